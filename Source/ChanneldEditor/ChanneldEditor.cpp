@@ -9,6 +9,7 @@
 #include "ChanneldEditorSubsystem.h"
 #include "ChanneldSettings.h"
 #include "ChanneldSettingsDetails.h"
+#include "ChanneldReplicationComponentDetails.h"
 #include "LevelEditor.h"
 #include "ReplicatorGeneratorManager.h"
 #include "ChanneldUE/Replication/ChanneldReplicationComponent.h"
@@ -23,6 +24,7 @@
 #include "EditorUtilityWidgetBlueprint.h"
 #include "ILiveCodingModule.h"
 #include "Async/Async.h"
+#include "Misc/FileHelper.h"
 #include "ChanneldEditorTypes.h"
 
 IMPLEMENT_MODULE(FChanneldEditorModule, ChanneldEditor);
@@ -102,7 +104,7 @@ void FChanneldEditorModule::StartupModule()
 	FEditorDelegates::EditorModeIDExit.AddLambda([&](const FEditorModeID&)
 	{
 		StopChanneldAction();
-		StopServersAction();
+		StopServers(false);
 	});
 
 	// Add editor settings 
@@ -119,6 +121,7 @@ void FChanneldEditorModule::StartupModule()
 	// PropertyModule.RegisterCustomPropertyTypeLayout(FClientInterestSettingsPreset::StaticStruct()->GetFName(),
 	// 	FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FClientInterestSettingsCustomization::MakeInstance));
 	PropertyModule.RegisterCustomClassLayout(UChanneldSettings::StaticClass()->GetFName(), FOnGetDetailCustomizationInstance::CreateStatic(&FChanneldSettingsDetails::MakeInstance));
+	PropertyModule.RegisterCustomClassLayout(UChanneldReplicationComponent::StaticClass()->GetFName(), FOnGetDetailCustomizationInstance::CreateStatic(&FChanneldReplicationComponentDetails::MakeInstance));
 
 	PropertyModule.NotifyCustomizationModuleChanged();
 
@@ -136,9 +139,16 @@ void FChanneldEditorModule::ShutdownModule()
 		FPropertyEditorModule& PropertyModule = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
 		PropertyModule.UnregisterCustomPropertyTypeLayout(FClientInterestSettingsPreset::StaticStruct()->GetFName());
 		PropertyModule.UnregisterCustomClassLayout(UChanneldSettings::StaticClass()->GetFName());
+		PropertyModule.UnregisterCustomClassLayout(UChanneldReplicationComponent::StaticClass()->GetFName());
 		PropertyModule.NotifyCustomizationModuleChanged();
 	}
 
+	for (auto& Pair : ResidentServers)
+	{
+		FPlatformProcess::TerminateProc(Pair.Value.ProcHandle, true);
+	}
+	ResidentServers.Empty();
+
 	FChanneldEditorStyle::Shutdown();
 
 	FChanneldEditorCommands::Unregister();
@@ -366,8 +376,9 @@ void FChanneldEditorModule::LaunchServersAction()
 	}
 	UChanneldEditorSettings* Settings = GetMutableDefault<UChanneldEditorSettings>();
 	FTimerManager* TimerManager = GetTimerManager();
-	for (FServerGroup& ServerGroup : Settings->ServerGroups)
+	for (int32 GroupIndex = 0; GroupIndex < Settings->ServerGroups.Num(); GroupIndex++)
 	{
+		FServerGroup& ServerGroup = Settings->ServerGroups[GroupIndex];
 		if (!ServerGroup.bEnabled)
 			continue;
 
@@ -380,9 +391,9 @@ void FChanneldEditorModule::LaunchServersAction()
 		{
 			if (TimerManager)
 			{
-				TimerManager->SetTimer(ServerGroup.DelayHandle, [&, ServerGroup]()
+				TimerManager->SetTimer(ServerGroup.DelayHandle, [&, GroupIndex, ServerGroup]()
 				{
-					LaunchServerGroup(ServerGroup);
+					LaunchServerGroup(GroupIndex, ServerGroup);
 				}, ServerGroup.DelayTime, false, ServerGroup.DelayTime);
 			}
 			else
@@ -392,12 +403,12 @@ void FChanneldEditorModule::LaunchServersAction()
 		}
 		else
 		{
-			LaunchServerGroup(ServerGroup);
+			LaunchServerGroup(GroupIndex, ServerGroup);
 		}
 	}
 }
 
-void FChanneldEditorModule::LaunchServerGroup(const FServerGroup& ServerGroup)
+void FChanneldEditorModule::LaunchServerGroup(int32 GroupIndex, const FServerGroup& ServerGroup)
 {
 	const FString EditorPath = FString(FPlatformProcess::ExecutablePath());
 	const FString ProjectPath = FPaths::GetProjectFilePath();
@@ -407,19 +418,54 @@ void FChanneldEditorModule::LaunchServerGroup(const FServerGroup& ServerGroup)
 	FString MapName = ServerGroup.ServerMap.IsValid() ? ServerGroup.ServerMap.GetLongPackageName() : GEditor->GetEditorWorldContext().World()->GetOuter()->GetName();
 	FString ViewClassName = ServerGroup.ServerViewClass ? ServerGroup.ServerViewClass->GetPathName() : Settings->ChannelDataViewClass->GetPathName();
 
+	const bool bResident = GetMutableDefault<UChanneldEditorSettings>()->bKeepServersResident;
+	const FString LaunchArgs = FString::Printf(TEXT("-channeld=%s %s"), Settings->bEnableNetworking ? TEXT("True") : TEXT("False"), *ServerGroup.AdditionalArgs.ToString());
 	for (int i = 0; i < ServerGroup.ServerNum; i++)
 	{
 		FString Params = FString::Printf(TEXT("\"%s\" %s -game -PIEVIACONSOLE -Multiprocess -server -log -MultiprocessSaveConfig -forcepassthrough -channeld=%s -SessionName=\"%s - Server %d\" -windowed ViewClass=%s %s"),
 		                                 *ProjectPath, *MapName, Settings->bEnableNetworking ? TEXT("True") : TEXT("False"), *MapName, i, *ViewClassName, *ServerGroup.AdditionalArgs.ToString());
+
+		const FString ReloadRequestFile = GetReloadRequestFile(GroupIndex, i);
+		if (bResident)
+		{
+			// The map and the view are loaded by the command line at the launch, and by the request file after that.
+			const FString ReloadRequest = FString::Printf(TEXT("%s ViewClass=%s RequestId=%s"), *MapName, *ViewClassName, *FGuid::NewGuid().ToString());
+			if (FResidentServer* ResidentServer = ResidentServers.Find(ReloadRequestFile))
+			{
+				if (FPlatformProcess::IsProcRunning(ResidentServer->ProcHandle) && ResidentServer->LaunchArgs == LaunchArgs)
+				{
+					FFileHelper::SaveStringToFile(ReloadRequest, *ReloadRequestFile);
+					UE_LOG(LogChanneldEditor, Log, TEXT("Reloading the resident server %d of group %d"), i, GroupIndex);
+					continue;
+				}
+				FPlatformProcess::TerminateProc(ResidentServer->ProcHandle, true);
+				ResidentServers.Remove(ReloadRequestFile);
+			}
+			FFileHelper::SaveStringToFile(ReloadRequest, *ReloadRequestFile);
+			Params += FString::Printf(TEXT(" -ChanneldReloadFile=\"%s\""), *ReloadRequestFile);
+		}
+
 		uint32 ProcessId;
 		FProcHandle ProcHandle = FPlatformProcess::CreateProc(*EditorPath, *Params, true, false, false, &ProcessId, 0, nullptr, nullptr, nullptr);
 		if (ProcHandle.IsValid())
 		{
-			ServerProcHandles.Add(ProcHandle);
+			if (bResident)
+			{
+				ResidentServers.Add(ReloadRequestFile, {ProcHandle, LaunchArgs});
+			}
+			else
+			{
+				ServerProcHandles.Add(ProcHandle);
+			}
 		}
 	}
 }
 
+FString FChanneldEditorModule::GetReloadRequestFile(int32 GroupIndex, int32 ServerIndex)
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("Channeld/ResidentServers") / FString::Printf(TEXT("Group%d_Server%d.txt"), GroupIndex, ServerIndex));
+}
+
 bool FChanneldEditorModule::IsCompatibleRecompilationEnabled()
 {
 	return GetMutableDefault<UChanneldEditorSettings>()->bEnableCompatibleRecompilation;
@@ -433,6 +479,11 @@ void FChanneldEditorModule::ToggleCompatibleRecompilationAction()
 }
 
 void FChanneldEditorModule::StopServersAction()
+{
+	StopServers(true);
+}
+
+void FChanneldEditorModule::StopServers(bool bStopResidentServers)
 {
 	if (FTimerManager* TimerManager = GetTimerManager())
 	{
@@ -447,6 +498,15 @@ void FChanneldEditorModule::StopServersAction()
 		FPlatformProcess::TerminateProc(ServerProc, true);
 	}
 	ServerProcHandles.Reset();
+
+	if (bStopResidentServers)
+	{
+		for (auto& Pair : ResidentServers)
+		{
+			FPlatformProcess::TerminateProc(Pair.Value.ProcHandle, true);
+		}
+		ResidentServers.Empty();
+	}
 }
 
 void FChanneldEditorModule::LaunchChanneldAndServersAction()
@@ -31,8 +31,10 @@ private:
 	FTimerManager* GetTimerManager();
 	void LaunchServersAction();
 	void StopServersAction();
+	void StopServers(bool bStopResidentServers);
 	void LaunchChanneldAndServersAction();
-	void LaunchServerGroup(const FServerGroup& ServerGroup);
+	void LaunchServerGroup(int32 GroupIndex, const FServerGroup& ServerGroup);
+	static FString GetReloadRequestFile(int32 GroupIndex, int32 ServerIndex);
 
 	static bool IsCompatibleRecompilationEnabled();
 	static void ToggleCompatibleRecompilationAction();
@@ -51,6 +53,15 @@ private:
 	TSharedRef<SWidget> CreateMenuContent(TSharedPtr<FUICommandList> Commands);
 	TArray<FProcHandle> ServerProcHandles;
 
+	// The servers kept running between the launches, by the reload request file.
+	struct FResidentServer
+	{
+		FProcHandle ProcHandle;
+		// The args that can't be changed by the reload.
+		FString LaunchArgs;
+	};
+	TMap<FString, FResidentServer> ResidentServers;
+
 	mutable TSharedPtr<FChanneldProcWorkerThread> BuildChanneldWorkThread;
 	UChanneldMissionNotiProxy* BuildChanneldNotify;
 
@@ -58,6 +58,11 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "Server")
 	TArray<FServerGroup> ServerGroups;
 
+	// Keep the launched servers running after the launch. Launching the servers again only makes the running servers reload the map
+	// and the view, instead of starting them cold. The servers are restarted if the Additional Args of the group have changed.
+	UPROPERTY(Config, EditAnywhere, Category = "Server")
+	bool bKeepServersResident = false;
+
 	//Using to add the replication component to all replicated blueprint actors
 	UPROPERTY(Config, EditAnywhere, Category = "Tools")
 	TSubclassOf<UChanneldReplicationComponent> DefaultReplicationComponent = UChanneldReplicationComponent::StaticClass();
@@ -23,9 +23,11 @@
 #include "Developer/DesktopPlatform/Public/IDesktopPlatform.h"
 #include "Developer/DesktopPlatform/Public/DesktopPlatformModule.h"
 #include "Async/Async.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "DerivedDataCache/Public/DerivedDataCacheInterface.h"
 #include "Editor/UnrealEdEngine.h"
 #include "Interfaces/IMainFrameModule.h"
+#include "Interfaces/IPluginManager.h"
 #include "Interfaces/IProjectTargetPlatformEditorModule.h"
 #include "Logging/MessageLog.h"
 #include "Logging/TokenizedMessage.h"
@@ -51,6 +53,16 @@ void UChanneldEditorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 	GenRepNotify = NewObject<UChanneldMissionNotiProxy>();
 	GenRepNotify->AddToRoot();
+	GenRepNotify->MissionCanceled.AddLambda([this]()
+	{
+		for (const TSharedPtr<FChanneldProcWorkerThread>& WorkThread : GenProtoWorkThreads)
+		{
+			if (WorkThread->GetThreadStatus() == EChanneldThreadStatus::Busy)
+			{
+				WorkThread->Cancel();
+			}
+		}
+	});
 
 	BuildServerDockerImageNotify = NewObject<UChanneldMissionNotiProxy>();
 	BuildServerDockerImageNotify->AddToRoot();
@@ -241,7 +253,7 @@ void UChanneldEditorSubsystem::GenerateReplicationAction()
 		const UChanneldEditorSettings* EditorSettings = GetMutableDefault<UChanneldEditorSettings>();
 
 		FReplicatorGeneratorManager& GeneratorManager = FReplicatorGeneratorManager::Get();
-		GeneratorManager.RemoveGeneratedCodeFiles();
+		// The unchanged files are kept, so UBT and protoc can skip them. The stale files are removed by GenerateReplication().
 		GeneratorManager.GenerateReplication(
 			EditorSettings->ChanneldGoPackageImportPathPrefix,
 			EditorSettings->bEnableCompatibleRecompilation
@@ -263,56 +275,153 @@ void UChanneldEditorSubsystem::GenerateReplicationAction()
 		}
 #endif // CLANG_FORMAT_PATH
 
-		const TArray<FString> GeneratedProtoFiles = GeneratorManager.GetGeneratedProtoFiles();
-		GenRepProtoCppCode(GeneratedProtoFiles, [this, GeneratedProtoFiles]()
+		// The C++ and Go code are generated at the same time. Only the proto files that are changed (or failed to compile last time) are compiled,
+		// so the unchanged .pb.h/.pb.cpp/.pb.go files keep their timestamps.
+		GenProtoWorkThreads.Reset();
+		TSharedRef<FThreadSafeCounter> NumPendingLanguages = MakeShared<FThreadSafeCounter>(2);
+		auto OnLanguageGenerated = [this, NumPendingLanguages]()
 		{
-			GenRepProtoGoCode(GeneratedProtoFiles, [this]()
+			if (NumPendingLanguages->Decrement() == 0)
 			{
-				auto Settings = GetMutableDefault<UChanneldSettings>();
-				FReplicatorGeneratorManager& GeneratorManager = FReplicatorGeneratorManager::Get();
-				FGeneratedManifest LatestGeneratedManifest;
-				if (!GeneratorManager.LoadLatestGeneratedManifest(LatestGeneratedManifest))
-				{
-					UE_LOG(LogChanneldEditor, Error, TEXT("Failed to load latest generated manifest"));
-					FailedToGenRepCode();
-					return;
-				}
-				for (const auto& ChannelDataMsgName : LatestGeneratedManifest.ChannelDataMsgNames)
-				{
-					Settings->DefaultChannelDataMsgNames.Emplace(ChannelDataMsgName.Key, ChannelDataMsgName.Value);
-					UE_LOG(LogChanneldEditor, Log, TEXT("Updated the default channel data message name of %s: %s"),
-						*StaticEnum<EChanneldChannelType>()->GetNameStringByValue(static_cast<int64>(ChannelDataMsgName.Key)),
-						*ChannelDataMsgName.Value);
-				}
-				Settings->SaveConfig();
-				GetMutableDefault<UChanneldSettings>()->ReloadConfig();
+				PostGenRepProtoCode();
+			}
+		};
+		GenRepProtoCppCode(GeneratorManager.GetOutdatedProtoFiles(), OnLanguageGenerated);
+		GenRepProtoGoCode(GeneratorManager.GetGeneratedProtoFiles(), OnLanguageGenerated);
+	});
+}
+
+void UChanneldEditorSubsystem::PostGenRepProtoCode()
+{
+	auto Settings = GetMutableDefault<UChanneldSettings>();
+	FReplicatorGeneratorManager& GeneratorManager = FReplicatorGeneratorManager::Get();
+	FGeneratedManifest LatestGeneratedManifest;
+	if (!GeneratorManager.LoadLatestGeneratedManifest(LatestGeneratedManifest))
+	{
+		UE_LOG(LogChanneldEditor, Error, TEXT("Failed to load latest generated manifest"));
+		FailedToGenRepCode();
+		return;
+	}
+	for (const auto& ChannelDataMsgName : LatestGeneratedManifest.ChannelDataMsgNames)
+	{
+		Settings->DefaultChannelDataMsgNames.Emplace(ChannelDataMsgName.Key, ChannelDataMsgName.Value);
+		UE_LOG(LogChanneldEditor, Log, TEXT("Updated the default channel data message name of %s: %s"),
+			*StaticEnum<EChanneldChannelType>()->GetNameStringByValue(static_cast<int64>(ChannelDataMsgName.Key)),
+			*ChannelDataMsgName.Value);
+	}
+	Settings->SaveConfig();
+	GetMutableDefault<UChanneldSettings>()->ReloadConfig();
 
-				if (GetMutableDefault<UChanneldEditorSettings>()->bEnableCompatibleRecompilation)
+	if (GetMutableDefault<UChanneldEditorSettings>()->bEnableCompatibleRecompilation)
+	{
+		UE_LOG(LogChanneldEditor, Verbose,
+		       TEXT("Auto recompile game code after generate replicator protos"));
+		// Run RecompileGameCode in game thread, the RecompileGameCode will use FNotificationInfo which can only be used in game thread
+		AsyncTask(ENamedThreads::GameThread, [this]()
+		{
+			RecompileGameCode();
+		});
+	}
+	else
+	{
+		// Only when the dialog window is opened in the game line, the dialog window will be a ue4 editor style window
+		AsyncTask(ENamedThreads::GameThread, [this]()
+		{
+			FMessageDialog::Open(EAppMsgType::OkCancel,
+			                     FText::FromString(TEXT(
+				                     "Please close the editor and recompile the game code to make the changes take effect.")));
+		});
+	}
+	GenRepNotify->SpawnMissionSucceedNotification(nullptr);
+	bGeneratingReplication = false;
+	PostGenerateReplicationCode.Broadcast(true);
+}
+
+void UChanneldEditorSubsystem::RunProtocShards(const TCHAR* ThreadName, const TArray<FString>& ProtoFiles,
+                                               TFunction<FString(const TArray<FString>&)> BuildArgs,
+                                               TFunction<void()> OnAllShardsSucceeded, TFunction<void()> OnFailed)
+{
+	const FString ProtocPath = FProtocHelper::GetProtocPath();
+	// The C++ and Go code are generated at the same time, so each of them takes half of the cores.
+	const int32 NumShards = FMath::Clamp(FPlatformMisc::NumberOfCores() / 2, 1, ProtoFiles.Num());
+	TArray<TArray<FString>> Shards;
+	Shards.SetNum(NumShards);
+	for (int32 i = 0; i < ProtoFiles.Num(); i++)
+	{
+		Shards[i % NumShards].Add(ProtoFiles[i]);
+	}
+
+	TSharedRef<FThreadSafeCounter> NumPendingShards = MakeShared<FThreadSafeCounter>(NumShards);
+	TSharedRef<FThreadSafeBool> bAnyShardFailed = MakeShared<FThreadSafeBool>(false);
+	for (int32 ShardIndex = 0; ShardIndex < NumShards; ShardIndex++)
+	{
+		const FString Args = BuildArgs(Shards[ShardIndex]);
+		UE_LOG(LogChanneldEditor, Display, TEXT("%s [%d/%d]:\n\"%s\" %s"), ThreadName, ShardIndex + 1, NumShards, *ProtocPath, *Args);
+
+		TSharedPtr<FChanneldProcWorkerThread> WorkThread = MakeShareable(new FChanneldProcWorkerThread(ThreadName, ProtocPath, Args));
+		WorkThread->ProcOutputMsgDelegate.BindUObject(GenRepNotify, &UChanneldMissionNotiProxy::ReceiveOutputMsg);
+		WorkThread->ProcFailedDelegate.AddLambda([OnFailed, bAnyShardFailed](FChanneldProcWorkerThread*)
+			{
+				// Only report the first failed shard.
+				if (!bAnyShardFailed->AtomicSet(true))
 				{
-					UE_LOG(LogChanneldEditor, Verbose,
-					       TEXT("Auto recompile game code after generate replicator protos"));
-					// Run RecompileGameCode in game thread, the RecompileGameCode will use FNotificationInfo which can only be used in game thread
-					AsyncTask(ENamedThreads::GameThread, [this]()
-					{
-						RecompileGameCode();
-					});
+					OnFailed();
 				}
-				else
+			}
+		);
+		WorkThread->ProcSucceedDelegate.AddLambda([OnAllShardsSucceeded, NumPendingShards, bAnyShardFailed](FChanneldProcWorkerThread*)
+			{
+				if (NumPendingShards->Decrement() == 0 && !*bAnyShardFailed)
 				{
-					// Only when the dialog window is opened in the game line, the dialog window will be a ue4 editor style window
-					AsyncTask(ENamedThreads::GameThread, [this]()
-					{
-						FMessageDialog::Open(EAppMsgType::OkCancel,
-						                     FText::FromString(TEXT(
-							                     "Please close the editor and recompile the game code to make the changes take effect.")));
-					});
+					OnAllShardsSucceeded();
 				}
-				GenRepNotify->SpawnMissionSucceedNotification(nullptr);
-				bGeneratingReplication = false;
-				PostGenerateReplicationCode.Broadcast(true);
-			});
-		});
-	});
+			}
+		);
+		GenProtoWorkThreads.Add(WorkThread);
+		WorkThread->Execute();
+	}
+}
+
+// The directory of unreal_components.proto, which defines the states of the built-in component replicators.
+static FString GetChanneldUEProtoDir()
+{
+	FString ProtoDir = IPluginManager::Get().FindPlugin(TEXT("ChanneldUE"))->GetBaseDir() / TEXT("Source") / TEXT("ChanneldUE");
+	FPaths::NormalizeDirectoryName(ProtoDir);
+	return ProtoDir;
+}
+
+// Copy unreal_components.proto to CHANNELD_PATH/pkg/unrealpb and compile its Go code there, if it's missing or older than the proto file of the plugin.
+static bool UpdateUnrealComponentsGoCode(const FString& ChanneldUnrealpbPath)
+{
+	const FString ProtoFileName = TEXT("unreal_components.proto");
+	const FString SrcProtoFile = GetChanneldUEProtoDir() / ProtoFileName;
+	const FString GoFile = ChanneldUnrealpbPath / FPaths::GetBaseFilename(ProtoFileName) + TEXT(".pb.go");
+	IFileManager& FileManager = IFileManager::Get();
+	if (FileManager.GetTimeStamp(*GoFile) >= FileManager.GetTimeStamp(*SrcProtoFile))
+	{
+		return true;
+	}
+
+	if (FileManager.Copy(*(ChanneldUnrealpbPath / ProtoFileName), *SrcProtoFile) != COPY_OK)
+	{
+		UE_LOG(LogChanneldEditor, Error, TEXT("Failed to copy %s to %s"), *SrcProtoFile, *ChanneldUnrealpbPath);
+		return false;
+	}
+	const FString Args = FProtocHelper::BuildProtocProcessGoArguments(
+		ChanneldUnrealpbPath,
+		TEXT("paths=source_relative"),
+		{ChanneldUnrealpbPath},
+		{ProtoFileName}
+	);
+	int32 ReturnCode = 0;
+	FString StdOut, StdErr;
+	FPlatformProcess::ExecProcess(*FProtocHelper::GetProtocPath(), *Args, &ReturnCode, &StdOut, &StdErr);
+	if (ReturnCode != 0)
+	{
+		UE_LOG(LogChanneldEditor, Error, TEXT("Failed to generate the go code of %s: %s"), *ProtoFileName, *StdErr);
+		return false;
+	}
+	return true;
 }
 
 void UChanneldEditorSubsystem::GenRepProtoCppCode(const TArray<FString>& ProtoFiles,
@@ -335,21 +444,21 @@ void UChanneldEditorSubsystem::GenRepProtoCppCode(const TArray<FString>& ProtoFi
 		UE_LOG(LogChanneldEditor, Verbose, TEXT("Game module export API macro is empty"));
 	}
 
+	if (ProtoFiles.Num() == 0)
+	{
+		UE_LOG(LogChanneldEditor, Display, TEXT("All the cpp prototype code is up to date."));
+		if (PostGenRepProtoCppCodeSuccess != nullptr)
+		{
+			PostGenRepProtoCppCodeSuccess();
+		}
+		return;
+	}
+
 	FString ReplicatorStorageDir = FReplicatorGeneratorManager::Get().GetReplicatorStorageDir();
 
 	FString ChanneldUnrealpbPath = ChanneldPath / TEXT("pkg") / TEXT("unrealpb");
 	FPaths::NormalizeDirectoryName(ChanneldUnrealpbPath);
 
-	const FString Args = FProtocHelper::BuildProtocProcessCppArguments(
-		ReplicatorStorageDir,
-		FString::Printf(TEXT("dllexport_decl=%s"), *GameModuleExportAPIMacro),
-		{
-			ReplicatorStorageDir,
-			ChanneldUnrealpbPath,
-		},
-		ProtoFiles
-	);
-
 	IFileManager& FileManager = IFileManager::Get();
 	const FString ProtocPath = FProtocHelper::GetProtocPath();
 	if (!FileManager.FileExists(*ProtocPath))
@@ -359,33 +468,22 @@ void UChanneldEditorSubsystem::GenRepProtoCppCode(const TArray<FString>& ProtoFi
 		return;
 	}
 
-	UE_LOG(LogChanneldEditor, Display, TEXT("Generate Cpp Protobuf Code:\n\"%s\" %s"), *ProtocPath, *Args);
-
-	GenProtoCppCodeWorkThread = MakeShareable(
-		new FChanneldProcWorkerThread(TEXT("GenerateReplicatorProtoThread"), ProtocPath, Args));
-	GenProtoCppCodeWorkThread->ProcOutputMsgDelegate.BindUObject(GenRepNotify,
-	                                                             &UChanneldMissionNotiProxy::ReceiveOutputMsg);
-	GenProtoCppCodeWorkThread->ProcBeginDelegate.AddLambda([](FChanneldProcWorkerThread*)
+	UE_LOG(LogChanneldEditor, Display, TEXT("Start generating cpp prototype code of %d proto files..."), ProtoFiles.Num());
+	RunProtocShards(TEXT("GenerateReplicatorProtoThread"), ProtoFiles,
+		[ReplicatorStorageDir, GameModuleExportAPIMacro, ChanneldUnrealpbPath, ChanneldUEProtoDir = GetChanneldUEProtoDir()](const TArray<FString>& ShardProtoFiles)
 		{
-			UE_LOG(LogChanneldEditor, Display, TEXT("Start generating cpp prototype code..."));
-		}
-	);
-	GenProtoCppCodeWorkThread->ProcFailedDelegate.AddLambda([this](FChanneldProcWorkerThread*)
-		{
-			UE_LOG(LogChanneldEditor, Error, TEXT("Failed to generate cpp proto codes!"));
-			FailedToGenRepCode();
-		}
-	);
-	GenRepNotify->MissionCanceled.AddLambda([this]()
-	{
-		if (GenProtoCppCodeWorkThread.IsValid() && GenProtoCppCodeWorkThread->GetThreadStatus() ==
-			EChanneldThreadStatus::Busy)
-		{
-			GenProtoCppCodeWorkThread->Cancel();
-		}
-	});
-	GenProtoCppCodeWorkThread->ProcSucceedDelegate.AddLambda(
-		[this, ProtoFiles, ReplicatorStorageDir, PostGenRepProtoCppCodeSuccess](FChanneldProcWorkerThread*)
+			return FProtocHelper::BuildProtocProcessCppArguments(
+				ReplicatorStorageDir,
+				FString::Printf(TEXT("dllexport_decl=%s"), *GameModuleExportAPIMacro),
+				{
+					ReplicatorStorageDir,
+					ChanneldUnrealpbPath,
+					ChanneldUEProtoDir,
+				},
+				ShardProtoFiles
+			);
+		},
+		[ProtoFiles, ReplicatorStorageDir, PostGenRepProtoCppCodeSuccess]()
 		{
 			IFileManager& FileManager = IFileManager::Get();
 			for (FString GeneratedProtoFile : ProtoFiles)
@@ -401,10 +499,13 @@ void UChanneldEditorSubsystem::GenRepProtoCppCode(const TArray<FString>& ProtoFi
 			{
 				PostGenRepProtoCppCodeSuccess();
 			}
+		},
+		[this]()
+		{
+			UE_LOG(LogChanneldEditor, Error, TEXT("Failed to generate cpp proto codes!"));
+			FailedToGenRepCode();
 		}
 	);
-
-	GenProtoCppCodeWorkThread->Execute();
 }
 
 void UChanneldEditorSubsystem::GenRepProtoGoCode(const TArray<FString>& ProtoFiles,
@@ -437,29 +538,34 @@ void UChanneldEditorSubsystem::GenRepProtoGoCode(const TArray<FString>& ProtoFil
 	{
 		IFileManager::Get().MakeDirectory(*DirToGenGoProto, true);
 	}
-	else
+
+	// Only compile the proto files whose .pb.go is missing or older than the proto file, and remove the .pb.go files of the removed proto files.
+	// The merge and registration code are always replaced below.
+	const FString ReplicatorStorageDir = GeneratorManager.GetReplicatorStorageDir();
+	TArray<FString> OutdatedProtoFiles;
+	TSet<FString> ExpectedGoFiles;
+	for (const FString& ProtoFile : ProtoFiles)
+	{
+		const FString GoFile = FPaths::GetBaseFilename(ProtoFile) + TEXT(".pb.go");
+		ExpectedGoFiles.Add(GoFile);
+		if (IFileManager::Get().GetTimeStamp(*(DirToGenGoProto / GoFile)) < IFileManager::Get().GetTimeStamp(*(ReplicatorStorageDir / ProtoFile)))
+		{
+			OutdatedProtoFiles.Add(ProtoFile);
+		}
+	}
+	TArray<FString> ExistingGoFiles;
+	IFileManager::Get().FindFiles(ExistingGoFiles, *DirToGenGoProto, TEXT(".pb.go"));
+	for (const FString& GoFile : ExistingGoFiles)
 	{
-		// remove all files in channeld go proto storage dir
-		TArray<FString> AllCodeFiles;
-		IFileManager::Get().FindFiles(AllCodeFiles, *DirToGenGoProto);
-		for (const FString& FilePath : AllCodeFiles)
+		if (!ExpectedGoFiles.Contains(GoFile))
 		{
-			IFileManager::Get().Delete(*(DirToGenGoProto / FilePath));
+			IFileManager::Get().Delete(*(DirToGenGoProto / GoFile));
 		}
 	}
+
 	FString ChanneldUnrealpbPath = ChanneldPath / TEXT("pkg") / TEXT("unrealpb");
 	FPaths::NormalizeDirectoryName(ChanneldUnrealpbPath);
 
-	const FString Args = FProtocHelper::BuildProtocProcessGoArguments(
-		DirToGenGoProto,
-		TEXT("paths=source_relative"),
-		{
-			GeneratorManager.GetReplicatorStorageDir(),
-			ChanneldUnrealpbPath,
-		},
-		ProtoFiles
-	);
-
 	IFileManager& FileManager = IFileManager::Get();
 	const FString ProtocPath = FProtocHelper::GetProtocPath();
 	if (!FileManager.FileExists(*ProtocPath))
@@ -469,51 +575,71 @@ void UChanneldEditorSubsystem::GenRepProtoGoCode(const TArray<FString>& ProtoFil
 		return;
 	}
 
-	UE_LOG(LogChanneldEditor, Display, TEXT("Generate GO Protobuf Code:\n\"%s\" %s"), *ProtocPath, *Args);
+	// The generated channel data can refer to the states in unreal_components.proto.
+	if (!UpdateUnrealComponentsGoCode(ChanneldUnrealpbPath))
+	{
+		FailedToGenRepCode();
+		return;
+	}
 
-	GenProtoGoCodeWorkThread = MakeShareable(
-		new FChanneldProcWorkerThread(TEXT("GenerateReplicatorGoProtoThread"), ProtocPath, Args));
-	GenProtoGoCodeWorkThread->ProcOutputMsgDelegate.BindUObject(GenRepNotify,
-	                                                            &UChanneldMissionNotiProxy::ReceiveOutputMsg);
-	GenProtoGoCodeWorkThread->ProcBeginDelegate.AddLambda([](FChanneldProcWorkerThread*)
+	// The merge and registration code don't depend on the output of protoc.
+	IFileManager::Get().Move(*(DirToGenGoProto / TEXT("data.go")), *LatestGeneratedManifest.TemporaryGoMergeCodePath);
+	if (!LatestGeneratedManifest.TemporaryGoMergeBenchmarkCodePath.IsEmpty())
+	{
+		// Run with `go test -bench=Merge` in the generated package.
+		IFileManager::Get().Move(*(DirToGenGoProto / TEXT("data_bench_test.go")), *LatestGeneratedManifest.TemporaryGoMergeBenchmarkCodePath);
+	}
+	IFileManager::Get().Move(*(DirToGoMain / TEXT("channeldue.gen.go")),
+	                         *LatestGeneratedManifest.TemporaryGoRegistrationCodePath);
+
+	if (OutdatedProtoFiles.Num() == 0)
+	{
+		UE_LOG(LogChanneldEditor, Display, TEXT("All the channeld go proto code is up to date."));
+		if (PostGenRepProtoGoCodeSuccess != nullptr)
 		{
-			UE_LOG(LogChanneldEditor, Display, TEXT("Start generating channeld go proto code..."));
+			PostGenRepProtoGoCodeSuccess();
 		}
-	);
-	GenProtoGoCodeWorkThread->ProcFailedDelegate.AddLambda([this](FChanneldProcWorkerThread*)
+		return;
+	}
+
+	UE_LOG(LogChanneldEditor, Display, TEXT("Start generating channeld go proto code of %d proto files..."), OutdatedProtoFiles.Num());
+	RunProtocShards(TEXT("GenerateReplicatorGoProtoThread"), OutdatedProtoFiles,
+		[DirToGenGoProto, ReplicatorStorageDir, ChanneldUnrealpbPath](const TArray<FString>& ShardProtoFiles)
 		{
-			UE_LOG(LogChanneldEditor, Error, TEXT("Failed to generate channeld go proto codes!"));
-			FailedToGenRepCode();
-		}
-	);
-	GenProtoGoCodeWorkThread->ProcSucceedDelegate.AddLambda([PostGenRepProtoGoCodeSuccess](FChanneldProcWorkerThread*)
+			return FProtocHelper::BuildProtocProcessGoArguments(
+				DirToGenGoProto,
+				TEXT("paths=source_relative"),
+				{
+					ReplicatorStorageDir,
+					ChanneldUnrealpbPath,
+				},
+				ShardProtoFiles
+			);
+		},
+		[PostGenRepProtoGoCodeSuccess]()
 		{
 			UE_LOG(LogChanneldEditor, Display, TEXT("Successfully generated channeld go proto code."));
 			if (PostGenRepProtoGoCodeSuccess != nullptr)
 			{
 				PostGenRepProtoGoCodeSuccess();
 			}
-		}
-	);
-	GenRepNotify->MissionCanceled.AddLambda([this]()
-	{
-		if (GenProtoGoCodeWorkThread.IsValid() && GenProtoGoCodeWorkThread->GetThreadStatus() ==
-			EChanneldThreadStatus::Busy)
+		},
+		[this]()
 		{
-			GenProtoGoCodeWorkThread->Cancel();
+			UE_LOG(LogChanneldEditor, Error, TEXT("Failed to generate channeld go proto codes!"));
+			FailedToGenRepCode();
 		}
-	});
-	GenProtoGoCodeWorkThread->Execute();
-
-	IFileManager::Get().Move(*(DirToGenGoProto / TEXT("data.go")), *LatestGeneratedManifest.TemporaryGoMergeCodePath);
-	IFileManager::Get().Move(*(DirToGoMain / TEXT("channeldue.gen.go")),
-	                         *LatestGeneratedManifest.TemporaryGoRegistrationCodePath);
+	);
 }
 
 void UChanneldEditorSubsystem::FailedToGenRepCode()
 {
+	// The C++ and Go code are generated in parallel, so only the first failure is reported.
+	if (!bGeneratingReplication.AtomicSet(false))
+	{
+		return;
+	}
 	GenRepNotify->SpawnMissionFailedNotification(nullptr);
-	bGeneratingReplication = false;
 	PostGenerateReplicationCode.Broadcast(false);
 }
 
@@ -562,8 +688,89 @@ FString UChanneldEditorSubsystem::GetCloudDepymentProjectIntermediateDir() const
 		FPaths::ProjectDir() / TEXT("Intermediate") / TEXT("ChanneldClouldDeployment"));
 }
 
+/**
+ * The COPY instructions of the packaged server, one layer per folder, from the least to the most frequently changed ones
+ * (the engine, the content, the binaries). A rebuild after changing the code only re-creates the layer of the binaries.
+ */
+static FString GetServerImageCopyLayers(const FString& LinuxServerDir)
+{
+	const FString ProjectName = FApp::GetProjectName();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	auto ListDir = [&PlatformFile](const FString& Dir, TArray<FString>& OutDirs, TArray<FString>& OutFiles)
+	{
+		PlatformFile.IterateDirectory(*Dir, [&OutDirs, &OutFiles](const TCHAR* Path, bool bIsDirectory)
+		{
+			(bIsDirectory ? OutDirs : OutFiles).Add(FPaths::GetCleanFilename(Path));
+			return true;
+		});
+	};
+	TArray<FString> TopDirs, TopFiles, ProjectDirs, ProjectFiles;
+	ListDir(LinuxServerDir, TopDirs, TopFiles);
+	ListDir(LinuxServerDir / ProjectName, ProjectDirs, ProjectFiles);
+	if (TopDirs.Num() == 0 && TopFiles.Num() == 0)
+	{
+		UE_LOG(LogChanneldEditor, Warning, TEXT("The packaged server is not found in %s, copying it as a single layer."), *LinuxServerDir);
+		return TEXT("COPY --chown=ue4:ue4 ./LinuxServer /LinuxServer/");
+	}
+	TopDirs.Sort();
+	ProjectDirs.Sort();
+
+	// The paths relative to the LinuxServer folder, in the order of the layers.
+	TArray<FString> LayerDirs;
+	if (TopDirs.Remove(TEXT("Engine")) > 0)
+	{
+		LayerDirs.Add(TEXT("Engine"));
+	}
+	if (ProjectDirs.Remove(TEXT("Content")) > 0)
+	{
+		LayerDirs.Add(ProjectName / TEXT("Content"));
+	}
+	TopDirs.Remove(ProjectName);
+	LayerDirs.Append(TopDirs);
+	const bool bHasBinaries = ProjectDirs.Remove(TEXT("Binaries")) > 0;
+	for (const FString& Dir : ProjectDirs)
+	{
+		LayerDirs.Add(ProjectName / Dir);
+	}
+	if (bHasBinaries)
+	{
+		LayerDirs.Add(ProjectName / TEXT("Binaries"));
+	}
+
+	FString Result;
+	for (const FString& Dir : LayerDirs)
+	{
+		Result += FString::Printf(TEXT("COPY --chown=ue4:ue4 [\"./LinuxServer/%s\", \"/LinuxServer/%s/\"]\n"), *Dir, *Dir);
+	}
+	// The startup script and the manifests are small, so they are copied along with the last layers.
+	auto AppendCopyFiles = [&Result](const FString& Dir, const TArray<FString>& Files)
+	{
+		if (Files.Num() == 0)
+		{
+			return;
+		}
+		Result += TEXT("COPY --chown=ue4:ue4 [");
+		for (const FString& File : Files)
+		{
+			Result += FString::Printf(TEXT("\"./LinuxServer/%s\", "), *(Dir / File));
+		}
+		Result += FString::Printf(TEXT("\"%s/\"]\n"), *(Dir.IsEmpty() ? FString(TEXT("/LinuxServer")) : TEXT("/LinuxServer") / Dir));
+	};
+	AppendCopyFiles(ProjectName, ProjectFiles);
+	AppendCopyFiles(TEXT(""), TopFiles);
+	return Result;
+}
+
 void UChanneldEditorSubsystem::BuildServerDockerImage(const FString& Tag,
                                                       const FPostBuildServerDockerImage& PostBuildServerDockerImage)
+{
+	BuildServerDockerImageInternal(Tag, [PostBuildServerDockerImage](bool Success)
+	{
+		PostBuildServerDockerImage.ExecuteIfBound(Success);
+	});
+}
+
+void UChanneldEditorSubsystem::BuildServerDockerImageInternal(const FString& Tag, TFunction<void(bool Success)> PostBuildServerDockerImage)
 {
 	BuildServerDockerImageNotify->SetMissionNotifyText(
 		FText::FromString(TEXT("Building Server Docker Image...")),
@@ -577,12 +784,31 @@ void UChanneldEditorSubsystem::BuildServerDockerImage(const FString& Tag,
 	{
 		UE_LOG(LogChanneldEditor, Error, TEXT("Tag is empty!"));
 		BuildServerDockerImageNotify->SpawnMissionFailedNotification(nullptr);
-		PostBuildServerDockerImage.ExecuteIfBound(false);
+		PostBuildServerDockerImage(false);
 		return;
 	}
 
 	const UProjectPackagingSettings* const PackagingSettings = GetDefault<UProjectPackagingSettings>();
 
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 2
+	const UPlatformsMenuSettings* PlatformsSettings = GetDefault<UPlatformsMenuSettings>();
+	FDirectoryPath StagingDirectory = PlatformsSettings->StagingDirectory;
+#else
+	FDirectoryPath StagingDirectory = PackagingSettings->StagingDirectory;
+#endif
+
+	// Copied before generating the Dockerfile, which copies the files in the staging directory.
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.CopyFile(*(StagingDirectory.Path / TEXT("LinuxServer/ChanneldUE.ini")),
+	                           *(FPaths::GetPath(FPaths::GetProjectFilePath()) / TEXT(
+		                           "/Saved/Config/Windows/ChanneldUE.ini"))))
+	{
+		UE_LOG(LogChanneldEditor, Error, TEXT("Failed to copy ChanneldUE.ini"));
+		BuildServerDockerImageNotify->SpawnMissionFailedNotification(nullptr);
+		PostBuildServerDockerImage(false);
+		return;
+	}
+
 	FString DockerfileTemplate = FString(ANSI_TO_TCHAR(PLUGIN_DIR)) / TEXT("Template") / TEXT("Dockerfile-LinuxServer");
 	// Load DockerfileTemplate
 	FString DockerfileContent;
@@ -591,11 +817,12 @@ void UChanneldEditorSubsystem::BuildServerDockerImage(const FString& Tag,
 		{
 			UE_LOG(LogChanneldEditor, Error, TEXT("Failed to load Dockerfile template."));
 			BuildServerDockerImageNotify->SpawnMissionFailedNotification(nullptr);
-			PostBuildServerDockerImage.ExecuteIfBound(false);
+			PostBuildServerDockerImage(false);
 			return;
 		}
 		FStringFormatNamedArguments FormatArgs;
 		FormatArgs.Add(TEXT("ProjectName"), FApp::GetProjectName());
+		FormatArgs.Add(TEXT("CopyLayers"), GetServerImageCopyLayers(StagingDirectory.Path / TEXT("LinuxServer")));
 		DockerfileContent = FString::Format(*DockerfileContent, FormatArgs);
 	}
 	// Write Dockerfile to intermediate dir
@@ -605,25 +832,7 @@ void UChanneldEditorSubsystem::BuildServerDockerImage(const FString& Tag,
 	{
 		UE_LOG(LogChanneldEditor, Error, TEXT("Failed to save Dockerfile."));
 		BuildServerDockerImageNotify->SpawnMissionFailedNotification(nullptr);
-		PostBuildServerDockerImage.ExecuteIfBound(false);
-		return;
-	}
-
-#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 2
-	const UPlatformsMenuSettings* PlatformsSettings = GetDefault<UPlatformsMenuSettings>();
-	FDirectoryPath StagingDirectory = PlatformsSettings->StagingDirectory;
-#else
-	FDirectoryPath StagingDirectory = PackagingSettings->StagingDirectory;
-#endif
-
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	if (!PlatformFile.CopyFile(*(StagingDirectory.Path / TEXT("LinuxServer/ChanneldUE.ini")),
-	                           *(FPaths::GetPath(FPaths::GetProjectFilePath()) / TEXT(
-		                           "/Saved/Config/Windows/ChanneldUE.ini"))))
-	{
-		UE_LOG(LogChanneldEditor, Error, TEXT("Failed to copy ChanneldUE.ini"));
-		BuildServerDockerImageNotify->SpawnMissionFailedNotification(nullptr);
-		PostBuildServerDockerImage.ExecuteIfBound(false);
+		PostBuildServerDockerImage(false);
 		return;
 	}
 
@@ -638,7 +847,7 @@ void UChanneldEditorSubsystem::BuildServerDockerImage(const FString& Tag,
 		{
 			UE_LOG(LogChanneldEditor, Error, TEXT("Failed to load BuildServerDockerImage.bat template."));
 			BuildServerDockerImageNotify->SpawnMissionFailedNotification(nullptr);
-			PostBuildServerDockerImage.ExecuteIfBound(false);
+			PostBuildServerDockerImage(false);
 			return;
 		}
 		FStringFormatNamedArguments FormatArgs;
@@ -659,7 +868,7 @@ void UChanneldEditorSubsystem::BuildServerDockerImage(const FString& Tag,
 			BuildServerDockerImageNotify->SpawnMissionSucceedNotification(nullptr);
 			AsyncTask(ENamedThreads::GameThread, [this, PostBuildServerDockerImage]()
 			{
-				PostBuildServerDockerImage.ExecuteIfBound(true);
+				PostBuildServerDockerImage(true);
 			});
 		}
 		else
@@ -667,7 +876,7 @@ void UChanneldEditorSubsystem::BuildServerDockerImage(const FString& Tag,
 			BuildServerDockerImageNotify->SpawnMissionFailedNotification(nullptr);
 			AsyncTask(ENamedThreads::GameThread, [this, PostBuildServerDockerImage]()
 			{
-				PostBuildServerDockerImage.ExecuteIfBound(true);
+				PostBuildServerDockerImage(false);
 			});
 		}
 	});
@@ -677,6 +886,14 @@ void UChanneldEditorSubsystem::BuildServerDockerImage(const FString& Tag,
 void UChanneldEditorSubsystem::BuildChanneldDockerImage(const FString& Tag,
                                                         const FPostBuildChanneldDockerImage&
                                                         PostBuildChanneldDockerImage)
+{
+	BuildChanneldDockerImageInternal(Tag, [PostBuildChanneldDockerImage](bool Success)
+	{
+		PostBuildChanneldDockerImage.ExecuteIfBound(Success);
+	});
+}
+
+void UChanneldEditorSubsystem::BuildChanneldDockerImageInternal(const FString& Tag, TFunction<void(bool Success)> PostBuildChanneldDockerImage)
 {
 	BuildChanneldDockerImageNotify->SetMissionNotifyText(
 		FText::FromString(TEXT("Building Channeld Gateway...")),
@@ -690,7 +907,7 @@ void UChanneldEditorSubsystem::BuildChanneldDockerImage(const FString& Tag,
 	{
 		UE_LOG(LogChanneldEditor, Error, TEXT("Tag is empty!"));
 		BuildChanneldDockerImageNotify->SpawnMissionFailedNotification(nullptr);
-		PostBuildChanneldDockerImage.ExecuteIfBound(false);
+		PostBuildChanneldDockerImage(false);
 		return;
 	}
 
@@ -702,7 +919,7 @@ void UChanneldEditorSubsystem::BuildChanneldDockerImage(const FString& Tag,
 			       "CHANNELD_PATH environment variable is not set. Please set it to the path of the channeld source code directory."
 		       ));
 		BuildChanneldDockerImageNotify->SpawnMissionFailedNotification(nullptr);
-		PostBuildChanneldDockerImage.ExecuteIfBound(false);
+		PostBuildChanneldDockerImage(false);
 		return;
 	}
 	FPaths::NormalizeDirectoryName(ChanneldPath);
@@ -714,7 +931,7 @@ void UChanneldEditorSubsystem::BuildChanneldDockerImage(const FString& Tag,
 			       "Channeld source code directory does not exist."
 		       ));
 		BuildChanneldDockerImageNotify->SpawnMissionFailedNotification(nullptr);
-		PostBuildChanneldDockerImage.ExecuteIfBound(false);
+		PostBuildChanneldDockerImage(false);
 		return;
 	}
 
@@ -726,7 +943,7 @@ void UChanneldEditorSubsystem::BuildChanneldDockerImage(const FString& Tag,
 			       "LaunchChanneldEntry is not set. Please set it to the path of the channeld entry point."
 		       ));
 		BuildChanneldDockerImageNotify->SpawnMissionFailedNotification(nullptr);
-		PostBuildChanneldDockerImage.ExecuteIfBound(false);
+		PostBuildChanneldDockerImage(false);
 		return;
 	}
 	FPaths::NormalizeDirectoryName(ChanneldEntryPath);
@@ -738,7 +955,7 @@ void UChanneldEditorSubsystem::BuildChanneldDockerImage(const FString& Tag,
 			       "Channeld entry point does not exist."
 		       ));
 		BuildChanneldDockerImageNotify->SpawnMissionFailedNotification(nullptr);
-		PostBuildChanneldDockerImage.ExecuteIfBound(false);
+		PostBuildChanneldDockerImage(false);
 		return;
 	}
 
@@ -747,7 +964,7 @@ void UChanneldEditorSubsystem::BuildChanneldDockerImage(const FString& Tag,
 	{
 		UE_LOG(LogChanneldEditor, Error, TEXT("Cannot find Dockerfile at %s."), *ChanneldDockerfilePath);
 		BuildChanneldDockerImageNotify->SpawnMissionFailedNotification(nullptr);
-		PostBuildChanneldDockerImage.ExecuteIfBound(false);
+		PostBuildChanneldDockerImage(false);
 		return;
 	}
 
@@ -762,7 +979,7 @@ void UChanneldEditorSubsystem::BuildChanneldDockerImage(const FString& Tag,
 		{
 			UE_LOG(LogChanneldEditor, Error, TEXT("Failed to load BuildServerDockerImage.bat template."));
 			BuildChanneldDockerImageNotify->SpawnMissionFailedNotification(nullptr);
-			PostBuildChanneldDockerImage.ExecuteIfBound(false);
+			PostBuildChanneldDockerImage(false);
 			return;
 		}
 		FStringFormatNamedArguments FormatArgs;
@@ -784,7 +1001,7 @@ void UChanneldEditorSubsystem::BuildChanneldDockerImage(const FString& Tag,
 			BuildChanneldDockerImageNotify->SpawnMissionSucceedNotification(nullptr);
 			AsyncTask(ENamedThreads::GameThread, [this, PostBuildChanneldDockerImage]()
 			{
-				PostBuildChanneldDockerImage.ExecuteIfBound(true);
+				PostBuildChanneldDockerImage(true);
 			});
 		}
 		else
@@ -792,12 +1009,34 @@ void UChanneldEditorSubsystem::BuildChanneldDockerImage(const FString& Tag,
 			BuildChanneldDockerImageNotify->SpawnMissionFailedNotification(nullptr);
 			AsyncTask(ENamedThreads::GameThread, [this, PostBuildChanneldDockerImage]()
 			{
-				PostBuildChanneldDockerImage.ExecuteIfBound(false);
+				PostBuildChanneldDockerImage(false);
 			});
 		}
 	});
 }
 
+void UChanneldEditorSubsystem::BuildDockerImages(const FString& ChanneldTag, const FString& ServerTag,
+                                                 const FPostBuildDockerImages& PostBuildDockerImages)
+{
+	// The two builds are independent, so they run at the same time. The callback is called after both are finished.
+	struct FBuildState
+	{
+		int32 NumRunning = 2;
+		bool bSuccess = true;
+	};
+	TSharedRef<FBuildState> State = MakeShared<FBuildState>();
+	auto OnBuilt = [State, PostBuildDockerImages](bool Success)
+	{
+		State->bSuccess &= Success;
+		if (--State->NumRunning == 0)
+		{
+			PostBuildDockerImages.ExecuteIfBound(State->bSuccess);
+		}
+	};
+	BuildChanneldDockerImageInternal(ChanneldTag, OnBuilt);
+	BuildServerDockerImageInternal(ServerTag, OnBuilt);
+}
+
 void UChanneldEditorSubsystem::OpenPackagingSettings()
 {
 	if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
@@ -1432,6 +1671,37 @@ void UChanneldEditorSubsystem::UploadDockerImage(const FString& ChanneldImageTag
 		return;
 	}
 
+	// Skip the images that have been uploaded with the same image id.
+	const FString UploadedImageIdsPath = GetCloudDepymentProjectIntermediateDir() / TEXT("UploadedDockerImageIds.txt");
+	TMap<FString, FString> UploadedImageIds;
+	{
+		TArray<FString> Lines;
+		FFileHelper::LoadFileToStringArray(Lines, *UploadedImageIdsPath);
+		for (const FString& Line : Lines)
+		{
+			FString UploadedTag, UploadedId;
+			if (Line.Split(TEXT(" "), &UploadedTag, &UploadedId))
+			{
+				UploadedImageIds.Add(UploadedTag, UploadedId);
+			}
+		}
+	}
+	const TMap<FString, FString> ImageIds = GetDockerImageId({ChanneldImageTag, ServerImageTag});
+	auto IsUploaded = [&ImageIds, &UploadedImageIds](const FString& Tag)
+	{
+		const FString* ImageId = ImageIds.Find(Tag);
+		return ImageId && !ImageId->IsEmpty() && UploadedImageIds.FindRef(Tag) == *ImageId;
+	};
+	const bool bUploadChanneld = !IsUploaded(ChanneldImageTag);
+	const bool bUploadServer = !IsUploaded(ServerImageTag);
+	if (!bUploadChanneld && !bUploadServer)
+	{
+		UE_LOG(LogChanneldEditor, Log, TEXT("The docker images are not changed since the last upload, skipped uploading."));
+		UploadDockerImageNotify->SpawnMissionSucceedNotification(nullptr);
+		PostUploadDockerImage.ExecuteIfBound(true);
+		return;
+	}
+
 	FString BatTemplate = FString(ANSI_TO_TCHAR(PLUGIN_DIR)) / TEXT("Template") / TEXT("UploadDockerImage.bat");
 
 	FString BatFileContent;
@@ -1446,9 +1716,10 @@ void UChanneldEditorSubsystem::UploadDockerImage(const FString& ChanneldImageTag
 		FStringFormatNamedArguments FormatArgs;
 		FormatArgs.Add(TEXT("WorkDir"), GetCloudDepymentProjectIntermediateDir());
 		FormatArgs.Add(TEXT("Username"), RegistryUsername);
-		FormatArgs.Add(TEXT("ChanneldTag"), ChanneldImageTag);
+		// The push of an empty tag is skipped.
+		FormatArgs.Add(TEXT("ChanneldTag"), bUploadChanneld ? ChanneldImageTag : FString());
 		FormatArgs.Add(TEXT("ChanneldRepoUrl"), FPaths::GetPath(FPaths::GetPath(ChanneldImageTag)));
-		FormatArgs.Add(TEXT("ServerTag"), ServerImageTag);
+		FormatArgs.Add(TEXT("ServerTag"), bUploadServer ? ServerImageTag : FString());
 		FormatArgs.Add(TEXT("ServerRepoUrl"), FPaths::GetPath(FPaths::GetPath(ServerImageTag)));
 		BatFileContent = FString::Format(*BatFileContent, FormatArgs);
 	}
@@ -1464,11 +1735,20 @@ void UChanneldEditorSubsystem::UploadDockerImage(const FString& ChanneldImageTag
 		                              *(GetCloudDepymentProjectIntermediateDir() / TEXT("TempRegistryPassword")));
 	}
 
-	AsyncTask(ENamedThreads::AnyNormalThreadNormalTask, [this, TempBatFilePath, PostUploadDockerImage]()
+	AsyncTask(ENamedThreads::AnyNormalThreadNormalTask, [this, TempBatFilePath, PostUploadDockerImage, ImageIds, UploadedImageIds, UploadedImageIdsPath]()
 	{
 		int Result = system(TCHAR_TO_ANSI(*FString::Printf(TEXT("cmd /c \"%s\""), *TempBatFilePath)));
 		if (Result == 0)
 		{
+			TMap<FString, FString> NewUploadedImageIds = UploadedImageIds;
+			NewUploadedImageIds.Append(ImageIds);
+			TArray<FString> Lines;
+			for (const auto& Pair : NewUploadedImageIds)
+			{
+				Lines.Add(Pair.Key + TEXT(" ") + Pair.Value);
+			}
+			FFileHelper::SaveStringArrayToFile(Lines, *UploadedImageIdsPath);
+
 			UploadDockerImageNotify->SpawnMissionSucceedNotification(nullptr);
 			AsyncTask(ENamedThreads::GameThread, [this, PostUploadDockerImage]()
 			{
@@ -1566,6 +1846,21 @@ void UChanneldEditorSubsystem::DeployToCluster(const FDeploymentStepParams Deplo
 		FormatArgs.Add(TEXT("ViewClass"), ServerGroup.ServerViewClass->GetPathName());
 		FormatArgs.Add(TEXT("AdditionalArgs"), ServerGroup.AdditionalArgs.ToString());
 		YAMLTemplateContent.Append(FString::Format(*ServerYAMLTemplateContent, FormatArgs));
+		if (ServerGroup.MaxServerNum > ServerGroup.ServerNum)
+		{
+			const FString AutoscalerYAMLTemplatePath = FString(ANSI_TO_TCHAR(PLUGIN_DIR)) / TEXT("Template") / TEXT("SpatialServerAutoscaler.yaml");
+			FString AutoscalerYAMLTemplateContent;
+			if (!FFileHelper::LoadFileToString(AutoscalerYAMLTemplateContent, *AutoscalerYAMLTemplatePath))
+			{
+				UE_LOG(LogChanneldEditor, Error, TEXT("Failed to load autoscaler YAML template at %s."), *AutoscalerYAMLTemplatePath);
+				DeployToClusterNotify->SpawnMissionFailedNotification(nullptr);
+				PostDeplymentToCluster.ExecuteIfBound(false);
+				return;
+			}
+			FormatArgs.Add(TEXT("MaxReplicas"), ServerGroup.MaxServerNum);
+			FormatArgs.Add(TEXT("TargetLoad"), FString::SanitizeFloat(ServerGroup.TargetLoad));
+			YAMLTemplateContent.Append(FString::Format(*AutoscalerYAMLTemplateContent, FormatArgs));
+		}
 		CheckPodStatusCommand.Append(
 			GetCheckPodCommand(
 				TEXT("%jqPath%"),
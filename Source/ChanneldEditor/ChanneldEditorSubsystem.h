@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
 #include "ChanneldMissionNotiProxy.h"
 #include "CloudDeploymentController.h"
 #include "ChanneldEditorSubsystem.generated.h"
@@ -40,6 +41,8 @@ DECLARE_DYNAMIC_DELEGATE_OneParam(FPostBuildServerDockerImage, bool, Success);
 
 DECLARE_DYNAMIC_DELEGATE_OneParam(FPostBuildChanneldDockerImage, bool, Success);
 
+DECLARE_DYNAMIC_DELEGATE_OneParam(FPostBuildDockerImages, bool, Success);
+
 DECLARE_DYNAMIC_DELEGATE_OneParam(FPostUploadDockerImage, bool, Success);
 
 DECLARE_DYNAMIC_DELEGATE_OneParam(FPostDeploymentToCluster, bool, Success);
@@ -93,6 +96,9 @@ public:
 
 	void FailedToGenRepCode();
 
+	// Update the settings and notify after both the C++ and Go proto code are generated.
+	void PostGenRepProtoCode();
+
 	/**
 	 * Recompile the game code. Copied from FLevelEditorActionCallbacks::RecompileGameCode_Clicked().
 	 */
@@ -114,6 +120,11 @@ public:
 	void BuildChanneldDockerImage(const FString& Tag,
 	                              const FPostBuildChanneldDockerImage& PostBuildChanneldDockerImage);
 
+	// Build the channeld and the server images in parallel.
+	UFUNCTION(BlueprintCallable)
+	void BuildDockerImages(const FString& ChanneldTag, const FString& ServerTag,
+	                       const FPostBuildDockerImages& PostBuildDockerImages);
+
 	UFUNCTION(BlueprintCallable)
 	void OpenPackagingSettings();
 
@@ -170,10 +181,22 @@ private:
 
 	TSharedPtr<FChanneldProcWorkerThread> GenRepWorkThread;
 	UChanneldMissionNotiProxy* GenRepNotify;
-	bool bGeneratingReplication;
+	FThreadSafeBool bGeneratingReplication;
+
+	// The protoc processes of the C++ and Go code of the current generation.
+	TArray<TSharedPtr<FChanneldProcWorkerThread>> GenProtoWorkThreads;
+
+	/**
+	 * Split the proto files into shards and compile them with concurrent protoc processes.
+	 * OnAllShardsSucceeded or OnFailed is called once, in the thread of the last succeeded or the first failed shard.
+	 */
+	void RunProtocShards(const TCHAR* ThreadName, const TArray<FString>& ProtoFiles,
+	                     TFunction<FString(const TArray<FString>&)> BuildArgs,
+	                     TFunction<void()> OnAllShardsSucceeded, TFunction<void()> OnFailed);
 
-	TSharedPtr<FChanneldProcWorkerThread> GenProtoCppCodeWorkThread;
-	TSharedPtr<FChanneldProcWorkerThread> GenProtoGoCodeWorkThread;
+	// The callbacks are called in the game thread.
+	void BuildServerDockerImageInternal(const FString& Tag, TFunction<void(bool Success)> PostBuildServerDockerImage);
+	void BuildChanneldDockerImageInternal(const FString& Tag, TFunction<void(bool Success)> PostBuildChanneldDockerImage);
 
 	UChanneldMissionNotiProxy* BuildServerDockerImageNotify;
 	UChanneldMissionNotiProxy* BuildChanneldDockerImageNotify;
@@ -0,0 +1,105 @@
+#include "ChanneldReplicationComponentDetails.h"
+
+#include "DetailCategoryBuilder.h"
+#include "DetailLayoutBuilder.h"
+#include "DetailWidgetRow.h"
+#include "ReplicatorGeneratorManager.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "FChanneldUEModule"
+
+TSharedRef<IDetailCustomization> FChanneldReplicationComponentDetails::MakeInstance()
+{
+	return MakeShareable(new FChanneldReplicationComponentDetails);
+}
+
+// The component classes of the actor class, including the ones added in the Blueprints.
+static void GetComponentClasses(const UClass* ActorClass, TSet<const UClass*>& OutComponentClasses)
+{
+	if (const AActor* ActorCDO = Cast<AActor>(ActorClass->GetDefaultObject()))
+	{
+		for (const UActorComponent* Comp : ActorCDO->GetComponents())
+		{
+			OutComponentClasses.Add(Comp->GetClass());
+		}
+	}
+	for (const UClass* Class = ActorClass; Class != nullptr; Class = Class->GetSuperClass())
+	{
+		const UBlueprintGeneratedClass* BPClass = Cast<UBlueprintGeneratedClass>(Class);
+		if (BPClass && BPClass->SimpleConstructionScript)
+		{
+			for (const USCS_Node* Node : BPClass->SimpleConstructionScript->GetAllNodes())
+			{
+				if (Node->ComponentTemplate)
+				{
+					OutComponentClasses.Add(Node->ComponentTemplate->GetClass());
+				}
+			}
+		}
+	}
+}
+
+void FChanneldReplicationComponentDetails::CustomizeDetails(IDetailLayoutBuilder& DetailBuilder)
+{
+	TArray<TWeakObjectPtr<UObject>> Objects;
+	DetailBuilder.GetObjectsBeingCustomized(Objects);
+	if (Objects.Num() != 1 || !Objects[0].IsValid())
+	{
+		return;
+	}
+
+	// The template of a Blueprint component has no owner, but is outered to the generated class.
+	const UActorComponent* RepComp = CastChecked<UActorComponent>(Objects[0].Get());
+	const UClass* ActorClass = RepComp->GetOwner() ? RepComp->GetOwner()->GetClass() : RepComp->GetTypedOuter<UClass>();
+	if (ActorClass == nullptr)
+	{
+		return;
+	}
+
+	FReplicatorGeneratorManager& GeneratorManager = FReplicatorGeneratorManager::Get();
+	FReplicationCostEstimate Estimate;
+	bool bFound = GeneratorManager.GetReplicationCostEstimate(ActorClass, Estimate);
+	// The replicated components are sent at the frequency of the owner.
+	TSet<const UClass*> ComponentClasses;
+	GetComponentClasses(ActorClass, ComponentClasses);
+	for (const UClass* ComponentClass : ComponentClasses)
+	{
+		FReplicationCostEstimate ComponentEstimate;
+		if (GeneratorManager.GetReplicationCostEstimate(ComponentClass, ComponentEstimate))
+		{
+			Estimate.TypicalStateBytes += ComponentEstimate.TypicalStateBytes;
+			Estimate.WorstCaseStateBytes += ComponentEstimate.WorstCaseStateBytes;
+			bFound = true;
+		}
+	}
+	Estimate.UpdateBytesPerSecond();
+
+	IDetailCategoryBuilder& Category = DetailBuilder.EditCategory("Channeld Replication Cost", FText::GetEmpty(), ECategoryPriority::Uncommon);
+	auto AddRow = [&Category, &DetailBuilder](const FText& Name, const FString& Value)
+	{
+		Category.AddCustomRow(Name)
+			.NameContent()
+			[
+				SNew(STextBlock).Text(Name).Font(DetailBuilder.GetDetailFont())
+			]
+			.ValueContent()
+			.MinDesiredWidth(250.f)
+			[
+				SNew(STextBlock).Text(FText::FromString(Value)).Font(DetailBuilder.GetDetailFont())
+			];
+	};
+	if (!bFound)
+	{
+		AddRow(LOCTEXT("ReplicationCostNotGenerated", "Estimate"), TEXT("Generate the replication code to estimate the cost"));
+		return;
+	}
+	AddRow(LOCTEXT("ReplicationCostStateSize", "State Size"),
+		FString::Printf(TEXT("%d bytes (worst case: %d bytes)"), Estimate.TypicalStateBytes, Estimate.WorstCaseStateBytes));
+	AddRow(LOCTEXT("ReplicationCostBandwidth", "Bandwidth"),
+		FString::Printf(TEXT("Up to %d B/s (worst case: %d B/s) at %g Hz"), Estimate.TypicalBytesPerSecond, Estimate.WorstCaseBytesPerSecond, Estimate.NetUpdateFrequency));
+}
+
+#undef LOCTEXT_NAMESPACE
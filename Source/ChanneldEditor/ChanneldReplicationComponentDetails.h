@@ -0,0 +1,12 @@
+#pragma once
+#include "IDetailCustomization.h"
+
+// Shows the estimated replication cost of the owning actor class of UChanneldReplicationComponent, from the manifest of the
+// last generated replicators. See FReplicatorGeneratorManager::GetReplicationCostEstimate().
+class FChanneldReplicationComponentDetails : public IDetailCustomization
+{
+public:
+	static TSharedRef<IDetailCustomization> MakeInstance();
+
+	virtual void CustomizeDetails(IDetailLayoutBuilder& DetailBuilder) override;
+};
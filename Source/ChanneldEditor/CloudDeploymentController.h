@@ -15,6 +15,15 @@ struct CHANNELDEDITOR_API FServerGroupForDeployment : public FServerGroup
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	FString YAMLTemplatePath;
 
+	// If greater than ServerNum, the servers of the group are scaled out up to the number by the average of their ue_spatial_load metric.
+	// Requires KEDA in the cluster and SpatialLoadReportInterval > 0 of the servers. See Template/SpatialServerAutoscaler.yaml.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	int32 MaxServerNum = 0;
+
+	// The average load of the servers to keep below by scaling out.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (EditCondition = "MaxServerNum > 0", ClampMin = "0.1"))
+	float TargetLoad = 0.8f;
+
 	FServerGroupForDeployment()
 	{
 	}
@@ -0,0 +1,33 @@
+
+using UnrealBuildTool;
+
+public class ChanneldLoadTest : ModuleRules
+{
+	public ChanneldLoadTest(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"ChanneldUE",
+				"ProtobufUE",
+				"PrometheusUE",
+			}
+		);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"HTTP",
+				"Json",
+				"JsonUtilities",
+			}
+		);
+
+		bUseRTTI = false;
+	}
+}
@@ -0,0 +1,357 @@
+#include "ChanneldBenchmark.h"
+
+#include "ChanneldCapture.h"
+#include "ChanneldConnection.h"
+#include "ChanneldLoadTest.h"
+#include "ChanneldMetrics.h"
+#include "ChanneldUtils.h"
+#include "unreal_common.pb.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Replication/ChanneldReplication.h"
+#include "Replication/ChanneldReplicatorBase.h"
+
+namespace
+{
+	// Counts the heap allocations while it's installed as GMalloc. The allocations of the other threads are counted as well,
+	// so the benchmarks should run when the process is otherwise idle, e.g. in the commandlet.
+	class FChanneldCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FChanneldCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			NumAllocs.Increment();
+			return Inner->Malloc(Count, Alignment);
+		}
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Original == nullptr)
+			{
+				NumAllocs.Increment();
+			}
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("ChanneldCountingMalloc"); }
+
+		FMalloc* Inner;
+		FThreadSafeCounter64 NumAllocs;
+	};
+}
+
+void FChanneldBenchmarkSuite::FillSyntheticMessage(google::protobuf::Message* Msg, int32 NumEntries, FRandomStream& Random, int32 Depth)
+{
+	using namespace google::protobuf;
+	const Descriptor* Desc = Msg->GetDescriptor();
+	const Reflection* Refl = Msg->GetReflection();
+	for (int32 i = 0; i < Desc->field_count(); i++)
+	{
+		const FieldDescriptor* Field = Desc->field(i);
+		// Don't remove the entries of the channel data.
+		if (Field->name() == "removed")
+		{
+			continue;
+		}
+
+		if (Field->is_map())
+		{
+			if (Depth > 0)
+			{
+				continue;
+			}
+			for (int32 Index = 0; Index < NumEntries; Index++)
+			{
+				Message* Entry = Refl->AddMessage(Msg, Field);
+				const FieldDescriptor* KeyField = Entry->GetDescriptor()->map_key();
+				const FieldDescriptor* ValueField = Entry->GetDescriptor()->map_value();
+				const uint32 Key = Channeld::EntityChannelIdStart + Index;
+				switch (KeyField->cpp_type())
+				{
+				case FieldDescriptor::CPPTYPE_UINT32: Entry->GetReflection()->SetUInt32(Entry, KeyField, Key); break;
+				case FieldDescriptor::CPPTYPE_INT32: Entry->GetReflection()->SetInt32(Entry, KeyField, Key); break;
+				case FieldDescriptor::CPPTYPE_UINT64: Entry->GetReflection()->SetUInt64(Entry, KeyField, Key); break;
+				case FieldDescriptor::CPPTYPE_INT64: Entry->GetReflection()->SetInt64(Entry, KeyField, Key); break;
+				case FieldDescriptor::CPPTYPE_STRING: Entry->GetReflection()->SetString(Entry, KeyField, std::to_string(Key)); break;
+				default: break;
+				}
+				if (ValueField->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE)
+				{
+					FillSyntheticMessage(Entry->GetReflection()->MutableMessage(Entry, ValueField), NumEntries, Random, Depth + 1);
+				}
+			}
+			continue;
+		}
+
+		if (Field->is_repeated())
+		{
+			continue;
+		}
+
+		switch (Field->cpp_type())
+		{
+		case FieldDescriptor::CPPTYPE_INT32: Refl->SetInt32(Msg, Field, Random.RandRange(1, 1000)); break;
+		case FieldDescriptor::CPPTYPE_UINT32: Refl->SetUInt32(Msg, Field, Random.RandRange(1, 1000)); break;
+		case FieldDescriptor::CPPTYPE_INT64: Refl->SetInt64(Msg, Field, Random.RandRange(1, 1000)); break;
+		case FieldDescriptor::CPPTYPE_UINT64: Refl->SetUInt64(Msg, Field, Random.RandRange(1, 1000)); break;
+		case FieldDescriptor::CPPTYPE_FLOAT: Refl->SetFloat(Msg, Field, Random.FRandRange(-10000.f, 10000.f)); break;
+		case FieldDescriptor::CPPTYPE_DOUBLE: Refl->SetDouble(Msg, Field, Random.FRandRange(-10000.f, 10000.f)); break;
+		case FieldDescriptor::CPPTYPE_BOOL: Refl->SetBool(Msg, Field, Random.RandRange(0, 1) != 0); break;
+		case FieldDescriptor::CPPTYPE_ENUM: Refl->SetEnum(Msg, Field, Field->enum_type()->value(0)); break;
+		case FieldDescriptor::CPPTYPE_STRING: Refl->SetString(Msg, Field, "synthetic"); break;
+		case FieldDescriptor::CPPTYPE_MESSAGE:
+			// Any is left empty, as it needs a concrete message type.
+			if (Depth < 3 && Field->message_type()->full_name() != "google.protobuf.Any")
+			{
+				FillSyntheticMessage(Refl->MutableMessage(Msg, Field), NumEntries, Random, Depth + 1);
+			}
+			break;
+		}
+	}
+}
+
+void FChanneldBenchmarkSuite::Run(const FString& Name, TFunctionRef<void()> Op, int32 OpsPerCall)
+{
+	if (!CurrentFilter.IsEmpty() && !Name.Contains(CurrentFilter))
+	{
+		return;
+	}
+
+	// Warm up the caches and the pools.
+	for (int32 i = 0; i < 3; i++)
+	{
+		Op();
+	}
+
+	FChanneldCountingMalloc CountingMalloc(GMalloc);
+	GMalloc = &CountingMalloc;
+
+	int64 NumCalls = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	double Elapsed = 0;
+	do
+	{
+		Op();
+		NumCalls++;
+		Elapsed = FPlatformTime::Seconds() - StartTime;
+	}
+	while (Elapsed < MinSeconds);
+
+	GMalloc = CountingMalloc.Inner;
+
+	FChanneldBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+	Result.Name = Name;
+	const double NumOps = static_cast<double>(NumCalls) * OpsPerCall;
+	Result.NsPerOp = Elapsed * 1e9 / NumOps;
+	Result.AllocsPerOp = CountingMalloc.NumAllocs.GetValue() / NumOps;
+	UE_LOG(LogChanneldLoadTest, Display, TEXT("%-60s %14.1f ns/op %10.2f allocs/op"), *Name, Result.NsPerOp, Result.AllocsPerOp);
+}
+
+void FChanneldBenchmarkSuite::RunAll(const FString& Filter)
+{
+	CurrentFilter = Filter;
+	Results.Reset();
+	UE_LOG(LogChanneldLoadTest, Display, TEXT("Running the benchmarks with %d entities"), NumEntities);
+
+	RunProcessorMerges();
+	RunCharacterReplicatorTick();
+	RunVectorHelpers();
+	RunPacketAssembly();
+}
+
+void FChanneldBenchmarkSuite::RunProcessorMerges()
+{
+	using namespace google::protobuf;
+	ChanneldReplication::CreateAllChannelDataProcessors();
+	for (const auto& Pair : ChanneldReplication::ChannelDataProcessorRegistry)
+	{
+		const Descriptor* Desc = DescriptorPool::generated_pool()->FindMessageTypeByName(TCHAR_TO_UTF8(*Pair.Key.ToString()));
+		if (Desc == nullptr)
+		{
+			UE_LOG(LogChanneldLoadTest, Warning, TEXT("Can't find the message type of the processor: %s"), *Pair.Key.ToString());
+			continue;
+		}
+		const Message* Prototype = MessageFactory::generated_factory()->GetPrototype(Desc);
+
+		// The full state of the channel, and an update that touches a tenth of the entities.
+		FRandomStream Random(NumEntities);
+		TUniquePtr<Message> FullState(Prototype->New());
+		FillSyntheticMessage(FullState.Get(), NumEntities, Random);
+		TUniquePtr<Message> Update(Prototype->New());
+		FillSyntheticMessage(Update.Get(), FMath::Max(1, NumEntities / 10), Random);
+
+		IChannelDataProcessor* Processor = Pair.Value;
+		Run(FString::Printf(TEXT("Merge/%s"), *Pair.Key.ToString()), [&]()
+		{
+			Processor->Merge(Update.Get(), FullState.Get());
+		});
+	}
+}
+
+void FChanneldBenchmarkSuite::RunCharacterReplicatorTick()
+{
+	if (GEngine == nullptr)
+	{
+		return;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ChanneldBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+
+	TArray<ACharacter*> Characters;
+	TArray<FChanneldReplicatorBase*> Replicators;
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	for (int32 i = 0; i < NumEntities; i++)
+	{
+		ACharacter* Character = World->SpawnActor<ACharacter>(FVector(i * 100.f, 0, 0), FRotator::ZeroRotator, SpawnParams);
+		if (Character)
+		{
+			Characters.Add(Character);
+			Replicators.Append(ChanneldReplication::FindAndCreateReplicators(Character));
+		}
+	}
+
+	float Offset = 0.f;
+	Run(TEXT("ReplicatorTick/Character"), [&]()
+	{
+		// Move all the characters, so every replicator has a change to collect.
+		Offset += 1.f;
+		for (ACharacter* Character : Characters)
+		{
+			Character->SetActorLocation(Character->GetActorLocation() + FVector(0, Offset, 0));
+		}
+		for (FChanneldReplicatorBase* Replicator : Replicators)
+		{
+			Replicator->Tick(0.033f);
+			Replicator->ClearState();
+		}
+	}, FMath::Max(1, Characters.Num()));
+
+	for (FChanneldReplicatorBase* Replicator : Replicators)
+	{
+		delete Replicator;
+	}
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+}
+
+void FChanneldBenchmarkSuite::RunVectorHelpers()
+{
+	FRandomStream Random(NumEntities);
+	TArray<FVector> Vectors;
+	Vectors.SetNumUninitialized(NumEntities);
+	for (FVector& Vector : Vectors)
+	{
+		Vector = Random.GetUnitVector() * 10000.f;
+	}
+	TArray<unrealpb::FVector> PBVectors;
+	PBVectors.SetNum(NumEntities);
+
+	Run(TEXT("ChanneldUtils/SetVectorToPB"), [&]()
+	{
+		for (int32 i = 0; i < Vectors.Num(); i++)
+		{
+			Vectors[i].X += 1.f;
+			ChanneldUtils::SetVectorToPB(&PBVectors[i], Vectors[i]);
+		}
+	}, Vectors.Num());
+
+	Run(TEXT("ChanneldUtils/CheckDifference"), [&]()
+	{
+		int32 NumDifferent = 0;
+		for (int32 i = 0; i < Vectors.Num(); i++)
+		{
+			NumDifferent += ChanneldUtils::CheckDifference(Vectors[i], &PBVectors[i]);
+		}
+		// Keep the comparisons from being optimized away.
+		static volatile int32 Sink;
+		Sink = NumDifferent;
+	}, Vectors.Num());
+}
+
+void FChanneldBenchmarkSuite::RunPacketAssembly()
+{
+	// Plays back an empty capture, which discards the outgoing data, so the packets are assembled without a socket.
+	const FString CapturePath = FPaths::ProjectSavedDir() / TEXT("ChanneldBenchmark") / TEXT("Empty.cdcap");
+	{
+		FChanneldCaptureWriter Writer;
+		if (!Writer.Open(CapturePath))
+		{
+			UE_LOG(LogChanneldLoadTest, Warning, TEXT("Failed to create the capture for the packet assembly benchmark: %s"), *CapturePath);
+			return;
+		}
+	}
+
+	UChanneldConnection* Conn = NewObject<UChanneldConnection>();
+	Conn->AddToRoot();
+	Conn->bPollOnCallingThread = true;
+	Conn->ReplayFilePath = CapturePath;
+	Conn->InitializeStandalone(GEngine->GetEngineSubsystem<UChanneldMetrics>());
+	FString Error;
+	if (Conn->Connect(true, TEXT("127.0.0.1"), 0, Error))
+	{
+		FRandomStream Random(NumEntities);
+		unrealpb::SpatialChannelData Data;
+		FillSyntheticMessage(&Data, 4, Random);
+		channeldpb::ChannelDataUpdateMessage UpdateMsg;
+		UpdateMsg.mutable_data()->PackFrom(Data);
+
+		Run(TEXT("Connection/SendAndFlush"), [&]()
+		{
+			for (int32 i = 0; i < NumEntities; i++)
+			{
+				Conn->Send(Channeld::SpatialChannelIdStart + i % 16, channeldpb::CHANNEL_DATA_UPDATE, UpdateMsg);
+			}
+			Conn->TickOutgoing();
+		}, NumEntities);
+	}
+	else
+	{
+		UE_LOG(LogChanneldLoadTest, Warning, TEXT("Failed to open the replay connection for the packet assembly benchmark: %s"), *Error);
+	}
+	Conn->Deinitialize();
+	Conn->RemoveFromRoot();
+	IFileManager::Get().Delete(*CapturePath);
+}
+
+bool FChanneldBenchmarkSuite::CompareWithBaseline(const FChanneldBenchmarkBaseline& Baseline, double Tolerance) const
+{
+	if (Baseline.NumEntities != NumEntities)
+	{
+		UE_LOG(LogChanneldLoadTest, Warning, TEXT("The baseline was recorded with %d entities, but the benchmarks ran with %d"), Baseline.NumEntities, NumEntities);
+	}
+
+	bool bPassed = true;
+	for (const FChanneldBenchmarkResult& Result : Results)
+	{
+		const FChanneldBenchmarkResult* BaselineResult = Baseline.Results.FindByPredicate([&Result](const FChanneldBenchmarkResult& Other) { return Other.Name == Result.Name; });
+		if (BaselineResult == nullptr)
+		{
+			UE_LOG(LogChanneldLoadTest, Display, TEXT("%s is not in the baseline"), *Result.Name);
+			continue;
+		}
+		if (Result.NsPerOp > BaselineResult->NsPerOp * (1.0 + Tolerance))
+		{
+			UE_LOG(LogChanneldLoadTest, Error, TEXT("%s regressed: %.1f ns/op, baseline: %.1f ns/op"), *Result.Name, Result.NsPerOp, BaselineResult->NsPerOp);
+			bPassed = false;
+		}
+		// Allow a fraction of an allocation for the noise of the other threads.
+		if (Result.AllocsPerOp > BaselineResult->AllocsPerOp * (1.0 + Tolerance) + 0.5)
+		{
+			UE_LOG(LogChanneldLoadTest, Error, TEXT("%s allocates more: %.2f allocs/op, baseline: %.2f allocs/op"), *Result.Name, Result.AllocsPerOp, BaselineResult->AllocsPerOp);
+			bPassed = false;
+		}
+	}
+	return bPassed;
+}
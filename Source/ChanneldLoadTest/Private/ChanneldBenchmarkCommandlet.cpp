@@ -0,0 +1,56 @@
+#include "ChanneldBenchmarkCommandlet.h"
+
+#include "ChanneldBenchmark.h"
+#include "ChanneldLoadTest.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UChanneldBenchmarkCommandlet::UChanneldBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = true;
+	LogToConsole = true;
+}
+
+int32 UChanneldBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumEntities = 1000;
+	FParse::Value(*Params, TEXT("Entities="), NumEntities);
+	double MinSeconds = 1.0;
+	FParse::Value(*Params, TEXT("MinSeconds="), MinSeconds);
+	FString Filter;
+	FParse::Value(*Params, TEXT("Filter="), Filter);
+	FString BaselinePath = FPaths::ProjectSavedDir() / TEXT("ChanneldBenchmark") / TEXT("Baseline.json");
+	FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+	double Tolerance = 0.1;
+	FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+
+	FChanneldBenchmarkSuite Suite(FMath::Max(1, NumEntities), MinSeconds);
+	Suite.RunAll(Filter);
+
+	if (FParse::Param(*Params, TEXT("SaveBaseline")))
+	{
+		FChanneldBenchmarkBaseline Baseline;
+		Baseline.NumEntities = NumEntities;
+		Baseline.Results = Suite.GetResults();
+		FString Json;
+		if (!FJsonObjectConverter::UStructToJsonObjectString(Baseline, Json) || !FFileHelper::SaveStringToFile(Json, *BaselinePath))
+		{
+			UE_LOG(LogChanneldLoadTest, Error, TEXT("Failed to save the benchmark baseline to %s"), *BaselinePath);
+			return 1;
+		}
+		UE_LOG(LogChanneldLoadTest, Display, TEXT("Saved the benchmark baseline to %s"), *BaselinePath);
+		return 0;
+	}
+
+	FString Json;
+	FChanneldBenchmarkBaseline Baseline;
+	if (!FFileHelper::LoadFileToString(Json, *BaselinePath) || !FJsonObjectConverter::JsonObjectStringToUStruct(Json, &Baseline, 0, 0))
+	{
+		UE_LOG(LogChanneldLoadTest, Display, TEXT("No benchmark baseline at %s. Run with -SaveBaseline to create one."), *BaselinePath);
+		return 0;
+	}
+	return Suite.CompareWithBaseline(Baseline, Tolerance) ? 0 : 1;
+}
@@ -0,0 +1,17 @@
+#include "ChanneldLoadTest.h"
+
+DEFINE_LOG_CATEGORY(LogChanneldLoadTest);
+
+#define LOCTEXT_NAMESPACE "FChanneldLoadTestModule"
+
+void FChanneldLoadTestModule::StartupModule()
+{
+}
+
+void FChanneldLoadTestModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+	
+IMPLEMENT_MODULE(FChanneldLoadTestModule, ChanneldLoadTest)
@@ -0,0 +1,254 @@
+#include "ChanneldLoadTestBot.h"
+
+#include "ChanneldConnection.h"
+#include "ChanneldLoadTest.h"
+#include "JsonObjectConverter.h"
+#include "unreal_common.pb.h"
+#include "Misc/FileHelper.h"
+
+bool FChanneldBotScript::LoadFromFile(const FString& FilePath, FChanneldBotScript& OutScript)
+{
+	FString Json;
+	if (!FFileHelper::LoadFileToString(Json, *FilePath))
+	{
+		UE_LOG(LogChanneldLoadTest, Error, TEXT("Failed to read the bot script: %s"), *FilePath);
+		return false;
+	}
+	if (!FJsonObjectConverter::JsonObjectStringToUStruct(Json, &OutScript, 0, 0))
+	{
+		UE_LOG(LogChanneldLoadTest, Error, TEXT("Failed to parse the bot script: %s"), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+bool UChanneldLoadTestBot::Start(int32 InBotIndex, const FString& Host, int32 Port, const FChanneldBotScript& InScript, UChanneldMetrics* Metrics)
+{
+	BotIndex = InBotIndex;
+	Script = InScript;
+	Random.Initialize(BotIndex);
+	// Spread the bots around the origin, facing random directions.
+	Location = FVector(Random.FRandRange(-Script.BoundsExtent, Script.BoundsExtent), Random.FRandRange(-Script.BoundsExtent, Script.BoundsExtent), 0);
+	Yaw = Random.FRandRange(0.f, 360.f);
+	// Don't send or ping in the same tick for all the bots.
+	SendTimer = Random.FRand() / FMath::Max(Script.InputSendRate, 1.f);
+	PingTimer = Random.FRand() * Script.PingInterval;
+
+	Connection = NewObject<UChanneldConnection>(this);
+	Connection->bPollOnCallingThread = true;
+	Connection->InitializeStandalone(Metrics);
+
+	FString Error;
+	if (!Connection->Connect(true, Host, Port, Error))
+	{
+		UE_LOG(LogChanneldLoadTest, Warning, TEXT("Bot %d failed to connect to channeld: %s"), BotIndex, *Error);
+		return false;
+	}
+
+	TWeakObjectPtr<UChanneldLoadTestBot> WeakThis(this);
+	Connection->Auth(FString::Printf(TEXT("LoadTestBot%d"), BotIndex), TEXT(""), [WeakThis](const channeldpb::AuthResultMessage* AuthResultMsg)
+	{
+		if (!WeakThis.IsValid())
+		{
+			return;
+		}
+		if (AuthResultMsg->result() == channeldpb::AuthResultMessage_AuthResult_SUCCESSFUL)
+		{
+			WeakThis->OnAuthenticated();
+		}
+		else
+		{
+			UE_LOG(LogChanneldLoadTest, Warning, TEXT("Bot %d failed to authenticate"), WeakThis->BotIndex);
+		}
+	});
+	Connection->TickOutgoing();
+	return true;
+}
+
+void UChanneldLoadTestBot::Stop()
+{
+	if (Connection)
+	{
+		Connection->Disconnect();
+		Connection->Deinitialize();
+		Connection = nullptr;
+	}
+	bAuthenticated = false;
+}
+
+bool UChanneldLoadTestBot::IsConnected() const
+{
+	return Connection && Connection->IsConnected();
+}
+
+void UChanneldLoadTestBot::OnAuthenticated()
+{
+	bAuthenticated = true;
+	UE_LOG(LogChanneldLoadTest, Verbose, TEXT("Bot %d authenticated, connId: %d"), BotIndex, Connection->GetConnId());
+}
+
+void UChanneldLoadTestBot::Tick(float DeltaTime)
+{
+	if (!IsConnected())
+	{
+		return;
+	}
+
+	Connection->TickIncoming();
+
+	if (bAuthenticated)
+	{
+		Simulate(DeltaTime);
+
+		SendTimer -= DeltaTime;
+		if (SendTimer <= 0.f)
+		{
+			SendInput();
+			SendTimer += 1.f / FMath::Max(Script.InputSendRate, 1.f);
+		}
+
+		if (Script.PingInterval > 0.f)
+		{
+			PingTimer -= DeltaTime;
+			if (PingTimer <= 0.f)
+			{
+				SendPing();
+				PingTimer += Script.PingInterval;
+			}
+		}
+	}
+
+	Connection->TickOutgoing();
+}
+
+void UChanneldLoadTestBot::Simulate(float DeltaTime)
+{
+	static const float Gravity = -980.f;
+	static const float JumpZVelocity = 420.f;
+
+	bool bMoving = true;
+	if (Script.Steps.Num() > 0 && StepIndex < Script.Steps.Num())
+	{
+		const FChanneldBotInputStep& Step = Script.Steps[StepIndex];
+		const bool bStepStarted = StepTime == 0.f;
+		switch (Step.Input)
+		{
+		case EChanneldBotInput::Turn:
+			Yaw += Step.Duration > 0.f ? Step.Value * FMath::Min(DeltaTime, Step.Duration - StepTime) / Step.Duration : Step.Value;
+			break;
+		case EChanneldBotInput::Jump:
+			if (bStepStarted && Location.Z <= 0.f)
+			{
+				VelocityZ = JumpZVelocity;
+			}
+			break;
+		case EChanneldBotInput::Wait:
+			bMoving = false;
+			break;
+		default:
+			break;
+		}
+
+		StepTime += DeltaTime;
+		if (StepTime >= Step.Duration)
+		{
+			StepTime = 0.f;
+			StepIndex++;
+			if (StepIndex >= Script.Steps.Num() && Script.bLoop)
+			{
+				StepIndex = 0;
+			}
+		}
+	}
+
+	// The chances are per second, so scale them by the frame time.
+	if (Random.FRand() < Script.RandomTurnChance * DeltaTime)
+	{
+		Yaw += Random.RandRange(0, 1) ? 90.f : -90.f;
+	}
+	if (Location.Z <= 0.f && Random.FRand() < Script.RandomJumpChance * DeltaTime)
+	{
+		VelocityZ = JumpZVelocity;
+	}
+
+	// Turn around when hitting the bounds.
+	if (FMath::Abs(Location.X) > Script.BoundsExtent || FMath::Abs(Location.Y) > Script.BoundsExtent)
+	{
+		Yaw = FMath::RadiansToDegrees(FMath::Atan2(-Location.Y, -Location.X));
+	}
+	Yaw = FRotator::ClampAxis(Yaw);
+
+	const FVector Forward = FRotator(0.f, Yaw, 0.f).Vector();
+	Velocity = bMoving ? Forward * Script.MoveSpeed : FVector::ZeroVector;
+	VelocityZ = Location.Z > 0.f || VelocityZ > 0.f ? VelocityZ + Gravity * DeltaTime : 0.f;
+	Velocity.Z = VelocityZ;
+	Location += Velocity * DeltaTime;
+	if (Location.Z < 0.f)
+	{
+		Location.Z = 0.f;
+		VelocityZ = 0.f;
+	}
+}
+
+void UChanneldLoadTestBot::SendInput()
+{
+	unrealpb::FRepMovement Msg;
+	Msg.mutable_location()->set_x(Location.X);
+	Msg.mutable_location()->set_y(Location.Y);
+	Msg.mutable_location()->set_z(Location.Z);
+	Msg.mutable_rotation()->set_y(Yaw);
+	Msg.mutable_linearvelocity()->set_x(Velocity.X);
+	Msg.mutable_linearvelocity()->set_y(Velocity.Y);
+	Msg.mutable_linearvelocity()->set_z(Velocity.Z);
+	Connection->Send(Channeld::GlobalChannelId, Channeld::LoadTestInputMsgType, Msg);
+}
+
+void UChanneldLoadTestBot::SendPing()
+{
+	// channeld answers the LIST_CHANNEL itself, and the filter matches no channel, so the result is small.
+	static const TArray<FString> PingFilter = {TEXT("__channeld_load_test_ping__")};
+	const double SendTime = FPlatformTime::Seconds();
+	TWeakObjectPtr<UChanneldLoadTestBot> WeakThis(this);
+	Connection->ListChannel(channeldpb::UNKNOWN, &PingFilter, [WeakThis, SendTime](const channeldpb::ListChannelResultMessage*)
+	{
+		if (WeakThis.IsValid())
+		{
+			WeakThis->RttSamples.Add((FPlatformTime::Seconds() - SendTime) * 1000.0);
+		}
+	});
+}
+
+TArray<float> UChanneldLoadTestBot::ConsumeRttSamples()
+{
+	return MoveTemp(RttSamples);
+}
+
+void UChanneldLoadTestBot::ConsumeTraffic(int64& OutSentBytes, int64& OutReceivedBytes, int64& OutSentMsgs, int64& OutReceivedMsgs)
+{
+	OutSentBytes = OutReceivedBytes = OutSentMsgs = OutReceivedMsgs = 0;
+	if (Connection == nullptr)
+	{
+		return;
+	}
+
+	// The bots' connections are not drained by UChanneldMetrics, so the counters are reset here.
+	FChanneldTrafficStats& Stats = Connection->TrafficStats;
+	OutSentBytes = Stats.Packets[FChanneldTrafficStats::Sent].Bytes.Reset();
+	OutReceivedBytes = Stats.Packets[FChanneldTrafficStats::Received].Bytes.Reset();
+	for (uint32 MsgType = 0; MsgType <= FChanneldTrafficStats::MaxMsgTypes; MsgType++)
+	{
+		for (int32 Category = 0; Category < FChanneldTrafficStats::NumChannelCategories; Category++)
+		{
+			FChanneldTrafficStats::FSlot& SentSlot = Stats.Slots[FChanneldTrafficStats::Sent][MsgType][Category];
+			if (SentSlot.Messages.GetValue() != 0)
+			{
+				OutSentMsgs += SentSlot.Messages.Reset();
+			}
+			FChanneldTrafficStats::FSlot& ReceivedSlot = Stats.Slots[FChanneldTrafficStats::Received][MsgType][Category];
+			if (ReceivedSlot.Messages.GetValue() != 0)
+			{
+				OutReceivedMsgs += ReceivedSlot.Messages.Reset();
+			}
+		}
+	}
+}
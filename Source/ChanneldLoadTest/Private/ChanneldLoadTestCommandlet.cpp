@@ -0,0 +1,55 @@
+#include "ChanneldLoadTestCommandlet.h"
+
+#include "ChanneldLoadTest.h"
+#include "ChanneldLoadTestRunner.h"
+
+UChanneldLoadTestCommandlet::UChanneldLoadTestCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UChanneldLoadTestCommandlet::Main(const FString& Params)
+{
+	FChanneldLoadTestParams LoadTestParams;
+	if (!FChanneldLoadTestParams::ParseCommandLine(*Params, LoadTestParams))
+	{
+		UE_LOG(LogChanneldLoadTest, Error, TEXT("Invalid load test parameters: %s"), *Params);
+		return 1;
+	}
+
+	// 0 means running until the process is terminated.
+	float Duration = 0;
+	FParse::Value(*Params, TEXT("LoadTestDuration="), Duration);
+	float TickRate = 30;
+	FParse::Value(*Params, TEXT("LoadTestTickRate="), TickRate);
+	const double TickInterval = 1.0 / FMath::Max(TickRate, 1.f);
+
+	UChanneldLoadTestRunner* Runner = NewObject<UChanneldLoadTestRunner>();
+	Runner->AddToRoot();
+	Runner->Start(LoadTestParams);
+
+	const double StartTime = FPlatformTime::Seconds();
+	double LastTime = StartTime;
+	while (!IsEngineExitRequested() && (Duration <= 0 || LastTime - StartTime < Duration))
+	{
+		const double Now = FPlatformTime::Seconds();
+		const float DeltaTime = Now - LastTime;
+		LastTime = Now;
+
+		// The Prometheus exposer serves on its own threads, so only the bots need to be ticked here.
+		Runner->Tick(DeltaTime);
+
+		const double SleepTime = TickInterval - (FPlatformTime::Seconds() - Now);
+		if (SleepTime > 0)
+		{
+			FPlatformProcess::Sleep(SleepTime);
+		}
+	}
+
+	Runner->Stop();
+	Runner->RemoveFromRoot();
+	return 0;
+}
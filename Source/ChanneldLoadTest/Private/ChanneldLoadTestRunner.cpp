@@ -0,0 +1,166 @@
+#include "ChanneldLoadTestRunner.h"
+
+#include "ChanneldLoadTest.h"
+#include "ChanneldMetrics.h"
+#include "ChanneldSettings.h"
+
+bool FChanneldLoadTestParams::ParseCommandLine(const TCHAR* CmdLine, FChanneldLoadTestParams& OutParams)
+{
+	const UChanneldSettings* Settings = GetDefault<UChanneldSettings>();
+	OutParams.Host = Settings->ChanneldIpForClient;
+	OutParams.Port = Settings->ChanneldPortForClient;
+
+	FParse::Value(CmdLine, TEXT("LoadTestBots="), OutParams.NumBots);
+	FParse::Value(CmdLine, TEXT("LoadTestSpawnRate="), OutParams.SpawnRate);
+	FParse::Value(CmdLine, TEXT("LoadTestHost="), OutParams.Host);
+	FParse::Value(CmdLine, TEXT("LoadTestPort="), OutParams.Port);
+	FParse::Value(CmdLine, TEXT("LoadTestReportInterval="), OutParams.ReportInterval);
+
+	FString ScriptPath;
+	if (FParse::Value(CmdLine, TEXT("LoadTestScript="), ScriptPath))
+	{
+		if (!FChanneldBotScript::LoadFromFile(ScriptPath, OutParams.Script))
+		{
+			return false;
+		}
+		UE_LOG(LogChanneldLoadTest, Log, TEXT("Loaded the bot script from %s, steps: %d"), *ScriptPath, OutParams.Script.Steps.Num());
+	}
+	return OutParams.NumBots > 0;
+}
+
+void UChanneldLoadTestRunner::Start(const FChanneldLoadTestParams& InParams)
+{
+	Params = InParams;
+	SpawnBudget = 1.f;
+	ReportTimer = Params.ReportInterval;
+	NumFailedBots = 0;
+	NumAuthenticatedBots = 0;
+	TotalSentBytes = TotalReceivedBytes = TotalSentMsgs = TotalReceivedMsgs = 0;
+	InitMetrics();
+	UE_LOG(LogChanneldLoadTest, Log, TEXT("Starting %d bots to %s:%d, %.1f bots per second"), Params.NumBots, *Params.Host, Params.Port, Params.SpawnRate);
+}
+
+void UChanneldLoadTestRunner::Stop()
+{
+	for (UChanneldLoadTestBot* Bot : Bots)
+	{
+		Bot->Stop();
+	}
+	Bots.Reset();
+}
+
+void UChanneldLoadTestRunner::InitMetrics()
+{
+	if (Rtt_Histogram != nullptr)
+	{
+		return;
+	}
+
+	UMetricsSubsystem* Metrics = GEngine->GetEngineSubsystem<UMetricsSubsystem>();
+	Family<Gauge>& BotsFamily = Metrics->AddGaugeFamily(FName("ue_loadtest_bots"), TEXT("Number of the load test bots, by state"));
+	ConnectedBots_Gauge = &BotsFamily.Add({{"state", "connected"}});
+	AuthenticatedBots_Gauge = &BotsFamily.Add({{"state", "authenticated"}});
+
+	static const Histogram::BucketBoundaries RttBuckets = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000};
+	Rtt_Histogram = &Metrics->AddHistogramFamily(FName("ue_loadtest_rtt_ms"), TEXT("Milliseconds of the round trip from the load test bots to channeld")).Add({}, RttBuckets);
+
+	Family<Counter>& BytesFamily = Metrics->AddCounterFamily(FName("ue_loadtest_bytes"), TEXT("Bytes sent and received by the load test bots"));
+	SentBytes_Counter = &BytesFamily.Add({{"direction", "sent"}});
+	ReceivedBytes_Counter = &BytesFamily.Add({{"direction", "received"}});
+
+	Family<Counter>& MsgsFamily = Metrics->AddCounterFamily(FName("ue_loadtest_msgs"), TEXT("Number of the messages sent and received by the load test bots"));
+	SentMsgs_Counter = &MsgsFamily.Add({{"direction", "sent"}});
+	ReceivedMsgs_Counter = &MsgsFamily.Add({{"direction", "received"}});
+}
+
+void UChanneldLoadTestRunner::Tick(float DeltaTime)
+{
+	if (Bots.Num() + NumFailedBots < Params.NumBots)
+	{
+		SpawnBudget += Params.SpawnRate * DeltaTime;
+		UChanneldMetrics* ChanneldMetrics = GEngine->GetEngineSubsystem<UChanneldMetrics>();
+		while (SpawnBudget >= 1.f && Bots.Num() + NumFailedBots < Params.NumBots)
+		{
+			SpawnBudget -= 1.f;
+			UChanneldLoadTestBot* Bot = NewObject<UChanneldLoadTestBot>(this);
+			if (Bot->Start(Bots.Num() + NumFailedBots, Params.Host, Params.Port, Params.Script, ChanneldMetrics))
+			{
+				Bots.Add(Bot);
+			}
+			else
+			{
+				Bot->Stop();
+				NumFailedBots++;
+			}
+		}
+	}
+
+	for (UChanneldLoadTestBot* Bot : Bots)
+	{
+		Bot->Tick(DeltaTime);
+	}
+
+	ReportTimer -= DeltaTime;
+	if (ReportTimer <= 0.f)
+	{
+		Report();
+		ReportTimer += FMath::Max(Params.ReportInterval, 1.f);
+	}
+}
+
+void UChanneldLoadTestRunner::Report()
+{
+	int32 NumConnected = 0;
+	int32 NumAuthenticated = 0;
+	int64 SentBytes = 0, ReceivedBytes = 0, SentMsgs = 0, ReceivedMsgs = 0;
+	TArray<float> RttSamples;
+	for (UChanneldLoadTestBot* Bot : Bots)
+	{
+		if (Bot->IsConnected())
+		{
+			NumConnected++;
+		}
+		if (Bot->IsAuthenticated())
+		{
+			NumAuthenticated++;
+		}
+		int64 BotSentBytes, BotReceivedBytes, BotSentMsgs, BotReceivedMsgs;
+		Bot->ConsumeTraffic(BotSentBytes, BotReceivedBytes, BotSentMsgs, BotReceivedMsgs);
+		SentBytes += BotSentBytes;
+		ReceivedBytes += BotReceivedBytes;
+		SentMsgs += BotSentMsgs;
+		ReceivedMsgs += BotReceivedMsgs;
+		RttSamples.Append(Bot->ConsumeRttSamples());
+	}
+
+	NumAuthenticatedBots = NumAuthenticated;
+	TotalSentBytes += SentBytes;
+	TotalReceivedBytes += ReceivedBytes;
+	TotalSentMsgs += SentMsgs;
+	TotalReceivedMsgs += ReceivedMsgs;
+
+	ConnectedBots_Gauge->Set(NumConnected);
+	AuthenticatedBots_Gauge->Set(NumAuthenticated);
+	SentBytes_Counter->Increment(SentBytes);
+	ReceivedBytes_Counter->Increment(ReceivedBytes);
+	SentMsgs_Counter->Increment(SentMsgs);
+	ReceivedMsgs_Counter->Increment(ReceivedMsgs);
+	for (const float Rtt : RttSamples)
+	{
+		Rtt_Histogram->Observe(Rtt);
+	}
+
+	const float Interval = FMath::Max(Params.ReportInterval, 1.f);
+	float RttP50 = 0.f, RttP99 = 0.f;
+	if (RttSamples.Num() > 0)
+	{
+		RttSamples.Sort();
+		RttP50 = RttSamples[RttSamples.Num() / 2];
+		RttP99 = RttSamples[FMath::Min(RttSamples.Num() - 1, RttSamples.Num() * 99 / 100)];
+	}
+	UE_LOG(LogChanneldLoadTest, Log, TEXT("Bots: %d connected, %d authenticated, %d failed | Sent: %.1f KB/s, %.0f msg/s | Received: %.1f KB/s, %.0f msg/s | RTT p50: %.1fms, p99: %.1fms"),
+		NumConnected, NumAuthenticated, NumFailedBots,
+		SentBytes / 1024.f / Interval, SentMsgs / Interval,
+		ReceivedBytes / 1024.f / Interval, ReceivedMsgs / Interval,
+		RttP50, RttP99);
+}
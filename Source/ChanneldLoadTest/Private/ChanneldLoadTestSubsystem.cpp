@@ -0,0 +1,36 @@
+#include "ChanneldLoadTestSubsystem.h"
+
+#include "ChanneldLoadTest.h"
+#include "ChanneldLoadTestRunner.h"
+
+bool UChanneldLoadTestSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return FCString::Strifind(FCommandLine::Get(), TEXT("LoadTestBots=")) != nullptr;
+}
+
+void UChanneldLoadTestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	FChanneldLoadTestParams Params;
+	if (!FChanneldLoadTestParams::ParseCommandLine(FCommandLine::Get(), Params))
+	{
+		UE_LOG(LogChanneldLoadTest, Error, TEXT("Invalid load test parameters, the bots are not started"));
+		return;
+	}
+
+	Runner = NewObject<UChanneldLoadTestRunner>(this);
+	Runner->Start(Params);
+}
+
+void UChanneldLoadTestSubsystem::Deinitialize()
+{
+	if (Runner)
+	{
+		Runner->Stop();
+		Runner = nullptr;
+	}
+}
+
+void UChanneldLoadTestSubsystem::Tick(float DeltaTime)
+{
+	Runner->Tick(DeltaTime);
+}
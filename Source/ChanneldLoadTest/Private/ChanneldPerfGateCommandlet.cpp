@@ -0,0 +1,418 @@
+#include "ChanneldPerfGateCommandlet.h"
+
+#include "ChanneldLoadTest.h"
+#include "ChanneldLoadTestRunner.h"
+#include "HttpModule.h"
+#include "JsonObjectConverter.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+// Sums the samples of each metric in the Prometheus text format over the labels.
+static void ParsePrometheusText(const FString& Text, TMap<FString, double>& OutValues)
+{
+	TArray<FString> Lines;
+	Text.ParseIntoArrayLines(Lines);
+	for (const FString& Line : Lines)
+	{
+		if (Line.IsEmpty() || Line[0] == TEXT('#'))
+		{
+			continue;
+		}
+		int32 NameEnd = INDEX_NONE;
+		for (int32 i = 0; i < Line.Len(); i++)
+		{
+			if (Line[i] == TEXT('{') || Line[i] == TEXT(' '))
+			{
+				NameEnd = i;
+				break;
+			}
+		}
+		if (NameEnd <= 0)
+		{
+			continue;
+		}
+		int32 ValueStart = NameEnd;
+		if (Line[NameEnd] == TEXT('{'))
+		{
+			ValueStart = Line.Find(TEXT("}"), ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+			if (ValueStart == INDEX_NONE)
+			{
+				continue;
+			}
+			ValueStart++;
+		}
+		// The optional timestamp after the value is ignored.
+		FString ValueStr = Line.Mid(ValueStart).TrimStart();
+		int32 SpaceIndex;
+		if (ValueStr.FindChar(TEXT(' '), SpaceIndex))
+		{
+			ValueStr.LeftInline(SpaceIndex);
+		}
+		OutValues.FindOrAdd(Line.Left(NameEnd)) += FCString::Atod(*ValueStr);
+	}
+}
+
+static bool ScrapeMetrics(const FString& Url, TMap<FString, double>& OutValues, double Timeout = 5.0)
+{
+	auto Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(Url);
+	Request->SetVerb(TEXT("GET"));
+	if (!Request->ProcessRequest())
+	{
+		return false;
+	}
+
+	// There's no engine loop in the commandlet, so the HTTP manager is ticked here.
+	const double StartTime = FPlatformTime::Seconds();
+	double LastTime = StartTime;
+	while (Request->GetStatus() == EHttpRequestStatus::Processing && LastTime - StartTime < Timeout)
+	{
+		FPlatformProcess::Sleep(0.01f);
+		const double Now = FPlatformTime::Seconds();
+		FHttpModule::Get().GetHttpManager().Tick(Now - LastTime);
+		LastTime = Now;
+	}
+	const FHttpResponsePtr Response = Request->GetResponse();
+	if (Request->GetStatus() != EHttpRequestStatus::Succeeded || !Response.IsValid() || Response->GetResponseCode() != 200)
+	{
+		Request->CancelRequest();
+		return false;
+	}
+	ParsePrometheusText(Response->GetContentAsString(), OutValues);
+	return true;
+}
+
+UChanneldPerfGateCommandlet::UChanneldPerfGateCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UChanneldPerfGateCommandlet::Main(const FString& Params)
+{
+	FChanneldPerfResults Results;
+	if (!FParse::Value(*Params, TEXT("Map="), Results.Map))
+	{
+		UE_LOG(LogChanneldLoadTest, Error, TEXT("-Map= is required"));
+		return 1;
+	}
+	Results.Scenario = FPaths::GetBaseFilename(Results.Map);
+	FParse::Value(*Params, TEXT("Scenario="), Results.Scenario);
+	FParse::Value(*Params, TEXT("ViewClass="), Results.ViewClass);
+	Results.NumServers = 1;
+	FParse::Value(*Params, TEXT("Servers="), Results.NumServers);
+
+	float Duration = 300.f, Warmup = 30.f, SampleInterval = 5.f, ServerStartDelay = 20.f;
+	FParse::Value(*Params, TEXT("Duration="), Duration);
+	FParse::Value(*Params, TEXT("Warmup="), Warmup);
+	FParse::Value(*Params, TEXT("SampleInterval="), SampleInterval);
+	FParse::Value(*Params, TEXT("ServerStartDelay="), ServerStartDelay);
+	SampleInterval = FMath::Max(SampleInterval, 1.f);
+	FString ServerArgs, ChanneldBin, ChanneldArgs, ChanneldMetricsList;
+	FParse::Value(*Params, TEXT("ServerArgs="), ServerArgs, false);
+	FParse::Value(*Params, TEXT("ChanneldBin="), ChanneldBin);
+	FParse::Value(*Params, TEXT("ChanneldArgs="), ChanneldArgs, false);
+	FString ChanneldMetricsUrl = TEXT("http://127.0.0.1:8080/metrics");
+	FParse::Value(*Params, TEXT("ChanneldMetricsUrl="), ChanneldMetricsUrl);
+	// The standard process metrics of the Go client. The others depend on the version of channeld.
+	ChanneldMetricsList = TEXT("process_cpu_seconds_total,process_resident_memory_bytes");
+	FParse::Value(*Params, TEXT("ChanneldMetrics="), ChanneldMetricsList);
+	TArray<FString> ChanneldMetricNames;
+	ChanneldMetricsList.ParseIntoArray(ChanneldMetricNames, TEXT(","));
+	int32 ServerMetricsPort = 8090;
+	FParse::Value(*Params, TEXT("ServerMetricsPort="), ServerMetricsPort);
+
+	const FString OutputDir = FPaths::ProjectSavedDir() / TEXT("ChanneldPerfGate");
+	FString ResultsPath = OutputDir / Results.Scenario + TEXT(".json");
+	FParse::Value(*Params, TEXT("Results="), ResultsPath);
+	FString BaselinePath = OutputDir / TEXT("Baseline_") + Results.Scenario + TEXT(".json");
+	FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+	float FpsTolerance = 0.1f, BytesTolerance = 0.1f, MinFps = 0.f, MaxBytesPerPlayer = 0.f;
+	FParse::Value(*Params, TEXT("FpsTolerance="), FpsTolerance);
+	FParse::Value(*Params, TEXT("BytesTolerance="), BytesTolerance);
+	FParse::Value(*Params, TEXT("MinFps="), MinFps);
+	FParse::Value(*Params, TEXT("MaxBytesPerPlayer="), MaxBytesPerPlayer);
+
+	FChanneldLoadTestParams LoadTestParams;
+	LoadTestParams.NumBots = 150;
+	FParse::Value(*Params, TEXT("Bots="), LoadTestParams.NumBots);
+	if (!FChanneldLoadTestParams::ParseCommandLine(*Params, LoadTestParams))
+	{
+		UE_LOG(LogChanneldLoadTest, Error, TEXT("Invalid load test parameters: %s"), *Params);
+		return 1;
+	}
+	LoadTestParams.ReportInterval = SampleInterval;
+
+	// Launch channeld, unless it's already running.
+	if (!ChanneldBin.IsEmpty())
+	{
+		FString WorkingDir = FPlatformMisc::GetEnvironmentVariable(TEXT("CHANNELD_PATH"));
+		if (WorkingDir.IsEmpty())
+		{
+			WorkingDir = FPaths::GetPath(ChanneldBin);
+		}
+		FProcHandle ChanneldProc = FPlatformProcess::CreateProc(*ChanneldBin, *ChanneldArgs, false, true, true, nullptr, 0, *WorkingDir, nullptr, nullptr);
+		if (!ChanneldProc.IsValid())
+		{
+			UE_LOG(LogChanneldLoadTest, Error, TEXT("Failed to launch channeld: %s %s"), *ChanneldBin, *ChanneldArgs);
+			return 1;
+		}
+		LaunchedProcs.Add(ChanneldProc);
+		FPlatformProcess::Sleep(2.f);
+	}
+
+	// Launch the servers the same way as the editor, with their own Prometheus ports.
+	const FString ServerExePath = FPlatformProcess::ExecutablePath();
+	const FString ProjectPath = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+	TArray<FString> ServerMetricsUrls;
+	for (int32 i = 0; i < Results.NumServers; i++)
+	{
+		const int32 Port = ServerMetricsPort + i;
+		FString ServerParams = FString::Printf(TEXT("\"%s\" %s -game -server -log -unattended -nullrhi -channeld=True -metrics=True -prometheusPort=%d -SessionName=\"PerfGate - Server %d\" %s"),
+			*ProjectPath, *Results.Map, Port, i, *ServerArgs);
+		if (!Results.ViewClass.IsEmpty())
+		{
+			ServerParams += FString::Printf(TEXT(" ViewClass=%s"), *Results.ViewClass);
+		}
+		FProcHandle ServerProc = FPlatformProcess::CreateProc(*ServerExePath, *ServerParams, false, true, true, nullptr, 0, nullptr, nullptr, nullptr);
+		if (!ServerProc.IsValid())
+		{
+			UE_LOG(LogChanneldLoadTest, Error, TEXT("Failed to launch server %d: %s"), i, *ServerParams);
+			TerminateLaunchedProcs();
+			return 1;
+		}
+		LaunchedProcs.Add(ServerProc);
+		ServerMetricsUrls.Add(FString::Printf(TEXT("http://127.0.0.1:%d/metrics"), Port));
+	}
+	UE_LOG(LogChanneldLoadTest, Display, TEXT("Launched %d servers of %s, waiting %.0fs for them to start"), Results.NumServers, *Results.Map, ServerStartDelay);
+	FPlatformProcess::Sleep(ServerStartDelay);
+
+	UChanneldLoadTestRunner* Runner = NewObject<UChanneldLoadTestRunner>();
+	Runner->AddToRoot();
+	Runner->Start(LoadTestParams);
+
+	const double TickInterval = 1.0 / 30.0;
+	double LastTickTime = FPlatformTime::Seconds();
+	auto TickFor = [&](double Seconds)
+	{
+		const double EndTime = FPlatformTime::Seconds() + Seconds;
+		while (!IsEngineExitRequested() && FPlatformTime::Seconds() < EndTime)
+		{
+			const double Now = FPlatformTime::Seconds();
+			Runner->Tick(Now - LastTickTime);
+			LastTickTime = Now;
+			const double SleepTime = TickInterval - (FPlatformTime::Seconds() - Now);
+			if (SleepTime > 0)
+			{
+				FPlatformProcess::Sleep(SleepTime);
+			}
+		}
+	};
+
+	// Spawn all the bots, then let the servers and channeld settle.
+	const float SpawnTime = LoadTestParams.NumBots / FMath::Max(LoadTestParams.SpawnRate, 0.1f);
+	UE_LOG(LogChanneldLoadTest, Display, TEXT("Spawning %d bots in %.0fs, warming up for %.0fs"), LoadTestParams.NumBots, SpawnTime, Warmup);
+	TickFor(SpawnTime + Warmup);
+
+	auto SampleServers = [&](TArray<TMap<FString, double>>& OutServerValues)
+	{
+		OutServerValues.SetNum(ServerMetricsUrls.Num());
+		for (int32 i = 0; i < ServerMetricsUrls.Num(); i++)
+		{
+			OutServerValues[i].Reset();
+			if (!ScrapeMetrics(ServerMetricsUrls[i], OutServerValues[i]))
+			{
+				UE_LOG(LogChanneldLoadTest, Warning, TEXT("Failed to scrape the metrics of server %d: %s"), i, *ServerMetricsUrls[i]);
+			}
+		}
+	};
+	auto SampleChanneld = [&](TMap<FString, double>& OutValues)
+	{
+		TMap<FString, double> AllValues;
+		if (!ScrapeMetrics(ChanneldMetricsUrl, AllValues))
+		{
+			UE_LOG(LogChanneldLoadTest, Warning, TEXT("Failed to scrape the metrics of channeld: %s"), *ChanneldMetricsUrl);
+		}
+		for (const FString& Name : ChanneldMetricNames)
+		{
+			OutValues.Add(Name, AllValues.FindRef(Name));
+		}
+	};
+
+	// The counters are measured from the start of the measurement.
+	TArray<TMap<FString, double>> StartServerValues, ServerValues;
+	TMap<FString, double> StartChanneldValues;
+	SampleServers(StartServerValues);
+	SampleChanneld(StartChanneldValues);
+	const int64 StartReceivedBytes = Runner->GetTotalReceivedBytes();
+	const int64 StartSentBytes = Runner->GetTotalSentBytes();
+	const int64 StartReceivedMsgs = Runner->GetTotalReceivedMsgs();
+	const double StartTime = FPlatformTime::Seconds();
+
+	double SumFps = 0, SumCpu = 0, SumMem = 0, SumBots = 0;
+	int32 NumServerSamples = 0;
+	Results.MinServerFps = MAX_flt;
+	while (!IsEngineExitRequested() && FPlatformTime::Seconds() - StartTime < Duration)
+	{
+		TickFor(SampleInterval);
+
+		FChanneldPerfSample& Sample = Results.Samples.AddDefaulted_GetRef();
+		Sample.Time = FPlatformTime::Seconds() - StartTime;
+		Sample.NumBots = Runner->GetNumAuthenticatedBots();
+		SumBots += Sample.NumBots;
+		SampleServers(ServerValues);
+		for (const TMap<FString, double>& Values : ServerValues)
+		{
+			const float Fps = Values.FindRef(TEXT("ue_server_fps"));
+			Sample.ServerFps.Add(Fps);
+			SumFps += Fps;
+			SumCpu += Values.FindRef(TEXT("ue_server_cpu"));
+			SumMem += Values.FindRef(TEXT("ue_server_mem"));
+			Results.MinServerFps = FMath::Min(Results.MinServerFps, Fps);
+			NumServerSamples++;
+		}
+		SampleChanneld(Sample.ChanneldMetrics);
+		UE_LOG(LogChanneldLoadTest, Display, TEXT("[%.0fs] Bots: %d, server FPS: %s"), Sample.Time, Sample.NumBots,
+			*FString::JoinBy(Sample.ServerFps, TEXT(", "), [](float Fps) { return FString::Printf(TEXT("%.1f"), Fps); }));
+	}
+
+	const double MeasuredTime = FMath::Max(FPlatformTime::Seconds() - StartTime, 1.0);
+	const int64 ReceivedBytes = Runner->GetTotalReceivedBytes() - StartReceivedBytes;
+	const int64 SentBytes = Runner->GetTotalSentBytes() - StartSentBytes;
+	const int64 ReceivedMsgs = Runner->GetTotalReceivedMsgs() - StartReceivedMsgs;
+	Runner->Stop();
+	Runner->RemoveFromRoot();
+	TerminateLaunchedProcs();
+
+	const int32 NumSamples = Results.Samples.Num();
+	Results.Duration = MeasuredTime;
+	Results.NumBots = NumSamples > 0 ? SumBots / NumSamples : 0.f;
+	if (NumServerSamples > 0)
+	{
+		Results.AvgServerFps = SumFps / NumServerSamples;
+		Results.AvgServerCpu = SumCpu / NumServerSamples;
+		Results.AvgServerMemMB = SumMem / NumServerSamples;
+	}
+	else
+	{
+		Results.MinServerFps = 0.f;
+	}
+	double Handovers = 0;
+	for (int32 i = 0; i < ServerValues.Num() && i < StartServerValues.Num(); i++)
+	{
+		Handovers += ServerValues[i].FindRef(TEXT("ue_handovers")) - StartServerValues[i].FindRef(TEXT("ue_handovers"));
+	}
+	Results.HandoversPerSecond = Handovers / MeasuredTime;
+	const double BotSeconds = FMath::Max(Results.NumBots, 1.f) * MeasuredTime;
+	Results.BytesPerPlayer = ReceivedBytes / BotSeconds;
+	Results.SentBytesPerPlayer = SentBytes / BotSeconds;
+	Results.MsgsPerPlayer = ReceivedMsgs / BotSeconds;
+	for (const FString& Name : ChanneldMetricNames)
+	{
+		if (NumSamples == 0)
+		{
+			break;
+		}
+		if (Name.EndsWith(TEXT("_total")))
+		{
+			Results.ChanneldMetrics.Add(Name, (Results.Samples.Last().ChanneldMetrics.FindRef(Name) - StartChanneldValues.FindRef(Name)) / MeasuredTime);
+		}
+		else
+		{
+			double Sum = 0;
+			for (const FChanneldPerfSample& Sample : Results.Samples)
+			{
+				Sum += Sample.ChanneldMetrics.FindRef(Name);
+			}
+			Results.ChanneldMetrics.Add(Name, Sum / NumSamples);
+		}
+	}
+
+	UE_LOG(LogChanneldLoadTest, Display, TEXT("%s: %.0f bots, %d servers | FPS avg: %.1f, min: %.1f | CPU: %.1f%%, memory: %.0fMB | %.0f B/s per player (sent: %.0f B/s) | %.2f handovers/s"),
+		*Results.Scenario, Results.NumBots, Results.NumServers, Results.AvgServerFps, Results.MinServerFps, Results.AvgServerCpu, Results.AvgServerMemMB,
+		Results.BytesPerPlayer, Results.SentBytesPerPlayer, Results.HandoversPerSecond);
+
+	FString Json;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(Results, Json) || !FFileHelper::SaveStringToFile(Json, *ResultsPath))
+	{
+		UE_LOG(LogChanneldLoadTest, Error, TEXT("Failed to save the results to %s"), *ResultsPath);
+		return 1;
+	}
+	UE_LOG(LogChanneldLoadTest, Display, TEXT("Saved the results to %s"), *ResultsPath);
+
+	if (FParse::Param(*Params, TEXT("SaveBaseline")))
+	{
+		if (!FFileHelper::SaveStringToFile(Json, *BaselinePath))
+		{
+			UE_LOG(LogChanneldLoadTest, Error, TEXT("Failed to save the baseline to %s"), *BaselinePath);
+			return 1;
+		}
+		UE_LOG(LogChanneldLoadTest, Display, TEXT("Saved the baseline to %s"), *BaselinePath);
+		return 0;
+	}
+	return CheckRegression(Results, BaselinePath, FpsTolerance, BytesTolerance, MinFps, MaxBytesPerPlayer) ? 0 : 1;
+}
+
+void UChanneldPerfGateCommandlet::TerminateLaunchedProcs()
+{
+	for (FProcHandle& Proc : LaunchedProcs)
+	{
+		if (FPlatformProcess::IsProcRunning(Proc))
+		{
+			FPlatformProcess::TerminateProc(Proc, true);
+		}
+		FPlatformProcess::CloseProc(Proc);
+	}
+	LaunchedProcs.Reset();
+}
+
+bool UChanneldPerfGateCommandlet::CheckRegression(const FChanneldPerfResults& Results, const FString& BaselinePath, float FpsTolerance, float BytesTolerance, float MinFps, float MaxBytesPerPlayer) const
+{
+	bool bPassed = true;
+	if (Results.Samples.Num() == 0 || Results.NumBots <= 0.f)
+	{
+		UE_LOG(LogChanneldLoadTest, Error, TEXT("No bot was connected during the measurement"));
+		bPassed = false;
+	}
+	if (MinFps > 0.f && Results.AvgServerFps < MinFps)
+	{
+		UE_LOG(LogChanneldLoadTest, Error, TEXT("The average server FPS %.1f is below %.1f"), Results.AvgServerFps, MinFps);
+		bPassed = false;
+	}
+	if (MaxBytesPerPlayer > 0.f && Results.BytesPerPlayer > MaxBytesPerPlayer)
+	{
+		UE_LOG(LogChanneldLoadTest, Error, TEXT("The bytes per player %.0f B/s is above %.0f B/s"), Results.BytesPerPlayer, MaxBytesPerPlayer);
+		bPassed = false;
+	}
+
+	FString Json;
+	FChanneldPerfResults Baseline;
+	if (!FFileHelper::LoadFileToString(Json, *BaselinePath) || !FJsonObjectConverter::JsonObjectStringToUStruct(Json, &Baseline, 0, 0))
+	{
+		UE_LOG(LogChanneldLoadTest, Display, TEXT("No perf baseline at %s. Run with -SaveBaseline to create one."), *BaselinePath);
+		return bPassed;
+	}
+	if (Baseline.NumServers != Results.NumServers || FMath::Abs(Baseline.NumBots - Results.NumBots) > FMath::Max(1.f, Baseline.NumBots * 0.05f))
+	{
+		UE_LOG(LogChanneldLoadTest, Warning, TEXT("The baseline was recorded with %d servers and %.0f bots, but the scenario ran with %d servers and %.0f bots"),
+			Baseline.NumServers, Baseline.NumBots, Results.NumServers, Results.NumBots);
+	}
+	if (Results.AvgServerFps < Baseline.AvgServerFps * (1.f - FpsTolerance))
+	{
+		UE_LOG(LogChanneldLoadTest, Error, TEXT("The average server FPS regressed: %.1f, baseline: %.1f"), Results.AvgServerFps, Baseline.AvgServerFps);
+		bPassed = false;
+	}
+	if (Results.BytesPerPlayer > Baseline.BytesPerPlayer * (1.f + BytesTolerance))
+	{
+		UE_LOG(LogChanneldLoadTest, Error, TEXT("The bytes per player regressed: %.0f B/s, baseline: %.0f B/s"), Results.BytesPerPlayer, Baseline.BytesPerPlayer);
+		bPassed = false;
+	}
+	if (bPassed)
+	{
+		UE_LOG(LogChanneldLoadTest, Display, TEXT("No regression from the baseline %s"), *BaselinePath);
+	}
+	return bPassed;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "google/protobuf/message.h"
+#include "ChanneldBenchmark.generated.h"
+
+USTRUCT()
+struct FChanneldBenchmarkResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Name;
+
+	UPROPERTY()
+	double NsPerOp = 0;
+
+	UPROPERTY()
+	double AllocsPerOp = 0;
+};
+
+USTRUCT()
+struct FChanneldBenchmarkBaseline
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 NumEntities = 0;
+
+	UPROPERTY()
+	TArray<FChanneldBenchmarkResult> Results;
+};
+
+/**
+ * Microbenchmarks of the hot paths of the plugin on synthetic channel data: the Merge() of the registered channel data processors,
+ * the Tick() of the character replicators, the vector helpers of ChanneldUtils, and the packet assembly of UChanneldConnection.
+ * Each benchmark reports the time and the heap allocations per operation. Run by UChanneldBenchmarkCommandlet.
+ */
+class CHANNELDLOADTEST_API FChanneldBenchmarkSuite
+{
+public:
+	explicit FChanneldBenchmarkSuite(int32 InNumEntities, double InMinSeconds = 1.0) : NumEntities(InNumEntities), MinSeconds(InMinSeconds) {}
+
+	// Run the benchmarks whose names contain the filter (all if empty).
+	void RunAll(const FString& Filter = FString());
+
+	FORCEINLINE const TArray<FChanneldBenchmarkResult>& GetResults() const { return Results; }
+
+	/**
+	 * Compare the results with the baseline. Logs the benchmarks that are slower, or allocate more, than the baseline by more than Tolerance (e.g. 0.1 for 10%).
+	 * @return False if any benchmark regressed.
+	 */
+	bool CompareWithBaseline(const FChanneldBenchmarkBaseline& Baseline, double Tolerance) const;
+
+	// Fill every map field of the message with NumEntries entries, and the fields of the entries with random values. Used for the channel data of any type.
+	static void FillSyntheticMessage(google::protobuf::Message* Msg, int32 NumEntries, FRandomStream& Random, int32 Depth = 0);
+
+private:
+	int32 NumEntities;
+	double MinSeconds;
+	TArray<FChanneldBenchmarkResult> Results;
+	FString CurrentFilter;
+
+	// Run Op repeatedly for at least MinSeconds, and record the average time and allocations. Each call of Op counts as OpsPerCall operations.
+	void Run(const FString& Name, TFunctionRef<void()> Op, int32 OpsPerCall = 1);
+
+	void RunProcessorMerges();
+	void RunCharacterReplicatorTick();
+	void RunVectorHelpers();
+	void RunPacketAssembly();
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ChanneldBenchmarkCommandlet.generated.h"
+
+/**
+ * Runs FChanneldBenchmarkSuite and compares the results with the stored baseline:
+ * -run=ChanneldBenchmark [-Entities=1000] [-MinSeconds=1] [-Filter=Merge] [-Baseline=Path.json] [-SaveBaseline] [-Tolerance=0.1]
+ * Returns 1 if any benchmark regressed, so it can gate a release build.
+ */
+UCLASS()
+class CHANNELDLOADTEST_API UChanneldBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UChanneldBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
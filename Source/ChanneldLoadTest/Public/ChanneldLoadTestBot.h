@@ -0,0 +1,129 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChanneldTypes.h"
+#include "ChanneldLoadTestBot.generated.h"
+
+class UChanneldConnection;
+class UChanneldMetrics;
+
+UENUM()
+enum class EChanneldBotInput : uint8
+{
+	MoveForward,
+	// Turn by Value degrees, spread over the Duration of the step.
+	Turn,
+	Jump,
+	// Stand still.
+	Wait,
+};
+
+USTRUCT()
+struct FChanneldBotInputStep
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EChanneldBotInput Input = EChanneldBotInput::MoveForward;
+
+	UPROPERTY()
+	float Duration = 1.f;
+
+	UPROPERTY()
+	float Value = 0.f;
+};
+
+/**
+ * The inputs the bots replay. Loaded from a JSON file with -LoadTestScript=, or the default one that matches the simulated client behavior
+ * in docs/benchmark.md: move forward continuously, with a 10% chance of turning and a 10% chance of jumping every second.
+ */
+USTRUCT()
+struct FChanneldBotScript
+{
+	GENERATED_BODY()
+
+	// Played in order. An empty script keeps moving forward.
+	UPROPERTY()
+	TArray<FChanneldBotInputStep> Steps;
+
+	UPROPERTY()
+	bool bLoop = true;
+
+	// The chance per second of turning left or right by 90 degrees, on top of the steps.
+	UPROPERTY()
+	float RandomTurnChance = 0.1f;
+
+	// The chance per second of jumping, on top of the steps.
+	UPROPERTY()
+	float RandomJumpChance = 0.1f;
+
+	UPROPERTY()
+	float MoveSpeed = 600.f;
+
+	// The bot turns around when it leaves the box of this half size around the origin, in place of hitting an obstacle.
+	UPROPERTY()
+	float BoundsExtent = 20000.f;
+
+	// How many times per second the bot sends its movement to channeld.
+	UPROPERTY()
+	float InputSendRate = 30.f;
+
+	// How often the bot measures the round trip time to channeld. 0 disables the measurement.
+	UPROPERTY()
+	float PingInterval = 1.f;
+
+	static bool LoadFromFile(const FString& FilePath, FChanneldBotScript& OutScript);
+};
+
+/**
+ * A lightweight client that talks to channeld through its own UChanneldConnection, without a UNetDriver, a world or rendering.
+ * After the auth, it replays the script and sends its simulated movement to the global channel as LoadTestInputMsgType messages,
+ * so the channeld and server side of the pipeline see the traffic of a moving client.
+ */
+UCLASS(transient)
+class CHANNELDLOADTEST_API UChanneldLoadTestBot : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	bool Start(int32 InBotIndex, const FString& Host, int32 Port, const FChanneldBotScript& InScript, UChanneldMetrics* Metrics);
+	void Stop();
+	void Tick(float DeltaTime);
+
+	bool IsConnected() const;
+	FORCEINLINE bool IsAuthenticated() const { return bAuthenticated; }
+
+	// The round trip times measured since the last call, in milliseconds.
+	TArray<float> ConsumeRttSamples();
+	// The bytes and the number of the messages on the wire since the last call.
+	void ConsumeTraffic(int64& OutSentBytes, int64& OutReceivedBytes, int64& OutSentMsgs, int64& OutReceivedMsgs);
+
+private:
+
+	UPROPERTY()
+	UChanneldConnection* Connection;
+
+	int32 BotIndex = 0;
+	bool bAuthenticated = false;
+	FChanneldBotScript Script;
+	FRandomStream Random;
+
+	int32 StepIndex = 0;
+	float StepTime = 0.f;
+	float SendTimer = 0.f;
+	float PingTimer = 0.f;
+
+	FVector Location = FVector::ZeroVector;
+	float Yaw = 0.f;
+	float VelocityZ = 0.f;
+	FVector Velocity = FVector::ZeroVector;
+
+	TArray<float> RttSamples;
+
+	void OnAuthenticated();
+	// Advance the script and the random inputs, and integrate the movement.
+	void Simulate(float DeltaTime);
+	void SendInput();
+	void SendPing();
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ChanneldLoadTestCommandlet.generated.h"
+
+class UChanneldLoadTestRunner;
+
+/**
+ * Runs the load test bots without a world: -run=ChanneldLoadTest -LoadTestBots=200 [-LoadTestDuration=600] [-LoadTestTickRate=30]
+ * See FChanneldLoadTestParams for the other parameters.
+ */
+UCLASS()
+class CHANNELDLOADTEST_API UChanneldLoadTestCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UChanneldLoadTestCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChanneldLoadTestBot.h"
+#include "MetricsSubsystem.h"
+#include "ChanneldLoadTestRunner.generated.h"
+
+struct FChanneldLoadTestParams
+{
+	int32 NumBots = 100;
+	// How many bots are connected per second, so channeld and the servers are not flooded by the logins.
+	float SpawnRate = 20.f;
+	FString Host = TEXT("127.0.0.1");
+	int32 Port = 12108;
+	// How often the latency and throughput are logged and reported to Prometheus.
+	float ReportInterval = 5.f;
+	FChanneldBotScript Script;
+
+	// Read from the command line: -LoadTestBots=, -LoadTestSpawnRate=, -LoadTestHost=, -LoadTestPort=, -LoadTestReportInterval= and -LoadTestScript=.
+	// The host and port default to ChanneldIpForClient and ChanneldPortForClient of UChanneldSettings.
+	static bool ParseCommandLine(const TCHAR* CmdLine, FChanneldLoadTestParams& OutParams);
+};
+
+/**
+ * Runs the load test bots in the calling process. Ticked by UChanneldLoadTestCommandlet (without a world),
+ * or by UChanneldLoadTestSubsystem (in a running game).
+ */
+UCLASS(transient)
+class CHANNELDLOADTEST_API UChanneldLoadTestRunner : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	void Start(const FChanneldLoadTestParams& InParams);
+	void Stop();
+	void Tick(float DeltaTime);
+
+	FORCEINLINE int32 GetNumBots() const { return Bots.Num(); }
+	FORCEINLINE int32 GetNumAuthenticatedBots() const { return NumAuthenticatedBots; }
+	FORCEINLINE int32 GetNumFailedBots() const { return NumFailedBots; }
+	// The traffic of all the bots since the start, updated at each report.
+	FORCEINLINE int64 GetTotalSentBytes() const { return TotalSentBytes; }
+	FORCEINLINE int64 GetTotalReceivedBytes() const { return TotalReceivedBytes; }
+	FORCEINLINE int64 GetTotalSentMsgs() const { return TotalSentMsgs; }
+	FORCEINLINE int64 GetTotalReceivedMsgs() const { return TotalReceivedMsgs; }
+
+private:
+
+	UPROPERTY()
+	TArray<UChanneldLoadTestBot*> Bots;
+
+	FChanneldLoadTestParams Params;
+	float SpawnBudget = 0.f;
+	float ReportTimer = 0.f;
+	int32 NumFailedBots = 0;
+	int32 NumAuthenticatedBots = 0;
+	int64 TotalSentBytes = 0;
+	int64 TotalReceivedBytes = 0;
+	int64 TotalSentMsgs = 0;
+	int64 TotalReceivedMsgs = 0;
+
+	Gauge* ConnectedBots_Gauge = nullptr;
+	Gauge* AuthenticatedBots_Gauge = nullptr;
+	Histogram* Rtt_Histogram = nullptr;
+	Counter* SentBytes_Counter = nullptr;
+	Counter* ReceivedBytes_Counter = nullptr;
+	Counter* SentMsgs_Counter = nullptr;
+	Counter* ReceivedMsgs_Counter = nullptr;
+
+	void InitMetrics();
+	void Report();
+};
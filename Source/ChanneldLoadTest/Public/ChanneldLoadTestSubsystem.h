@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "ChanneldLoadTestSubsystem.generated.h"
+
+class UChanneldLoadTestRunner;
+
+/**
+ * Runs the load test bots alongside a running game, when it's launched with -LoadTestBots=N. The bots don't use the game's world,
+ * so the game can be the same client that has its simulated proxies' Tick disabled as in docs/benchmark.md.
+ * Use UChanneldLoadTestCommandlet to run the bots without a world.
+ */
+UCLASS()
+class CHANNELDLOADTEST_API UChanneldLoadTestSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return !IsTemplate() && Runner != nullptr; }
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UChanneldLoadTestSubsystem, STATGROUP_Tickables); }
+	//~ End FTickableGameObject Interface
+
+private:
+
+	UPROPERTY()
+	UChanneldLoadTestRunner* Runner;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ChanneldPerfGateCommandlet.generated.h"
+
+USTRUCT()
+struct FChanneldPerfSample
+{
+	GENERATED_BODY()
+
+	// Seconds since the start of the measurement
+	UPROPERTY()
+	float Time = 0.f;
+
+	UPROPERTY()
+	int32 NumBots = 0;
+
+	// The ue_server_fps of each server, or 0 if the server didn't respond.
+	UPROPERTY()
+	TArray<float> ServerFps;
+
+	// The metrics of channeld listed by -ChanneldMetrics, summed over the labels.
+	UPROPERTY()
+	TMap<FString, double> ChanneldMetrics;
+};
+
+USTRUCT()
+struct FChanneldPerfResults
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Scenario;
+
+	UPROPERTY()
+	FString Map;
+
+	UPROPERTY()
+	FString ViewClass;
+
+	UPROPERTY()
+	int32 NumServers = 0;
+
+	// The number of the authenticated bots, averaged over the samples.
+	UPROPERTY()
+	float NumBots = 0.f;
+
+	// Seconds of the measurement, after the bots are spawned and warmed up.
+	UPROPERTY()
+	float Duration = 0.f;
+
+	UPROPERTY()
+	float AvgServerFps = 0.f;
+
+	UPROPERTY()
+	float MinServerFps = 0.f;
+
+	UPROPERTY()
+	float AvgServerCpu = 0.f;
+
+	UPROPERTY()
+	float AvgServerMemMB = 0.f;
+
+	UPROPERTY()
+	float HandoversPerSecond = 0.f;
+
+	// Bytes per second received by each bot from channeld
+	UPROPERTY()
+	float BytesPerPlayer = 0.f;
+
+	// Bytes per second sent by each bot to channeld
+	UPROPERTY()
+	float SentBytesPerPlayer = 0.f;
+
+	UPROPERTY()
+	float MsgsPerPlayer = 0.f;
+
+	// The averages of the sampled channeld metrics. The counters (named *_total) are converted to the rates per second.
+	UPROPERTY()
+	TMap<FString, double> ChanneldMetrics;
+
+	UPROPERTY()
+	TArray<FChanneldPerfSample> Samples;
+};
+
+/**
+ * Runs a benchmark scenario of docs/benchmark.md and gates the regressions. Launches channeld (if -ChanneldBin is set) and the
+ * servers with the map and the view class, starts the headless bots of UChanneldLoadTestRunner in this process, samples the
+ * Prometheus metrics of the servers and channeld, and writes the results as JSON:
+ *
+ * -run=ChanneldPerfGate -Map=/Game/Maps/TestReplication [-Scenario=Single] [-ViewClass=/Script/ChanneldUE.SingleChannelDataView]
+ *     [-Servers=1] [-Bots=150] [-Duration=300] [-Warmup=30] [-SampleInterval=5] [-ServerStartDelay=20] [-ServerArgs="..."]
+ *     [-ChanneldBin=Path] [-ChanneldArgs="..."] [-ChanneldMetricsUrl=http://127.0.0.1:8080/metrics] [-ChanneldMetrics=a,b]
+ *     [-ServerMetricsPort=8090] [-Results=Path.json] [-Baseline=Path.json] [-SaveBaseline]
+ *     [-FpsTolerance=0.1] [-BytesTolerance=0.1] [-MinFps=0] [-MaxBytesPerPlayer=0]
+ *
+ * Returns 1 if the average server FPS or the bytes per player regressed past the tolerance of the baseline, or past the absolute limits.
+ */
+UCLASS()
+class CHANNELDLOADTEST_API UChanneldPerfGateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UChanneldPerfGateCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	TArray<FProcHandle> LaunchedProcs;
+
+	void TerminateLaunchedProcs();
+	bool CheckRegression(const FChanneldPerfResults& Results, const FString& BaselinePath, float FpsTolerance, float BytesTolerance, float MinFps, float MaxBytesPerPlayer) const;
+};
@@ -0,0 +1,94 @@
+#include "ChannelDataInterfaces.h"
+
+bool IChannelDataProcessor::GetNetGUIDsInChannelData(const google::protobuf::Message* ChannelData, TSet<uint32>& OutNetGUIDs)
+{
+	using google::protobuf::FieldDescriptor;
+	const google::protobuf::Reflection* Reflection = ChannelData->GetReflection();
+	std::vector<const FieldDescriptor*> Fields;
+	Reflection->ListFields(*ChannelData, &Fields);
+	for (const FieldDescriptor* Field : Fields)
+	{
+		if (!Field->is_map())
+		{
+			return false;
+		}
+		const FieldDescriptor* KeyField = Field->message_type()->map_key();
+		if (KeyField->cpp_type() != FieldDescriptor::CPPTYPE_UINT32)
+		{
+			return false;
+		}
+		
+		const int Num = Reflection->FieldSize(*ChannelData, Field);
+		for (int i = 0; i < Num; i++)
+		{
+			const google::protobuf::Message& Entry = Reflection->GetRepeatedMessage(*ChannelData, Field, i);
+			OutNetGUIDs.Add(Entry.GetReflection()->GetUInt32(Entry, KeyField));
+		}
+	}
+	return true;
+}
+
+int32 IChannelDataProcessor::EraseRemovedStatesInChannelData(google::protobuf::Message* ChannelData)
+{
+	using google::protobuf::FieldDescriptor;
+	const google::protobuf::Reflection* Reflection = ChannelData->GetReflection();
+	std::vector<const FieldDescriptor*> Fields;
+	Reflection->ListFields(*ChannelData, &Fields);
+	std::vector<const FieldDescriptor*> StateMapFields;
+	TSet<uint32> RemovedNetGUIDs;
+	for (const FieldDescriptor* Field : Fields)
+	{
+		if (!Field->is_map() || Field->message_type()->map_key()->cpp_type() != FieldDescriptor::CPPTYPE_UINT32)
+		{
+			continue;
+		}
+		StateMapFields.push_back(Field);
+
+		const FieldDescriptor* ValueField = Field->message_type()->map_value();
+		if (ValueField->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE)
+		{
+			continue;
+		}
+		const FieldDescriptor* RemovedField = ValueField->message_type()->FindFieldByName("removed");
+		if (RemovedField == nullptr || RemovedField->cpp_type() != FieldDescriptor::CPPTYPE_BOOL)
+		{
+			continue;
+		}
+
+		const int Num = Reflection->FieldSize(*ChannelData, Field);
+		for (int i = 0; i < Num; i++)
+		{
+			const google::protobuf::Message& Entry = Reflection->GetRepeatedMessage(*ChannelData, Field, i);
+			const google::protobuf::Message& State = Entry.GetReflection()->GetMessage(Entry, ValueField);
+			if (State.GetReflection()->GetBool(State, RemovedField))
+			{
+				RemovedNetGUIDs.Add(Entry.GetReflection()->GetUInt32(Entry, Field->message_type()->map_key()));
+			}
+		}
+	}
+
+	if (RemovedNetGUIDs.Num() == 0)
+	{
+		return 0;
+	}
+
+	// An object can have states in multiple maps (e.g. ActorState and CharacterState), but only one of them is marked as removed.
+	for (const FieldDescriptor* Field : StateMapFields)
+	{
+		const FieldDescriptor* KeyField = Field->message_type()->map_key();
+		for (int i = Reflection->FieldSize(*ChannelData, Field) - 1; i >= 0; i--)
+		{
+			const google::protobuf::Message& Entry = Reflection->GetRepeatedMessage(*ChannelData, Field, i);
+			if (RemovedNetGUIDs.Contains(Entry.GetReflection()->GetUInt32(Entry, KeyField)))
+			{
+				const int Last = Reflection->FieldSize(*ChannelData, Field) - 1;
+				if (i != Last)
+				{
+					Reflection->SwapElements(ChannelData, Field, i, Last);
+				}
+				Reflection->RemoveLast(ChannelData, Field);
+			}
+		}
+	}
+	return RemovedNetGUIDs.Num();
+}
@@ -35,6 +35,31 @@ public:
 	virtual void SetRemoved(bool bInRemoved) = 0;
 	virtual bool UpdateChannelData(google::protobuf::Message* ChannelData) = 0;
 	virtual void OnChannelDataUpdated(google::protobuf::Message* ChannelData) = 0;
+	/**
+	 * @brief If true, UChannelDataView stops calling UpdateChannelData() until the provider calls UChannelDataView::WakeProvider(),
+	 * apart from a periodic check (see UChanneldSettings::SleepingProviderCheckInterval).
+	 */
+	virtual bool IsIdle() { return false; }
+	/**
+	 * @brief If true, UChannelDataView doesn't update the provider at all (not even by the periodic check) until it's not
+	 * dormant anymore. The scheduler also drops the provider until UChannelDataView::WakeProvider() is called. See AActor::NetDormancy.
+	 */
+	virtual bool IsDormant() { return false; }
+	/**
+	 * @brief If true, UpdateChannelData() can be called from a worker thread, along with the other thread-safe providers
+	 * (see UChanneldSettings::bParallelProviderCollection). The game thread is blocked meanwhile.
+	 */
+	virtual bool IsThreadSafeUpdate() { return false; }
+	// The seconds until the next UpdateChannelData() call, used by the replication scheduler (see UChanneldSettings::bScheduledReplication). 0 means every tick.
+	virtual float GetUpdateInterval() { return 0; }
+	// The higher the priority is, the sooner the provider is updated when the scheduler can't update all the due providers in a tick.
+	virtual float GetUpdatePriority() { return 1.0f; }
+	/**
+	 * @brief Get the NetGUIDs of the states the provider reads in OnChannelDataUpdated(), so UChannelDataView only notifies
+	 * the provider of the updates that contain any of them.
+	 * @return False if the NetGUIDs are not known (yet). Such provider is notified of every update.
+	 */
+	virtual bool GetNetGUIDs(TArray<uint32>& OutNetGUIDs) { return false; }
 	
 	static FString GetName(const IChannelDataProvider* Provider)
 	{
@@ -52,6 +77,19 @@ class CHANNELDUE_API IChannelDataProcessor
 {
 public:
 	virtual bool Merge(const google::protobuf::Message* SrcMsg, google::protobuf::Message* DstMsg) = 0;
+	/**
+	 * @brief Same as Merge(), but the states new to DstMsg can be swapped out of SrcMsg instead of deep copied.
+	 * Used when SrcMsg is a temporary message that is parsed again before the next use.
+	 */
+	virtual bool MergeMove(google::protobuf::Message* SrcMsg, google::protobuf::Message* DstMsg) { return Merge(SrcMsg, DstMsg); }
+	/**
+	 * @brief Merge the serialized channel data into DstMsg in a single pass, with the same result as parsing it and calling Merge().
+	 * See ChannelDataMerge.h for the helpers.
+	 * @return False if the bytes are malformed. DstMsg can be partially merged in that case.
+	 */
+	virtual bool MergeFromString(const std::string& SrcBytes, google::protobuf::Message* DstMsg) { return false; }
+	// If false, UChannelDataView parses the channel data into a temporary message and calls Merge().
+	virtual bool SupportsMergeFromString() const { return false; }
 
 	virtual bool UpdateChannelData(UObject* TargetObj, google::protobuf::Message* ChannelData) {return true;}
 	virtual bool OnChannelDataUpdated(UObject* TargetObj, google::protobuf::Message* ChannelData) {return true;}
@@ -66,6 +104,20 @@ public:
 	 * @param NetGUID The NetworkGUID used for looking up the state in the channel data. Generally the key of the state map.
 	 */
 	virtual void SetStateToChannelData(const google::protobuf::Message* State, google::protobuf::Message* ChannelData, UClass* TargetClass, UObject* TargetObject, uint32 NetGUID) = 0;
+
+	/**
+	 * @brief Get the NetGUIDs of the states in the channel data, so UChannelDataView only notifies the affected providers.
+	 * The default implementation collects the keys of the map<uint32, State> fields via reflection.
+	 * @return False if the channel data contains any state that is not keyed by NetGUID, so all the providers should be notified.
+	 */
+	virtual bool GetNetGUIDsInChannelData(const google::protobuf::Message* ChannelData, TSet<uint32>& OutNetGUIDs);
+
+	/**
+	 * @brief Erase all the states of the objects that have any state with removed = true, so the removal is not replayed to a provider added later.
+	 * The default implementation looks for the removed field of the map<uint32, State> values via reflection.
+	 * @return The number of the objects erased.
+	 */
+	virtual int32 EraseRemovedStatesInChannelData(google::protobuf::Message* ChannelData);
 	
 	virtual ~IChannelDataProcessor() {}
 };
\ No newline at end of file
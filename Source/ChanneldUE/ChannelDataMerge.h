@@ -0,0 +1,152 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+#include "google/protobuf/map.h"
+
+/**
+ * Helpers for IChannelDataProcessor::MergeFromString(). The serialized channel data is merged into the existing message
+ * field by field, without parsing it into an intermediate message first.
+ */
+namespace ChannelDataMerge
+{
+	using google::protobuf::io::CodedInputStream;
+	using google::protobuf::internal::WireFormatLite;
+
+	constexpr uint32 MapKeyTag = (1 << 3) | WireFormatLite::WIRETYPE_VARINT;
+	constexpr uint32 MapValueTag = (2 << 3) | WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+
+	FORCEINLINE bool IsLengthDelimited(uint32 Tag)
+	{
+		return WireFormatLite::GetTagWireType(Tag) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+	}
+
+	// Merge a length-delimited message field into Dst, same as Dst->MergeFrom() with the parsed field.
+	template <typename MsgType>
+	bool MergeMessage(CodedInputStream& Input, MsgType* Dst)
+	{
+		const CodedInputStream::Limit Limit = Input.ReadLengthAndPushLimit();
+		const bool bOk = Dst->MergePartialFromCodedStream(&Input) && Input.ConsumedEntireMessage();
+		Input.PopLimit(Limit);
+		return bOk;
+	}
+
+	/**
+	 * Read a map entry, calling OnValue(Key, Input) to parse the value in place. The protobuf serializers always write
+	 * the key before the value, but the format doesn't require it, so a value that comes first is copied and parsed
+	 * after the entry is read.
+	 */
+	template <typename FuncType>
+	bool ReadMapEntry(CodedInputStream& Input, FuncType&& OnValue)
+	{
+		const CodedInputStream::Limit Limit = Input.ReadLengthAndPushLimit();
+		uint32 Key = 0;
+		bool bHasKey = false;
+		bool bValueParsed = false;
+		bool bHasDeferredValue = false;
+		std::string DeferredValue;
+		bool bOk = true;
+		while (bOk)
+		{
+			const uint32 Tag = Input.ReadTag();
+			if (Tag == 0)
+			{
+				break;
+			}
+			if (Tag == MapKeyTag)
+			{
+				bOk = Input.ReadVarint32(&Key);
+				bHasKey = true;
+			}
+			else if (Tag == MapValueTag && bHasKey)
+			{
+				const CodedInputStream::Limit ValueLimit = Input.ReadLengthAndPushLimit();
+				bOk = OnValue(Key, Input) && Input.ConsumedEntireMessage();
+				Input.PopLimit(ValueLimit);
+				bValueParsed = true;
+			}
+			else if (Tag == MapValueTag)
+			{
+				bOk = WireFormatLite::ReadBytes(&Input, &DeferredValue);
+				bHasDeferredValue = true;
+			}
+			else
+			{
+				bOk = WireFormatLite::SkipField(&Input, Tag);
+			}
+		}
+		bOk = bOk && Input.ConsumedEntireMessage();
+		Input.PopLimit(Limit);
+		if (!bOk)
+		{
+			return false;
+		}
+
+		if (!bValueParsed)
+		{
+			// An entry without the value still adds the default state, same as parsing the map.
+			CodedInputStream ValueInput(reinterpret_cast<const uint8*>(DeferredValue.data()), bHasDeferredValue ? DeferredValue.size() : 0);
+			return OnValue(Key, ValueInput) && ValueInput.ConsumedEntireMessage();
+		}
+		return true;
+	}
+
+	/**
+	 * Merge a map<uint32, State> entry into Map. The state is merged into the existing one with the same key, or added
+	 * if there's none, same as the generated Merge().
+	 * @return The merged state, or nullptr if the entry is malformed.
+	 */
+	template <typename StateType>
+	StateType* MergeStateMapEntry(CodedInputStream& Input, google::protobuf::Map<uint32, StateType>& Map)
+	{
+		StateType* State = nullptr;
+		const bool bOk = ReadMapEntry(Input, [&Map, &State](uint32 Key, CodedInputStream& ValueInput)
+		{
+			State = &Map[Key];
+			return State->MergePartialFromCodedStream(&ValueInput);
+		});
+		return bOk ? State : nullptr;
+	}
+
+	// Parse a map<uint32, State> entry into OutState (cleared first), for the states that must be checked before merging.
+	template <typename StateType>
+	bool ReadStateMapEntry(CodedInputStream& Input, uint32& OutKey, StateType& OutState)
+	{
+		OutState.Clear();
+		return ReadMapEntry(Input, [&OutKey, &OutState](uint32 Key, CodedInputStream& ValueInput)
+		{
+			OutKey = Key;
+			return OutState.MergePartialFromCodedStream(&ValueInput);
+		});
+	}
+
+	template <typename StateType>
+	void MergeState(google::protobuf::Map<uint32, StateType>& Map, uint32 Key, const StateType& State)
+	{
+		auto Itr = Map.find(Key);
+		if (Itr != Map.end())
+		{
+			Itr->second.MergeFrom(State);
+		}
+		else
+		{
+			Map.emplace(Key, State);
+		}
+	}
+
+	// Same as above, but the existing state is merged by MergeFunc(StateType* Dst, const StateType* Src), e.g. the generated field-by-field merge.
+	template <typename StateType, typename MergeFuncType>
+	void MergeState(google::protobuf::Map<uint32, StateType>& Map, uint32 Key, const StateType& State, MergeFuncType&& MergeFunc)
+	{
+		auto Itr = Map.find(Key);
+		if (Itr != Map.end())
+		{
+			MergeFunc(&Itr->second, &State);
+		}
+		else
+		{
+			Map.emplace(Key, State);
+		}
+	}
+}
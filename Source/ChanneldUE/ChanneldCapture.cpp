@@ -0,0 +1,85 @@
+#include "ChanneldCapture.h"
+#include "ChanneldTypes.h"
+#include "HAL/FileManager.h"
+
+bool FChanneldCaptureWriter::Open(const FString& FilePath)
+{
+	FScopeLock Lock(&WriterLock);
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to open the capture file: %s"), *FilePath);
+		return false;
+	}
+
+	uint32 Magic = ChanneldCapture::Magic;
+	uint32 Version = ChanneldCapture::Version;
+	*Writer << Magic << Version;
+	StartTime = FPlatformTime::Seconds();
+	UE_LOG(LogChanneld, Log, TEXT("Started capturing the traffic to %s"), *FilePath);
+	return true;
+}
+
+void FChanneldCaptureWriter::Close()
+{
+	FScopeLock Lock(&WriterLock);
+	if (Writer.IsValid())
+	{
+		Writer->Close();
+		Writer.Reset();
+	}
+}
+
+void FChanneldCaptureWriter::Write(ChanneldCapture::EDirection Direction, const uint8* Data, int32 Size)
+{
+	FScopeLock Lock(&WriterLock);
+	if (!Writer.IsValid() || Size <= 0)
+	{
+		return;
+	}
+
+	uint8 DirectionByte = static_cast<uint8>(Direction);
+	double Time = FPlatformTime::Seconds() - StartTime;
+	*Writer << DirectionByte << Time << Size;
+	Writer->Serialize(const_cast<uint8*>(Data), Size);
+}
+
+bool FChanneldCaptureReader::Load(const FString& FilePath, FString& Error)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader.IsValid())
+	{
+		Error = FString::Printf(TEXT("Failed to open the capture file: %s"), *FilePath);
+		return false;
+	}
+
+	uint32 Magic = 0, Version = 0;
+	*Reader << Magic << Version;
+	if (Magic != ChanneldCapture::Magic || Version != ChanneldCapture::Version)
+	{
+		Error = FString::Printf(TEXT("Invalid capture file: %s, magic: %x, version: %d"), *FilePath, Magic, Version);
+		return false;
+	}
+
+	Records.Reset();
+	while (!Reader->AtEnd())
+	{
+		uint8 DirectionByte;
+		double Time;
+		int32 Size;
+		*Reader << DirectionByte << Time << Size;
+		if (Reader->IsError() || Size <= 0 || Size > Reader->TotalSize() - Reader->Tell())
+		{
+			// A capture that is not closed properly can end with a partial record.
+			UE_LOG(LogChanneld, Warning, TEXT("Truncated capture file: %s, loaded %d records"), *FilePath, Records.Num());
+			break;
+		}
+
+		ChanneldCapture::FRecord& Record = Records.AddDefaulted_GetRef();
+		Record.Direction = static_cast<ChanneldCapture::EDirection>(DirectionByte);
+		Record.Time = Time;
+		Record.Data.SetNumUninitialized(Size);
+		Reader->Serialize(Record.Data.GetData(), Size);
+	}
+	return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The capture file of the traffic between UChanneldConnection and channeld. Consists of a header (Magic, Version)
+ * followed by the records. The bytes are the raw stream, i.e. the packets with their headers, possibly split or
+ * coalesced the same way as they were read from or written to the transport.
+ */
+namespace ChanneldCapture
+{
+	static constexpr uint32 Magic = 0x50434443; // "CDCP"
+	static constexpr uint32 Version = 1;
+
+	enum class EDirection : uint8
+	{
+		Incoming = 0,
+		Outgoing = 1,
+	};
+
+	struct FRecord
+	{
+		EDirection Direction;
+		// Seconds since the capture started.
+		double Time;
+		TArray<uint8> Data;
+	};
+}
+
+// Appends the records to a capture file. Thread-safe, as the receive thread and the send thread can write at the same time.
+class CHANNELDUE_API FChanneldCaptureWriter
+{
+public:
+	~FChanneldCaptureWriter() { Close(); }
+
+	bool Open(const FString& FilePath);
+	void Close();
+	FORCEINLINE bool IsOpen() const { return Writer.IsValid(); }
+
+	void Write(ChanneldCapture::EDirection Direction, const uint8* Data, int32 Size);
+
+private:
+	TUniquePtr<FArchive> Writer;
+	FCriticalSection WriterLock;
+	double StartTime = 0;
+};
+
+// Reads all the records of a capture file into memory, so reading doesn't affect the timing of a replay.
+class CHANNELDUE_API FChanneldCaptureReader
+{
+public:
+	bool Load(const FString& FilePath, FString& Error);
+
+	TArray<ChanneldCapture::FRecord> Records;
+};
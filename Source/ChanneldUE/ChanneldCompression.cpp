@@ -0,0 +1,258 @@
+#include "ChanneldCompression.h"
+
+namespace
+{
+	constexpr uint8 TagLiteral = 0x00;
+	constexpr uint8 TagCopy1 = 0x01;
+	constexpr uint8 TagCopy2 = 0x02;
+	constexpr uint8 TagCopy4 = 0x03;
+
+	constexpr uint32 HashTableBits = 12;
+	constexpr uint32 HashTableSize = 1 << HashTableBits;
+	constexpr uint32 MinMatchLength = 4;
+
+	FORCEINLINE uint32 Load32(const uint8* Ptr)
+	{
+		return Ptr[0] | (Ptr[1] << 8) | (Ptr[2] << 16) | (static_cast<uint32>(Ptr[3]) << 24);
+	}
+
+	FORCEINLINE uint32 HashBytes(uint32 Bytes)
+	{
+		return (Bytes * 0x1e35a7bd) >> (32 - HashTableBits);
+	}
+
+	uint8* EmitLiteral(uint8* Dst, const uint8* Literal, uint32 Len)
+	{
+		const uint32 N = Len - 1;
+		if (N < 60)
+		{
+			*Dst++ = TagLiteral | (N << 2);
+		}
+		else if (N < (1 << 8))
+		{
+			*Dst++ = TagLiteral | (60 << 2);
+			*Dst++ = N & 0xff;
+		}
+		else if (N < (1 << 16))
+		{
+			*Dst++ = TagLiteral | (61 << 2);
+			*Dst++ = N & 0xff;
+			*Dst++ = (N >> 8) & 0xff;
+		}
+		else
+		{
+			*Dst++ = TagLiteral | (62 << 2);
+			*Dst++ = N & 0xff;
+			*Dst++ = (N >> 8) & 0xff;
+			*Dst++ = (N >> 16) & 0xff;
+		}
+		FMemory::Memcpy(Dst, Literal, Len);
+		return Dst + Len;
+	}
+
+	uint8* EmitCopyUpTo64(uint8* Dst, uint32 Offset, uint32 Len)
+	{
+		if (Len < 12 && Offset < 2048)
+		{
+			*Dst++ = TagCopy1 | ((Len - 4) << 2) | ((Offset >> 8) << 5);
+			*Dst++ = Offset & 0xff;
+		}
+		else
+		{
+			*Dst++ = TagCopy2 | ((Len - 1) << 2);
+			*Dst++ = Offset & 0xff;
+			*Dst++ = (Offset >> 8) & 0xff;
+		}
+		return Dst;
+	}
+
+	uint8* EmitCopy(uint8* Dst, uint32 Offset, uint32 Len)
+	{
+		// Emit 64-byte copies, but make sure the remaining is at least 4 bytes.
+		while (Len >= 68)
+		{
+			Dst = EmitCopyUpTo64(Dst, Offset, 64);
+			Len -= 64;
+		}
+		if (Len > 64)
+		{
+			Dst = EmitCopyUpTo64(Dst, Offset, 60);
+			Len -= 60;
+		}
+		return EmitCopyUpTo64(Dst, Offset, Len);
+	}
+}
+
+uint32 ChanneldCompression::SnappyCompress(const uint8* Src, uint32 SrcSize, uint8* Dst)
+{
+	uint8* Out = Dst;
+
+	// Preamble: the uncompressed length as a varint.
+	uint32 Len = SrcSize;
+	while (Len >= 0x80)
+	{
+		*Out++ = (Len & 0x7f) | 0x80;
+		Len >>= 7;
+	}
+	*Out++ = Len;
+
+	if (SrcSize < MinMatchLength + 1)
+	{
+		if (SrcSize > 0)
+		{
+			Out = EmitLiteral(Out, Src, SrcSize);
+		}
+		return Out - Dst;
+	}
+
+	int32 HashTable[HashTableSize];
+	FMemory::Memset(HashTable, 0xff, sizeof(HashTable));
+
+	uint32 LiteralStart = 0;
+	uint32 Pos = 0;
+	const uint32 MatchLimit = SrcSize - MinMatchLength;
+	while (Pos <= MatchLimit)
+	{
+		const uint32 Bytes = Load32(Src + Pos);
+		const uint32 Hash = HashBytes(Bytes);
+		const int32 Candidate = HashTable[Hash];
+		HashTable[Hash] = Pos;
+
+		if (Candidate < 0 || Pos - Candidate > 0xffff || Load32(Src + Candidate) != Bytes)
+		{
+			Pos++;
+			continue;
+		}
+
+		if (Pos > LiteralStart)
+		{
+			Out = EmitLiteral(Out, Src + LiteralStart, Pos - LiteralStart);
+		}
+
+		uint32 MatchLen = MinMatchLength;
+		while (Pos + MatchLen < SrcSize && Src[Candidate + MatchLen] == Src[Pos + MatchLen])
+		{
+			MatchLen++;
+		}
+		Out = EmitCopy(Out, Pos - Candidate, MatchLen);
+
+		Pos += MatchLen;
+		LiteralStart = Pos;
+	}
+
+	if (LiteralStart < SrcSize)
+	{
+		Out = EmitLiteral(Out, Src + LiteralStart, SrcSize - LiteralStart);
+	}
+
+	return Out - Dst;
+}
+
+bool ChanneldCompression::SnappyUncompress(const uint8* Src, uint32 SrcSize, TArray<uint8>& OutData, uint32 MaxUncompressedSize)
+{
+	const uint8* Ptr = Src;
+	const uint8* End = Src + SrcSize;
+
+	uint32 UncompressedSize = 0;
+	for (uint32 Shift = 0; ; Shift += 7)
+	{
+		if (Ptr >= End || Shift > 28)
+		{
+			return false;
+		}
+		const uint8 B = *Ptr++;
+		UncompressedSize |= (B & 0x7f) << Shift;
+		if ((B & 0x80) == 0)
+		{
+			break;
+		}
+	}
+	if (UncompressedSize > MaxUncompressedSize)
+	{
+		return false;
+	}
+
+	const int32 StartOffset = OutData.Num();
+	OutData.AddUninitialized(UncompressedSize);
+	uint8* const OutBegin = OutData.GetData() + StartOffset;
+	uint8* Out = OutBegin;
+	uint8* const OutEnd = OutBegin + UncompressedSize;
+
+	while (Ptr < End)
+	{
+		const uint8 Tag = *Ptr++;
+		uint32 Len;
+		uint32 Offset;
+		switch (Tag & 0x03)
+		{
+		case TagLiteral:
+			{
+				Len = Tag >> 2;
+				if (Len >= 60)
+				{
+					const uint32 NumLenBytes = Len - 59;
+					if (Ptr + NumLenBytes > End)
+					{
+						return false;
+					}
+					Len = 0;
+					for (uint32 i = 0; i < NumLenBytes; i++)
+					{
+						Len |= Ptr[i] << (8 * i);
+					}
+					Ptr += NumLenBytes;
+				}
+				Len += 1;
+				if (Len > static_cast<uint32>(End - Ptr) || Len > static_cast<uint32>(OutEnd - Out))
+				{
+					return false;
+				}
+				FMemory::Memcpy(Out, Ptr, Len);
+				Ptr += Len;
+				Out += Len;
+				continue;
+			}
+		case TagCopy1:
+			if (Ptr + 1 > End)
+			{
+				return false;
+			}
+			Len = 4 + ((Tag >> 2) & 0x07);
+			Offset = ((Tag >> 5) << 8) | Ptr[0];
+			Ptr += 1;
+			break;
+		case TagCopy2:
+			if (Ptr + 2 > End)
+			{
+				return false;
+			}
+			Len = 1 + (Tag >> 2);
+			Offset = Ptr[0] | (Ptr[1] << 8);
+			Ptr += 2;
+			break;
+		default:
+			if (Ptr + 4 > End)
+			{
+				return false;
+			}
+			Len = 1 + (Tag >> 2);
+			Offset = Load32(Ptr);
+			Ptr += 4;
+			break;
+		}
+
+		if (Offset == 0 || Offset > static_cast<uint32>(Out - OutBegin) || Len > static_cast<uint32>(OutEnd - Out))
+		{
+			return false;
+		}
+		// The source and destination can overlap (e.g. repeated bytes), so copy byte by byte.
+		const uint8* CopySrc = Out - Offset;
+		for (uint32 i = 0; i < Len; i++)
+		{
+			Out[i] = CopySrc[i];
+		}
+		Out += Len;
+	}
+
+	return Out == OutEnd;
+}
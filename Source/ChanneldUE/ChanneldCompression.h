@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Minimal implementation of the Snappy block format (https://github.com/google/snappy/blob/main/format_description.txt),
+ * which is the format channeld uses for the packet compression (CompressionType = SNAPPY).
+ *
+ * The compressor only emits copies with 16-bit offsets, and literals up to 24-bit length, which covers
+ * Channeld::MaxLargePacketSize.
+ */
+class CHANNELDUE_API ChanneldCompression
+{
+public:
+	// The worst case of the compressed size of SrcSize bytes.
+	static uint32 SnappyMaxCompressedLength(uint32 SrcSize)
+	{
+		return 32 + SrcSize + SrcSize / 6;
+	}
+
+	/**
+	 * @brief Compress the source bytes into Dst.
+	 * @param Dst The destination buffer. Must be at least SnappyMaxCompressedLength(SrcSize) bytes.
+	 * @return The size of the compressed data written to Dst.
+	 */
+	static uint32 SnappyCompress(const uint8* Src, uint32 SrcSize, uint8* Dst);
+
+	/**
+	 * @brief Decompress the source bytes and append the result to the end of OutData.
+	 * @return False if the source bytes are corrupted, or the uncompressed size exceeds MaxUncompressedSize.
+	 */
+	static bool SnappyUncompress(const uint8* Src, uint32 SrcSize, TArray<uint8>& OutData, uint32 MaxUncompressedSize);
+};
@@ -2,11 +2,32 @@
 #include "ChanneldNetDriver.h"
 #include "ChanneldSettings.h"
 #include "ChanneldMetrics.h"
+#include "ChanneldCompression.h"
+#include "Misc/ScopeRWLock.h"
 #include "SocketSubsystem.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
 
 //DEFINE_LOG_CATEGORY(LogChanneld);
 
+TRACE_DECLARE_INT_COUNTER(ChanneldDispatchedMessages, TEXT("Channeld/DispatchedMessages"));
+TRACE_DECLARE_INT_COUNTER(ChanneldOutgoingQueueSize, TEXT("Channeld/OutgoingQueueSize"));
+
 void UChanneldConnection::Initialize(FSubsystemCollectionBase& Collection)
+{
+	// Created before the connection, so it's available throughout the connection's lifetime.
+	Metrics = Cast<UChanneldMetrics>(Collection.InitializeDependency(UChanneldMetrics::StaticClass()));
+	InitializeConnection();
+}
+
+void UChanneldConnection::InitializeStandalone(UChanneldMetrics* InMetrics)
+{
+	check(InMetrics);
+	Metrics = InMetrics;
+	InitializeConnection();
+}
+
+void UChanneldConnection::InitializeConnection()
 {
 	// Command line arguments can override the INI settings
 	const TCHAR* CmdLine = FCommandLine::Get();
@@ -22,22 +43,123 @@ void UChanneldConnection::Initialize(FSubsystemCollectionBase& Collection)
 	{
 		UE_LOG(LogChanneld, Log, TEXT("Parsed bShowUserSpaceMessageLog from CLI: %d"), bShowUserSpaceMessageLog);
 	}
+	if (FParse::Value(CmdLine, TEXT("CompressionThreshold="), CompressionThreshold))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed CompressionThreshold from CLI: %d"), CompressionThreshold);
+	}
+	if (FParse::Value(CmdLine, TEXT("RpcCallbackTimeoutSeconds="), RpcCallbackTimeoutSeconds))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed RpcCallbackTimeoutSeconds from CLI: %f"), RpcCallbackTimeoutSeconds);
+	}
+	if (FParse::Bool(CmdLine, TEXT("AllowLargePackets="), bAllowLargePackets))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bAllowLargePackets from CLI: %d"), bAllowLargePackets);
+	}
+	if (FParse::Value(CmdLine, TEXT("CriticalLaneBytesPerTick="), CriticalLaneBytesPerTick))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed CriticalLaneBytesPerTick from CLI: %d"), CriticalLaneBytesPerTick);
+	}
+	if (FParse::Value(CmdLine, TEXT("ChannelDataLaneBytesPerTick="), ChannelDataLaneBytesPerTick))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ChannelDataLaneBytesPerTick from CLI: %d"), ChannelDataLaneBytesPerTick);
+	}
+	if (FParse::Value(CmdLine, TEXT("BulkLaneBytesPerTick="), BulkLaneBytesPerTick))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed BulkLaneBytesPerTick from CLI: %d"), BulkLaneBytesPerTick);
+	}
+	if (FParse::Value(CmdLine, TEXT("SendPressureHighWaterBytes="), SendPressureHighWaterBytes))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed SendPressureHighWaterBytes from CLI: %d"), SendPressureHighWaterBytes);
+	}
+	if (FParse::Value(CmdLine, TEXT("SendPressureHighWaterMessages="), SendPressureHighWaterMessages))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed SendPressureHighWaterMessages from CLI: %d"), SendPressureHighWaterMessages);
+	}
+	if (FParse::Value(CmdLine, TEXT("MaxPooledMessagePacks="), MaxPooledMessagePacks))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MaxPooledMessagePacks from CLI: %d"), MaxPooledMessagePacks);
+	}
+	if (FParse::Value(CmdLine, TEXT("TraceSampleRate="), TraceSampleRate))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed TraceSampleRate from CLI: %f"), TraceSampleRate);
+	}
+	if (FParse::Value(CmdLine, TEXT("ChanneldCapture="), CaptureFilePath))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed CaptureFilePath from CLI: %s"), *CaptureFilePath);
+	}
+	if (FParse::Value(CmdLine, TEXT("ChanneldReplay="), ReplayFilePath))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ReplayFilePath from CLI: %s"), *ReplayFilePath);
+	}
+	if (FParse::Bool(CmdLine, TEXT("ReplayRealTime="), bReplayRealTime))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bReplayRealTime from CLI: %d"), bReplayRealTime);
+	}
+	if (FParse::Value(CmdLine, TEXT("ChanneldMatchRecord="), MatchRecordFilePath))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MatchRecordFilePath from CLI: %s"), *MatchRecordFilePath);
+	}
+	if (FParse::Value(CmdLine, TEXT("MatchRecordKeyframeInterval="), MatchRecordKeyframeInterval))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MatchRecordKeyframeInterval from CLI: %f"), MatchRecordKeyframeInterval);
+	}
+	if (FParse::Value(CmdLine, TEXT("ChanneldMatchPlayback="), MatchPlaybackFilePath))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MatchPlaybackFilePath from CLI: %s"), *MatchPlaybackFilePath);
+	}
+	if (FParse::Value(CmdLine, TEXT("MatchPlaybackStartTime="), MatchPlaybackStartTime))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MatchPlaybackStartTime from CLI: %f"), MatchPlaybackStartTime);
+	}
+	if (FParse::Value(CmdLine, TEXT("IncomingBudgetMs="), IncomingBudgetMs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed IncomingBudgetMs from CLI: %f"), IncomingBudgetMs);
+	}
+	if (FParse::Value(CmdLine, TEXT("IncomingBudgetMessages="), IncomingBudgetMessages))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed IncomingBudgetMessages from CLI: %d"), IncomingBudgetMessages);
+	}
+	if (FParse::Value(CmdLine, TEXT("ConnectTimeoutSeconds="), ConnectTimeoutSeconds))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ConnectTimeoutSeconds from CLI: %f"), ConnectTimeoutSeconds);
+	}
+	if (FParse::Value(CmdLine, TEXT("MaxConnectAttempts="), MaxConnectAttempts))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MaxConnectAttempts from CLI: %d"), MaxConnectAttempts);
+	}
+	if (FParse::Value(CmdLine, TEXT("ReconnectDelaySeconds="), ReconnectDelaySeconds))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ReconnectDelaySeconds from CLI: %f"), ReconnectDelaySeconds);
+	}
+	if (FParse::Value(CmdLine, TEXT("ReconnectMaxDelaySeconds="), ReconnectMaxDelaySeconds))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ReconnectMaxDelaySeconds from CLI: %f"), ReconnectMaxDelaySeconds);
+	}
+	if (FParse::Value(CmdLine, TEXT("ReconnectBackoffMultiplier="), ReconnectBackoffMultiplier))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ReconnectBackoffMultiplier from CLI: %f"), ReconnectBackoffMultiplier);
+	}
+	if (FParse::Value(CmdLine, TEXT("SessionResumeGracePeriodSeconds="), SessionResumeGracePeriodSeconds))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed SessionResumeGracePeriodSeconds from CLI: %f"), SessionResumeGracePeriodSeconds);
+	}
 	
-	if (ReceiveBufferSize < Channeld::MaxPacketSize)
+	// The receive buffer should be able to hold at least one packet of the max size.
+	if (ReceiveBufferSize < static_cast<int32>(HeaderSize + Channeld::MaxPacketSize))
 	{
-		ReceiveBufferSize = Channeld::MaxPacketSize;
+		ReceiveBufferSize = HeaderSize + Channeld::MaxPacketSize;
 	}
 	if (SendBufferSize < Channeld::MaxPacketSize)
 	{
 		SendBufferSize = Channeld::MaxPacketSize;
 	}
 	ReceiveBuffer = new uint8[ReceiveBufferSize];
-
-	// StubId=0 is reserved.
-	RpcCallbacks.Add(0, nullptr);
+	IncomingEvent = FPlatformProcess::GetSynchEventFromPool();
+	SendBuffer = new uint8[SendBufferSize];
+	SendBufferCapacity = SendBufferSize;
 
 	UserSpaceMessageHandlerEntry = MessageHandlerEntry();
-	UserSpaceMessageHandlerEntry.Msg = new channeldpb::ServerForwardMessage;
+	UserSpaceMessageHandlerEntry.SetMessageTemplate(new channeldpb::ServerForwardMessage);
 	//UserSpaceMessageHandlerEntry.Handlers.Add([&](UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
 	//	{
 	//		HandleServerForwardMessage(Conn, ChId, Msg);
@@ -83,13 +205,25 @@ void UChanneldConnection::Initialize(FSubsystemCollectionBase& Collection)
 	
 	RegisterMessageHandler(channeldpb::QUERY_SPATIAL_CHANNEL, new channeldpb::QuerySpatialChannelResultMessage());
 	RegisterMessageHandler(channeldpb::CHANNEL_DATA_HANDOVER, new channeldpb::ChannelDataHandoverMessage());
-	RegisterMessageHandler(channeldpb::SPATIAL_REGIONS_UPDATE, new channeldpb::SpatialRegionsUpdateMessage());
+	RegisterMessageHandler(channeldpb::SPATIAL_REGIONS_UPDATE, new channeldpb::SpatialRegionsUpdateMessage(), [&](UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+		{
+			HandleSpatialRegionsUpdate(Conn, ChId, Msg);
+		});
 }
 
 void UChanneldConnection::Deinitialize()
 {
+	// The queued messages reference the handler entries.
+	IncomingQueue.Empty();
+	IncomingCriticalQueue.Empty();
 	UserSpaceMessageHandlerEntry.Handlers.Reset();
-	MessageHandlers.Reset();
+	for (MessageHandlerEntry& Entry : BuiltinMessageHandlers)
+	{
+		Entry = MessageHandlerEntry();
+	}
+	UserSpaceMessageHandlers.Reset();
+	PendingCreateEntityBatches.Reset();
+	PendingSubBatches.Reset();
 
 //}
 //
@@ -97,6 +231,20 @@ void UChanneldConnection::Deinitialize()
 //{
 //	Super::BeginDestroy();
 	Disconnect(false);
+
+	delete[] SendBuffer;
+	SendBuffer = nullptr;
+	SendBufferCapacity = 0;
+
+	EmptyOutgoingQueues();
+	while (channeldpb::MessagePack* MsgPack = MessagePackPool.Pop())
+	{
+		delete MsgPack;
+	}
+	MessagePackPoolSize.Reset();
+
+	FPlatformProcess::ReturnSynchEventToPool(IncomingEvent);
+	IncomingEvent = nullptr;
 }
 
 bool UChanneldConnection::Connect(bool bInitAsClient, const FString& Host, int32 Port, FString& Error)
@@ -104,6 +252,10 @@ bool UChanneldConnection::Connect(bool bInitAsClient, const FString& Host, int32
 	if (IsConnected())
 		return false;
 
+	// The regions may change between the sessions.
+	SpatialRegionIndex.Reset();
+	bSpatialRegionsRequested = false;
+
 	auto SocketSubsystem = ISocketSubsystem::Get();
 	if (SocketSubsystem == NULL)
 	{
@@ -129,67 +281,241 @@ bool UChanneldConnection::Connect(bool bInitAsClient, const FString& Host, int32
 	}
 	RemoteAddr->SetPort(Port);
 
-	// Create TCP socket to channeld
-	Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("Connection to channeld"), RemoteAddr->GetProtocolType());
-
-	int32 NewSize = 0;
-	if (Socket->SetReceiveBufferSize(0x0fffff, NewSize))
+	if (!ReplayFilePath.IsEmpty())
+	{
+		Transport = MakeUnique<FChanneldReplayTransport>(ReplayFilePath, bReplayRealTime);
+	}
+	else if (!MatchPlaybackFilePath.IsEmpty())
 	{
-		UE_LOG(LogChanneld, Log, TEXT("Set Socket's receive buffer size to %d"), NewSize);
+		Transport = MakeUnique<FChanneldMatchPlaybackTransport>(MatchPlaybackFilePath, MatchPlaybackStartTime);
 	}
 	else
 	{
-		UE_LOG(LogChanneld, Error, TEXT("Failed to set Socket's receive buffer size"));
+		// Only the clients can use KCP, as channeld doesn't support it for the server connections.
+		Transport = FChanneldTransport::Create(bInitAsClient ? GetMutableDefault<UChanneldSettings>()->ClientTransport : EChanneldTransportType::ETT_TCP);
+	}
+	if (!Transport->Connect(*RemoteAddr, Error))
+	{
+		Transport.Reset();
+		return false;
+	}
+
+	// Don't wait for the connection to be established. The messages sent in the meantime (e.g. the auth) are queued and
+	// sent as soon as it's done, so the login takes no more than the round trips.
+	bConnectPending = true;
+	ConnectAttempts = 1;
+	FirstConnectStartTime = ConnectAttemptStartTime = FPlatformTime::Seconds();
+	NextConnectTime = 0;
+	TickConnect();
+	if (!Transport.IsValid())
+	{
+		Error = TEXT("Failed to connect to channeld");
+		return false;
+	}
+	return true;
+}
+
+void UChanneldConnection::TickConnect()
+{
+	const double Now = FPlatformTime::Seconds();
+	if (NextConnectTime > 0)
+	{
+		if (Now < NextConnectTime)
+		{
+			return;
+		}
+		NextConnectTime = 0;
+		ConnectAttempts++;
+		ConnectAttemptStartTime = Now;
+		FString Error;
+		UE_LOG(LogChanneld, Log, TEXT("Connecting to channeld, attempt %d"), ConnectAttempts);
+		if (!Transport->Connect(*RemoteAddr, Error))
+		{
+			OnConnectAttemptFailed(Error);
+			return;
+		}
+	}
+
+	if (Transport->IsConnecting())
+	{
+		if (ConnectTimeoutSeconds > 0 && Now - ConnectAttemptStartTime > ConnectTimeoutSeconds)
+		{
+			OnConnectAttemptFailed(FString::Printf(TEXT("Timed out after %.1fs"), ConnectTimeoutSeconds));
+		}
+		return;
 	}
-	if (Socket->SetSendBufferSize(0x0fffff, NewSize))
+
+	if (Transport->IsConnected())
 	{
-		UE_LOG(LogChanneld, Log, TEXT("Set Socket's send buffer size to %d"), NewSize);
+		OnTransportConnected();
 	}
 	else
 	{
-		UE_LOG(LogChanneld, Error, TEXT("Failed to set Socket's send buffer size"));
+		OnConnectAttemptFailed(TEXT("Connection refused"));
 	}
-	if(!Socket->SetNoDelay(true))
+}
+
+void UChanneldConnection::OnTransportConnected()
+{
+	bConnectPending = false;
+	UE_LOG(LogChanneld, Log, TEXT("Connected to channeld in %.1fms, attempts: %d"), (FPlatformTime::Seconds() - FirstConnectStartTime) * 1000.0, ConnectAttempts);
+
+	if (!CaptureFilePath.IsEmpty() && ReplayFilePath.IsEmpty())
 	{
-		UE_LOG(LogChanneld, Error, TEXT("Failed to set Socket to NoDelay"));
+		CaptureWriter.Open(CaptureFilePath);
 	}
-	if(!Socket->SetNonBlocking(true))
+	// Keep recording the same match across the resumed sessions.
+	if (!MatchRecordFilePath.IsEmpty() && ReplayFilePath.IsEmpty() && MatchPlaybackFilePath.IsEmpty() && !MatchRecordWriter.IsOpen())
 	{
-		UE_LOG(LogChanneld, Error, TEXT("Failed to set Socket to NonBlocking"));
+		MatchRecordWriter.Open(MatchRecordFilePath, MatchRecordKeyframeInterval);
 	}
-	
-	UE_LOG(LogChanneld, Log, TEXT("Connecting to channeld with addr: %s"), *RemoteAddr->ToString(true));
-	bool bSocketConnected = Socket->Connect(*RemoteAddr);
-	if (!ensure(bSocketConnected))
+
+	if (GetMutableDefault<UChanneldSettings>()->bUseReceiveThread && !bPollOnCallingThread)
 	{
-		Error = FString::Printf(TEXT("SocketConnected failed"));
-		return false;
+		ensureMsgf(StartReceiveThread(), TEXT("Start receive thread failed"));
+	}
+	if (GetMutableDefault<UChanneldSettings>()->bUseSendThread && !bPollOnCallingThread)
+	{
+		ensureMsgf(StartSendThread(), TEXT("Start send thread failed"));
+	}
+	TickPhaseEstimator.Init(GetMutableDefault<UChanneldSettings>()->ChanneldTickIntervalMs / 1000.0);
+	if (TickPhaseEstimator.IsEnabled() && SendThread == nullptr)
+	{
+		UE_LOG(LogChanneld, Warning, TEXT("The send pacing requires the send thread. Only the tick phase of channeld is measured."));
 	}
 
-	if (GetMutableDefault<UChanneldSettings>()->bUseReceiveThread)
+	if (IsResumingSession())
 	{
-		if (!ensure(StartReceiveThread()))
+		Auth(LastAuthPIT, LastAuthLT, [this](const channeldpb::AuthResultMessage* AuthResultMsg)
 		{
-			Error = TEXT("Start receive thread failed");
-			return false;
-		}
+			RestoreSession(AuthResultMsg);
+		});
 	}
-	return true;
+
+	// Send the messages queued while connecting right away, rather than at the end of the tick.
+	TickOutgoing();
+}
+
+void UChanneldConnection::OnConnectAttemptFailed(const FString& Reason)
+{
+	Transport->Close();
+	// When resuming the session, the attempts are only limited by the grace period.
+	if (IsResumingSession() ? FPlatformTime::Seconds() >= ResumeDeadline : MaxConnectAttempts > 0 && ConnectAttempts >= MaxConnectAttempts)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to connect to channeld %s after %d attempts: %s"), *RemoteAddr->ToString(true), ConnectAttempts, *Reason);
+		OnDisconnected();
+		Transport.Reset();
+		OnConnectFailed.Broadcast(this, Reason);
+		return;
+	}
+
+	const float Delay = FMath::Min(ReconnectDelaySeconds * FMath::Pow(FMath::Max(ReconnectBackoffMultiplier, 1.0f), ConnectAttempts - 1), ReconnectMaxDelaySeconds);
+	UE_LOG(LogChanneld, Warning, TEXT("Failed to connect to channeld %s: %s, retrying in %.2fs"), *RemoteAddr->ToString(true), *Reason, Delay);
+	NextConnectTime = FPlatformTime::Seconds() + FMath::Max(Delay, 0.0f);
+}
+
+void UChanneldConnection::HandleTransportLost()
+{
+	bTransportLost = false;
+	if (SessionResumeGracePeriodSeconds <= 0 || !IsAuthenticated() || bConnectPending)
+	{
+		CloseSession();
+		return;
+	}
+
+	UE_LOG(LogChanneld, Warning, TEXT("Lost the connection to channeld, resuming the session within %.1fs"), SessionResumeGracePeriodSeconds);
+	StopSendThread();
+	StopReceiveThread();
+	Transport->Close();
+	CaptureWriter.Close();
+
+	// The responses of the pending requests will never arrive, and the partial packets are of the old stream.
+	ReceiveBufferOffset = 0;
+	PendingSendSize = 0;
+	BufferedSendSize.Reset();
+	IncomingQueue.Empty();
+	IncomingCriticalQueue.Empty();
+	EmptyOutgoingQueues();
+	ResetRpcStubs();
+
+	// The subscriptions are added back by the results of the re-subscriptions.
+	ResumingSubscriptions = MoveTemp(SubscribedChannels);
+	SubscribedChannels.Reset();
+	if (OwnedChannels.Num() > 0)
+	{
+		UE_LOG(LogChanneld, Warning, TEXT("The %d owned channels will not be restored when resuming the session"), OwnedChannels.Num());
+		OwnedChannels.Empty();
+	}
+	EntityGroups.Reset();
+	PendingCreateEntityBatches.Reset();
+	PendingSubBatches.Reset();
+	LocalSpatialQueryResults.Reset();
+	ResumingConnId = ConnId;
+	ConnId = 0;
+
+	const double Now = FPlatformTime::Seconds();
+	ResumeDeadline = Now + SessionResumeGracePeriodSeconds;
+	bConnectPending = true;
+	ConnectAttempts = 0;
+	FirstConnectStartTime = Now;
+	// Start the first attempt in TickConnect() right away.
+	NextConnectTime = Now;
+}
+
+void UChanneldConnection::RestoreSession(const channeldpb::AuthResultMessage* AuthResultMsg)
+{
+	ResumeDeadline = 0;
+	if (AuthResultMsg->result() != channeldpb::AuthResultMessage_AuthResult_SUCCESSFUL)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to re-authenticate when resuming the session with channeld"));
+		CloseSession();
+		OnConnectFailed.Broadcast(this, TEXT("Failed to re-authenticate"));
+		return;
+	}
+
+	UE_LOG(LogChanneld, Log, TEXT("Resumed the session with channeld in %.1fms, connId: %d -> %d, restoring %d subscriptions"),
+		(FPlatformTime::Seconds() - FirstConnectStartTime) * 1000.0, ResumingConnId, ConnId, ResumingSubscriptions.Num());
+	for (const TPair<Channeld::ChannelId, FSubscribedChannelInfo>& Pair : ResumingSubscriptions)
+	{
+		const TSharedPtr<channeldpb::ChannelSubscriptionOptions> SubOptions = Pair.Value.SubOptions.ToMessage();
+		SubToChannel(Pair.Key, SubOptions.Get());
+	}
+	ResumingSubscriptions.Empty();
+	OnSessionResumed.Broadcast(this, ResumingConnId);
+}
+
+void UChanneldConnection::CloseSession()
+{
+	StopSendThread();
+	OnDisconnected();
+
+	// The receive thread may be using the transport, so stop it before closing.
+	StopReceiveThread();
+	Transport->Close();
+	Transport.Reset();
+	CaptureWriter.Close();
+	MatchRecordWriter.Close();
 }
 
 void UChanneldConnection::OnDisconnected()
 {
+	bConnectPending = false;
+	NextConnectTime = 0;
+	bTransportLost = false;
+	ResumeDeadline = 0;
+	ResumingSubscriptions.Empty();
 	ConnId = 0;
 	ConnectionType = channeldpb::NO_CONNECTION;
+	CompressionType = channeldpb::NO_COMPRESSION;
 	RemoteAddr = nullptr;
 		
 	ReceiveBufferOffset = 0;
+	PendingSendSize = 0;
+	BufferedSendSize.Reset();
 	IncomingQueue.Empty();
-	OutgoingQueue.Empty();
-	OutgoingQueueSize = 0;
-	RpcCallbacks.Empty();
-	// StubId=0 is reserved.
-	RpcCallbacks.Add(0, nullptr);
+	IncomingCriticalQueue.Empty();
+	EmptyOutgoingQueues();
+	ResetRpcStubs();
 
 	OnAuthenticated.Clear();
 	OnUserSpaceMessageReceived.Clear();
@@ -197,6 +523,10 @@ void UChanneldConnection::OnDisconnected()
 	SubscribedChannels.Empty();
 	OwnedChannels.Empty();
 	ListedChannels.Empty();
+	EntityGroups.Reset();
+	PendingCreateEntityBatches.Reset();
+	PendingSubBatches.Reset();
+	LocalSpatialQueryResults.Reset();
 }
 
 void UChanneldConnection::SendDisconnectMessage(Channeld::ConnectionId InConnId)
@@ -214,6 +544,7 @@ void UChanneldConnection::SendDisconnectMessage(Channeld::ConnectionId InConnId)
 	MsgPack.set_msgbody(DisconnectMsg.SerializeAsString());
 	
 	Packet.add_messages()->CopyFrom(MsgPack);
+	FScopeLock Lock(&SendCriticalSection);
 	SendDirect(Packet);
 }
 
@@ -222,91 +553,152 @@ void UChanneldConnection::Disconnect(bool bFlushAll/* = true*/)
 	if (!IsConnected())
 		return;
 
+	// Stop the send thread first, so the remaining messages are flushed on the calling thread.
+	StopSendThread();
 	if (bFlushAll)
 	{
 		TickOutgoing();
 	}
 
-	OnDisconnected();
+	CloseSession();
+}
 
-	Socket->Close();
-	StopReceiveThread();
 
-	auto SocketSubsystem = ISocketSubsystem::Get();
-	if (SocketSubsystem)
+void UChanneldConnection::Receive()
+{
+	// Drain the socket. A read that fills up the free space of the buffer means there could be more data.
+	while (ReceiveOnce())
 	{
-		SocketSubsystem->DestroySocket(Socket);
 	}
-	Socket = NULL;
-}
 
+	if (HasIncomingMessages())
+	{
+		IncomingEvent->Trigger();
+	}
+}
 
-void UChanneldConnection::Receive()
+bool UChanneldConnection::ReceiveOnce()
 {
-	uint32 PendingDataSize;
-	if (!Socket->HasPendingData(PendingDataSize))
-		return;
-
 	int32 BytesRead;
-	if (Socket->Recv(ReceiveBuffer + ReceiveBufferOffset, ReceiveBufferSize, BytesRead, ESocketReceiveFlags::None))
+	const int32 FreeSpace = ReceiveBufferSize - ReceiveBufferOffset;
+	if (Transport->Recv(ReceiveBuffer + ReceiveBufferOffset, FreeSpace, BytesRead))
 	{
-		ReceiveBufferOffset += BytesRead;		
-		while (ReceiveBufferOffset > HeaderSize)
+		CHANNELD_TRACE_SCOPE(Channeld_Receive);
+		TickPhaseEstimator.AddArrival(FPlatformTime::Seconds());
+		if (CaptureWriter.IsOpen())
 		{
-			if (ReceiveBuffer[0] != 67 || ReceiveBuffer[1] != 72)
+			CaptureWriter.Write(ChanneldCapture::EDirection::Incoming, ReceiveBuffer + ReceiveBufferOffset, BytesRead);
+		}
+		ReceiveBufferOffset += BytesRead;
+		// Created on the first complete packet of this batch.
+		FReceiveArenaPtr BatchArena;
+		// The packets are parsed in place from the read position. The unfinished packet at the end (if any) is moved
+		// to the front of the buffer only once per Recv.
+		uint32 ReadPos = 0;
+		uint32 UnfinishedPacketSize = 0;
+		while (ReceiveBufferOffset - ReadPos >= HeaderSize)
+		{
+			const uint8* PacketHeader = ReceiveBuffer + ReadPos;
+			if (PacketHeader[0] != 67)
 			{
 				ReceiveBufferOffset = 0;
-				UE_LOG(LogChanneld, Error, TEXT("Invalid tag: %d, the packet will be dropped"), ReceiveBuffer[0]);
-				UChanneldMetrics* Metrics = GEngine->GetEngineSubsystem<UChanneldMetrics>();
-				Metrics->DroppedPacket_Counter->Increment();
-				return;
+				UE_LOG(LogChanneld, Error, TEXT("Invalid tag: %d, the packet will be dropped"), PacketHeader[0]);
+				TrafficStats.DroppedPackets.Increment();
+				return false;
 			}
 			
-			uint32 PacketSize = ReceiveBuffer[3] | (ReceiveBuffer[2] << 8);
+			uint32 PacketSize = PacketHeader[3] | (PacketHeader[2] << 8);
+			// In a large packet, the second byte of the header is the high byte of the size instead of the 'H' tag.
+			if (PacketHeader[1] != 72)
+			{
+				if (!bAllowLargePackets)
+				{
+					ReceiveBufferOffset = 0;
+					UE_LOG(LogChanneld, Error, TEXT("Invalid tag: %d, the packet will be dropped (large packets are not allowed)"), PacketHeader[1]);
+					TrafficStats.DroppedPackets.Increment();
+					return false;
+				}
+				PacketSize |= PacketHeader[1] << 16;
+				if (PacketSize > Channeld::MaxLargePacketSize)
+				{
+					ReceiveBufferOffset = 0;
+					UE_LOG(LogChanneld, Error, TEXT("Invalid packet size: %d, the packet will be dropped"), PacketSize);
+					TrafficStats.DroppedPackets.Increment();
+					return false;
+				}
+			}
 
 			// UE_LOG(LogChanneld, VeryVerbose, TEXT("ReceiveBufferOffset: %d, PacketSize:%d"), ReceiveBufferOffset,
 			//        PacketSize);
 
-			if (ReceiveBufferOffset < HeaderSize + PacketSize)
+			if (ReceiveBufferOffset - ReadPos < HeaderSize + PacketSize)
 			{
 				// Unfinished packet
 				UE_LOG(LogChanneld, Verbose,
 				       TEXT("UChanneldConnection::Receive: unfinished packet body, read: %d, pos: %d/%d"), BytesRead,
-				       ReceiveBufferOffset, HeaderSize + PacketSize);
-				UChanneldMetrics* Metrics = GEngine->GetEngineSubsystem<UChanneldMetrics>();
-				Metrics->FragmentedPacket_Counter->Increment();
-				return;
+				       ReceiveBufferOffset - ReadPos, HeaderSize + PacketSize);
+				TrafficStats.FragmentedPackets.Increment();
+				UnfinishedPacketSize = HeaderSize + PacketSize;
+				break;
 			}
 
-			// TODO: support Snappy compression
+			const uint8* PacketData = PacketHeader + HeaderSize;
+			uint32 PacketDataSize = PacketSize;
+			if (PacketHeader[4] == channeldpb::SNAPPY)
+			{
+				DecompressBuffer.Reset();
+				if (!ChanneldCompression::SnappyUncompress(PacketData, PacketSize, DecompressBuffer, Channeld::MaxUncompressedPacketSize))
+				{
+					ReceiveBufferOffset = 0;
+					UE_LOG(LogChanneld, Error, TEXT("UChanneldConnection::Receive: Failed to decompress packet, size: %d"), PacketSize);
+					TrafficStats.DroppedPackets.Increment();
+					return false;
+				}
+				PacketData = DecompressBuffer.GetData();
+				PacketDataSize = DecompressBuffer.Num();
+				// The incompressible data can expand in the snappy frame.
+				TrafficStats.Packets[FChanneldTrafficStats::Received].CompressionSavedBytes.Add(PacketDataSize > PacketSize ? PacketDataSize - PacketSize : 0);
+			}
+			else if (PacketHeader[4] != channeldpb::NO_COMPRESSION)
+			{
+				ReceiveBufferOffset = 0;
+				UE_LOG(LogChanneld, Error, TEXT("UChanneldConnection::Receive: Unsupported compression type: %d, the packet will be dropped"), PacketHeader[4]);
+				TrafficStats.DroppedPackets.Increment();
+				return false;
+			}
 
-			channeldpb::Packet Packet;
-			if (!Packet.ParseFromArray(ReceiveBuffer + HeaderSize, PacketSize))
+			if (!BatchArena.IsValid())
+			{
+				BatchArena = MakeShared<google::protobuf::Arena, ESPMode::ThreadSafe>();
+			}
+			channeldpb::Packet& Packet = *google::protobuf::Arena::CreateMessage<channeldpb::Packet>(BatchArena.Get());
+			if (!Packet.ParseFromArray(PacketData, PacketDataSize))
 			{
 				ReceiveBufferOffset = 0;
 				UE_LOG(LogChanneld, Error, TEXT("UChanneldConnection::Receive: Failed to parse packet, size: %d"),
 				       PacketSize);
-				UChanneldMetrics* Metrics = GEngine->GetEngineSubsystem<UChanneldMetrics>();
-				Metrics->DroppedPacket_Counter->Increment();
-				return;
+				TrafficStats.DroppedPackets.Increment();
+				return false;
 			}
 
-			// move buff
-			uint32 moveLen = PacketSize + HeaderSize;
-			memmove_s(ReceiveBuffer, ReceiveBuffer + moveLen, ReceiveBufferOffset - moveLen);
-			
-			ReceiveBufferOffset -= moveLen;
+			ReadPos += HeaderSize + PacketSize;
+			TrafficStats.AddPacket(FChanneldTrafficStats::Received, HeaderSize + PacketSize);
 
 			for (auto const& MessagePackData : Packet.messages())
 			{
 				uint32 MsgType = MessagePackData.msgtype();
+				TrafficStats.Add(FChanneldTrafficStats::Received, MsgType, MessagePackData.channelid(), MessagePackData.msgbody().size());
+				if (MatchRecordWriter.IsOpen())
+				{
+					MatchRecordWriter.Write(MessagePackData.channelid(), MsgType, MessagePackData.msgbody());
+				}
 
-				MessageHandlerEntry Entry;
-				if (!MessageHandlers.Contains(MsgType))
+				const MessageHandlerEntry* Entry = FindMessageHandlerEntry(MsgType);
+				if (Entry == nullptr)
 				{
 					if (MsgType >= channeldpb::USER_SPACE_START)
 					{
-						Entry = UserSpaceMessageHandlerEntry;
+						Entry = &UserSpaceMessageHandlerEntry;
 					}
 					else
 					{
@@ -315,48 +707,102 @@ void UChanneldConnection::Receive()
 						continue;
 					}
 				}
-				else
-				{
-					Entry = MessageHandlers[MsgType];
-				}
 
-				if (Entry.Msg == nullptr)
+				// The template is never modified, so a new instance in the arena is enough.
+				google::protobuf::Message* Msg = Entry->Msg->New(BatchArena.Get());
+				Channeld::ConnectionId ClientConnId = 0;
+				if (Entry->bForwardPayload ? !ParseForwardPayload(MessagePackData.msgbody(), ClientConnId, Msg) : !Msg->ParseFromString(MessagePackData.msgbody()))
 				{
-					UE_LOG(LogChanneld, Error, TEXT("No message template registered for type: %d"),
-					       MessagePackData.msgtype());
+					UE_LOG(LogChanneld, Error, TEXT("Failed to parse message %s"),
+					       UTF8_TO_TCHAR(Msg->GetTypeName().c_str()));
 					continue;
 				}
 
-				// Always make a clone!
-				google::protobuf::Message* Msg = Entry.Msg->New();
-				Msg->CopyFrom(*Entry.Msg);
-				if (!Msg->ParseFromString(MessagePackData.msgbody()))
+				google::protobuf::Message* UnpackedData = nullptr;
+				if (MsgType == channeldpb::CHANNEL_DATA_UPDATE)
 				{
-					UE_LOG(LogChanneld, Error, TEXT("Failed to parse message %s"),
-					       UTF8_TO_TCHAR(Msg->GetTypeName().c_str()));
-					continue;
+					UnpackedData = UnpackChannelData(static_cast<channeldpb::ChannelDataUpdateMessage*>(Msg)->data(), BatchArena.Get());
 				}
 
 				MessageQueueEntry QueueEntry = {
-					MsgType, Msg, MessagePackData.channelid(), MessagePackData.stubid(), Entry.Handlers, Entry.Delegate
+					MsgType, Msg, BatchArena, MessagePackData.channelid(), MessagePackData.stubid(), Entry,
+					ShouldTrace() ? FPlatformTime::Seconds() : 0, UnpackedData, ClientConnId
 				};
-				IncomingQueue.Enqueue(QueueEntry);
+				if (HasIncomingBudget() && (MsgType == channeldpb::AUTH || QueueEntry.StubId > 0))
+				{
+					IncomingCriticalQueue.Enqueue(QueueEntry);
+				}
+				else
+				{
+					IncomingQueue.Enqueue(QueueEntry);
+				}
 			}
 		}
+
+		// Move the remaining bytes (the unfinished packet) to the front of the buffer.
+		if (ReadPos > 0)
+		{
+			ReceiveBufferOffset -= ReadPos;
+			if (ReceiveBufferOffset > 0)
+			{
+				FMemory::Memmove(ReceiveBuffer, ReceiveBuffer + ReadPos, ReceiveBufferOffset);
+			}
+		}
+
+		// Grow the buffer to hold the whole large packet.
+		if (UnfinishedPacketSize > static_cast<uint32>(ReceiveBufferSize))
+		{
+			uint8* NewBuffer = new uint8[UnfinishedPacketSize];
+			FMemory::Memcpy(NewBuffer, ReceiveBuffer, ReceiveBufferOffset);
+			delete[] ReceiveBuffer;
+			ReceiveBuffer = NewBuffer;
+			ReceiveBufferSize = UnfinishedPacketSize;
+			UE_LOG(LogChanneld, Log, TEXT("UChanneldConnection::Receive: receive buffer is grown to %d bytes"), ReceiveBufferSize);
+		}
 	}
 	else
 	{
-		OnDisconnected();
-		// Handle disconnection or exception
-		UE_LOG(LogChanneld, Warning, TEXT("Failed to receive data "));
+		// Handled by TickIncoming() on the game thread, as the session state is not thread-safe.
+		if (!bTransportLost)
+		{
+			UE_LOG(LogChanneld, Warning, TEXT("Failed to receive data "));
+			bTransportLost = true;
+		}
+		return false;
 	}
 
 	// Reset read position
 	// ReceiveBufferOffset = 0;
+
+	return BytesRead == FreeSpace;
 }
 
 
 
+static EThreadPriority ToThreadPriority(EChanneldThreadPriority Priority)
+{
+	switch (Priority)
+	{
+	case EChanneldThreadPriority::ETP_AboveNormal:
+		return TPri_AboveNormal;
+	case EChanneldThreadPriority::ETP_Highest:
+		return TPri_Highest;
+	case EChanneldThreadPriority::ETP_TimeCritical:
+		return TPri_TimeCritical;
+	case EChanneldThreadPriority::ETP_BelowNormal:
+		return TPri_BelowNormal;
+	case EChanneldThreadPriority::ETP_Lowest:
+		return TPri_Lowest;
+	default:
+		return TPri_Normal;
+	}
+}
+
+static uint64 ToAffinityMask(int64 Mask)
+{
+	return Mask != 0 ? static_cast<uint64>(Mask) : FPlatformAffinity::GetNoAffinityMask();
+}
+
 bool UChanneldConnection::StartReceiveThread()
 {
 	if (bReceiveThreadRunning)
@@ -365,7 +811,9 @@ bool UChanneldConnection::StartReceiveThread()
 	}
 	if (ReceiveThread == nullptr)
 	{
-		ReceiveThread = FRunnableThread::Create(this, TEXT("Tpri_Channeld_Connection_Receive"));
+		const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+		ReceiveThread = FRunnableThread::Create(this, TEXT("Tpri_Channeld_Connection_Receive"), 0,
+			ToThreadPriority(Settings->ReceiveThreadPriority), ToAffinityMask(Settings->ReceiveThreadAffinityMask));
 	}
 	return ReceiveThread != nullptr;
 }
@@ -380,6 +828,70 @@ void UChanneldConnection::StopReceiveThread()
 	}
 }
 
+bool UChanneldConnection::StartSendThread()
+{
+	if (SendThread != nullptr)
+	{
+		return false;
+	}
+	SendWorker = MakeUnique<FSendWorker>(this);
+	SendWorker->WakeEvent = FPlatformProcess::GetSynchEventFromPool();
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	SendThread = FRunnableThread::Create(SendWorker.Get(), TEXT("Tpri_Channeld_Connection_Send"), 0,
+		ToThreadPriority(Settings->SendThreadPriority), ToAffinityMask(Settings->SendThreadAffinityMask));
+	if (SendThread == nullptr)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(SendWorker->WakeEvent);
+		SendWorker.Reset();
+		return false;
+	}
+	return true;
+}
+
+void UChanneldConnection::StopSendThread()
+{
+	if (SendThread == nullptr)
+	{
+		return;
+	}
+	SendThread->Kill(true);
+	delete SendThread;
+	SendThread = nullptr;
+	FPlatformProcess::ReturnSynchEventToPool(SendWorker->WakeEvent);
+	SendWorker.Reset();
+}
+
+uint32 UChanneldConnection::FSendWorker::Run()
+{
+	while (bRunning)
+	{
+		WakeEvent->Wait();
+		if (!bRunning)
+		{
+			break;
+		}
+		// Hold the packets until they can just make channeld's next tick. See UChanneldSettings::ChanneldTickIntervalMs.
+		if (Conn->TickPhaseEstimator.IsEnabled())
+		{
+			const double Now = FPlatformTime::Seconds();
+			const double SendTime = Conn->TickPhaseEstimator.GetNextPhaseTime(Now, GetMutableDefault<UChanneldSettings>()->SendPhaseOffsetMs / 1000.0);
+			if (SendTime > Now)
+			{
+				FPlatformProcess::SleepNoStats(SendTime - Now);
+			}
+		}
+		FScopeLock Lock(&Conn->SendCriticalSection);
+		Conn->FlushOutgoingQueue();
+	}
+	return 0;
+}
+
+void UChanneldConnection::FSendWorker::Stop()
+{
+	bRunning = false;
+	WakeEvent->Trigger();
+}
+
 bool UChanneldConnection::Init()
 {
 	bReceiveThreadRunning = true;
@@ -388,15 +900,35 @@ bool UChanneldConnection::Init()
 
 uint32 UChanneldConnection::Run()
 {
-	while (bReceiveThreadRunning)
+	// Stop on the transport failure. The thread is restarted if the session is resumed.
+	while (bReceiveThreadRunning && !bTransportLost)
 	{
-		Receive();
-		// FPlatformProcess::Sleep(0.001f);
-		Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(10));
+		// Block until the socket is readable, then drain it. The timeout only decides how soon Stop() is noticed.
+		if (Transport->Wait(FTimespan::FromMilliseconds(ReceiveThreadWaitMs)))
+		{
+			Receive();
+		}
 	}
 	return 0;
 }
 
+bool UChanneldConnection::WaitForIncoming(uint32 TimeoutMs)
+{
+	if (HasIncomingMessages())
+	{
+		return true;
+	}
+	if (bConnectPending)
+	{
+		return false;
+	}
+	if (bReceiveThreadRunning)
+	{
+		return IncomingEvent->Wait(TimeoutMs);
+	}
+	return Transport.IsValid() && Transport->Wait(FTimespan::FromMilliseconds(TimeoutMs));
+}
+
 void UChanneldConnection::Stop()
 {
 	bReceiveThreadRunning = false;
@@ -408,147 +940,579 @@ void UChanneldConnection::Exit()
 		bReceiveThreadRunning = true;
 }
 
-uint32 UChanneldConnection::AddRpcCallback(const FChanneldMessageHandlerFunc& HandlerFunc)
+uint32 UChanneldConnection::AddRpcCallback(const FChanneldMessageHandlerFunc& HandlerFunc, float TimeoutSeconds/* = 0*/, const TFunction<void()>& TimeoutFunc/* = nullptr*/)
 {
-	uint32 StubId = 0;
-	while (RpcCallbacks.Contains(StubId))
+	uint16 Slot;
+	if (FreeRpcStubSlots.Num() > 0)
+	{
+		Slot = FreeRpcStubSlots.Pop(false);
+	}
+	else if (static_cast<uint32>(RpcStubs.Num()) <= MaxRpcStubSlot)
 	{
-		StubId++;
+		Slot = RpcStubs.AddDefaulted();
 	}
+	else
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to add RPC callback: too many pending callbacks (%d)"), NumPendingRpcStubs);
+		return 0;
+	}
+
+	FRpcStub& Stub = RpcStubs[Slot];
+	Stub.Callback = HandlerFunc;
+	Stub.TimeoutFunc = TimeoutFunc;
+	Stub.bInUse = true;
+	NumPendingRpcStubs++;
 
-	RpcCallbacks.Add(StubId, HandlerFunc);
+	// The generation is never 0, so the StubId is never 0 (reserved for the messages without callback).
+	const uint32 StubId = (static_cast<uint32>(Stub.Generation) << 16) | Slot;
+	if (TimeoutSeconds > 0)
+	{
+		RpcStubTimeouts.HeapPush({FPlatformTime::Seconds() + TimeoutSeconds, StubId});
+	}
 	return StubId;
 }
 
+UChanneldConnection::FRpcStub* UChanneldConnection::FindRpcStub(uint32 StubId)
+{
+	const uint32 Slot = StubId & MaxRpcStubSlot;
+	if (Slot >= static_cast<uint32>(RpcStubs.Num()))
+	{
+		return nullptr;
+	}
+	FRpcStub& Stub = RpcStubs[Slot];
+	// A stale StubId (of a timed-out or already handled callback) has a different generation.
+	if (!Stub.bInUse || Stub.Generation != (StubId >> 16))
+	{
+		return nullptr;
+	}
+	return &Stub;
+}
+
+void UChanneldConnection::ReleaseRpcStub(uint32 StubId)
+{
+	const uint16 Slot = StubId & MaxRpcStubSlot;
+	FRpcStub& Stub = RpcStubs[Slot];
+	Stub.Callback = nullptr;
+	Stub.TimeoutFunc = nullptr;
+	Stub.bInUse = false;
+	Stub.Generation = Stub.Generation == MAX_uint16 ? 1 : Stub.Generation + 1;
+	FreeRpcStubSlots.Push(Slot);
+	NumPendingRpcStubs--;
+}
+
+void UChanneldConnection::ResetRpcStubs()
+{
+	RpcStubs.Empty();
+	FreeRpcStubSlots.Empty();
+	RpcStubTimeouts.Empty();
+	NumPendingRpcStubs = 0;
+}
+
+void UChanneldConnection::TickRpcTimeouts()
+{
+	const double Now = FPlatformTime::Seconds();
+	while (RpcStubTimeouts.Num() > 0 && RpcStubTimeouts.HeapTop().ExpireTime <= Now)
+	{
+		FRpcStubTimeout Timeout;
+		RpcStubTimeouts.HeapPop(Timeout, false);
+		FRpcStub* Stub = FindRpcStub(Timeout.StubId);
+		if (Stub == nullptr)
+		{
+			// Already handled
+			continue;
+		}
+
+		UE_LOG(LogChanneld, Warning, TEXT("RPC callback timed out, stubId: %d"), Timeout.StubId);
+		const TFunction<void()> TimeoutFunc = MoveTemp(Stub->TimeoutFunc);
+		ReleaseRpcStub(Timeout.StubId);
+		if (TimeoutFunc)
+		{
+			TimeoutFunc();
+		}
+	}
+
+	// Checked once per second, as the requests of the batches are not sorted by the expire time.
+	if (Now >= NextPendingBatchExpireTime && (PendingCreateEntityBatches.Num() > 0 || PendingSubBatches.Num() > 0))
+	{
+		NextPendingBatchExpireTime = Now + 1.0;
+		const int32 NumExpired = ExpirePendingBatches(PendingCreateEntityBatches, Now) + ExpirePendingBatches(PendingSubBatches, Now);
+		if (NumExpired > 0)
+		{
+			UE_LOG(LogChanneld, Warning, TEXT("%d entity channel creations or subscriptions got no result in time, their batches will not complete"), NumExpired);
+		}
+	}
+}
+
 void UChanneldConnection::TickIncoming()
 {
+	CHANNELD_TRACE_SCOPE(Channeld_TickIncoming);
+	if (bTransportLost)
+	{
+		HandleTransportLost();
+	}
+	if (bConnectPending)
+	{
+		TickConnect();
+	}
+	// Still connecting, or disconnected.
+	if (bConnectPending || !Transport.IsValid())
+	{
+		return;
+	}
+
 	if (!bReceiveThreadRunning)
 	{
 		Receive();
 	}
 	
 	MessageQueueEntry Entry;
-	while (IncomingQueue.Dequeue(Entry))
+	// The auth result and the RPC responses are never held back by the budget.
+	while (IncomingCriticalQueue.Dequeue(Entry))
+	{
+		DispatchMessage(Entry);
+	}
+
+	if (LocalSpatialQueryResults.Num() > 0)
 	{
-		if (Entry.MsgType >= channeldpb::USER_SPACE_START && !MessageHandlers.Contains(Entry.MsgType))
+		// The queries made by the callbacks are left to the next tick.
+		auto Results = MoveTemp(LocalSpatialQueryResults);
+		LocalSpatialQueryResults.Reset();
+		for (auto& Result : Results)
 		{
-			HandleServerForwardMessage(this, Entry.ChId, Entry.Msg, Entry.MsgType);
+			Result.Key(&Result.Value);
 		}
-		else
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumDispatched = 0;
+	while (IncomingQueue.Dequeue(Entry))
+	{
+		DispatchMessage(Entry);
+		NumDispatched++;
+		// The rest of the queue is carried over to the next tick, so a backlog (e.g. after a hitch) is spread across multiple frames.
+		if ((IncomingBudgetMessages > 0 && NumDispatched >= IncomingBudgetMessages) ||
+			(IncomingBudgetMs > 0 && (FPlatformTime::Seconds() - StartTime) * 1000.0 >= IncomingBudgetMs))
 		{
-			// Handler functions are called before the delegate.Broadcast()
-			for (const auto& Func : Entry.Handlers)
+			if (!IncomingQueue.IsEmpty())
 			{
-				Func(this, Entry.ChId, Entry.Msg);
+				UE_LOG(LogChanneld, Verbose, TEXT("TickIncoming reached the budget after dispatching %d messages, the rest is carried over"), NumDispatched);
 			}
-			Entry.Delegate.Broadcast(this, Entry.ChId, Entry.Msg);
+			break;
+		}
+	}
+	TRACE_COUNTER_SET(ChanneldDispatchedMessages, NumDispatched);
+	OnIncomingDispatched.Broadcast(this);
+
+	TickRpcTimeouts();
+	Metrics->PendingRpcStubs_Gauge->Set(NumPendingRpcStubs);
+}
+
+void UChanneldConnection::DispatchMessage(MessageQueueEntry& Entry)
+{
+	CHANNELD_TRACE_SCOPE_TEXT(*Entry.Handler->TraceName);
+	double DispatchTime = 0;
+	if (Entry.TraceTime > 0)
+	{
+		DispatchTime = FPlatformTime::Seconds();
+		Metrics->OnMessageLatency(EChanneldMessageLatency::Dispatch, Entry.MsgType, DispatchTime - Entry.TraceTime);
+	}
+	else if (Metrics->IsTrackingFrameOffenders())
+	{
+		DispatchTime = FPlatformTime::Seconds();
+	}
+
+	TGuardValue<const MessageQueueEntry*> DispatchingEntryGuard(DispatchingEntry, &Entry);
+	if (Entry.Handler == &UserSpaceMessageHandlerEntry)
+	{
+		HandleServerForwardMessage(this, Entry.ChId, Entry.Msg, Entry.MsgType);
+	}
+	else if (Entry.Handler->bForwardPayload)
+	{
+		const TArray<FPayloadHandler>& PayloadHandlers = Entry.Handler->PayloadHandlers;
+		const int32 NumHandlers = PayloadHandlers.Num();
+		for (int32 i = 0; i < NumHandlers; i++)
+		{
+			PayloadHandlers[i].Func(this, Entry.ChId, Entry.ClientConnId, *Entry.Msg);
 		}
+	}
+	else
+	{
+		// Handler functions are called before the delegate.Broadcast().
+		// A handler may register new handlers for the same type, so iterate by the index of a snapshot of the count.
+		const TArray<FChanneldMessageHandlerFunc>& Handlers = Entry.Handler->Handlers;
+		const int32 NumHandlers = Handlers.Num();
+		for (int32 i = 0; i < NumHandlers; i++)
+		{
+			Handlers[i](this, Entry.ChId, Entry.Msg);
+		}
+		Entry.Handler->Delegate.Broadcast(this, Entry.ChId, Entry.Msg);
+	}
 
-		if (Entry.StubId > 0)
+	if (Entry.StubId > 0)
+	{
+		FRpcStub* Stub = FindRpcStub(Entry.StubId);
+		if (Stub != nullptr)
 		{
-			auto CallbackFunc = RpcCallbacks.Find(Entry.StubId);
-			if (CallbackFunc != nullptr)
+			UE_LOG(LogChanneld, VeryVerbose, TEXT("Handling RPC callback of %s, stubId: %d"), UTF8_TO_TCHAR(Entry.Msg->GetTypeName().c_str()), Entry.StubId);
+			// The callback may add new callbacks, which can reallocate the slab.
+			const FChanneldMessageHandlerFunc CallbackFunc = MoveTemp(Stub->Callback);
+			ReleaseRpcStub(Entry.StubId);
+			if (CallbackFunc)
 			{
-				UE_LOG(LogChanneld, VeryVerbose, TEXT("Handling RPC callback of %s, stubId: %d"), UTF8_TO_TCHAR(Entry.Msg->GetTypeName().c_str()), Entry.StubId);
-				(*CallbackFunc)(this, Entry.ChId, Entry.Msg);
-				RpcCallbacks.Remove(Entry.StubId);
+				CallbackFunc(this, Entry.ChId, Entry.Msg);
 			}
 		}
-		delete Entry.Msg;
-		Entry.Msg = nullptr;
 	}
+	if (DispatchTime > 0)
+	{
+		const double HandleSeconds = FPlatformTime::Seconds() - DispatchTime;
+		if (Entry.TraceTime > 0)
+		{
+			Metrics->OnMessageLatency(EChanneldMessageLatency::Handle, Entry.MsgType, HandleSeconds);
+		}
+		if (Metrics->IsTrackingFrameOffenders())
+		{
+			Metrics->FrameOffenders.MsgType.Add(Entry.MsgType, HandleSeconds);
+		}
+	}
+	// The message is freed with the arena, when the last message of the batch is dispatched.
+	Entry.Msg = nullptr;
+	Entry.UnpackedData = nullptr;
+	Entry.Arena.Reset();
 }
 
 void UChanneldConnection::TickOutgoing()
 {
-	if (!IsConnected())
+	// The messages sent while connecting stay in the queue.
+	if (!IsConnected() || bConnectPending)
 		return;
 
-	if (OutgoingQueue.IsEmpty())
+	Metrics->SendPressure_Gauge->Set(GetSendPressure());
+	double TickPhase;
+	if (TickPhaseEstimator.IsEnabled() && TickPhaseEstimator.GetPhase(TickPhase))
+	{
+		Metrics->ChanneldTickPhase_Gauge->Set(TickPhase * 1000.0);
+	}
+	Metrics->MessagePackPoolHit_Counter->Increment(MessagePackPoolHits.Reset());
+	Metrics->MessagePackPoolMiss_Counter->Increment(MessagePackPoolMisses.Reset());
+
+	EntityGroups.Flush([this](Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, const TArray<Channeld::EntityId>& Added, const TArray<Channeld::EntityId>& Removed)
+	{
+		SendEntityGroupChanges(EntityChId, GroupType, Added, Removed);
+	});
+
+	if (SendWorker.IsValid())
+	{
+		SendWorker->WakeEvent->Trigger();
 		return;
+	}
 
-	channeldpb::Packet Packet;
-	TSharedPtr<channeldpb::MessagePack> MessagePack;
-	while (OutgoingQueue.Peek(MessagePack))
+	FScopeLock Lock(&SendCriticalSection);
+	FlushOutgoingQueue();
+}
+
+void UChanneldConnection::FlushOutgoingQueue()
+{
+	if (!Transport.IsValid())
+		return;
+
+	CHANNELD_TRACE_SCOPE(Channeld_FlushOutgoing);
+	TRACE_COUNTER_SET(ChanneldOutgoingQueueSize, OutgoingQueueSize.GetValue());
+
+	// Send the remaining bytes of the last partially sent packet first, to keep the stream in order.
+	if (PendingSendSize > 0)
 	{
-		uint32 MsgSize = MessagePack->ByteSizeLong();
-		if (MsgSize >= Channeld::MaxPacketSize)
-		{
-			OutgoingQueue.Pop();
-			OutgoingQueueSize--;
-			UE_LOG(LogChanneld, Error, TEXT("Dropped oversized message pack: %d, type: %d, remaining in queue: %d"), MsgSize, MessagePack->msgtype(), OutgoingQueueSize);
-			return;
-		}
+		FlushSendBuffer();
+	}
 
-		Packet.add_messages()->CopyFrom(*MessagePack);
-		if (Packet.ByteSizeLong() > Channeld::MaxPacketSize)
+	if (OutgoingQueueSize.GetValue() == 0)
+		return;
+
+	// The MessagePacks are written straight into the send buffer in the wire format of channeldpb::Packet,
+	// with a running size, so assembling a packet is linear to the number of messages.
+	uint8* PacketBody = BeginPacket();
+	uint32 PacketSize = 0;
+	uint32 NumInPacket = 0;
+	FOutgoingMessage OutgoingMessage;
+	// The lanes are flushed in the order of priority. A packet can contain the messages of multiple lanes.
+	for (int32 LaneIndex = 0; LaneIndex < NumSendLanes; LaneIndex++)
+	{
+		auto& Queue = OutgoingQueues[LaneIndex];
+		const int32 LaneBudget = GetLaneBytesPerTick(LaneIndex);
+		int32 LaneBytes = 0;
+		uint32 LaneMessages = 0;
+		while (Queue.Peek(OutgoingMessage))
 		{
-			// Revert adding the message that causes oversize
-			Packet.mutable_messages()->RemoveLast();
-			UE_LOG(LogChanneld, Log, TEXT("Packet is going to be oversized: %d, message type: %d, size: %d, num in packet: %d, remaining in queue: %d"),
-				(uint32)Packet.ByteSizeLong(), MessagePack->msgtype(), MsgSize, Packet.messages_size(), OutgoingQueueSize);
+			channeldpb::MessagePack* MessagePack = OutgoingMessage.MsgPack;
+			// Calculates and caches the size, which is used by SerializeWithCachedSizesToArray() below.
+			const uint32 MsgSize = MessagePack->ByteSizeLong();
+			const uint32 EncodedSize = PacketFieldTagSize + google::protobuf::io::CodedOutputStream::VarintSize32(MsgSize) + MsgSize;
+			if (EncodedSize > (bAllowLargePackets ? Channeld::MaxLargePacketSize : Channeld::MaxPacketSize))
+			{
+				Queue.Pop();
+				OutgoingQueueSize.Decrement();
+				CHANNELD_LOG_RATE_LIMITED(LogChanneld, Error, 1.0, TEXT("Dropped oversized message pack: %d, type: %d, remaining in queue: %d"), MsgSize, MessagePack->msgtype(), OutgoingQueueSize.GetValue());
+				ReleaseMessagePack(MessagePack);
+				continue;
+			}
 
-			if (Packet.messages_size() > 0)
+			// The rest of the lane is left to the next tick. At least one message is sent, so the lane always makes progress.
+			if (LaneBudget > 0 && LaneMessages > 0 && LaneBytes + static_cast<int32>(EncodedSize) > LaneBudget)
 			{
-				SendDirect(Packet);
-				Packet.Clear();
+				break;
 			}
-			// Keep sending packets until the queue is empty.
-			continue;
+
+			if (PacketSize + EncodedSize > Channeld::MaxPacketSize)
+			{
+				CHANNELD_LOG_RATE_LIMITED(LogChanneld, Verbose, 1.0, TEXT("Packet is going to be oversized: %d, message type: %d, size: %d, num in packet: %d, remaining in queue: %d"),
+					PacketSize + EncodedSize, MessagePack->msgtype(), MsgSize, NumInPacket, OutgoingQueueSize.GetValue());
+
+				if (NumInPacket > 0)
+				{
+					CommitPacket(PacketSize, NumInPacket);
+				}
+				// A message larger than MaxPacketSize is sent alone in a large packet.
+				PacketBody = BeginPacket(EncodedSize);
+				PacketSize = 0;
+				NumInPacket = 0;
+			}
+
+			// Field 1 (messages) of channeldpb::Packet, length-delimited.
+			uint8* Ptr = PacketBody + PacketSize;
+			*Ptr++ = PacketMessagesFieldTag;
+			Ptr = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(MsgSize, Ptr);
+			MessagePack->SerializeWithCachedSizesToArray(Ptr);
+			PacketSize += EncodedSize;
+			NumInPacket++;
+			LaneBytes += EncodedSize;
+			LaneMessages++;
+			TrafficStats.Add(FChanneldTrafficStats::Sent, MessagePack->msgtype(), MessagePack->channelid(), MessagePack->msgbody().size());
+			if (OutgoingMessage.TraceTime > 0)
+			{
+				PendingSendTraces.Emplace(MessagePack->msgtype(), OutgoingMessage.TraceTime);
+			}
+
+			// Actually remove the message from the queue
+			Queue.Pop();
+			OutgoingQueueSize.Decrement();
+			ReleaseMessagePack(MessagePack);
+		}
+	}
+
+	if (NumInPacket > 0)
+	{
+		CommitPacket(PacketSize, NumInPacket);
+	}
+}
+
+void UChanneldConnection::EmptyOutgoingQueues()
+{
+	FOutgoingMessage OutgoingMessage;
+	for (auto& Queue : OutgoingQueues)
+	{
+		while (Queue.Dequeue(OutgoingMessage))
+		{
+			ReleaseMessagePack(OutgoingMessage.MsgPack);
 		}
+	}
+	OutgoingQueueSize.Reset();
+}
+
+channeldpb::MessagePack* UChanneldConnection::AcquireMessagePack()
+{
+	if (channeldpb::MessagePack* MsgPack = MessagePackPool.Pop())
+	{
+		MessagePackPoolSize.Decrement();
+		MessagePackPoolHits.Increment();
+		return MsgPack;
+	}
+	MessagePackPoolMisses.Increment();
+	return new channeldpb::MessagePack;
+}
+
+void UChanneldConnection::ReleaseMessagePack(channeldpb::MessagePack* MsgPack)
+{
+	if (MessagePackPoolSize.GetValue() >= MaxPooledMessagePacks)
+	{
+		delete MsgPack;
+		return;
+	}
+	MsgPack->Clear();
+	MessagePackPool.Push(MsgPack);
+	MessagePackPoolSize.Increment();
+}
 
-		// Actually remove the message from the queue
-		OutgoingQueue.Pop();
-		OutgoingQueueSize--;
+int32 UChanneldConnection::GetLaneBytesPerTick(int32 LaneIndex) const
+{
+	switch (static_cast<EChanneldSendLane>(LaneIndex))
+	{
+	case EChanneldSendLane::ESL_Critical:
+		return CriticalLaneBytesPerTick;
+	case EChanneldSendLane::ESL_ChannelData:
+		return ChannelDataLaneBytesPerTick;
+	case EChanneldSendLane::ESL_Bulk:
+		return BulkLaneBytesPerTick;
+	default:
+		return 0;
 	}
+}
 
-	if (Packet.messages_size() > 0)
+EChanneldSendLane UChanneldConnection::GetSendLane(uint32 MsgType, EChanneldSendLane Lane) const
+{
+	if (Lane < EChanneldSendLane::ESL_Max)
+	{
+		return Lane;
+	}
+	if (const EChanneldSendLane* MappedLane = MessageTypeLanes.Find(MsgType))
 	{
-		SendDirect(Packet);
+		if (*MappedLane < EChanneldSendLane::ESL_Max)
+		{
+			return *MappedLane;
+		}
+	}
+	return MsgType == channeldpb::CHANNEL_DATA_UPDATE ? EChanneldSendLane::ESL_ChannelData : EChanneldSendLane::ESL_Critical;
+}
+
+void UChanneldConnection::ReserveSendBuffer(uint32 AdditionalSize)
+{
+	const uint32 RequiredSize = PendingSendSize + AdditionalSize;
+	if (RequiredSize <= SendBufferCapacity)
+	{
+		return;
+	}
+
+	uint32 NewCapacity = FMath::Max<uint32>(SendBufferCapacity, Channeld::MaxPacketSize);
+	while (NewCapacity < RequiredSize)
+	{
+		NewCapacity *= 2;
+	}
+
+	uint8* NewBuffer = new uint8[NewCapacity];
+	if (PendingSendSize > 0)
+	{
+		FMemory::Memcpy(NewBuffer, SendBuffer, PendingSendSize);
+	}
+	delete[] SendBuffer;
+	SendBuffer = NewBuffer;
+	SendBufferCapacity = NewCapacity;
+	UE_LOG(LogChanneld, Log, TEXT("Grew the send buffer to %d bytes, pending: %d"), NewCapacity, PendingSendSize);
+}
+
+bool UChanneldConnection::FlushSendBuffer()
+{
+	if (PendingSendSize == 0)
+	{
+		return true;
+	}
+
+	int32 BytesSent = 0;
+	// The transport returns true with fewer bytes sent (even 0) if it can't take more data for now.
+	if (!Transport->Send(SendBuffer, PendingSendSize, BytesSent))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to send %d bytes to channeld, last packet size: %d"), PendingSendSize, LastPacketSize);
+		PendingSendSize = 0;
+		BufferedSendSize.Reset();
+		return false;
+	}
+
+	if (BytesSent > 0 && static_cast<uint32>(BytesSent) < PendingSendSize)
+	{
+		// Keep the unsent bytes at the head of the buffer, so they will be sent first next time.
+		FMemory::Memmove(SendBuffer, SendBuffer + BytesSent, PendingSendSize - BytesSent);
+	}
+	PendingSendSize -= FMath::Min<uint32>(BytesSent, PendingSendSize);
+	BufferedSendSize.Set(PendingSendSize);
+
+	if (PendingSendSize > 0)
+	{
+		UE_LOG(LogChanneld, Verbose, TEXT("Socket accepted %d bytes, %d bytes are pending in the send buffer"), BytesSent, PendingSendSize);
+	}
+	return true;
+}
+
+float UChanneldConnection::GetSendPressure() const
+{
+	const float BytesPressure = SendPressureHighWaterBytes > 0 ? static_cast<float>(BufferedSendSize.GetValue()) / SendPressureHighWaterBytes : 0.0f;
+	const float MessagesPressure = SendPressureHighWaterMessages > 0 ? static_cast<float>(OutgoingQueueSize.GetValue()) / SendPressureHighWaterMessages : 0.0f;
+	return FMath::Min(FMath::Max(BytesPressure, MessagesPressure), 1.0f);
+}
+
+uint8* UChanneldConnection::BeginPacket(uint32 MaxSize)
+{
+	ReserveSendBuffer(HeaderSize + FMath::Max(MaxSize, Channeld::MaxPacketSize));
+	return SendBuffer + PendingSendSize + HeaderSize;
+}
+
+void UChanneldConnection::CommitPacket(uint32 PacketSize, uint32 NumMessages)
+{
+	uint8* PacketData = SendBuffer + PendingSendSize;
+
+	uint8 PacketCompression = channeldpb::NO_COMPRESSION;
+	if (CompressionType == channeldpb::SNAPPY && PacketSize >= static_cast<uint32>(CompressionThreshold))
+	{
+		CompressBuffer.SetNumUninitialized(ChanneldCompression::SnappyMaxCompressedLength(PacketSize), false);
+		const uint32 CompressedSize = ChanneldCompression::SnappyCompress(PacketData + HeaderSize, PacketSize, CompressBuffer.GetData());
+		// Only use the compressed data when it's actually smaller.
+		if (CompressedSize < PacketSize)
+		{
+			FMemory::Memcpy(PacketData + HeaderSize, CompressBuffer.GetData(), CompressedSize);
+			TrafficStats.Packets[FChanneldTrafficStats::Sent].CompressionSavedBytes.Add(PacketSize - CompressedSize);
+			PacketSize = CompressedSize;
+			PacketCompression = channeldpb::SNAPPY;
+		}
+	}
+	const uint32 Size = HeaderSize + PacketSize;
+	TrafficStats.AddPacket(FChanneldTrafficStats::Sent, Size);
+
+	// Set the header
+	PacketData[0] = 67;
+	PacketData[1] = PacketSize > Channeld::MaxPacketSize ? (PacketSize >> 16) & 0xff : 72;
+	PacketData[2] = (PacketSize >> 8) & 0xff;
+	PacketData[3] = (PacketSize & 0xff);
+	PacketData[4] = PacketCompression;
+
+	if (CaptureWriter.IsOpen())
+	{
+		CaptureWriter.Write(ChanneldCapture::EDirection::Outgoing, PacketData, Size);
+	}
+
+	PendingSendSize += Size;
+	if (!FlushSendBuffer())
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to send packet to channeld, num of messages: %d, full size: %d, last packet size: %d"), NumMessages, Size, LastPacketSize);
+	}
+	else
+	{
+		LastPacketSize = PacketSize;
+	}
+
+	if (PendingSendTraces.Num() > 0)
+	{
+		const double Now = FPlatformTime::Seconds();
+		for (const auto& Trace : PendingSendTraces)
+		{
+			Metrics->OnMessageLatency(EChanneldMessageLatency::Send, Trace.Key, Now - Trace.Value);
+		}
+		PendingSendTraces.Reset();
 	}
 }
 
 void UChanneldConnection::SendDirect(const channeldpb::Packet& Packet)
 {
-	uint32 PacketSize = Packet.ByteSizeLong();
-	uint32 Size = HeaderSize + PacketSize;
-	// TODO: Use a send buffer for all transmissions instead of temp buffer for each transmission
-	uint8* PacketData = new uint8[Size];
-	if (!Packet.SerializeToArray(PacketData + HeaderSize, Size))
+	const uint32 PacketSize = Packet.ByteSizeLong();
+	if (PacketSize > Channeld::MaxPacketSize)
 	{
-		delete[] PacketData;
-		UE_LOG(LogChanneld, Error, TEXT("Failed to serialize Packet, size: %d"), Size);
+		UE_LOG(LogChanneld, Error, TEXT("Failed to send oversized Packet, size: %d"), PacketSize);
 		return;
 	}
 
-	// Set the header
-	PacketData[0] = 67;
-	PacketData[1] = 72;
-	PacketData[2] = (PacketSize >> 8) & 0xff;
-	PacketData[3] = (PacketSize & 0xff);
-	// TODO: support Snappy compression
-	PacketData[4] = 0;
-
-	int32 BytesSent;
-	bool IsSent = Socket->Send(PacketData, Size, BytesSent);
-	// Free send buffer
-	delete[] PacketData;
-	if (!IsSent || BytesSent != Size)
-	{
-		FString MsgTypes;
-		for (int i = 0; i < Packet.messages_size(); i++)
-		{
-			MsgTypes.Appendf(TEXT("%d, "), Packet.messages(i).msgtype());
-		}
-		UE_LOG(LogChanneld, Error, TEXT("Failed to send packet to channeld, msgTypes: %s, sent/full size: %d/%d, last packet size: %d"), *MsgTypes, BytesSent, Size, LastPacketSize);
-	}
-	else
-	{
-		LastPacketSize = PacketSize;
-	}
+	// Serialize the packet straight into the send buffer, after the bytes that are still pending.
+	uint8* PacketBody = BeginPacket();
+	Packet.SerializeWithCachedSizesToArray(PacketBody);
+	CommitPacket(PacketSize, Packet.messages_size());
 }
 
-void UChanneldConnection::Send(Channeld::ChannelId ChId, uint32 MsgType, google::protobuf::Message& Msg, channeldpb::BroadcastType Broadcast/* = channeldpb::NO_BROADCAST*/, const FChanneldMessageHandlerFunc& HandlerFunc/* = nullptr*/)
+void UChanneldConnection::Send(Channeld::ChannelId ChId, uint32 MsgType, google::protobuf::Message& Msg, channeldpb::BroadcastType Broadcast/* = channeldpb::NO_BROADCAST*/, const FChanneldMessageHandlerFunc& HandlerFunc/* = nullptr*/, EChanneldSendLane Lane/* = EChanneldSendLane::ESL_Auto*/)
 {
 	if (ChId == Channeld::InvalidChannelId)
 	{
@@ -556,13 +1520,14 @@ void UChanneldConnection::Send(Channeld::ChannelId ChId, uint32 MsgType, google:
 		return;
 	}
 	
-	SendRaw(ChId, MsgType, Msg.SerializeAsString(), Broadcast, HandlerFunc);
+	uint32 StubId = HandlerFunc != nullptr ? AddRpcCallback(HandlerFunc, RpcCallbackTimeoutSeconds) : 0;
+	EnqueueMessage(ChId, MsgType, Msg.SerializeAsString(), Broadcast, StubId, Lane);
 
 	if (MsgType < channeldpb::USER_SPACE_START)
 		UE_LOG(LogChanneld, Verbose, TEXT("Send message %s to channel %d"), UTF8_TO_TCHAR(channeldpb::MessageType_Name((channeldpb::MessageType)MsgType).c_str()), ChId);
 }
 
-void UChanneldConnection::SendRaw(Channeld::ChannelId ChId, uint32 MsgType, const std::string& MsgBody, channeldpb::BroadcastType Broadcast /*= channeldpb::NO_BROADCAST*/, const FChanneldMessageHandlerFunc& HandlerFunc /*= nullptr*/)
+void UChanneldConnection::SendRaw(Channeld::ChannelId ChId, uint32 MsgType, std::string MsgBody, channeldpb::BroadcastType Broadcast /*= channeldpb::NO_BROADCAST*/, const FChanneldMessageHandlerFunc& HandlerFunc /*= nullptr*/, EChanneldSendLane Lane /*= EChanneldSendLane::ESL_Auto*/)
 {
 	if (ChId == Channeld::InvalidChannelId)
 	{
@@ -570,16 +1535,33 @@ void UChanneldConnection::SendRaw(Channeld::ChannelId ChId, uint32 MsgType, cons
 		return;
 	}
 	
-	uint32 StubId = HandlerFunc != nullptr ? AddRpcCallback(HandlerFunc) : 0;
+	uint32 StubId = HandlerFunc != nullptr ? AddRpcCallback(HandlerFunc, RpcCallbackTimeoutSeconds) : 0;
+	EnqueueMessage(ChId, MsgType, MoveTemp(MsgBody), Broadcast, StubId, Lane);
+}
+
+void UChanneldConnection::SendWithTimeout(Channeld::ChannelId ChId, uint32 MsgType, google::protobuf::Message& Msg, const FChanneldMessageHandlerFunc& HandlerFunc, float TimeoutSeconds, const TFunction<void()>& TimeoutFunc, channeldpb::BroadcastType Broadcast /*= channeldpb::NO_BROADCAST*/, EChanneldSendLane Lane /*= EChanneldSendLane::ESL_Auto*/)
+{
+	if (ChId == Channeld::InvalidChannelId)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Illegal attempt to send message to invalid channel"));
+		return;
+	}
+
+	uint32 StubId = AddRpcCallback(HandlerFunc, TimeoutSeconds, TimeoutFunc);
+	EnqueueMessage(ChId, MsgType, Msg.SerializeAsString(), Broadcast, StubId, Lane);
+}
 
-	TSharedPtr<channeldpb::MessagePack> MsgPack(new channeldpb::MessagePack);
+void UChanneldConnection::EnqueueMessage(Channeld::ChannelId ChId, uint32 MsgType, std::string MsgBody, channeldpb::BroadcastType Broadcast, uint32 StubId, EChanneldSendLane Lane)
+{
+	const size_t BodySize = MsgBody.size();
+	channeldpb::MessagePack* MsgPack = AcquireMessagePack();
 	MsgPack->set_channelid(ChId);
 	MsgPack->set_broadcast(Broadcast);
 	MsgPack->set_stubid(StubId);
 	MsgPack->set_msgtype(MsgType);
-	MsgPack->set_msgbody(MsgBody);
-	OutgoingQueue.Enqueue(MsgPack);
-	OutgoingQueueSize++;
+	MsgPack->set_msgbody(MoveTemp(MsgBody));
+	OutgoingQueues[static_cast<int32>(GetSendLane(MsgType, Lane))].Enqueue(FOutgoingMessage{MsgPack, ShouldTrace() ? FPlatformTime::Seconds() : 0});
+	OutgoingQueueSize.Increment();
 
 	/*
 	channeldpb::MessagePack MsgPack;
@@ -592,22 +1574,121 @@ void UChanneldConnection::SendRaw(Channeld::ChannelId ChId, uint32 MsgType, cons
 	*/
 
 	if (MsgType >= channeldpb::USER_SPACE_START && bShowUserSpaceMessageLog)
-		UE_LOG(LogChanneld, Verbose, TEXT("Send user-space message to channel %d, stubId=%d, type=%d, bodySize=%d)"), ChId, StubId, MsgType, MsgBody.size());
+		UE_LOG(LogChanneld, Verbose, TEXT("Send user-space message to channel %d, stubId=%d, type=%d, bodySize=%d)"), ChId, StubId, MsgType, BodySize);
+}
+
+uint8* UChanneldConnection::BeginForwardBody(std::string& Body, Channeld::ConnectionId ClientConnId, uint32 PayloadSize)
+{
+	using google::protobuf::io::CodedOutputStream;
+	constexpr uint8 ClientConnIdTag = (channeldpb::ServerForwardMessage::kClientConnIdFieldNumber << 3) | 0;
+	constexpr uint8 PayloadTag = (channeldpb::ServerForwardMessage::kPayloadFieldNumber << 3) | 2;
+
+	// Same as ServerForwardMessage::SerializeAsString(): the default value of clientConnId is not written.
+	const size_t HeaderSize = (ClientConnId != 0 ? 1 + CodedOutputStream::VarintSize32(ClientConnId) : 0) + 1 + CodedOutputStream::VarintSize32(PayloadSize);
+	Body.resize(HeaderSize + PayloadSize);
+	uint8* Ptr = reinterpret_cast<uint8*>(&Body[0]);
+	if (ClientConnId != 0)
+	{
+		*Ptr++ = ClientConnIdTag;
+		Ptr = CodedOutputStream::WriteVarint32ToArray(ClientConnId, Ptr);
+	}
+	*Ptr++ = PayloadTag;
+	return CodedOutputStream::WriteVarint32ToArray(PayloadSize, Ptr);
+}
+
+void UChanneldConnection::Forward(Channeld::ChannelId ChId, uint32 MsgType, const google::protobuf::Message& Msg, Channeld::ConnectionId ClientConnId, EChanneldSendLane Lane)
+{
+	if (ChId == Channeld::InvalidChannelId)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Illegal attempt to send message to invalid channel"));
+		return;
+	}
+
+	std::string Body;
+	Msg.SerializeWithCachedSizesToArray(BeginForwardBody(Body, ClientConnId, Msg.ByteSizeLong()));
+	EnqueueMessage(ChId, MsgType, MoveTemp(Body), channeldpb::BroadcastType::SINGLE_CONNECTION, 0, Lane);
+}
+
+void UChanneldConnection::ForwardRaw(Channeld::ChannelId ChId, uint32 MsgType, const uint8* Payload, int32 PayloadSize, Channeld::ConnectionId ClientConnId, EChanneldSendLane Lane)
+{
+	if (ChId == Channeld::InvalidChannelId)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Illegal attempt to send message to invalid channel"));
+		return;
+	}
+
+	std::string Body;
+	FMemory::Memcpy(BeginForwardBody(Body, ClientConnId, PayloadSize), Payload, PayloadSize);
+	EnqueueMessage(ChId, MsgType, MoveTemp(Body), channeldpb::BroadcastType::SINGLE_CONNECTION, 0, Lane);
+}
+
+size_t UChanneldConnection::ByteSizeWithPayload(const google::protobuf::Message& Msg, int32 PayloadFieldNumber, const google::protobuf::Message* Payload)
+{
+	using google::protobuf::io::CodedOutputStream;
+	using google::protobuf::internal::WireFormatLite;
+	const size_t MsgSize = Msg.ByteSizeLong();
+	const size_t PayloadSize = Payload ? Payload->ByteSizeLong() : 0;
+	if (PayloadSize == 0)
+	{
+		return MsgSize;
+	}
+	const uint32 PayloadTag = WireFormatLite::MakeTag(PayloadFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+	return MsgSize + CodedOutputStream::VarintSize32(PayloadTag) + CodedOutputStream::VarintSize32(PayloadSize) + PayloadSize;
+}
+
+uint8* UChanneldConnection::SerializeWithPayload(const google::protobuf::Message& Msg, int32 PayloadFieldNumber, const google::protobuf::Message* Payload, uint8* Target)
+{
+	using google::protobuf::io::CodedOutputStream;
+	using google::protobuf::internal::WireFormatLite;
+	Target = Msg.SerializeWithCachedSizesToArray(Target);
+	const uint32 PayloadSize = Payload ? Payload->GetCachedSize() : 0;
+	if (PayloadSize == 0)
+	{
+		return Target;
+	}
+	Target = CodedOutputStream::WriteVarint32ToArray(WireFormatLite::MakeTag(PayloadFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED), Target);
+	Target = CodedOutputStream::WriteVarint32ToArray(PayloadSize, Target);
+	return Payload->SerializeWithCachedSizesToArray(Target);
+}
+
+void UChanneldConnection::SendWithPayload(Channeld::ChannelId ChId, uint32 MsgType, const google::protobuf::Message& Msg, int32 PayloadFieldNumber, const google::protobuf::Message* Payload, channeldpb::BroadcastType Broadcast, EChanneldSendLane Lane)
+{
+	if (ChId == Channeld::InvalidChannelId)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Illegal attempt to send message to invalid channel"));
+		return;
+	}
+
+	std::string Body;
+	Body.resize(ByteSizeWithPayload(Msg, PayloadFieldNumber, Payload));
+	SerializeWithPayload(Msg, PayloadFieldNumber, Payload, reinterpret_cast<uint8*>(&Body[0]));
+	EnqueueMessage(ChId, MsgType, MoveTemp(Body), Broadcast, 0, Lane);
 }
 
-void UChanneldConnection::Forward(Channeld::ChannelId ChId, uint32 MsgType, const google::protobuf::Message& Msg, Channeld::ConnectionId ClientConnId)
+void UChanneldConnection::ForwardWithPayload(Channeld::ChannelId ChId, uint32 MsgType, const google::protobuf::Message& Msg, int32 PayloadFieldNumber, const google::protobuf::Message* Payload, Channeld::ConnectionId ClientConnId, int BroadcastType, EChanneldSendLane Lane)
 {
-	channeldpb::ServerForwardMessage ServerForwardMessage;
-	ServerForwardMessage.set_clientconnid(ClientConnId);
-	ServerForwardMessage.set_payload(Msg.SerializeAsString());
-	Send(ChId, MsgType, ServerForwardMessage, channeldpb::BroadcastType::SINGLE_CONNECTION);
+	if (ChId == Channeld::InvalidChannelId)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Illegal attempt to send message to invalid channel"));
+		return;
+	}
+
+	std::string Body;
+	SerializeWithPayload(Msg, PayloadFieldNumber, Payload, BeginForwardBody(Body, ClientConnId, ByteSizeWithPayload(Msg, PayloadFieldNumber, Payload)));
+	EnqueueMessage(ChId, MsgType, MoveTemp(Body), static_cast<channeldpb::BroadcastType>(BroadcastType), 0, Lane);
 }
 
-void UChanneldConnection::Broadcast(Channeld::ChannelId ChId, uint32 MsgType, const google::protobuf::Message& Msg, int BroadcastType)
+void UChanneldConnection::Broadcast(Channeld::ChannelId ChId, uint32 MsgType, const google::protobuf::Message& Msg, int BroadcastType, EChanneldSendLane Lane)
 {
-	channeldpb::ServerForwardMessage ServerForwardMessage;
-	ServerForwardMessage.set_payload(Msg.SerializeAsString());
-	Send(ChId, MsgType, ServerForwardMessage, static_cast<channeldpb::BroadcastType>(BroadcastType));
+	if (ChId == Channeld::InvalidChannelId)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Illegal attempt to send message to invalid channel"));
+		return;
+	}
+
+	std::string Body;
+	Msg.SerializeWithCachedSizesToArray(BeginForwardBody(Body, 0, Msg.ByteSizeLong()));
+	EnqueueMessage(ChId, MsgType, MoveTemp(Body), static_cast<channeldpb::BroadcastType>(BroadcastType), 0, Lane);
 }
 
 void UChanneldConnection::HandleServerForwardMessage(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg, uint32 MsgType)
@@ -621,6 +1702,45 @@ void UChanneldConnection::HandleServerForwardMessage(UChanneldConnection* Conn,
 	OnUserSpaceMessageReceived.Broadcast(MsgType, ChId, UserSpaceMsg->clientconnid(), UserSpaceMsg->payload());
 }
 
+bool UChanneldConnection::ParseForwardPayload(const std::string& Body, Channeld::ConnectionId& OutClientConnId, google::protobuf::Message* OutPayload)
+{
+	using google::protobuf::internal::WireFormatLite;
+	constexpr uint32 ClientConnIdTag = (channeldpb::ServerForwardMessage::kClientConnIdFieldNumber << 3) | WireFormatLite::WIRETYPE_VARINT;
+	constexpr uint32 PayloadTag = (channeldpb::ServerForwardMessage::kPayloadFieldNumber << 3) | WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+
+	const uint8* Data = reinterpret_cast<const uint8*>(Body.data());
+	google::protobuf::io::CodedInputStream Input(Data, Body.size());
+	const uint8* Payload = Data;
+	uint32 PayloadSize = 0;
+	while (const uint32 Tag = Input.ReadTag())
+	{
+		if (Tag == ClientConnIdTag)
+		{
+			if (!Input.ReadVarint32(&OutClientConnId))
+			{
+				return false;
+			}
+		}
+		else if (Tag == PayloadTag)
+		{
+			if (!Input.ReadVarint32(&PayloadSize))
+			{
+				return false;
+			}
+			Payload = Data + Input.CurrentPosition();
+			if (!Input.Skip(PayloadSize))
+			{
+				return false;
+			}
+		}
+		else if (!WireFormatLite::SkipField(&Input, Tag))
+		{
+			return false;
+		}
+	}
+	return OutPayload->ParseFromArray(Payload, PayloadSize);
+}
+
 template <typename MsgClass>
 FChanneldMessageHandlerFunc WrapMessageHandler(const TFunction<void(const MsgClass*)>& Callback)
 {
@@ -637,6 +1757,8 @@ void UChanneldConnection::Auth(const FString& PIT, const FString& LT, const TFun
 	channeldpb::AuthMessage Msg;
 	Msg.set_playeridentifiertoken(std::string(TCHAR_TO_UTF8(*PIT)));
 	Msg.set_logintoken(std::string(TCHAR_TO_UTF8(*LT)));
+	LastAuthPIT = PIT;
+	LastAuthLT = LT;
 
 	Send(Channeld::GlobalChannelId, channeldpb::AUTH, Msg, channeldpb::NO_BROADCAST, WrapMessageHandler(Callback));
 }
@@ -703,6 +1825,50 @@ void UChanneldConnection::CreateEntityChannel(Channeld::ChannelId ChId, UObject*
 	Send(ChId, channeldpb::CREATE_ENTITY_CHANNEL, CreateEntityMsg, channeldpb::NO_BROADCAST, WrapMessageHandler(Callback));
 }
 
+void UChanneldConnection::CreateEntityChannels(const TArray<FEntityChannelToCreate>& Entities, const channeldpb::ChannelSubscriptionOptions* SubOptions,
+	const TFunction<void(const channeldpb::CreateChannelResultMessage*)>& Callback, const TFunction<void()>& OnCompleted)
+{
+	// Nobody reads the results.
+	TSharedPtr<TPendingBatch<channeldpb::CreateChannelResultMessage>> Batch;
+	if (Callback || OnCompleted)
+	{
+		Batch = MakeShared<TPendingBatch<channeldpb::CreateChannelResultMessage>>();
+		Batch->Callback = Callback;
+		Batch->OnCompleted = OnCompleted;
+	}
+
+	channeldpb::CreateEntityChannelMessage CreateEntityMsg;
+	if (SubOptions != nullptr)
+	{
+		CreateEntityMsg.mutable_suboptions()->MergeFrom(*SubOptions);
+	}
+	for (const FEntityChannelToCreate& ToCreate : Entities)
+	{
+		CreateEntityMsg.set_entityid(ToCreate.EntityId);
+		if (ToCreate.Data != nullptr)
+		{
+			CreateEntityMsg.mutable_data()->PackFrom(*ToCreate.Data);
+		}
+		else
+		{
+			CreateEntityMsg.clear_data();
+		}
+		const AActor* Actor = Cast<AActor>(ToCreate.Entity);
+		CreateEntityMsg.set_iswellknown(Actor && Actor->bAlwaysRelevant);
+
+		Send(ToCreate.ChId, channeldpb::CREATE_ENTITY_CHANNEL, CreateEntityMsg);
+		if (Batch.IsValid())
+		{
+			AddPendingBatchRequest(PendingCreateEntityBatches, ToCreate.EntityId, Batch);
+		}
+	}
+
+	if (Entities.Num() == 0 && OnCompleted)
+	{
+		OnCompleted();
+	}
+}
+
 void UChanneldConnection::RemoveChannel(uint32 ChannelToRemove, const TFunction<void(const channeldpb::RemoveChannelMessage*)>& Callback)
 {
 	channeldpb::RemoveChannelMessage Msg;
@@ -739,6 +1905,103 @@ void UChanneldConnection::SubConnectionToChannel(Channeld::ConnectionId TargetCo
 	Send(ChId, channeldpb::SUB_TO_CHANNEL, Msg, channeldpb::NO_BROADCAST, WrapMessageHandler(Callback));
 }
 
+void UChanneldConnection::SubConnectionsToChannels(const TArray<TPair<Channeld::ConnectionId, Channeld::ChannelId>>& Subs, const channeldpb::ChannelSubscriptionOptions* SubOptions,
+	const TFunction<void(const channeldpb::SubscribedToChannelResultMessage*)>& Callback, const TFunction<void()>& OnCompleted)
+{
+	TSharedPtr<TPendingBatch<channeldpb::SubscribedToChannelResultMessage>> Batch;
+	if (Callback || OnCompleted)
+	{
+		Batch = MakeShared<TPendingBatch<channeldpb::SubscribedToChannelResultMessage>>();
+		Batch->Callback = Callback;
+		Batch->OnCompleted = OnCompleted;
+	}
+
+	channeldpb::SubscribedToChannelMessage Msg;
+	if (SubOptions != nullptr)
+		Msg.mutable_suboptions()->MergeFrom(*SubOptions);
+	for (auto& Sub : Subs)
+	{
+		Msg.set_connid(Sub.Key);
+		Send(Sub.Value, channeldpb::SUB_TO_CHANNEL, Msg);
+		if (Batch.IsValid())
+		{
+			AddPendingBatchRequest(PendingSubBatches, Sub, Batch);
+		}
+	}
+
+	if (Subs.Num() == 0 && OnCompleted)
+	{
+		OnCompleted();
+	}
+}
+
+// The results of the batch requests don't go through the RPC stubs, so they have their own timeout.
+static constexpr double DefaultPendingBatchTimeoutSeconds = 30.0;
+
+template <typename KeyType, typename ResultMsgType>
+void UChanneldConnection::AddPendingBatchRequest(TPendingBatchMap<KeyType, ResultMsgType>& Batches, const KeyType& Key, const TSharedPtr<TPendingBatch<ResultMsgType>>& Batch)
+{
+	const double Timeout = RpcCallbackTimeoutSeconds > 0 ? RpcCallbackTimeoutSeconds : DefaultPendingBatchTimeoutSeconds;
+	Batches.FindOrAdd(Key).Add({Batch, FPlatformTime::Seconds() + Timeout});
+	Batch->NumPending++;
+}
+
+template <typename KeyType, typename ResultMsgType>
+void UChanneldConnection::CompletePendingBatch(TPendingBatchMap<KeyType, ResultMsgType>& Batches, const KeyType& Key, const ResultMsgType* ResultMsg)
+{
+	auto* Requests = Batches.Find(Key);
+	if (Requests == nullptr)
+	{
+		return;
+	}
+	// The earliest request of the key.
+	const TSharedPtr<TPendingBatch<ResultMsgType>> Batch = (*Requests)[0].Batch;
+	Requests->RemoveAt(0, 1, false);
+	if (Requests->Num() == 0)
+	{
+		Batches.Remove(Key);
+	}
+
+	if (Batch->Callback)
+	{
+		Batch->Callback(ResultMsg);
+	}
+	if (--Batch->NumPending == 0 && Batch->OnCompleted)
+	{
+		Batch->OnCompleted();
+	}
+}
+
+template <typename KeyType, typename ResultMsgType>
+int32 UChanneldConnection::ExpirePendingBatches(TPendingBatchMap<KeyType, ResultMsgType>& Batches, double Now)
+{
+	int32 NumExpired = 0;
+	for (auto It = Batches.CreateIterator(); It; ++It)
+	{
+		NumExpired += It.Value().RemoveAll([Now](const TPendingBatchRequest<ResultMsgType>& Request) { return Request.ExpireTime <= Now; });
+		if (It.Value().Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+	return NumExpired;
+}
+
+void UChanneldConnection::RemovePendingBatches(Channeld::ChannelId ChId, Channeld::ConnectionId SubConnId)
+{
+	if (SubConnId == 0)
+	{
+		PendingCreateEntityBatches.Remove(ChId);
+	}
+	for (auto It = PendingSubBatches.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Value == ChId && (SubConnId == 0 || It.Key().Key == SubConnId))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
 void UChanneldConnection::UnsubFromChannel(Channeld::ChannelId ChId, const TFunction<void(const channeldpb::UnsubscribedFromChannelResultMessage*)>& Callback /*= nullptr*/)
 {
 	UnsubConnectionFromChannel(GetConnId(), ChId, Callback);
@@ -749,11 +2012,46 @@ void UChanneldConnection::UnsubConnectionFromChannel(Channeld::ConnectionId Targ
 	channeldpb::UnsubscribedFromChannelMessage Msg;
 	Msg.set_connid(TargetConnId);
 
+	// The result of the subscription may never arrive after the unsubscription.
+	RemovePendingBatches(ChId, TargetConnId);
 	Send(ChId, channeldpb::UNSUB_FROM_CHANNEL, Msg, channeldpb::NO_BROADCAST, WrapMessageHandler(Callback));
 }
 
 void UChanneldConnection::QuerySpatialChannel(const TArray<FVector>& Positions, const TFunction<void(const channeldpb::QuerySpatialChannelResultMessage*)>& Callback)
 {
+	if (GetMutableDefault<UChanneldSettings>()->bUseLocalSpatialRegionIndex)
+	{
+		if (SpatialRegionIndex.IsEmpty())
+		{
+			// Query channeld until the regions arrive.
+			RequestSpatialRegions();
+		}
+		else
+		{
+			channeldpb::QuerySpatialChannelResultMessage ResultMsg;
+			for (auto& Pos : Positions)
+			{
+				const Channeld::ChannelId SpatialChId = SpatialRegionIndex.GetChannelId(Pos);
+				if (SpatialChId == Channeld::InvalidChannelId)
+				{
+					break;
+				}
+				ResultMsg.add_channelid(SpatialChId);
+			}
+
+			// Fall back to channeld if any position is out of the known regions.
+			if (ResultMsg.channelid_size() == Positions.Num())
+			{
+				// Deferred, so the callers see the same order and re-entrancy as with the result from channeld.
+				if (Callback)
+				{
+					LocalSpatialQueryResults.Emplace(Callback, MoveTemp(ResultMsg));
+				}
+				return;
+			}
+		}
+	}
+
 	channeldpb::QuerySpatialChannelMessage Msg;
 	for (auto& Pos : Positions)
 	{
@@ -766,28 +2064,67 @@ void UChanneldConnection::QuerySpatialChannel(const TArray<FVector>& Positions,
 	Send(Channeld::GlobalChannelId, channeldpb::QUERY_SPATIAL_CHANNEL, Msg, channeldpb::NO_BROADCAST, WrapMessageHandler(Callback));
 }
 
-void UChanneldConnection::AddToEntityGroup(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, const TArray<Channeld::EntityId> EntitiesToAdd)
+void UChanneldConnection::RequestSpatialRegions()
 {
-	channeldpb::AddEntityGroupMessage addMsg;
-	addMsg.set_type(GroupType);
-	for (auto& EntityId : EntitiesToAdd)
+	if (bSpatialRegionsRequested)
 	{
-		addMsg.add_entitiestoadd(EntityId);
+		return;
 	}
-	
-	Send(EntityChId, channeldpb::ENTITY_GROUP_ADD, addMsg);
+	bSpatialRegionsRequested = true;
+
+	channeldpb::DebugGetSpatialRegionsMessage Msg;
+	Send(Channeld::GlobalChannelId, channeldpb::DEBUG_GET_SPATIAL_REGIONS, Msg);
 }
 
-void UChanneldConnection::RemoveFromEntityGroup(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, const TArray<Channeld::EntityId> EntitiesToRemove)
+void UChanneldConnection::AddToEntityGroup(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, TArrayView<const Channeld::EntityId> EntitiesToAdd)
 {
-	channeldpb::RemoveEntityGroupMessage removeMsg;
-	removeMsg.set_type(GroupType);
-	for (auto& EntityId : EntitiesToRemove)
+	if (GetMutableDefault<UChanneldSettings>()->bBatchEntityGroupUpdates)
 	{
-		removeMsg.add_entitiestoremove(EntityId);
+		EntityGroups.Add(EntityChId, GroupType, EntitiesToAdd);
+	}
+	else
+	{
+		SendEntityGroupChanges(EntityChId, GroupType, EntitiesToAdd, {});
+	}
+}
+
+void UChanneldConnection::RemoveFromEntityGroup(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, TArrayView<const Channeld::EntityId> EntitiesToRemove)
+{
+	if (GetMutableDefault<UChanneldSettings>()->bBatchEntityGroupUpdates)
+	{
+		EntityGroups.Remove(EntityChId, GroupType, EntitiesToRemove);
+	}
+	else
+	{
+		SendEntityGroupChanges(EntityChId, GroupType, {}, EntitiesToRemove);
+	}
+}
+
+void UChanneldConnection::SendEntityGroupChanges(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, TArrayView<const Channeld::EntityId> Added, TArrayView<const Channeld::EntityId> Removed)
+{
+	if (Removed.Num() > 0)
+	{
+		channeldpb::RemoveEntityGroupMessage removeMsg;
+		removeMsg.set_type(GroupType);
+		removeMsg.mutable_entitiestoremove()->Reserve(Removed.Num());
+		for (auto& EntityId : Removed)
+		{
+			removeMsg.add_entitiestoremove(EntityId);
+		}
+		Send(EntityChId, channeldpb::ENTITY_GROUP_REMOVE, removeMsg);
 	}
 
-	Send(EntityChId, channeldpb::ENTITY_GROUP_REMOVE, removeMsg);
+	if (Added.Num() > 0)
+	{
+		channeldpb::AddEntityGroupMessage addMsg;
+		addMsg.set_type(GroupType);
+		addMsg.mutable_entitiestoadd()->Reserve(Added.Num());
+		for (auto& EntityId : Added)
+		{
+			addMsg.add_entitiestoadd(EntityId);
+		}
+		Send(EntityChId, channeldpb::ENTITY_GROUP_ADD, addMsg);
+	}
 }
 
 void UChanneldConnection::HandleAuth(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
@@ -800,6 +2137,11 @@ void UChanneldConnection::HandleAuth(UChanneldConnection* Conn, Channeld::Channe
 		{
 			ConnId = ResultMsg->connid();
 			CompressionType = ResultMsg->compressiontype();
+			if (CompressionType != channeldpb::NO_COMPRESSION && CompressionType != channeldpb::SNAPPY)
+			{
+				UE_LOG(LogChanneld, Warning, TEXT("Unsupported compression type: %d, packets will be sent uncompressed."), CompressionType);
+				CompressionType = channeldpb::NO_COMPRESSION;
+			}
 			OnAuthenticated.Broadcast(this);
 		}
 		else
@@ -825,6 +2167,11 @@ void UChanneldConnection::HandleCreateChannel(UChanneldConnection* Conn, Channel
 		ChannelInfo.OwnerConnId = ResultMsg->ownerconnid();
 		OwnedChannels.Add(ResultMsg->channelid(), ChannelInfo);
 	}
+
+	if (ResultMsg->channeltype() == channeldpb::ENTITY)
+	{
+		CompletePendingBatch(PendingCreateEntityBatches, ResultMsg->channelid(), ResultMsg);
+	}
 }
 
 void UChanneldConnection::HandleRemoveChannel(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
@@ -833,6 +2180,8 @@ void UChanneldConnection::HandleRemoveChannel(UChanneldConnection* Conn, Channel
 	SubscribedChannels.Remove(RemoveMsg->channelid());
 	OwnedChannels.Remove(RemoveMsg->channelid());
 	ListedChannels.Remove(RemoveMsg->channelid());
+	EntityGroups.RemoveEntityChannel(RemoveMsg->channelid());
+	RemovePendingBatches(RemoveMsg->channelid(), 0);
 }
 
 void UChanneldConnection::HandleListChannel(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
@@ -881,11 +2230,14 @@ void UChanneldConnection::HandleSubToChannel(UChanneldConnection* Conn, Channeld
 			ExistingOwnedChannel->Subscribeds.Add(SubMsg->connid(), SubscribedInfo);
 		}
 	}
+
+	CompletePendingBatch(PendingSubBatches, TPair<Channeld::ConnectionId, Channeld::ChannelId>(SubMsg->connid(), ChId), SubMsg);
 }
 
 void UChanneldConnection::HandleUnsubFromChannel(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
 {
 	auto UnsubMsg = static_cast<const channeldpb::UnsubscribedFromChannelResultMessage*>(Msg);
+	RemovePendingBatches(ChId, UnsubMsg->connid());
 	if (UnsubMsg->connid() == Conn->GetConnId())
 	{
 		SubscribedChannels.Remove(ChId);
@@ -906,6 +2258,61 @@ void UChanneldConnection::HandleChannelDataUpdate(UChanneldConnection* Conn, Cha
 
 }
 
+void UChanneldConnection::RegisterChannelDataPrototype(const std::string& TypeUrl, const google::protobuf::Message* Prototype)
+{
+	if (!GetMutableDefault<UChanneldSettings>()->bUnpackChannelDataOnReceiveThread)
+	{
+		return;
+	}
+
+	FRWScopeLock Lock(ChannelDataPrototypesLock, SLT_Write);
+	for (auto& Pair : ChannelDataPrototypes)
+	{
+		if (Pair.Key == TypeUrl)
+		{
+			Pair.Value = Prototype;
+			return;
+		}
+	}
+	ChannelDataPrototypes.Emplace(TypeUrl, Prototype);
+}
+
+void UChanneldConnection::UnregisterChannelDataPrototypes()
+{
+	FRWScopeLock Lock(ChannelDataPrototypesLock, SLT_Write);
+	ChannelDataPrototypes.Empty();
+}
+
+google::protobuf::Message* UChanneldConnection::UnpackChannelData(const google::protobuf::Any& Data, google::protobuf::Arena* Arena)
+{
+	const google::protobuf::Message* Prototype = nullptr;
+	{
+		FRWScopeLock Lock(ChannelDataPrototypesLock, SLT_ReadOnly);
+		for (const auto& Pair : ChannelDataPrototypes)
+		{
+			if (Pair.Key == Data.type_url())
+			{
+				Prototype = Pair.Value;
+				break;
+			}
+		}
+	}
+	if (Prototype == nullptr)
+	{
+		return nullptr;
+	}
+
+	CHANNELD_TRACE_SCOPE(Channeld_UnpackChannelData);
+	// Allocated on the heap rather than in the arena, so the states can be swapped into the merged update data without copying.
+	google::protobuf::Message* UnpackedData = Prototype->New();
+	Arena->Own(UnpackedData);
+	if (!UnpackedData->ParseFromString(Data.value()))
+	{
+		return nullptr;
+	}
+	return UnpackedData;
+}
+
 void UChanneldConnection::HandleCreateSpatialChannel(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
 {
 	auto ResultMsg = static_cast<const channeldpb::CreateSpatialChannelsResultMessage*>(Msg);
@@ -922,3 +2329,13 @@ void UChanneldConnection::HandleCreateSpatialChannel(UChanneldConnection* Conn,
 		}
 	}
 }
+
+void UChanneldConnection::HandleSpatialRegionsUpdate(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+{
+	SpatialRegionIndex.Build(*static_cast<const channeldpb::SpatialRegionsUpdateMessage*>(Msg));
+	// The spatial channels may not be created yet. Request again on the next query.
+	if (SpatialRegionIndex.IsEmpty())
+	{
+		bSpatialRegionsRequested = false;
+	}
+}
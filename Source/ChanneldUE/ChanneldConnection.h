@@ -2,19 +2,100 @@
 
 #include "CoreMinimal.h"
 #include "Sockets.h"
+#include "Containers/LockFreeList.h"
 #include "google/protobuf/message.h"
+#include "google/protobuf/arena.h"
 #include "ChanneldTypes.h"
+#include "ChanneldTransport.h"
+#include "ChanneldSpatialRegionIndex.h"
+#include "ChanneldEntityGroups.h"
+#include "ChanneldTickPhase.h"
 #include "channeld.pb.h"
 #include "ChanneldConnection.generated.h"
 
 class UChanneldConnection;
+class UChanneldMetrics;
 
 DECLARE_MULTICAST_DELEGATE_ThreeParams(FChanneldMessageDelegate, UChanneldConnection*, Channeld::ChannelId, const google::protobuf::Message*)
 DECLARE_MULTICAST_DELEGATE_FourParams(FUserSpaceMessageDelegate, uint32, Channeld::ChannelId, Channeld::ConnectionId, const std::string&)
 DECLARE_MULTICAST_DELEGATE_OneParam(FChanneldAuthenticatedDelegate, UChanneldConnection*);
+DECLARE_MULTICAST_DELEGATE_OneParam(FChanneldIncomingDispatchedDelegate, UChanneldConnection*);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FChanneldConnectFailedDelegate, UChanneldConnection*, const FString&);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FChanneldSessionResumedDelegate, UChanneldConnection*, Channeld::ConnectionId);
 
 typedef TFunction<void(UChanneldConnection*, Channeld::ChannelId, const google::protobuf::Message*)> FChanneldMessageHandlerFunc;
+
+// The bytes and the number of the messages sent and received, by msgType and the type of the channel (derived from the channelId,
+// as the received messages may come from the receive thread). Each direction has a single writer - the send or the receive path -
+// so the counters are never contended. UChanneldMetrics::Tick() drains them into the Prometheus counters.
+struct FChanneldTrafficStats
+{
+	enum EDirection : uint8 { Sent, Received, NumDirections };
+	enum EChannelCategory : uint8 { Global, Spatial, Entity, Other, NumChannelCategories };
+	// The msgTypes from MaxMsgTypes on share the last slot.
+	static constexpr uint32 MaxMsgTypes = 256;
+	// The upper bounds of the buckets of the ue_packet_size_bytes histograms. The last bucket is unbounded.
+	static constexpr int32 NumPacketSizeBuckets = 8;
+	static FORCEINLINE uint32 GetPacketSizeBucketBound(int32 Index)
+	{
+		static constexpr uint32 Bounds[NumPacketSizeBuckets] = {64, 256, 1024, 4096, 16384, 65536, 262144, 1048576};
+		return Bounds[Index];
+	}
+
+	struct FSlot
+	{
+		FThreadSafeCounter64 Bytes;
+		FThreadSafeCounter64 Messages;
+	};
+	FSlot Slots[NumDirections][MaxMsgTypes + 1][NumChannelCategories];
+
+	// The packets on the wire, after compression. Like the slots, each direction has a single writer.
+	struct FPacketSlot
+	{
+		FThreadSafeCounter64 Bytes;
+		FThreadSafeCounter64 SizeBuckets[NumPacketSizeBuckets + 1];
+		FThreadSafeCounter64 CompressionSavedBytes;
+	};
+	FPacketSlot Packets[NumDirections];
+	// Only written by the receive path.
+	FThreadSafeCounter64 DroppedPackets;
+	FThreadSafeCounter64 FragmentedPackets;
+
+	FORCEINLINE void AddPacket(EDirection Direction, uint32 Size)
+	{
+		int32 Bucket = 0;
+		while (Bucket < NumPacketSizeBuckets && Size > GetPacketSizeBucketBound(Bucket))
+		{
+			Bucket++;
+		}
+		FPacketSlot& Slot = Packets[Direction];
+		Slot.SizeBuckets[Bucket].Increment();
+		Slot.Bytes.Add(Size);
+	}
+
+	FORCEINLINE void Add(EDirection Direction, uint32 MsgType, Channeld::ChannelId ChId, int64 Bytes)
+	{
+		FSlot& Slot = Slots[Direction][FMath::Min(MsgType, MaxMsgTypes)][GetChannelCategory(ChId)];
+		Slot.Bytes.Add(Bytes);
+		Slot.Messages.Increment();
+	}
+
+	static FORCEINLINE EChannelCategory GetChannelCategory(Channeld::ChannelId ChId)
+	{
+		if (ChId == Channeld::GlobalChannelId)
+		{
+			return Global;
+		}
+		if (ChId >= Channeld::EntityChannelIdStart)
+		{
+			return Entity;
+		}
+		return ChId >= Channeld::SpatialChannelIdStart ? Spatial : Other;
+	}
+};
 //typedef TFunction<void(Channeld::ChannelId, ConnectionId, const std::string&)> FUserSpaceMessageHandlerFunc;
+// The handler of a user-space message registered by RegisterUserSpaceMessageHandler(). The message is the payload of the ServerForwardMessage.
+typedef TFunction<void(UChanneldConnection*, Channeld::ChannelId, Channeld::ConnectionId, const google::protobuf::Message&)> FChanneldPayloadHandlerFunc;
 
 UCLASS(transient, config = ChanneldUE)
 class CHANNELDUE_API UChanneldConnection : public UEngineSubsystem, public FRunnable
@@ -26,11 +107,13 @@ public:
 	//UChanneldConnection(const FObjectInitializer& ObjectInitializer);
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
+	// Initialize a connection created with NewObject() rather than as the engine subsystem, e.g. by the load test bots. Call Deinitialize() when done.
+	void InitializeStandalone(UChanneldMetrics* InMetrics);
 
 	FORCEINLINE void RegisterMessageHandler(uint32 MsgType, google::protobuf::Message* MessageTemplate, const FChanneldMessageHandlerFunc& Handler = nullptr)
 	{
-		MessageHandlerEntry& Entry = MessageHandlers.FindOrAdd(MsgType);
-		Entry.Msg = MessageTemplate;
+		MessageHandlerEntry& Entry = FindOrAddMessageHandlerEntry(MsgType);
+		Entry.SetMessageTemplate(MessageTemplate);
 		if (Handler)
 		{
 			Entry.Handlers.Add(Handler);
@@ -40,46 +123,92 @@ public:
 	template <typename UserClass>
 	FORCEINLINE void RegisterMessageHandler(uint32 MsgType, google::protobuf::Message* MessageTemplate, UserClass* InUserObject, typename TMemFunPtrType<false, UserClass, void(UChanneldConnection*, Channeld::ChannelId, const google::protobuf::Message*)>::Type InFunc)
 	{
-		MessageHandlerEntry& Entry = MessageHandlers.FindOrAdd(MsgType);
-		Entry.Msg = MessageTemplate;
+		MessageHandlerEntry& Entry = FindOrAddMessageHandlerEntry(MsgType);
+		Entry.SetMessageTemplate(MessageTemplate);
 		Entry.Delegate.AddUObject(InUserObject, InFunc);
 	}
 
+	// Register the type of the channel data to be parsed on the receive thread, if bUnpackChannelDataOnReceiveThread is set.
+	// The prototype is only used to create new messages, and must be valid until it's unregistered.
+	void RegisterChannelDataPrototype(const std::string& TypeUrl, const google::protobuf::Message* Prototype);
+	void UnregisterChannelDataPrototypes();
+	// The channel data of the ChannelDataUpdateMessage being dispatched, if it was parsed on the receive thread. Otherwise nullptr.
+	// Only valid in the handlers of the message. The handler that merges it may move its states out.
+	google::protobuf::Message* GetUnpackedChannelData(const google::protobuf::Message* UpdateMsg) const
+	{
+		return DispatchingEntry && DispatchingEntry->Msg == UpdateMsg ? DispatchingEntry->UnpackedData : nullptr;
+	}
+
 	FORCEINLINE void AddMessageHandler(uint32 MsgType, const FChanneldMessageHandlerFunc& Handler)
 	{
-		MessageHandlerEntry& Entry = MessageHandlers.FindOrAdd(MsgType);
-		if (Entry.Msg == nullptr)
+		MessageHandlerEntry* Entry = FindMessageHandlerEntry(MsgType);
+		if (Entry == nullptr)
 		{
 			UE_LOG(LogChanneld, Error, TEXT("No message template registered for msgType: %d"), MsgType);
 			return;
 		}
-		Entry.Handlers.Add(Handler);
+		Entry->Handlers.Add(Handler);
 	}
 
 	template <typename UserClass>
 	FORCEINLINE void AddMessageHandler(uint32 MsgType, UserClass* InUserObject, typename TMemFunPtrType<false, UserClass, void(UChanneldConnection*, uint32, const google::protobuf::Message*)>::Type InFunc)
 	{
-		MessageHandlerEntry& Entry = MessageHandlers.FindOrAdd(MsgType);
-		if (Entry.Msg == nullptr)
+		MessageHandlerEntry* Entry = FindMessageHandlerEntry(MsgType);
+		if (Entry == nullptr)
 		{
 			UE_LOG(LogChanneld, Error, TEXT("No message template registered for msgType: %d"), MsgType);
 			return;
 		}
-		Entry.Delegate.AddUObject(InUserObject, InFunc);
+		Entry->Delegate.AddUObject(InUserObject, InFunc);
+	}
+
+	/**
+	 * Bind the user-space msgType to the type of the payload of its ServerForwardMessage, and add a handler of the payload.
+	 * The payload is parsed on the receive thread straight from the message body, without unpacking an Any or copying the payload.
+	 * The msgType can't be registered with RegisterMessageHandler() at the same time.
+	 */
+	template <typename MsgClass, typename UserClass>
+	void RegisterUserSpaceMessageHandler(uint32 MsgType, UserClass* InUserObject, void (UserClass::*InFunc)(UChanneldConnection*, Channeld::ChannelId, Channeld::ConnectionId, const MsgClass&))
+	{
+		if (MsgType < channeldpb::USER_SPACE_START)
+		{
+			UE_LOG(LogChanneld, Error, TEXT("Not a user-space msgType: %d"), MsgType);
+			return;
+		}
+		MessageHandlerEntry& Entry = FindOrAddMessageHandlerEntry(MsgType);
+		if (Entry.Msg == nullptr)
+		{
+			Entry.SetMessageTemplate(new MsgClass);
+			Entry.bForwardPayload = true;
+		}
+		else if (!Entry.bForwardPayload || Entry.Msg->GetDescriptor() != MsgClass::descriptor())
+		{
+			UE_LOG(LogChanneld, Error, TEXT("The msgType %d is already registered with %s"), MsgType, UTF8_TO_TCHAR(Entry.Msg->GetTypeName().c_str()));
+			return;
+		}
+		TWeakObjectPtr<UserClass> WeakUserObject(InUserObject);
+		Entry.PayloadHandlers.Add({InUserObject, [WeakUserObject, InFunc](UChanneldConnection* Conn, Channeld::ChannelId ChId, Channeld::ConnectionId ClientConnId, const google::protobuf::Message& Payload)
+		{
+			if (UserClass* UserObject = WeakUserObject.Get())
+			{
+				(UserObject->*InFunc)(Conn, ChId, ClientConnId, static_cast<const MsgClass&>(Payload));
+			}
+		}});
 	}
 
 	void RemoveMessageHandler(uint32 MsgType, const void* InUserObject)
 	{
-		auto Entry = MessageHandlers.Find(MsgType);
+		auto Entry = FindMessageHandlerEntry(MsgType);
 		if (Entry == nullptr)
 		{
 			UE_LOG(LogChanneld, Warning, TEXT("Failed to remove message handler as the msgType is not found: %d"), MsgType);
 			return;
 		}
 		Entry->Delegate.RemoveAll(InUserObject);
+		Entry->PayloadHandlers.RemoveAll([InUserObject](const FPayloadHandler& Handler) { return Handler.UserObject == InUserObject; });
 	}
 
-	FORCEINLINE FSocket* GetSocket() { return Socket; }
+	FORCEINLINE FSocket* GetSocket() { return Transport.IsValid() ? Transport->GetSocket() : nullptr; }
 	
 	FORCEINLINE Channeld::ConnectionId GetConnId()
 	{
@@ -87,7 +216,12 @@ public:
 		return ConnId;
 	}
 
-	FORCEINLINE bool IsConnected() { return !IsPendingKill() && Socket != nullptr && Socket->GetConnectionState() == SCS_Connected; }
+	// Also true while connecting (see IsConnecting()), so the messages sent in the meantime are queued rather than dropped.
+	FORCEINLINE bool IsConnected() { return !IsPendingKill() && Transport.IsValid() && (bConnectPending || bTransportLost || Transport->IsConnected()); }
+	// Whether Connect() is still waiting for the transport to connect, or for the next attempt after a failed one.
+	FORCEINLINE bool IsConnecting() const { return bConnectPending; }
+	// Whether the connection is lost and being re-established within SessionResumeGracePeriodSeconds.
+	FORCEINLINE bool IsResumingSession() const { return ResumeDeadline > 0; }
 
 	FORCEINLINE bool IsAuthenticated() { return ConnId > 0; }
 
@@ -102,13 +236,31 @@ public:
 	bool Connect(bool bInitAsClient, const FString& Host, int32 Port, FString& Error);
 	void Disconnect(bool bFlushAll = true);
 	// Send a message to channeld. Thread-safe.
-	void Send(Channeld::ChannelId ChId, uint32 MsgType, google::protobuf::Message& Msg, channeldpb::BroadcastType Broadcast = channeldpb::NO_BROADCAST, const FChanneldMessageHandlerFunc& HandlerFunc = nullptr);
-	// Send with underlying bytes.
-	void SendRaw(Channeld::ChannelId ChId, uint32 MsgType, const std::string& MsgBody, channeldpb::BroadcastType Broadcast = channeldpb::NO_BROADCAST, const FChanneldMessageHandlerFunc& HandlerFunc = nullptr);
+	// Lane selects the outgoing queue of the message. By default, it's decided by the message type (see GetSendLane()).
+	void Send(Channeld::ChannelId ChId, uint32 MsgType, google::protobuf::Message& Msg, channeldpb::BroadcastType Broadcast = channeldpb::NO_BROADCAST, const FChanneldMessageHandlerFunc& HandlerFunc = nullptr, EChanneldSendLane Lane = EChanneldSendLane::ESL_Auto);
+	// Send with underlying bytes. Pass an rvalue MsgBody to avoid copying it.
+	void SendRaw(Channeld::ChannelId ChId, uint32 MsgType, std::string MsgBody, channeldpb::BroadcastType Broadcast = channeldpb::NO_BROADCAST, const FChanneldMessageHandlerFunc& HandlerFunc = nullptr, EChanneldSendLane Lane = EChanneldSendLane::ESL_Auto);
+	/**
+	 * @brief Send a message with a callback that is dropped if the response doesn't arrive in time.
+	 * @param TimeoutSeconds How long to wait for the response. 0 means waiting forever.
+	 * @param TimeoutFunc Called on the game thread when the response doesn't arrive in time.
+	 */
+	void SendWithTimeout(Channeld::ChannelId ChId, uint32 MsgType, google::protobuf::Message& Msg, const FChanneldMessageHandlerFunc& HandlerFunc, float TimeoutSeconds, const TFunction<void()>& TimeoutFunc, channeldpb::BroadcastType Broadcast = channeldpb::NO_BROADCAST, EChanneldSendLane Lane = EChanneldSendLane::ESL_Auto);
 	// Send a message that wrapped by the ServerForwardMessage to a specific connection. If ClientConnId is 0, the message will be forwarded to the channel owner.
-	void Forward(Channeld::ChannelId ChId, uint32 MsgType, const google::protobuf::Message& Msg, Channeld::ConnectionId ClientConnId = 0);
+	void Forward(Channeld::ChannelId ChId, uint32 MsgType, const google::protobuf::Message& Msg, Channeld::ConnectionId ClientConnId = 0, EChanneldSendLane Lane = EChanneldSendLane::ESL_Auto);
 	// Send a message that wrapped by the ServerForwardMessage. This is mainly for using channeld for broadcasting.
-	void Broadcast(Channeld::ChannelId ChId, uint32 MsgType, const google::protobuf::Message& Msg, int BroadcastType);
+	void Broadcast(Channeld::ChannelId ChId, uint32 MsgType, const google::protobuf::Message& Msg, int BroadcastType, EChanneldSendLane Lane = EChanneldSendLane::ESL_Auto);
+	// Same as Forward(), but with the serialized payload. The ServerForwardMessage is encoded directly into the message body, so the payload is copied only once.
+	void ForwardRaw(Channeld::ChannelId ChId, uint32 MsgType, const uint8* Payload, int32 PayloadSize, Channeld::ConnectionId ClientConnId = 0, EChanneldSendLane Lane = EChanneldSendLane::ESL_Auto);
+	/**
+	 * @brief Send a message with a bytes field that holds another message, e.g. RemoteFunctionMessage.paramsPayload, without serializing the payload into the field first.
+	 * The payload is encoded straight into the message body after the rest of Msg, so it's not copied through each layer of wrapping.
+	 * @param PayloadFieldNumber The number of the bytes field in Msg. The field should be left empty in Msg.
+	 * @param Payload Encoded as the bytes field. Nullptr or an empty payload leaves the field out, the same as an empty bytes field.
+	 */
+	void SendWithPayload(Channeld::ChannelId ChId, uint32 MsgType, const google::protobuf::Message& Msg, int32 PayloadFieldNumber, const google::protobuf::Message* Payload, channeldpb::BroadcastType Broadcast = channeldpb::NO_BROADCAST, EChanneldSendLane Lane = EChanneldSendLane::ESL_Auto);
+	// Same as SendWithPayload(), but wrapped by the ServerForwardMessage. See Forward() and Broadcast().
+	void ForwardWithPayload(Channeld::ChannelId ChId, uint32 MsgType, const google::protobuf::Message& Msg, int32 PayloadFieldNumber, const google::protobuf::Message* Payload, Channeld::ConnectionId ClientConnId = 0, int BroadcastType = channeldpb::SINGLE_CONNECTION, EChanneldSendLane Lane = EChanneldSendLane::ESL_Auto);
 	/**
 	 * @brief Server sends a DisconnectMessage for safe disconnection. The message skips queueing and will be sent immediately.
 	 * @param InConnId The Id of the Connection to be disconnected
@@ -135,6 +287,23 @@ public:
 	void CreateChannel(channeldpb::ChannelType ChannelType, const FString& Metadata, const channeldpb::ChannelSubscriptionOptions* SubOptions = nullptr, const google::protobuf::Message* Data = nullptr, const channeldpb::ChannelDataMergeOptions* MergeOptions = nullptr, const TFunction<void(const channeldpb::CreateChannelResultMessage*)>& Callback = nullptr);
 	void CreateSpatialChannel(const FString& Metadata, const channeldpb::ChannelSubscriptionOptions* SubOptions = nullptr, const google::protobuf::Message* Data = nullptr, const channeldpb::ChannelDataMergeOptions* MergeOptions = nullptr, const TFunction<void(const channeldpb::CreateSpatialChannelsResultMessage*)>& Callback = nullptr);
 	void CreateEntityChannel(Channeld::ChannelId ChId, UObject* Entity, uint32 EntityId, const FString& Metadata, const channeldpb::ChannelSubscriptionOptions* SubOptions = nullptr, const google::protobuf::Message* Data = nullptr, const channeldpb::ChannelDataMergeOptions* MergeOptions = nullptr, const TFunction<void(const channeldpb::CreateChannelResultMessage*)>& Callback = nullptr);
+
+	struct FEntityChannelToCreate
+	{
+		// The channel to send the creation to, normally the spatial channel of the entity.
+		Channeld::ChannelId ChId;
+		UObject* Entity;
+		uint32 EntityId;
+		const google::protobuf::Message* Data = nullptr;
+	};
+	/**
+	 * @brief Create the entity channels with the same SubOptions. channeld has no batch message, so there's still a message per entity,
+	 * but the messages are queued together and don't take an RPC stub each. The results are matched by the entity channelId.
+	 * @param Callback Called for each created channel.
+	 * @param OnCompleted Called after all the channels are created. Never called if channeld fails to create any of them, which is known by
+	 * the results not arriving in RpcCallbackTimeoutSeconds (or 30 seconds if it's 0). Nothing is tracked if both of the callbacks are null.
+	 */
+	void CreateEntityChannels(const TArray<FEntityChannelToCreate>& Entities, const channeldpb::ChannelSubscriptionOptions* SubOptions = nullptr, const TFunction<void(const channeldpb::CreateChannelResultMessage*)>& Callback = nullptr, const TFunction<void()>& OnCompleted = nullptr);
 	/**
 	 * Remove Channel by channel Id
 	 *
@@ -144,16 +313,45 @@ public:
 	void ListChannel(channeldpb::ChannelType TypeFilter = channeldpb::UNKNOWN, const TArray<FString>* MetadataFilters = nullptr, const TFunction<void(const channeldpb::ListChannelResultMessage*)>& Callback = nullptr);
 	void SubToChannel(Channeld::ChannelId ChId, const channeldpb::ChannelSubscriptionOptions* SubOptions = nullptr, const TFunction<void(const channeldpb::SubscribedToChannelResultMessage*)>& Callback = nullptr);
 	void SubConnectionToChannel(Channeld::ConnectionId ConnId, Channeld::ChannelId ChId, const channeldpb::ChannelSubscriptionOptions* SubOptions = nullptr, const TFunction<void(const channeldpb::SubscribedToChannelResultMessage*)>& Callback = nullptr);
+	// Subscribe the connections to the channels with the same SubOptions, in the same way as CreateEntityChannels(). The results are matched by the (ConnId, ChId) pairs.
+	void SubConnectionsToChannels(const TArray<TPair<Channeld::ConnectionId, Channeld::ChannelId>>& Subs, const channeldpb::ChannelSubscriptionOptions* SubOptions = nullptr, const TFunction<void(const channeldpb::SubscribedToChannelResultMessage*)>& Callback = nullptr, const TFunction<void()>& OnCompleted = nullptr);
 	void UnsubFromChannel(Channeld::ChannelId ChId, const TFunction<void(const channeldpb::UnsubscribedFromChannelResultMessage*)>& Callback = nullptr);
 	void UnsubConnectionFromChannel(Channeld::ConnectionId ConnId, Channeld::ChannelId ChId, const TFunction<void(const channeldpb::UnsubscribedFromChannelResultMessage*)>& Callback = nullptr);
+	/**
+	 * @brief Map the positions to the spatial channels. Resolved from the local spatial region index if all the positions are in the known
+	 * regions (see UChanneldSettings::bUseLocalSpatialRegionIndex). The callback is always called later in TickIncoming(), as the result from channeld.
+	 */
 	void QuerySpatialChannel(const TArray<FVector>& Positions, const TFunction<void(const channeldpb::QuerySpatialChannelResultMessage*)>& Callback = nullptr);
-
-	void AddToEntityGroup(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, const TArray<Channeld::EntityId> EntitiesToAdd);
-	void RemoveFromEntityGroup(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, const TArray<Channeld::EntityId> EntitiesToRemove);
+	// Request the spatial regions from channeld to build the local spatial region index, if not requested yet.
+	void RequestSpatialRegions();
+	// Returns InvalidChannelId if the spatial regions have not been received, or the location is out of all the regions.
+	FORCEINLINE Channeld::ChannelId GetSpatialChannelId(const FVector& Location) const { return SpatialRegionIndex.GetChannelId(Location); }
+	FORCEINLINE const FChanneldSpatialRegionIndex& GetSpatialRegionIndex() const { return SpatialRegionIndex; }
+
+	// Unless UChanneldSettings::bBatchEntityGroupUpdates is false, the changes of the group are sent as the diff of the members in the next TickOutgoing().
+	void AddToEntityGroup(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, TArrayView<const Channeld::EntityId> EntitiesToAdd);
+	void RemoveFromEntityGroup(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, TArrayView<const Channeld::EntityId> EntitiesToRemove);
+	// Returns nullptr if the group has no member, or the members are not cached (see UChanneldSettings::bBatchEntityGroupUpdates).
+	FORCEINLINE const TSet<Channeld::EntityId>* GetEntityGroupMembers(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType) const { return EntityGroups.GetMembers(EntityChId, GroupType); }
 	
 	void TickIncoming();
+	// Send the queued messages to channeld. If the send thread is running, the work is handed over to it.
 	void TickOutgoing();
 
+	FORCEINLINE int32 GetOutgoingQueueSize() const { return OutgoingQueueSize.GetValue(); }
+
+	/**
+	 * @brief How congested the connection to channeld is, from 0 (nothing waiting) to 1 (at or above the high-water mark).
+	 * The replication can read it to lower the update frequency before the backlog grows out of control. Thread-safe.
+	 */
+	float GetSendPressure() const;
+
+	// Block the calling thread until there are new messages for TickIncoming() to handle, or the timeout is reached. Returns false on timeout.
+	bool WaitForIncoming(uint32 TimeoutMs);
+
+	// Resolve ESL_Auto to the lane mapped in MessageTypeLanes. Unmapped CHANNEL_DATA_UPDATE goes to ESL_ChannelData, and others go to ESL_Critical.
+	EChanneldSendLane GetSendLane(uint32 MsgType, EChanneldSendLane Lane = EChanneldSendLane::ESL_Auto) const;
+
 	UPROPERTY(Config)
 	int32 ReceiveBufferSize = Channeld::MaxPacketSize * 2;
 
@@ -163,7 +361,130 @@ public:
 	UPROPERTY(Config)
 	bool bShowUserSpaceMessageLog = false;
 
+	// How long the receive thread blocks on the socket each time. The thread wakes up as soon as data arrives, so this only affects how fast it can be stopped.
+	UPROPERTY(Config)
+	int32 ReceiveThreadWaitMs = 100;
+
+	// Packets smaller than this size (in bytes) are sent uncompressed even if compression is negotiated with channeld.
+	UPROPERTY(Config)
+	int32 CompressionThreshold = 256;
+
+	// Send a message larger than Channeld::MaxPacketSize (up to Channeld::MaxLargePacketSize) in its own large packet, instead of dropping it,
+	// and accept the large packets from channeld. The size of a large packet takes the 'H' tag byte of the header, so it requires a channeld
+	// that supports the extended header. A stock channeld can't parse the packets larger than 64KB.
+	UPROPERTY(Config)
+	bool bAllowLargePackets = false;
+
+	// The timeout of the callbacks passed to Send() and SendRaw(). The callback is dropped if the response doesn't arrive in time. 0 means waiting forever.
+	UPROPERTY(Config)
+	float RpcCallbackTimeoutSeconds = 0;
+
+	// How long a connect attempt can take before it's considered failed. 0 means waiting for the transport to give up.
+	UPROPERTY(Config)
+	float ConnectTimeoutSeconds = 5;
+
+	// The max number of the connect attempts before OnConnectFailed is broadcast. 0 means retrying forever.
+	UPROPERTY(Config)
+	int32 MaxConnectAttempts = 1;
+
+	// The delay before the second connect attempt. It's multiplied by ReconnectBackoffMultiplier after each failed attempt, up to ReconnectMaxDelaySeconds.
+	UPROPERTY(Config)
+	float ReconnectDelaySeconds = 0.5f;
+
+	UPROPERTY(Config)
+	float ReconnectMaxDelaySeconds = 10;
+
+	UPROPERTY(Config)
+	float ReconnectBackoffMultiplier = 2;
+
+	// If greater than 0, a lost connection is re-established (with the reconnect backoff above) within this period, instead of
+	// dropping the session state. After re-authenticating, the subscriptions are restored with their options, and channeld sends
+	// the data of the subscribed channels again. The owned channels are not restored. 0 means disconnecting on the first failure.
+	UPROPERTY(Config)
+	float SessionResumeGracePeriodSeconds = 0;
+
+	// The bytes each lane can send per tick. Zero or negative means unlimited.
+	// A lane always sends at least one message per tick, so a lane with an exhausted budget is never starved.
+	UPROPERTY(Config)
+	int32 CriticalLaneBytesPerTick = 0;
+
+	UPROPERTY(Config)
+	int32 ChannelDataLaneBytesPerTick = 0;
+
+	UPROPERTY(Config)
+	int32 BulkLaneBytesPerTick = 16 * 1024;
+
+	// Overrides the lane of the message types sent with ESL_Auto.
+	UPROPERTY(Config)
+	TMap<uint32, EChanneldSendLane> MessageTypeLanes;
+
+	// The send pressure reaches 1 when this many bytes are waiting in the send buffer (not accepted by the socket yet).
+	UPROPERTY(Config)
+	int32 SendPressureHighWaterBytes = 1024 * 1024;
+
+	// The send pressure reaches 1 when this many messages are waiting in the outgoing queues.
+	UPROPERTY(Config)
+	int32 SendPressureHighWaterMessages = 4096;
+
+	// The max number of the released MessagePacks kept for reuse. The rest are deleted.
+	UPROPERTY(Config)
+	int32 MaxPooledMessagePacks = 1024;
+
+	// The fraction (0 to 1) of the messages whose local latencies are traced and reported to UChanneldMetrics:
+	// enqueue to socket write for the outgoing messages, and receive to dispatch for the incoming ones. 0 disables the tracing.
+	UPROPERTY(Config)
+	float TraceSampleRate = 0;
+
+	// The max milliseconds TickIncoming() spends on dispatching the messages per call. The rest is carried over to the next call. 0 means unlimited.
+	// The auth result and the RPC responses are always dispatched first, regardless of the budget.
+	UPROPERTY(Config)
+	float IncomingBudgetMs = 0;
+
+	// The max number of the messages TickIncoming() dispatches per call (not counting the auth result and the RPC responses). 0 means unlimited.
+	UPROPERTY(Config)
+	int32 IncomingBudgetMessages = 0;
+
+	// If set, the raw traffic to and from channeld is recorded to this file. See FChanneldCaptureWriter.
+	UPROPERTY(Config)
+	FString CaptureFilePath;
+
+	// If set, Connect() plays back the incoming traffic of this capture file instead of connecting to channeld. See FChanneldReplayTransport.
+	UPROPERTY(Config)
+	FString ReplayFilePath;
+
+	// Play back the capture with the recorded timing. If false, the whole capture is fed as fast as the connection can handle.
+	UPROPERTY(Config)
+	bool bReplayRealTime = true;
+
+	// If set, the messages received from channeld are recorded to this match record file, which can be played back with MatchPlaybackFilePath.
+	// A client connection records the channels it's subscribed to, with the read access. See FChanneldMatchRecordWriter.
+	UPROPERTY(Config)
+	FString MatchRecordFilePath;
+
+	// The seconds between the keyframes of the match record. 0 means no keyframes, so the playback can only start from the beginning.
+	UPROPERTY(Config)
+	float MatchRecordKeyframeInterval = 10.f;
+
+	// If set, Connect() plays back this match record instead of connecting to channeld. See FChanneldMatchPlaybackTransport.
+	UPROPERTY(Config)
+	FString MatchPlaybackFilePath;
+
+	// Seconds since the start of the recording to start the playback from. The playback starts from the latest keyframe before it.
+	UPROPERTY(Config)
+	float MatchPlaybackStartTime = 0;
+
+	// If true, Connect() starts neither the receive nor the send thread, and TickIncoming() and TickOutgoing() do the socket I/O on the calling thread.
+	// The load test bots set it, so hundreds of connections in one process don't take two threads each.
+	bool bPollOnCallingThread = false;
+
 	FChanneldAuthenticatedDelegate OnAuthenticated;
+	// Broadcast when all the connect attempts failed. The queued messages (e.g. the auth) are dropped.
+	FChanneldConnectFailedDelegate OnConnectFailed;
+	// Broadcast with the previous ConnId after the session is resumed and the subscriptions are requested again.
+	// OnAuthenticated is also broadcast before it, with the new ConnId.
+	FChanneldSessionResumedDelegate OnSessionResumed;
+	// Broadcast at the end of TickIncoming(), after the messages of this tick are dispatched.
+	FChanneldIncomingDispatchedDelegate OnIncomingDispatched;
 
 	//FUserSpaceMessageHandlerFunc UserSpaceMessageHandlerFunc = nullptr;
 	FUserSpaceMessageDelegate OnUserSpaceMessageReceived;
@@ -172,60 +493,328 @@ public:
 	TMap<Channeld::ChannelId, FOwnedChannelInfo> OwnedChannels;
 	TMap<Channeld::ChannelId, FListedChannelInfo> ListedChannels;
 
+	// Accumulated in the receive and send paths, drained by UChanneldMetrics::Tick(). The receive and send threads only
+	// write to it, so they never touch the engine subsystems or the shared Prometheus metrics.
+	FChanneldTrafficStats TrafficStats;
+	// Cached in Initialize(), for the game thread callers that report to the metrics frequently.
+	FORCEINLINE UChanneldMetrics* GetMetrics() const { return Metrics; }
+
 private:
+	UPROPERTY()
+	UChanneldMetrics* Metrics;
+
+	// Shared by Initialize() and InitializeStandalone(), after Metrics is set.
+	void InitializeConnection();
+
 	const uint32 HeaderSize = 5;
+	// The wire tag of the 'messages' field (field number 1, length-delimited) in channeldpb::Packet.
+	static constexpr uint8 PacketMessagesFieldTag = (channeldpb::Packet::kMessagesFieldNumber << 3) | 2;
+	static constexpr uint32 PacketFieldTagSize = 1;
 
 	channeldpb::ConnectionType ConnectionType = channeldpb::NO_CONNECTION;
 	channeldpb::CompressionType CompressionType = channeldpb::NO_COMPRESSION;
 	Channeld::ConnectionId ConnId = 0;
 	TSharedPtr<FInternetAddr> RemoteAddr;
-	FSocket* Socket;
+	TUniquePtr<FChanneldTransport> Transport;
+
+	FChanneldSpatialRegionIndex SpatialRegionIndex;
+	// The results of QuerySpatialChannel() resolved from SpatialRegionIndex, dispatched in the next TickIncoming().
+	TArray<TPair<TFunction<void(const channeldpb::QuerySpatialChannelResultMessage*)>, channeldpb::QuerySpatialChannelResultMessage>> LocalSpatialQueryResults;
+	bool bSpatialRegionsRequested = false;
+
+	FChanneldEntityGroups EntityGroups;
+	void SendEntityGroupChanges(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, TArrayView<const Channeld::EntityId> Added, TArrayView<const Channeld::EntityId> Removed);
 
 	FThreadSafeBool bReceiveThreadRunning = false;
 	FRunnableThread* ReceiveThread = nullptr;
+	// Triggered when new messages are put into the IncomingQueue.
+	FEvent* IncomingEvent = nullptr;
+
+	// Assembles the packets and writes them to the socket, so TickOutgoing() doesn't block the game thread.
+	class FSendWorker : public FRunnable
+	{
+	public:
+		FSendWorker(UChanneldConnection* InConn) : Conn(InConn) {}
+		virtual uint32 Run() override;
+		virtual void Stop() override;
+
+		FThreadSafeBool bRunning = true;
+		// Triggered by TickOutgoing() or Stop().
+		FEvent* WakeEvent = nullptr;
+	private:
+		UChanneldConnection* Conn;
+	};
+	TUniquePtr<FSendWorker> SendWorker;
+	FRunnableThread* SendThread = nullptr;
+	// Guards the packet assembly and the send buffer, as SendDisconnectMessage() can be called from the game thread while the send thread is running.
+	FCriticalSection SendCriticalSection;
 	uint8* ReceiveBuffer;
 	uint32 ReceiveBufferOffset;
+	// Persistent buffer that the outgoing packets are serialized into. Grows on demand, starting from SendBufferSize.
+	uint8* SendBuffer = nullptr;
+	uint32 SendBufferCapacity = 0;
+	// Bytes at the head of SendBuffer that are serialized but not yet accepted by the socket.
+	uint32 PendingSendSize = 0;
+	// Copy of PendingSendSize for GetSendPressure(), which can be called without locking SendCriticalSection.
+	FThreadSafeCounter BufferedSendSize;
+	// Scratch buffers for the packet compression.
+	TArray<uint8> CompressBuffer;
+	TArray<uint8> DecompressBuffer;
 	// For debug
 	int32 LastPacketSize = 0;
+	FChanneldCaptureWriter CaptureWriter;
+	FChanneldMatchRecordWriter MatchRecordWriter;
+	// See UChanneldSettings::ChanneldTickIntervalMs
+	FChanneldTickPhaseEstimator TickPhaseEstimator;
+
+	struct FPayloadHandler
+	{
+		const void* UserObject;
+		FChanneldPayloadHandlerFunc Func;
+	};
 
 	struct MessageHandlerEntry
 	{
-		google::protobuf::Message* Msg;
+		google::protobuf::Message* Msg = nullptr;
 		TArray<FChanneldMessageHandlerFunc> Handlers;
 		FChanneldMessageDelegate Delegate;
+		// If true, Msg is the template of the payload of the ServerForwardMessage, which is dispatched to PayloadHandlers.
+		bool bForwardPayload = false;
+		TArray<FPayloadHandler> PayloadHandlers;
+		// The name of the handler scopes in the trace, cached as it's needed for every message.
+		FString TraceName;
+
+		void SetMessageTemplate(google::protobuf::Message* MessageTemplate)
+		{
+			Msg = MessageTemplate;
+			TraceName = FString::Printf(TEXT("Channeld_Handle_%s"), UTF8_TO_TCHAR(MessageTemplate->GetDescriptor()->name().c_str()));
+		}
 	};
 
+	// All the messages received in one Receive() call are allocated in the same arena, which is freed in one shot after the last message is dispatched.
+	typedef TSharedPtr<google::protobuf::Arena, ESPMode::ThreadSafe> FReceiveArenaPtr;
+
 	struct MessageQueueEntry
 	{
 		uint32 MsgType;
+		// Owned by the Arena. DO NOT delete.
 		google::protobuf::Message* Msg;
+		FReceiveArenaPtr Arena;
 		Channeld::ChannelId ChId;
 		uint32 StubId;
-		TArray<FChanneldMessageHandlerFunc> Handlers;
-		FChanneldMessageDelegate Delegate;
+		// Points to an entry in BuiltinMessageHandlers or UserSpaceMessageHandlers, or to UserSpaceMessageHandlerEntry.
+		const MessageHandlerEntry* Handler;
+		// When the message was received, if it's sampled for tracing. Otherwise 0.
+		double TraceTime;
+		// The channel data of the ChannelDataUpdateMessage parsed on the receive thread, or nullptr. Owned by the Arena.
+		google::protobuf::Message* UnpackedData;
+		// The clientConnId of the ServerForwardMessage, if the handler has bForwardPayload set.
+		Channeld::ConnectionId ClientConnId;
 	};
+	// The entry in DispatchMessage(), for GetUnpackedChannelData().
+	const MessageQueueEntry* DispatchingEntry = nullptr;
+
+	// Read by the receive thread, written by the game thread.
+	FRWLock ChannelDataPrototypesLock;
+	// There are only a few channel data types, so a linear search is faster than hashing the type URL.
+	TArray<TPair<std::string, const google::protobuf::Message*>> ChannelDataPrototypes;
+	// Called on the receive thread. Returns nullptr if the type is not registered or the data can't be parsed, which leaves the unpacking to the game thread.
+	google::protobuf::Message* UnpackChannelData(const google::protobuf::Any& Data, google::protobuf::Arena* Arena);
 
 	MessageHandlerEntry UserSpaceMessageHandlerEntry;
-	TMap<uint32, MessageHandlerEntry> MessageHandlers;
+	// The built-in message types are dense and small, so they are indexed by msgType directly.
+	MessageHandlerEntry BuiltinMessageHandlers[channeldpb::USER_SPACE_START];
+	// Heap-allocated so the queued messages can reference the entries safely when the map grows.
+	TMap<uint32, TUniquePtr<MessageHandlerEntry>> UserSpaceMessageHandlers;
+
+	// Returns nullptr if no message template has been registered for the msgType.
+	FORCEINLINE MessageHandlerEntry* FindMessageHandlerEntry(uint32 MsgType)
+	{
+		if (MsgType < channeldpb::USER_SPACE_START)
+		{
+			MessageHandlerEntry& Entry = BuiltinMessageHandlers[MsgType];
+			return Entry.Msg ? &Entry : nullptr;
+		}
+		const TUniquePtr<MessageHandlerEntry>* EntryPtr = UserSpaceMessageHandlers.Find(MsgType);
+		return EntryPtr ? EntryPtr->Get() : nullptr;
+	}
+
+	FORCEINLINE MessageHandlerEntry& FindOrAddMessageHandlerEntry(uint32 MsgType)
+	{
+		if (MsgType < channeldpb::USER_SPACE_START)
+		{
+			return BuiltinMessageHandlers[MsgType];
+		}
+		TUniquePtr<MessageHandlerEntry>& EntryPtr = UserSpaceMessageHandlers.FindOrAdd(MsgType);
+		if (!EntryPtr.IsValid())
+		{
+			EntryPtr = MakeUnique<MessageHandlerEntry>();
+		}
+		return *EntryPtr;
+	}
+
 	TQueue<MessageQueueEntry> IncomingQueue;
-	TQueue<TSharedPtr<channeldpb::MessagePack>> OutgoingQueue;
-	int OutgoingQueueSize = 0;
-	TMap<uint32, FChanneldMessageHandlerFunc> RpcCallbacks;
+	// Only used when there's an incoming budget. Holds the auth result and the RPC responses, which are dispatched before IncomingQueue.
+	TQueue<MessageQueueEntry> IncomingCriticalQueue;
+	FORCEINLINE bool HasIncomingBudget() const { return IncomingBudgetMs > 0 || IncomingBudgetMessages > 0; }
+	FORCEINLINE bool HasIncomingMessages() const { return !IncomingQueue.IsEmpty() || !IncomingCriticalQueue.IsEmpty(); }
+	void DispatchMessage(MessageQueueEntry& Entry);
+	static constexpr int32 NumSendLanes = static_cast<int32>(EChanneldSendLane::ESL_Max);
+	// One queue per EChanneldSendLane. Multiple producers (any thread calling Send) and a single consumer (the game thread or the send thread).
+	struct FOutgoingMessage
+	{
+		channeldpb::MessagePack* MsgPack;
+		// When the message was enqueued, if it's sampled for tracing. Otherwise 0.
+		double TraceTime;
+	};
+	// The MessagePacks are taken from the pool by EnqueueMessage() and returned by FlushOutgoingQueue().
+	TQueue<FOutgoingMessage, EQueueMode::Mpsc> OutgoingQueues[NumSendLanes];
+	// The (msgType, enqueue time) of the sampled messages in the packet being assembled. Reported when the packet is written.
+	TArray<TPair<uint32, double>> PendingSendTraces;
+	FORCEINLINE bool ShouldTrace() const { return TraceSampleRate > 0 && FMath::FRand() < TraceSampleRate; }
+	// The total number of messages in all lanes.
+	FThreadSafeCounter OutgoingQueueSize;
+	void EmptyOutgoingQueues();
+
+	// Recycles the outgoing MessagePacks, so they are not heap-allocated for every message. Any thread can acquire and release.
+	TLockFreePointerListUnordered<channeldpb::MessagePack, PLATFORM_CACHE_LINE_SIZE> MessagePackPool;
+	FThreadSafeCounter MessagePackPoolSize;
+	// Reported to UChanneldMetrics in TickOutgoing().
+	FThreadSafeCounter MessagePackPoolHits;
+	FThreadSafeCounter MessagePackPoolMisses;
+	channeldpb::MessagePack* AcquireMessagePack();
+	void ReleaseMessagePack(channeldpb::MessagePack* MsgPack);
+	int32 GetLaneBytesPerTick(int32 LaneIndex) const;
+	// The RPC callbacks are stored in a slab. The StubId is the slot index in the low 16 bits, and the slot's generation
+	// in the high 16 bits, so a slot can be reused without mistaking a late response for the new callback.
+	struct FRpcStub
+	{
+		FChanneldMessageHandlerFunc Callback;
+		TFunction<void()> TimeoutFunc;
+		uint16 Generation = 1;
+		bool bInUse = false;
+	};
+	struct FRpcStubTimeout
+	{
+		double ExpireTime;
+		uint32 StubId;
+		bool operator<(const FRpcStubTimeout& Other) const { return ExpireTime < Other.ExpireTime; }
+	};
+	static constexpr uint32 MaxRpcStubSlot = 0xffff;
+
+	// The requests sent by CreateEntityChannels() or SubConnectionsToChannels() that are waiting for the results.
+	template <typename ResultMsgType>
+	struct TPendingBatch
+	{
+		TFunction<void(const ResultMsgType*)> Callback;
+		TFunction<void()> OnCompleted;
+		int32 NumPending = 0;
+	};
+	template <typename ResultMsgType>
+	struct TPendingBatchRequest
+	{
+		TSharedPtr<TPendingBatch<ResultMsgType>> Batch;
+		double ExpireTime;
+	};
+	// The same key can be requested again before the result of the last request arrives, so the requests of a key are matched in order.
+	template <typename KeyType, typename ResultMsgType>
+	using TPendingBatchMap = TMap<KeyType, TArray<TPendingBatchRequest<ResultMsgType>, TInlineAllocator<1>>>;
+	template <typename KeyType, typename ResultMsgType>
+	void AddPendingBatchRequest(TPendingBatchMap<KeyType, ResultMsgType>& Batches, const KeyType& Key, const TSharedPtr<TPendingBatch<ResultMsgType>>& Batch);
+	template <typename KeyType, typename ResultMsgType>
+	static void CompletePendingBatch(TPendingBatchMap<KeyType, ResultMsgType>& Batches, const KeyType& Key, const ResultMsgType* ResultMsg);
+	// Drop the requests that have no result in time. Their batches never complete.
+	template <typename KeyType, typename ResultMsgType>
+	static int32 ExpirePendingBatches(TPendingBatchMap<KeyType, ResultMsgType>& Batches, double Now);
+	// Drop the pending requests of the channel, e.g. as it's removed or unsubscribed from.
+	void RemovePendingBatches(Channeld::ChannelId ChId, Channeld::ConnectionId SubConnId);
+	TPendingBatchMap<Channeld::ChannelId, channeldpb::CreateChannelResultMessage> PendingCreateEntityBatches;
+	TPendingBatchMap<TPair<Channeld::ConnectionId, Channeld::ChannelId>, channeldpb::SubscribedToChannelResultMessage> PendingSubBatches;
+	double NextPendingBatchExpireTime = 0;
+	TArray<FRpcStub> RpcStubs;
+	TArray<uint16> FreeRpcStubSlots;
+	// Min-heap by the expire time. The entries of the handled callbacks are skipped when popped.
+	TArray<FRpcStubTimeout> RpcStubTimeouts;
+	int32 NumPendingRpcStubs = 0;
+
+	FRpcStub* FindRpcStub(uint32 StubId);
+	void ReleaseRpcStub(uint32 StubId);
+	void ResetRpcStubs();
+	// Drop the expired callbacks and call their TimeoutFunc.
+	void TickRpcTimeouts();
+
+	// MsgBody is moved into the MessagePack, so pass an rvalue to avoid the copy.
+	void EnqueueMessage(Channeld::ChannelId ChId, uint32 MsgType, std::string MsgBody, channeldpb::BroadcastType Broadcast, uint32 StubId, EChanneldSendLane Lane);
+	/**
+	 * @brief Encode the header of a ServerForwardMessage into Body, and leave PayloadSize bytes at the end for the payload.
+	 * @return The pointer to the payload in Body.
+	 */
+	static uint8* BeginForwardBody(std::string& Body, Channeld::ConnectionId ClientConnId, uint32 PayloadSize);
+	// The encoded size of Msg with Payload as its bytes field PayloadFieldNumber. Caches the sizes of both messages for SerializeWithPayload().
+	static size_t ByteSizeWithPayload(const google::protobuf::Message& Msg, int32 PayloadFieldNumber, const google::protobuf::Message* Payload);
+	// The field is written after the rest of Msg, which is fine as the parsers don't care about the order of the fields.
+	static uint8* SerializeWithPayload(const google::protobuf::Message& Msg, int32 PayloadFieldNumber, const google::protobuf::Message* Payload, uint8* Target);
 
 	void SendDirect(const channeldpb::Packet& Packet);
+	// Returns where the body of the next packet should be written. The space for a full packet (or MaxSize if it's larger) is reserved.
+	uint8* BeginPacket(uint32 MaxSize = Channeld::MaxPacketSize);
+	// Compress (if needed), write the header of the packet body written after BeginPacket(), and send it.
+	void CommitPacket(uint32 PacketSize, uint32 NumMessages);
+	// Assemble the queued messages into packets and send them. Must be called with SendCriticalSection locked.
+	void FlushOutgoingQueue();
+	// Make sure the send buffer can hold the pending bytes plus AdditionalSize.
+	void ReserveSendBuffer(uint32 AdditionalSize);
+	// Try to send the pending bytes in the send buffer. Returns false if the socket failed (not including EWOULDBLOCK).
+	bool FlushSendBuffer();
+	// Read all the available data from the socket and queue the received messages.
 	void Receive();
+	// Read from the socket once. Returns true if the read filled the receive buffer, which means there could be more data.
+	bool ReceiveOnce();
 	void OnDisconnected();
 
+	// Called by TickIncoming() while connecting. Polls the transport, times out the attempt and starts the next one.
+	void TickConnect();
+	// Start the I/O threads and send the messages queued while connecting.
+	void OnTransportConnected();
+	void OnConnectAttemptFailed(const FString& Reason);
+	// Called on the game thread after the receive path failed. Either starts resuming the session or closes it.
+	void HandleTransportLost();
+	void RestoreSession(const channeldpb::AuthResultMessage* AuthResultMsg);
+	// Stop the I/O threads, reset the session state and release the transport.
+	void CloseSession();
+
+	bool bConnectPending = false;
+	int32 ConnectAttempts = 0;
+	double ConnectAttemptStartTime = 0;
+	double FirstConnectStartTime = 0;
+	// When to start the next attempt. 0 means the current attempt is in progress.
+	double NextConnectTime = 0;
+
+	// Set by the receive path when the transport fails, and handled by TickIncoming().
+	FThreadSafeBool bTransportLost = false;
+	// When to give up resuming the session. 0 means not resuming.
+	double ResumeDeadline = 0;
+	Channeld::ConnectionId ResumingConnId = 0;
+	TMap<Channeld::ChannelId, FSubscribedChannelInfo> ResumingSubscriptions;
+	// The tokens of the last Auth(), for re-authenticating when resuming the session.
+	FString LastAuthPIT;
+	FString LastAuthLT;
+
 	bool StartReceiveThread();
 	void StopReceiveThread();
+	bool StartSendThread();
+	void StopSendThread();
 	virtual bool Init() override;
 	virtual uint32 Run() override;
 	virtual void Stop() override;
 	virtual void Exit() override;
 
-	uint32 AddRpcCallback(const FChanneldMessageHandlerFunc& HandlerFunc);
+	// Returns the StubId of the callback, or 0 if there are too many pending callbacks.
+	uint32 AddRpcCallback(const FChanneldMessageHandlerFunc& HandlerFunc, float TimeoutSeconds = 0, const TFunction<void()>& TimeoutFunc = nullptr);
 
 	void HandleServerForwardMessage(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg, uint32 MsgType);
+	// Decode the ServerForwardMessage in the body, and parse its payload into OutPayload in place.
+	static bool ParseForwardPayload(const std::string& Body, Channeld::ConnectionId& OutClientConnId, google::protobuf::Message* OutPayload);
 	void HandleAuth(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
 	void HandleCreateChannel(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
 	void HandleRemoveChannel(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
@@ -234,4 +823,5 @@ private:
 	void HandleUnsubFromChannel(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
 	void HandleChannelDataUpdate(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
 	void HandleCreateSpatialChannel(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
+	void HandleSpatialRegionsUpdate(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
 };
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "ChanneldEntityGroups.h"
+
+FChanneldEntityGroups::FGroup& FChanneldEntityGroups::MarkDirty(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType)
+{
+	const FGroupKey Key(EntityChId, static_cast<int32>(GroupType));
+	FGroup& Group = Groups.FindOrAdd(Key);
+	if (!Group.bDirty)
+	{
+		Group.bDirty = true;
+		DirtyGroups.Add(Key);
+	}
+	return Group;
+}
+
+void FChanneldEntityGroups::Add(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, TArrayView<const Channeld::EntityId> Entities)
+{
+	FGroup& Group = MarkDirty(EntityChId, GroupType);
+	for (const Channeld::EntityId EntityId : Entities)
+	{
+		Group.Members.Add(EntityId);
+		Group.PendingRemoves.Remove(EntityId);
+	}
+}
+
+void FChanneldEntityGroups::Remove(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, TArrayView<const Channeld::EntityId> Entities)
+{
+	FGroup& Group = MarkDirty(EntityChId, GroupType);
+	for (const Channeld::EntityId EntityId : Entities)
+	{
+		Group.Members.Remove(EntityId);
+		Group.PendingRemoves.Add(EntityId);
+	}
+}
+
+void FChanneldEntityGroups::Flush(TFunctionRef<void(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, const TArray<Channeld::EntityId>& Added, const TArray<Channeld::EntityId>& Removed)> Func)
+{
+	TArray<Channeld::EntityId> Added, Removed;
+	for (const FGroupKey& Key : DirtyGroups)
+	{
+		FGroup* Group = Groups.Find(Key);
+		if (Group == nullptr)
+		{
+			// Removed with the entity channel.
+			continue;
+		}
+		Group->bDirty = false;
+
+		Added.Reset();
+		Removed.Reset();
+		for (const Channeld::EntityId EntityId : Group->Members)
+		{
+			if (!Group->SentMembers.Contains(EntityId))
+			{
+				Added.Add(EntityId);
+			}
+		}
+		// The sent members that are no longer in the group are all in PendingRemoves.
+		for (const Channeld::EntityId EntityId : Group->PendingRemoves)
+		{
+			Removed.Add(EntityId);
+		}
+		Group->PendingRemoves.Reset();
+
+		if (Group->Members.Num() == 0)
+		{
+			Groups.Remove(Key);
+		}
+		else
+		{
+			Group->SentMembers = Group->Members;
+		}
+		if (Added.Num() > 0 || Removed.Num() > 0)
+		{
+			Func(Key.Key, static_cast<channeldpb::EntityGroupType>(Key.Value), Added, Removed);
+		}
+	}
+	DirtyGroups.Reset();
+}
+
+const TSet<Channeld::EntityId>* FChanneldEntityGroups::GetMembers(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType) const
+{
+	const FGroup* Group = Groups.Find(FGroupKey(EntityChId, static_cast<int32>(GroupType)));
+	return Group && Group->Members.Num() > 0 ? &Group->Members : nullptr;
+}
+
+void FChanneldEntityGroups::RemoveEntityChannel(Channeld::EntityId EntityChId)
+{
+	for (auto It = Groups.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Key == EntityChId)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FChanneldEntityGroups::Reset()
+{
+	Groups.Reset();
+	DirtyGroups.Reset();
+}
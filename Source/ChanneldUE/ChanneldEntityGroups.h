@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChanneldTypes.h"
+
+/**
+ * Caches the members of the entity groups (handover and lock) set up by a connection, and coalesces the changes of a group in a frame into
+ * at most one ENTITY_GROUP_ADD and one ENTITY_GROUP_REMOVE message. Adding an existing member sends nothing. Every removed entity is sent,
+ * even if it's not in the cache, as the cache only knows the changes made by this connection since the last reset, and the group can have
+ * the members added by another server before a handover, or by this connection before a session resume.
+ * It drops the groups of a removed entity channel. Game thread only.
+ */
+class CHANNELDUE_API FChanneldEntityGroups
+{
+public:
+	void Add(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, TArrayView<const Channeld::EntityId> Entities);
+	void Remove(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, TArrayView<const Channeld::EntityId> Entities);
+	// Passes the entities added to and removed from each changed group since the last flush. Either array can be empty.
+	void Flush(TFunctionRef<void(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType, const TArray<Channeld::EntityId>& Added, const TArray<Channeld::EntityId>& Removed)> Func);
+	// Returns nullptr if the group has no member.
+	const TSet<Channeld::EntityId>* GetMembers(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType) const;
+	// Drops the groups of the entity channel, including the pending changes. channeld drops the groups with the channel.
+	void RemoveEntityChannel(Channeld::EntityId EntityChId);
+	void Reset();
+
+private:
+	typedef TPair<Channeld::EntityId, int32> FGroupKey;
+	struct FGroup
+	{
+		// Including the pending changes.
+		TSet<Channeld::EntityId> Members;
+		// As channeld knows since the last flush.
+		TSet<Channeld::EntityId> SentMembers;
+		// The entities requested to be removed since the last flush, whether they are cached or not.
+		TSet<Channeld::EntityId> PendingRemoves;
+		bool bDirty = false;
+	};
+	FGroup& MarkDirty(Channeld::EntityId EntityChId, channeldpb::EntityGroupType GroupType);
+
+	TMap<FGroupKey, FGroup> Groups;
+	TArray<FGroupKey> DirtyGroups;
+};
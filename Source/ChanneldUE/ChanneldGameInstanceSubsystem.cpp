@@ -5,11 +5,21 @@
 #include "Kismet/GameplayStatics.h"
 #include "ChanneldUtils.h"
 #include "ChanneldSettings.h"
+#include "ChanneldMetrics.h"
+#include "EngineUtils.h"
+#include "Misc/FileHelper.h"
 
 void UChanneldGameInstanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	GetMutableDefault<UChanneldSettings>()->UpdateNetDriverDefinitions();
 	InitConnection();
+
+	if (IsRunningDedicatedServer() && FParse::Value(FCommandLine::Get(), TEXT("ChanneldReloadFile="), ReloadRequestFile))
+	{
+		// The request that exists before the launch has been fulfilled by the command line.
+		FFileHelper::LoadFileToString(LastReloadRequest, *ReloadRequestFile);
+		UE_LOG(LogChanneld, Log, TEXT("Watching the reload requests of the resident server: %s"), *ReloadRequestFile);
+	}
 }
 
 void UChanneldGameInstanceSubsystem::Deinitialize()
@@ -32,7 +42,15 @@ void UChanneldGameInstanceSubsystem::Deinitialize()
 	ConnectionInstance->RemoveMessageHandler((uint32)channeldpb::UNSUB_FROM_CHANNEL, this);
 	ConnectionInstance->RemoveMessageHandler((uint32)channeldpb::CHANNEL_DATA_UPDATE, this);
 	// ConnectionInstance->OnUserSpaceMessageReceived.RemoveAll(this);
-	ConnectionInstance->Disconnect();
+	if (ConnectionInstance->GetOuter() == this)
+	{
+		// Disconnects and releases the buffers of the connection owned by this game instance.
+		ConnectionInstance->Deinitialize();
+	}
+	else
+	{
+		ConnectionInstance->Disconnect();
+	}
 
 	Super::Deinitialize();
 }
@@ -45,6 +63,11 @@ void UChanneldGameInstanceSubsystem::Tick(float DeltaTime)
 		ConnectionInstance->TickIncoming();
 		ConnectionInstance->TickOutgoing();
 	}
+
+	if (!ReloadRequestFile.IsEmpty())
+	{
+		CheckReloadRequest();
+	}
 }
 
 void UChanneldGameInstanceSubsystem::InitConnection()
@@ -67,7 +90,18 @@ void UChanneldGameInstanceSubsystem::InitConnection()
 		ConnectionInstance = NewObject<UChanneldConnection>(this);
 	}
 	*/
-	ConnectionInstance = GEngine->GetEngineSubsystem<UChanneldConnection>();
+	if (GetMutableDefault<UChanneldSettings>()->bConnectionPerGameInstance)
+	{
+		// The NetDriver of the game instance gets the connection from the subsystem.
+		UChanneldMetrics* Metrics = GEngine->GetEngineSubsystem<UChanneldMetrics>();
+		ConnectionInstance = NewObject<UChanneldConnection>(this);
+		ConnectionInstance->InitializeStandalone(Metrics);
+		Metrics->AddTrafficSource(ConnectionInstance);
+	}
+	else
+	{
+		ConnectionInstance = GEngine->GetEngineSubsystem<UChanneldConnection>();
+	}
 
 	ConnectionInstance->AddMessageHandler((uint32)channeldpb::AUTH, this, &UChanneldGameInstanceSubsystem::HandleAuthResult);
 	ConnectionInstance->AddMessageHandler((uint32)channeldpb::CREATE_CHANNEL, this, &UChanneldGameInstanceSubsystem::HandleCreateChannel);
@@ -212,12 +246,13 @@ void UChanneldGameInstanceSubsystem::ConnectToChanneld(bool& Success, FString& E
 
 	if (ConnectionInstance->IsConnected())
 	{
-		Error = TEXT("Already connected to channeld");
+		Error = ConnectionInstance->IsConnecting() ? TEXT("Already connecting to channeld") : TEXT("Already connected to channeld");
 		return;
 	}
 
 	if (ConnectionInstance->Connect(bInitAsClient, Host, Port, Error))
 	{
+		// Queued while connecting, and sent as soon as the connection is established.
 		ConnectionInstance->Auth(TEXT("test_pit"), TEXT("test_lt"),
 			[AuthCallback](const channeldpb::AuthResultMessage* Message)
 			{
@@ -380,10 +415,11 @@ int64 UChanneldGameInstanceSubsystem::GetEntityId(AActor* Actor)
 	return 0;
 }
 
-void UChanneldGameInstanceSubsystem::AddToHandoverGroup(AActor* JunctionEntity, const TArray<AActor*> EntitiesToAdd)
+void UChanneldGameInstanceSubsystem::AddToHandoverGroup(AActor* JunctionEntity, const TArray<AActor*>& EntitiesToAdd)
 {
 	Channeld::EntityId EntityChId = GetEntityId(JunctionEntity);
 	TArray<Channeld::EntityId> EntityIds;
+	EntityIds.Reserve(EntitiesToAdd.Num());
 	for (auto Entity : EntitiesToAdd)
 	{
 		EntityIds.Add(GetEntityId(Entity));
@@ -391,10 +427,11 @@ void UChanneldGameInstanceSubsystem::AddToHandoverGroup(AActor* JunctionEntity,
 	ConnectionInstance->AddToEntityGroup(EntityChId, channeldpb::HANDOVER, EntityIds);
 }
 
-void UChanneldGameInstanceSubsystem::RemoveFromHandoverGroup(AActor* JunctionEntity, const TArray<AActor*> EntitiesToRemove)
+void UChanneldGameInstanceSubsystem::RemoveFromHandoverGroup(AActor* JunctionEntity, const TArray<AActor*>& EntitiesToRemove)
 {
 	Channeld::EntityId EntityChId = GetEntityId(JunctionEntity);
 	TArray<Channeld::EntityId> EntityIds;
+	EntityIds.Reserve(EntitiesToRemove.Num());
 	for (auto Entity : EntitiesToRemove)
 	{
 		EntityIds.Add(GetEntityId(Entity));
@@ -402,10 +439,11 @@ void UChanneldGameInstanceSubsystem::RemoveFromHandoverGroup(AActor* JunctionEnt
 	ConnectionInstance->RemoveFromEntityGroup(EntityChId, channeldpb::HANDOVER, EntityIds);
 }
 
-void UChanneldGameInstanceSubsystem::AddToLockGroup(AActor* JunctionEntity, const TArray<AActor*> EntitiesToAdd)
+void UChanneldGameInstanceSubsystem::AddToLockGroup(AActor* JunctionEntity, const TArray<AActor*>& EntitiesToAdd)
 {
 	Channeld::EntityId EntityChId = GetEntityId(JunctionEntity);
 	TArray<Channeld::EntityId> EntityIds;
+	EntityIds.Reserve(EntitiesToAdd.Num());
 	for (auto Entity : EntitiesToAdd)
 	{
 		EntityIds.Add(GetEntityId(Entity));
@@ -413,10 +451,11 @@ void UChanneldGameInstanceSubsystem::AddToLockGroup(AActor* JunctionEntity, cons
 	ConnectionInstance->AddToEntityGroup(EntityChId, channeldpb::LOCK, EntityIds);
 }
 
-void UChanneldGameInstanceSubsystem::RemoveFromLockGroup(AActor* JunctionEntity, const TArray<AActor*> EntitiesToRemove)
+void UChanneldGameInstanceSubsystem::RemoveFromLockGroup(AActor* JunctionEntity, const TArray<AActor*>& EntitiesToRemove)
 {
 	Channeld::EntityId EntityChId = GetEntityId(JunctionEntity);
 	TArray<Channeld::EntityId> EntityIds;
+	EntityIds.Reserve(EntitiesToRemove.Num());
 	for (auto Entity : EntitiesToRemove)
 	{
 		EntityIds.Add(GetEntityId(Entity));
@@ -517,11 +556,19 @@ void UChanneldGameInstanceSubsystem::SetLowLevelSendToChannelId(int32 ChId)
 
 void UChanneldGameInstanceSubsystem::OpenLevel(FName LevelName, bool bAbsolute /*= true*/, FString Options /*= FString(TEXT(""))*/)
 {
+	if (ChannelDataView)
+	{
+		ChannelDataView->OnClientTravel(Channeld::InvalidChannelId);
+	}
 	UGameplayStatics::OpenLevel(this, LevelName, bAbsolute, Options);
 }
 
 void UChanneldGameInstanceSubsystem::OpenLevelByObjPtr(const TSoftObjectPtr<UWorld> Level, bool bAbsolute /*= true*/, FString Options /*= FString(TEXT(""))*/)
 {
+	if (ChannelDataView)
+	{
+		ChannelDataView->OnClientTravel(Channeld::InvalidChannelId);
+	}
 	UGameplayStatics::OpenLevelBySoftObjectPtr(this, Level, bAbsolute, Options);
 }
 
@@ -534,6 +581,11 @@ void UChanneldGameInstanceSubsystem::SeamlessTravelToChannel(APlayerController*
 		ConnectionInstance->SubToChannel(ChId);
 	}
 	SetLowLevelSendToChannelId(ChId);
+	if (ChannelDataView)
+	{
+		// Subscribe in parallel with the travel.
+		ChannelDataView->OnClientTravel(ChId);
+	}
 
 	UWorld* World = GetWorld();
 	// Map name starts with '/Game/Maps'
@@ -541,6 +593,57 @@ void UChanneldGameInstanceSubsystem::SeamlessTravelToChannel(APlayerController*
 	PlayerController->ClientTravel(FString::Printf(TEXT("127.0.0.1%s"), *MapName), ETravelType::TRAVEL_Relative, true);
 }
 
+bool UChanneldGameInstanceSubsystem::StartSpectating()
+{
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	if (!Settings->bSpectatorMode)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("StartSpectating requires the spectator mode to be enabled"));
+		return false;
+	}
+
+	UWorld* World = GetWorld();
+	if (World == nullptr || World->GetNetDriver() != nullptr)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("StartSpectating requires a standalone world"));
+		return false;
+	}
+
+	// There's no pending net game to create the net driver, as the map is loaded locally.
+	if (!GEngine->CreateNamedNetDriver(World, NAME_GameNetDriver, NAME_GameNetDriver))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to create the net driver for spectating"));
+		return false;
+	}
+	UNetDriver* NetDriver = GEngine->FindNamedNetDriver(World, NAME_GameNetDriver);
+	NetDriver->SetWorld(World);
+	World->SetNetDriver(NetDriver);
+
+	FURL URL;
+	URL.Host = Settings->ChanneldIpForClient;
+	URL.Port = Settings->ChanneldPortForClient;
+	FString Error;
+	if (!NetDriver->InitConnect(World, URL, Error))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to start spectating: %s"), *Error);
+		World->SetNetDriver(nullptr);
+		GEngine->DestroyNamedNetDriver(World, NAME_GameNetDriver);
+		return false;
+	}
+
+	// The actors placed in the level are simulated from the channel data, as in the world of a normal client.
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (It->GetIsReplicated() && It->IsNetStartupActor() && It->HasAuthority())
+		{
+			It->SetRole(ROLE_SimulatedProxy);
+		}
+	}
+
+	UE_LOG(LogChanneld, Log, TEXT("Started spectating via channeld %s:%d"), *URL.Host, URL.Port);
+	return true;
+}
+
 UClientInterestManager* UChanneldGameInstanceSubsystem::GetClientInterestManager(APlayerController* PC)
 {
 	if (auto NetConn = Cast<UChanneldNetConnection>(PC->GetNetConnection()))
@@ -555,7 +658,8 @@ void UChanneldGameInstanceSubsystem::HandleAuthResult(UChanneldConnection* Conn,
 {
 	auto AuthResultMsg = static_cast<const channeldpb::AuthResultMessage*>(Msg);
 
-	if (AuthResultMsg->result() == channeldpb::AuthResultMessage_AuthResult_SUCCESSFUL && AuthResultMsg->connid() == Conn->GetConnId())
+	// The view is kept when the session is resumed.
+	if (AuthResultMsg->result() == channeldpb::AuthResultMessage_AuthResult_SUCCESSFUL && AuthResultMsg->connid() == Conn->GetConnId() && !Conn->IsResumingSession())
 	{
 		InitChannelDataView();
 	}
@@ -677,6 +781,58 @@ void UChanneldGameInstanceSubsystem::InitChannelDataView()
 	}
 }
 
+void UChanneldGameInstanceSubsystem::CheckReloadRequest()
+{
+	const double Now = FPlatformTime::Seconds();
+	if (Now < NextReloadRequestCheckTime)
+	{
+		return;
+	}
+	NextReloadRequestCheckTime = Now + 0.5;
+
+	FString Request;
+	if (!FFileHelper::LoadFileToString(Request, *ReloadRequestFile) || Request == LastReloadRequest)
+	{
+		return;
+	}
+	LastReloadRequest = Request;
+	ReloadServer(Request);
+}
+
+void UChanneldGameInstanceSubsystem::ReloadServer(const FString& Request)
+{
+	const TCHAR* Stream = *Request;
+	FString MapName;
+	if (!FParse::Token(Stream, MapName, false) || MapName.IsEmpty())
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Invalid reload request of the resident server: %s"), *Request);
+		return;
+	}
+
+	const auto Settings = GetMutableDefault<UChanneldSettings>();
+	FString ViewClassName;
+	if (FParse::Value(*Request, TEXT("ViewClass="), ViewClassName))
+	{
+		if (auto LoadedViewClass = LoadClass<UChannelDataView>(NULL, *ViewClassName))
+		{
+			Settings->ChannelDataViewClass = LoadedViewClass;
+		}
+	}
+	UE_LOG(LogChanneld, Log, TEXT("Reloading the resident server, map: %s, view: %s"), *MapName, *GetNameSafe(Settings->ChannelDataViewClass));
+
+	// The net driver of the new map connects to channeld again, and the view is created after the authentication.
+	if (ChannelDataView)
+	{
+		ChannelDataView->Unintialize();
+		ChannelDataView = nullptr;
+	}
+	if (ConnectionInstance && ConnectionInstance->IsConnected())
+	{
+		ConnectionInstance->Disconnect(true);
+	}
+	UGameplayStatics::OpenLevel(GetWorld(), FName(*MapName));
+}
+
 void UChanneldGameInstanceSubsystem::RegisterDataProvider(IChannelDataProvider* Provider)
 {
 	if (ChannelDataView)
@@ -173,16 +173,16 @@ public:
 	int64 GetEntityId(AActor* Actor);
 	
 	UFUNCTION(BlueprintCallable, Category = "Channeld|Entity")
-	void AddToHandoverGroup(AActor* JunctionEntity, const TArray<AActor*> EntitiesToAdd);
+	void AddToHandoverGroup(AActor* JunctionEntity, const TArray<AActor*>& EntitiesToAdd);
 	
 	UFUNCTION(BlueprintCallable, Category = "Channeld|Entity")
-	void RemoveFromHandoverGroup(AActor* JunctionEntity, const TArray<AActor*> EntitiesToRemove);
+	void RemoveFromHandoverGroup(AActor* JunctionEntity, const TArray<AActor*>& EntitiesToRemove);
 	
 	UFUNCTION(BlueprintCallable, Category = "Channeld|Entity")
-	void AddToLockGroup(AActor* JunctionEntity, const TArray<AActor*> EntitiesToAdd);
+	void AddToLockGroup(AActor* JunctionEntity, const TArray<AActor*>& EntitiesToAdd);
 	
 	UFUNCTION(BlueprintCallable, Category = "Channeld|Entity")
-	void RemoveFromLockGroup(AActor* JunctionEntity, const TArray<AActor*> EntitiesToRemove);
+	void RemoveFromLockGroup(AActor* JunctionEntity, const TArray<AActor*>& EntitiesToRemove);
 
 	UFUNCTION(BlueprintCallable, Category = "Channeld|Net", Meta = (ToolTip = "Only run on server"))
 		void ServerBroadcast(int32 ChId, int32 ClientConnId, UProtoMessageObject* MessageObject, EChanneldBroadcastType BroadcastType);
@@ -217,6 +217,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Channeld|Utility")
 		void SeamlessTravelToChannel(APlayerController* PlayerController, int32 ChId);
 
+	// Connect the current world to channeld as a read-only spectator. The map should have been loaded locally, as the spectator doesn't
+	// log in to the servers. Requires UChanneldSettings::bSpectatorMode.
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Spatial")
+		bool StartSpectating();
+
 	
 	UFUNCTION(BlueprintCallable, Category = "Channeld|Spatial")
 	UClientInterestManager* GetClientInterestManager(APlayerController* PC);
@@ -248,6 +253,15 @@ protected:
 	void HandleUserSpaceAnyMessage(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
 
 	void InitChannelDataView();
+
+	// Set by -ChanneldReloadFile= when the dedicated server is kept resident by the editor between the launches.
+	// The file has the map to load and the optional ViewClass=, in the same format as the command line.
+	FString ReloadRequestFile;
+	FString LastReloadRequest;
+	double NextReloadRequestCheckTime = 0;
+	void CheckReloadRequest();
+	// Reconnects to channeld with the view of the request, and loads the map of the request.
+	void ReloadServer(const FString& Request);
 };
 
 
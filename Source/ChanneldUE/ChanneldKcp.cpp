@@ -0,0 +1,709 @@
+#include "ChanneldKcp.h"
+
+namespace
+{
+	constexpr int32 RtoNoDelay = 30;
+	constexpr int32 RtoMin = 100;
+	constexpr int32 RtoDefault = 200;
+	constexpr int32 RtoMax = 60000;
+
+	constexpr uint8 CmdPush = 81;
+	constexpr uint8 CmdAck = 82;
+	constexpr uint8 CmdWindowAsk = 83;
+	constexpr uint8 CmdWindowTell = 84;
+
+	constexpr uint32 AskSend = 1;
+	constexpr uint32 AskTell = 2;
+
+	constexpr uint32 DefaultSendWindow = 32;
+	constexpr uint32 DefaultReceiveWindow = 128;
+	constexpr uint32 DefaultMtu = 1400;
+	constexpr uint32 DefaultInterval = 100;
+	constexpr uint32 DefaultDeadLink = 20;
+	constexpr uint32 ThreshInit = 2;
+	constexpr uint32 ThreshMin = 2;
+	constexpr uint32 ProbeInit = 7000;
+	constexpr uint32 ProbeLimit = 120000;
+	constexpr uint32 FastAckLimit = 5;
+
+	FORCEINLINE int32 TimeDiff(uint32 Later, uint32 Earlier)
+	{
+		return static_cast<int32>(Later - Earlier);
+	}
+
+	FORCEINLINE uint8* Encode8(uint8* Ptr, uint8 V)
+	{
+		*Ptr = V;
+		return Ptr + 1;
+	}
+
+	FORCEINLINE uint8* Encode16(uint8* Ptr, uint16 V)
+	{
+		Ptr[0] = V & 0xff;
+		Ptr[1] = V >> 8;
+		return Ptr + 2;
+	}
+
+	FORCEINLINE uint8* Encode32(uint8* Ptr, uint32 V)
+	{
+		Ptr[0] = V & 0xff;
+		Ptr[1] = (V >> 8) & 0xff;
+		Ptr[2] = (V >> 16) & 0xff;
+		Ptr[3] = V >> 24;
+		return Ptr + 4;
+	}
+
+	FORCEINLINE uint16 Decode16(const uint8* Ptr)
+	{
+		return Ptr[0] | (Ptr[1] << 8);
+	}
+
+	FORCEINLINE uint32 Decode32(const uint8* Ptr)
+	{
+		return Ptr[0] | (Ptr[1] << 8) | (Ptr[2] << 16) | (static_cast<uint32>(Ptr[3]) << 24);
+	}
+}
+
+FChanneldKcp::FChanneldKcp(uint32 InConv, const FOutputFunc& InOutput)
+	: Conv(InConv)
+	, Mtu(DefaultMtu)
+	, Mss(DefaultMtu - Overhead)
+	, SsThresh(ThreshInit)
+	, RxRto(RtoDefault)
+	, RxMinRto(RtoMin)
+	, SendWnd(DefaultSendWindow)
+	, ReceiveWnd(DefaultReceiveWindow)
+	, RemoteWnd(DefaultReceiveWindow)
+	, Interval(DefaultInterval)
+	, TsFlush(DefaultInterval)
+	, DeadLink(DefaultDeadLink)
+	, FastLimit(FastAckLimit)
+	, Output(InOutput)
+{
+	FlushBuffer.SetNumUninitialized((Mtu + Overhead) * 3);
+}
+
+bool FChanneldKcp::Send(const uint8* Data, int32 Size)
+{
+	if (Size < 0)
+	{
+		return false;
+	}
+
+	// Append to the last unsent segment
+	if (bStreamMode && SendQueue.Num() > SendQueueHead)
+	{
+		FSegment& Last = SendQueue.Last();
+		if (static_cast<uint32>(Last.Data.Num()) < Mss)
+		{
+			const int32 Extend = FMath::Min<int32>(Size, Mss - Last.Data.Num());
+			Last.Data.Append(Data, Extend);
+			Data += Extend;
+			Size -= Extend;
+			if (Size == 0)
+			{
+				return true;
+			}
+		}
+	}
+
+	uint32 Count = Size <= static_cast<int32>(Mss) ? 1 : (Size + Mss - 1) / Mss;
+	if (Count >= DefaultReceiveWindow)
+	{
+		return false;
+	}
+
+	for (uint32 i = 0; i < Count; i++)
+	{
+		const int32 SegSize = FMath::Min<int32>(Size, Mss);
+		FSegment& Seg = SendQueue.AddDefaulted_GetRef();
+		Seg.Data.Append(Data, SegSize);
+		Seg.Frg = bStreamMode ? 0 : static_cast<uint8>(Count - i - 1);
+		Data += SegSize;
+		Size -= SegSize;
+	}
+	return true;
+}
+
+int32 FChanneldKcp::PeekSize() const
+{
+	if (ReceiveQueue.Num() == 0)
+	{
+		return -1;
+	}
+
+	const FSegment& First = ReceiveQueue[0];
+	if (First.Frg == 0)
+	{
+		return First.Data.Num();
+	}
+	if (ReceiveQueue.Num() < First.Frg + 1)
+	{
+		return -1;
+	}
+
+	int32 Length = 0;
+	for (const FSegment& Seg : ReceiveQueue)
+	{
+		Length += Seg.Data.Num();
+		if (Seg.Frg == 0)
+		{
+			break;
+		}
+	}
+	return Length;
+}
+
+int32 FChanneldKcp::Recv(uint8* Buffer, int32 BufferSize)
+{
+	const int32 Size = PeekSize();
+	if (Size < 0)
+	{
+		return -1;
+	}
+	if (Size > BufferSize)
+	{
+		return -3;
+	}
+
+	const bool bRecover = static_cast<uint32>(ReceiveQueue.Num()) >= ReceiveWnd;
+
+	// Merge the fragments
+	int32 Length = 0;
+	int32 NumMerged = 0;
+	for (const FSegment& Seg : ReceiveQueue)
+	{
+		FMemory::Memcpy(Buffer + Length, Seg.Data.GetData(), Seg.Data.Num());
+		Length += Seg.Data.Num();
+		NumMerged++;
+		if (Seg.Frg == 0)
+		{
+			break;
+		}
+	}
+	ReceiveQueue.RemoveAt(0, NumMerged, false);
+
+	MoveToReceiveQueue();
+
+	// Tell the remote that the window is open again
+	if (bRecover && static_cast<uint32>(ReceiveQueue.Num()) < ReceiveWnd)
+	{
+		Probe |= AskTell;
+	}
+	return Length;
+}
+
+void FChanneldKcp::MoveToReceiveQueue()
+{
+	int32 NumMoved = 0;
+	for (FSegment& Seg : ReceiveBuffer)
+	{
+		if (Seg.Sn != RcvNxt || static_cast<uint32>(ReceiveQueue.Num()) >= ReceiveWnd)
+		{
+			break;
+		}
+		ReceiveQueue.Add(MoveTemp(Seg));
+		RcvNxt++;
+		NumMoved++;
+	}
+	if (NumMoved > 0)
+	{
+		ReceiveBuffer.RemoveAt(0, NumMoved, false);
+	}
+}
+
+void FChanneldKcp::UpdateAck(int32 Rtt)
+{
+	if (RxSrtt == 0)
+	{
+		RxSrtt = Rtt;
+		RxRttVal = Rtt / 2;
+	}
+	else
+	{
+		const int32 Delta = FMath::Abs(Rtt - RxSrtt);
+		RxRttVal = (3 * RxRttVal + Delta) / 4;
+		RxSrtt = FMath::Max((7 * RxSrtt + Rtt) / 8, 1);
+	}
+	const int32 Rto = RxSrtt + FMath::Max<int32>(Interval, 4 * RxRttVal);
+	RxRto = FMath::Clamp(Rto, RxMinRto, RtoMax);
+}
+
+void FChanneldKcp::ShrinkBuffer()
+{
+	SndUna = SendBuffer.Num() > 0 ? SendBuffer[0].Sn : SndNxt;
+}
+
+void FChanneldKcp::ParseAck(uint32 Sn)
+{
+	if (TimeDiff(Sn, SndUna) < 0 || TimeDiff(Sn, SndNxt) >= 0)
+	{
+		return;
+	}
+	for (int32 i = 0; i < SendBuffer.Num(); i++)
+	{
+		if (Sn == SendBuffer[i].Sn)
+		{
+			SendBuffer.RemoveAt(i, 1, false);
+			break;
+		}
+		if (TimeDiff(Sn, SendBuffer[i].Sn) < 0)
+		{
+			break;
+		}
+	}
+}
+
+void FChanneldKcp::ParseUna(uint32 Una)
+{
+	int32 NumAcked = 0;
+	for (const FSegment& Seg : SendBuffer)
+	{
+		if (TimeDiff(Una, Seg.Sn) <= 0)
+		{
+			break;
+		}
+		NumAcked++;
+	}
+	if (NumAcked > 0)
+	{
+		SendBuffer.RemoveAt(0, NumAcked, false);
+	}
+}
+
+void FChanneldKcp::ParseFastAck(uint32 Sn)
+{
+	if (TimeDiff(Sn, SndUna) < 0 || TimeDiff(Sn, SndNxt) >= 0)
+	{
+		return;
+	}
+	for (FSegment& Seg : SendBuffer)
+	{
+		if (TimeDiff(Sn, Seg.Sn) < 0)
+		{
+			break;
+		}
+		if (Sn != Seg.Sn)
+		{
+			Seg.FastAck++;
+		}
+	}
+}
+
+void FChanneldKcp::ParseData(FSegment&& NewSeg)
+{
+	const uint32 Sn = NewSeg.Sn;
+	if (TimeDiff(Sn, RcvNxt + ReceiveWnd) >= 0 || TimeDiff(Sn, RcvNxt) < 0)
+	{
+		return;
+	}
+
+	// Find the position from the back, as the segments mostly arrive in order.
+	int32 InsertIndex = 0;
+	for (int32 i = ReceiveBuffer.Num() - 1; i >= 0; i--)
+	{
+		if (ReceiveBuffer[i].Sn == Sn)
+		{
+			// Duplicated
+			return;
+		}
+		if (TimeDiff(Sn, ReceiveBuffer[i].Sn) > 0)
+		{
+			InsertIndex = i + 1;
+			break;
+		}
+	}
+	ReceiveBuffer.Insert(MoveTemp(NewSeg), InsertIndex);
+
+	MoveToReceiveQueue();
+}
+
+bool FChanneldKcp::Input(const uint8* Data, int32 Size)
+{
+	const uint32 PrevUna = SndUna;
+	uint32 MaxAck = 0;
+	bool bHasAck = false;
+
+	if (Data == nullptr || Size < static_cast<int32>(Overhead))
+	{
+		return false;
+	}
+
+	while (Size >= static_cast<int32>(Overhead))
+	{
+		if (Decode32(Data) != Conv)
+		{
+			return false;
+		}
+		const uint8 Cmd = Data[4];
+		const uint8 Frg = Data[5];
+		const uint16 Wnd = Decode16(Data + 6);
+		const uint32 Ts = Decode32(Data + 8);
+		const uint32 Sn = Decode32(Data + 12);
+		const uint32 Una = Decode32(Data + 16);
+		const uint32 Len = Decode32(Data + 20);
+		Data += Overhead;
+		Size -= Overhead;
+
+		if (static_cast<uint32>(Size) < Len)
+		{
+			return false;
+		}
+		if (Cmd != CmdPush && Cmd != CmdAck && Cmd != CmdWindowAsk && Cmd != CmdWindowTell)
+		{
+			return false;
+		}
+
+		RemoteWnd = Wnd;
+		ParseUna(Una);
+		ShrinkBuffer();
+
+		if (Cmd == CmdAck)
+		{
+			if (TimeDiff(Current, Ts) >= 0)
+			{
+				UpdateAck(TimeDiff(Current, Ts));
+			}
+			ParseAck(Sn);
+			ShrinkBuffer();
+			if (!bHasAck || TimeDiff(Sn, MaxAck) > 0)
+			{
+				bHasAck = true;
+				MaxAck = Sn;
+			}
+		}
+		else if (Cmd == CmdPush)
+		{
+			if (TimeDiff(Sn, RcvNxt + ReceiveWnd) < 0)
+			{
+				AckList.Emplace(Sn, Ts);
+				if (TimeDiff(Sn, RcvNxt) >= 0)
+				{
+					FSegment Seg;
+					Seg.Conv = Conv;
+					Seg.Cmd = Cmd;
+					Seg.Frg = Frg;
+					Seg.Wnd = Wnd;
+					Seg.Ts = Ts;
+					Seg.Sn = Sn;
+					Seg.Una = Una;
+					Seg.Data.Append(Data, Len);
+					ParseData(MoveTemp(Seg));
+				}
+			}
+		}
+		else if (Cmd == CmdWindowAsk)
+		{
+			Probe |= AskTell;
+		}
+
+		Data += Len;
+		Size -= Len;
+	}
+
+	if (bHasAck)
+	{
+		ParseFastAck(MaxAck);
+	}
+
+	// Grow the congestion window
+	if (TimeDiff(SndUna, PrevUna) > 0 && CongestionWnd < RemoteWnd)
+	{
+		if (CongestionWnd < SsThresh)
+		{
+			CongestionWnd++;
+			Incr += Mss;
+		}
+		else
+		{
+			if (Incr < Mss)
+			{
+				Incr = Mss;
+			}
+			Incr += (Mss * Mss) / Incr + (Mss / 16);
+			if ((CongestionWnd + 1) * Mss <= Incr)
+			{
+				CongestionWnd = (Incr + Mss - 1) / Mss;
+			}
+		}
+		if (CongestionWnd > RemoteWnd)
+		{
+			CongestionWnd = RemoteWnd;
+			Incr = RemoteWnd * Mss;
+		}
+	}
+	return true;
+}
+
+uint16 FChanneldKcp::GetUnusedWindow() const
+{
+	const uint32 NumQueued = ReceiveQueue.Num();
+	return NumQueued < ReceiveWnd ? static_cast<uint16>(ReceiveWnd - NumQueued) : 0;
+}
+
+uint8* FChanneldKcp::EncodeSegment(uint8* Ptr, const FSegment& Seg)
+{
+	Ptr = Encode32(Ptr, Seg.Conv);
+	Ptr = Encode8(Ptr, Seg.Cmd);
+	Ptr = Encode8(Ptr, Seg.Frg);
+	Ptr = Encode16(Ptr, Seg.Wnd);
+	Ptr = Encode32(Ptr, Seg.Ts);
+	Ptr = Encode32(Ptr, Seg.Sn);
+	Ptr = Encode32(Ptr, Seg.Una);
+	Ptr = Encode32(Ptr, Seg.Data.Num());
+	return Ptr;
+}
+
+uint8* FChanneldKcp::OutputIfFull(uint8* Ptr, uint32 Size)
+{
+	uint8* const Begin = FlushBuffer.GetData();
+	if (static_cast<uint32>(Ptr - Begin) + Size > Mtu)
+	{
+		Output(Begin, Ptr - Begin);
+		return Begin;
+	}
+	return Ptr;
+}
+
+void FChanneldKcp::Flush()
+{
+	if (!bUpdated)
+	{
+		return;
+	}
+
+	uint8* const Begin = FlushBuffer.GetData();
+	uint8* Ptr = Begin;
+
+	FSegment Seg;
+	Seg.Conv = Conv;
+	Seg.Cmd = CmdAck;
+	Seg.Wnd = GetUnusedWindow();
+	Seg.Una = RcvNxt;
+
+	// Acknowledgements
+	for (const TPair<uint32, uint32>& Ack : AckList)
+	{
+		Ptr = OutputIfFull(Ptr, Overhead);
+		Seg.Sn = Ack.Key;
+		Seg.Ts = Ack.Value;
+		Ptr = EncodeSegment(Ptr, Seg);
+	}
+	AckList.Reset();
+
+	// Probe the remote window size if it's zero
+	if (RemoteWnd == 0)
+	{
+		if (ProbeWait == 0)
+		{
+			ProbeWait = ProbeInit;
+			TsProbe = Current + ProbeWait;
+		}
+		else if (TimeDiff(Current, TsProbe) >= 0)
+		{
+			ProbeWait = FMath::Max(ProbeWait, ProbeInit);
+			ProbeWait = FMath::Min(ProbeWait + ProbeWait / 2, ProbeLimit);
+			TsProbe = Current + ProbeWait;
+			Probe |= AskSend;
+		}
+	}
+	else
+	{
+		TsProbe = 0;
+		ProbeWait = 0;
+	}
+
+	Seg.Sn = 0;
+	Seg.Ts = 0;
+	if (Probe & AskSend)
+	{
+		Seg.Cmd = CmdWindowAsk;
+		Ptr = OutputIfFull(Ptr, Overhead);
+		Ptr = EncodeSegment(Ptr, Seg);
+	}
+	if (Probe & AskTell)
+	{
+		Seg.Cmd = CmdWindowTell;
+		Ptr = OutputIfFull(Ptr, Overhead);
+		Ptr = EncodeSegment(Ptr, Seg);
+	}
+	Probe = 0;
+
+	uint32 Cwnd = FMath::Min(SendWnd, RemoteWnd);
+	if (!bNoCongestionControl)
+	{
+		Cwnd = FMath::Min(CongestionWnd, Cwnd);
+	}
+
+	// Move the segments from the send queue to the send buffer, within the window
+	while (TimeDiff(SndNxt, SndUna + Cwnd) < 0 && SendQueueHead < SendQueue.Num())
+	{
+		FSegment& NewSeg = SendBuffer.Add_GetRef(MoveTemp(SendQueue[SendQueueHead++]));
+		NewSeg.Conv = Conv;
+		NewSeg.Cmd = CmdPush;
+		NewSeg.Wnd = Seg.Wnd;
+		NewSeg.Ts = Current;
+		NewSeg.Sn = SndNxt++;
+		NewSeg.Una = RcvNxt;
+		NewSeg.ResendTs = Current;
+		NewSeg.Rto = RxRto;
+		NewSeg.FastAck = 0;
+		NewSeg.Xmit = 0;
+	}
+	if (SendQueueHead >= SendQueue.Num())
+	{
+		SendQueue.Reset();
+		SendQueueHead = 0;
+	}
+	else if (SendQueueHead > 64 && SendQueueHead > SendQueue.Num() / 2)
+	{
+		SendQueue.RemoveAt(0, SendQueueHead, false);
+		SendQueueHead = 0;
+	}
+
+	const uint32 Resent = FastResend > 0 ? FastResend : MAX_uint32;
+	const uint32 RtoMinExtra = bNoDelay ? 0 : (RxRto >> 3);
+	bool bChange = false;
+	bool bLost = false;
+
+	for (FSegment& SendSeg : SendBuffer)
+	{
+		bool bNeedSend = false;
+		if (SendSeg.Xmit == 0)
+		{
+			bNeedSend = true;
+			SendSeg.Xmit++;
+			SendSeg.Rto = RxRto;
+			SendSeg.ResendTs = Current + SendSeg.Rto + RtoMinExtra;
+		}
+		else if (TimeDiff(Current, SendSeg.ResendTs) >= 0)
+		{
+			bNeedSend = true;
+			SendSeg.Xmit++;
+			if (!bNoDelay)
+			{
+				SendSeg.Rto += FMath::Max<uint32>(SendSeg.Rto, RxRto);
+			}
+			else
+			{
+				SendSeg.Rto += SendSeg.Rto / 2;
+			}
+			SendSeg.ResendTs = Current + SendSeg.Rto;
+			bLost = true;
+		}
+		else if (SendSeg.FastAck >= Resent)
+		{
+			if (SendSeg.Xmit <= FastLimit || FastLimit == 0)
+			{
+				bNeedSend = true;
+				SendSeg.Xmit++;
+				SendSeg.FastAck = 0;
+				SendSeg.ResendTs = Current + SendSeg.Rto;
+				bChange = true;
+			}
+		}
+
+		if (bNeedSend)
+		{
+			SendSeg.Ts = Current;
+			SendSeg.Wnd = Seg.Wnd;
+			SendSeg.Una = RcvNxt;
+
+			Ptr = OutputIfFull(Ptr, Overhead + SendSeg.Data.Num());
+			Ptr = EncodeSegment(Ptr, SendSeg);
+			if (SendSeg.Data.Num() > 0)
+			{
+				FMemory::Memcpy(Ptr, SendSeg.Data.GetData(), SendSeg.Data.Num());
+				Ptr += SendSeg.Data.Num();
+			}
+
+			if (SendSeg.Xmit >= DeadLink)
+			{
+				bDeadLink = true;
+			}
+		}
+	}
+
+	if (Ptr > Begin)
+	{
+		Output(Begin, Ptr - Begin);
+	}
+
+	if (bChange)
+	{
+		const uint32 Inflight = SndNxt - SndUna;
+		SsThresh = FMath::Max(Inflight / 2, ThreshMin);
+		CongestionWnd = SsThresh + Resent;
+		Incr = CongestionWnd * Mss;
+	}
+	if (bLost)
+	{
+		SsThresh = FMath::Max(Cwnd / 2, ThreshMin);
+		CongestionWnd = 1;
+		Incr = Mss;
+	}
+	if (CongestionWnd < 1)
+	{
+		CongestionWnd = 1;
+		Incr = Mss;
+	}
+}
+
+void FChanneldKcp::Update(uint32 InCurrent)
+{
+	Current = InCurrent;
+	if (!bUpdated)
+	{
+		bUpdated = true;
+		TsFlush = Current;
+	}
+
+	int32 Slap = TimeDiff(Current, TsFlush);
+	if (Slap >= 10000 || Slap < -10000)
+	{
+		TsFlush = Current;
+		Slap = 0;
+	}
+
+	if (Slap >= 0)
+	{
+		TsFlush += Interval;
+		if (TimeDiff(Current, TsFlush) >= 0)
+		{
+			TsFlush = Current + Interval;
+		}
+		Flush();
+	}
+}
+
+void FChanneldKcp::SetNoDelay(bool bInNoDelay, int32 InInterval, int32 InFastResend, bool bInNoCongestionControl)
+{
+	bNoDelay = bInNoDelay;
+	RxMinRto = bNoDelay ? RtoNoDelay : RtoMin;
+	Interval = FMath::Clamp(InInterval, 10, 5000);
+	FastResend = FMath::Max(InFastResend, 0);
+	bNoCongestionControl = bInNoCongestionControl;
+}
+
+void FChanneldKcp::SetWindowSize(uint32 SendWindow, uint32 ReceiveWindow)
+{
+	if (SendWindow > 0)
+	{
+		SendWnd = SendWindow;
+	}
+	if (ReceiveWindow > 0)
+	{
+		ReceiveWnd = FMath::Max(ReceiveWindow, DefaultReceiveWindow);
+	}
+}
+
+void FChanneldKcp::SetMtu(uint32 InMtu)
+{
+	if (InMtu < 50 || InMtu < Overhead)
+	{
+		return;
+	}
+	Mtu = InMtu;
+	Mss = Mtu - Overhead;
+	FlushBuffer.SetNumUninitialized((Mtu + Overhead) * 3);
+}
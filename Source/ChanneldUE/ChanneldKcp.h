@@ -0,0 +1,140 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Implementation of the KCP protocol (https://github.com/skywind3000/kcp), an ARQ protocol on top of UDP that
+ * trades bandwidth for lower latency than TCP under packet loss. The wire format is the same as ikcp and kcp-go, which
+ * channeld uses for the KCP listener.
+ *
+ * Not thread-safe. The owner should lock around the calls.
+ */
+class CHANNELDUE_API FChanneldKcp
+{
+public:
+	// Called with each UDP datagram to be sent.
+	typedef TFunction<void(const uint8* Data, int32 Size)> FOutputFunc;
+
+	static constexpr uint32 Overhead = 24;
+
+	FChanneldKcp(uint32 InConv, const FOutputFunc& InOutput);
+
+	/**
+	 * @brief Queue the data to be sent. In stream mode, the data is appended to the last unsent segment.
+	 * @return False if the data needs more fragments than the receive window allows.
+	 */
+	bool Send(const uint8* Data, int32 Size);
+
+	/**
+	 * @brief Read the next complete message.
+	 * @return The size of the message, -1 if there's no complete message, or -3 if BufferSize is not large enough.
+	 */
+	int32 Recv(uint8* Buffer, int32 BufferSize);
+
+	// The size of the next complete message, or -1 if there's none.
+	int32 PeekSize() const;
+
+	// Feed a received UDP datagram. Returns false if the datagram is malformed or belongs to another conversation.
+	bool Input(const uint8* Data, int32 Size);
+
+	// Should be called repeatedly (every Interval milliseconds), with the current time in milliseconds.
+	void Update(uint32 Current);
+
+	// Acknowledge, send and resend the segments right now.
+	void Flush();
+
+	/**
+	 * @brief Configure the latency/bandwidth trade-off, as ikcp_nodelay.
+	 * @param bNoDelay Use the minimum RTO of 30ms and slower RTO backoff.
+	 * @param InInterval The interval of the internal update in milliseconds.
+	 * @param InFastResend Resend a segment after this many ACKs skipped it. 0 disables the fast resend.
+	 * @param bNoCongestionControl Disable the congestion window.
+	 */
+	void SetNoDelay(bool bNoDelay, int32 InInterval, int32 InFastResend, bool bNoCongestionControl);
+	void SetWindowSize(uint32 SendWindow, uint32 ReceiveWindow);
+	void SetMtu(uint32 InMtu);
+	void SetStreamMode(bool bStream) { bStreamMode = bStream; }
+
+	// The number of segments waiting to be sent or acknowledged.
+	FORCEINLINE int32 GetWaitingSegments() const { return SendBuffer.Num() + SendQueue.Num() - SendQueueHead; }
+	FORCEINLINE uint32 GetSendWindow() const { return SendWnd; }
+	FORCEINLINE uint32 GetMss() const { return Mss; }
+	FORCEINLINE uint32 GetInterval() const { return Interval; }
+	// A segment has been resent too many times without an ACK.
+	FORCEINLINE bool IsDeadLink() const { return bDeadLink; }
+
+private:
+	struct FSegment
+	{
+		uint32 Conv = 0;
+		uint8 Cmd = 0;
+		uint8 Frg = 0;
+		uint16 Wnd = 0;
+		uint32 Ts = 0;
+		uint32 Sn = 0;
+		uint32 Una = 0;
+		uint32 ResendTs = 0;
+		uint32 Rto = 0;
+		uint32 FastAck = 0;
+		uint32 Xmit = 0;
+		TArray<uint8> Data;
+	};
+
+	static uint8* EncodeSegment(uint8* Ptr, const FSegment& Seg);
+	uint16 GetUnusedWindow() const;
+	void UpdateAck(int32 Rtt);
+	void ShrinkBuffer();
+	void ParseAck(uint32 Sn);
+	void ParseUna(uint32 Una);
+	void ParseFastAck(uint32 Sn);
+	void ParseData(FSegment&& Seg);
+	void MoveToReceiveQueue();
+	// Output the pending bytes in FlushBuffer if adding Size bytes would exceed the MTU.
+	uint8* OutputIfFull(uint8* Ptr, uint32 Size);
+
+	uint32 Conv;
+	uint32 Mtu;
+	uint32 Mss;
+	uint32 SndUna = 0;
+	uint32 SndNxt = 0;
+	uint32 RcvNxt = 0;
+	uint32 SsThresh;
+	int32 RxRttVal = 0;
+	int32 RxSrtt = 0;
+	int32 RxRto;
+	int32 RxMinRto;
+	uint32 SendWnd;
+	uint32 ReceiveWnd;
+	uint32 RemoteWnd;
+	uint32 CongestionWnd = 0;
+	uint32 Incr = 0;
+	uint32 Probe = 0;
+	uint32 Current = 0;
+	uint32 Interval;
+	uint32 TsFlush;
+	uint32 TsProbe = 0;
+	uint32 ProbeWait = 0;
+	uint32 DeadLink;
+	uint32 FastResend = 0;
+	uint32 FastLimit;
+	bool bNoDelay = false;
+	bool bNoCongestionControl = false;
+	bool bStreamMode = false;
+	bool bUpdated = false;
+	bool bDeadLink = false;
+
+	// Unsent segments. The sent ones before SendQueueHead are removed lazily.
+	TArray<FSegment> SendQueue;
+	int32 SendQueueHead = 0;
+	// Sent but not yet acknowledged segments.
+	TArray<FSegment> SendBuffer;
+	// The segments received out of order.
+	TArray<FSegment> ReceiveBuffer;
+	// The segments received in order, waiting for Recv().
+	TArray<FSegment> ReceiveQueue;
+	// Pairs of (sn, ts) to be acknowledged.
+	TArray<TPair<uint32, uint32>> AckList;
+	TArray<uint8> FlushBuffer;
+
+	FOutputFunc Output;
+};
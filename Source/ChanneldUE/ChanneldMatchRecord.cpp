@@ -0,0 +1,225 @@
+#include "ChanneldMatchRecord.h"
+#include "ChanneldTypes.h"
+#include "channeld.pb.h"
+#include "HAL/FileManager.h"
+
+bool FChanneldMatchRecordWriter::Open(const FString& FilePath, float InKeyframeInterval)
+{
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to open the match record file: %s"), *FilePath);
+		return false;
+	}
+
+	uint32 Magic = ChanneldMatchRecord::Magic;
+	uint32 Version = ChanneldMatchRecord::Version;
+	*Writer << Magic << Version;
+	WriterFilePath = FilePath;
+	StartTime = FPlatformTime::Seconds();
+	KeyframeInterval = InKeyframeInterval;
+	NextKeyframeTime = KeyframeInterval;
+	UE_LOG(LogChanneld, Log, TEXT("Started recording the match to %s"), *FilePath);
+	return true;
+}
+
+void FChanneldMatchRecordWriter::Close()
+{
+	if (!Writer.IsValid())
+	{
+		return;
+	}
+
+	int64 IndexOffset = Writer->Tell();
+	int32 NumKeyframes = KeyframeOffsets.Num();
+	*Writer << NumKeyframes;
+	for (auto& Pair : KeyframeOffsets)
+	{
+		*Writer << Pair.Key << Pair.Value;
+	}
+	*Writer << IndexOffset;
+	Writer->Close();
+	Writer.Reset();
+	UE_LOG(LogChanneld, Log, TEXT("Saved the match record with %d keyframes to %s"), NumKeyframes, *WriterFilePath);
+
+	MergedChannelData.Empty();
+	KeyframeOffsets.Empty();
+}
+
+void FChanneldMatchRecordWriter::Write(uint32 ChId, uint32 MsgType, const std::string& MsgBody)
+{
+	if (!Writer.IsValid())
+	{
+		return;
+	}
+
+	const double Time = FPlatformTime::Seconds() - StartTime;
+	// The keyframe goes before the record, so playing back from the keyframe doesn't skip the record.
+	if (KeyframeInterval > 0 && Time >= NextKeyframeTime)
+	{
+		WriteKeyframe(Time);
+		NextKeyframeTime = Time + KeyframeInterval;
+	}
+
+	if (MsgType == channeldpb::CHANNEL_DATA_UPDATE)
+	{
+		MergeChannelData(ChId, MsgBody);
+	}
+	else if (MsgType == channeldpb::REMOVE_CHANNEL)
+	{
+		channeldpb::RemoveChannelMessage RemoveMsg;
+		if (RemoveMsg.ParseFromString(MsgBody))
+		{
+			MergedChannelData.Remove(RemoveMsg.channelid());
+		}
+	}
+	WriteRecord(Time, ChId, MsgType, false, reinterpret_cast<const uint8*>(MsgBody.data()), MsgBody.size());
+}
+
+void FChanneldMatchRecordWriter::WriteRecord(double Time, uint32 ChId, uint32 MsgType, bool bKeyframe, const uint8* Data, int32 Size)
+{
+	uint8 KeyframeByte = bKeyframe ? 1 : 0;
+	*Writer << Time << ChId << MsgType << KeyframeByte << Size;
+	Writer->Serialize(const_cast<uint8*>(Data), Size);
+}
+
+void FChanneldMatchRecordWriter::MergeChannelData(uint32 ChId, const std::string& MsgBody)
+{
+	channeldpb::ChannelDataUpdateMessage UpdateMsg;
+	if (!UpdateMsg.ParseFromString(MsgBody))
+	{
+		return;
+	}
+
+	const std::string& TypeUrl = UpdateMsg.data().type_url();
+	const std::string TypeName = TypeUrl.substr(TypeUrl.find_last_of('/') + 1);
+	TUniquePtr<google::protobuf::Message>* Merged = MergedChannelData.Find(ChId);
+	if (Merged == nullptr || (*Merged)->GetTypeName() != TypeName)
+	{
+		const google::protobuf::Descriptor* Descriptor = google::protobuf::DescriptorPool::generated_pool()->FindMessageTypeByName(TypeName);
+		if (Descriptor == nullptr)
+		{
+			UE_LOG(LogChanneld, Warning, TEXT("Unknown channel data type '%s' of channel %d, the channel is left out of the keyframes"), UTF8_TO_TCHAR(TypeName.c_str()), ChId);
+			MergedChannelData.Remove(ChId);
+			return;
+		}
+		Merged = &MergedChannelData.Add(ChId, TUniquePtr<google::protobuf::Message>(google::protobuf::MessageFactory::generated_factory()->GetPrototype(Descriptor)->New()));
+	}
+	(*Merged)->MergeFromString(UpdateMsg.data().value());
+}
+
+void FChanneldMatchRecordWriter::WriteKeyframe(double Time)
+{
+	if (MergedChannelData.Num() == 0)
+	{
+		return;
+	}
+
+	const int64 Offset = Writer->Tell();
+	channeldpb::ChannelDataUpdateMessage KeyframeMsg;
+	std::string Body;
+	for (auto& Pair : MergedChannelData)
+	{
+		KeyframeMsg.mutable_data()->PackFrom(*Pair.Value);
+		KeyframeMsg.SerializeToString(&Body);
+		WriteRecord(Time, Pair.Key, channeldpb::CHANNEL_DATA_UPDATE, true, reinterpret_cast<const uint8*>(Body.data()), Body.size());
+	}
+	KeyframeOffsets.Emplace(Time, Offset);
+}
+
+bool FChanneldMatchRecordReader::Load(const FString& FilePath, FString& Error)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader.IsValid())
+	{
+		Error = FString::Printf(TEXT("Failed to open the match record file: %s"), *FilePath);
+		return false;
+	}
+
+	uint32 Magic = 0, Version = 0;
+	*Reader << Magic << Version;
+	if (Magic != ChanneldMatchRecord::Magic || Version != ChanneldMatchRecord::Version)
+	{
+		Error = FString::Printf(TEXT("Invalid match record file: %s, magic: %x, version: %d"), *FilePath, Magic, Version);
+		return false;
+	}
+	const int64 RecordsOffset = Reader->Tell();
+	const int64 TotalSize = Reader->TotalSize();
+
+	// A recording that is not closed properly has no keyframe index, but the records are still valid.
+	int64 IndexOffset = TotalSize;
+	TArray<TPair<double, int64>> KeyframeOffsets;
+	if (TotalSize >= RecordsOffset + static_cast<int64>(sizeof(int64)))
+	{
+		Reader->Seek(TotalSize - sizeof(int64));
+		*Reader << IndexOffset;
+		int32 NumKeyframes = 0;
+		if (!Reader->IsError() && IndexOffset >= RecordsOffset && IndexOffset + static_cast<int64>(sizeof(int32)) <= TotalSize - static_cast<int64>(sizeof(int64)))
+		{
+			Reader->Seek(IndexOffset);
+			*Reader << NumKeyframes;
+		}
+		constexpr int64 KeyframeSize = sizeof(double) + sizeof(int64);
+		if (NumKeyframes >= 0 && IndexOffset + static_cast<int64>(sizeof(int32)) + NumKeyframes * KeyframeSize + static_cast<int64>(sizeof(int64)) == TotalSize)
+		{
+			KeyframeOffsets.SetNum(NumKeyframes);
+			for (auto& Pair : KeyframeOffsets)
+			{
+				*Reader << Pair.Key << Pair.Value;
+			}
+		}
+		else
+		{
+			UE_LOG(LogChanneld, Warning, TEXT("The match record has no keyframe index: %s"), *FilePath);
+			IndexOffset = TotalSize;
+		}
+	}
+
+	Reader->Seek(RecordsOffset);
+	Records.Reset();
+	Keyframes.Reset();
+	int32 NextKeyframe = 0;
+	while (Reader->Tell() < IndexOffset)
+	{
+		const int64 Offset = Reader->Tell();
+		for (; NextKeyframe < KeyframeOffsets.Num() && KeyframeOffsets[NextKeyframe].Value <= Offset; NextKeyframe++)
+		{
+			if (KeyframeOffsets[NextKeyframe].Value == Offset)
+			{
+				Keyframes.Add({KeyframeOffsets[NextKeyframe].Key, Records.Num()});
+			}
+		}
+
+		double Time;
+		uint32 ChId, MsgType;
+		uint8 KeyframeByte;
+		int32 Size;
+		*Reader << Time << ChId << MsgType << KeyframeByte << Size;
+		if (Reader->IsError() || Size < 0 || Size > IndexOffset - Reader->Tell())
+		{
+			UE_LOG(LogChanneld, Warning, TEXT("Truncated match record file: %s, loaded %d records"), *FilePath, Records.Num());
+			break;
+		}
+
+		ChanneldMatchRecord::FRecord& Record = Records.AddDefaulted_GetRef();
+		Record.Time = Time;
+		Record.ChId = ChId;
+		Record.MsgType = MsgType;
+		Record.bKeyframe = KeyframeByte != 0;
+		Record.Body.SetNumUninitialized(Size);
+		Reader->Serialize(Record.Body.GetData(), Size);
+	}
+	return true;
+}
+
+const ChanneldMatchRecord::FKeyframe* FChanneldMatchRecordReader::FindKeyframe(double Time) const
+{
+	for (int32 i = Keyframes.Num() - 1; i >= 0; i--)
+	{
+		if (Keyframes[i].Time <= Time)
+		{
+			return &Keyframes[i];
+		}
+	}
+	return nullptr;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "google/protobuf/message.h"
+
+/**
+ * The match record file: the messages received by a recorder connection from channeld, i.e. the channel data updates, the spawn,
+ * destroy and RPC messages and the subscriptions, plus the keyframes of the merged channel data for seeking. Unlike the capture
+ * file (see ChanneldCapture), the records are the messages rather than the raw stream, so they can be played back from a keyframe.
+ *
+ * Layout: Magic (uint32) | Version (uint32) | the records | the keyframe index | the offset of the keyframe index (int64)
+ * Record: Time (double) | ChId (uint32) | MsgType (uint32) | bKeyframe (uint8) | Size (int32) | the message body
+ * Keyframe index: Num (int32) | (Time (double), the offset of the first record of the keyframe (int64)) * Num
+ */
+namespace ChanneldMatchRecord
+{
+	static constexpr uint32 Magic = 0x524D4443; // "CDMR"
+	static constexpr uint32 Version = 1;
+
+	struct FRecord
+	{
+		// Seconds since the recording started.
+		double Time;
+		uint32 ChId;
+		uint32 MsgType;
+		// The merged channel data of a channel at the time of a keyframe, as a ChannelDataUpdateMessage.
+		bool bKeyframe;
+		TArray<uint8> Body;
+	};
+
+	struct FKeyframe
+	{
+		double Time;
+		// The index of the first record of the keyframe in FChanneldMatchRecordReader::Records.
+		int32 RecordIndex;
+	};
+}
+
+/**
+ * Appends the messages received by a connection to a match record file. The channel data updates are also merged into
+ * the state of each channel, which is written as a keyframe every KeyframeInterval seconds. The merge is a plain protobuf
+ * merge, so the removed entries of the maps stay in the keyframes until the next update of the channel removes them.
+ * Called on the receive thread only.
+ */
+class CHANNELDUE_API FChanneldMatchRecordWriter
+{
+public:
+	~FChanneldMatchRecordWriter() { Close(); }
+
+	bool Open(const FString& FilePath, float InKeyframeInterval);
+	// Writes the keyframe index and closes the file.
+	void Close();
+	FORCEINLINE bool IsOpen() const { return Writer.IsValid(); }
+
+	void Write(uint32 ChId, uint32 MsgType, const std::string& MsgBody);
+
+private:
+	void WriteRecord(double Time, uint32 ChId, uint32 MsgType, bool bKeyframe, const uint8* Data, int32 Size);
+	void MergeChannelData(uint32 ChId, const std::string& MsgBody);
+	void WriteKeyframe(double Time);
+
+	TUniquePtr<FArchive> Writer;
+	FString WriterFilePath;
+	double StartTime = 0;
+	float KeyframeInterval = 0;
+	double NextKeyframeTime = 0;
+	TMap<uint32, TUniquePtr<google::protobuf::Message>> MergedChannelData;
+	TArray<TPair<double, int64>> KeyframeOffsets;
+};
+
+// Reads all the records of a match record file into memory.
+class CHANNELDUE_API FChanneldMatchRecordReader
+{
+public:
+	bool Load(const FString& FilePath, FString& Error);
+
+	// Returns the latest keyframe at or before the time, or nullptr if there's none.
+	const ChanneldMatchRecord::FKeyframe* FindKeyframe(double Time) const;
+
+	TArray<ChanneldMatchRecord::FRecord> Records;
+	TArray<ChanneldMatchRecord::FKeyframe> Keyframes;
+};
@@ -4,6 +4,51 @@
 #include "ChanneldConnection.h"
 #include "ChanneldSettings.h"
 
+namespace
+{
+	FAutoConsoleCommand ReportNativeRPCFallbacksCommand(
+		TEXT("channeld.NativeRPCFallbacks"),
+		TEXT("Log the RPCs that fell back to the native path and save the report"),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			if (UChanneldMetrics* Metrics = GEngine ? GEngine->GetEngineSubsystem<UChanneldMetrics>() : nullptr)
+			{
+				Metrics->ReportNativeRPCFallbacks();
+			}
+		}));
+
+	FAutoConsoleCommand DumpWireSizesCommand(
+		TEXT("channeld.WireSizes"),
+		TEXT("Log the bytes of the sampled channel data updates by message type and field. Usage: channeld.WireSizes [MaxRows]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (UChanneldMetrics* Metrics = GEngine ? GEngine->GetEngineSubsystem<UChanneldMetrics>() : nullptr)
+			{
+				Metrics->WireSizeSampler.Dump(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 30);
+			}
+		}));
+}
+
+const TCHAR* LexToString(ERPCDropReason Reason)
+{
+	switch (Reason)
+	{
+	case RPCDropReason_InvalidMulticast: return TEXT("InvalidMulticast");
+	case RPCDropReason_RedirMaxRetried: return TEXT("RedirMaxRetried");
+	case RPCDropReason_RedirNoChannel: return TEXT("RedirNoChannel");
+	case RPCDropReason_RedirNoView: return TEXT("RedirNoView");
+	case RPCDropReason_SerializeFailed: return TEXT("SerializeFailed");
+	case RPCDropReason_NoRepComp: return TEXT("NoRepComp");
+	case RPCDropReason_NoAuthority: return TEXT("NoAuthority");
+	case RPCDropReason_DeserializeFailed: return TEXT("DeserializeFailed");
+	case RPCDropReason_RateLimited: return TEXT("RateLimited");
+	case RPCDropReason_Superseded: return TEXT("Superseded");
+	case RPCDropReason_DeferredMaxRetried: return TEXT("DeferredMaxRetried");
+	case RPCDropReason_UnexportedMaxRetried: return TEXT("UnexportedMaxRetried");
+	default: return TEXT("Unknown");
+	}
+}
+
 void UChanneldMetrics::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Collection.InitializeDependency(UMetricsSubsystem::StaticClass());
@@ -22,7 +67,7 @@ void UChanneldMetrics::Initialize(FSubsystemCollectionBase& Collection)
 		MetricsName = FApp::GetProjectName();
 	}
 	
-	const Labels NameLabel = {{ "name", TCHAR_TO_UTF8(*MetricsName) }};
+	NameLabel = {{ "name", TCHAR_TO_UTF8(*MetricsName) }};
 	auto Metrics = GEngine->GetEngineSubsystem<UMetricsSubsystem>();
 	
 	FPS = &Metrics->AddGaugeFamily(FName("ue_server_fps"), TEXT("Framerate of the UE server"));
@@ -39,6 +84,27 @@ void UChanneldMetrics::Initialize(FSubsystemCollectionBase& Collection)
 	
 	DroppedPacket = &Metrics->AddCounterFamily(FName("ue_packets_drop"), TEXT("Number of dropped packets"));
 	DroppedPacket_Counter = &DroppedPacket->Add(NameLabel);
+
+	CompressionSavedBytes = &Metrics->AddCounterFamily(FName("ue_packets_compression_saved"), TEXT("Number of bytes saved by the packet compression, both sent and received"));
+	CompressionSavedBytes_Counter = &CompressionSavedBytes->Add(NameLabel);
+
+	PendingRpcStubs = &Metrics->AddGaugeFamily(FName("ue_rpc_stubs_pending"), TEXT("Number of the RPC callbacks waiting for the response from channeld"));
+	PendingRpcStubs_Gauge = &PendingRpcStubs->Add(NameLabel);
+
+	SendPressure = &Metrics->AddGaugeFamily(FName("ue_send_pressure"), TEXT("Send pressure of the connection to channeld, from 0 to 1"));
+	SendPressure_Gauge = &SendPressure->Add(NameLabel);
+
+	ChanneldTickPhase = &Metrics->AddGaugeFamily(FName("ue_channeld_tick_phase_ms"), TEXT("Estimated phase of the arrivals of channeld's fan-outs within the tick interval, in milliseconds"));
+	ChanneldTickPhase_Gauge = &ChanneldTickPhase->Add(NameLabel);
+
+	FrameArenaHighWater = &Metrics->AddGaugeFamily(FName("ue_frame_arena_high_water"), TEXT("Max bytes used by the frame arena of the channel data view in a frame"));
+	FrameArenaHighWater_Gauge = &FrameArenaHighWater->Add(NameLabel);
+
+	MessagePackPoolHit = &Metrics->AddCounterFamily(FName("ue_msgpack_pool_hits"), TEXT("Number of the outgoing message packs reused from the pool"));
+	MessagePackPoolHit_Counter = &MessagePackPoolHit->Add(NameLabel);
+
+	MessagePackPoolMiss = &Metrics->AddCounterFamily(FName("ue_msgpack_pool_misses"), TEXT("Number of the outgoing message packs allocated as the pool is empty"));
+	MessagePackPoolMiss_Counter = &MessagePackPoolMiss->Add(NameLabel);
 	
 	ReplicatedProviders = &Metrics->AddCounterFamily(FName("ue_provider_reps"), TEXT("Number of the replicated data providers"));
 	ReplicatedProviders_Counter = &ReplicatedProviders->Add(NameLabel);
@@ -54,12 +120,102 @@ void UChanneldMetrics::Initialize(FSubsystemCollectionBase& Collection)
 
 	RedirectedRPCs = &Metrics->AddCounterFamily(FName("ue_rpc_redir"), TEXT("Number of the RPCs redirected"));
 	RedirectedRPCs_Counter = &RedirectedRPCs->Add(NameLabel);
+
+	NativeRPCFallbacks = &Metrics->AddCounterFamily(FName("ue_rpc_native_fallback"), TEXT("Number of the RPCs sent by the native UE path as the replicators failed to send them"));
+	NativeRPCFallbacks_Counter = &NativeRPCFallbacks->Add(NameLabel);
+
+	NativeRPCFallbackBytes = &Metrics->AddCounterFamily(FName("ue_rpc_native_fallback_bytes"), TEXT("Bunch bytes of the RPCs sent by the native UE path, summed over the connections"));
+	NativeRPCFallbackBytes_Counter = &NativeRPCFallbackBytes->Add(NameLabel);
+	StartTime = FPlatformTime::Seconds();
+
+	DeferredRPCs = &Metrics->AddGaugeFamily(FName("ue_rpc_deferred"), TEXT("Number of the received RPCs waiting for the target actor or the NetGUIDs to be resolved"));
+	DeferredRPCs_Gauge = &DeferredRPCs->Add(NameLabel);
+
+	ObjRefCacheSize = &Metrics->AddGaugeFamily(FName("ue_objref_cache_size"), TEXT("Number of the full-exported object refs cached by the NetDriver"));
+	ObjRefCacheSize_Gauge = &ObjRefCacheSize->Add(NameLabel);
+
+	ObjRefCacheBytes = &Metrics->AddGaugeFamily(FName("ue_objref_cache_bytes"), TEXT("Approximate bytes of the object refs cached by the NetDriver"));
+	ObjRefCacheBytes_Gauge = &ObjRefCacheBytes->Add(NameLabel);
+
+	OwningChannelMappings = &Metrics->AddGaugeFamily(FName("ue_owning_channel_mappings"), TEXT("Number of the NetId to owning channel mappings in the channel data view"));
+	OwningChannelMappings_Gauge = &OwningChannelMappings->Add(NameLabel);
+
+	ServerInterestBytes = &Metrics->AddCounterFamily(FName("ue_server_interest_bytes"), TEXT("Bytes of the channel data updates received by the server from the channels it doesn't own"));
+	ServerInterestBytes_Counter = &ServerInterestBytes->Add(NameLabel);
 	
 	Handovers = &Metrics->AddCounterFamily(FName("ue_handovers"), TEXT("Number of handovers"));
+
+	SendLatency = &Metrics->AddHistogramFamily(FName("ue_msg_send_latency_ms"), TEXT("Milliseconds from enqueuing a message to writing it to the socket, sampled"));
+	DispatchLatency = &Metrics->AddHistogramFamily(FName("ue_msg_dispatch_latency_ms"), TEXT("Milliseconds from receiving a message to dispatching it to the handlers, sampled"));
+	HandleTime = &Metrics->AddHistogramFamily(FName("ue_msg_handle_ms"), TEXT("Milliseconds spent in the handlers of a message, sampled"));
+
+	static const Histogram::BucketBoundaries SizeBuckets = {64, 256, 1024, 4096, 16384, 65536, 262144, 1048576};
+	Labels SentLabels = NameLabel;
+	SentLabels.emplace("direction", "sent");
+	Labels ReceivedLabels = NameLabel;
+	ReceivedLabels.emplace("direction", "received");
+
+	// Accumulated in FChanneldTrafficStats by the same buckets.
+	Histogram::BucketBoundaries PacketSizeBuckets;
+	for (int32 i = 0; i < FChanneldTrafficStats::NumPacketSizeBuckets; i++)
+	{
+		PacketSizeBuckets.push_back(FChanneldTrafficStats::GetPacketSizeBucketBound(i));
+	}
+	PacketSize = &Metrics->AddHistogramFamily(FName("ue_packet_size_bytes"), TEXT("Bytes of the packets sent to and received from channeld, after compression"));
+	SentPacketSize_Histogram = &PacketSize->Add(SentLabels, PacketSizeBuckets);
+	ReceivedPacketSize_Histogram = &PacketSize->Add(ReceivedLabels, PacketSizeBuckets);
+
+	ChannelUpdateSize = &Metrics->AddHistogramFamily(FName("ue_channel_update_bytes"), TEXT("Bytes of the channel data in each channel data update sent or received"));
+	SentChannelUpdateSize_Histogram = &ChannelUpdateSize->Add(SentLabels, SizeBuckets);
+	ReceivedChannelUpdateSize_Histogram = &ChannelUpdateSize->Add(ReceivedLabels, SizeBuckets);
+
+	HandoverDuration = &Metrics->AddHistogramFamily(FName("ue_handover_duration_ms"), TEXT("Milliseconds spent in processing a handover on the server"));
+	HandoverDuration_Histogram = &HandoverDuration->Add(NameLabel, Histogram::BucketBoundaries{0.1, 0.2, 0.5, 1, 2, 5, 10, 20, 50, 100});
+
+	InterestSpatialChannels = &Metrics->AddGaugeFamily(FName("ue_interest_spatial_channels"), TEXT("Number of the spatial channels the client is subscribed to. On the server, only the channels it owns"));
+	InterestEntityChannels = &Metrics->AddGaugeFamily(FName("ue_interest_entity_channels"), TEXT("Number of the entity channels the client is subscribed to. On the server, only the channels it owns"));
+	InterestChurn = &Metrics->AddCounterFamily(FName("ue_interest_churn"), TEXT("Number of the subscriptions and unsubscriptions of the client to the spatial and entity channels"));
+	InterestSpawnsPerChange = &Metrics->AddHistogramFamily(FName("ue_interest_spawns_per_change"), TEXT("Number of the entities spawned for the client after each change of its interest"));
+
+	TrafficBytes = &Metrics->AddCounterFamily(FName("ue_traffic_bytes"), TEXT("Bytes of the message bodies sent to and received from channeld, by msgType and channel type"));
+	TrafficMessages = &Metrics->AddCounterFamily(FName("ue_traffic_msgs"), TEXT("Number of the messages sent to and received from channeld, by msgType and channel type"));
+
+	ChannelReplicationTime = &Metrics->AddCounterFamily(FName("ue_channel_rep_ms"), TEXT("Milliseconds spent in collecting, merging and consuming the channel data, by channel type"));
+	ChannelReplicationBytes = &Metrics->AddCounterFamily(FName("ue_channel_rep_bytes"), TEXT("Bytes of the channel data updates sent and received, by channel type"));
+	ProviderCollectTime = &Metrics->AddCounterFamily(FName("ue_provider_collect_ms"), TEXT("Milliseconds spent in updating the channel data by the providers, by the class of the target object"));
+
+	NetFrameTime = &Metrics->AddGaugeFamily(FName("ue_net_frame_ms"), TEXT("Milliseconds spent in the networking work on the game thread in the last frame, by stage"));
+	NetFrameTimeHistogram = &Metrics->AddHistogramFamily(FName("ue_net_frame_time_ms"), TEXT("Milliseconds spent in the networking work on the game thread in each frame, by stage"));
+	static const Histogram::BucketBoundaries NetFrameBuckets = {0.5, 1, 2, 4, 8, 16, 33, 66};
+	static const char* NetFrameStageNames[NumNetFrameStats] = {"incoming", "replicate", "outgoing", "total"};
+	for (int32 i = 0; i < NumNetFrameStats; i++)
+	{
+		Labels StageLabels = NameLabel;
+		StageLabels.emplace("stage", NetFrameStageNames[i]);
+		NetFrameTime_Gauges[i] = &NetFrameTime->Add(StageLabels);
+		NetFrameTime_Histograms[i] = &NetFrameTimeHistogram->Add(StageLabels, NetFrameBuckets);
+	}
+	NetFramesOverBudget = &Metrics->AddCounterFamily(FName("ue_net_frames_over_budget"), TEXT("Number of the frames whose networking work on the game thread took longer than NetFrameBudgetMs"));
+	NetFramesOverBudget_Counter = &NetFramesOverBudget->Add(NameLabel);
+
+	SpatialChannels = &Metrics->AddGaugeFamily(FName("ue_spatial_channels"), TEXT("Number of the spatial channels owned by the spatial server"));
+	SpatialChannels_Gauge = &SpatialChannels->Add(NameLabel);
+	SpatialEntities = &Metrics->AddGaugeFamily(FName("ue_spatial_entities"), TEXT("Number of the entities in the spatial channels owned by the spatial server"));
+	SpatialEntities_Gauge = &SpatialEntities->Add(NameLabel);
+	SpatialLoad = &Metrics->AddGaugeFamily(FName("ue_spatial_load"), TEXT("Load of the spatial server, where 1 means fully loaded by SpatialServerTargetFrameMs or SpatialServerTargetEntities"));
+	SpatialLoad_Gauge = &SpatialLoad->Add(NameLabel);
+
+	WireBytes = &Metrics->AddCounterFamily(FName("ue_wire_bytes"), TEXT("Bytes of the fields in the sampled channel data updates sent, by message type and field"));
+	WireSizeSampler.Init(GetDefault<UChanneldSettings>()->WireSizeSampleRate);
+
+	NetFrameBudgetSeconds = GetDefault<UChanneldSettings>()->NetFrameBudgetMs / 1000.0;
+	bTrackFrameOffenders = NetFrameBudgetSeconds > 0;
 }
 
 void UChanneldMetrics::Deinitialize()
 {
+	ReportNativeRPCFallbacks();
+
 	auto Metrics = GEngine->GetEngineSubsystem<UMetricsSubsystem>();
 	FPS->Remove(FPS_Gauge);
 	Metrics->Remove(*FPS);
@@ -76,6 +232,27 @@ void UChanneldMetrics::Deinitialize()
 	DroppedPacket->Remove(DroppedPacket_Counter);
 	Metrics->Remove(*DroppedPacket);
 
+	CompressionSavedBytes->Remove(CompressionSavedBytes_Counter);
+	Metrics->Remove(*CompressionSavedBytes);
+
+	PendingRpcStubs->Remove(PendingRpcStubs_Gauge);
+	Metrics->Remove(*PendingRpcStubs);
+
+	SendPressure->Remove(SendPressure_Gauge);
+	Metrics->Remove(*SendPressure);
+
+	ChanneldTickPhase->Remove(ChanneldTickPhase_Gauge);
+	Metrics->Remove(*ChanneldTickPhase);
+
+	FrameArenaHighWater->Remove(FrameArenaHighWater_Gauge);
+	Metrics->Remove(*FrameArenaHighWater);
+
+	MessagePackPoolHit->Remove(MessagePackPoolHit_Counter);
+	Metrics->Remove(*MessagePackPoolHit);
+
+	MessagePackPoolMiss->Remove(MessagePackPoolMiss_Counter);
+	Metrics->Remove(*MessagePackPoolMiss);
+
 	ReplicatedProviders->Remove(ReplicatedProviders_Counter);
 	Metrics->Remove(*ReplicatedProviders);
 
@@ -90,8 +267,77 @@ void UChanneldMetrics::Deinitialize()
 
 	RedirectedRPCs->Remove(RedirectedRPCs_Counter);
 	Metrics->Remove(*RedirectedRPCs);
+
+	NativeRPCFallbacks->Remove(NativeRPCFallbacks_Counter);
+	Metrics->Remove(*NativeRPCFallbacks);
+
+	NativeRPCFallbackBytes->Remove(NativeRPCFallbackBytes_Counter);
+	Metrics->Remove(*NativeRPCFallbackBytes);
+
+	DeferredRPCs->Remove(DeferredRPCs_Gauge);
+	Metrics->Remove(*DeferredRPCs);
+
+	ObjRefCacheSize->Remove(ObjRefCacheSize_Gauge);
+	Metrics->Remove(*ObjRefCacheSize);
+
+	ObjRefCacheBytes->Remove(ObjRefCacheBytes_Gauge);
+	Metrics->Remove(*ObjRefCacheBytes);
+
+	OwningChannelMappings->Remove(OwningChannelMappings_Gauge);
+	Metrics->Remove(*OwningChannelMappings);
+
+	ServerInterestBytes->Remove(ServerInterestBytes_Counter);
+	Metrics->Remove(*ServerInterestBytes);
 	
 	Metrics->Remove(*Handovers);
+
+	Metrics->Remove(*SendLatency);
+	Metrics->Remove(*DispatchLatency);
+	Metrics->Remove(*HandleTime);
+
+	PacketSize->Remove(SentPacketSize_Histogram);
+	PacketSize->Remove(ReceivedPacketSize_Histogram);
+	Metrics->Remove(*PacketSize);
+
+	ChannelUpdateSize->Remove(SentChannelUpdateSize_Histogram);
+	ChannelUpdateSize->Remove(ReceivedChannelUpdateSize_Histogram);
+	Metrics->Remove(*ChannelUpdateSize);
+
+	HandoverDuration->Remove(HandoverDuration_Histogram);
+	Metrics->Remove(*HandoverDuration);
+
+	Metrics->Remove(*InterestSpatialChannels);
+	Metrics->Remove(*InterestEntityChannels);
+	Metrics->Remove(*InterestChurn);
+	Metrics->Remove(*InterestSpawnsPerChange);
+
+	Metrics->Remove(*TrafficBytes);
+	Metrics->Remove(*TrafficMessages);
+
+	Metrics->Remove(*ChannelReplicationTime);
+	Metrics->Remove(*ChannelReplicationBytes);
+	Metrics->Remove(*ProviderCollectTime);
+
+	for (int32 i = 0; i < NumNetFrameStats; i++)
+	{
+		NetFrameTime->Remove(NetFrameTime_Gauges[i]);
+		NetFrameTimeHistogram->Remove(NetFrameTime_Histograms[i]);
+	}
+	Metrics->Remove(*NetFrameTime);
+	Metrics->Remove(*NetFrameTimeHistogram);
+	NetFramesOverBudget->Remove(NetFramesOverBudget_Counter);
+	Metrics->Remove(*NetFramesOverBudget);
+
+	SpatialChannels->Remove(SpatialChannels_Gauge);
+	Metrics->Remove(*SpatialChannels);
+	SpatialEntities->Remove(SpatialEntities_Gauge);
+	Metrics->Remove(*SpatialEntities);
+	SpatialLoad->Remove(SpatialLoad_Gauge);
+	Metrics->Remove(*SpatialLoad);
+
+	WireSizeSampler.Init(0);
+	WireBytesCounters.Empty();
+	Metrics->Remove(*WireBytes);
 }
 
 void UChanneldMetrics::Tick(float DeltaTime)
@@ -99,6 +345,220 @@ void UChanneldMetrics::Tick(float DeltaTime)
 	FPS_Gauge->Set(1.0 / DeltaTime);
 	CPU_Gauge->Set(FPlatformTime::GetCPUTime().CPUTimePct);
 	MEM_Gauge->Set(FPlatformMemory::GetStats().UsedPhysical >> 20);
+	FlushTrafficStats();
+	if (WireSizeSampler.IsEnabled())
+	{
+		FlushWireSizes();
+	}
+}
+
+void UChanneldMetrics::FlushWireSizes()
+{
+	WireSizeSampler.ConsumeDeltas([this](const FChanneldWireSizeSampler::FFieldKey& Key, uint64 Bytes)
+	{
+		Counter*& WireBytesCounter = WireBytesCounters.FindOrAdd(Key);
+		if (WireBytesCounter == nullptr)
+		{
+			Labels FieldLabels = NameLabel;
+			FieldLabels.emplace("type", TCHAR_TO_UTF8(*Key.Key.ToString()));
+			FieldLabels.emplace("field", TCHAR_TO_UTF8(*Key.Value.ToString()));
+			WireBytesCounter = &WireBytes->Add(FieldLabels);
+		}
+		WireBytesCounter->Increment(Bytes);
+	});
+}
+
+void UChanneldMetrics::FlushTrafficStats()
+{
+	if (UChanneldConnection* Conn = GEngine->GetEngineSubsystem<UChanneldConnection>())
+	{
+		FlushTrafficStats(Conn->TrafficStats);
+	}
+	for (int32 i = ExtraTrafficSources.Num() - 1; i >= 0; i--)
+	{
+		if (ExtraTrafficSources[i].IsValid())
+		{
+			FlushTrafficStats(ExtraTrafficSources[i]->TrafficStats);
+		}
+		else
+		{
+			ExtraTrafficSources.RemoveAtSwap(i);
+		}
+	}
+}
+
+void UChanneldMetrics::FlushTrafficStats(FChanneldTrafficStats& Stats)
+{
+	FragmentedPacket_Counter->Increment(Stats.FragmentedPackets.Reset());
+	DroppedPacket_Counter->Increment(Stats.DroppedPackets.Reset());
+	for (int32 Direction = 0; Direction < FChanneldTrafficStats::NumDirections; Direction++)
+	{
+		FChanneldTrafficStats::FPacketSlot& PacketSlot = Stats.Packets[Direction];
+		CompressionSavedBytes_Counter->Increment(PacketSlot.CompressionSavedBytes.Reset());
+		const int64 PacketBytes = PacketSlot.Bytes.Reset();
+		if (PacketBytes > 0)
+		{
+			std::vector<double> BucketIncrements(FChanneldTrafficStats::NumPacketSizeBuckets + 1);
+			for (int32 i = 0; i <= FChanneldTrafficStats::NumPacketSizeBuckets; i++)
+			{
+				BucketIncrements[i] = PacketSlot.SizeBuckets[i].Reset();
+			}
+			Histogram* PacketSizeHistogram = Direction == FChanneldTrafficStats::Sent ? SentPacketSize_Histogram : ReceivedPacketSize_Histogram;
+			PacketSizeHistogram->ObserveMultiple(BucketIncrements, PacketBytes);
+		}
+	}
+
+	static const char* DirectionNames[FChanneldTrafficStats::NumDirections] = {"sent", "received"};
+	static const char* ChannelCategoryNames[FChanneldTrafficStats::NumChannelCategories] = {"global", "spatial", "entity", "other"};
+	for (int32 Direction = 0; Direction < FChanneldTrafficStats::NumDirections; Direction++)
+	{
+		for (uint32 MsgType = 0; MsgType <= FChanneldTrafficStats::MaxMsgTypes; MsgType++)
+		{
+			for (int32 Category = 0; Category < FChanneldTrafficStats::NumChannelCategories; Category++)
+			{
+				FChanneldTrafficStats::FSlot& Slot = Stats.Slots[Direction][MsgType][Category];
+				// Most of the slots are never used; skip them without the atomic exchange.
+				if (Slot.Messages.GetValue() == 0)
+				{
+					continue;
+				}
+
+				TPair<Counter*, Counter*>& Counters = TrafficCounters[Direction][MsgType][Category];
+				if (Counters.Key == nullptr)
+				{
+					Labels TrafficLabels = NameLabel;
+					TrafficLabels.emplace("direction", DirectionNames[Direction]);
+					TrafficLabels.emplace("msgType", MsgType < FChanneldTrafficStats::MaxMsgTypes ? std::to_string(MsgType) : "other");
+					TrafficLabels.emplace("channelType", ChannelCategoryNames[Category]);
+					Counters.Key = &TrafficBytes->Add(TrafficLabels);
+					Counters.Value = &TrafficMessages->Add(TrafficLabels);
+				}
+				Counters.Key->Increment(Slot.Bytes.Reset());
+				Counters.Value->Increment(Slot.Messages.Reset());
+			}
+		}
+	}
+}
+
+void UChanneldMetrics::OnMessageLatency(EChanneldMessageLatency Type, uint32 MsgType, double Seconds)
+{
+	static const Histogram::BucketBoundaries LatencyBuckets = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000};
+	Family<Histogram>* LatencyFamily = Type == EChanneldMessageLatency::Send ? SendLatency : (Type == EChanneldMessageLatency::Dispatch ? DispatchLatency : HandleTime);
+	Labels MsgLabels = NameLabel;
+	MsgLabels.emplace("msgType", std::to_string(MsgType));
+	// Family::Add() returns the existing histogram of the same labels.
+	LatencyFamily->Add(MsgLabels, LatencyBuckets).Observe(Seconds * 1000.0);
+}
+
+FChanneldInterestMetrics UChanneldMetrics::AddInterestMetrics(Channeld::ConnectionId ConnId)
+{
+	static const Histogram::BucketBoundaries SpawnBuckets = {0, 1, 2, 5, 10, 20, 50, 100, 200, 500};
+	Labels ConnLabels = NameLabel;
+	ConnLabels.emplace("connId", std::to_string(ConnId));
+	FChanneldInterestMetrics InterestMetrics;
+	InterestMetrics.SpatialChannels = &InterestSpatialChannels->Add(ConnLabels);
+	InterestMetrics.EntityChannels = &InterestEntityChannels->Add(ConnLabels);
+	InterestMetrics.Churn = &InterestChurn->Add(ConnLabels);
+	InterestMetrics.SpawnsPerChange = &InterestSpawnsPerChange->Add(ConnLabels, SpawnBuckets);
+	return InterestMetrics;
+}
+
+void UChanneldMetrics::RemoveInterestMetrics(FChanneldInterestMetrics& InterestMetrics)
+{
+	if (!InterestMetrics.IsValid())
+	{
+		return;
+	}
+	InterestSpatialChannels->Remove(InterestMetrics.SpatialChannels);
+	InterestEntityChannels->Remove(InterestMetrics.EntityChannels);
+	InterestChurn->Remove(InterestMetrics.Churn);
+	InterestSpawnsPerChange->Remove(InterestMetrics.SpawnsPerChange);
+	InterestMetrics = FChanneldInterestMetrics();
+}
+
+void UChanneldMetrics::OnChannelReplicationCost(const FChannelReplicationCost& Cost)
+{
+	Labels TypeLabels = NameLabel;
+	TypeLabels.emplace("channelType", TCHAR_TO_UTF8(*Cost.ChannelTypeName));
+	auto AddStage = [&](const char* Stage, double Seconds)
+	{
+		if (Seconds > 0)
+		{
+			Labels StageLabels = TypeLabels;
+			StageLabels.emplace("stage", Stage);
+			ChannelReplicationTime->Add(StageLabels).Increment(Seconds * 1000.0);
+		}
+	};
+	AddStage("collect", Cost.CollectSeconds);
+	AddStage("merge", Cost.MergeSeconds);
+	AddStage("consume", Cost.ConsumeSeconds);
+
+	auto AddBytes = [&](const char* Direction, uint64 Bytes)
+	{
+		if (Bytes > 0)
+		{
+			Labels DirectionLabels = TypeLabels;
+			DirectionLabels.emplace("direction", Direction);
+			ChannelReplicationBytes->Add(DirectionLabels).Increment(Bytes);
+		}
+	};
+	AddBytes("sent", Cost.SentBytes);
+	AddBytes("received", Cost.ReceivedBytes);
+}
+
+void UChanneldMetrics::OnProviderCollectTime(FName ClassName, double Seconds)
+{
+	Labels ClassLabels = NameLabel;
+	ClassLabels.emplace("class", TCHAR_TO_UTF8(*ClassName.ToString()));
+	ProviderCollectTime->Add(ClassLabels).Increment(Seconds * 1000.0);
+}
+
+void UChanneldMetrics::OnNetFrame(const double (&StageSeconds)[static_cast<int32>(EChanneldNetFrameStage::Max)])
+{
+	double TotalSeconds = 0;
+	for (int32 i = 0; i < static_cast<int32>(EChanneldNetFrameStage::Max); i++)
+	{
+		NetFrameTime_Gauges[i]->Set(StageSeconds[i] * 1000.0);
+		NetFrameTime_Histograms[i]->Observe(StageSeconds[i] * 1000.0);
+		TotalSeconds += StageSeconds[i];
+	}
+	NetFrameTime_Gauges[NumNetFrameStats - 1]->Set(TotalSeconds * 1000.0);
+	NetFrameTime_Histograms[NumNetFrameStats - 1]->Observe(TotalSeconds * 1000.0);
+
+	if (!bTrackFrameOffenders)
+	{
+		return;
+	}
+
+	if (TotalSeconds > NetFrameBudgetSeconds)
+	{
+		NetFramesOverBudget_Counter->Increment();
+		NumFramesOverBudget++;
+		// Only the offenders of the frame that triggers the warning are logged, so a long hitch doesn't flood the log.
+		const double Now = FPlatformTime::Seconds();
+		if (Now - LastOverBudgetWarningTime >= 1.0)
+		{
+			UE_LOG(LogChanneld, Warning, TEXT("Networking took %.2fms (incoming: %.2fms, replicate: %.2fms, outgoing: %.2fms), over the budget of %.2fms in %d frame(s). Costliest channel: %u (%.2fms), actor class: %s (%.2fms), msgType: %u (%.2fms)"),
+				TotalSeconds * 1000.0,
+				StageSeconds[static_cast<int32>(EChanneldNetFrameStage::Incoming)] * 1000.0,
+				StageSeconds[static_cast<int32>(EChanneldNetFrameStage::Replicate)] * 1000.0,
+				StageSeconds[static_cast<int32>(EChanneldNetFrameStage::Outgoing)] * 1000.0,
+				NetFrameBudgetSeconds * 1000.0, NumFramesOverBudget,
+				FrameOffenders.Channel.Key, FrameOffenders.Channel.Seconds * 1000.0,
+				*FrameOffenders.ActorClass.Key.ToString(), FrameOffenders.ActorClass.Seconds * 1000.0,
+				FrameOffenders.MsgType.Key, FrameOffenders.MsgType.Seconds * 1000.0);
+			LastOverBudgetWarningTime = Now;
+			NumFramesOverBudget = 0;
+		}
+	}
+	FrameOffenders.Reset();
+}
+
+void UChanneldMetrics::OnSpatialLoadReport(int32 NumChannels, int32 NumEntities, double Load)
+{
+	SpatialChannels_Gauge->Set(NumChannels);
+	SpatialEntities_Gauge->Set(NumEntities);
+	SpatialLoad_Gauge->Set(Load);
 }
 
 void UChanneldMetrics::OnDroppedRPC(const std::string& FuncName, ERPCDropReason Reason)
@@ -108,3 +568,42 @@ void UChanneldMetrics::OnDroppedRPC(const std::string& FuncName, ERPCDropReason
 	DroppedRPCs->Add({{"funcName", FuncName}, {"reason", std::to_string(Reason)}}).Increment();
 #endif
 }
+
+void UChanneldMetrics::OnNativeRPCFallback(const UFunction* Function, ERPCDropReason Reason, int64 Bytes)
+{
+	NativeRPCFallbacks_Counter->Increment();
+	NativeRPCFallbackBytes_Counter->Increment(Bytes);
+
+	const FString ClassPath = Function->GetOwnerClass()->GetPathName();
+	const FString FuncName = Function->GetName();
+	FChanneldNativeRPCFallback& Fallback = NativeRPCFallbackFunctions.FindOrAdd(ClassPath + TEXT("::") + FuncName);
+	if (Fallback.Calls == 0)
+	{
+		UE_LOG(LogChanneld, Warning, TEXT("RPC %s::%s fell back to the native path (%s). Run channeld.NativeRPCFallbacks for the report."), *ClassPath, *FuncName, LexToString(Reason));
+		Fallback.ClassPath = ClassPath;
+		Fallback.FuncName = FuncName;
+	}
+	Fallback.Reason = LexToString(Reason);
+	Fallback.Calls++;
+	Fallback.Bytes += Bytes;
+#if !UE_BUILD_SHIPPING
+	const std::string FuncLabel = TCHAR_TO_UTF8(*FuncName);
+	NativeRPCFallbacks->Add({{"funcName", FuncLabel}}).Increment();
+	NativeRPCFallbackBytes->Add({{"funcName", FuncLabel}}).Increment(Bytes);
+#endif
+}
+
+void UChanneldMetrics::ReportNativeRPCFallbacks()
+{
+	FChanneldNativeRPCFallbackReport Report;
+	Report.Duration = FPlatformTime::Seconds() - StartTime;
+	NativeRPCFallbackFunctions.GenerateValueArray(Report.Functions);
+	Report.Functions.Sort([](const FChanneldNativeRPCFallback& Lhs, const FChanneldNativeRPCFallback& Rhs) { return Lhs.Bytes > Rhs.Bytes; });
+	Report.Log();
+	if (Report.Functions.Num() > 0)
+	{
+		// One report per process, so the servers and the clients launched together don't overwrite each other's.
+		Report.Save(FChanneldNativeRPCFallbackReport::GetReportDir() / FString::Printf(TEXT("%s_%u.json"),
+			IsRunningDedicatedServer() ? TEXT("Server") : TEXT("Client"), FPlatformProcess::GetCurrentProcessId()));
+	}
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include "MetricsSubsystem.h"
 #include "View/ChannelDataView.h"
+#include "ChanneldNativeRPCFallbacks.h"
+#include "ChanneldWireSizeSampler.h"
 #include "ChanneldMetrics.generated.h"
 
 enum ERPCDropReason : uint8
@@ -14,6 +16,72 @@ enum ERPCDropReason : uint8
 	RPCDropReason_NoRepComp = 6,
 	RPCDropReason_NoAuthority = 7,
 	RPCDropReason_DeserializeFailed = 8,
+	RPCDropReason_RateLimited = 9,
+	RPCDropReason_Superseded = 10,
+	RPCDropReason_DeferredMaxRetried = 11,
+	RPCDropReason_UnexportedMaxRetried = 12,
+};
+
+CHANNELDUE_API const TCHAR* LexToString(ERPCDropReason Reason);
+
+enum class EChanneldMessageLatency : uint8
+{
+	// From UChanneldConnection::EnqueueMessage() to the packet written to the socket.
+	Send,
+	// From received to dispatched in UChanneldConnection::TickIncoming().
+	Dispatch,
+	// From dispatched to all the handlers and the RPC callback returned.
+	Handle,
+};
+
+// The interest metrics of a client connection, labeled by its connId. See UChanneldMetrics::AddInterestMetrics().
+struct FChanneldInterestMetrics
+{
+	Gauge* SpatialChannels = nullptr;
+	Gauge* EntityChannels = nullptr;
+	Counter* Churn = nullptr;
+	Histogram* SpawnsPerChange = nullptr;
+
+	bool IsValid() const { return SpatialChannels != nullptr; }
+};
+
+// The stages of the networking work on the game thread in a frame. See UChanneldMetrics::OnNetFrame().
+enum class EChanneldNetFrameStage : uint8
+{
+	// UChanneldNetDriver::TickDispatch
+	Incoming,
+	// ServerReplicateActors, or SendAllChannelUpdates when there's no client connection
+	Replicate,
+	// The rest of UChanneldNetDriver::TickFlush
+	Outgoing,
+	Max,
+};
+
+// The costliest item of a kind in the current frame, e.g. the channel that took the longest to collect.
+template <typename KeyType>
+struct TChanneldFrameOffender
+{
+	KeyType Key{};
+	double Seconds = 0;
+
+	FORCEINLINE void Add(const KeyType& InKey, double InSeconds)
+	{
+		if (InSeconds > Seconds)
+		{
+			Key = InKey;
+			Seconds = InSeconds;
+		}
+	}
+};
+
+// Only collected when UChanneldSettings::NetFrameBudgetMs is greater than 0. Reset at the end of each frame.
+struct FChanneldFrameOffenders
+{
+	TChanneldFrameOffender<Channeld::ChannelId> Channel;
+	TChanneldFrameOffender<FName> ActorClass;
+	TChanneldFrameOffender<uint32> MsgType;
+
+	void Reset() { *this = FChanneldFrameOffenders(); }
 };
 
 UCLASS(transient)
@@ -33,6 +101,30 @@ public:
 	//~ End FTickableGameObject Interface
 	
 	void OnDroppedRPC(const std::string& String, ERPCDropReason Reason);
+	// Record an RPC that fell back to the native path, and the bunch bytes it took. See FChanneldNativeRPCFallbackReport.
+	void OnNativeRPCFallback(const UFunction* Function, ERPCDropReason Reason, int64 Bytes);
+	// Log the native RPC fallbacks and save the report, if there's any.
+	void ReportNativeRPCFallbacks();
+	// The traffic of the connections not created as the engine subsystem (see UChanneldSettings::bConnectionPerGameInstance) is also drained into the metrics.
+	void AddTrafficSource(UChanneldConnection* Conn) { ExtraTrafficSources.AddUnique(Conn); }
+	// Record the latency of a message sampled by UChanneldConnection::TraceSampleRate. Thread-safe.
+	void OnMessageLatency(EChanneldMessageLatency Type, uint32 MsgType, double Seconds);
+	FChanneldInterestMetrics AddInterestMetrics(Channeld::ConnectionId ConnId);
+	// Remove the metrics of the connection, so the labels of the closed connections don't pile up.
+	void RemoveInterestMetrics(FChanneldInterestMetrics& InterestMetrics);
+	// Add the cost of a channel in the last report interval to the counters of its channel type. See UChanneldSettings::ReplicationProfileInterval.
+	void OnChannelReplicationCost(const FChannelReplicationCost& Cost);
+	void OnProviderCollectTime(FName ClassName, double Seconds);
+	// Report the seconds spent in each EChanneldNetFrameStage in this frame. Warns if the total is over UChanneldSettings::NetFrameBudgetMs.
+	void OnNetFrame(const double (&StageSeconds)[static_cast<int32>(EChanneldNetFrameStage::Max)]);
+	// Set by each load report of the spatial server. See UChanneldSettings::SpatialLoadReportInterval.
+	void OnSpatialLoadReport(int32 NumChannels, int32 NumEntities, double Load);
+
+	FORCEINLINE bool IsTrackingFrameOffenders() const { return bTrackFrameOffenders; }
+	// Only valid to write when IsTrackingFrameOffenders() is true. Game thread only.
+	FChanneldFrameOffenders FrameOffenders;
+	// Enabled by UChanneldSettings::WireSizeSampleRate. Dumped by the console command "channeld.WireSizes".
+	FChanneldWireSizeSampler WireSizeSampler;
 	
 	Family<Gauge>* FPS;
 	Gauge* FPS_Gauge;
@@ -48,6 +140,27 @@ public:
 
 	Family<Counter>* DroppedPacket;
 	Counter* DroppedPacket_Counter;
+
+	Family<Counter>* CompressionSavedBytes;
+	Counter* CompressionSavedBytes_Counter;
+
+	Family<Gauge>* PendingRpcStubs;
+	Gauge* PendingRpcStubs_Gauge;
+
+	Family<Gauge>* SendPressure;
+	Gauge* SendPressure_Gauge;
+
+	Family<Gauge>* ChanneldTickPhase;
+	Gauge* ChanneldTickPhase_Gauge;
+
+	Family<Gauge>* FrameArenaHighWater;
+	Gauge* FrameArenaHighWater_Gauge;
+
+	Family<Counter>* MessagePackPoolHit;
+	Counter* MessagePackPoolHit_Counter;
+
+	Family<Counter>* MessagePackPoolMiss;
+	Counter* MessagePackPoolMiss_Counter;
 	
 	Family<Counter>* ReplicatedProviders;
 	Counter* ReplicatedProviders_Counter;
@@ -63,6 +176,102 @@ public:
 
 	Family<Counter>* RedirectedRPCs;
 	Counter* RedirectedRPCs_Counter;
+
+	Family<Counter>* NativeRPCFallbacks;
+	Counter* NativeRPCFallbacks_Counter;
+
+	Family<Counter>* NativeRPCFallbackBytes;
+	Counter* NativeRPCFallbackBytes_Counter;
+
+	Family<Gauge>* DeferredRPCs;
+	Gauge* DeferredRPCs_Gauge;
+
+	Family<Gauge>* ObjRefCacheSize;
+	Gauge* ObjRefCacheSize_Gauge;
+
+	Family<Gauge>* ObjRefCacheBytes;
+	Gauge* ObjRefCacheBytes_Gauge;
+
+	Family<Gauge>* OwningChannelMappings;
+	Gauge* OwningChannelMappings_Gauge;
+
+	Family<Counter>* ServerInterestBytes;
+	Counter* ServerInterestBytes_Counter;
 	
 	Family<Counter>* Handovers;
+
+	Family<Histogram>* SendLatency;
+	Family<Histogram>* DispatchLatency;
+	Family<Histogram>* HandleTime;
+
+	// The size of the packets on the wire, after compression. Accumulated by the connection and merged in Tick().
+	Family<Histogram>* PacketSize;
+	Histogram* SentPacketSize_Histogram;
+	Histogram* ReceivedPacketSize_Histogram;
+
+	// The size of the encoded channel data in each ChannelDataUpdateMessage.
+	Family<Histogram>* ChannelUpdateSize;
+	Histogram* SentChannelUpdateSize_Histogram;
+	Histogram* ReceivedChannelUpdateSize_Histogram;
+
+	Family<Histogram>* HandoverDuration;
+	Histogram* HandoverDuration_Histogram;
+
+	Family<Gauge>* InterestSpatialChannels;
+	Family<Gauge>* InterestEntityChannels;
+	Family<Counter>* InterestChurn;
+	Family<Histogram>* InterestSpawnsPerChange;
+
+	// Labeled by direction, msgType and channelType. See FChanneldTrafficStats.
+	Family<Counter>* TrafficBytes;
+	Family<Counter>* TrafficMessages;
+
+	// Labeled by channelType, and by stage (collect, merge or consume) or direction.
+	Family<Counter>* ChannelReplicationTime;
+	Family<Counter>* ChannelReplicationBytes;
+	// Labeled by the class of the target objects of the providers.
+	Family<Counter>* ProviderCollectTime;
+
+	// Labeled by EChanneldNetFrameStage, and "total".
+	Family<Gauge>* NetFrameTime;
+	Family<Histogram>* NetFrameTimeHistogram;
+	Family<Counter>* NetFramesOverBudget;
+	Counter* NetFramesOverBudget_Counter;
+
+	// The metrics of the load reports of the spatial server, for the autoscaler of the spatial server deployment.
+	Family<Gauge>* SpatialChannels;
+	Gauge* SpatialChannels_Gauge;
+	Family<Gauge>* SpatialEntities;
+	Gauge* SpatialEntities_Gauge;
+	Family<Gauge>* SpatialLoad;
+	Gauge* SpatialLoad_Gauge;
+
+	// Labeled by the message type and the field. Only the sampled channel data updates are counted. See FChanneldWireSizeSampler.
+	Family<Counter>* WireBytes;
+
+private:
+	Labels NameLabel;
+
+	double StartTime = 0;
+	// By "ClassPath::FuncName"
+	TMap<FString, FChanneldNativeRPCFallback> NativeRPCFallbackFunctions;
+
+	bool bTrackFrameOffenders = false;
+	double NetFrameBudgetSeconds = 0;
+	// The frames over the budget since the last warning. The warnings are logged at most once per second.
+	int32 NumFramesOverBudget = 0;
+	double LastOverBudgetWarningTime = 0;
+	static constexpr int32 NumNetFrameStats = static_cast<int32>(EChanneldNetFrameStage::Max) + 1;
+	Gauge* NetFrameTime_Gauges[NumNetFrameStats] = {};
+	Histogram* NetFrameTime_Histograms[NumNetFrameStats] = {};
+
+	// Drain UChanneldConnection::TrafficStats into the packet metrics, TrafficBytes and TrafficMessages.
+	void FlushTrafficStats();
+	void FlushTrafficStats(FChanneldTrafficStats& Stats);
+	// Drain the bytes of the fields sampled by WireSizeSampler into WireBytes.
+	void FlushWireSizes();
+	TArray<TWeakObjectPtr<UChanneldConnection>> ExtraTrafficSources;
+	// Created on the first traffic of the slot, so the unused msgTypes don't add to the exposition.
+	TPair<Counter*, Counter*> TrafficCounters[FChanneldTrafficStats::NumDirections][FChanneldTrafficStats::MaxMsgTypes + 1][FChanneldTrafficStats::NumChannelCategories] = {};
+	TMap<FChanneldWireSizeSampler::FFieldKey, Counter*> WireBytesCounters;
 };
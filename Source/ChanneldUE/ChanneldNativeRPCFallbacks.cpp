@@ -0,0 +1,60 @@
+#include "ChanneldNativeRPCFallbacks.h"
+#include "ChanneldTypes.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+FString FChanneldNativeRPCFallbackReport::GetReportDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Channeld/NativeRPCFallbacks");
+}
+
+TArray<FChanneldNativeRPCFallbackReport> FChanneldNativeRPCFallbackReport::LoadAll()
+{
+	TArray<FChanneldNativeRPCFallbackReport> Reports;
+	TArray<FString> FileNames;
+	IFileManager::Get().FindFiles(FileNames, *GetReportDir(), TEXT(".json"));
+	for (const FString& FileName : FileNames)
+	{
+		const FString FilePath = GetReportDir() / FileName;
+		FString Json;
+		FChanneldNativeRPCFallbackReport Report;
+		if (!FFileHelper::LoadFileToString(Json, *FilePath) || !FJsonObjectConverter::JsonObjectStringToUStruct(Json, &Report, 0, 0))
+		{
+			UE_LOG(LogChanneld, Warning, TEXT("Invalid native RPC fallback report: %s"), *FilePath);
+			continue;
+		}
+		Reports.Add(MoveTemp(Report));
+	}
+	return Reports;
+}
+
+bool FChanneldNativeRPCFallbackReport::Save(const FString& FilePath) const
+{
+	FString Json;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(*this, Json) || !FFileHelper::SaveStringToFile(Json, *FilePath))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to save the native RPC fallback report: %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogChanneld, Log, TEXT("Saved %d functions of the native RPC fallbacks to %s"), Functions.Num(), *FilePath);
+	return true;
+}
+
+void FChanneldNativeRPCFallbackReport::Log() const
+{
+	if (Functions.Num() == 0)
+	{
+		UE_LOG(LogChanneld, Log, TEXT("No RPC fell back to the native path in %.0fs"), Duration);
+		return;
+	}
+
+	UE_LOG(LogChanneld, Warning, TEXT("%d functions fell back to the native RPC path in %.0fs:"), Functions.Num(), Duration);
+	const double Seconds = FMath::Max(Duration, 1.0);
+	for (const FChanneldNativeRPCFallback& Function : Functions)
+	{
+		UE_LOG(LogChanneld, Warning, TEXT("  %s::%s (%s): %lld calls (%.2f/s), %lld bytes (%.1f B/s)"),
+			*Function.ClassPath, *Function.FuncName, *Function.Reason, Function.Calls, Function.Calls / Seconds, Function.Bytes, Function.Bytes / Seconds);
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChanneldNativeRPCFallbacks.generated.h"
+
+// A function whose RPCs fell back to the native UE path (bunches in the LOW_LEVEL messages) instead of the replicators.
+USTRUCT()
+struct CHANNELDUE_API FChanneldNativeRPCFallback
+{
+	GENERATED_BODY()
+
+	// The path name of the class that declares the function, which needs a generated replicator to serialize it.
+	UPROPERTY()
+	FString ClassPath;
+
+	UPROPERTY()
+	FString FuncName;
+
+	// The ERPCDropReason of the last fallback, e.g. SerializeFailed or NoRepComp.
+	UPROPERTY()
+	FString Reason;
+
+	UPROPERTY()
+	int64 Calls = 0;
+
+	// The bunch bytes written by the native path, summed over the connections.
+	UPROPERTY()
+	int64 Bytes = 0;
+};
+
+/**
+ * The functions that fell back to the native RPC path since the start of the process, sorted by the bytes. Saved under
+ * Saved/Channeld/NativeRPCFallbacks when the process exits or by the console command channeld.NativeRPCFallbacks. The replicator
+ * generator reads the reports and generates the replicators of the classes of the functions that failed to serialize.
+ */
+USTRUCT()
+struct CHANNELDUE_API FChanneldNativeRPCFallbackReport
+{
+	GENERATED_BODY()
+
+	// The seconds the fallbacks were recorded in, for the call rates.
+	UPROPERTY()
+	double Duration = 0;
+
+	UPROPERTY()
+	TArray<FChanneldNativeRPCFallback> Functions;
+
+	static FString GetReportDir();
+	// Loads all the reports in GetReportDir().
+	static TArray<FChanneldNativeRPCFallbackReport> LoadAll();
+
+	bool Save(const FString& FilePath) const;
+	void Log() const;
+};
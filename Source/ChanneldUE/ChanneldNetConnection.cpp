@@ -6,16 +6,23 @@
 #include "PacketHandlers/StatelessConnectHandlerComponent.h"
 #include "GameFramework/GameModeBase.h"
 #include "GameFramework/GameStateBase.h"
+#include "GameFramework/CharacterMovementReplication.h"
 #include "unreal_common.pb.h"
 #include "ChanneldUtils.h"
 #include "ChanneldSettings.h"
 #include <numeric>
 #include "Interest/ClientInterestManager.h"
+#include "Replication/ChanneldReplication.h"
+#include "ChanneldMetrics.h"
+#include "ChanneldPackageMapClient.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/wire_format_lite.h"
 
 UChanneldNetConnection::UChanneldNetConnection(const FObjectInitializer& ObjectInitializer)
 	:Super(ObjectInitializer)
 {
 	//MaxPacket = MaxPacketSize;
+	PackageMapClass = UChanneldPackageMapClient::StaticClass();
 	if (GetMutableDefault<UChanneldSettings>()->bSetInternalAck)
 	{
 		SetInternalAck(true);
@@ -38,6 +45,7 @@ void UChanneldNetConnection::InitBase(UNetDriver* InDriver, class FSocket* InSoc
 		// Reset the PacketHandler to remove the StatelessConnectHandler and bypass the handshake process.
 		Handler.Reset(NULL);
 	}
+	bSlimLowLevelPackets = GetMutableDefault<UChanneldSettings>()->bSlimLowLevelPackets && bDisableHandshaking && IsInternalAck();
 
 	ClientInterestManager = NewObject<UClientInterestManager>(this, UClientInterestManager::StaticClass());
 }
@@ -62,6 +70,7 @@ void UChanneldNetConnection::InitRemoteConnection(UNetDriver* InDriver, class FS
 	InRemoteAddr.GetPort(Port);
 	RemoteAddr->SetIp(Ip);
 	RemoteAddr->SetPort(Port);
+	RemoteConnId = Ip;
 
 	MaxPacket = Channeld::MaxPacketSize;
 	PacketOverhead = 10;
@@ -88,7 +97,7 @@ void UChanneldNetConnection::LowLevelSend(void* Data, int32 CountBits, FOutPacke
 	else
 	{
 		const uint8* DataToSend = reinterpret_cast<uint8*>(Data);
-		if (!bDisableHandshaking && Handler.IsValid() && !Handler->GetRawSend())
+		if (!bSlimLowLevelPackets && !bDisableHandshaking && Handler.IsValid() && !Handler->GetRawSend())
 		{
 			const ProcessedPacket ProcessedData = Handler->Outgoing(reinterpret_cast<uint8*>(Data), CountBits, Traits);
 
@@ -134,7 +143,7 @@ void UChanneldNetConnection::SendData(uint32 MsgType, const uint8* DataToSend, i
 		return;
 	}
 	
-	auto ConnToChanneld = GEngine->GetEngineSubsystem<UChanneldConnection>();
+	auto ConnToChanneld = CastChecked<UChanneldNetDriver>(Driver)->GetConnToChanneld();
 	
 	if (ChId == Channeld::InvalidChannelId)
 	{
@@ -147,10 +156,7 @@ void UChanneldNetConnection::SendData(uint32 MsgType, const uint8* DataToSend, i
 	
 	if (ConnToChanneld->IsServer())
 	{
-		channeldpb::ServerForwardMessage ServerForwardMessage;
-		ServerForwardMessage.set_clientconnid(GetConnId());
-		ServerForwardMessage.set_payload(DataToSend, DataSize);
-		ConnToChanneld->Send(ChId, MsgType, ServerForwardMessage, channeldpb::SINGLE_CONNECTION);
+		ConnToChanneld->ForwardRaw(ChId, MsgType, DataToSend, DataSize, GetConnId());
 	}
 	else
 	{
@@ -158,10 +164,58 @@ void UChanneldNetConnection::SendData(uint32 MsgType, const uint8* DataToSend, i
 	}
 }
 
-void UChanneldNetConnection::SendMessage(uint32 MsgType, const google::protobuf::Message& Msg, Channeld::ChannelId ChId)
+void UChanneldNetConnection::SendMessage(uint32 MsgType, const google::protobuf::Message& Msg, Channeld::ChannelId ChId, int32 PayloadFieldNumber, const google::protobuf::Message* Payload)
 {
-	const std::string StrData = Msg.SerializeAsString();
-	SendData(MsgType, reinterpret_cast<const uint8*>(StrData.data()), StrData.size(), ChId);
+	if (!Driver)
+	{
+		UE_LOG(LogChanneld, Warning, TEXT("SendMessage failed as the NetConn %d has no NetDriver"), GetConnId());
+		return;
+	}
+	
+	auto ConnToChanneld = CastChecked<UChanneldNetDriver>(Driver)->GetConnToChanneld();
+	
+	if (ChId == Channeld::InvalidChannelId)
+	{
+		ChId = GetSendToChannelId();
+		if (ChId == Channeld::InvalidChannelId)
+		{
+			UE_LOG(LogChanneld, Warning, TEXT("UChanneldNetConnection::SendMessage failed as the NetConn %d has no channelId"), GetConnId());
+		}
+	}
+
+	// Not via SendData(), so the message is serialized only once, into the body of the MessagePack.
+	if (ConnToChanneld->IsServer())
+	{
+		ConnToChanneld->ForwardWithPayload(ChId, MsgType, Msg, PayloadFieldNumber, Payload, GetConnId());
+	}
+	else
+	{
+		ConnToChanneld->SendWithPayload(ChId, MsgType, Msg, PayloadFieldNumber, Payload);
+	}
+}
+
+namespace
+{
+	// The queued RPCs are expired and the queued spawns are rechecked at this interval, instead of every tick.
+	constexpr uint32 QueuedMessageSweepIntervalTicks = 30;
+
+	FORCEINLINE bool TestSpawnBit(const TBitArray<>& Bits, int32 Index)
+	{
+		return Bits.IsValidIndex(Index) && Bits[Index];
+	}
+
+	FORCEINLINE void SetSpawnBit(TBitArray<>& Bits, int32 Index, bool bValue)
+	{
+		if (Index >= Bits.Num())
+		{
+			if (!bValue)
+			{
+				return;
+			}
+			Bits.Add(false, Index + 1 - Bits.Num());
+		}
+		Bits[Index] = bValue;
+	}
 }
 
 bool UChanneldNetConnection::HasSentSpawn(UObject* Object) const
@@ -172,19 +226,30 @@ bool UChanneldNetConnection::HasSentSpawn(UObject* Object) const
 		return false;
 	}
 	
+	const FNetworkGUID NetId = Driver->GuidCache->GetOrAssignNetGUID(Object);
+	return HasSentSpawn(NetId, CastChecked<UChanneldNetDriver>(Driver)->GetSpawnTrackingIndex(NetId));
+}
+
+bool UChanneldNetConnection::HasSentSpawn(const FNetworkGUID NetId, int32 SpawnIndex) const
+{
 	// Already in the queue, don't send again
-	for (auto& Tuple : QueuedSpawnMessageTargets)
+	return TestSpawnBit(QueuedSpawnBits, SpawnIndex) || IsSpawnExported(NetId, SpawnIndex);
+}
+
+bool UChanneldNetConnection::IsSpawnExported(const FNetworkGUID NetId, int32 SpawnIndex) const
+{
+	if (TestSpawnBit(SentSpawnBits, SpawnIndex))
 	{
-		if (Tuple.Get<0>().Get() == Object)
-		{
-			return true;
-		}
+		return true;
 	}
-	
-	const FNetworkGUID NetId = Driver->GuidCache->GetOrAssignNetGUID(Object);
 	UPackageMapClient* PackageMapClient = CastChecked<UPackageMapClient>(PackageMap);
-	int32* ExportCount = PackageMapClient->NetGUIDExportCountMap.Find(NetId);
-	return (ExportCount != nullptr && *ExportCount > 0);
+	const int32* ExportCount = PackageMapClient->NetGUIDExportCountMap.Find(NetId);
+	if (ExportCount != nullptr && *ExportCount > 0)
+	{
+		SetSpawnBit(SentSpawnBits, SpawnIndex, true);
+		return true;
+	}
+	return false;
 }
 
 void UChanneldNetConnection::SendSpawnMessage(UObject* Object, ENetRole Role /*= ENetRole::None*/, uint32 OwningChannelId /*= Channeld::InvalidChannelId*/, uint32 OwningConnId /*= 0*/, FVector* Location /*= nullptr*/)
@@ -194,11 +259,12 @@ void UChanneldNetConnection::SendSpawnMessage(UObject* Object, ENetRole Role /*=
 		UE_LOG(LogChanneld, Warning, TEXT("SendSpawnMessage failed as the NetConn %d has no NetDriver"), GetConnId());
 		return;
 	}
+	FlushDestroyMessages();
 	
 	const FNetworkGUID NetId = Driver->GuidCache->GetOrAssignNetGUID(Object);
-	UPackageMapClient* PackageMapClient = CastChecked<UPackageMapClient>(PackageMap);
-	int32* ExportCount = PackageMapClient->NetGUIDExportCountMap.Find(NetId);
-	if (ExportCount != nullptr && *ExportCount > 0)
+	auto NetDriver = CastChecked<UChanneldNetDriver>(Driver);
+	const int32 SpawnIndex = NetDriver->GetSpawnTrackingIndex(NetId);
+	if (IsSpawnExported(NetId, SpawnIndex))
 	{
 		UE_LOG(LogChanneld, Verbose, TEXT("[Server] Skip sending spawn to conn %d, obj: %s"), GetConnId(), *GetNameSafe(Object));
 		return;
@@ -207,7 +273,6 @@ void UChanneldNetConnection::SendSpawnMessage(UObject* Object, ENetRole Role /*=
 	// Check if the object has the owning ChannelId
 	if (OwningChannelId == Channeld::InvalidChannelId)
 	{
-		auto NetDriver = CastChecked<UChanneldNetDriver>(Driver);
 		if (NetDriver->ChannelDataView.IsValid())
 		{
 			OwningChannelId = NetDriver->ChannelDataView->GetOwningChannelId(NetId);
@@ -215,8 +280,13 @@ void UChanneldNetConnection::SendSpawnMessage(UObject* Object, ENetRole Role /*=
 	}
 	if (OwningChannelId == Channeld::InvalidChannelId)
 	{
-		QueuedSpawnMessageTargets.Add(MakeTuple(Object, Role, OwningChannelId, OwningConnId, Location));
-		UE_LOG(LogChanneld, Warning, TEXT("[Server] Unable to send Spawn message as there's no mapping of NetId %d -> ChannelId. Pushed to the next tick."), NetId.Value);
+		QueuedSpawnMessages.Add(NetId, MakeTuple(TWeakObjectPtr<UObject>(Object), Role, OwningChannelId, OwningConnId, Location));
+		SetSpawnBit(QueuedSpawnBits, SpawnIndex, true);
+		if (NetDriver->ChannelDataView.IsValid())
+		{
+			NetDriver->ChannelDataView->WaitForOwningChannelId(NetId, this);
+		}
+		UE_LOG(LogChanneld, Warning, TEXT("[Server] Unable to send Spawn message as there's no mapping of NetId %d -> ChannelId. Queued until the mapping is set."), NetId.Value);
 		return;
 	}
 
@@ -237,16 +307,19 @@ void UChanneldNetConnection::SendSpawnMessage(UObject* Object, ENetRole Role /*=
 		SpawnMsg.mutable_location()->MergeFrom(ChanneldUtils::GetVectorPB(*Location));
 	}
 	SendMessage(unrealpb::SPAWN, SpawnMsg, OwningChannelId);
+	// The size is cached by the serialization in SendMessage().
+	SentSpawnBytes += SpawnMsg.GetCachedSize();
 	UE_LOG(LogChanneld, Verbose, TEXT("[Server] Send Spawn message to conn: %d, obj: %s, netId: %d, role: %d, owning channel: %d, owningConnId: %d, location: %s"),
 		GetConnId(), *GetNameSafe(Object), SpawnMsg.obj().netguid(), SpawnMsg.localrole(), SpawnMsg.channelid(), SpawnMsg.obj().owningconnid(), Location ? *Location->ToCompactString() : TEXT("NULL"));
 
-	SetSentSpawned(NetId);
+	SetSentSpawned(NetId, SpawnIndex);
 }
 
-void UChanneldNetConnection::SetSentSpawned(const FNetworkGUID NetId)
+void UChanneldNetConnection::SetSentSpawned(const FNetworkGUID NetId, int32 SpawnIndex)
 {
 	if (UPackageMapClient* PackageMapClient = Cast<UPackageMapClient>(PackageMap))
 	{
+		// ChanneldUtils::GetRefOfObject() still relies on the export count to decide whether to export the object.
 		int32* ExportCount = &PackageMapClient->NetGUIDExportCountMap.FindOrAdd(NetId, 0);
 		(*ExportCount)++;
 	}
@@ -254,6 +327,39 @@ void UChanneldNetConnection::SetSentSpawned(const FNetworkGUID NetId)
 	{
 		UE_LOG(LogChanneld, Error, TEXT("Failed to set sent spawned as the NetConn %d has no PackageMapClient"), GetConnId());
 	}
+
+	if (SpawnIndex == INDEX_NONE && Driver)
+	{
+		SpawnIndex = CastChecked<UChanneldNetDriver>(Driver)->GetSpawnTrackingIndex(NetId);
+	}
+	if (SpawnIndex != INDEX_NONE)
+	{
+		SetSpawnBit(SentSpawnBits, SpawnIndex, true);
+	}
+
+	ReleaseUnexportedRPCs(NetId);
+}
+
+void UChanneldNetConnection::ClearSentSpawned(const FNetworkGUID NetId, int32 SpawnIndex)
+{
+	SetSpawnBit(SentSpawnBits, SpawnIndex, false);
+	SetSpawnBit(QueuedSpawnBits, SpawnIndex, false);
+	QueuedSpawnMessages.Remove(NetId);
+	if (ReadySpawnMessages.Num() > 0)
+	{
+		ReadySpawnMessages.RemoveAll([NetId](const TPair<FNetworkGUID, FQueuedSpawnMessage>& Ready) { return Ready.Key == NetId; });
+	}
+	UnexportedRPCs.Remove(NetId);
+}
+
+void UChanneldNetConnection::OnOwningChannelIdSet(const FNetworkGUID NetId)
+{
+	FQueuedSpawnMessage SpawnMessage;
+	if (QueuedSpawnMessages.RemoveAndCopyValue(NetId, SpawnMessage))
+	{
+		// The queued bit stays set until the message is sent, so the object is not spawned twice in the meantime.
+		ReadySpawnMessages.Emplace(NetId, MoveTemp(SpawnMessage));
+	}
 }
 
 void UChanneldNetConnection::SendDestroyMessage(UObject* Object, EChannelCloseReason Reason)
@@ -284,31 +390,46 @@ void UChanneldNetConnection::SendDestroyMessage(UObject* Object, EChannelCloseRe
 		return;
 	}
 
-	unrealpb::DestroyObjectMessage DestroyMsg;
-	DestroyMsg.set_netid(NetId.Value);
-	DestroyMsg.set_reason(static_cast<uint8>(EChannelCloseReason::Destroyed));
-	SendMessage(unrealpb::DESTROY, DestroyMsg);
-	UE_LOG(LogChanneld, Verbose, TEXT("[Server] Send Destroy message to conn: %d, obj: %s, netId: %d"), GetConnId(), *GetNameSafe(Object), NetId.Value);
+	if (GetMutableDefault<UChanneldSettings>()->bBatchDestroyMessages)
+	{
+		PendingDestroyNetIds.Add(NetId.Value);
+		UE_LOG(LogChanneld, Verbose, TEXT("[Server] Batched Destroy message to conn: %d, obj: %s, netId: %d"), GetConnId(), *GetNameSafe(Object), NetId.Value);
+	}
+	else
+	{
+		unrealpb::DestroyObjectMessage DestroyMsg;
+		DestroyMsg.set_netid(NetId.Value);
+		DestroyMsg.set_reason(static_cast<uint8>(EChannelCloseReason::Destroyed));
+		SendMessage(unrealpb::DESTROY, DestroyMsg);
+		UE_LOG(LogChanneld, Verbose, TEXT("[Server] Send Destroy message to conn: %d, obj: %s, netId: %d"), GetConnId(), *GetNameSafe(Object), NetId.Value);
+	}
 
 	if (ExportCount != nullptr)
 	{
 		(*ExportCount)--;
 	}
+	// The object can be spawned to the connection again, e.g. when it comes back into the interest area.
+	if (const int32* SpawnIndex = CastChecked<UChanneldNetDriver>(Driver)->FindSpawnTrackingIndex(NetId))
+	{
+		ClearSentSpawned(NetId, *SpawnIndex);
+	}
 }
 
 void UChanneldNetConnection::SendRPCMessage(AActor* Actor, const FString& FuncName, TSharedPtr<google::protobuf::Message> ParamsMsg, Channeld::ChannelId ChId, const FString& SubObjectPath)
 {
 	if (GetMutableDefault<UChanneldSettings>()->bQueueUnexportedActorRPC)
 	{
-		if (Actor->HasAuthority() && !HasSentSpawn(Actor))
+		const FNetworkGUID NetId = Actor->HasAuthority() ? Driver->GuidCache->GetOrAssignNetGUID(Actor) : FNetworkGUID();
+		// Keep the calling order if the earlier RPCs of the actor are still queued.
+		if (NetId.IsValid() && (UnexportedRPCs.Contains(NetId) || !HasSentSpawn(NetId, CastChecked<UChanneldNetDriver>(Driver)->GetSpawnTrackingIndex(NetId))))
 		{
 			/* On server, the actor should be spawned to client via OnServerSpawnedObject.
 			// If the target object hasn't been spawned in the remote end yet, send the Spawn message before the RPC message.
 			NetConn->SendSpawnMessage(Actor, Actor->GetRemoteRole());
 			*/
 
-			UnexportedRPCs.Add(FOutgoingRPC{Actor, FuncName, ParamsMsg, ChId});
-			UE_LOG(LogChanneld, Log, TEXT("Calling RPC %s::%s while the NetConnection(%d) doesn't have the NetId exported yet. Pushed to the next tick."),
+			UnexportedRPCs.FindOrAdd(NetId).Add(FOutgoingRPC{Actor, FuncName, ParamsMsg, ChId, SubObjectPath, NumTicks});
+			UE_LOG(LogChanneld, Log, TEXT("Calling RPC %s::%s while the NetConnection(%d) doesn't have the NetId exported yet. Queued until the actor is exported."),
 				*Actor->GetName(), *FuncName, GetConnId());
 			return;
 		}
@@ -318,17 +439,17 @@ void UChanneldNetConnection::SendRPCMessage(AActor* Actor, const FString& FuncNa
 	// Don't send the whole UnrealObjectRef to the other side - the object spawning process goes its own way!
 	// RpcMsg.mutable_targetobj()->MergeFrom(*ChanneldUtils::GetRefOfObject(Actor));
 	RpcMsg.mutable_targetobj()->set_netguid(Driver->GuidCache->GetNetGUID(Actor).Value);
-	RpcMsg.set_functionname(TCHAR_TO_UTF8(*FuncName), FuncName.Len());
+	ChanneldReplication::SetRPCFunctionName(RpcMsg, FuncName);
 	if (!SubObjectPath.IsEmpty())
 	{
 		RpcMsg.set_subobjectpath(TCHAR_TO_UTF8(*SubObjectPath), SubObjectPath.Len());
 	}
+	// The parameters are encoded straight into the message body as the paramsPayload.
+	SendMessage(unrealpb::RPC, RpcMsg, ChId, unrealpb::RemoteFunctionMessage::kParamsPayloadFieldNumber, ParamsMsg.Get());
 	if (ParamsMsg)
 	{
-		RpcMsg.set_paramspayload(ParamsMsg->SerializeAsString());
-		UE_LOG(LogChanneld, VeryVerbose, TEXT("Serialized RPC parameters to %d bytes"), RpcMsg.paramspayload().size());
+		UE_LOG(LogChanneld, VeryVerbose, TEXT("Serialized RPC parameters to %d bytes"), ParamsMsg->GetCachedSize());
 	}
-	SendMessage(unrealpb::RPC, RpcMsg, ChId);
 
 	if (auto NetDriver = Cast<UChanneldNetDriver>(Driver))
 	{
@@ -336,6 +457,83 @@ void UChanneldNetConnection::SendRPCMessage(AActor* Actor, const FString& FuncNa
 	}
 }
 
+bool UChanneldNetConnection::SendPackedMoveRPC(AActor* Actor, const FString& FuncName, const FCharacterNetworkSerializationPackedBits& PackedBits, bool bServerMove, Channeld::ChannelId ChId)
+{
+	// The queued RPCs hold their own params message.
+	if (GetMutableDefault<UChanneldSettings>()->bQueueUnexportedActorRPC && Actor->HasAuthority() && !HasSentSpawn(Actor))
+	{
+		return false;
+	}
+
+	const int32 BitsNum = PackedBits.DataBits.Num();
+	const char* Data = reinterpret_cast<const char*>(PackedBits.DataBits.GetData());
+	const size_t BytesNum = FMath::DivideAndRoundUp(BitsNum, 8);
+	if (!bServerMove && bDeferMoveResponses)
+	{
+		if (NumDeferredMoveResponses == DeferredMoveResponses.Num())
+		{
+			DeferredMoveResponses.Add(MakeUnique<FDeferredMoveResponse>());
+		}
+		FDeferredMoveResponse& Deferred = *DeferredMoveResponses[NumDeferredMoveResponses++];
+		Deferred.RpcMsg.mutable_targetobj()->set_netguid(Driver->GuidCache->GetNetGUID(Actor).Value);
+		ChanneldReplication::SetRPCFunctionName(Deferred.RpcMsg, FuncName);
+		Deferred.PackedBits.Reset();
+		Deferred.PackedBits.Append(reinterpret_cast<const uint8*>(Data), BytesNum);
+		Deferred.BitsNum = BitsNum;
+		Deferred.ChId = ChId;
+		return true;
+	}
+
+	if (bServerMove)
+	{
+		ServerMovePackedParamsMsg.set_bitsnum(BitsNum);
+		ServerMovePackedParamsMsg.set_packedbits(Data, BytesNum);
+	}
+	else
+	{
+		ClientMoveResponsePackedParamsMsg.set_bitsnum(BitsNum);
+		ClientMoveResponsePackedParamsMsg.set_packedbits(Data, BytesNum);
+	}
+
+	PackedMoveRpcMsg.mutable_targetobj()->set_netguid(Driver->GuidCache->GetNetGUID(Actor).Value);
+	ChanneldReplication::SetRPCFunctionName(PackedMoveRpcMsg, FuncName);
+	const google::protobuf::Message* ParamsMsg = bServerMove ? static_cast<const google::protobuf::Message*>(&ServerMovePackedParamsMsg) : &ClientMoveResponsePackedParamsMsg;
+	SendMessage(unrealpb::RPC, PackedMoveRpcMsg, ChId, unrealpb::RemoteFunctionMessage::kParamsPayloadFieldNumber, ParamsMsg);
+
+	if (auto NetDriver = Cast<UChanneldNetDriver>(Driver))
+	{
+		NetDriver->OnSentRPC(PackedMoveRpcMsg);
+	}
+	return true;
+}
+
+void UChanneldNetConnection::SerializeDeferredMoveResponses()
+{
+	for (int32 i = 0; i < NumDeferredMoveResponses; i++)
+	{
+		FDeferredMoveResponse& Deferred = *DeferredMoveResponses[i];
+		ClientMoveResponsePackedParamsMsg.set_bitsnum(Deferred.BitsNum);
+		ClientMoveResponsePackedParamsMsg.set_packedbits(reinterpret_cast<const char*>(Deferred.PackedBits.GetData()), Deferred.PackedBits.Num());
+		ClientMoveResponsePackedParamsMsg.SerializeToString(Deferred.RpcMsg.mutable_paramspayload());
+		Deferred.RpcMsg.SerializeToString(&Deferred.Payload);
+	}
+}
+
+void UChanneldNetConnection::FlushDeferredMoveResponses()
+{
+	UChanneldNetDriver* NetDriver = Cast<UChanneldNetDriver>(Driver);
+	for (int32 i = 0; i < NumDeferredMoveResponses; i++)
+	{
+		const FDeferredMoveResponse& Deferred = *DeferredMoveResponses[i];
+		SendData(unrealpb::RPC, reinterpret_cast<const uint8*>(Deferred.Payload.data()), Deferred.Payload.size(), Deferred.ChId);
+		if (NetDriver)
+		{
+			NetDriver->OnSentRPC(Deferred.RpcMsg);
+		}
+	}
+	NumDeferredMoveResponses = 0;
+}
+
 FString UChanneldNetConnection::LowLevelGetRemoteAddress(bool bAppendPort /*= false*/)
 {
 	if (!Driver)
@@ -379,35 +577,181 @@ void UChanneldNetConnection::CleanUp()
 	{
 		ClientInterestManager->CleanUp();
 	}
+
+	// The channel is closed along with the other channels.
+	UnbindExportChannel();
+	ExportChannel = nullptr;
 	
 	Super::CleanUp();
 }
 
+UActorChannel* UChanneldNetConnection::BindExportChannel(AActor* Actor)
+{
+	if (!IsValid(ExportChannel) || ExportChannel->Closing)
+	{
+		ExportChannel = Cast<UActorChannel>(CreateChannelByName(NAME_Actor, EChannelCreateFlags::None));
+	}
+	ExportChannel->SetChannelActor(Actor, ESetChannelActorFlags::None);
+	return ExportChannel;
+}
+
+void UChanneldNetConnection::UnbindExportChannel()
+{
+	if (IsValid(ExportChannel) && ExportChannel->Actor)
+	{
+		RemoveActorChannel(ExportChannel->Actor);
+		// Clears the actor and its replicators of the channel.
+		ExportChannel->ReleaseReferences(false);
+	}
+}
+
+void UChanneldNetConnection::FlushDestroyMessages()
+{
+	if (PendingDestroyNetIds.Num() == 0)
+	{
+		return;
+	}
+
+	unrealpb::DestroyObjectMessage DestroyMsg;
+	DestroyMsg.set_reason(static_cast<uint8>(EChannelCloseReason::Destroyed));
+	if (PendingDestroyNetIds.Num() == 1)
+	{
+		DestroyMsg.set_netid(PendingDestroyNetIds[0]);
+		SendMessage(unrealpb::DESTROY, DestroyMsg);
+	}
+	else
+	{
+		std::string Payload;
+		{
+			google::protobuf::io::StringOutputStream Stream(&Payload);
+			google::protobuf::io::CodedOutputStream Output(&Stream);
+			for (const uint32 NetId : PendingDestroyNetIds)
+			{
+				DestroyMsg.set_netid(NetId);
+				Output.WriteTag((1 << 3) | google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+				Output.WriteVarint32(DestroyMsg.ByteSizeLong());
+				DestroyMsg.SerializeWithCachedSizes(&Output);
+			}
+		}
+		SendData(Channeld::DestroyObjectsMsgType, reinterpret_cast<const uint8*>(Payload.data()), Payload.size());
+	}
+	UE_LOG(LogChanneld, Verbose, TEXT("[Server] Send Destroy message of %d objects to conn: %d"), PendingDestroyNetIds.Num(), GetConnId());
+	PendingDestroyNetIds.Reset();
+}
+
 void UChanneldNetConnection::Tick(float DeltaSeconds)
 {
 	UNetConnection::Tick(DeltaSeconds);
-	
-	const int RpcNum = UnexportedRPCs.Num();
-	for (int i = 0; i < RpcNum; i++)
+	NumTicks++;
+
+	FlushDestroyMessages();
+
+	if (ReadySpawnMessages.Num() > 0)
+	{
+		auto NetDriver = CastChecked<UChanneldNetDriver>(Driver);
+		// Indexed loop, as sending the spawn may release more messages.
+		for (int32 i = 0; i < ReadySpawnMessages.Num(); i++)
+		{
+			const TPair<FNetworkGUID, FQueuedSpawnMessage> Ready = ReadySpawnMessages[i];
+			if (const int32* SpawnIndex = NetDriver->FindSpawnTrackingIndex(Ready.Key))
+			{
+				SetSpawnBit(QueuedSpawnBits, *SpawnIndex, false);
+			}
+			const FQueuedSpawnMessage& Params = Ready.Value;
+			if (Params.Get<0>().IsValid())
+			{
+				SendSpawnMessage(Params.Get<0>().Get(), Params.Get<1>(), Params.Get<2>(), Params.Get<3>(), Params.Get<4>());
+			}
+		}
+		ReadySpawnMessages.Reset();
+	}
+
+	if ((UnexportedRPCs.Num() > 0 || QueuedSpawnMessages.Num() > 0) && NumTicks % QueuedMessageSweepIntervalTicks == 0)
+	{
+		SweepQueuedMessages();
+	}
+}
+
+void UChanneldNetConnection::ReleaseUnexportedRPCs(const FNetworkGUID NetId)
+{
+	TArray<FOutgoingRPC> RPCs;
+	if (UnexportedRPCs.Num() == 0 || !UnexportedRPCs.RemoveAndCopyValue(NetId, RPCs))
+	{
+		return;
+	}
+	for (FOutgoingRPC& RPC : RPCs)
 	{
-		FOutgoingRPC& RPC = UnexportedRPCs[i];
 		if (IsValid(RPC.Actor))
 		{
-			SendRPCMessage(RPC.Actor, RPC.FuncName, RPC.ParamsMsg, RPC.ChId);
+			SendRPCMessage(RPC.Actor, RPC.FuncName, RPC.ParamsMsg, RPC.ChId, RPC.SubObjectPath);
+		}
+	}
+}
+
+void UChanneldNetConnection::SweepQueuedMessages()
+{
+	auto NetDriver = CastChecked<UChanneldNetDriver>(Driver);
+	const uint32 MaxRetries = FMath::Max(GetMutableDefault<UChanneldSettings>()->MaxDeferredRPCRetries, 0);
+	TArray<FNetworkGUID> ReleasedNetIds;
+	for (auto It = UnexportedRPCs.CreateIterator(); It; ++It)
+	{
+		TArray<FOutgoingRPC>& RPCs = It.Value();
+		AActor* Actor = RPCs.Num() > 0 ? RPCs[0].Actor : nullptr;
+		if (!IsValid(Actor))
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+		// The authority may have been handed over, or the actor may have been exported as an RPC parameter.
+		if (!Actor->HasAuthority() || IsSpawnExported(It.Key(), NetDriver->GetSpawnTrackingIndex(It.Key())))
+		{
+			ReleasedNetIds.Add(It.Key());
+			continue;
+		}
+		if (MaxRetries == 0)
+		{
+			continue;
+		}
+		int32 NumExpired = 0;
+		while (NumExpired < RPCs.Num() && NumTicks - RPCs[NumExpired].QueuedTick >= MaxRetries)
+		{
+			const FOutgoingRPC& RPC = RPCs[NumExpired++];
+			UE_LOG(LogChanneld, Warning, TEXT("Dropped RPC %s::%s after %u ticks as the NetConnection(%d) still doesn't have the NetId exported"),
+				*Actor->GetName(), *RPC.FuncName, NumTicks - RPC.QueuedTick, GetConnId());
+			GEngine->GetEngineSubsystem<UChanneldMetrics>()->OnDroppedRPC(std::string(TCHAR_TO_UTF8(*RPC.FuncName)), RPCDropReason_UnexportedMaxRetried);
+		}
+		if (NumExpired == RPCs.Num())
+		{
+			It.RemoveCurrent();
+		}
+		else if (NumExpired > 0)
+		{
+			RPCs.RemoveAt(0, NumExpired);
 		}
 	}
-	UnexportedRPCs.RemoveAt(0, RpcNum);
+	// Sent outside the iteration, as sending may modify UnexportedRPCs.
+	for (const FNetworkGUID& NetId : ReleasedNetIds)
+	{
+		ReleaseUnexportedRPCs(NetId);
+	}
 
-	const int SpawnMsgNum = QueuedSpawnMessageTargets.Num();
-	for (int i = 0; i < SpawnMsgNum; i++)
+	for (auto It = QueuedSpawnMessages.CreateIterator(); It; ++It)
 	{
-		auto& Params = QueuedSpawnMessageTargets[i];
-		if (Params.Get<0>().IsValid())
+		if (!It.Value().Get<0>().IsValid())
 		{
-			SendSpawnMessage(Params.Get<0>().Get(), Params.Get<1>(), Params.Get<2>(), Params.Get<3>(), Params.Get<4>());
+			if (const int32* SpawnIndex = NetDriver->FindSpawnTrackingIndex(It.Key()))
+			{
+				SetSpawnBit(QueuedSpawnBits, *SpawnIndex, false);
+			}
+			It.RemoveCurrent();
+		}
+		// In case the view was not available to notify when the message was queued.
+		else if (NetDriver->ChannelDataView.IsValid() && NetDriver->ChannelDataView->GetOwningChannelId(It.Key()) != Channeld::InvalidChannelId)
+		{
+			ReadySpawnMessages.Emplace(It.Key(), It.Value());
+			It.RemoveCurrent();
 		}
 	}
-	QueuedSpawnMessageTargets.RemoveAt(0, SpawnMsgNum);
 
 }
 
@@ -432,6 +776,12 @@ void UChanneldNetConnection::ReceivedRawPacket(void* Data, int32 Count)
 	}
 
 	uint8* DataRef = reinterpret_cast<uint8*>(Data);
+	if (bSlimLowLevelPackets)
+	{
+		ReceivedSlimPacket(DataRef, Count);
+		return;
+	}
+
 	if (bInConnectionlessHandshake)
 	{
 		// Process all incoming packets.
@@ -487,3 +837,39 @@ void UChanneldNetConnection::ReceivedRawPacket(void* Data, int32 Count)
 
 	UNetConnection::ReceivedRawPacket(DataRef, Count);
 }
+
+void UChanneldNetConnection::ReceivedSlimPacket(uint8* Data, int32 Count)
+{
+	// The same accounting as UNetConnection::ReceivedRawPacket()
+	const int32 PacketBytes = Count + PacketOverhead;
+	InBytes += PacketBytes;
+	++InPackets;
+	Driver->InBytes += PacketBytes;
+	++Driver->InPackets;
+
+	// The bit stream ends with a terminator bit at the most significant set bit of the last byte.
+	uint8 LastByte = Data[Count - 1];
+	if (LastByte == 0)
+	{
+		UE_LOG(LogChanneld, Warning, TEXT("NetConnection %d received a malformed packet without the terminator bit, size: %dB"), GetConnId(), Count);
+		return;
+	}
+	int32 BitSize = Count * 8 - 1;
+	while (!(LastByte & 0x80))
+	{
+		LastByte <<= 1;
+		BitSize--;
+	}
+
+	FBitReader Reader(Data, BitSize);
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+	SetNetVersionsOnArchive(Reader);
+#else
+	Reader.SetEngineNetVer(EngineNetworkProtocolVersion);
+	Reader.SetGameNetVer(GameNetworkProtocolVersion);
+#endif
+	if (Reader.GetBitsLeft() > 0)
+	{
+		ReceivedPacket(Reader);
+	}
+}
@@ -27,10 +27,16 @@ public:
 	virtual void CleanUp() override;
 	virtual void Tick(float DeltaSeconds) override;
 	virtual void ReceivedRawPacket(void* Data, int32 Count) override;
+	// The slim path of ReceivedRawPacket(): strips the terminator bit and passes the bunches to ReceivedPacket().
+	void ReceivedSlimPacket(uint8* Data, int32 Count);
 
 	// Get the ConnectionID associated with channeld, which is different from the native UNetConnection::GetConnectionId().
 	FORCEINLINE Channeld::ConnectionId GetConnId() const
 	{
+		if (RemoteConnId != 0)
+		{
+			return RemoteConnId;
+		}
 		if (RemoteAddr.IsValid())
 		{
 			uint32 ConnId;
@@ -46,9 +52,17 @@ public:
 	// Send data between UE client and sever via channeld. MsgType should be in user space (>= 100).
 	void SendData(uint32 MsgType, const uint8* DataToSend, int32 DataSize, Channeld::ChannelId ChId = Channeld::InvalidChannelId);
 	// Send message between UE client and sever via channeld. MsgType should be in user space (>= 100).
-	void SendMessage(uint32 MsgType, const google::protobuf::Message& Msg, Channeld::ChannelId ChId = Channeld::InvalidChannelId);
+	// Msg is encoded straight into the message body. See UChanneldConnection::SendWithPayload() for PayloadFieldNumber and Payload.
+	void SendMessage(uint32 MsgType, const google::protobuf::Message& Msg, Channeld::ChannelId ChId = Channeld::InvalidChannelId, int32 PayloadFieldNumber = 0, const google::protobuf::Message* Payload = nullptr);
 	bool HasSentSpawn(UObject* Object) const;
-	void SetSentSpawned(const FNetworkGUID NetId);
+	// The same as above, with the index from UChanneldNetDriver::GetSpawnTrackingIndex(), so checking a number of connections looks it up only once.
+	bool HasSentSpawn(const FNetworkGUID NetId, int32 SpawnIndex) const;
+	// SpawnIndex is looked up if not specified.
+	void SetSentSpawned(const FNetworkGUID NetId, int32 SpawnIndex = INDEX_NONE);
+	// Also drops the spawn message and the RPCs queued for the object.
+	void ClearSentSpawned(const FNetworkGUID NetId, int32 SpawnIndex);
+	// Called by the view when the NetId-ChannelId mapping is set, which releases the spawn message queued for it.
+	void OnOwningChannelIdSet(const FNetworkGUID NetId);
 	/**
 	 * @brief Send SpawnObjectMessage to the connection.
 	 * @param Object The object has been spawned on the server.
@@ -58,12 +72,39 @@ public:
 	 * @param Location The actor's location on the server. Only used when the actor is in spatial channel. channeld uses the location to amend the OwningChannelId. If not set or in spatial channel, the amendment will not happen.
 	 */
 	void SendSpawnMessage(UObject* Object, ENetRole Role = ENetRole::ROLE_None, uint32 OwningChannelId = Channeld::InvalidChannelId, uint32 OwningConnId = 0, FVector* Location = nullptr);
+	// The total bytes of the spawn messages sent to the connection.
+	FORCEINLINE uint64 GetSentSpawnBytes() const { return SentSpawnBytes; }
 	void SendDestroyMessage(UObject* Object, EChannelCloseReason Reason = EChannelCloseReason::Destroyed);
+	// Send the destroy messages batched by SendDestroyMessage() in this frame. Called in Tick(), and before sending a spawn so it can't be overtaken by an earlier destroy.
+	void FlushDestroyMessages();
 	void SendRPCMessage(AActor* Actor, const FString& FuncName, TSharedPtr<google::protobuf::Message> ParamsMsg = nullptr, Channeld::ChannelId ChId = Channeld::InvalidChannelId, const FString& SubObjectPath = "");
+	/**
+	 * @brief Send ServerMovePacked or ClientMoveResponsePacked without making the params message of the character replicator.
+	 * The payload is the same as FChanneldCharacterReplicator::SerializeFunctionParams() makes, so the receiving end doesn't change.
+	 * @return False if the RPC should go the normal way, e.g. when it needs to be queued.
+	 */
+	bool SendPackedMoveRPC(AActor* Actor, const FString& FuncName, const struct FCharacterNetworkSerializationPackedBits& PackedBits, bool bServerMove, Channeld::ChannelId ChId);
+	/**
+	 * While deferring, SendPackedMoveRPC() only records the ClientMoveResponsePacked RPCs. They are serialized by
+	 * SerializeDeferredMoveResponses(), which can run on a worker thread as it only touches the messages of this connection,
+	 * and sent by FlushDeferredMoveResponses() on the game thread. See UChanneldNetDriver::ServerReplicateActors().
+	 */
+	void SetDeferMoveResponses(bool bDefer) { bDeferMoveResponses = bDefer; }
+	bool HasDeferredMoveResponses() const { return NumDeferredMoveResponses > 0; }
+	void SerializeDeferredMoveResponses();
+	void FlushDeferredMoveResponses();
 	// Flush the handshake packets that are queued before received AuthResultMessage to the server.
 	void FlushUnauthData();
+	// Bind the pooled actor channel to the actor, to serialize the actor for the spawn without opening a channel per actor. See ChanneldUtils::GetRefOfObject().
+	UActorChannel* BindExportChannel(AActor* Actor);
+	// Release the actor of the pooled actor channel, keeping the channel open for the next BindExportChannel().
+	void UnbindExportChannel();
 
 	bool bDisableHandshaking = false;
+	// The ConnectionId of the client, decoded from the fake remote address once in InitRemoteConnection(). Only set in the server.
+	Channeld::ConnectionId RemoteConnId = 0;
+	// Set in InitBase(). See UChanneldSettings::bSlimLowLevelPackets.
+	bool bSlimLowLevelPackets = false;
 	bool bInConnectionlessHandshake = false;
 	bool bChanneldAuthenticated = false;
 
@@ -72,16 +113,42 @@ public:
 	
 	FPlayerEnterSpatialChannelEvent PlayerEnterSpatialChannelEvent;
 
+	// The existing actors to spawn to the new player, nearest first, streamed by UChannelDataView. See UChanneldSettings::bStreamLateJoinSpawns.
+	TArray<TWeakObjectPtr<AActor>> LateJoinSpawnQueue;
+	// The index of the next actor in LateJoinSpawnQueue to spawn.
+	int32 LateJoinSpawnIndex = 0;
+	// From 0 to 1. 1 if the connection doesn't have any existing actor to spawn.
+	FORCEINLINE float GetLateJoinProgress() const { return LateJoinSpawnQueue.Num() > 0 ? static_cast<float>(LateJoinSpawnIndex) / LateJoinSpawnQueue.Num() : 1.0f; }
+
 private:
 
 	//uint32 ConnId = 0;
+
+	uint64 SentSpawnBytes = 0;
+
+	// See BindExportChannel().
+	UPROPERTY()
+	UActorChannel* ExportChannel = nullptr;
 	
 	// Queue the data from LowLevelSend() when the connection and authentication to channeld is not finished yet,
 	// and send them after the authentication is done.
 	TQueue<TTuple<std::string*, FOutPacketTraits*>> LowLevelSendDataBeforeAuth;
 
-	// Queued Spawn messages that don't have the object's NetId-ChannelId mapping set yet.
-	TArray<TTuple<TWeakObjectPtr<UObject>, ENetRole, uint32, uint32, FVector*>> QueuedSpawnMessageTargets;
+	typedef TTuple<TWeakObjectPtr<UObject>, ENetRole, uint32, uint32, FVector*> FQueuedSpawnMessage;
+	// Queued Spawn messages that don't have the object's NetId-ChannelId mapping set yet, by the NetId they wait on.
+	// Moved to ReadySpawnMessages by OnOwningChannelIdSet(), instead of being retried every tick.
+	TMap<FNetworkGUID, FQueuedSpawnMessage> QueuedSpawnMessages;
+	// Sent in the next Tick(), with the queued bits cleared.
+	TArray<TPair<FNetworkGUID, FQueuedSpawnMessage>> ReadySpawnMessages;
+	// The NetIds of the objects to destroy in the client, sent in one message by FlushDestroyMessages(). See UChanneldSettings::bBatchDestroyMessages.
+	TArray<uint32> PendingDestroyNetIds;
+
+	// Indexed by UChanneldNetDriver::GetSpawnTrackingIndex(). Mutable as HasSentSpawn() caches the objects exported by the package map.
+	mutable TBitArray<> SentSpawnBits;
+	// The objects in QueuedSpawnMessages, by the same index.
+	TBitArray<> QueuedSpawnBits;
+	// Whether the spawn of the object has been sent, or the object has been exported by the package map (e.g. as an RPC parameter).
+	bool IsSpawnExported(const FNetworkGUID NetId, int32 SpawnIndex) const;
 
 	struct FOutgoingRPC
 	{
@@ -89,7 +156,37 @@ private:
 		FString FuncName;
 		TSharedPtr<google::protobuf::Message> ParamsMsg;
 		Channeld::ChannelId ChId;
+		FString SubObjectPath;
+		// The value of NumTicks when the RPC is queued.
+		uint32 QueuedTick;
+	};
+	// RPCs queued on the caller's side that don't have the NetId exported yet, by the NetId of the actor, in the calling order.
+	// Sent by SetSentSpawned() right after the spawn. See UChanneldSettings::MaxDeferredRPCRetries.
+	TMap<FNetworkGUID, TArray<FOutgoingRPC>> UnexportedRPCs;
+	// Send the RPCs of the actor in UnexportedRPCs, if any.
+	void ReleaseUnexportedRPCs(const FNetworkGUID NetId);
+	// Runs at a low frequency in Tick(). Drops the expired RPCs and sends the ones of the actors exported by the package map,
+	// which don't trigger SetSentSpawned(). Also drops the spawn messages of the destroyed objects.
+	void SweepQueuedMessages();
+	uint32 NumTicks = 0;
+
+	// Reused by SendPackedMoveRPC(), so the strings keep their capacity between the moves. The params are encoded straight into the body as the paramsPayload.
+	unrealpb::RemoteFunctionMessage PackedMoveRpcMsg;
+	unrealpb::Character_ServerMovePacked_Params ServerMovePackedParamsMsg;
+	unrealpb::Character_ClientMoveResponsePacked_Params ClientMoveResponsePackedParamsMsg;
+
+	struct FDeferredMoveResponse
+	{
+		// The NetGUID and the function name are set on the game thread.
+		unrealpb::RemoteFunctionMessage RpcMsg;
+		TArray<uint8> PackedBits;
+		int32 BitsNum = 0;
+		Channeld::ChannelId ChId = Channeld::InvalidChannelId;
+		// The serialized RpcMsg
+		std::string Payload;
 	};
-	// RPCs queued on the caller's side that don't have the NetId exported yet.
-	TArray<FOutgoingRPC> UnexportedRPCs;
+	bool bDeferMoveResponses = false;
+	// Reused between the frames. Only the first NumDeferredMoveResponses are valid.
+	TArray<TUniquePtr<FDeferredMoveResponse>> DeferredMoveResponses;
+	int32 NumDeferredMoveResponses = 0;
 };
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "Net/RepLayout.h"
 #include "Misc/ScopeExit.h"
 #include "google/protobuf/message_lite.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
 #include "Engine/NetConnection.h"
 #include "PacketHandler.h"
 #include "Net/Core/Misc/PacketAudit.h"
@@ -12,12 +14,26 @@
 #include "ChanneldSettings.h"
 #include "ChanneldMetrics.h"
 #include "GameFramework/PlayerState.h"
+#include "Replication/ChanneldReplication.h"
 #include "Replication/ChanneldReplicationComponent.h"
 #include "GameFramework/GameModeBase.h"
 #include "GameFramework/GameStateBase.h"
 #include "GameFramework/PlayerController.h"
+#include "GameFramework/CharacterMovementReplication.h"
 #include "ChanneldNetConnection.h"
 #include "Engine/World.h"
+#include "Async/ParallelFor.h"
+#include "Interest/ClientInterestManager.h"
+#include "GameFramework/ChanneldCharacter.h"
+#include "EngineUtils.h"
+
+TRACE_DECLARE_INT_COUNTER(ChanneldPendingSpawns, TEXT("Channeld/PendingSpawns"));
+
+namespace
+{
+	// The max number of moves held per character during the handover. The oldest ones are superseded by the newer ones.
+	constexpr int32 MaxHandoverMovesPerActor = 64;
+}
 
 UChanneldNetDriver::UChanneldNetDriver(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -38,6 +54,15 @@ UChanneldNetConnection* UChanneldNetDriver::AddChanneldClientConnection(Channeld
 	AddClientConnection(ClientConnection);
 
 	ClientConnectionMap.Add(ClientConnId, ClientConnection);
+	WakeFromIdle(TEXT("client connection"));
+	if (ClientConnectionsByConnId.Num() == 0)
+	{
+		ClientConnectionsByConnId.SetNumZeroed(1 << Channeld::MaxConnectionIdBits);
+	}
+	if (ClientConnId < static_cast<uint32>(ClientConnectionsByConnId.Num()))
+	{
+		ClientConnectionsByConnId[ClientConnId] = ClientConnection;
+	}
 
 	if (ChannelDataView.IsValid())
 	{
@@ -58,6 +83,10 @@ void UChanneldNetDriver::RemoveChanneldClientConnection(Channeld::ConnectionId C
 	UChanneldNetConnection* ClientConn;
 	if (ClientConnectionMap.RemoveAndCopyValue(ClientConnId, ClientConn))
 	{
+		if (ClientConnId < static_cast<uint32>(ClientConnectionsByConnId.Num()))
+		{
+			ClientConnectionsByConnId[ClientConnId] = nullptr;
+		}
 		if (ChannelDataView.IsValid())
 		{
 			ChannelDataView->OnRemoveClientConnection(ClientConn);
@@ -75,6 +104,7 @@ void UChanneldNetDriver::RemoveChanneldClientConnection(Channeld::ConnectionId C
 
 void UChanneldNetDriver::HandleSpawnObject(TSharedRef<unrealpb::SpawnObjectMessage> SpawnMsg)
 {
+	CHANNELD_TRACE_SCOPE(Channeld_Spawn);
 	FNetworkGUID NetId = FNetworkGUID(SpawnMsg->obj().netguid());
 	
 	// If the object with the same NetId exists, destroy it before spawning a new one.
@@ -95,6 +125,11 @@ void UChanneldNetDriver::HandleSpawnObject(TSharedRef<unrealpb::SpawnObjectMessa
 		return;
 	}
 
+	if (TryAsyncLoadSpawnClass(SpawnMsg))
+	{
+		return;
+	}
+
 	if (ChannelDataView.IsValid() && SpawnMsg->has_channelid())
 	{
 		// Set up the mapping before actually spawn it, so AddProvider() can find the mapping.
@@ -150,10 +185,88 @@ void UChanneldNetDriver::HandleSpawnObject(TSharedRef<unrealpb::SpawnObjectMessa
 		}
 
 		UE_LOG(LogChanneld, Verbose, TEXT("[Client] Spawned object from message: %s, NetId: %d, owning channel: %d, local role: %d"), *NewObj->GetName(), SpawnMsg->obj().netguid(), SpawnMsg->channelid(), LocalRole);
+
+		// The held updates are replayed when the provider is added in BeginPlay, unless it's deferred.
+		const AActor* NewActor = Cast<AActor>(NewObj);
+		if (ChannelDataView.IsValid() && (NewActor == nullptr || NewActor->HasActorBegunPlay()))
+		{
+			ChannelDataView->StopHoldingUpdates(NetId);
+		}
 	}
 	else
 	{
-		UE_LOG(LogChanneld, Warning, TEXT("[Client] Failed to spawn object from msg: %s"), UTF8_TO_TCHAR(SpawnMsg->DebugString().c_str()));
+		if (ChannelDataView.IsValid())
+		{
+			ChannelDataView->StopHoldingUpdates(NetId);
+		}
+		CHANNELD_LOG_RATE_LIMITED(LogChanneld, Warning, 1.0, TEXT("[Client] Failed to spawn object from msg: %s"), UTF8_TO_TCHAR(SpawnMsg->ShortDebugString().c_str()));
+	}
+}
+
+bool UChanneldNetDriver::TryAsyncLoadSpawnClass(TSharedRef<unrealpb::SpawnObjectMessage> SpawnMsg)
+{
+	if (!GetMutableDefault<UChanneldSettings>()->bAsyncLoadSpawnClasses || !ConnToChanneld->IsClient() || !SpawnMsg->obj().has_classpath())
+	{
+		return false;
+	}
+
+	const FSoftClassPath ClassPath(ChanneldUtils::DecodeObjRefPath(SpawnMsg->obj().classpath()));
+	// The native classes are always loaded.
+	if (ClassPath.IsNull() || ClassPath.GetLongPackageName().StartsWith(TEXT("/Script/")) || ClassPath.ResolveClass() != nullptr)
+	{
+		return false;
+	}
+
+	const FName PackageName = ClassPath.GetLongPackageFName();
+	const FNetworkGUID NetId(SpawnMsg->obj().netguid());
+	if (ChannelDataView.IsValid())
+	{
+		ChannelDataView->HoldUpdatesUntilSpawned(NetId);
+	}
+	if (TArray<TSharedRef<unrealpb::SpawnObjectMessage>>* LoadingMsgs = AsyncLoadingSpawnMsgs.Find(PackageName))
+	{
+		LoadingMsgs->Add(SpawnMsg);
+		return true;
+	}
+
+	AsyncLoadingSpawnMsgs.Add(PackageName).Add(SpawnMsg);
+	UE_LOG(LogChanneld, Verbose, TEXT("[Client] Loading the class %s of the spawned object asynchronously, NetId: %d"), *ClassPath.ToString(), NetId.Value);
+	LoadPackageAsync(PackageName.ToString(), FLoadPackageAsyncDelegate::CreateUObject(this, &UChanneldNetDriver::OnSpawnClassPackageLoaded));
+	return true;
+}
+
+void UChanneldNetDriver::OnSpawnClassPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+{
+	TArray<TSharedRef<unrealpb::SpawnObjectMessage>> SpawnMsgs;
+	if (!AsyncLoadingSpawnMsgs.RemoveAndCopyValue(PackageName, SpawnMsgs))
+	{
+		return;
+	}
+
+	if (Result != EAsyncLoadingResult::Succeeded)
+	{
+		UE_LOG(LogChanneld, Warning, TEXT("[Client] Failed to load the package %s of the spawned class, dropped %d spawns"), *PackageName.ToString(), SpawnMsgs.Num());
+		for (const auto& SpawnMsg : SpawnMsgs)
+		{
+			if (ChannelDataView.IsValid())
+			{
+				ChannelDataView->StopHoldingUpdates(FNetworkGUID(SpawnMsg->obj().netguid()));
+			}
+		}
+		return;
+	}
+
+	UE_LOG(LogChanneld, Verbose, TEXT("[Client] Loaded the package %s of the spawned class, spawning %d objects"), *PackageName.ToString(), SpawnMsgs.Num());
+	for (const auto& SpawnMsg : SpawnMsgs)
+	{
+		if (GetMutableDefault<UChanneldSettings>()->ClientSpawnTimeBudgetMs > 0)
+		{
+			PendingSpawnMsgs.Add(SpawnMsg);
+		}
+		else
+		{
+			HandleSpawnObject(SpawnMsg);
+		}
 	}
 }
 
@@ -181,7 +294,7 @@ void UChanneldNetDriver::OnUserSpaceMessageReceived(uint32 MsgType, Channeld::Ch
 		}
 		else
 		{
-			auto ClientConnection = ClientConnectionMap.FindRef(ClientConnId);
+			auto ClientConnection = GetClientConnection(ClientConnId);
 			// Server's ClientConnection is created when the first packet (NMT_Hello) from client arrives.
 			if (ClientConnection == nullptr)
 			{
@@ -199,6 +312,7 @@ void UChanneldNetDriver::OnUserSpaceMessageReceived(uint32 MsgType, Channeld::Ch
 			return;
 		}
 
+		WakeFromIdle(TEXT("incoming RPC"));
 		HandleCustomRPC(RpcMsg);
 		OnReceivedRPC(*RpcMsg);
 	}
@@ -211,48 +325,208 @@ void UChanneldNetDriver::OnUserSpaceMessageReceived(uint32 MsgType, Channeld::Ch
 			return;
 		}
 
-		HandleSpawnObject(SpawnMsg);
+		if (GetMutableDefault<UChanneldSettings>()->ClientSpawnTimeBudgetMs > 0 && ConnToChanneld->IsClient())
+		{
+			PendingSpawnMsgs.Add(SpawnMsg);
+		}
+		else
+		{
+			HandleSpawnObject(SpawnMsg);
+		}
 	}
 	else if (MsgType == unrealpb::DESTROY)
 	{
-		auto DestroyMsg = MakeShared<unrealpb::DestroyObjectMessage>();
-		if (!DestroyMsg->ParseFromString(Payload))
+		unrealpb::DestroyObjectMessage DestroyMsg;
+		if (!DestroyMsg.ParseFromString(Payload))
 		{
 			UE_LOG(LogChanneld, Error, TEXT("Failed to parse DestroyObjectMessage"));
 			return;
 		}
-
-		UObject* ObjToDestroy = GuidCache->GetObjectFromNetGUID(FNetworkGUID(DestroyMsg->netid()), true);
-		if (ObjToDestroy)
+		HandleDestroyObject(DestroyMsg);
+	}
+	else if (MsgType == Channeld::DestroyObjectsMsgType)
+	{
+		// The repeated DestroyObjectMessage in field 1. See UChanneldNetConnection::FlushDestroyMessages().
+		google::protobuf::io::CodedInputStream Input(reinterpret_cast<const uint8*>(Payload.data()), Payload.size());
+		unrealpb::DestroyObjectMessage DestroyMsg;
+		while (const uint32 Tag = Input.ReadTag())
 		{
-			UE_LOG(LogChanneld, Verbose, TEXT("[Client] Destroying object from message: %s, NetId: %d"), *GetNameSafe(ObjToDestroy), DestroyMsg->netid());
-			
-			if (AActor* Actor = Cast<AActor>(ObjToDestroy))
+			uint32 Size;
+			if (Tag != ((1 << 3) | google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) || !Input.ReadVarint32(&Size))
 			{
-				GetWorld()->DestroyActor(Actor, true);
+				UE_LOG(LogChanneld, Error, TEXT("Failed to parse the batched DestroyObjectMessage"));
+				return;
 			}
-			else
+			const google::protobuf::io::CodedInputStream::Limit Limit = Input.PushLimit(Size);
+			DestroyMsg.Clear();
+			if (!DestroyMsg.MergeFromCodedStream(&Input) || !Input.ConsumedEntireMessage())
 			{
-				ObjToDestroy->ConditionalBeginDestroy();
+				UE_LOG(LogChanneld, Error, TEXT("Failed to parse the batched DestroyObjectMessage"));
+				return;
 			}
+			Input.PopLimit(Limit);
+			HandleDestroyObject(DestroyMsg);
+		}
+	}
+}
+
+void UChanneldNetDriver::HandleDestroyObject(const unrealpb::DestroyObjectMessage& DestroyMsg)
+{
+	// The object is destroyed before it's spawned - just drop the spawn.
+	const int32 NumRemoved = PendingSpawnMsgs.RemoveAll([&DestroyMsg](const TSharedRef<unrealpb::SpawnObjectMessage>& SpawnMsg)
+	{
+		return SpawnMsg->obj().netguid() == DestroyMsg.netid();
+	});
+	int32 NumLoadingRemoved = 0;
+	for (auto& Pair : AsyncLoadingSpawnMsgs)
+	{
+		NumLoadingRemoved += Pair.Value.RemoveAll([&DestroyMsg](const TSharedRef<unrealpb::SpawnObjectMessage>& SpawnMsg)
+		{
+			return SpawnMsg->obj().netguid() == DestroyMsg.netid();
+		});
+	}
+	if (NumLoadingRemoved > 0 && ChannelDataView.IsValid())
+	{
+		ChannelDataView->StopHoldingUpdates(FNetworkGUID(DestroyMsg.netid()));
+	}
+	if (NumRemoved + NumLoadingRemoved > 0)
+	{
+		UE_LOG(LogChanneld, Verbose, TEXT("[Client] Dropped the pending spawn of the destroyed object, NetId: %d"), DestroyMsg.netid());
+		return;
+	}
+
+	UObject* ObjToDestroy = GuidCache->GetObjectFromNetGUID(FNetworkGUID(DestroyMsg.netid()), true);
+	if (ObjToDestroy)
+	{
+		UE_LOG(LogChanneld, Verbose, TEXT("[Client] Destroying object from message: %s, NetId: %d"), *GetNameSafe(ObjToDestroy), DestroyMsg.netid());
+		
+		if (AActor* Actor = Cast<AActor>(ObjToDestroy))
+		{
+			GetWorld()->DestroyActor(Actor, true);
 		}
 		else
 		{
-			UE_LOG(LogChanneld, Warning, TEXT("[Client] Failed to destroy object from msg: %s"), UTF8_TO_TCHAR(DestroyMsg->DebugString().c_str()));
+			ObjToDestroy->ConditionalBeginDestroy();
+		}
+	}
+	else
+	{
+		CHANNELD_LOG_RATE_LIMITED(LogChanneld, Warning, 1.0, TEXT("[Client] Failed to destroy object from msg: %s"), UTF8_TO_TCHAR(DestroyMsg.ShortDebugString().c_str()));
+	}
+}
+
+void UChanneldNetDriver::SpawnPendingObjects()
+{
+	CHANNELD_TRACE_SCOPE(Channeld_SpawnPendingObjects);
+	// Nearest first. The spawn messages without the location (PlayerController, PlayerState, GameState, etc.) go at the front.
+	if (const APlayerController* PC = GetWorld()->GetFirstPlayerController())
+	{
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		PendingSpawnMsgs.StableSort([&ViewLocation](const TSharedRef<unrealpb::SpawnObjectMessage>& A, const TSharedRef<unrealpb::SpawnObjectMessage>& B)
+		{
+			auto DistSq = [&ViewLocation](const unrealpb::SpawnObjectMessage& Msg)
+			{
+				if (!Msg.has_location())
+				{
+					return -1.0;
+				}
+				FVector Location = FVector::ZeroVector;
+				ChanneldUtils::SetVectorFromPB(Location, Msg.location());
+				return static_cast<double>(FVector::DistSquared(Location, ViewLocation));
+			};
+			return DistSq(*A) < DistSq(*B);
+		});
+	}
+
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	const double EndTime = FPlatformTime::Seconds() + Settings->ClientSpawnTimeBudgetMs * 0.001;
+
+	// The actors spawned in the previous ticks begin play first, in the order they were spawned (the owners before the owned actors).
+	int32 NumInitialized = 0;
+	while (NumInitialized < PendingPostNetInitActors.Num() && FPlatformTime::Seconds() < EndTime)
+	{
+		AActor* Actor = PendingPostNetInitActors[NumInitialized++].Get();
+		if (IsValid(Actor) && !Actor->HasActorBegunPlay())
+		{
+			Actor->PostNetInit();
 		}
 	}
+	PendingPostNetInitActors.RemoveAt(0, NumInitialized, false);
+
+	// Always spawn at least one object per tick, so the queue can't stall.
+	if (Settings->bClientDeferBeginPlay)
+	{
+		ChanneldUtils::DeferredPostNetInitActors = &PendingPostNetInitActors;
+	}
+	int32 NumSpawned = 0;
+	while (NumSpawned < PendingSpawnMsgs.Num())
+	{
+		HandleSpawnObject(PendingSpawnMsgs[NumSpawned++]);
+		if (FPlatformTime::Seconds() >= EndTime)
+		{
+			break;
+		}
+	}
+	ChanneldUtils::DeferredPostNetInitActors = nullptr;
+	PendingSpawnMsgs.RemoveAt(0, NumSpawned, false);
+	TRACE_COUNTER_SET(ChanneldPendingSpawns, PendingSpawnMsgs.Num());
+
+	UE_CLOG(PendingSpawnMsgs.Num() > 0 || PendingPostNetInitActors.Num() > 0, LogChanneld, VeryVerbose, TEXT("[Client] Spawned %d objects and initialized %d actors in this tick, %d spawns and %d inits pending"),
+		NumSpawned, NumInitialized, PendingSpawnMsgs.Num(), PendingPostNetInitActors.Num());
 }
 
 void UChanneldNetDriver::OnReceivedRPC(const unrealpb::RemoteFunctionMessage& RpcMsg)
 {
-	UChanneldMetrics* Metrics = GEngine->GetEngineSubsystem<UChanneldMetrics>();
+	UChanneldMetrics* Metrics = ConnToChanneld->GetMetrics();
 	Metrics->ReceivedRPCs_Counter->Increment();
 #if !UE_BUILD_SHIPPING
-	Metrics->ReceivedRPCs->Add({{"funcName", RpcMsg.functionname()}}).Increment();
+	Metrics->ReceivedRPCs->Add({{"funcName", TCHAR_TO_UTF8(*ChanneldReplication::GetRPCFunctionName(RpcMsg).ToString())}}).Increment();
 #endif
 }
 
-void UChanneldNetDriver::HandleCustomRPC(TSharedPtr<unrealpb::RemoteFunctionMessage> Msg)
+void UChanneldNetDriver::CullSimulatedProxies()
+{
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	if (Settings->SimulatedProxyCullDistance <= 0 && !Settings->bCullSimulatedProxiesOutOfView)
+	{
+		return;
+	}
+	const double Now = FPlatformTime::Seconds();
+	if (Now < NextProxyCullTime)
+	{
+		return;
+	}
+	NextProxyCullTime = Now + Settings->SimulatedProxyCullInterval;
+
+	APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (PC == nullptr)
+	{
+		return;
+	}
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	CHANNELD_TRACE_SCOPE(Channeld_CullSimulatedProxies);
+	const float CullDistSq = FMath::Square(Settings->SimulatedProxyCullDistance);
+	for (TActorIterator<AChanneldCharacter> It(GetWorld()); It; ++It)
+	{
+		AChanneldCharacter* Character = *It;
+		// The role may have changed since the last check, e.g. the player possesses the character.
+		if (Character->GetLocalRole() != ROLE_SimulatedProxy)
+		{
+			Character->SetProxyCulled(false);
+			continue;
+		}
+		const bool bCulled = (CullDistSq > 0 && FVector::DistSquared(Character->GetActorLocation(), ViewLocation) > CullDistSq)
+			|| (Settings->bCullSimulatedProxiesOutOfView && !Character->WasRecentlyRendered(Settings->SimulatedProxyCullInterval));
+		Character->SetProxyCulled(bCulled);
+	}
+}
+
+void UChanneldNetDriver::HandleCustomRPC(TSharedPtr<unrealpb::RemoteFunctionMessage> Msg, int32 NumRetries)
 {
 	// We should NEVER creates the actor via RPC
 	AActor* Actor = Cast<AActor>(ChanneldUtils::GetObjectByRef(&Msg->targetobj(), GetWorld(), false));
@@ -261,11 +535,12 @@ void UChanneldNetDriver::HandleCustomRPC(TSharedPtr<unrealpb::RemoteFunctionMess
 		// Case 1: the client receives the RPC before the spawn message. Should wait until the actor is spawned.
 		if (!IsServer())
 		{
-			UnprocessedRPCs.Add(Msg);
-			UE_LOG(LogChanneld, Log, TEXT("Cannot find actor to call remote function '%s', NetGUID: %d. Pushed to the next tick."), UTF8_TO_TCHAR(Msg->functionname().c_str()), Msg->targetobj().netguid());
+			UE_CLOG(NumRetries == 0, LogChanneld, Log, TEXT("Cannot find actor to call remote function '%s', NetGUID: %d. Pushed to the next tick."), *ChanneldReplication::GetRPCFunctionName(*Msg).ToString(), Msg->targetobj().netguid());
+			DeferRPC(Msg, NumRetries);
 		}
-		// Case 2: the server receives the client RPC, but the actor has just been handed over to another server (deleted).
-		else
+		// Case 2: the server receives the client RPC, but the actor has just been handed over to another server (deleted),
+		// or is being handed over to this server.
+		else if (!BufferHandoverMove(Msg, nullptr))
 		{
 			RedirectRPC(Msg);
 		}
@@ -274,15 +549,20 @@ void UChanneldNetDriver::HandleCustomRPC(TSharedPtr<unrealpb::RemoteFunctionMess
 	// Case 3: the server receives the client RPC, but the actor has just been handed over to another server (became non-authoritative).
 	if (IsServer() && !Actor->HasAuthority())
 	{
-		if (RedirectRPC(Msg))
+		if (BufferHandoverMove(Msg, Actor) || RedirectRPC(Msg))
 		{
 			return;
 		}
 	}
+	// The handover of the actor is received but not processed yet, so the moves would be applied to the state that is being handed over.
+	else if (IsServer() && BufferHandoverMove(Msg, Actor))
+	{
+		return;
+	}
 
 	//TSet<FNetworkGUID> UnmappedGUID;
 	bool bDelayRPC = false;
-	FName FuncName = UTF8_TO_TCHAR(Msg->functionname().c_str());
+	FName FuncName = ChanneldReplication::GetRPCFunctionName(*Msg);
 	UObject* SubObject = nullptr;
 	if (Msg->subobjectpath().length() > 0)
 	{
@@ -296,9 +576,90 @@ void UChanneldNetDriver::HandleCustomRPC(TSharedPtr<unrealpb::RemoteFunctionMess
 	ReceivedRPC(Actor, FuncName, Msg->paramspayload(), bDelayRPC, SubObject);
 	if (bDelayRPC)
 	{
-		UE_LOG(LogChanneld, Log, TEXT("Deferred RPC '%s::%s' due to unmapped NetGUID: %d"), *Actor->GetName(), *FuncName.ToString(), Msg->targetobj().netguid());
-		UnprocessedRPCs.Add(Msg);
+		UE_CLOG(NumRetries == 0, LogChanneld, Log, TEXT("Deferred RPC '%s::%s' due to unmapped NetGUID: %d"), *Actor->GetName(), *FuncName.ToString(), Msg->targetobj().netguid());
+		DeferRPC(Msg, NumRetries);
+	}
+}
+
+bool UChanneldNetDriver::BufferHandoverMove(TSharedPtr<unrealpb::RemoteFunctionMessage> Msg, AActor* Actor)
+{
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	if (bFlushingHandoverMoves || Settings->HandoverMoveBufferMs <= 0 || !ChannelDataView.IsValid())
+	{
+		return false;
+	}
+	if (!Settings->bHoldAllRPCsDuringHandover && ChanneldReplication::GetRPCFunctionName(*Msg) != ServerMovePackedFuncName)
+	{
+		return false;
+	}
+
+	const FNetworkGUID NetId(Msg->targetobj().netguid());
+	FHandoverMoveBuffer* Buffer = HandoverMoveBuffers.Find(NetId.Value);
+	// Keep the order of the moves that arrive after the buffered ones.
+	if (Buffer == nullptr)
+	{
+		// The handover to this server hasn't arrived yet, so the actor is neither spawned nor redirectable.
+		const bool bHandoverNotArrived = Actor == nullptr && ConnToChanneld->OwnedChannels.Contains(ChannelDataView->GetOwningChannelId(NetId));
+		if (!bHandoverNotArrived && !ChannelDataView->IsHandoverPending(NetId))
+		{
+			return false;
+		}
+		Buffer = &HandoverMoveBuffers.Add(NetId.Value, FHandoverMoveBuffer{FPlatformTime::Seconds()});
+	}
+
+	if (Buffer->Moves.Num() >= MaxHandoverMovesPerActor)
+	{
+		// Not necessarily a move if bHoldAllRPCsDuringHandover is set.
+		const FName DroppedFuncName = ChanneldReplication::GetRPCFunctionName(*Buffer->Moves[0]);
+		Buffer->Moves.RemoveAt(0, 1, false);
+		GEngine->GetEngineSubsystem<UChanneldMetrics>()->OnDroppedRPC(std::string(TCHAR_TO_UTF8(*DroppedFuncName.ToString())), RPCDropReason_Superseded);
+	}
+	Buffer->Moves.Add(Msg);
+	return true;
+}
+
+void UChanneldNetDriver::FlushHandoverMoveBuffers()
+{
+	const double ExpireTime = FPlatformTime::Seconds() - GetMutableDefault<UChanneldSettings>()->HandoverMoveBufferMs * 0.001;
+	TArray<TSharedPtr<unrealpb::RemoteFunctionMessage>> ReadyMoves;
+	for (auto It = HandoverMoveBuffers.CreateIterator(); It; ++It)
+	{
+		const FNetworkGUID NetId(It.Key());
+		if (It.Value().StartTime > ExpireTime && ChannelDataView.IsValid())
+		{
+			if (ChannelDataView->IsHandoverPending(NetId))
+			{
+				continue;
+			}
+			// Still waiting for the handover to this server.
+			if (GuidCache->GetObjectFromNetGUID(NetId, false) == nullptr && ConnToChanneld->OwnedChannels.Contains(ChannelDataView->GetOwningChannelId(NetId)))
+			{
+				continue;
+			}
+		}
+		ReadyMoves.Append(MoveTemp(It.Value().Moves));
+		It.RemoveCurrent();
+	}
+
+	// The moves of a character are either processed locally or redirected to its new server together.
+	TGuardValue<bool> FlushingGuard(bFlushingHandoverMoves, true);
+	for (TSharedPtr<unrealpb::RemoteFunctionMessage>& Move : ReadyMoves)
+	{
+		HandleCustomRPC(Move);
+	}
+}
+
+void UChanneldNetDriver::DeferRPC(TSharedPtr<unrealpb::RemoteFunctionMessage> Msg, int32 NumRetries)
+{
+	const int32 MaxRetries = GetMutableDefault<UChanneldSettings>()->MaxDeferredRPCRetries;
+	if (MaxRetries > 0 && NumRetries >= MaxRetries)
+	{
+		const FName FuncName = ChanneldReplication::GetRPCFunctionName(*Msg);
+		UE_LOG(LogChanneld, Warning, TEXT("Dropped deferred RPC '%s' after %d retries, NetGUID: %d"), *FuncName.ToString(), NumRetries, Msg->targetobj().netguid());
+		GEngine->GetEngineSubsystem<UChanneldMetrics>()->OnDroppedRPC(std::string(TCHAR_TO_UTF8(*FuncName.ToString())), RPCDropReason_DeferredMaxRetried);
+		return;
 	}
+	UnprocessedRPCs.Add(FUnprocessedRPC{Msg, NumRetries});
 }
 
 Channeld::ConnectionId UChanneldNetDriver::AddrToConnId(const FInternetAddr& Addr)
@@ -408,9 +769,15 @@ bool UChanneldNetDriver::InitBase(bool bInitAsClient, FNetworkNotify* InNotify,
 		}
 	}
 
-	ConnToChanneld = GEngine->GetEngineSubsystem<UChanneldConnection>();
+	// The same as the engine's connection, unless UChanneldSettings::bConnectionPerGameInstance is set.
+	ConnToChanneld = Subsystem ? Subsystem->GetConnection() : GEngine->GetEngineSubsystem<UChanneldConnection>();
 
 	ConnToChanneld->OnUserSpaceMessageReceived.AddUObject(this, &UChanneldNetDriver::OnUserSpaceMessageReceived);
+	if (!bInitAsClient && GetMutableDefault<UChanneldSettings>()->IdleServerDelay > 0)
+	{
+		ConnToChanneld->AddMessageHandler(channeldpb::SUB_TO_CHANNEL, this, &UChanneldNetDriver::HandleIdleWakeMessage);
+		ConnToChanneld->AddMessageHandler(channeldpb::CHANNEL_DATA_HANDOVER, this, &UChanneldNetDriver::HandleIdleWakeMessage);
+	}
 
 	InitBaseURL = URL;
 
@@ -435,6 +802,9 @@ bool UChanneldNetDriver::InitBase(bool bInitAsClient, FNetworkNotify* InNotify,
 			Error = TEXT("Failed to connect to channeld");
 			return false;
 		}
+		// Connect() returns before the connection is established. The failure after that is reported by the delegate.
+		ConnToChanneld->OnConnectFailed.RemoveAll(this);
+		ConnToChanneld->OnConnectFailed.AddUObject(this, &UChanneldNetDriver::OnChanneldConnectFailed);
 	}
 
 	if (!ConnToChanneld->IsAuthenticated())
@@ -444,6 +814,8 @@ bool UChanneldNetDriver::InitBase(bool bInitAsClient, FNetworkNotify* InNotify,
 		ConnToChanneld->Auth(TEXT("test_pit"), TEXT("test_lt"));
 	}
 
+	ObjRefCache.Init(GetMutableDefault<UChanneldSettings>()->MaxObjRefCacheSize);
+
 	return UNetDriver::InitBase(bInitAsClient, InNotify, URL, bReuseAddressAndPort, Error);
 }
 
@@ -566,7 +938,7 @@ void UChanneldNetDriver::LowLevelSend(TSharedPtr<const FInternetAddr> Address, v
 		if (ConnToChanneld->IsServer())
 		{
 			Channeld::ConnectionId ClientConnId = AddrToConnId(*Address);
-			if (auto Conn = ClientConnectionMap.FindRef(ClientConnId))
+			if (auto Conn = GetClientConnection(ClientConnId))
 			{
 				Conn->SendData(unrealpb::LOW_LEVEL, DataToSend, DataSize);
 			}
@@ -575,10 +947,11 @@ void UChanneldNetDriver::LowLevelSend(TSharedPtr<const FInternetAddr> Address, v
 				UE_LOG(LogChanneld, Log, TEXT("[Server] Failed to LowLevelSend to client %d"), ClientConnId);
 			}
 		}
-		else
+		else if (!GetMutableDefault<UChanneldSettings>()->bSpectatorMode)
 		{
 			GetServerConnection()->SendData(unrealpb::LOW_LEVEL, DataToSend, DataSize);
 		}
+		// The spectator never logs in to the servers, so the UE's packets go nowhere.
 	}
 }
 
@@ -589,11 +962,23 @@ void UChanneldNetDriver::LowLevelDestroy()
 	FGameModeEvents::GameModePostLoginEvent.RemoveAll(this);
 	
 	ClientConnectionMap.Reset();
+	ClientConnectionsByConnId.Empty();
+	SpawnTrackingIndices.Empty();
+	FreeSpawnTrackingIndices.Empty();
+	RPCFunctionCache.Empty();
+	HandoverMoveBuffers.Empty();
+	QueuedUnreliableRPCs.Reset();
+	LatestUnreliableRPCIndices.Reset();
+	UnreliableRPCNextAllowedTimes.Reset();
+	ObjRefCache.Reset();
+	ResolvedObjCache.Reset();
 
 	if (ConnToChanneld)
 	{
 		ConnToChanneld->OnAuthenticated.RemoveAll(this);
 		ConnToChanneld->OnUserSpaceMessageReceived.RemoveAll(this);
+		ConnToChanneld->RemoveMessageHandler(channeldpb::SUB_TO_CHANNEL, this);
+		ConnToChanneld->RemoveMessageHandler(channeldpb::CHANNEL_DATA_HANDOVER, this);
 		// ConnToChanneld->RemoveMessageHandler(channeldpb::UNSUB_FROM_CHANNEL, this);
 		//ConnToChanneld->RemoveMessageHandler(unrealpb::LOW_LEVEL, this);
 		//ConnToChanneld->RemoveMessageHandler(MessageType_RPC, this);
@@ -631,6 +1016,7 @@ bool UChanneldNetDriver::IsNetResourceValid()
 
 void UChanneldNetDriver::OnServerSpawnedActor(AActor* Actor)
 {
+	CHANNELD_TRACE_SCOPE(Channeld_ServerSpawn);
 	if (GetMutableDefault<UChanneldSettings>()->bSkipCustomReplication)
 	{
 		return;
@@ -651,6 +1037,7 @@ void UChanneldNetDriver::OnServerSpawnedActor(AActor* Actor)
 	}
 
 	// Make sure the NetGUID exists.
+	CheckDynamicNetIdBlock();
 	FNetworkGUID NetId = GuidCache->GetOrAssignNetGUID(Actor);
 
 	/* Moved to UChanneldGameInstanceSubsystem::OnActorSpawned
@@ -772,10 +1159,41 @@ void UChanneldNetDriver::OnServerBeginPlay(UChanneldReplicationComponent* RepCom
 
 void UChanneldNetDriver::SetAllSentSpawn(const FNetworkGUID NetId)
 {
+	const int32 SpawnIndex = GetSpawnTrackingIndex(NetId);
+	for (auto& Pair : ClientConnectionMap)
+	{
+		Pair.Value->SetSentSpawned(NetId, SpawnIndex);
+	}
+}
+
+int32 UChanneldNetDriver::GetSpawnTrackingIndex(const FNetworkGUID NetId)
+{
+	if (const int32* SpawnIndex = SpawnTrackingIndices.Find(NetId))
+	{
+		return *SpawnIndex;
+	}
+	// Without the free indices, the indices in use are [0, Num).
+	const int32 NewIndex = FreeSpawnTrackingIndices.Num() > 0 ? FreeSpawnTrackingIndices.Pop(false) : SpawnTrackingIndices.Num();
+	SpawnTrackingIndices.Add(NetId, NewIndex);
+	return NewIndex;
+}
+
+void UChanneldNetDriver::ReleaseSpawnTrackingIndex(const FNetworkGUID NetId)
+{
+	int32 SpawnIndex;
+	if (!SpawnTrackingIndices.RemoveAndCopyValue(NetId, SpawnIndex))
+	{
+		return;
+	}
+	// The index can be reused by another object right away.
 	for (auto& Pair : ClientConnectionMap)
 	{
-		Pair.Value->SetSentSpawned(NetId);
+		if (IsValid(Pair.Value))
+		{
+			Pair.Value->ClearSentSpawned(NetId, SpawnIndex);
+		}
 	}
+	FreeSpawnTrackingIndices.Add(SpawnIndex);
 }
 
 bool UChanneldNetDriver::RedirectRPC(TSharedPtr<unrealpb::RemoteFunctionMessage> Msg)
@@ -788,7 +1206,7 @@ bool UChanneldNetDriver::RedirectRPC(TSharedPtr<unrealpb::RemoteFunctionMessage>
 			Channeld::ChannelId TargetChId = ChannelDataView->GetOwningChannelId(FNetworkGUID(Msg->targetobj().netguid()));
 			if (ConnToChanneld->OwnedChannels.Contains(TargetChId))
 			{
-				UE_LOG(LogChanneld, Warning, TEXT("Attempt to redirect RPC to the same server, netId: %d, func: %s"), Msg->targetobj().netguid(), UTF8_TO_TCHAR(Msg->functionname().c_str()));
+				UE_LOG(LogChanneld, Warning, TEXT("Attempt to redirect RPC to the same server, netId: %d, func: %s"), Msg->targetobj().netguid(), *ChanneldReplication::GetRPCFunctionName(*Msg).ToString());
 				return false;
 			}
 		
@@ -796,12 +1214,12 @@ bool UChanneldNetDriver::RedirectRPC(TSharedPtr<unrealpb::RemoteFunctionMessage>
 			{
 				Msg->set_redirectioncounter(Msg->redirectioncounter() + 1);
 				ConnToChanneld->Broadcast(TargetChId, unrealpb::RPC, *Msg, channeldpb::SINGLE_CONNECTION);
-				UE_LOG(LogChanneld, Verbose, TEXT("Redirect RPC to channel %d, netId: %d, func: %s"), TargetChId, Msg->targetobj().netguid(), UTF8_TO_TCHAR(Msg->functionname().c_str()));
+				UE_LOG(LogChanneld, Verbose, TEXT("Redirect RPC to channel %d, netId: %d, func: %s"), TargetChId, Msg->targetobj().netguid(), *ChanneldReplication::GetRPCFunctionName(*Msg).ToString());
 				
 				UChanneldMetrics* Metrics = GEngine->GetEngineSubsystem<UChanneldMetrics>();
 				Metrics->RedirectedRPCs_Counter->Increment();
 #if !UE_BUILD_SHIPPING
-				Metrics->RedirectedRPCs->Add({{"funcName", Msg->functionname()}}).Increment();
+				Metrics->RedirectedRPCs->Add({{"funcName", TCHAR_TO_UTF8(*ChanneldReplication::GetRPCFunctionName(*Msg).ToString())}}).Increment();
 #endif
 
 				OnSentRPC(*Msg);
@@ -822,7 +1240,7 @@ bool UChanneldNetDriver::RedirectRPC(TSharedPtr<unrealpb::RemoteFunctionMessage>
 		DropReason = RPCDropReason_RedirMaxRetried;
 	}
 
-	GEngine->GetEngineSubsystem<UChanneldMetrics>()->OnDroppedRPC(Msg->functionname(), DropReason);
+	GEngine->GetEngineSubsystem<UChanneldMetrics>()->OnDroppedRPC(std::string(TCHAR_TO_UTF8(*ChanneldReplication::GetRPCFunctionName(*Msg).ToString())), DropReason);
 	return true;
 }
 
@@ -853,24 +1271,65 @@ void UChanneldNetDriver::OnClientPostLogin(AGameModeBase* GameMode, APlayerContr
 
 void UChanneldNetDriver::TickDispatch(float DeltaTime)
 {
+	double StartTime = FPlatformTime::Seconds();
 	//Super::TickDispatch(DeltaTime);
 	UNetDriver::TickDispatch(DeltaTime);
 
 	if (IsValid(ConnToChanneld) && ConnToChanneld->IsConnected())
+	{
+		const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+		const int32 WaitMs = Settings->ServerDispatchWaitMs;
+		if (bServerIdle)
+		{
+			// Wait out the rest of the idle frame, unless a message arrives in the meantime. The waiting is not counted as the incoming time.
+			const double WaitStartTime = FPlatformTime::Seconds();
+			const int32 IdleWaitMs = FMath::FloorToInt((LastIdleDispatchTime + 1.0 / FMath::Max(Settings->IdleServerTickRate, 1) - WaitStartTime) * 1000);
+			if (IdleWaitMs > 0)
+			{
+				ConnToChanneld->WaitForIncoming(IdleWaitMs);
+			}
+			LastIdleDispatchTime = FPlatformTime::Seconds();
+			StartTime += LastIdleDispatchTime - WaitStartTime;
+		}
+		else if (WaitMs > 0 && ConnToChanneld->IsServer())
+		{
+			ConnToChanneld->WaitForIncoming(WaitMs);
+		}
 		ConnToChanneld->TickIncoming();
+	}
 
-	int NumToProcess = UnprocessedRPCs.Num();
-	for (int i = 0; i < NumToProcess; i++)
+	if (PendingSpawnMsgs.Num() > 0 || PendingPostNetInitActors.Num() > 0)
 	{
-		TSharedPtr<unrealpb::RemoteFunctionMessage> RpcMsg = *UnprocessedRPCs.GetData();
-		UnprocessedRPCs.RemoveAt(0);
-		HandleCustomRPC(RpcMsg);
+		SpawnPendingObjects();
 	}
+
+	if (!IsServer())
+	{
+		CullSimulatedProxies();
+	}
+
+	if (UnprocessedRPCs.Num() > 0)
+	{
+		// The RPCs deferred again are added to the emptied UnprocessedRPCs for the next tick.
+		Swap(UnprocessedRPCs, RetryingRPCs);
+		for (FUnprocessedRPC& RPC : RetryingRPCs)
+		{
+			HandleCustomRPC(RPC.Msg, RPC.NumRetries + 1);
+		}
+		RetryingRPCs.Reset();
+	}
+	if (HandoverMoveBuffers.Num() > 0)
+	{
+		FlushHandoverMoveBuffers();
+	}
+	GEngine->GetEngineSubsystem<UChanneldMetrics>()->DeferredRPCs_Gauge->Set(UnprocessedRPCs.Num());
+	NetFrameStageSeconds[static_cast<int32>(EChanneldNetFrameStage::Incoming)] += FPlatformTime::Seconds() - StartTime;
 }
 
 // Won't trigger until ClientConnections.Num() > 0
 int32 UChanneldNetDriver::ServerReplicateActors(float DeltaSeconds)
 {
+	const double StartTime = FPlatformTime::Seconds();
 	int32 Result = 0;
 
 	if (GetMutableDefault<UChanneldSettings>()->bSkipCustomReplication)
@@ -879,13 +1338,34 @@ int32 UChanneldNetDriver::ServerReplicateActors(float DeltaSeconds)
 	}
 	else
 	{
+		// The move responses are recorded during SendClientAdjustment(), serialized in parallel, and then sent in the order of the connections.
+		const bool bParallelAdjustments = GetMutableDefault<UChanneldSettings>()->bParallelClientAdjustments;
+		TArray<UChanneldNetConnection*> DeferredConnections;
 		for (int32 i = 0; i < ClientConnections.Num(); i++)
 		{
 			UChanneldNetConnection* Connection = CastChecked<UChanneldNetConnection>(ClientConnections[i]);
 			if (Connection->PlayerController && Connection->PlayerController->GetViewTarget())
 			{
 				// Trigger ClientMoveResponse RPC
+				Connection->SetDeferMoveResponses(bParallelAdjustments);
 				Connection->PlayerController->SendClientAdjustment();
+				Connection->SetDeferMoveResponses(false);
+				if (Connection->HasDeferredMoveResponses())
+				{
+					DeferredConnections.Add(Connection);
+				}
+			}
+		}
+
+		if (DeferredConnections.Num() > 0)
+		{
+			ParallelFor(DeferredConnections.Num(), [&](int32 i)
+			{
+				DeferredConnections[i]->SerializeDeferredMoveResponses();
+			});
+			for (UChanneldNetConnection* Connection : DeferredConnections)
+			{
+				Connection->FlushDeferredMoveResponses();
 			}
 		}
 
@@ -894,12 +1374,14 @@ int32 UChanneldNetDriver::ServerReplicateActors(float DeltaSeconds)
 			Result = ChannelDataView->SendAllChannelUpdates();
 		}
 	}
-	
+
+	NetFrameStageSeconds[static_cast<int32>(EChanneldNetFrameStage::Replicate)] += FPlatformTime::Seconds() - StartTime;
 	return Result;
 }
 
 void UChanneldNetDriver::ProcessRemoteFunction(class AActor* Actor, class UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, struct FFrame* Stack, class UObject* SubObject /*= nullptr*/)
 {
+	CHANNELD_TRACE_SCOPE(Channeld_SendRPC);
 	const FName FuncFName = Function->GetFName();
 	const FString FuncName = FuncFName.ToString();
 	const bool bShouldLog = FuncFName != ServerMovePackedFuncName && FuncFName != ClientMoveResponsePackedFuncName && FuncFName != ServerUpdateCameraFuncName;
@@ -927,7 +1409,7 @@ void UChanneldNetDriver::ProcessRemoteFunction(class AActor* Actor, class UFunct
 	ERPCDropReason DropReason = RPCDropReason_Unknown;
 	if (!GetMutableDefault<UChanneldSettings>()->bSkipCustomReplication)
 	{
-		auto RepComp = Cast<UChanneldReplicationComponent>(Actor->FindComponentByClass(UChanneldReplicationComponent::StaticClass()));
+		auto RepComp = UChanneldReplicationComponent::FindForActor(Actor);
 		if (RepComp)
 		{
 			UObject* TargetObject = Actor;
@@ -938,51 +1420,26 @@ void UChanneldNetDriver::ProcessRemoteFunction(class AActor* Actor, class UFunct
 				SubObjectPathName = SubObject->GetName();
 			}
 			
+			// The most frequent RPCs. Skip the reflection and the params message of the character replicator.
+			if (SubObject == nullptr && (FuncFName == ServerMovePackedFuncName || FuncFName == ClientMoveResponsePackedFuncName)
+				&& SendPackedMoveRPC(Actor, FuncFName, FuncName, Parameters))
+			{
+				return;
+			}
+			
 			bool bSuccess = true;
 			auto ParamsMsg = RepComp->SerializeFunctionParams(TargetObject, Function, Parameters, OutParms, bSuccess);
 			if (bSuccess)
 			{
 				UE_CLOG(bShouldLog && ParamsMsg.IsValid(), LogChanneld, VeryVerbose, TEXT("Serialized RPC parameters: %s"), UTF8_TO_TCHAR(ParamsMsg->DebugString().c_str()));
 				
-				Channeld::ChannelId OwningChId = ChannelDataView->GetOwningChannelId(Actor);
-
-				// Server -> Client multicast RPC
-				if (ConnToChanneld->IsServer() && (Function->FunctionFlags & FUNC_NetMulticast))
+				if (!(Function->FunctionFlags & FUNC_NetReliable) && QueueUnreliableRPC(Actor, TargetObject, Function, FuncName, ParamsMsg, SubObjectPathName))
 				{
-					if (ChannelDataView->SendMulticastRPC(Actor, FuncName, ParamsMsg, SubObjectPathName))
-					{
-						return;
-					}
-				}
-				// Client or authoritative server sends the RPC directly
-				else if (ConnToChanneld->IsClient() || Actor->HasAuthority() || ConnToChanneld->OwnedChannels.Contains(OwningChId))
-				{
-					UChanneldNetConnection* NetConn = ConnToChanneld->IsClient() ? GetServerConnection() : Cast<UChanneldNetConnection>(Actor->GetNetConnection());
-					if (NetConn)
-					{
-						NetConn->SendRPCMessage(Actor, FuncName, ParamsMsg, OwningChId, SubObjectPathName);
-						return;
-					}
-					UE_LOG(LogChanneld, Warning, TEXT("Failed to send RPC %s::%s as the actor doesn't have any NetConn"), *Actor->GetName(), *FuncName);
+					return;
 				}
-				// Non-authoritative server forwards the RPC to the server that has authority over the actor (channel owner)
-				else
+
+				if (SendRPC(Actor, Function, FuncName, ParamsMsg, SubObjectPathName))
 				{
-					unrealpb::RemoteFunctionMessage RpcMsg;
-					RpcMsg.mutable_targetobj()->set_netguid(GuidCache->GetNetGUID(Actor).Value);
-					RpcMsg.set_functionname(TCHAR_TO_UTF8(*FuncName), FuncName.Len());
-					if (!SubObjectPathName.IsEmpty())
-					{
-						RpcMsg.set_subobjectpath(TCHAR_TO_UTF8(*SubObjectPathName), SubObjectPathName.Len());
-					}
-					if (ParamsMsg)
-					{
-						RpcMsg.set_paramspayload(ParamsMsg->SerializeAsString());
-						UE_LOG(LogChanneld, VeryVerbose, TEXT("Serialized RPC parameters to %llu bytes"), RpcMsg.paramspayload().size());
-					}
-					ConnToChanneld->Broadcast(OwningChId, unrealpb::RPC, RpcMsg, channeldpb::SINGLE_CONNECTION);
-					UE_LOG(LogChanneld, Log, TEXT("Forwarded RPC %s::%s to the owner of channel %d"), *Actor->GetName(), *FuncName, OwningChId);
-					OnSentRPC(RpcMsg);
 					return;
 				}
 			}
@@ -999,34 +1456,213 @@ void UChanneldNetDriver::ProcessRemoteFunction(class AActor* Actor, class UFunct
 		}
 	}
 
-	GEngine->GetEngineSubsystem<UChanneldMetrics>()->OnDroppedRPC(std::string(TCHAR_TO_UTF8(*FuncName)), DropReason);
+	UChanneldMetrics* Metrics = GEngine->GetEngineSubsystem<UChanneldMetrics>();
+	Metrics->OnDroppedRPC(std::string(TCHAR_TO_UTF8(*FuncName)), DropReason);
 	
 	// Fallback to native RPC
+	const bool bCustomReplication = !GetMutableDefault<UChanneldSettings>()->bSkipCustomReplication;
+	const int64 NativeSendBits = bCustomReplication ? GetNativeSendBits() : 0;
 	Super::ProcessRemoteFunction(Actor, Function, Parameters, OutParms, Stack, SubObject);
+	if (bCustomReplication)
+	{
+		Metrics->OnNativeRPCFallback(Function, DropReason, (GetNativeSendBits() - NativeSendBits + 7) / 8);
+	}
+}
+
+int64 UChanneldNetDriver::GetNativeSendBits() const
+{
+	// OutBytes covers the packets flushed in the middle of the RPC.
+	int64 Bits = 0;
+	if (ServerConnection)
+	{
+		Bits += ServerConnection->SendBuffer.GetNumBits() + ServerConnection->OutBytes * 8ll;
+	}
+	for (const UNetConnection* ClientConn : ClientConnections)
+	{
+		Bits += ClientConn->SendBuffer.GetNumBits() + ClientConn->OutBytes * 8ll;
+	}
+	return Bits;
+}
+
+bool UChanneldNetDriver::SendPackedMoveRPC(AActor* Actor, const FName& FuncFName, const FString& FuncName, void* Parameters)
+{
+	// Only the direct sending has the fast path. See ProcessRemoteFunction().
+	const Channeld::ChannelId OwningChId = ChannelDataView->GetOwningChannelId(Actor);
+	if (!ConnToChanneld->IsClient() && !Actor->HasAuthority() && !ConnToChanneld->OwnedChannels.Contains(OwningChId))
+	{
+		return false;
+	}
+	UChanneldNetConnection* NetConn = ConnToChanneld->IsClient() ? GetServerConnection() : Cast<UChanneldNetConnection>(Actor->GetNetConnection());
+	if (!NetConn)
+	{
+		return false;
+	}
+
+	// The packed bits are the only parameter of both functions.
+	const bool bServerMove = FuncFName == ServerMovePackedFuncName;
+	const FCharacterNetworkSerializationPackedBits& PackedBits = bServerMove
+		? static_cast<const FCharacterNetworkSerializationPackedBits&>(*static_cast<FCharacterServerMovePackedBits*>(Parameters))
+		: static_cast<const FCharacterNetworkSerializationPackedBits&>(*static_cast<FCharacterMoveResponsePackedBits*>(Parameters));
+	return NetConn->SendPackedMoveRPC(Actor, FuncName, PackedBits, bServerMove, OwningChId);
+}
+
+bool UChanneldNetDriver::SendRPC(AActor* Actor, UFunction* Function, const FString& FuncName, TSharedPtr<google::protobuf::Message> ParamsMsg, const FString& SubObjectPathName)
+{
+	Channeld::ChannelId OwningChId = ChannelDataView->GetOwningChannelId(Actor);
+
+	// Server -> Client multicast RPC
+	if (ConnToChanneld->IsServer() && (Function->FunctionFlags & FUNC_NetMulticast))
+	{
+		if (ChannelDataView->SendMulticastRPC(Actor, FuncName, ParamsMsg, SubObjectPathName))
+		{
+			return true;
+		}
+	}
+	// Client or authoritative server sends the RPC directly
+	else if (ConnToChanneld->IsClient() || Actor->HasAuthority() || ConnToChanneld->OwnedChannels.Contains(OwningChId))
+	{
+		UChanneldNetConnection* NetConn = ConnToChanneld->IsClient() ? GetServerConnection() : Cast<UChanneldNetConnection>(Actor->GetNetConnection());
+		if (NetConn)
+		{
+			NetConn->SendRPCMessage(Actor, FuncName, ParamsMsg, OwningChId, SubObjectPathName);
+			return true;
+		}
+		UE_LOG(LogChanneld, Warning, TEXT("Failed to send RPC %s::%s as the actor doesn't have any NetConn"), *Actor->GetName(), *FuncName);
+	}
+	// Non-authoritative server forwards the RPC to the server that has authority over the actor (channel owner)
+	else
+	{
+		unrealpb::RemoteFunctionMessage RpcMsg;
+		RpcMsg.mutable_targetobj()->set_netguid(GuidCache->GetNetGUID(Actor).Value);
+		ChanneldReplication::SetRPCFunctionName(RpcMsg, FuncName);
+		if (!SubObjectPathName.IsEmpty())
+		{
+			RpcMsg.set_subobjectpath(TCHAR_TO_UTF8(*SubObjectPathName), SubObjectPathName.Len());
+		}
+		// The parameters are encoded straight into the message body as the paramsPayload.
+		ConnToChanneld->ForwardWithPayload(OwningChId, unrealpb::RPC, RpcMsg, unrealpb::RemoteFunctionMessage::kParamsPayloadFieldNumber, ParamsMsg.Get());
+		UE_LOG(LogChanneld, Log, TEXT("Forwarded RPC %s::%s to the owner of channel %d"), *Actor->GetName(), *FuncName, OwningChId);
+		OnSentRPC(RpcMsg);
+		return true;
+	}
+	return false;
+}
+
+bool UChanneldNetDriver::QueueUnreliableRPC(AActor* Actor, UObject* TargetObject, UFunction* Function, const FString& FuncName, TSharedPtr<google::protobuf::Message> ParamsMsg, const FString& SubObjectPathName)
+{
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	const FChanneldUnreliableRPCLimit* Limit = Settings->UnreliableRPCLimits.Find(Function->GetFName());
+	const TPair<const UObject*, const UFunction*> Key(TargetObject, Function);
+
+	if (Limit && Limit->MaxCallsPerSecond > 0)
+	{
+		const double Now = FPlatformTime::Seconds();
+		double& NextAllowedTime = UnreliableRPCNextAllowedTimes.FindOrAdd(MakeTuple(TWeakObjectPtr<const UObject>(TargetObject), TWeakObjectPtr<const UFunction>(Function)), 0);
+		if (Now < NextAllowedTime)
+		{
+			GEngine->GetEngineSubsystem<UChanneldMetrics>()->OnDroppedRPC(std::string(TCHAR_TO_UTF8(*FuncName)), RPCDropReason_RateLimited);
+			return true;
+		}
+		NextAllowedTime = Now + 1.0 / Limit->MaxCallsPerSecond;
+	}
+
+	if (!Settings->bBatchUnreliableRPCs)
+	{
+		return false;
+	}
+
+	if (Limit && Limit->bLatestWins)
+	{
+		if (const int32* Index = LatestUnreliableRPCIndices.Find(Key))
+		{
+			GEngine->GetEngineSubsystem<UChanneldMetrics>()->OnDroppedRPC(std::string(TCHAR_TO_UTF8(*FuncName)), RPCDropReason_Superseded);
+			QueuedUnreliableRPCs[*Index].ParamsMsg = ParamsMsg;
+			return true;
+		}
+		LatestUnreliableRPCIndices.Add(Key, QueuedUnreliableRPCs.Num());
+	}
+	QueuedUnreliableRPCs.Add(FQueuedUnreliableRPC{Actor, Function, FuncName, ParamsMsg, SubObjectPathName});
+	return true;
+}
+
+void UChanneldNetDriver::FlushUnreliableRPCs()
+{
+	for (FQueuedUnreliableRPC& RPC : QueuedUnreliableRPCs)
+	{
+		AActor* Actor = RPC.Actor.Get();
+		if (Actor == nullptr || Actor->IsActorBeingDestroyed())
+		{
+			continue;
+		}
+		// The parameters are gone, so it can't fall back to the native RPC as ProcessRemoteFunction() does.
+		if (!SendRPC(Actor, RPC.Function, RPC.FuncName, RPC.ParamsMsg, RPC.SubObjectPathName))
+		{
+			GEngine->GetEngineSubsystem<UChanneldMetrics>()->OnDroppedRPC(std::string(TCHAR_TO_UTF8(*RPC.FuncName)), RPCDropReason_Unknown);
+		}
+	}
+	QueuedUnreliableRPCs.Reset();
+	LatestUnreliableRPCIndices.Reset();
+}
+
+void UChanneldNetDriver::PruneUnreliableRPCLimits()
+{
+	if (UnreliableRPCNextAllowedTimes.Num() == 0)
+	{
+		return;
+	}
+	const double Now = FPlatformTime::Seconds();
+	for (auto It = UnreliableRPCNextAllowedTimes.CreateIterator(); It; ++It)
+	{
+		if (It.Value() <= Now || !It.Key().Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
 }
 
 void UChanneldNetDriver::OnSentRPC(const unrealpb::RemoteFunctionMessage& RpcMsg)
 {
-	UChanneldMetrics* Metrics = GEngine->GetEngineSubsystem<UChanneldMetrics>();
+	UChanneldMetrics* Metrics = ConnToChanneld->GetMetrics();
 	Metrics->SentRPCs_Counter->Increment();
 #if !UE_BUILD_SHIPPING
-	Metrics->SentRPCs->Add({{"funcName", RpcMsg.functionname()}}).Increment();
+	Metrics->SentRPCs->Add({{"funcName", TCHAR_TO_UTF8(*ChanneldReplication::GetRPCFunctionName(RpcMsg).ToString())}}).Increment();
 #endif
 }
 
+UFunction* UChanneldNetDriver::FindRPCFunction(UObject* Obj, const FName& FunctionName)
+{
+	const TPair<const UClass*, FName> CacheKey(Obj->GetClass(), FunctionName);
+	if (const TWeakObjectPtr<UFunction>* CachedFunction = RPCFunctionCache.Find(CacheKey))
+	{
+		// The function can be gone with the class, e.g. a recompiled blueprint.
+		if (CachedFunction->IsValid())
+		{
+			return CachedFunction->Get();
+		}
+	}
+	UFunction* Function = Obj->FindFunction(FunctionName);
+	if (Function)
+	{
+		RPCFunctionCache.Add(CacheKey, Function);
+	}
+	return Function;
+}
+
 void UChanneldNetDriver::ReceivedRPC(AActor* Actor, const FName& FunctionName, const std::string& ParamsPayload, bool& bDeferredRPC, UObject* SubObject)
 {
-	const FString FuncName = FunctionName.ToString();
+	CHANNELD_TRACE_SCOPE(Channeld_ReceiveRPC);
 	const bool bShouldLog = FunctionName != ServerMovePackedFuncName && FunctionName != ClientMoveResponsePackedFuncName && FunctionName != ServerUpdateCameraFuncName;
-	UE_CLOG(bShouldLog, LogChanneld, Verbose, TEXT("Received RPC %s::%s"), *Actor->GetName(), *FuncName);
+	UE_CLOG(bShouldLog, LogChanneld, Verbose, TEXT("Received RPC %s::%s"), *Actor->GetName(), *FunctionName.ToString());
 
 	UObject* Obj = SubObject != nullptr ? SubObject : Actor;
-	UFunction* Function = Obj->FindFunction(FunctionName);
+	UFunction* Function = FindRPCFunction(Obj, FunctionName);
 	if (!Function)
 	{
-		UE_LOG(LogChanneld, Error, TEXT("RPC function %s doesn't exist on Obj %s"), *FuncName, *Actor->GetName());
+		UE_LOG(LogChanneld, Error, TEXT("RPC function %s doesn't exist on Obj %s"), *FunctionName.ToString(), *Actor->GetName());
 		return;
 	}
+	// Only used by the logging and the metrics of the failures below.
+	const FString FuncName = FunctionName.ToString();
 
 	ERPCDropReason DropReason = RPCDropReason_Unknown;
 	if (Actor->GetLocalRole() <= ENetRole::ROLE_SimulatedProxy)
@@ -1040,7 +1676,7 @@ void UChanneldNetDriver::ReceivedRPC(AActor* Actor, const FName& FunctionName, c
 	}
 	else
 	{
-		auto RepComp = Cast<UChanneldReplicationComponent>(Actor->FindComponentByClass(UChanneldReplicationComponent::StaticClass()));
+		auto RepComp = UChanneldReplicationComponent::FindForActor(Actor);
 		if (RepComp)
 		{
 			bool bSuccess = true;
@@ -1071,19 +1707,82 @@ void UChanneldNetDriver::ReceivedRPC(AActor* Actor, const FName& FunctionName, c
 	GEngine->GetEngineSubsystem<UChanneldMetrics>()->OnDroppedRPC(std::string(TCHAR_TO_UTF8(*FuncName)), DropReason);
 }
 
+void UChanneldNetDriver::TickClientInterests(float DeltaSeconds)
+{
+	TArray<UClientInterestManager*> Managers;
+	Managers.Reserve(ClientConnectionMap.Num());
+	for (auto& Pair : ClientConnectionMap)
+	{
+		if (Pair.Value && Pair.Value->ClientInterestManager && Pair.Value->ClientInterestManager->IsActive())
+		{
+			Managers.Add(Pair.Value->ClientInterestManager);
+		}
+	}
+
+	TArray<bool> NewQueries;
+	NewQueries.SetNumZeroed(Managers.Num());
+	ParallelFor(Managers.Num(), [&](int32 i)
+	{
+		NewQueries[i] = Managers[i]->TickQuery(DeltaSeconds);
+	}, !GetMutableDefault<UChanneldSettings>()->bParallelInterestQueries);
+
+	// The messages of the changed queries go out in the same TickOutgoing().
+	for (int32 i = 0; i < Managers.Num(); i++)
+	{
+		if (NewQueries[i])
+		{
+			Managers[i]->SendQuery();
+		}
+		Managers[i]->TickReplicationLOD(DeltaSeconds);
+	}
+}
+
 void UChanneldNetDriver::TickFlush(float DeltaSeconds)
 {
+	CHANNELD_TRACE_SCOPE(Channeld_TickFlush);
+	const double StartTime = FPlatformTime::Seconds();
 	// Trigger the callings of ServerReplicateActors() and LowLevelSend()
 	UNetDriver::TickFlush(DeltaSeconds);
 
 	// Send ChannelDataUpdate to channeld even if there's no client connection yet, and ServerReplicateActors() is skipped.
 	if (IsServer() && ClientConnections.Num() == 0 && !bSkipServerReplicateActors)
 	{
-		if (!GetMutableDefault<UChanneldSettings>()->bSkipCustomReplication && ChannelDataView.IsValid())
+		const double ReplicateStartTime = FPlatformTime::Seconds();
+		if (!GetMutableDefault<UChanneldSettings>()->bSkipCustomReplication && ChannelDataView.IsValid() && ShouldReplicateWhileIdle(ReplicateStartTime))
 		{
-			ChannelDataView->SendAllChannelUpdates();
+			UpdateServerIdle(ChannelDataView->SendAllChannelUpdates());
+			NetFrameStageSeconds[static_cast<int32>(EChanneldNetFrameStage::Replicate)] += FPlatformTime::Seconds() - ReplicateStartTime;
 		}
 	}
+	else if (bServerIdle)
+	{
+		WakeFromIdle(TEXT("client connection"));
+	}
+
+	if (QueuedUnreliableRPCs.Num() > 0 && ChannelDataView.IsValid())
+	{
+		FlushUnreliableRPCs();
+	}
+	// The rate limits apply even if the RPCs are not batched.
+	PruneUnreliableRPCLimits();
+
+	if (IsServer() && ClientConnectionMap.Num() > 0)
+	{
+		TickClientInterests(DeltaSeconds);
+	}
+
+	if (IsServer())
+	{
+		CheckDynamicNetIdBlock();
+	}
+
+	UChanneldMetrics* Metrics = GEngine->GetEngineSubsystem<UChanneldMetrics>();
+	Metrics->ObjRefCacheSize_Gauge->Set(ObjRefCache.Num());
+	Metrics->ObjRefCacheBytes_Gauge->Set(ObjRefCache.GetAllocatedSize());
+	if (ChannelDataView.IsValid())
+	{
+		Metrics->OwningChannelMappings_Gauge->Set(ChannelDataView->GetNumOwningChannelMappings());
+	}
 
 	if (ConnToChanneld && ConnToChanneld->IsConnected())
 	{
@@ -1091,6 +1790,71 @@ void UChanneldNetDriver::TickFlush(float DeltaSeconds)
 		ConnToChanneld->TickOutgoing();
 		UNCLOCK_CYCLES(SendCycles);
 	}
+
+	// ServerReplicateActors() is called inside TickFlush, so its time is not counted as outgoing.
+	const double ReplicateSeconds = NetFrameStageSeconds[static_cast<int32>(EChanneldNetFrameStage::Replicate)];
+	NetFrameStageSeconds[static_cast<int32>(EChanneldNetFrameStage::Outgoing)] = FMath::Max(0.0, FPlatformTime::Seconds() - StartTime - ReplicateSeconds);
+	Metrics->OnNetFrame(NetFrameStageSeconds);
+	FMemory::Memzero(NetFrameStageSeconds);
+}
+
+bool UChanneldNetDriver::ShouldReplicateWhileIdle(double Now)
+{
+	if (!bServerIdle)
+	{
+		return true;
+	}
+	// The replicators compare against the last sent state, so the changes in between are sent with the next update.
+	if (Now < NextIdleReplicationTime)
+	{
+		return false;
+	}
+	NextIdleReplicationTime = Now + GetMutableDefault<UChanneldSettings>()->IdleReplicationInterval;
+	return true;
+}
+
+void UChanneldNetDriver::UpdateServerIdle(int32 NumUpdates)
+{
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	if (Settings->IdleServerDelay <= 0)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (NumUpdates > 0)
+	{
+		WakeFromIdle(TEXT("changed channel data"));
+		NothingReplicatedSince = Now;
+		return;
+	}
+	if (NothingReplicatedSince == 0)
+	{
+		NothingReplicatedSince = Now;
+	}
+	if (!bServerIdle && Now - NothingReplicatedSince >= Settings->IdleServerDelay)
+	{
+		bServerIdle = true;
+		NextIdleReplicationTime = Now + Settings->IdleReplicationInterval;
+		LastIdleDispatchTime = Now;
+		UE_LOG(LogChanneld, Log, TEXT("[Server] Nothing replicated in %.1fs, going idle at %d ticks per second"), Now - NothingReplicatedSince, Settings->IdleServerTickRate);
+	}
+}
+
+void UChanneldNetDriver::WakeFromIdle(const TCHAR* Reason)
+{
+	// Count the idle delay again from now, so a single event doesn't put the server back to idle right away.
+	NothingReplicatedSince = 0;
+	if (bServerIdle)
+	{
+		bServerIdle = false;
+		UE_LOG(LogChanneld, Log, TEXT("[Server] Woken up from idle by %s"), Reason);
+	}
+}
+
+void UChanneldNetDriver::HandleIdleWakeMessage(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+{
+	WakeFromIdle(UTF8_TO_TCHAR(Msg->GetDescriptor()->name().c_str()));
 }
 
 void UChanneldNetDriver::OnChanneldAuthenticated(UChanneldConnection* _)
@@ -1100,6 +1864,9 @@ void UChanneldNetDriver::OnChanneldAuthenticated(UChanneldConnection* _)
 	GuidCache->UniqueNetIDs[0] = UniqueNetIdOffset;
 	// Static NetIDs may conflict on the spatial servers, so we need to offset them as well.
 	GuidCache->UniqueNetIDs[1] = UniqueNetIdOffset;
+	DynamicNetIdBlockEnd = UniqueNetIdOffset + (1u << Channeld::ConnectionIdBitOffset);
+	DynamicNetIdBlockMargin = GetMutableDefault<UChanneldSettings>()->DynamicNetIdBlockSize / 4;
+	bDynamicNetIdOverflowReported = false;
 
 	if (ConnToChanneld->IsClient())
 	{
@@ -1107,7 +1874,7 @@ void UChanneldNetDriver::OnChanneldAuthenticated(UChanneldConnection* _)
 		MyServerConnection->RemoteAddr = ConnIdToAddr(ConnToChanneld->GetConnId());
 		MyServerConnection->bChanneldAuthenticated = true;
 
-		if (*LowLevelSendToChannelId != Channeld::InvalidChannelId)
+		if (*LowLevelSendToChannelId != Channeld::InvalidChannelId && !GetMutableDefault<UChanneldSettings>()->bSpectatorMode)
 		{
 			MyServerConnection->FlushUnauthData();
 		}
@@ -1115,7 +1882,159 @@ void UChanneldNetDriver::OnChanneldAuthenticated(UChanneldConnection* _)
 	}
 }
 
+void UChanneldNetDriver::CheckDynamicNetIdBlock()
+{
+	if (DynamicNetIdBlockEnd == 0 || !ConnToChanneld->IsServer())
+	{
+		return;
+	}
+
+	// UniqueNetIDs[0] is pre-incremented, and the NetGUID of the dynamic object is (Index << 1).
+	const uint32 NextIndex = static_cast<uint32>(GuidCache->UniqueNetIDs[0]) + 1;
+	if (NextIndex + DynamicNetIdBlockMargin < DynamicNetIdBlockEnd)
+	{
+		return;
+	}
+
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	if (!Settings->bRecycleDynamicNetIds)
+	{
+		if (NextIndex >= DynamicNetIdBlockEnd && !bDynamicNetIdOverflowReported)
+		{
+			bDynamicNetIdOverflowReported = true;
+			UE_LOG(LogChanneld, Error, TEXT("The dynamic NetGUIDs of the server have run out of the range of connection %d, and may collide with the ones of the next connection. Enable bRecycleDynamicNetIds to reuse the free ones."), ConnToChanneld->GetConnId());
+		}
+		return;
+	}
+
+	const uint32 RangeStart = ConnToChanneld->GetConnId() << Channeld::ConnectionIdBitOffset;
+	const uint32 RangeSize = 1u << Channeld::ConnectionIdBitOffset;
+	// The NetGUIDs still in the cache, plus the ones removed from the cache but alive elsewhere: the objects handed over to or pooled by the
+	// spatial servers, and the entity channels, which take the NetGUIDs as the channel ids.
+	TSet<uint32> UsedNetIds;
+	for (const auto& Pair : GuidCache->ObjectLookup)
+	{
+		UsedNetIds.Add(Pair.Key.Value);
+	}
+	if (ChannelDataView.IsValid())
+	{
+		ChannelDataView->GetNetIdsInUse(UsedNetIds);
+	}
+	for (const auto& Pair : ConnToChanneld->SubscribedChannels)
+	{
+		if (Pair.Key >= Channeld::EntityChannelIdStart)
+		{
+			UsedNetIds.Add(Pair.Key);
+		}
+	}
+	for (const auto& Pair : ConnToChanneld->OwnedChannels)
+	{
+		if (Pair.Key >= Channeld::EntityChannelIdStart)
+		{
+			UsedNetIds.Add(Pair.Key);
+		}
+	}
+
+	// The indices (relative to RangeStart) of the used dynamic NetGUIDs of the range.
+	TArray<uint32> UsedIndices;
+	for (const uint32 NetId : UsedNetIds)
+	{
+		const FNetworkGUID NetGUID(NetId);
+		const uint32 Index = NetId >> 1;
+		if (NetGUID.IsDynamic() && Index >= RangeStart && Index - RangeStart < RangeSize)
+		{
+			UsedIndices.Add(Index - RangeStart);
+		}
+	}
+	UsedIndices.Sort();
+	UsedIndices.Add(RangeSize);
+
+	// The first fit after the current block, then the first fit from the start of the range, so the most recently freed ones are reused last.
+	// Falls back to the largest free block if none is big enough. Index 0 is never assigned, as the first assignment pre-increments it.
+	const uint32 BlockSize = Settings->DynamicNetIdBlockSize;
+	const uint32 From = FMath::Min(DynamicNetIdBlockEnd - RangeStart, RangeSize);
+	uint32 BestStart = 0, BestEnd = 0, LargestStart = 0, LargestEnd = 0;
+	uint32 FreeStart = 1;
+	for (const uint32 UsedIndex : UsedIndices)
+	{
+		if (UsedIndex > FreeStart)
+		{
+			if (UsedIndex - FreeStart > LargestEnd - LargestStart)
+			{
+				LargestStart = FreeStart;
+				LargestEnd = UsedIndex;
+			}
+			const uint32 Start = FMath::Max(FreeStart, From);
+			if (UsedIndex > Start && UsedIndex - Start >= BlockSize && (BestEnd == 0 || BestStart < From))
+			{
+				BestStart = Start;
+				BestEnd = UsedIndex;
+			}
+			else if (UsedIndex - FreeStart >= BlockSize && BestEnd == 0)
+			{
+				BestStart = FreeStart;
+				BestEnd = UsedIndex;
+			}
+		}
+		FreeStart = FMath::Max(FreeStart, UsedIndex + 1);
+	}
+	if (BestEnd == 0)
+	{
+		BestStart = LargestStart;
+		BestEnd = LargestEnd;
+	}
+	if (BestEnd <= BestStart + 1)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("All the %u dynamic NetGUIDs of connection %d are in use"), RangeSize, ConnToChanneld->GetConnId());
+		return;
+	}
+
+	GuidCache->UniqueNetIDs[0] = RangeStart + BestStart - 1;
+	DynamicNetIdBlockEnd = RangeStart + BestEnd;
+	DynamicNetIdBlockMargin = FMath::Min(BlockSize, BestEnd - BestStart) / 4;
+	UE_LOG(LogChanneld, Log, TEXT("Recycling the dynamic NetGUIDs from index %u to %u of connection %d, %d in use"), BestStart, BestEnd, ConnToChanneld->GetConnId(), UsedIndices.Num() - 1);
+}
+
+void UChanneldNetDriver::OnChanneldConnectFailed(UChanneldConnection* _, const FString& Reason)
+{
+	if (GEngine && GetWorld())
+	{
+		GEngine->BroadcastNetworkFailure(GetWorld(), this, ENetworkFailure::ConnectionTimeout, FString::Printf(TEXT("Failed to connect to channeld: %s"), *Reason));
+	}
+}
+
 // Triggered by UWorld::DestroyActor, for replicated actors only.
+void UChanneldNetDriver::FlushActorDormancy(AActor* Actor, bool bWasDormInitial)
+{
+	Super::FlushActorDormancy(Actor, bWasDormInitial);
+
+	if (GetMutableDefault<UChanneldSettings>()->bSkipCustomReplication || !IsServer())
+	{
+		return;
+	}
+
+	if (UChanneldReplicationComponent* RepComp = UChanneldReplicationComponent::FindForActor(Actor))
+	{
+		RepComp->FlushDormancy();
+	}
+}
+
+void UChanneldNetDriver::NotifyActorDormancyChange(AActor* Actor, ENetDormancy OldDormancyState)
+{
+	Super::NotifyActorDormancyChange(Actor, OldDormancyState);
+
+	if (GetMutableDefault<UChanneldSettings>()->bSkipCustomReplication || !IsServer())
+	{
+		return;
+	}
+
+	// Send the changes made while dormant when the actor wakes up, or its last state when it goes dormant.
+	if (UChanneldReplicationComponent* RepComp = UChanneldReplicationComponent::FindForActor(Actor))
+	{
+		RepComp->FlushDormancy();
+	}
+}
+
 void UChanneldNetDriver::NotifyActorDestroyed(AActor* Actor, bool IsSeamlessTravel)
 {
 	if (GetMutableDefault<UChanneldSettings>()->bSkipCustomReplication)
@@ -1131,6 +2050,12 @@ void UChanneldNetDriver::NotifyActorDestroyed(AActor* Actor, bool IsSeamlessTrav
 	}
 
 	FNetworkGUID NetId = GuidCache->GetNetGUID(Actor);
+	if (NetId.IsValid())
+	{
+		// The NetGUID can be recycled for another object.
+		ObjRefCache.Remove(NetId.Value);
+		ResolvedObjCache.Remove(NetId.Value);
+	}
 	if (NetId.IsValid() && ChannelDataView.IsValid())
 	{
 		// Only authoritative server should send destroy to clients
@@ -1145,6 +2070,10 @@ void UChanneldNetDriver::NotifyActorDestroyed(AActor* Actor, bool IsSeamlessTrav
 	{
 		// UE_LOG(LogChanneld, Warning, TEXT("ChannelDataView failed to handle the destroy of %s, netId: %d"), *GetNameSafe(Actor), NetId.Value);
 	}
+	if (NetId.IsValid())
+	{
+		ReleaseSpawnTrackingIndex(NetId);
+	}
 	
 	//~ Begin copy of UNetDriver::NotifyActorDestroyed
 	if (ServerConnection)
@@ -3,8 +3,10 @@
 #include "CoreMinimal.h"
 #include "ChanneldTypes.h"
 #include "ChanneldConnection.h"
+#include "ChanneldMetrics.h"
 #include "ChannelDataInterfaces.h"
 #include "ChanneldNetConnection.h"
+#include "ChanneldObjRefCache.h"
 #include "Engine/NetDriver.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
@@ -57,6 +59,8 @@ public:
 	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
 	virtual void ProcessRemoteFunction(class AActor* Actor, class UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, struct FFrame* Stack, class UObject* SubObject = nullptr) override;
 	virtual void NotifyActorDestroyed(AActor* Actor, bool IsSeamlessTravel) override;
+	virtual void FlushActorDormancy(AActor* Actor, bool bWasDormInitial = false) override;
+	virtual void NotifyActorDormancyChange(AActor* Actor, ENetDormancy OldDormancyState) override;
 	//~ End UNetDriver Interface
 	
 	UChanneldNetConnection* AddChanneldClientConnection(Channeld::ConnectionId ClientConnId, Channeld::ChannelId ChId);
@@ -76,6 +80,10 @@ public:
 
 	UChanneldNetConnection* GetClientConnection(Channeld::ConnectionId ConnId) const
 	{
+		if (ConnId < static_cast<uint32>(ClientConnectionsByConnId.Num()))
+		{
+			return ClientConnectionsByConnId[ConnId];
+		}
 		return ClientConnectionMap.FindRef(ConnId);
 	}
 
@@ -86,6 +94,12 @@ public:
 	// Update the PackageMap of all connections that the specified NetId has been sent, so it's safe to send the actor's RPC message.
 	void SetAllSentSpawn(const FNetworkGUID NetId);
 
+	// The dense index of the NetId in the spawn-tracking bitsets of the client connections (see UChanneldNetConnection::HasSentSpawn()).
+	// Assigned on the first call, and recycled when the actor is destroyed.
+	int32 GetSpawnTrackingIndex(const FNetworkGUID NetId);
+	FORCEINLINE const int32* FindSpawnTrackingIndex(const FNetworkGUID NetId) const { return SpawnTrackingIndices.Find(NetId); }
+	void ReleaseSpawnTrackingIndex(const FNetworkGUID NetId);
+
 	// Returns false if the RPC should not be redirected and should be handled locally.
 	bool RedirectRPC(TSharedPtr<unrealpb::RemoteFunctionMessage> Msg);
 
@@ -96,6 +110,13 @@ public:
 	TWeakObjectPtr<UChannelDataView> ChannelDataView;
 	void OnServerSpawnedActor(AActor* Actor);
 
+	// The full-exported UnrealObjectRefs of the objects in the world of the NetDriver. See ChanneldUtils::GetRefOfObject().
+	FChanneldObjRefCache ObjRefCache;
+	// [Client] The objects resolved from the received UnrealObjectRefs. See ChanneldUtils::GetObjectByRef().
+	FChanneldResolvedObjCache ResolvedObjCache;
+	// The virtual connection of the view for exporting the spawned objects. See ChanneldUtils::InitNetConnForSpawn().
+	TWeakObjectPtr<UChanneldNetConnection> NetConnForSpawn;
+
 protected:
 	TSharedRef<Channeld::ChannelId> LowLevelSendToChannelId = MakeShared<Channeld::ChannelId>(Channeld::InvalidChannelId);
 
@@ -116,21 +137,129 @@ private:
 
 	UPROPERTY()
 	TMap<uint32, UChanneldNetConnection*> ClientConnectionMap;
+	// The same connections as ClientConnectionMap, indexed by the ConnectionId (less than 2^MaxConnectionIdBits) for the per-packet lookups.
+	// ClientConnectionMap holds the references for the GC.
+	TArray<UChanneldNetConnection*> ClientConnectionsByConnId;
+
+	// See GetSpawnTrackingIndex().
+	TMap<FNetworkGUID, int32> SpawnTrackingIndices;
+	TArray<int32> FreeSpawnTrackingIndices;
+
+	// The RPC functions resolved by ReceivedRPC(), by the class of the target object and the function name, so the class hierarchy is not searched for every RPC.
+	TMap<TPair<const UClass*, FName>, TWeakObjectPtr<UFunction>> RPCFunctionCache;
+	UFunction* FindRPCFunction(UObject* Obj, const FName& FunctionName);
 
-	// RPCs queued on the callee's side that dont' have the actor resolved yet.
-	TArray<TSharedPtr<unrealpb::RemoteFunctionMessage>> UnprocessedRPCs;
+	struct FUnprocessedRPC
+	{
+		TSharedPtr<unrealpb::RemoteFunctionMessage> Msg;
+		int32 NumRetries;
+	};
+	// RPCs queued on the callee's side that dont' have the actor resolved yet. Retried every tick. See UChanneldSettings::MaxDeferredRPCRetries.
+	TArray<FUnprocessedRPC> UnprocessedRPCs;
+	// Swapped with UnprocessedRPCs in TickDispatch(), so retrying the RPCs doesn't shift the queue.
+	TArray<FUnprocessedRPC> RetryingRPCs;
+
+	struct FHandoverMoveBuffer
+	{
+		double StartTime;
+		TArray<TSharedPtr<unrealpb::RemoteFunctionMessage>> Moves;
+	};
+	// [Server] The ServerMovePacked RPCs (or all the RPCs, see UChanneldSettings::bHoldAllRPCsDuringHandover) held during the handover
+	// of the actor, by NetId. See UChanneldSettings::HandoverMoveBufferMs.
+	TMap<uint32, FHandoverMoveBuffer> HandoverMoveBuffers;
+	bool bFlushingHandoverMoves = false;
+	// Returns true if the RPC is held until the handover of the target actor is done.
+	bool BufferHandoverMove(TSharedPtr<unrealpb::RemoteFunctionMessage> Msg, AActor* Actor);
+	// Handle the held moves of the characters whose handover is done, or that have waited for too long, in the order they were received.
+	void FlushHandoverMoveBuffers();
+
+	struct FQueuedUnreliableRPC
+	{
+		TWeakObjectPtr<AActor> Actor;
+		UFunction* Function;
+		FString FuncName;
+		TSharedPtr<google::protobuf::Message> ParamsMsg;
+		FString SubObjectPathName;
+	};
+	// [Client] The spawn messages waiting for the time budget. See UChanneldSettings::ClientSpawnTimeBudgetMs.
+	TArray<TSharedRef<unrealpb::SpawnObjectMessage>> PendingSpawnMsgs;
+	// [Client] The spawned actors waiting for PostNetInit(). See UChanneldSettings::bClientDeferBeginPlay.
+	TArray<TWeakObjectPtr<AActor>> PendingPostNetInitActors;
+	// [Client] The spawn messages waiting for the packages of their classes to load, by the package name. See UChanneldSettings::bAsyncLoadSpawnClasses.
+	TMap<FName, TArray<TSharedRef<unrealpb::SpawnObjectMessage>>> AsyncLoadingSpawnMsgs;
+
+	// The unreliable RPCs called in this frame, sent in TickFlush(). See UChanneldSettings::bBatchUnreliableRPCs.
+	TArray<FQueuedUnreliableRPC> QueuedUnreliableRPCs;
+	// The index in QueuedUnreliableRPCs by the target object and the function, for the functions with FChanneldUnreliableRPCLimit::bLatestWins.
+	TMap<TPair<const UObject*, const UFunction*>, int32> LatestUnreliableRPCIndices;
+	// The earliest time the function can be called again on the target object. See FChanneldUnreliableRPCLimit::MaxCallsPerSecond.
+	// Keyed by the weak pointers, so a new object allocated at the address of a destroyed one is not throttled. Pruned in each TickFlush().
+	TMap<TPair<TWeakObjectPtr<const UObject>, TWeakObjectPtr<const UFunction>>, double> UnreliableRPCNextAllowedTimes;
 
 	TSet<FNetworkGUID> SentSpawnedNetGUIDs;
 
+	// The seconds spent in each EChanneldNetFrameStage in this frame, reported to UChanneldMetrics at the end of TickFlush().
+	double NetFrameStageSeconds[static_cast<int32>(EChanneldNetFrameStage::Max)] = {};
+
 	// Actors that spawned in server using SpawnActorDeferred (mainly in Blueprints), which don't have ActorComponent registered.
 	// We need to skip these actors in OnServerSpawnedActor(), and actually handle them in their BeginPlay().
 	TSet<TWeakObjectPtr<AActor>> ServerDeferredSpawns;
 
+	// [Server] The end (exclusive) of the block of the dynamic NetGUID indices that GuidCache->UniqueNetIDs[0] assigns from, and the number
+	// of the indices left in the block to look for the next one. See UChanneldSettings::bRecycleDynamicNetIds.
+	uint32 DynamicNetIdBlockEnd = 0;
+	uint32 DynamicNetIdBlockMargin = 0;
+	bool bDynamicNetIdOverflowReported = false;
+	// [Server] Move UniqueNetIDs[0] to the next free block of the range of the ConnectionId when the current block is running out.
+	void CheckDynamicNetIdBlock();
+
+	// [Server] See UChanneldSettings::IdleServerDelay.
+	bool bServerIdle = false;
+	// Since when the server has had nothing to replicate. 0 if it's not known yet.
+	double NothingReplicatedSince = 0;
+	double NextIdleReplicationTime = 0;
+	// When the last idle TickDispatch() finished waiting, for the frame time of UChanneldSettings::IdleServerTickRate.
+	double LastIdleDispatchTime = 0;
+	// Returns false if the idle server skips sending the channel data updates in this frame.
+	bool ShouldReplicateWhileIdle(double Now);
+	// Go idle if nothing has been replicated for UChanneldSettings::IdleServerDelay, or wake up if anything is.
+	void UpdateServerIdle(int32 NumUpdates);
+	void WakeFromIdle(const TCHAR* Reason);
+	// Wakes the idle server up on the subscriptions to its channels and the handovers.
+	void HandleIdleWakeMessage(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
+
 	void OnChanneldAuthenticated(UChanneldConnection* Conn);
+	void OnChanneldConnectFailed(UChanneldConnection* Conn, const FString& Reason);
 	void OnUserSpaceMessageReceived(uint32 MsgType, Channeld::ChannelId ChId, Channeld::ConnectionId ClientConnId, const std::string& Payload);
 	void OnReceivedRPC(const unrealpb::RemoteFunctionMessage& RpcMsg);
+	// Send the serialized RPC via channeld. Returns false if the RPC can't be sent.
+	bool SendRPC(AActor* Actor, UFunction* Function, const FString& FuncName, TSharedPtr<google::protobuf::Message> ParamsMsg, const FString& SubObjectPathName);
+	// Apply UChanneldSettings::UnreliableRPCLimits and queue the RPC if UChanneldSettings::bBatchUnreliableRPCs is set. Returns false if the RPC should be sent now.
+	bool QueueUnreliableRPC(AActor* Actor, UObject* TargetObject, UFunction* Function, const FString& FuncName, TSharedPtr<google::protobuf::Message> ParamsMsg, const FString& SubObjectPathName);
+	void FlushUnreliableRPCs();
+	// Remove the entries of UnreliableRPCNextAllowedTimes that no longer limit anything.
+	void PruneUnreliableRPCLimits();
+	// [Server] Evaluate the spatial interest of all the client connections in one pass and send the changed queries.
+	void TickClientInterests(float DeltaSeconds);
+	// The fast path of ServerMovePacked and ClientMoveResponsePacked. Returns false if the RPC should go the normal way.
+	bool SendPackedMoveRPC(AActor* Actor, const FName& FuncFName, const FString& FuncName, void* Parameters);
+	// The bits written by the native path to all the connections, for the cost of the native RPC fallbacks.
+	int64 GetNativeSendBits() const;
 	void HandleSpawnObject(TSharedRef<unrealpb::SpawnObjectMessage> SpawnMsg);
-	void HandleCustomRPC(TSharedPtr<unrealpb::RemoteFunctionMessage> Msg);
+	void HandleDestroyObject(const unrealpb::DestroyObjectMessage& DestroyMsg);
+	// [Client] Start loading the package of the spawned class if it's not loaded. Returns true if the spawn waits for the load.
+	// See UChanneldSettings::bAsyncLoadSpawnClasses.
+	bool TryAsyncLoadSpawnClass(TSharedRef<unrealpb::SpawnObjectMessage> SpawnMsg);
+	void OnSpawnClassPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+	// [Client] Run the deferred PostNetInit() of the spawned actors, then spawn the queued objects nearest to the local player first,
+	// until UChanneldSettings::ClientSpawnTimeBudgetMs is used up.
+	void SpawnPendingObjects();
+	// [Client] Switch the simulated proxy characters to the interpolation by the distance and the visibility. See UChanneldSettings::SimulatedProxyCullDistance.
+	void CullSimulatedProxies();
+	double NextProxyCullTime = 0;
+	void HandleCustomRPC(TSharedPtr<unrealpb::RemoteFunctionMessage> Msg, int32 NumRetries = 0);
+	// Queue the RPC to be retried in the next tick, or drop it if it has used up the retries.
+	void DeferRPC(TSharedPtr<unrealpb::RemoteFunctionMessage> Msg, int32 NumRetries);
 	void OnClientPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer);
 
 	UChanneldGameInstanceSubsystem* GetSubsystem() const;
@@ -0,0 +1,167 @@
+#include "ChanneldObjRefCache.h"
+#include "ChanneldTypes.h"
+#include "Components/ActorComponent.h"
+
+void FChanneldObjRefCache::Init(int32 InMaxNum)
+{
+	Reset();
+	MaxNum = FMath::Max(InMaxNum, 0);
+}
+
+void FChanneldObjRefCache::Reset()
+{
+	Entries.Reset();
+	AllocatedSize = 0;
+}
+
+TSharedPtr<unrealpb::UnrealObjectRef> FChanneldObjRefCache::Find(uint32 NetGUID, const UObject* Obj)
+{
+	FEntry* Entry = Entries.Find(NetGUID);
+	if (Entry == nullptr)
+	{
+		return nullptr;
+	}
+	if (Entry->Object.Get() != Obj)
+	{
+		UE_LOG(LogChanneld, Verbose, TEXT("Dropped the stale ObjRef: %d"), NetGUID);
+		Remove(NetGUID);
+		return nullptr;
+	}
+	Entry->LastUsed = ++UseCounter;
+	return Entry->Ref;
+}
+
+void FChanneldObjRefCache::Add(uint32 NetGUID, const UObject* Obj, const TSharedRef<unrealpb::UnrealObjectRef>& Ref)
+{
+	if (MaxNum == 0 || Obj == nullptr)
+	{
+		return;
+	}
+
+	Remove(NetGUID);
+	if (Entries.Num() >= MaxNum)
+	{
+		Evict();
+	}
+	const int64 Size = Ref->SpaceUsedLong() + sizeof(FEntry);
+	Entries.Add(NetGUID, FEntry{Ref, FWeakObjectPtr(Obj), Size, ++UseCounter});
+	AllocatedSize += Size;
+}
+
+void FChanneldObjRefCache::Remove(uint32 NetGUID)
+{
+	FEntry Entry;
+	if (Entries.RemoveAndCopyValue(NetGUID, Entry))
+	{
+		AllocatedSize -= Entry.Size;
+	}
+}
+
+void FChanneldObjRefCache::Evict()
+{
+	TArray<uint64> UseTimes;
+	UseTimes.Reserve(Entries.Num());
+	for (const auto& Pair : Entries)
+	{
+		UseTimes.Add(Pair.Value.LastUsed);
+	}
+	UseTimes.Sort();
+	const uint64 Threshold = UseTimes[FMath::Max(UseTimes.Num() / 4, 1) - 1];
+
+	for (auto Itr = Entries.CreateIterator(); Itr; ++Itr)
+	{
+		if (Itr.Value().LastUsed <= Threshold)
+		{
+			AllocatedSize -= Itr.Value().Size;
+			Itr.RemoveCurrent();
+		}
+	}
+	UE_LOG(LogChanneld, Verbose, TEXT("Evicted the ObjRef cache, %d left"), Entries.Num());
+}
+
+void FChanneldResolvedObjCache::Reset()
+{
+	Entries.Reset();
+	NextRemoveStaleNum = 1024;
+}
+
+UObject* FChanneldResolvedObjCache::Find(uint32 NetGUID)
+{
+	FEntry* Entry = Entries.Find(NetGUID);
+	if (Entry == nullptr)
+	{
+		return nullptr;
+	}
+	UObject* Obj = Entry->Object.Get();
+	if (Obj == nullptr)
+	{
+		Entries.Remove(NetGUID);
+	}
+	return Obj;
+}
+
+void FChanneldResolvedObjCache::Add(uint32 NetGUID, UObject* Obj)
+{
+	if (Obj == nullptr)
+	{
+		return;
+	}
+	if (Entries.Num() >= NextRemoveStaleNum)
+	{
+		RemoveStale();
+	}
+	FEntry& Entry = Entries.FindOrAdd(NetGUID);
+	if (Entry.Object.Get() != Obj)
+	{
+		Entry.Object = Obj;
+		Entry.Components.Reset();
+	}
+}
+
+UActorComponent* FChanneldResolvedObjCache::FindComponent(uint32 OwnerNetGUID, FName CompName)
+{
+	FEntry* Entry = Entries.Find(OwnerNetGUID);
+	if (Entry == nullptr || !Entry->Object.IsValid())
+	{
+		return nullptr;
+	}
+	for (const auto& Pair : Entry->Components)
+	{
+		if (Pair.Key == CompName)
+		{
+			return Cast<UActorComponent>(Pair.Value.Get());
+		}
+	}
+	return nullptr;
+}
+
+void FChanneldResolvedObjCache::AddComponent(uint32 OwnerNetGUID, FName CompName, UActorComponent* Comp)
+{
+	FEntry* Entry = Entries.Find(OwnerNetGUID);
+	if (Entry == nullptr || Comp == nullptr)
+	{
+		return;
+	}
+	for (auto& Pair : Entry->Components)
+	{
+		if (Pair.Key == CompName)
+		{
+			Pair.Value = Comp;
+			return;
+		}
+	}
+	Entry->Components.Emplace(CompName, FWeakObjectPtr(Comp));
+}
+
+void FChanneldResolvedObjCache::RemoveStale()
+{
+	for (auto Itr = Entries.CreateIterator(); Itr; ++Itr)
+	{
+		if (!Itr.Value().Object.IsValid())
+		{
+			Itr.RemoveCurrent();
+		}
+	}
+	NextRemoveStaleNum = FMath::Max(Entries.Num() * 2, 1024);
+	UE_LOG(LogChanneld, Verbose, TEXT("Removed the stale objects from the resolved object cache, %d left"), Entries.Num());
+}
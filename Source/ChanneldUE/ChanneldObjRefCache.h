@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "unreal_common.pb.h"
+
+class UActorComponent;
+
+/**
+ * The full-exported UnrealObjectRefs by NetGUID. Owned by UChanneldNetDriver, so the worlds in PIE or a multi-world server
+ * don't share the refs. The least recently used refs are evicted when the cache is full (see UChanneldSettings::MaxObjRefCacheSize).
+ */
+class CHANNELDUE_API FChanneldObjRefCache
+{
+public:
+	// 0 disables the cache.
+	void Init(int32 InMaxNum);
+	void Reset();
+
+	// Returns nullptr if the NetGUID is not cached, or the cached ref is of another object, e.g. the NetGUID has been recycled.
+	TSharedPtr<unrealpb::UnrealObjectRef> Find(uint32 NetGUID, const UObject* Obj);
+	FORCEINLINE bool Contains(uint32 NetGUID, const UObject* Obj) { return Find(NetGUID, Obj).IsValid(); }
+	void Add(uint32 NetGUID, const UObject* Obj, const TSharedRef<unrealpb::UnrealObjectRef>& Ref);
+	// Call it when the object is destroyed or handed over, as the context or the owning connection of the ref may have changed.
+	void Remove(uint32 NetGUID);
+
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+	// The approximate bytes of the cached refs.
+	FORCEINLINE int64 GetAllocatedSize() const { return AllocatedSize; }
+
+private:
+	struct FEntry
+	{
+		TSharedPtr<unrealpb::UnrealObjectRef> Ref;
+		// The weak pointer has the serial number of the object, so it doesn't match a new object at the same address.
+		FWeakObjectPtr Object;
+		int64 Size;
+		uint64 LastUsed;
+	};
+
+	// Evict the least recently used quarter of the entries, so the eviction doesn't sort the entries on every add.
+	void Evict();
+
+	TMap<uint32, FEntry> Entries;
+	int32 MaxNum = 0;
+	uint64 UseCounter = 0;
+	int64 AllocatedSize = 0;
+};
+
+/**
+ * [Client] The objects resolved from the NetGUIDs of the received UnrealObjectRefs, and the components resolved from the ActorComponentRefs,
+ * so the refs repeated in every update (e.g. the owner, the attach parent, the pawn and the player state) resolve with a single probe instead
+ * of going through the GuidCache and the components of the actor. The weak pointers don't match the destroyed objects, and the destroyed actors
+ * are removed by UChanneldNetDriver right away. Owned by UChanneldNetDriver, like FChanneldObjRefCache. See UChanneldSettings::bCacheResolvedObjRefs.
+ */
+class CHANNELDUE_API FChanneldResolvedObjCache
+{
+public:
+	void Reset();
+
+	// Returns nullptr if the NetGUID is not cached, or the cached object is gone.
+	UObject* Find(uint32 NetGUID);
+	void Add(uint32 NetGUID, UObject* Obj);
+	// Returns nullptr if the component or its owner is not cached, or either of them is gone.
+	UActorComponent* FindComponent(uint32 OwnerNetGUID, FName CompName);
+	// The owner should be added first.
+	void AddComponent(uint32 OwnerNetGUID, FName CompName, UActorComponent* Comp);
+	// Also removes the components of the object.
+	FORCEINLINE void Remove(uint32 NetGUID) { Entries.Remove(NetGUID); }
+
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+
+private:
+	struct FEntry
+	{
+		FWeakObjectPtr Object;
+		TArray<TPair<FName, FWeakObjectPtr>, TInlineAllocator<2>> Components;
+	};
+
+	// Drop the entries of the gone objects, which are not destroyed as actors (e.g. the objects created from the class path).
+	void RemoveStale();
+
+	TMap<uint32, FEntry> Entries;
+	// RemoveStale() runs when the cache grows to this size, so it's amortized over the adds.
+	int32 NextRemoveStaleNum = 1024;
+};
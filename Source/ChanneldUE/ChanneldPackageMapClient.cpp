@@ -0,0 +1,51 @@
+#include "ChanneldPackageMapClient.h"
+
+template<typename PredicateType>
+void UChanneldPackageMapClient::ForEachOuterGUID(const UObject* Obj, PredicateType Predicate) const
+{
+	if (Obj == nullptr)
+	{
+		return;
+	}
+
+	FNetworkGUID NetGUID = GuidCache->GetNetGUID(Obj);
+	while (NetGUID.IsValid())
+	{
+		Predicate(NetGUID);
+		const FNetGuidCacheObject* CacheObject = GuidCache->GetCacheObject(NetGUID);
+		if (CacheObject == nullptr || CacheObject->OuterGUID == NetGUID)
+		{
+			break;
+		}
+		NetGUID = CacheObject->OuterGUID;
+	}
+}
+
+bool UChanneldPackageMapClient::SerializeObject(FArchive& Ar, UClass* InClass, UObject*& Obj, FNetworkGUID* OutNetGUID)
+{
+	if (ExportRecorder == nullptr || !Ar.IsSaving())
+	{
+		return Super::SerializeObject(Ar, InClass, Obj, OutNetGUID);
+	}
+
+	// The NetGUIDs that have been exported before the call. The ones assigned during the call are not known yet.
+	TArray<FNetworkGUID, TInlineAllocator<8>> ExportedGUIDs;
+	ForEachOuterGUID(Obj, [this, &ExportedGUIDs](const FNetworkGUID& NetGUID)
+	{
+		if (NetGUIDExportCountMap.Contains(NetGUID))
+		{
+			ExportedGUIDs.Add(NetGUID);
+		}
+	});
+
+	const bool bResult = Super::SerializeObject(Ar, InClass, Obj, OutNetGUID);
+
+	ForEachOuterGUID(Obj, [this, &ExportedGUIDs](const FNetworkGUID& NetGUID)
+	{
+		if (!ExportedGUIDs.Contains(NetGUID) && NetGUIDExportCountMap.Contains(NetGUID))
+		{
+			ExportRecorder->AddUnique(NetGUID);
+		}
+	});
+	return bResult;
+}
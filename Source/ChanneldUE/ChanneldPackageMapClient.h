@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/PackageMapClient.h"
+#include "ChanneldPackageMapClient.generated.h"
+
+/**
+ * The package map of UChanneldNetConnection. Records the NetGUIDs exported for the first time while serializing a new actor,
+ * so ChanneldUtils::GetRefOfObject() doesn't have to diff the whole NetGUIDExportCountMap, which grows with the session.
+ */
+UCLASS(transient)
+class CHANNELDUE_API UChanneldPackageMapClient : public UPackageMapClient
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool SerializeObject(FArchive& Ar, UClass* InClass, UObject*& Obj, FNetworkGUID* OutNetGUID = nullptr) override;
+
+	// Start adding the newly exported NetGUIDs to OutNewGUIDs, until EndExportRecording() is called.
+	FORCEINLINE void BeginExportRecording(TArray<FNetworkGUID>& OutNewGUIDs) { ExportRecorder = &OutNewGUIDs; }
+	FORCEINLINE void EndExportRecording() { ExportRecorder = nullptr; }
+
+private:
+	// Only the object and its outers can be exported by SerializeObject().
+	template<typename PredicateType>
+	void ForEachOuterGUID(const UObject* Obj, PredicateType Predicate) const;
+
+	TArray<FNetworkGUID>* ExportRecorder = nullptr;
+};
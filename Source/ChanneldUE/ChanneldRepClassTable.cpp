@@ -0,0 +1,273 @@
+#include "ChanneldRepClassTable.h"
+#include "ChanneldTypes.h"
+#include "Async/MappedFileHandle.h"
+#include "Hash/CityHash.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static_assert(sizeof(FChanneldRepClassTable::FHeader) == 24, "The layout of FHeader is part of the file format");
+static_assert(sizeof(FChanneldRepClassTable::FEntry) == 24, "The layout of FEntry is part of the file format");
+
+FChanneldRepClassTable::~FChanneldRepClassTable()
+{
+	Reset();
+}
+
+const FChanneldRepClassTable& FChanneldRepClassTable::Get()
+{
+	static FChanneldRepClassTable Table;
+	static bool bLoaded = false;
+	if (!bLoaded)
+	{
+		bLoaded = true;
+		Table.Load();
+	}
+	return Table;
+}
+
+FString FChanneldRepClassTable::GetFilePath()
+{
+	return FPaths::ProjectContentDir() / TEXT("Channeld/RepClassTable.bin");
+}
+
+uint64 FChanneldRepClassTable::HashPath(const FString& PathName)
+{
+	const FTCHARToUTF8 Utf8Path(*PathName);
+	return CityHash64(reinterpret_cast<const char*>(Utf8Path.Get()), Utf8Path.Length());
+}
+
+bool FChanneldRepClassTable::Save(const TArray<FClassInfo>& Classes, const FString& FilePath)
+{
+	// The replicator ids follow the order of the names, and the entries follow the order of the hashes.
+	TArray<const FClassInfo*> SortedByName;
+	for (const FClassInfo& ClassInfo : Classes)
+	{
+		SortedByName.Add(&ClassInfo);
+	}
+	SortedByName.Sort([](const FClassInfo& Lhs, const FClassInfo& Rhs) { return Lhs.PathName < Rhs.PathName; });
+
+	TArray<TPair<uint64, int32>> HashAndIds;
+	HashAndIds.Reserve(SortedByName.Num());
+	for (int32 i = 0; i < SortedByName.Num(); i++)
+	{
+		HashAndIds.Add(MakeTuple(HashPath(SortedByName[i]->PathName), i));
+	}
+	HashAndIds.Sort([](const TPair<uint64, int32>& Lhs, const TPair<uint64, int32>& Rhs) { return Lhs.Key < Rhs.Key; });
+
+	TMap<FString, int32> IndexByPath;
+	for (int32 i = 0; i < HashAndIds.Num(); i++)
+	{
+		if (i > 0 && HashAndIds[i].Key == HashAndIds[i - 1].Key)
+		{
+			UE_LOG(LogChanneld, Error, TEXT("Hash collision of the class paths: %s and %s"), *SortedByName[HashAndIds[i].Value]->PathName, *SortedByName[HashAndIds[i - 1].Value]->PathName);
+			return false;
+		}
+		IndexByPath.Add(SortedByName[HashAndIds[i].Value]->PathName, i);
+	}
+
+	TArray<FEntry> Entries;
+	TArray<ANSICHAR> Strings;
+	Entries.SetNumZeroed(HashAndIds.Num());
+	for (int32 i = 0; i < HashAndIds.Num(); i++)
+	{
+		const FClassInfo& ClassInfo = *SortedByName[HashAndIds[i].Value];
+		const FTCHARToUTF8 Utf8Path(*ClassInfo.PathName);
+		if (Utf8Path.Length() > MAX_uint16)
+		{
+			UE_LOG(LogChanneld, Error, TEXT("The class path is too long: %s"), *ClassInfo.PathName);
+			return false;
+		}
+
+		FEntry& Entry = Entries[i];
+		Entry.PathHash = HashAndIds[i].Key;
+		const int32* ParentIndex = IndexByPath.Find(ClassInfo.ParentPathName);
+		Entry.ParentIndex = ParentIndex ? *ParentIndex : INDEX_NONE;
+		Entry.ReplicatorId = HashAndIds[i].Value;
+		Entry.PathOffset = Strings.Num();
+		Entry.PathLength = Utf8Path.Length();
+		Entry.Flags = ClassInfo.Flags;
+		Strings.Append(reinterpret_cast<const ANSICHAR*>(Utf8Path.Get()), Utf8Path.Length());
+	}
+
+	FHeader Header;
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.NumClasses = Entries.Num();
+	Header.StringsOffset = sizeof(FHeader) + Entries.Num() * sizeof(FEntry);
+	Header.StringsSize = Strings.Num();
+	Header.Reserved = 0;
+
+	TArray<uint8> Bytes;
+	Bytes.Reserve(Header.StringsOffset + Header.StringsSize);
+	Bytes.Append(reinterpret_cast<const uint8*>(&Header), sizeof(FHeader));
+	Bytes.Append(reinterpret_cast<const uint8*>(Entries.GetData()), Entries.Num() * sizeof(FEntry));
+	Bytes.Append(reinterpret_cast<const uint8*>(Strings.GetData()), Strings.Num());
+	if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to save the replicated class table: %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogChanneld, Log, TEXT("Saved %d replicated classes to %s"), Entries.Num(), *FilePath);
+	return true;
+}
+
+bool FChanneldRepClassTable::Load(const FString& FilePath)
+{
+	Reset();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*FilePath))
+	{
+		UE_LOG(LogChanneld, Verbose, TEXT("No replicated class table: %s"), *FilePath);
+		return false;
+	}
+
+	MappedHandle = PlatformFile.OpenMapped(*FilePath);
+	if (MappedHandle != nullptr)
+	{
+		MappedRegion = MappedHandle->MapRegion(0, MappedHandle->GetFileSize());
+	}
+	bool bParsed;
+	if (MappedRegion != nullptr)
+	{
+		bParsed = Parse(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize(), FilePath);
+	}
+	else
+	{
+		bParsed = FFileHelper::LoadFileToArray(LoadedBytes, *FilePath) && Parse(LoadedBytes.GetData(), LoadedBytes.Num(), FilePath);
+	}
+
+	if (!bParsed)
+	{
+		Reset();
+		return false;
+	}
+	UE_LOG(LogChanneld, Log, TEXT("Loaded %d replicated classes from %s (mapped: %d)"), NumEntries, *FilePath, MappedRegion != nullptr);
+	return true;
+}
+
+bool FChanneldRepClassTable::Parse(const uint8* Data, int64 Size, const FString& FilePath)
+{
+	if (Size < static_cast<int64>(sizeof(FHeader)))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Invalid replicated class table: %s"), *FilePath);
+		return false;
+	}
+	const FHeader* Header = reinterpret_cast<const FHeader*>(Data);
+	if (Header->Magic != Magic || Header->Version != Version)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("The replicated class table is of version %u, expected %u: %s"), Header->Version, Version, *FilePath);
+		return false;
+	}
+	const int64 EntriesEnd = sizeof(FHeader) + static_cast<int64>(Header->NumClasses) * sizeof(FEntry);
+	if (Header->NumClasses > MAX_int32 || EntriesEnd > Header->StringsOffset || static_cast<int64>(Header->StringsOffset) + Header->StringsSize > Size)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Invalid replicated class table: %s"), *FilePath);
+		return false;
+	}
+
+	const FEntry* ParsedEntries = reinterpret_cast<const FEntry*>(Data + sizeof(FHeader));
+	const int32 NumClasses = Header->NumClasses;
+	for (int32 i = 0; i < NumClasses; i++)
+	{
+		const FEntry& Entry = ParsedEntries[i];
+		if (static_cast<int64>(Entry.PathOffset) + Entry.PathLength > Header->StringsSize || Entry.ParentIndex < INDEX_NONE || Entry.ParentIndex >= NumClasses)
+		{
+			UE_LOG(LogChanneld, Error, TEXT("Invalid entry %d of the replicated class table: %s"), i, *FilePath);
+			return false;
+		}
+	}
+
+	Entries = ParsedEntries;
+	NumEntries = NumClasses;
+	Strings = reinterpret_cast<const ANSICHAR*>(Data + Header->StringsOffset);
+	return true;
+}
+
+void FChanneldRepClassTable::Reset()
+{
+	Entries = nullptr;
+	NumEntries = 0;
+	Strings = nullptr;
+	delete MappedRegion;
+	MappedRegion = nullptr;
+	delete MappedHandle;
+	MappedHandle = nullptr;
+	LoadedBytes.Empty();
+}
+
+FString FChanneldRepClassTable::GetPathName(int32 Index) const
+{
+	const FEntry& Entry = GetEntry(Index);
+	const FUTF8ToTCHAR PathName(Strings + Entry.PathOffset, Entry.PathLength);
+	return FString(PathName.Length(), PathName.Get());
+}
+
+int32 FChanneldRepClassTable::FindClass(const FString& PathName) const
+{
+	const int32 Index = FindClassByHash(HashPath(PathName));
+	if (Index == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+	// Make sure it's not a hash collision with a class that's not in the table.
+	const FTCHARToUTF8 Utf8Path(*PathName);
+	const FEntry& Entry = Entries[Index];
+	if (Entry.PathLength != Utf8Path.Length() || FMemory::Memcmp(Strings + Entry.PathOffset, Utf8Path.Get(), Entry.PathLength) != 0)
+	{
+		return INDEX_NONE;
+	}
+	return Index;
+}
+
+int32 FChanneldRepClassTable::FindClassByHash(uint64 PathHash) const
+{
+	if (!IsLoaded())
+	{
+		return INDEX_NONE;
+	}
+
+	int32 Low = 0, High = NumEntries;
+	while (Low < High)
+	{
+		const int32 Mid = Low + (High - Low) / 2;
+		if (Entries[Mid].PathHash < PathHash)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	if (Low == NumEntries || Entries[Low].PathHash != PathHash)
+	{
+		return INDEX_NONE;
+	}
+	return Low;
+}
+
+void FChanneldRepClassTable::GetParentChain(int32 Index, TArray<int32>& OutParentIndices) const
+{
+	OutParentIndices.Reset();
+	// Bounded by the number of the classes, in case of a corrupted file with a loop.
+	for (int32 ParentIndex = GetEntry(Index).ParentIndex; ParentIndex != INDEX_NONE && OutParentIndices.Num() < NumEntries; ParentIndex = Entries[ParentIndex].ParentIndex)
+	{
+		OutParentIndices.Add(ParentIndex);
+	}
+}
+
+bool FChanneldRepClassTable::IsChildOf(int32 Index, int32 ParentIndex) const
+{
+	int32 Steps = 0;
+	for (int32 i = Index; i != INDEX_NONE && Steps <= NumEntries; i = Entries[i].ParentIndex, Steps++)
+	{
+		if (i == ParentIndex)
+		{
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * The replicated classes of the project in a flat binary file, written by UCookAndUpdateRepActorCacheCommandlet along with the
+ * replication actor cache. Unlike the cache of the editor, the file has no strings to parse, so it can be memory-mapped at the
+ * startup of the server. It's saved under Content/Channeld/RepClassTable.bin, which should be packaged as a non-asset file.
+ *
+ * Layout (little-endian): FHeader | FEntry[NumClasses] sorted by the PathHash | the UTF-8 class paths
+ */
+class CHANNELDUE_API FChanneldRepClassTable
+{
+public:
+	enum EClassFlags : uint16
+	{
+		Flag_Component = 1 << 0,
+		Flag_ChildOfGameState = 1 << 1,
+		Flag_ChildOfWorldSettings = 1 << 2,
+	};
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 NumClasses;
+		uint32 StringsOffset;
+		uint32 StringsSize;
+		uint32 Reserved;
+	};
+
+	struct FEntry
+	{
+		uint64 PathHash;
+		// The index of the nearest replicated super class, or INDEX_NONE.
+		int32 ParentIndex;
+		// The index of the class in the class paths sorted by name, which is the same in all the builds of the same cache.
+		int32 ReplicatorId;
+		uint32 PathOffset;
+		uint16 PathLength;
+		uint16 Flags;
+	};
+
+	// The input of Save()
+	struct FClassInfo
+	{
+		FString PathName;
+		FString ParentPathName;
+		uint16 Flags = 0;
+	};
+
+	static constexpr uint32 Magic = 0x43525443; // "CRTC"
+	static constexpr uint32 Version = 1;
+
+	FChanneldRepClassTable() = default;
+	~FChanneldRepClassTable();
+	FChanneldRepClassTable(const FChanneldRepClassTable&) = delete;
+	FChanneldRepClassTable& operator=(const FChanneldRepClassTable&) = delete;
+
+	// The table loaded from GetFilePath() at the first call. Empty if the file doesn't exist or is invalid.
+	static const FChanneldRepClassTable& Get();
+
+	static FString GetFilePath();
+	static uint64 HashPath(const FString& PathName);
+	static bool Save(const TArray<FClassInfo>& Classes, const FString& FilePath = GetFilePath());
+
+	bool Load(const FString& FilePath = GetFilePath());
+	void Reset();
+
+	bool IsLoaded() const { return Entries != nullptr; }
+	int32 Num() const { return NumEntries; }
+	const FEntry& GetEntry(int32 Index) const { check(Index >= 0 && Index < NumEntries); return Entries[Index]; }
+	FString GetPathName(int32 Index) const;
+
+	// Returns the index of the class, or INDEX_NONE.
+	int32 FindClass(const FString& PathName) const;
+	// Returns the index of the class of the hash, or INDEX_NONE. Unlike FindClass(), the path is not verified.
+	int32 FindClassByHash(uint64 PathHash) const;
+	// The indices of the replicated super classes, from the nearest one to the root.
+	void GetParentChain(int32 Index, TArray<int32>& OutParentIndices) const;
+	bool IsChildOf(int32 Index, int32 ParentIndex) const;
+
+private:
+	// Either the mapped file or the file loaded into memory, when the platform (e.g. the pak file) doesn't support mapping.
+	IMappedFileHandle* MappedHandle = nullptr;
+	IMappedFileRegion* MappedRegion = nullptr;
+	TArray<uint8> LoadedBytes;
+
+	const FEntry* Entries = nullptr;
+	int32 NumEntries = 0;
+	// The UTF-8 class paths
+	const ANSICHAR* Strings = nullptr;
+
+	bool Parse(const uint8* Data, int64 Size, const FString& FilePath);
+};
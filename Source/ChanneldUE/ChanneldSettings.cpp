@@ -106,21 +106,250 @@ void UChanneldSettings::PostInitProperties()
 	{
 		UE_LOG(LogChanneld, Log, TEXT("Parsed bUseReceiveThread from CLI: %d"), bUseReceiveThread);
 	}
+	if (FParse::Bool(CmdLine, TEXT("UnpackChannelDataOnReceiveThread="), bUnpackChannelDataOnReceiveThread))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bUnpackChannelDataOnReceiveThread from CLI: %d"), bUnpackChannelDataOnReceiveThread);
+	}
+
+	if (FParse::Bool(CmdLine, TEXT("UseSendThread="), bUseSendThread))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bUseSendThread from CLI: %d"), bUseSendThread);
+	}
+	auto ParseThreadPriority = [CmdLine](const TCHAR* Match, EChanneldThreadPriority& OutPriority)
+	{
+		FString PriorityName;
+		if (FParse::Value(CmdLine, Match, PriorityName))
+		{
+			const int64 Value = StaticEnum<EChanneldThreadPriority>()->GetValueByNameString(TEXT("ETP_") + PriorityName);
+			if (Value != INDEX_NONE)
+			{
+				OutPriority = static_cast<EChanneldThreadPriority>(Value);
+			}
+			UE_LOG(LogChanneld, Log, TEXT("Parsed %s from CLI: %s"), Match, *PriorityName);
+		}
+	};
+	ParseThreadPriority(TEXT("ReceiveThreadPriority="), ReceiveThreadPriority);
+	ParseThreadPriority(TEXT("SendThreadPriority="), SendThreadPriority);
+	if (FParse::Value(CmdLine, TEXT("ReceiveThreadAffinityMask="), ReceiveThreadAffinityMask))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ReceiveThreadAffinityMask from CLI: %lld"), ReceiveThreadAffinityMask);
+	}
+	if (FParse::Value(CmdLine, TEXT("SendThreadAffinityMask="), SendThreadAffinityMask))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed SendThreadAffinityMask from CLI: %lld"), SendThreadAffinityMask);
+	}
+	if (FParse::Value(CmdLine, TEXT("ChanneldTickIntervalMs="), ChanneldTickIntervalMs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ChanneldTickIntervalMs from CLI: %d"), ChanneldTickIntervalMs);
+	}
+	if (FParse::Value(CmdLine, TEXT("SendPhaseOffsetMs="), SendPhaseOffsetMs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed SendPhaseOffsetMs from CLI: %f"), SendPhaseOffsetMs);
+	}
+	if (FParse::Value(CmdLine, TEXT("ServerDispatchWaitMs="), ServerDispatchWaitMs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ServerDispatchWaitMs from CLI: %d"), ServerDispatchWaitMs);
+	}
+	if (FParse::Bool(CmdLine, TEXT("ConnectionPerGameInstance="), bConnectionPerGameInstance))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bConnectionPerGameInstance from CLI: %d"), bConnectionPerGameInstance);
+	}
+	FString ClientTransportName;
+	if (FParse::Value(CmdLine, TEXT("ClientTransport="), ClientTransportName))
+	{
+		ClientTransport = ClientTransportName.Equals(TEXT("KCP"), ESearchCase::IgnoreCase) ? EChanneldTransportType::ETT_KCP : EChanneldTransportType::ETT_TCP;
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ClientTransport from CLI: %s"), *ClientTransportName);
+	}
 
 	if (FParse::Bool(CmdLine, TEXT("DisableHandshaking="), bDisableHandshaking))
 	{
 		UE_LOG(LogChanneld, Log, TEXT("Parsed bDisableHandshaking from CLI: %d"), bDisableHandshaking);
 	}
+
+	if (FParse::Bool(CmdLine, TEXT("SlimLowLevelPackets="), bSlimLowLevelPackets))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bSlimLowLevelPackets from CLI: %d"), bSlimLowLevelPackets);
+	}
 	
 	if (FParse::Value(CmdLine, TEXT("RpcRedirectionMaxRetries="), RpcRedirectionMaxRetries))
 	{
 		UE_LOG(LogChanneld, Log, TEXT("Parsed RpcRedirectionMaxRetries from CLI: %d"), RpcRedirectionMaxRetries);
 	}
+	if (FParse::Value(CmdLine, TEXT("OwningChannelRetentionSeconds="), OwningChannelRetentionSeconds))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed OwningChannelRetentionSeconds from CLI: %f"), OwningChannelRetentionSeconds);
+	}
 
+	if (FParse::Bool(CmdLine, TEXT("CompactObjRefPaths="), bCompactObjRefPaths))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bCompactObjRefPaths from CLI: %d"), bCompactObjRefPaths);
+	}
 	if (FParse::Bool(CmdLine, TEXT("SkipCustomReplication="), bSkipCustomReplication))
 	{
 		UE_LOG(LogChanneld, Log, TEXT("Parsed bSkipCustomReplication from CLI: %d"), bSkipCustomReplication);
 	}
+	if (FParse::Value(CmdLine, TEXT("ChannelDataThrottlePressure="), ChannelDataThrottlePressure))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ChannelDataThrottlePressure from CLI: %f"), ChannelDataThrottlePressure);
+	}
+	if (FParse::Value(CmdLine, TEXT("MaxChannelDataThrottleTicks="), MaxChannelDataThrottleTicks))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MaxChannelDataThrottleTicks from CLI: %d"), MaxChannelDataThrottleTicks);
+	}
+	if (FParse::Bool(CmdLine, TEXT("CoalesceChannelDataUpdates="), bCoalesceChannelDataUpdates))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bCoalesceChannelDataUpdates from CLI: %d"), bCoalesceChannelDataUpdates);
+	}
+	if (FParse::Value(CmdLine, TEXT("ProviderIdleUpdates="), ProviderIdleUpdates))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ProviderIdleUpdates from CLI: %d"), ProviderIdleUpdates);
+	}
+	if (FParse::Value(CmdLine, TEXT("SleepingProviderCheckInterval="), SleepingProviderCheckInterval))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed SleepingProviderCheckInterval from CLI: %f"), SleepingProviderCheckInterval);
+	}
+	if (FParse::Bool(CmdLine, TEXT("ParallelProviderCollection="), bParallelProviderCollection))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bParallelProviderCollection from CLI: %d"), bParallelProviderCollection);
+	}
+
+	if (FParse::Bool(CmdLine, TEXT("ParallelClientAdjustments="), bParallelClientAdjustments))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bParallelClientAdjustments from CLI: %d"), bParallelClientAdjustments);
+	}
+	if (FParse::Value(CmdLine, TEXT("GoodMoveAckInterval="), GoodMoveAckInterval))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed GoodMoveAckInterval from CLI: %f"), GoodMoveAckInterval);
+	}
+	if (FParse::Value(CmdLine, TEXT("SimulatedProxyCullDistance="), SimulatedProxyCullDistance))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed SimulatedProxyCullDistance from CLI: %f"), SimulatedProxyCullDistance);
+	}
+	if (FParse::Bool(CmdLine, TEXT("CullSimulatedProxiesOutOfView="), bCullSimulatedProxiesOutOfView))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bCullSimulatedProxiesOutOfView from CLI: %d"), bCullSimulatedProxiesOutOfView);
+	}
+	if (FParse::Value(CmdLine, TEXT("InterpolationDelayMs="), InterpolationDelayMs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed InterpolationDelayMs from CLI: %f"), InterpolationDelayMs);
+	}
+	if (FParse::Value(CmdLine, TEXT("MaxExtrapolationMs="), MaxExtrapolationMs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MaxExtrapolationMs from CLI: %f"), MaxExtrapolationMs);
+	}
+	if (FParse::Value(CmdLine, TEXT("MinParallelProviderBatch="), MinParallelProviderBatch))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MinParallelProviderBatch from CLI: %d"), MinParallelProviderBatch);
+	}
+	if (FParse::Bool(CmdLine, TEXT("IndexedChannelDataDispatch="), bIndexedChannelDataDispatch))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bIndexedChannelDataDispatch from CLI: %d"), bIndexedChannelDataDispatch);
+	}
+	if (FParse::Bool(CmdLine, TEXT("ScheduledReplication="), bScheduledReplication))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bScheduledReplication from CLI: %d"), bScheduledReplication);
+	}
+	if (FParse::Value(CmdLine, TEXT("MaxScheduledUpdateInterval="), MaxScheduledUpdateInterval))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MaxScheduledUpdateInterval from CLI: %f"), MaxScheduledUpdateInterval);
+	}
+	if (FParse::Value(CmdLine, TEXT("MaxScheduledUpdatesPerTick="), MaxScheduledUpdatesPerTick))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MaxScheduledUpdatesPerTick from CLI: %d"), MaxScheduledUpdatesPerTick);
+	}
+	if (FParse::Value(CmdLine, TEXT("MaxPendingChannelDataStates="), MaxPendingChannelDataStates))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MaxPendingChannelDataStates from CLI: %d"), MaxPendingChannelDataStates);
+	}
+	if (FParse::Value(CmdLine, TEXT("ReceivedUpdateDataBudgetBytes="), ReceivedUpdateDataBudgetBytes))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ReceivedUpdateDataBudgetBytes from CLI: %d"), ReceivedUpdateDataBudgetBytes);
+	}
+	if (FParse::Value(CmdLine, TEXT("FrameArenaStartBlockSize="), FrameArenaStartBlockSize))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed FrameArenaStartBlockSize from CLI: %d"), FrameArenaStartBlockSize);
+	}
+	if (FParse::Bool(CmdLine, TEXT("StreamLateJoinSpawns="), bStreamLateJoinSpawns))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bStreamLateJoinSpawns from CLI: %d"), bStreamLateJoinSpawns);
+	}
+	if (FParse::Value(CmdLine, TEXT("LateJoinSpawnBytesPerTick="), LateJoinSpawnBytesPerTick))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed LateJoinSpawnBytesPerTick from CLI: %d"), LateJoinSpawnBytesPerTick);
+	}
+	if (FParse::Value(CmdLine, TEXT("LateJoinMaxSpawnsPerTick="), LateJoinMaxSpawnsPerTick))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed LateJoinMaxSpawnsPerTick from CLI: %d"), LateJoinMaxSpawnsPerTick);
+	}
+	if (FParse::Bool(CmdLine, TEXT("BatchDestroyMessages="), bBatchDestroyMessages))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bBatchDestroyMessages from CLI: %d"), bBatchDestroyMessages);
+	}
+	if (FParse::Bool(CmdLine, TEXT("BroadcastSpawnToClients="), bBroadcastSpawnToClients))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bBroadcastSpawnToClients from CLI: %d"), bBroadcastSpawnToClients);
+	}
+	if (FParse::Value(CmdLine, TEXT("MaxPooledReplicatorStates="), MaxPooledReplicatorStates))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MaxPooledReplicatorStates from CLI: %d"), MaxPooledReplicatorStates);
+	}
+	if (FParse::Bool(CmdLine, TEXT("PushModelReplication="), bPushModelReplication))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bPushModelReplication from CLI: %d"), bPushModelReplication);
+	}
+	if (FParse::Bool(CmdLine, TEXT("UseRPCFunctionIds="), bUseRPCFunctionIds))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bUseRPCFunctionIds from CLI: %d"), bUseRPCFunctionIds);
+	}
+	if (FParse::Bool(CmdLine, TEXT("BatchUnreliableRPCs="), bBatchUnreliableRPCs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bBatchUnreliableRPCs from CLI: %d"), bBatchUnreliableRPCs);
+	}
+	if (FParse::Value(CmdLine, TEXT("MaxDeferredRPCRetries="), MaxDeferredRPCRetries))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MaxDeferredRPCRetries from CLI: %d"), MaxDeferredRPCRetries);
+	}
+	if (FParse::Value(CmdLine, TEXT("IdleServerDelay="), IdleServerDelay))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed IdleServerDelay from CLI: %f"), IdleServerDelay);
+	}
+	if (FParse::Value(CmdLine, TEXT("IdleReplicationInterval="), IdleReplicationInterval))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed IdleReplicationInterval from CLI: %f"), IdleReplicationInterval);
+	}
+	if (FParse::Value(CmdLine, TEXT("IdleServerTickRate="), IdleServerTickRate))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed IdleServerTickRate from CLI: %d"), IdleServerTickRate);
+	}
+	if (FParse::Value(CmdLine, TEXT("MaxObjRefCacheSize="), MaxObjRefCacheSize))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MaxObjRefCacheSize from CLI: %d"), MaxObjRefCacheSize);
+	}
+	if (FParse::Bool(CmdLine, TEXT("CacheResolvedObjRefs="), bCacheResolvedObjRefs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bCacheResolvedObjRefs from CLI: %d"), bCacheResolvedObjRefs);
+	}
+	if (FParse::Bool(CmdLine, TEXT("RecycleDynamicNetIds="), bRecycleDynamicNetIds))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bRecycleDynamicNetIds from CLI: %d"), bRecycleDynamicNetIds);
+	}
+	if (FParse::Value(CmdLine, TEXT("DynamicNetIdBlockSize="), DynamicNetIdBlockSize))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed DynamicNetIdBlockSize from CLI: %d"), DynamicNetIdBlockSize);
+	}
+
+	if (FParse::Value(CmdLine, TEXT("ReplicationProfileInterval="), ReplicationProfileInterval))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ReplicationProfileInterval from CLI: %f"), ReplicationProfileInterval);
+	}
+	if (FParse::Value(CmdLine, TEXT("NetFrameBudgetMs="), NetFrameBudgetMs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed NetFrameBudgetMs from CLI: %f"), NetFrameBudgetMs);
+	}
+	if (FParse::Value(CmdLine, TEXT("WireSizeSampleRate="), WireSizeSampleRate))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed WireSizeSampleRate from CLI: %d"), WireSizeSampleRate);
+	}
 	
 	FString PlayerStartLocatorClassName;
 	if (FParse::Value(CmdLine, TEXT("PlayerStartLocatorClass="), PlayerStartLocatorClassName))
@@ -128,6 +357,151 @@ void UChanneldSettings::PostInitProperties()
 		UE_LOG(LogChanneld, Log, TEXT("Parsed PlayerStartLocator class name from CLI: %s"), *PlayerStartLocatorClassName);
 		PlayerStartLocatorClass = LoadClass<UChannelDataView>(NULL, *PlayerStartLocatorClassName);
 	}
+	if (FParse::Value(CmdLine, TEXT("HandoverTimeBudgetMs="), HandoverTimeBudgetMs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed HandoverTimeBudgetMs from CLI: %f"), HandoverTimeBudgetMs);
+	}
+	if (FParse::Value(CmdLine, TEXT("HandoverActorPoolTTL="), HandoverActorPoolTTL))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed HandoverActorPoolTTL from CLI: %f"), HandoverActorPoolTTL);
+	}
+	if (FParse::Value(CmdLine, TEXT("MaxPooledHandoverActorsPerClass="), MaxPooledHandoverActorsPerClass))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MaxPooledHandoverActorsPerClass from CLI: %d"), MaxPooledHandoverActorsPerClass);
+	}
+	if (FParse::Value(CmdLine, TEXT("HandoverPrefetchDistance="), HandoverPrefetchDistance))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed HandoverPrefetchDistance from CLI: %f"), HandoverPrefetchDistance);
+	}
+	if (FParse::Value(CmdLine, TEXT("HandoverPrefetchInterval="), HandoverPrefetchInterval))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed HandoverPrefetchInterval from CLI: %f"), HandoverPrefetchInterval);
+	}
+	if (FParse::Value(CmdLine, TEXT("HandoverMoveBufferMs="), HandoverMoveBufferMs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed HandoverMoveBufferMs from CLI: %f"), HandoverMoveBufferMs);
+	}
+	if (FParse::Bool(CmdLine, TEXT("HoldAllRPCsDuringHandover="), bHoldAllRPCsDuringHandover))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bHoldAllRPCsDuringHandover from CLI: %d"), bHoldAllRPCsDuringHandover);
+	}
+	if (FParse::Bool(CmdLine, TEXT("BroadcastOwnershipChanges="), bBroadcastOwnershipChanges))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bBroadcastOwnershipChanges from CLI: %d"), bBroadcastOwnershipChanges);
+	}
+	if (FParse::Bool(CmdLine, TEXT("UseLocalSpatialRegionIndex="), bUseLocalSpatialRegionIndex))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bUseLocalSpatialRegionIndex from CLI: %d"), bUseLocalSpatialRegionIndex);
+	}
+	if (FParse::Bool(CmdLine, TEXT("UseStaticActorTable="), bUseStaticActorTable))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bUseStaticActorTable from CLI: %d"), bUseStaticActorTable);
+	}
+	if (FParse::Value(CmdLine, TEXT("StaticEntityChannelsPerTick="), StaticEntityChannelsPerTick))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed StaticEntityChannelsPerTick from CLI: %d"), StaticEntityChannelsPerTick);
+	}
+	if (FParse::Bool(CmdLine, TEXT("GroupLowImportanceEntities="), bGroupLowImportanceEntities))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bGroupLowImportanceEntities from CLI: %d"), bGroupLowImportanceEntities);
+	}
+	if (FParse::Value(CmdLine, TEXT("MaxEntitiesPerGroup="), MaxEntitiesPerGroup))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MaxEntitiesPerGroup from CLI: %d"), MaxEntitiesPerGroup);
+	}
+	if (FParse::Bool(CmdLine, TEXT("BatchEntityGroupUpdates="), bBatchEntityGroupUpdates))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bBatchEntityGroupUpdates from CLI: %d"), bBatchEntityGroupUpdates);
+	}
+	if (FParse::Value(CmdLine, TEXT("SpatialLoadReportInterval="), SpatialLoadReportInterval))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed SpatialLoadReportInterval from CLI: %f"), SpatialLoadReportInterval);
+	}
+	if (FParse::Value(CmdLine, TEXT("SpatialServerTargetFrameMs="), SpatialServerTargetFrameMs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed SpatialServerTargetFrameMs from CLI: %f"), SpatialServerTargetFrameMs);
+	}
+	if (FParse::Value(CmdLine, TEXT("SpatialServerTargetEntities="), SpatialServerTargetEntities))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed SpatialServerTargetEntities from CLI: %d"), SpatialServerTargetEntities);
+	}
+	if (FParse::Value(CmdLine, TEXT("SpatialClassSummaryInterval="), SpatialClassSummaryInterval))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed SpatialClassSummaryInterval from CLI: %f"), SpatialClassSummaryInterval);
+	}
+	if (FParse::Bool(CmdLine, TEXT("SyncStreamedLevelActors="), bSyncStreamedLevelActors))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bSyncStreamedLevelActors from CLI: %d"), bSyncStreamedLevelActors);
+	}
+	if (FParse::Value(CmdLine, TEXT("SpatialOwnerHeartbeatInterval="), SpatialOwnerHeartbeatInterval))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed SpatialOwnerHeartbeatInterval from CLI: %f"), SpatialOwnerHeartbeatInterval);
+	}
+	FString StandbyChannels;
+	if (FParse::Value(CmdLine, TEXT("StandbySpatialChannels="), StandbyChannels, false))
+	{
+		TArray<FString> StrChIds;
+		StandbyChannels.ParseIntoArray(StrChIds, TEXT(","));
+		StandbySpatialChannelIds.Reset();
+		for (const FString& StrChId : StrChIds)
+		{
+			StandbySpatialChannelIds.Add(FCString::Atoi(*StrChId));
+		}
+		UE_LOG(LogChanneld, Log, TEXT("Parsed StandbySpatialChannelIds from CLI: %s"), *StandbyChannels);
+	}
+	if (FParse::Value(CmdLine, TEXT("StandbyFailoverTimeout="), StandbyFailoverTimeout))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed StandbyFailoverTimeout from CLI: %f"), StandbyFailoverTimeout);
+	}
+	if (FParse::Value(CmdLine, TEXT("ClassPreloadDistance="), ClassPreloadDistance))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ClassPreloadDistance from CLI: %f"), ClassPreloadDistance);
+	}
+	if (FParse::Value(CmdLine, TEXT("EntityInterestRadius="), EntityInterestRadius))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed EntityInterestRadius from CLI: %f"), EntityInterestRadius);
+	}
+	if (FParse::Bool(CmdLine, TEXT("ParallelInterestQueries="), bParallelInterestQueries))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bParallelInterestQueries from CLI: %d"), bParallelInterestQueries);
+	}
+	if (FParse::Bool(CmdLine, TEXT("PrefetchInterestOnTravel="), bPrefetchInterestOnTravel))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bPrefetchInterestOnTravel from CLI: %d"), bPrefetchInterestOnTravel);
+	}
+	if (FParse::Bool(CmdLine, TEXT("ChanneldSpectator="), bSpectatorMode))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bSpectatorMode from CLI: %d"), bSpectatorMode);
+	}
+	if (FParse::Value(CmdLine, TEXT("SpectatorFanOutIntervalMs="), SpectatorFanOutIntervalMs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed SpectatorFanOutIntervalMs from CLI: %d"), SpectatorFanOutIntervalMs);
+	}
+	if (FParse::Value(CmdLine, TEXT("SpectatorInterestRadius="), SpectatorInterestRadius))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed SpectatorInterestRadius from CLI: %f"), SpectatorInterestRadius);
+	}
+	if (FParse::Value(CmdLine, TEXT("ServerInterestFanOutIntervalMs="), ServerInterestFanOutIntervalMs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ServerInterestFanOutIntervalMs from CLI: %d"), ServerInterestFanOutIntervalMs);
+	}
+	if (FParse::Value(CmdLine, TEXT("MaxClientSpawnsPerTick="), MaxClientSpawnsPerTick))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed MaxClientSpawnsPerTick from CLI: %d"), MaxClientSpawnsPerTick);
+	}
+	if (FParse::Value(CmdLine, TEXT("ClientSpawnTimeBudgetMs="), ClientSpawnTimeBudgetMs))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed ClientSpawnTimeBudgetMs from CLI: %f"), ClientSpawnTimeBudgetMs);
+	}
+
+	if (FParse::Bool(CmdLine, TEXT("ClientDeferBeginPlay="), bClientDeferBeginPlay))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bClientDeferBeginPlay from CLI: %d"), bClientDeferBeginPlay);
+	}
+	if (FParse::Bool(CmdLine, TEXT("AsyncLoadSpawnClasses="), bAsyncLoadSpawnClasses))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Parsed bAsyncLoadSpawnClasses from CLI: %d"), bAsyncLoadSpawnClasses);
+	}
 
 	float InterestRange;
 	if (FParse::Value(CmdLine, TEXT("InterestRange="), InterestRange))
@@ -48,6 +48,42 @@ public:
 	int32 ChanneldPortForServer = 11288;
 	UPROPERTY(Config, EditAnywhere, Category = "Transport")
 	bool bUseReceiveThread = true;
+	// If true, the channel data in the ChannelDataUpdateMessage is parsed along with the message on the receive thread,
+	// so the game thread only merges the parsed states and calls the providers.
+	UPROPERTY(Config, EditAnywhere, Category = "Transport")
+	bool bUnpackChannelDataOnReceiveThread = false;
+	// If true, the packet assembly and socket sending are moved from the game thread (TickFlush) to a separate thread.
+	UPROPERTY(Config, EditAnywhere, Category = "Transport")
+	bool bUseSendThread = false;
+	// The priorities and the core affinity masks of the receive and the send threads. An affinity mask of 0 means any core. On the servers
+	// limited to a core or two, a higher priority keeps the task graph workers from delaying the network.
+	UPROPERTY(Config, EditAnywhere, Category = "Transport")
+	EChanneldThreadPriority ReceiveThreadPriority = EChanneldThreadPriority::ETP_Normal;
+	UPROPERTY(Config, EditAnywhere, Category = "Transport")
+	int64 ReceiveThreadAffinityMask = 0;
+	UPROPERTY(Config, EditAnywhere, Category = "Transport")
+	EChanneldThreadPriority SendThreadPriority = EChanneldThreadPriority::ETP_Normal;
+	UPROPERTY(Config, EditAnywhere, Category = "Transport")
+	int64 SendThreadAffinityMask = 0;
+	// If greater than 0, the tick interval of channeld (20 for 50Hz). The phase of channeld's tick is estimated from the arrivals of the
+	// fan-outs, and the send thread holds the packets until SendPhaseOffsetMs from the next estimated arrival, so they reach channeld just
+	// before its tick instead of at a drifting phase. Requires bUseSendThread, otherwise the phase is only measured.
+	UPROPERTY(Config, EditAnywhere, Category = "Transport", meta = (ClampMin = "0"))
+	int32 ChanneldTickIntervalMs = 0;
+	// Relative to the estimated arrival of channeld's fan-out, which is about one latency after its tick. A negative offset a bit larger
+	// than the round trip time to channeld makes the packets arrive just before the next tick.
+	UPROPERTY(Config, EditAnywhere, Category = "Transport")
+	float SendPhaseOffsetMs = -5.f;
+	// If greater than 0, the server's TickDispatch blocks for up to this many milliseconds until new messages arrive from channeld. Only useful for the servers running at a low tick rate.
+	UPROPERTY(Config, EditAnywhere, Category = "Transport")
+	int32 ServerDispatchWaitMs = 0;
+	// If true, each game instance creates its own connection to channeld, instead of sharing the one of the engine.
+	// Allows one process to host several game worlds (e.g. small matches), each with its own connection, view and caches.
+	UPROPERTY(Config, EditAnywhere, Category = "Transport")
+	bool bConnectionPerGameInstance = false;
+	// The transport of the client connections. KCP resends the lost packets much sooner than TCP, at the cost of more bandwidth. Requires channeld to listen for the clients with the KCP network type.
+	UPROPERTY(Config, EditAnywhere, Category = "Transport")
+	EChanneldTransportType ClientTransport = EChanneldTransportType::ETT_TCP;
 
 	// If true, UE's default handshaking process will be skipped and the server will expect NMT_Hello as the first message.
 	UPROPERTY(Config, EditAnywhere, Category = "Transport")
@@ -55,22 +91,339 @@ public:
 	// If true, UNetConnection::SetInternalAck() will be called to internally ack all packets. Should be turned on for reliable connection (TCP) to save bandwidth.
 	UPROPERTY(Config, EditAnywhere, Category = "Transport")
 	bool bSetInternalAck = true;
+	// If true, the LOW_LEVEL packets are passed to UNetConnection::ReceivedPacket() directly, skipping the PacketHandler, packet audit and analytics
+	// layers of UNetConnection::ReceivedRawPacket(). Only takes effect when both bDisableHandshaking and bSetInternalAck are on, as the channeld link
+	// is reliable and ordered, and the packets have no sequence or ack to process.
+	UPROPERTY(Config, EditAnywhere, Category = "Transport")
+	bool bSlimLowLevelPackets = false;
+	// If true, the class paths of the UnrealObjectRefs, and the context paths of the packages of these classes, are sent as the hashes
+	// of FChanneldRepClassTable instead of the full strings. The servers and the clients must load the same table.
+	UPROPERTY(Config, EditAnywhere, Category = "Transport")
+	bool bCompactObjRefPaths = false;
 	// How many times an RPC will be redirected from a server that couldn't handle it to another server. 0 = No redirection. Setting this to a too high value can cause the RPC bouncing between servers and saturate the network.
 	UPROPERTY(Config, EditAnywhere, Category = "Transport")
 	int32 RpcRedirectionMaxRetries = 1;
+	// If greater than 0, the NetId to owning channel mappings of the objects that don't exist in this process (e.g. handed over to another server,
+	// or only referenced by a spawn message) are removed after they haven't been set for the seconds, checked every the seconds.
+	// Should be longer than the RPCs of a handed over object take to be redirected.
+	UPROPERTY(Config, EditAnywhere, Category = "Transport", meta = (ClampMin = "0"))
+	float OwningChannelRetentionSeconds = 0;
 
 	// Should the server and client skip the custom replication system and use UE's default one. All traffic still goes through channeld either way.
 	UPROPERTY(Config, EditAnywhere, Category = "Replication")
 	bool bSkipCustomReplication = false;
 
+	// The channel data updates are sent less frequently when the send pressure of the connection to channeld (see UChanneldConnection::GetSendPressure()) is above this value. 1 disables the throttling.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0", ClampMax = "1"))
+	float ChannelDataThrottlePressure = 0.5f;
+	// At the full send pressure, the channel data updates are sent once every (1 + MaxChannelDataThrottleTicks) ticks. The skipped changes are sent with the next update.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	int32 MaxChannelDataThrottleTicks = 4;
+	// If true, the ChannelDataUpdate messages received in the same tick are merged per channel, and the providers are updated only once per channel at the end of the tick.
+	// The updated states are then applied after the other messages (e.g. RPCs) received in the same tick.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	bool bCoalesceChannelDataUpdates = false;
+	// The number of the updates without any change before a replication component is considered idle and stops being updated every tick. 0 disables the idle tracking.
+	// An idle component is woken up when its owner moves, or when UChanneldReplicationComponent::MarkDirty() is called.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	int32 ProviderIdleUpdates = 0;
+	// How often (in seconds) the idle providers are still updated, to pick up the changes that don't wake them up.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	float SleepingProviderCheckInterval = 1.0f;
+	// If true, the replication components with bThreadSafeUpdate set are updated on the worker threads when sending the channel data updates.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	bool bParallelProviderCollection = false;
+	// The minimal number of the thread-safe providers updated by one worker. A channel with fewer than twice of this number is updated on the game thread.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "1"))
+	int32 MinParallelProviderBatch = 64;
+	// [Server] If true, the ClientMoveResponsePacked RPCs triggered by the client adjustments in ServerReplicateActors() are serialized on the worker
+	// threads, one client connection per task. The messages are still sent to channeld from the game thread.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	bool bParallelClientAdjustments = false;
+	// [Server] If greater than 0, the characters with UChanneldCharMoveComponent whose moves keep being good are acked at most once per the seconds,
+	// and each ack covers all the moves before it. A client with a detected error is still corrected in the same net tick. 0 acks every net tick.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0", ClampMax = "0.5"))
+	float GoodMoveAckInterval = 0;
+	// [Client] If greater than 0, the simulated proxies of AChanneldCharacter farther than the distance (in cm) from the view of the local player
+	// stop ticking their movement component and mesh, and follow the replicated transforms via UChanneldProxyInterpolationComponent instead.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	float SimulatedProxyCullDistance = 0;
+	// [Client] If true, the simulated proxies of AChanneldCharacter that are not rendered lately are culled as well, regardless of the distance.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	bool bCullSimulatedProxiesOutOfView = false;
+	// [Client] The seconds between the checks of the simulated proxy culling.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0.05"))
+	float SimulatedProxyCullInterval = 0.5f;
+	// [Client] If greater than 0, the received locations and rotations of the scene components and the movement of the actors (except the characters,
+	// which smooth the movement themselves, and the physics-replicated actors) are buffered, and applied with the delay in milliseconds by interpolation.
+	// It hides the jitter of the update intervals, so the servers can send less often. 0 applies the updates as they arrive.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	float InterpolationDelayMs = 0;
+	// [Client] The max milliseconds the interpolated transform is extrapolated by the last velocity when the next update is late.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	float MaxExtrapolationMs = 100;
+	// If true, a received ChannelDataUpdate is only dispatched to the providers of the states in it (see IChannelDataProcessor::GetNetGUIDsInChannelData), instead of all the providers in the channel.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	bool bIndexedChannelDataDispatch = true;
+	// If true, the channel data providers are updated by a scheduler ordered by the next update time, instead of checking every provider every tick.
+	// The interval of a replication component is 1 / NetUpdateFrequency, and backs off exponentially when the states don't change. Replaces the idle tracking (ProviderIdleUpdates).
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	bool bScheduledReplication = false;
+	// The max interval (in seconds) the scheduler backs off a replication component to.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	float MaxScheduledUpdateInterval = 1.0f;
+	// The max number of the providers updated per channel per tick by the scheduler, picked by AActor::NetPriority and the time they have been waiting. 0 means no limit.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	int32 MaxScheduledUpdatesPerTick = 0;
+	// The max number of the states (keyed by NetGUID) kept for a channel that doesn't have any provider yet. The kept states are merged and replayed to the providers added to the channel. 0 means the updates are dropped.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	int32 MaxPendingChannelDataStates = 256;
+	// If greater than 0, the max bytes (measured by SpaceUsedLong) that the received channel data of a channel can keep after being consumed.
+	// Clearing a message keeps the capacity of its maps and repeated fields, so a message over the budget is freed and allocated again by the next update.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	int32 ReceivedUpdateDataBudgetBytes = 0;
+	// The seconds between the checks of ReceivedUpdateDataBudgetBytes.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (EditCondition = "ReceivedUpdateDataBudgetBytes > 0", ClampMin = "0.1"))
+	float ReceivedUpdateDataTrimInterval = 5.0f;
+	// The size (in bytes) of the first block of the frame arena that holds the transient messages of the channel data view. 0 means the protobuf default.
+	// Set it to the ue_frame_arena_high_water metric to allocate one block per frame.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	int32 FrameArenaStartBlockSize = 0;
+	// If true, the existing actors are sent to a new player across the frames, nearest to the player first, instead of all at once at the end of PostLogin.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	bool bStreamLateJoinSpawns = false;
+	// The max bytes of the spawn messages sent to a new player per frame when streaming the existing actors.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "1"))
+	int32 LateJoinSpawnBytesPerTick = 16384;
+	// The max number of the existing actors sent to a new player per frame when streaming them.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "1"))
+	int32 LateJoinMaxSpawnsPerTick = 64;
+	// If true, the destroy messages of a client connection are sent in one message per frame, instead of one message per object.
+	// Reduces the messages when a level is streamed out or many actors are despawned at once. The clients must have the same setting.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	bool bBatchDestroyMessages = false;
+	// If set, the spawn of an actor is sent to the clients with one message, broadcast by channeld if all the clients need it.
+	// Turn it off if the view overrides UChannelDataView::SendSpawnToConn() to customize the message per client.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	bool bBroadcastSpawnToClients = true;
+	// The min interval (in seconds) between two channel data updates sent to the channels of a type. The changes between the sends are accumulated
+	// in the replicators and sent together. The channel types not in the map are updated every tick. See also UChannelDataView::SetChannelSendInterval().
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	TMap<EChanneldChannelType, float> ChannelTypeSendIntervals;
+	// The max number of the free replicator states kept per state message type, to be reused by the replicators created later. Only the states
+	// of the built-in replicators are pooled. 0 disables the pooling.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	int32 MaxPooledReplicatorStates = 128;
+	// If set, the generated replicators only diff the properties marked dirty via CHANNELD_MARK_PROPERTY_DIRTY_FROM_NAME or
+	// UChanneldReplicationComponent::MarkPropertyDirty(), instead of all the properties every tick. The properties changed without being marked are not replicated.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	bool bPushModelReplication = false;
+	// If set, the RPCs registered by the generated replication code are sent with the function ids instead of the names.
+	// The server and the client must be built from the same generated code.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	bool bUseRPCFunctionIds = false;
+	// If set, the unreliable RPCs are collected during the frame and sent together in TickFlush, so the superseded calls can be dropped (see UnreliableRPCLimits).
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	bool bBatchUnreliableRPCs = false;
+	// The limits of the unreliable RPCs by the function name, e.g. the cosmetic multicasts that can be called many times in a frame.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	TMap<FName, FChanneldUnreliableRPCLimit> UnreliableRPCLimits;
+	// The max number of the full-exported object refs cached per NetDriver. The least recently used ones are evicted. 0 disables the cache.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	int32 MaxObjRefCacheSize = 8192;
+	// [Client] If true, the objects and the components resolved from the received refs are cached by NetGUID per NetDriver, so the refs repeated
+	// in every update don't go through the GuidCache again. The destroyed objects are dropped from the cache.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	bool bCacheResolvedObjRefs = true;
+	// [Server] Each server assigns the dynamic NetGUIDs from the range of its ConnectionId, which has 2^ConnectionIdBitOffset of them. If true,
+	// the server keeps assigning from the free blocks of the range when it runs to the end, instead of overflowing into the range of the next
+	// ConnectionId. The NetGUIDs still in the GuidCache, the ones of the objects handed over to or pooled by the spatial servers, and the ones of
+	// the subscribed entity channels are never reused, so a long-running server only runs out when that many objects exist at once.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	bool bRecycleDynamicNetIds = false;
+	// [Server] The preferred number of the consecutive free NetGUIDs to recycle at a time. The server moves to the next block when a quarter of it is left.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "16"))
+	int32 DynamicNetIdBlockSize = 4096;
+	// If greater than 0, the seconds between the reports of the replication cost of each channel: the time spent in collecting, merging
+	// and consuming the channel data, and the bytes sent and received. Reported to UChanneldMetrics, and shown by the spatial visualizer.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	float ReplicationProfileInterval = 0;
+
+	// If greater than 0, a frame whose networking work on the game thread (TickDispatch, ServerReplicateActors and TickFlush) takes longer than
+	// this many milliseconds logs a warning with the costliest channel, actor class and message type of the frame.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	float NetFrameBudgetMs = 0;
+
+	// If greater than 0, one in this many channel data updates sent is broken down by the message type and the field on a background thread.
+	// Exported as the ue_wire_bytes metrics, and logged by the console command "channeld.WireSizes". See FChanneldWireSizeSampler.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	int32 WireSizeSampleRate = 0;
+
 	UPROPERTY(Config, EditAnywhere, Category = "Spatial")
 	TSubclassOf<UPlayerStartLocatorBase> PlayerStartLocatorClass = UPlayerStartLocator_ModByConnId::StaticClass();
+	// [Server] If greater than 0, the received handovers are queued and processed in the following ticks within the milliseconds per tick,
+	// player first. The handovers of an entity that moves on before being processed are merged. 0 processes each handover when it's received.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0"))
+	float HandoverTimeBudgetMs = 0;
+	// [Server] The seconds to keep a non-player actor hidden and deactivated after it leaves the interest area of the server, so it's reused
+	// with the handover data if it comes back in time, instead of being spawned again. 0 destroys the actor right away.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0"))
+	float HandoverActorPoolTTL = 0;
+	// [Server] The max number of the pooled actors per class. The actors beyond are destroyed right away.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0"))
+	int32 MaxPooledHandoverActorsPerClass = 32;
+	// [Server] If greater than 0, the non-player actor that is moving toward another server's spatial region within the distance (in cm)
+	// is sent to that server ahead of the handover, so it's already spawned there when the handover arrives.
+	// Requires HandoverActorPoolTTL > 0, as the destination server keeps the actor in the pool until then.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0"))
+	float HandoverPrefetchDistance = 0;
+	// [Server] The seconds between the checks of the handover prefetch.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0.02"))
+	float HandoverPrefetchInterval = 0.2f;
+	// [Server] If greater than 0, the ServerMovePacked RPCs of a character whose handover is not processed yet are held for up to the milliseconds,
+	// then processed or forwarded to the new owner in one batch once the handover is done, instead of being redirected one by one or dropped.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0"))
+	float HandoverMoveBufferMs = 0;
+	// [Server] If true, HandoverMoveBufferMs holds all the RPCs of an object whose handover is not processed yet, not only ServerMovePacked.
+	// The held RPCs keep their order.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial")
+	bool bHoldAllRPCsDuringHandover = false;
+	// [Server] If true, the server that hands over the objects tells the other spatial servers their new owning channels right away.
+	// The RPCs that reach the other servers are then redirected to the new owner, instead of bouncing off the stale mapping.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial")
+	bool bBroadcastOwnershipChanges = false;
+	// Resolve the spatial channel of a position from the spatial regions received from channeld, instead of querying channeld each time.
+	// channeld is still queried before the regions arrive, or for the positions out of all the regions.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial")
+	bool bUseLocalSpatialRegionIndex = true;
+	// [Server] Assign the NetIds precomputed by the CookAndUpdateRepActorCache commandlet to the static actors at startup, instead of
+	// synchronizing them between the spatial servers. See FChanneldStaticActorTable.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial")
+	bool bUseStaticActorTable = true;
+	// [Server] The max number of entity channels created for the static actors per tick at startup. 0 means no limit.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0"))
+	int32 StaticEntityChannelsPerTick = 64;
+	// [Server] Let the low-importance static actors of a spatial channel share one entity channel, instead of creating an entity channel
+	// for each of them. An actor is low-importance if it doesn't replicate the movement, is not always relevant, and its NetPriority is
+	// not greater than EntityGroupMaxNetPriority. The clients add the providers of the members to the shared entity channel as well.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial")
+	bool bGroupLowImportanceEntities = false;
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (EditCondition = "bGroupLowImportanceEntities", ClampMin = "0"))
+	float EntityGroupMaxNetPriority = 1.0f;
+	// The max number of the actors in a shared entity channel, including the one that owns the channel.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (EditCondition = "bGroupLowImportanceEntities", ClampMin = "2"))
+	int32 MaxEntitiesPerGroup = 256;
+	// If true, the connection caches the members of the handover and lock groups, and sends the changes of a group in a frame as one add and
+	// one remove message with only the entities that actually joined or left. Otherwise each AddToEntityGroup() or RemoveFromEntityGroup() call is sent as is.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial")
+	bool bBatchEntityGroupUpdates = true;
+	// [Server] If greater than 0, the seconds between the load reports of the spatial server, so the spatial channels can be rebalanced.
+	// The report is a google.protobuf.Struct sent to the global channel, with the game thread time and the entity count and the sent
+	// channel data bytes per owned spatial channel.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0"))
+	float SpatialLoadReportInterval = 0;
+	// [Server] The game thread time in milliseconds of a fully loaded spatial server. The load in the load report and the ue_spatial_load
+	// metric is the game thread time over it, or the entities over SpatialServerTargetEntities if that's higher. An autoscaler (see
+	// Template/SpatialServerAutoscaler.yaml) adds spatial servers when the average load is over its target.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (EditCondition = "SpatialLoadReportInterval > 0", ClampMin = "1"))
+	float SpatialServerTargetFrameMs = 33.3f;
+	// [Server] The number of the entities of a fully loaded spatial server. 0 means the load only counts the game thread time.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (EditCondition = "SpatialLoadReportInterval > 0", ClampMin = "0"))
+	int32 SpatialServerTargetEntities = 0;
+	// [Server] If greater than 0, the seconds between the summaries of the replicated classes in the owned spatial channels sent to the clients.
+	// The classes are sent as the indices of FChanneldRepClassTable, so the servers and the clients must package the same table.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0"))
+	float SpatialClassSummaryInterval = 0;
+	// [Server] If true, the actors of a level streamed in after the spatial channels are ready (e.g. a World Partition cell) are synchronized
+	// and added to the spatial channels they are in when the level is added to the world, and removed from the channels when it's removed.
+	// Without it, only the actors loaded when the spatial channels are ready are synchronized.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial")
+	bool bSyncStreamedLevelActors = false;
+	// [Server] If greater than 0, the seconds between the heartbeats of the spatial server to the other servers, which carry the spatial
+	// channels it owns. The standby servers (see StandbySpatialChannelIds) take over the channels when the heartbeats stop.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0"))
+	float SpatialOwnerHeartbeatInterval = 0;
+	// [Server] If not empty, the server runs as the standby of the spatial server that owns these channels, instead of creating its own.
+	// It subscribes to the channels with read access and spawns their entities as simulated proxies, which are kept up to date by the
+	// channel data updates. When the heartbeats of the owning server stop for StandbyFailoverTimeout, it takes over the channels and
+	// promotes the entities to authority, without spawning them again.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial")
+	TArray<int32> StandbySpatialChannelIds;
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0.1"))
+	float StandbyFailoverTimeout = 5.f;
+	// [Client] The classes in the spatial channels within the distance of the player's view are loaded in the background, before the
+	// spawns of the channels arrive. 0 means the class summaries are ignored.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0"))
+	float ClassPreloadDistance = 0;
+	// [Server] If greater than 0, the server re-subscribes to the spatial channels it doesn't own (the neighbouring cells channeld subscribes
+	// it to) with the fan-out interval, as it only needs the coarse states of the entities there.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0"))
+	int32 ServerInterestFanOutIntervalMs = 0;
+	// [Server] If not empty, only these fields of the spatial channels the server doesn't own are fanned out to it. Requires ServerInterestFanOutIntervalMs > 0.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial")
+	TArray<FString> ServerInterestDataFieldMasks;
+	// [Client] The max number of the unresolved spatial entities spawned per tick. The rest are spawned in the next ticks, and the updates
+	// of their entity channels are held until then. The updates of the spawned entities are applied right away. 0 means no limit.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0"))
+	int32 MaxClientSpawnsPerTick = 32;
+
+	// [Client] The time budget in milliseconds of spawning the objects from channeld per tick. The spawn messages over the budget are queued
+	// and spawned in the next ticks, nearest to the local player first. At least one object is spawned per tick. 0 means no budget.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "0"))
+	float ClientSpawnTimeBudgetMs = 0;
+	// [Client] If true and ClientSpawnTimeBudgetMs is set, the PostNetInit (and BeginPlay) of the actors spawned from the queued spawn messages
+	// is deferred, and run in the next ticks before spawning more objects, within the same time budget. The roles and the owning channels of the
+	// actors are already set when their BeginPlay is called.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial")
+	bool bClientDeferBeginPlay = false;
+	// [Client] If true, the spawn messages of the classes that are not loaded yet load the packages of the classes asynchronously, instead of
+	// blocking the game thread in LoadObject(). The spawns and the channel data updates of their NetGUIDs are held until the loads complete.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial")
+	bool bAsyncLoadSpawnClasses = false;
 
 	// If true, Actor::IsNetRelevantFor() will be called to determine whether an actor should be destroyed on the client when leaving player's the interest area.
 	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Client Interest")
 	bool bUseNetRelevancyForUninterestedActors = false;
 	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Client Interest")
 	TArray<FClientInterestSettingsPreset> ClientInterestPresets;
+	// [Server] The distance bands of the entity channels the clients are subscribed to, nearest first. The entity channel data is fanned out
+	// to the client with the interval and the field masks of the entity's band. Empty means all the entities are fanned out the same way.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Client Interest")
+	TArray<FChanneldReplicationLODBand> ReplicationLODBands;
+	// [Server] The interval (in seconds) to re-evaluate the bands of the entities for each client.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Client Interest", meta = (ClampMin = "0"))
+	float ReplicationLODUpdateInterval = 0.5f;
+	// [Server] If greater than 0, the entities farther than it from the client's pawn are out of the client's entity interest, even if
+	// they are in a spatial channel the client is subscribed to (also the entities not relevant to the client, if bUseNetRelevancyForUninterestedActors
+	// is set). Only the objRef of their entity channel data is fanned out, at CulledEntityFanOutIntervalMs. Re-evaluated with the LOD bands.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Client Interest", meta = (ClampMin = "0"))
+	float EntityInterestRadius = 0;
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Client Interest", meta = (ClampMin = "1"))
+	int32 CulledEntityFanOutIntervalMs = 1000;
+	// [Server] Evaluate the AOIs of the clients in parallel. The AOIs only read the locations of the followed actors, but the custom AOIs
+	// should be thread-safe to enable it. The changed queries are always sent from the game thread afterwards.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Client Interest")
+	bool bParallelInterestQueries = false;
+	// [Client] Subscribe to the spatial channels around the destination channel before travelling to it, with the radius of the
+	// default active interest presets, so their data arrives while the level loads. The channel data received during the travel is
+	// buffered and applied once the new map has loaded. The server's interest query replaces the prefetched subscriptions afterwards.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Client Interest")
+	bool bPrefetchInterestOnTravel = false;
+	// [Client] Connect as a read-only spectator with UChanneldGameInstanceSubsystem::StartSpectating(), after loading the map locally.
+	// The spectator never logs in to the servers, so they have no PlayerController, net connection or interest manager of it. It
+	// subscribes to the spatial channels around its own view with read access, and to the entity channels of their entities.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Spectator")
+	bool bSpectatorMode = false;
+	// [Client] The fan-out interval of the channels the spectator subscribes to, including the GLOBAL channel.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Spectator", meta = (ClampMin = "1"))
+	int32 SpectatorFanOutIntervalMs = 200;
+	// [Client] The spectator subscribes to the spatial channels within the distance of its view, and unsubscribes from them when they
+	// are a quarter farther than it.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Spectator", meta = (ClampMin = "0"))
+	float SpectatorInterestRadius = 10000.f;
+	// [Client] The interval (in seconds) to update the spatial channels of the spectator's view.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Spectator", meta = (ClampMin = "0.1"))
+	float SpectatorInterestUpdateInterval = 1.f;
 	
 	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Debug")
 	bool bEnableSpatialVisualizer = false;
@@ -95,14 +448,38 @@ public:
 	FVector SubscriptionBoxOffset;
 	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Debug", meta=(EditCondition="bEnableSpatialVisualizer"))
 	TSubclassOf<AOutlinerActor> SpatialOutlinerClass;
+	// Draw the region and subscription boxes as the instances of InstancedBoxMesh instead of spawning a RegionBoxClass or SubscriptionBoxClass
+	// actor for each box. Only the changed regions are updated when channeld sends the regions again.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Debug", meta=(EditCondition="bEnableSpatialVisualizer"))
+	bool bInstancedSpatialVisualizer = false;
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Debug", meta=(EditCondition="bEnableSpatialVisualizer && bInstancedSpatialVisualizer"))
+	TSoftObjectPtr<class UStaticMesh> InstancedBoxMesh = TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(TEXT("/Engine/BasicShapes/Cube.Cube")));
+	// The material of the instanced boxes, which should read the color from the per-instance custom data 0-3 (RGBA).
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial|Debug", meta=(EditCondition="bEnableSpatialVisualizer && bInstancedSpatialVisualizer"))
+	TSoftObjectPtr<class UMaterialInterface> InstancedBoxMaterial;
 
 	// If set to true, the RPC with the actor that hasn't been exported to the client will be postponed until being exported.
 	UPROPERTY(Config, EditAnywhere, Category = "Server")
 	bool bQueueUnexportedActorRPC = false;
+	// The max ticks a deferred RPC is retried, i.e. a received RPC waiting for the target actor or the NetGUIDs, or a queued RPC of an unexported actor (see bQueueUnexportedActorRPC).
+	// The RPC is dropped after that. 0 means retrying forever.
+	UPROPERTY(Config, EditAnywhere, Category = "Server", meta = (ClampMin = "0"))
+	int32 MaxDeferredRPCRetries = 600;
+	// If greater than 0, the server without any client connection goes idle after this many seconds without any changed channel data provider.
+	// An idle server sends the channel data updates every IdleReplicationInterval and ticks at IdleServerTickRate, until it's woken up by a changed
+	// provider, a client connection, a subscription to its channels, a handover or an incoming RPC. 0 disables the idle mode.
+	UPROPERTY(Config, EditAnywhere, Category = "Server", meta = (ClampMin = "0"))
+	float IdleServerDelay = 0;
+	// How often (in seconds) an idle server sends the channel data updates. The changes in between are sent with the next update.
+	UPROPERTY(Config, EditAnywhere, Category = "Server", meta = (EditCondition = "IdleServerDelay > 0", ClampMin = "0"))
+	float IdleReplicationInterval = 1.0f;
+	// The tick rate of an idle server. TickDispatch blocks until a message arrives from channeld or the frame time is up, so the server wakes up without waiting for the next frame.
+	UPROPERTY(Config, EditAnywhere, Category = "Server", meta = (EditCondition = "IdleServerDelay > 0", ClampMin = "1"))
+	int32 IdleServerTickRate = 5;
 	// Delay the calling of UChannelDataView::Initialize() for attaching the debugger or other purpose.
 	UPROPERTY(Config, EditAnywhere, Category = "Debug")
 	float DelayViewInitInSeconds = 0;
-	// If set to true, the simulated proxy actors and their components will not tick.
+	// If set to true, the simulated proxy actors and their components will not tick. See SimulatedProxyCullDistance for the culling of the proxies in production.
 	UPROPERTY(Config, EditAnywhere, Category = "Debug")
 	bool bDisableSimulatedProxyTick = false;
 	
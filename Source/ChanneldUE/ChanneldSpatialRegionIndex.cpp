@@ -0,0 +1,97 @@
+#include "ChanneldSpatialRegionIndex.h"
+
+// Limits the memory when the regions differ a lot in size.
+static constexpr int32 MaxCellsPerAxis = 256;
+
+void FChanneldSpatialRegionIndex::Build(const channeldpb::SpatialRegionsUpdateMessage& Msg)
+{
+	Reset();
+
+	FBox2D TotalBounds(ForceInit);
+	FVector2D MinRegionSize(MAX_flt, MAX_flt);
+	bool bBounded = true;
+	for (auto& Region : Msg.regions())
+	{
+		// Swap the Y and Z as UE uses the Z-Up rule but channeld uses the Y-up rule.
+		const FVector BoundsMin(Region.min().x(), Region.min().z(), Region.min().y());
+		const FVector BoundsMax(Region.max().x(), Region.max().z(), Region.max().y());
+		Regions.Add(FRegion{FBox(BoundsMin, BoundsMax), Region.channelid(), Region.serverindex()});
+
+		const FVector2D Size(BoundsMax.X - BoundsMin.X, BoundsMax.Y - BoundsMin.Y);
+		if (!FMath::IsFinite(Size.X) || !FMath::IsFinite(Size.Y) || Size.X <= 0 || Size.Y <= 0)
+		{
+			bBounded = false;
+			continue;
+		}
+		TotalBounds += FVector2D(BoundsMin.X, BoundsMin.Y);
+		TotalBounds += FVector2D(BoundsMax.X, BoundsMax.Y);
+		MinRegionSize = FVector2D::Min(MinRegionSize, Size);
+	}
+
+	UE_LOG(LogChanneld, Log, TEXT("Built the spatial region index of %d regions"), Regions.Num());
+	if (!bBounded || Regions.Num() == 0)
+	{
+		return;
+	}
+
+	const FVector2D TotalSize = TotalBounds.GetSize();
+	CellSize = FVector2D::Max(MinRegionSize, TotalSize / MaxCellsPerAxis);
+	GridOrigin = TotalBounds.Min;
+	NumCellsX = FMath::Clamp(FMath::CeilToInt(TotalSize.X / CellSize.X), 1, MaxCellsPerAxis);
+	NumCellsY = FMath::Clamp(FMath::CeilToInt(TotalSize.Y / CellSize.Y), 1, MaxCellsPerAxis);
+	Cells.SetNum(NumCellsX * NumCellsY);
+
+	for (int32 i = 0; i < Regions.Num(); i++)
+	{
+		const FBox& Bounds = Regions[i].Bounds;
+		const int32 MinX = FMath::Clamp(FMath::FloorToInt((Bounds.Min.X - GridOrigin.X) / CellSize.X), 0, NumCellsX - 1);
+		const int32 MinY = FMath::Clamp(FMath::FloorToInt((Bounds.Min.Y - GridOrigin.Y) / CellSize.Y), 0, NumCellsY - 1);
+		const int32 MaxX = FMath::Clamp(FMath::CeilToInt((Bounds.Max.X - GridOrigin.X) / CellSize.X) - 1, 0, NumCellsX - 1);
+		const int32 MaxY = FMath::Clamp(FMath::CeilToInt((Bounds.Max.Y - GridOrigin.Y) / CellSize.Y) - 1, 0, NumCellsY - 1);
+		for (int32 Y = MinY; Y <= MaxY; Y++)
+		{
+			for (int32 X = MinX; X <= MaxX; X++)
+			{
+				Cells[Y * NumCellsX + X].Add(i);
+			}
+		}
+	}
+}
+
+void FChanneldSpatialRegionIndex::Reset()
+{
+	Regions.Reset();
+	Cells.Reset();
+	NumCellsX = NumCellsY = 0;
+}
+
+Channeld::ChannelId FChanneldSpatialRegionIndex::GetChannelId(const FVector& Location) const
+{
+	if (Cells.Num() == 0)
+	{
+		for (const FRegion& Region : Regions)
+		{
+			if (IsInRegion(Region, Location))
+			{
+				return Region.ChId;
+			}
+		}
+		return Channeld::InvalidChannelId;
+	}
+
+	const int32 X = FMath::FloorToInt((Location.X - GridOrigin.X) / CellSize.X);
+	const int32 Y = FMath::FloorToInt((Location.Y - GridOrigin.Y) / CellSize.Y);
+	if (X < 0 || X >= NumCellsX || Y < 0 || Y >= NumCellsY)
+	{
+		return Channeld::InvalidChannelId;
+	}
+
+	for (const int32 RegionIndex : Cells[Y * NumCellsX + X])
+	{
+		if (IsInRegion(Regions[RegionIndex], Location))
+		{
+			return Regions[RegionIndex].ChId;
+		}
+	}
+	return Channeld::InvalidChannelId;
+}
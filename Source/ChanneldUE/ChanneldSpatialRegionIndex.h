@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChanneldTypes.h"
+
+/**
+ * Maps the locations to the spatial channels by the regions from SPATIAL_REGIONS_UPDATE, without a round trip to channeld.
+ * The regions are bucketed in a uniform grid on the XY plane (in UE's coordinates), so a lookup only tests a few regions.
+ */
+class CHANNELDUE_API FChanneldSpatialRegionIndex
+{
+public:
+	struct FRegion
+	{
+		FBox Bounds;
+		Channeld::ChannelId ChId;
+		uint32 ServerIndex;
+	};
+
+	void Build(const channeldpb::SpatialRegionsUpdateMessage& Msg);
+	void Reset();
+
+	// Returns InvalidChannelId if the index is empty or the location is out of all the regions.
+	Channeld::ChannelId GetChannelId(const FVector& Location) const;
+
+	FORCEINLINE bool IsEmpty() const { return Regions.Num() == 0; }
+	FORCEINLINE const TArray<FRegion>& GetRegions() const { return Regions; }
+
+private:
+	// The region has the min bound inclusive and the max bound exclusive, as channeld does.
+	static FORCEINLINE bool IsInRegion(const FRegion& Region, const FVector& Location)
+	{
+		return Location.X >= Region.Bounds.Min.X && Location.X < Region.Bounds.Max.X
+			&& Location.Y >= Region.Bounds.Min.Y && Location.Y < Region.Bounds.Max.Y;
+	}
+
+	TArray<FRegion> Regions;
+	FVector2D GridOrigin = FVector2D::ZeroVector;
+	FVector2D CellSize = FVector2D::ZeroVector;
+	int32 NumCellsX = 0;
+	int32 NumCellsY = 0;
+	// The indices of the regions that overlap each cell. Empty if the regions are not bounded, then all the regions are tested.
+	TArray<TArray<int32, TInlineAllocator<4>>> Cells;
+};
@@ -0,0 +1,44 @@
+#include "ChanneldStaticActorTable.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+FString FChanneldStaticActorTable::GetFilePath(const FString& InMapName)
+{
+	return FPaths::ProjectContentDir() / TEXT("Channeld/StaticActors") / InMapName.Replace(TEXT("/"), TEXT("_")) + TEXT(".json");
+}
+
+bool FChanneldStaticActorTable::Load(const FString& InMapName)
+{
+	const FString FilePath = GetFilePath(InMapName);
+	FString Json;
+	if (!FFileHelper::LoadFileToString(Json, *FilePath))
+	{
+		UE_LOG(LogChanneld, Verbose, TEXT("No static actor table of map %s"), *InMapName);
+		return false;
+	}
+
+	if (!FJsonObjectConverter::JsonObjectStringToUStruct(Json, this, 0, 0) || MapName != InMapName)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Invalid static actor table: %s"), *FilePath);
+		Actors.Reset();
+		return false;
+	}
+
+	UE_LOG(LogChanneld, Log, TEXT("Loaded %d static actors of map %s"), Actors.Num(), *MapName);
+	return true;
+}
+
+bool FChanneldStaticActorTable::Save() const
+{
+	const FString FilePath = GetFilePath(MapName);
+	FString Json;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(*this, Json) || !FFileHelper::SaveStringToFile(Json, *FilePath))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to save the static actor table: %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogChanneld, Log, TEXT("Saved %d static actors of map %s to %s"), Actors.Num(), *MapName, *FilePath);
+	return true;
+}
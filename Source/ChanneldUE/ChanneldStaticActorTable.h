@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChanneldTypes.h"
+#include "ChanneldStaticActorTable.generated.h"
+
+USTRUCT()
+struct CHANNELDUE_API FChanneldStaticActor
+{
+	GENERATED_BODY()
+
+	// The path name of the actor, without the PIE prefix.
+	UPROPERTY()
+	FString Path;
+
+	UPROPERTY()
+	uint32 NetId = 0;
+
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+};
+
+/**
+ * The static actors of a map, with the NetIds precomputed by UCookAndUpdateRepActorCacheCommandlet. All the spatial servers load
+ * the same table, so they don't need to synchronize the NetIds of these actors at startup (see USpatialChannelDataView::SyncNetIds).
+ * The tables are saved under Content/Channeld/StaticActors, which should be added to "Additional Non-Asset Directories to Package".
+ */
+USTRUCT()
+struct CHANNELDUE_API FChanneldStaticActorTable
+{
+	GENERATED_BODY()
+
+	// The long package name of the map, e.g. /Game/Maps/MyMap
+	UPROPERTY()
+	FString MapName;
+
+	// Sorted by the path.
+	UPROPERTY()
+	TArray<FChanneldStaticActor> Actors;
+
+	// The NetIds are odd (static) numbers in the range of Channeld::StaticActorNetIdOffset.
+	static constexpr int32 MaxNum = 1 << (Channeld::ConnectionIdBitOffset - 1);
+
+	static FString GetFilePath(const FString& InMapName);
+	static uint32 GetNetIdByIndex(int32 Index) { return Channeld::StaticActorNetIdOffset + 2 * Index + 1; }
+
+	bool Load(const FString& InMapName);
+	bool Save() const;
+};
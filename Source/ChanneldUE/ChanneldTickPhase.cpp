@@ -0,0 +1,73 @@
+#include "ChanneldTickPhase.h"
+
+// The weight of the old samples. The estimate follows the drift of the phase in about 50 ticks.
+static constexpr double SampleDecay = 0.98;
+static constexpr int32 MinSamples = 10;
+
+void FChanneldTickPhaseEstimator::Init(double InIntervalSeconds)
+{
+	FScopeLock ScopeLock(&Lock);
+	IntervalSeconds = InIntervalSeconds;
+	SumCos = SumSin = SumWeight = 0;
+	NumSamples = 0;
+	LastArrivalTime = 0;
+}
+
+void FChanneldTickPhaseEstimator::AddArrival(double Time)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	// Only the first packet of a burst is a sample of the tick.
+	const bool bNewBurst = Time - LastArrivalTime > IntervalSeconds * 0.5;
+	LastArrivalTime = Time;
+	if (!bNewBurst)
+	{
+		return;
+	}
+
+	const double Angle = FMath::Fmod(Time, IntervalSeconds) / IntervalSeconds * 2.0 * PI;
+	SumCos = SumCos * SampleDecay + FMath::Cos(Angle);
+	SumSin = SumSin * SampleDecay + FMath::Sin(Angle);
+	SumWeight = SumWeight * SampleDecay + 1.0;
+	NumSamples++;
+}
+
+bool FChanneldTickPhaseEstimator::GetPhase(double& OutPhaseSeconds) const
+{
+	FScopeLock ScopeLock(&Lock);
+	// The samples are spread all over the interval if the arrivals are not aligned to a tick, e.g. when the channels fan out at different
+	// rates. Then the length of the mean vector is close to 0.
+	if (NumSamples < MinSamples || FMath::Sqrt(FMath::Square(SumCos) + FMath::Square(SumSin)) < SumWeight * 0.5)
+	{
+		return false;
+	}
+
+	double Angle = FMath::Atan2(SumSin, SumCos);
+	if (Angle < 0)
+	{
+		Angle += 2.0 * PI;
+	}
+	OutPhaseSeconds = Angle / (2.0 * PI) * IntervalSeconds;
+	return true;
+}
+
+double FChanneldTickPhaseEstimator::GetNextPhaseTime(double Now, double OffsetSeconds) const
+{
+	double Phase;
+	if (!IsEnabled() || !GetPhase(Phase))
+	{
+		return Now;
+	}
+
+	const double Target = FMath::Fmod(Phase + OffsetSeconds, IntervalSeconds);
+	double Delay = (Target < 0 ? Target + IntervalSeconds : Target) - FMath::Fmod(Now, IntervalSeconds);
+	if (Delay < 0)
+	{
+		Delay += IntervalSeconds;
+	}
+	return Now + Delay;
+}
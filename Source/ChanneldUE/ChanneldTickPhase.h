@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Estimates the phase of channeld's fan-out tick from the arrival times of the packets, as channeld has no clock-sync message. The packets
+ * of a fan-out arrive together, about one network latency after channeld's tick, so the first packet of each burst is taken as a sample.
+ * The phase is the circular mean of the samples modulo the tick interval, decayed over time, so the replies to the requests that arrive
+ * between the ticks only pull it slightly. Thread-safe: the samples are added on the receive thread and read on the send thread.
+ */
+class CHANNELDUE_API FChanneldTickPhaseEstimator
+{
+public:
+	void Init(double InIntervalSeconds);
+	FORCEINLINE bool IsEnabled() const { return IntervalSeconds > 0; }
+
+	void AddArrival(double Time);
+	// Returns false if there are not enough samples yet.
+	bool GetPhase(double& OutPhaseSeconds) const;
+	// Returns the first time after Now that is OffsetSeconds from the estimated arrival of a fan-out, or Now if the phase is unknown.
+	double GetNextPhaseTime(double Now, double OffsetSeconds) const;
+
+private:
+	double IntervalSeconds = 0;
+	mutable FCriticalSection Lock;
+	double SumCos = 0;
+	double SumSin = 0;
+	double SumWeight = 0;
+	int32 NumSamples = 0;
+	double LastArrivalTime = 0;
+};
@@ -0,0 +1,584 @@
+#include "ChanneldTransport.h"
+#include "ChanneldKcp.h"
+#include "channeld.pb.h"
+#include "unreal_common.pb.h"
+#include "SocketSubsystem.h"
+
+TUniquePtr<FChanneldTransport> FChanneldTransport::Create(EChanneldTransportType Type)
+{
+	switch (Type)
+	{
+	case EChanneldTransportType::ETT_KCP:
+		return MakeUnique<FChanneldKcpTransport>();
+	default:
+		return MakeUnique<FChanneldTcpTransport>();
+	}
+}
+
+FChanneldTcpTransport::~FChanneldTcpTransport()
+{
+	Close();
+}
+
+bool FChanneldTcpTransport::Connect(const FInternetAddr& Addr, FString& Error)
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get();
+	Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("Connection to channeld"), Addr.GetProtocolType());
+	if (Socket == nullptr)
+	{
+		Error = TEXT("Failed to create TCP socket");
+		return false;
+	}
+
+	int32 NewSize = 0;
+	if (Socket->SetReceiveBufferSize(0x0fffff, NewSize))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Set Socket's receive buffer size to %d"), NewSize);
+	}
+	else
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to set Socket's receive buffer size"));
+	}
+	if (Socket->SetSendBufferSize(0x0fffff, NewSize))
+	{
+		UE_LOG(LogChanneld, Log, TEXT("Set Socket's send buffer size to %d"), NewSize);
+	}
+	else
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to set Socket's send buffer size"));
+	}
+	if(!Socket->SetNoDelay(true))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to set Socket to NoDelay"));
+	}
+	if(!Socket->SetNonBlocking(true))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to set Socket to NonBlocking"));
+	}
+
+	UE_LOG(LogChanneld, Log, TEXT("Connecting to channeld with addr: %s"), *Addr.ToString(true));
+	// The non-blocking connect returns immediately. The handshake is polled by IsConnecting().
+	if (!Socket->Connect(Addr))
+	{
+		const ESocketErrors LastError = SocketSubsystem->GetLastErrorCode();
+		if (LastError != SE_EINPROGRESS && LastError != SE_EWOULDBLOCK)
+		{
+			Error = FString::Printf(TEXT("Socket connect failed: %s"), SocketSubsystem->GetSocketError(LastError));
+			Close();
+			return false;
+		}
+	}
+	bConnecting = true;
+	return true;
+}
+
+void FChanneldTcpTransport::Close()
+{
+	if (Socket == nullptr)
+	{
+		return;
+	}
+	Socket->Close();
+	if (ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get())
+	{
+		SocketSubsystem->DestroySocket(Socket);
+	}
+	Socket = nullptr;
+	bConnecting = false;
+}
+
+bool FChanneldTcpTransport::IsConnected() const
+{
+	return Socket != nullptr && Socket->GetConnectionState() == SCS_Connected;
+}
+
+bool FChanneldTcpTransport::IsConnecting() const
+{
+	if (!bConnecting || Socket == nullptr)
+	{
+		return false;
+	}
+	// The socket becomes writable when the handshake is done, or gets an error when it failed.
+	if (Socket->GetConnectionState() == SCS_NotConnected)
+	{
+		return true;
+	}
+	bConnecting = false;
+	return false;
+}
+
+bool FChanneldTcpTransport::Send(const uint8* Data, int32 Count, int32& BytesSent)
+{
+	if (Socket->Send(Data, Count, BytesSent))
+	{
+		return true;
+	}
+
+	BytesSent = 0;
+	const ESocketErrors LastError = ISocketSubsystem::Get()->GetLastErrorCode();
+	if (LastError == SE_EWOULDBLOCK || LastError == SE_NO_ERROR)
+	{
+		return true;
+	}
+	UE_LOG(LogChanneld, Error, TEXT("Failed to send %d bytes to channeld, error: %s"), Count, ISocketSubsystem::Get()->GetSocketError(LastError));
+	return false;
+}
+
+bool FChanneldTcpTransport::Recv(uint8* Data, int32 BufferSize, int32& BytesRead)
+{
+	// The socket is non-blocking, so there's no need to check HasPendingData() first. Recv returns true with 0 bytes read if there's no data.
+	return Socket->Recv(Data, BufferSize, BytesRead, ESocketReceiveFlags::None);
+}
+
+bool FChanneldTcpTransport::Wait(FTimespan Timeout)
+{
+	return Socket != nullptr && Socket->Wait(ESocketWaitConditions::WaitForRead, Timeout);
+}
+
+namespace
+{
+	// The "turbo" mode of KCP: no delay, 10ms interval, fast resend after 2 skipped ACKs, no congestion control.
+	constexpr int32 KcpInterval = 10;
+	constexpr int32 KcpFastResend = 2;
+	constexpr uint32 KcpWindowSize = 256;
+	// Stop accepting data when this many segments are waiting, so the send buffer of UChanneldConnection holds the backlog.
+	constexpr int32 KcpMaxWaitingSegmentsInWindows = 4;
+	// KCP rejects the data that needs more fragments than its receive window in a single Send().
+	constexpr int32 KcpMaxSegmentsPerSend = 64;
+
+	FORCEINLINE uint32 KcpNow()
+	{
+		return static_cast<uint32>(FPlatformTime::Seconds() * 1000.0);
+	}
+}
+
+FChanneldKcpTransport::~FChanneldKcpTransport()
+{
+	Close();
+}
+
+bool FChanneldKcpTransport::Connect(const FInternetAddr& Addr, FString& Error)
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get();
+	Socket = SocketSubsystem->CreateSocket(NAME_DGram, TEXT("KCP connection to channeld"), Addr.GetProtocolType());
+	if (Socket == nullptr)
+	{
+		Error = TEXT("Failed to create UDP socket");
+		return false;
+	}
+
+	int32 NewSize = 0;
+	Socket->SetReceiveBufferSize(0x0fffff, NewSize);
+	Socket->SetSendBufferSize(0x0fffff, NewSize);
+	if(!Socket->SetNonBlocking(true))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to set Socket to NonBlocking"));
+	}
+
+	RemoteAddr = Addr.Clone();
+	FromAddr = SocketSubsystem->CreateInternetAddr();
+	DatagramBuffer.SetNumUninitialized(0xffff);
+
+	// The conversation id identifies the session on channeld, so it should be unique among the clients.
+	uint32 Conv = FGuid::NewGuid().A;
+	if (Conv == 0)
+	{
+		Conv = 1;
+	}
+	Kcp = MakeUnique<FChanneldKcp>(Conv, [this](const uint8* Data, int32 Size)
+	{
+		int32 BytesSent;
+		Socket->SendTo(Data, Size, BytesSent, *RemoteAddr);
+	});
+	Kcp->SetNoDelay(true, KcpInterval, KcpFastResend, true);
+	Kcp->SetWindowSize(KcpWindowSize, KcpWindowSize);
+	Kcp->SetStreamMode(true);
+
+	UE_LOG(LogChanneld, Log, TEXT("Connecting to channeld via KCP with addr: %s, conv: %u"), *Addr.ToString(true), Conv);
+	return true;
+}
+
+void FChanneldKcpTransport::Close()
+{
+	FScopeLock Lock(&KcpLock);
+	if (Socket == nullptr)
+	{
+		return;
+	}
+	Socket->Close();
+	if (ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get())
+	{
+		SocketSubsystem->DestroySocket(Socket);
+	}
+	Socket = nullptr;
+	Kcp.Reset();
+	PendingRecv.Empty();
+	PendingRecvOffset = 0;
+}
+
+bool FChanneldKcpTransport::IsConnected() const
+{
+	return Socket != nullptr && Kcp.IsValid() && !Kcp->IsDeadLink();
+}
+
+void FChanneldKcpTransport::Pump()
+{
+	int32 BytesRead;
+	while (Socket->RecvFrom(DatagramBuffer.GetData(), DatagramBuffer.Num(), BytesRead, *FromAddr) && BytesRead > 0)
+	{
+		// Ignore the datagrams not from channeld.
+		if (*FromAddr == *RemoteAddr)
+		{
+			Kcp->Input(DatagramBuffer.GetData(), BytesRead);
+		}
+	}
+	Kcp->Update(KcpNow());
+}
+
+bool FChanneldKcpTransport::Send(const uint8* Data, int32 Count, int32& BytesSent)
+{
+	FScopeLock Lock(&KcpLock);
+	BytesSent = 0;
+	if (!IsConnected())
+	{
+		return false;
+	}
+
+	if (Kcp->GetWaitingSegments() > static_cast<int32>(Kcp->GetSendWindow()) * KcpMaxWaitingSegmentsInWindows)
+	{
+		return true;
+	}
+
+	const int32 MaxBytesPerSend = Kcp->GetMss() * KcpMaxSegmentsPerSend;
+	while (BytesSent < Count)
+	{
+		const int32 Size = FMath::Min(Count - BytesSent, MaxBytesPerSend);
+		if (!Kcp->Send(Data + BytesSent, Size))
+		{
+			break;
+		}
+		BytesSent += Size;
+	}
+
+	// Send the new data right away instead of waiting for the next interval.
+	Kcp->Update(KcpNow());
+	Kcp->Flush();
+	return true;
+}
+
+bool FChanneldKcpTransport::Recv(uint8* Data, int32 BufferSize, int32& BytesRead)
+{
+	FScopeLock Lock(&KcpLock);
+	BytesRead = 0;
+	if (!IsConnected())
+	{
+		return false;
+	}
+
+	Pump();
+
+	// The rest of the last message goes first
+	if (PendingRecvOffset < PendingRecv.Num())
+	{
+		const int32 Size = FMath::Min(PendingRecv.Num() - PendingRecvOffset, BufferSize);
+		FMemory::Memcpy(Data, PendingRecv.GetData() + PendingRecvOffset, Size);
+		PendingRecvOffset += Size;
+		BytesRead += Size;
+	}
+
+	while (BytesRead < BufferSize)
+	{
+		const int32 MsgSize = Kcp->PeekSize();
+		if (MsgSize < 0)
+		{
+			break;
+		}
+		if (MsgSize <= BufferSize - BytesRead)
+		{
+			BytesRead += Kcp->Recv(Data + BytesRead, BufferSize - BytesRead);
+		}
+		else
+		{
+			PendingRecv.SetNumUninitialized(MsgSize, false);
+			Kcp->Recv(PendingRecv.GetData(), MsgSize);
+			PendingRecvOffset = BufferSize - BytesRead;
+			FMemory::Memcpy(Data + BytesRead, PendingRecv.GetData(), PendingRecvOffset);
+			BytesRead = BufferSize;
+		}
+	}
+	return true;
+}
+
+bool FChanneldKcpTransport::Wait(FTimespan Timeout)
+{
+	{
+		FScopeLock Lock(&KcpLock);
+		if (!IsConnected())
+		{
+			return false;
+		}
+		if (PendingRecvOffset < PendingRecv.Num() || Kcp->PeekSize() >= 0)
+		{
+			return true;
+		}
+	}
+
+	// Wake up at least every KCP interval to keep the ACKs and resends going.
+	const FTimespan MaxWait = FTimespan::FromMilliseconds(KcpInterval);
+	const bool bReadable = Socket->Wait(ESocketWaitConditions::WaitForRead, Timeout < MaxWait ? Timeout : MaxWait);
+
+	FScopeLock Lock(&KcpLock);
+	if (!IsConnected())
+	{
+		return false;
+	}
+	Pump();
+	return bReadable && Kcp->PeekSize() >= 0;
+}
+
+bool FChanneldReplayTransport::Connect(const FInternetAddr& Addr, FString& Error)
+{
+	FScopeLock Lock(&ReplayLock);
+	if (!Capture.Load(FilePath, Error))
+	{
+		return false;
+	}
+	RecordIndex = 0;
+	RecordOffset = 0;
+	StartTime = FPlatformTime::Seconds();
+	bOpen = true;
+	UE_LOG(LogChanneld, Log, TEXT("Replaying %d records from %s"), Capture.Records.Num(), *FilePath);
+	return true;
+}
+
+void FChanneldReplayTransport::Close()
+{
+	bOpen = false;
+}
+
+bool FChanneldReplayTransport::Send(const uint8* Data, int32 Count, int32& BytesSent)
+{
+	BytesSent = Count;
+	return bOpen;
+}
+
+const ChanneldCapture::FRecord* FChanneldReplayTransport::PeekDueRecord()
+{
+	while (RecordIndex < Capture.Records.Num() && Capture.Records[RecordIndex].Direction != ChanneldCapture::EDirection::Incoming)
+	{
+		RecordIndex++;
+	}
+	if (IsFinished())
+	{
+		return nullptr;
+	}
+	const ChanneldCapture::FRecord& Record = Capture.Records[RecordIndex];
+	if (bRealTime && Record.Time > FPlatformTime::Seconds() - StartTime)
+	{
+		return nullptr;
+	}
+	return &Record;
+}
+
+bool FChanneldReplayTransport::Recv(uint8* Data, int32 BufferSize, int32& BytesRead)
+{
+	FScopeLock Lock(&ReplayLock);
+	BytesRead = 0;
+	if (!bOpen)
+	{
+		return false;
+	}
+
+	while (BytesRead < BufferSize)
+	{
+		const ChanneldCapture::FRecord* Record = PeekDueRecord();
+		if (Record == nullptr)
+		{
+			break;
+		}
+		const int32 Size = FMath::Min(Record->Data.Num() - RecordOffset, BufferSize - BytesRead);
+		FMemory::Memcpy(Data + BytesRead, Record->Data.GetData() + RecordOffset, Size);
+		BytesRead += Size;
+		RecordOffset += Size;
+		if (RecordOffset == Record->Data.Num())
+		{
+			RecordIndex++;
+			RecordOffset = 0;
+			if (IsFinished())
+			{
+				UE_LOG(LogChanneld, Log, TEXT("Finished replaying %s in %.3fs"), *FilePath, FPlatformTime::Seconds() - StartTime);
+			}
+		}
+	}
+	return true;
+}
+
+bool FChanneldReplayTransport::Wait(FTimespan Timeout)
+{
+	const double EndTime = FPlatformTime::Seconds() + Timeout.GetTotalSeconds();
+	while (bOpen)
+	{
+		double NextTime;
+		{
+			FScopeLock Lock(&ReplayLock);
+			if (PeekDueRecord() != nullptr)
+			{
+				return true;
+			}
+			NextTime = IsFinished() ? EndTime : StartTime + Capture.Records[RecordIndex].Time;
+		}
+		const double Now = FPlatformTime::Seconds();
+		if (Now >= EndTime)
+		{
+			break;
+		}
+		FPlatformProcess::Sleep(static_cast<float>(FMath::Min(NextTime, EndTime) - Now));
+	}
+	return false;
+}
+
+bool FChanneldMatchPlaybackTransport::Connect(const FInternetAddr& Addr, FString& Error)
+{
+	FScopeLock Lock(&PlaybackLock);
+	if (!MatchRecord.Load(FilePath, Error))
+	{
+		return false;
+	}
+
+	KeyframeBeginIndex = KeyframeEndIndex = 0;
+	KeyframeTime = 0;
+	if (const ChanneldMatchRecord::FKeyframe* Keyframe = MatchRecord.FindKeyframe(PlaybackStartTime))
+	{
+		KeyframeBeginIndex = KeyframeEndIndex = Keyframe->RecordIndex;
+		KeyframeTime = Keyframe->Time;
+		while (KeyframeEndIndex < MatchRecord.Records.Num() && MatchRecord.Records[KeyframeEndIndex].bKeyframe)
+		{
+			KeyframeEndIndex++;
+		}
+	}
+	RecordIndex = 0;
+	PacketBuffer.Reset();
+	PacketOffset = 0;
+	StartTime = FPlatformTime::Seconds();
+	bOpen = true;
+	UE_LOG(LogChanneld, Log, TEXT("Playing back %d records from %s, starting from the keyframe at %.1fs"), MatchRecord.Records.Num(), *FilePath, KeyframeTime);
+	return true;
+}
+
+void FChanneldMatchPlaybackTransport::Close()
+{
+	bOpen = false;
+}
+
+bool FChanneldMatchPlaybackTransport::Send(const uint8* Data, int32 Count, int32& BytesSent)
+{
+	BytesSent = Count;
+	return bOpen;
+}
+
+const ChanneldMatchRecord::FRecord* FChanneldMatchPlaybackTransport::PeekDueRecord()
+{
+	for (; RecordIndex < MatchRecord.Records.Num(); RecordIndex++)
+	{
+		const ChanneldMatchRecord::FRecord& Record = MatchRecord.Records[RecordIndex];
+		if (Record.bKeyframe)
+		{
+			if (RecordIndex >= KeyframeBeginIndex && RecordIndex < KeyframeEndIndex)
+			{
+				break;
+			}
+		}
+		else if (RecordIndex >= KeyframeBeginIndex || (Record.MsgType != channeldpb::CHANNEL_DATA_UPDATE && Record.MsgType != unrealpb::RPC))
+		{
+			break;
+		}
+	}
+	if (IsFinished())
+	{
+		return nullptr;
+	}
+	// The records before the keyframe are due right away.
+	const ChanneldMatchRecord::FRecord& Record = MatchRecord.Records[RecordIndex];
+	if (Record.Time - KeyframeTime > FPlatformTime::Seconds() - StartTime)
+	{
+		return nullptr;
+	}
+	return &Record;
+}
+
+void FChanneldMatchPlaybackTransport::BuildPacket(const ChanneldMatchRecord::FRecord& Record)
+{
+	channeldpb::Packet Packet;
+	channeldpb::MessagePack* MessagePack = Packet.add_messages();
+	MessagePack->set_channelid(Record.ChId);
+	MessagePack->set_msgtype(Record.MsgType);
+	MessagePack->set_msgbody(Record.Body.GetData(), Record.Body.Num());
+
+	// Same header as UChanneldConnection::CommitPacket(), without the compression.
+	const uint32 PacketSize = Packet.ByteSizeLong();
+	PacketBuffer.SetNumUninitialized(5 + PacketSize, false);
+	PacketBuffer[0] = 67;
+	PacketBuffer[1] = PacketSize > Channeld::MaxPacketSize ? (PacketSize >> 16) & 0xff : 72;
+	PacketBuffer[2] = (PacketSize >> 8) & 0xff;
+	PacketBuffer[3] = PacketSize & 0xff;
+	PacketBuffer[4] = channeldpb::NO_COMPRESSION;
+	Packet.SerializeWithCachedSizesToArray(PacketBuffer.GetData() + 5);
+	PacketOffset = 0;
+}
+
+bool FChanneldMatchPlaybackTransport::Recv(uint8* Data, int32 BufferSize, int32& BytesRead)
+{
+	FScopeLock Lock(&PlaybackLock);
+	BytesRead = 0;
+	if (!bOpen)
+	{
+		return false;
+	}
+
+	while (BytesRead < BufferSize)
+	{
+		if (PacketOffset == PacketBuffer.Num())
+		{
+			const ChanneldMatchRecord::FRecord* Record = PeekDueRecord();
+			if (Record == nullptr)
+			{
+				break;
+			}
+			BuildPacket(*Record);
+			RecordIndex++;
+			if (IsFinished())
+			{
+				UE_LOG(LogChanneld, Log, TEXT("Finished playing back %s in %.3fs"), *FilePath, FPlatformTime::Seconds() - StartTime);
+			}
+		}
+		const int32 Size = FMath::Min(PacketBuffer.Num() - PacketOffset, BufferSize - BytesRead);
+		FMemory::Memcpy(Data + BytesRead, PacketBuffer.GetData() + PacketOffset, Size);
+		BytesRead += Size;
+		PacketOffset += Size;
+	}
+	return true;
+}
+
+bool FChanneldMatchPlaybackTransport::Wait(FTimespan Timeout)
+{
+	const double EndTime = FPlatformTime::Seconds() + Timeout.GetTotalSeconds();
+	while (bOpen)
+	{
+		double NextTime;
+		{
+			FScopeLock Lock(&PlaybackLock);
+			if (PacketOffset < PacketBuffer.Num() || PeekDueRecord() != nullptr)
+			{
+				return true;
+			}
+			NextTime = IsFinished() ? EndTime : StartTime + MatchRecord.Records[RecordIndex].Time - KeyframeTime;
+		}
+		const double Now = FPlatformTime::Seconds();
+		if (Now >= EndTime)
+		{
+			break;
+		}
+		FPlatformProcess::Sleep(static_cast<float>(FMath::Min(NextTime, EndTime) - Now));
+	}
+	return false;
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sockets.h"
+#include "ChanneldTypes.h"
+#include "ChanneldCapture.h"
+#include "ChanneldMatchRecord.h"
+
+class FChanneldKcp;
+
+/**
+ * @brief The byte stream between UChanneldConnection and channeld. All calls are non-blocking except Wait().
+ */
+class CHANNELDUE_API FChanneldTransport
+{
+public:
+	virtual ~FChanneldTransport() = default;
+
+	static TUniquePtr<FChanneldTransport> Create(EChanneldTransportType Type);
+
+	// Start connecting. Returns before the connection is established if the transport connects asynchronously (see IsConnecting()).
+	virtual bool Connect(const FInternetAddr& Addr, FString& Error) = 0;
+	virtual void Close() = 0;
+	virtual bool IsConnected() const = 0;
+	// Whether the connect started by Connect() is still in progress. When it returns false, IsConnected() tells if the connect succeeded.
+	virtual bool IsConnecting() const { return false; }
+
+	/**
+	 * @brief Write the data to the stream.
+	 * @param BytesSent Can be less than Count (even 0) if the transport can't take more data for now.
+	 * @return False if the transport failed.
+	 */
+	virtual bool Send(const uint8* Data, int32 Count, int32& BytesSent) = 0;
+
+	/**
+	 * @brief Read the available data from the stream.
+	 * @return False if the transport is closed or failed. True with BytesRead = 0 if there's no data for now.
+	 */
+	virtual bool Recv(uint8* Data, int32 BufferSize, int32& BytesRead) = 0;
+
+	// Block until there could be data to read, or the timeout is reached.
+	virtual bool Wait(FTimespan Timeout) = 0;
+
+	virtual FSocket* GetSocket() const = 0;
+};
+
+class CHANNELDUE_API FChanneldTcpTransport : public FChanneldTransport
+{
+public:
+	virtual ~FChanneldTcpTransport() override;
+
+	virtual bool Connect(const FInternetAddr& Addr, FString& Error) override;
+	virtual void Close() override;
+	virtual bool IsConnected() const override;
+	virtual bool IsConnecting() const override;
+	virtual bool Send(const uint8* Data, int32 Count, int32& BytesSent) override;
+	virtual bool Recv(uint8* Data, int32 BufferSize, int32& BytesRead) override;
+	virtual bool Wait(FTimespan Timeout) override;
+	virtual FSocket* GetSocket() const override { return Socket; }
+
+private:
+	FSocket* Socket = nullptr;
+	// Set by Connect() and cleared by IsConnecting() once the TCP handshake is done or failed.
+	mutable bool bConnecting = false;
+};
+
+/**
+ * @brief KCP over UDP. Requires channeld to listen for the clients with the KCP network type.
+ * The lost packets are resent much sooner than TCP, so the movement stalls less on lossy networks, at the cost of more bandwidth.
+ */
+class CHANNELDUE_API FChanneldKcpTransport : public FChanneldTransport
+{
+public:
+	virtual ~FChanneldKcpTransport() override;
+
+	virtual bool Connect(const FInternetAddr& Addr, FString& Error) override;
+	virtual void Close() override;
+	virtual bool IsConnected() const override;
+	virtual bool Send(const uint8* Data, int32 Count, int32& BytesSent) override;
+	virtual bool Recv(uint8* Data, int32 BufferSize, int32& BytesRead) override;
+	virtual bool Wait(FTimespan Timeout) override;
+	virtual FSocket* GetSocket() const override { return Socket; }
+
+private:
+	// Feed the received datagrams to KCP and update its timers. Must be called with KcpLock locked.
+	void Pump();
+
+	FSocket* Socket = nullptr;
+	TSharedPtr<FInternetAddr> RemoteAddr;
+	TSharedPtr<FInternetAddr> FromAddr;
+	TUniquePtr<FChanneldKcp> Kcp;
+	// The receive thread, the send thread and the game thread can access KCP at the same time.
+	FCriticalSection KcpLock;
+	TArray<uint8> DatagramBuffer;
+	// A received message that doesn't fit in the buffer passed to Recv().
+	TArray<uint8> PendingRecv;
+	int32 PendingRecvOffset = 0;
+};
+
+/**
+ * @brief Plays back the incoming traffic of a capture file (see FChanneldCaptureWriter) without a socket.
+ * The outgoing data is discarded. Used to benchmark the receive, dispatch and view pipeline offline.
+ */
+class CHANNELDUE_API FChanneldReplayTransport : public FChanneldTransport
+{
+public:
+	/**
+	 * @param bInRealTime Play back the records with the recorded timing. Otherwise, all the records are available at once.
+	 */
+	FChanneldReplayTransport(const FString& InFilePath, bool bInRealTime) : FilePath(InFilePath), bRealTime(bInRealTime) {}
+
+	virtual bool Connect(const FInternetAddr& Addr, FString& Error) override;
+	virtual void Close() override;
+	virtual bool IsConnected() const override { return bOpen; }
+	virtual bool Send(const uint8* Data, int32 Count, int32& BytesSent) override;
+	virtual bool Recv(uint8* Data, int32 BufferSize, int32& BytesRead) override;
+	virtual bool Wait(FTimespan Timeout) override;
+	virtual FSocket* GetSocket() const override { return nullptr; }
+
+	FORCEINLINE bool IsFinished() const { return RecordIndex >= Capture.Records.Num(); }
+
+private:
+	// Skip the outgoing records. Returns the next incoming record that is due, or nullptr.
+	const ChanneldCapture::FRecord* PeekDueRecord();
+
+	FString FilePath;
+	bool bRealTime;
+	FThreadSafeBool bOpen = false;
+	FChanneldCaptureReader Capture;
+	int32 RecordIndex = 0;
+	// The bytes of the current record that are already read.
+	int32 RecordOffset = 0;
+	double StartTime = 0;
+	// The receive thread and the thread calling UChanneldConnection::WaitForIncoming() can access the records at the same time.
+	FCriticalSection ReplayLock;
+};
+
+/**
+ * @brief Plays back a match record (see FChanneldMatchRecordWriter) as the incoming traffic, so it goes through UChanneldConnection and
+ * UChannelDataView the same way as the live match. The playback starts from the latest keyframe at or before the start time: the
+ * earlier records that set up the session (the auth, subscriptions, spawns, destroys, etc.) are played back at once, but not the
+ * channel data updates and the RPCs, which the keyframe supersedes. The outgoing data is discarded.
+ */
+class CHANNELDUE_API FChanneldMatchPlaybackTransport : public FChanneldTransport
+{
+public:
+	/**
+	 * @param InStartTime Seconds since the start of the recording to start the playback from.
+	 */
+	FChanneldMatchPlaybackTransport(const FString& InFilePath, double InStartTime) : FilePath(InFilePath), PlaybackStartTime(InStartTime) {}
+
+	virtual bool Connect(const FInternetAddr& Addr, FString& Error) override;
+	virtual void Close() override;
+	virtual bool IsConnected() const override { return bOpen; }
+	virtual bool Send(const uint8* Data, int32 Count, int32& BytesSent) override;
+	virtual bool Recv(uint8* Data, int32 BufferSize, int32& BytesRead) override;
+	virtual bool Wait(FTimespan Timeout) override;
+	virtual FSocket* GetSocket() const override { return nullptr; }
+
+	FORCEINLINE bool IsFinished() const { return RecordIndex >= MatchRecord.Records.Num(); }
+
+private:
+	// Skip the records superseded by the starting keyframe. Returns the next record that is due, or nullptr.
+	const ChanneldMatchRecord::FRecord* PeekDueRecord();
+	// Frame the record as a packet of a single message.
+	void BuildPacket(const ChanneldMatchRecord::FRecord& Record);
+
+	FString FilePath;
+	double PlaybackStartTime;
+	FThreadSafeBool bOpen = false;
+	FChanneldMatchRecordReader MatchRecord;
+	int32 RecordIndex = 0;
+	// The records of the starting keyframe. The other keyframes are skipped.
+	int32 KeyframeBeginIndex = 0;
+	int32 KeyframeEndIndex = 0;
+	double KeyframeTime = 0;
+	// The packet of the last record and the bytes of it that are already read.
+	TArray<uint8> PacketBuffer;
+	int32 PacketOffset = 0;
+	double StartTime = 0;
+	FCriticalSection PlaybackLock;
+};
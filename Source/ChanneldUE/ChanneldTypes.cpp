@@ -1,3 +1,19 @@
 #include "ChanneldTypes.h"
 
-DEFINE_LOG_CATEGORY(LogChanneld);
\ No newline at end of file
+DEFINE_LOG_CATEGORY(LogChanneld);
+
+bool FChanneldLogRateLimiter::ShouldLog(double IntervalSeconds, int32& OutNumSuppressed)
+{
+	const int64 Now = FPlatformTime::Cycles64();
+	const int64 Next = FPlatformAtomics::AtomicRead(&NextLogCycles);
+	// Only the thread that moves the time forward writes the log.
+	if (Now < Next || FPlatformAtomics::InterlockedCompareExchange(&NextLogCycles, Now + static_cast<int64>(IntervalSeconds / FPlatformTime::GetSecondsPerCycle64()), Next) != Next)
+	{
+		NumSuppressed.Increment();
+		return false;
+	}
+	OutNumSuppressed = NumSuppressed.Reset();
+	return true;
+}
+
+UE_TRACE_CHANNEL_DEFINE(ChanneldChannel);
\ No newline at end of file
@@ -1,10 +1,64 @@
 #pragma once
 #include "channeld.pb.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
 
 //#include "Engine/EngineBaseTypes.h"
 #include "ChanneldTypes.generated.h"
 
-DECLARE_LOG_CATEGORY_EXTERN(LogChanneld, Log, All);
+// The most verbose logs of LogChanneld that are compiled. The less verbose ones are stripped along with their arguments,
+// e.g. define it as Log in the Build.cs to strip the Verbose and VeryVerbose logs from a production build.
+#ifndef CHANNELD_LOG_COMPILE_VERBOSITY
+	#if UE_BUILD_SHIPPING
+		#define CHANNELD_LOG_COMPILE_VERBOSITY Log
+	#else
+		#define CHANNELD_LOG_COMPILE_VERBOSITY All
+	#endif
+#endif
+
+DECLARE_LOG_CATEGORY_EXTERN(LogChanneld, Log, CHANNELD_LOG_COMPILE_VERBOSITY);
+
+// Allows one log per interval from a call site, and counts the ones suppressed in between. Thread-safe.
+struct CHANNELDUE_API FChanneldLogRateLimiter
+{
+	// Returns true if the log should be written. OutNumSuppressed is the number of the logs suppressed since the last one written.
+	bool ShouldLog(double IntervalSeconds, int32& OutNumSuppressed);
+
+private:
+	volatile int64 NextLogCycles = 0;
+	FThreadSafeCounter NumSuppressed;
+};
+
+/**
+ * Log at most once per IntervalSeconds from the call site, e.g. the warnings that can be triggered every frame or by every message.
+ * The arguments are only evaluated when the log is written, so the heavy formatting (DebugString(), joining the NetIds) should go here.
+ */
+#define CHANNELD_LOG_RATE_LIMITED(CategoryName, Verbosity, IntervalSeconds, Format, ...) \
+	do \
+	{ \
+		if (UE_LOG_ACTIVE(CategoryName, Verbosity)) \
+		{ \
+			static FChanneldLogRateLimiter ChanneldLogRateLimiter; \
+			int32 ChanneldLogNumSuppressed; \
+			if (ChanneldLogRateLimiter.ShouldLog(IntervalSeconds, ChanneldLogNumSuppressed)) \
+			{ \
+				if (ChanneldLogNumSuppressed > 0) \
+				{ \
+					UE_LOG(CategoryName, Verbosity, Format TEXT(" (%d similar logs suppressed)"), ##__VA_ARGS__, ChanneldLogNumSuppressed); \
+				} \
+				else \
+				{ \
+					UE_LOG(CategoryName, Verbosity, Format, ##__VA_ARGS__); \
+				} \
+			} \
+		} \
+	} while (0)
+
+// The Unreal Insights trace channel of the networking pipeline of the plugin. Enable it with `-trace=cpu,channeld` or `Trace.Enable channeld`.
+UE_TRACE_CHANNEL_EXTERN(ChanneldChannel, CHANNELDUE_API);
+#define CHANNELD_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, ChanneldChannel)
+// The name is a TCHAR* evaluated at every call, so it should be cached rather than built in place.
+#define CHANNELD_TRACE_SCOPE_TEXT(Name) TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(Name, ChanneldChannel)
 
 namespace Channeld
 {
@@ -26,10 +80,43 @@ namespace Channeld
 
 	constexpr uint32 GameStateNetId = 0x00080000;
 
+	// Same as channeld: the spatial channels are allocated from SpatialChannelIdStart, and the entity channels take the netIds
+	// from EntityChannelIdStart. The channels below SpatialChannelIdStart are of the other types, e.g. PRIVATE and SUBWORLD.
+	constexpr ChannelId SpatialChannelIdStart = 0x00010000;
+	constexpr ChannelId EntityChannelIdStart = 0x00080000;
+
 	constexpr uint32 MaxPacketSize = 0x00ffff;
+	// A packet that only holds a single message larger than MaxPacketSize. The high byte of the size is carried
+	// in the second byte of the header, in place of the 'H' tag.
+	constexpr uint32 MaxLargePacketSize = 0x3fffff;
 	constexpr uint32 MinPacketSize = 20;
+	// The upper limit of a decompressed packet, to protect the receiver from malformed compressed data.
+	constexpr uint32 MaxUncompressedPacketSize = MaxLargePacketSize;
 	constexpr uint8 MaxConnectionIdBits = 13;
 	constexpr uint8 ConnectionIdBitOffset = (31 - MaxConnectionIdBits);
+	// The NetIds of the static actors precomputed in the cook (see FChanneldStaticActorTable) take the range of the last ConnectionId,
+	// which channeld is not expected to assign.
+	constexpr uint32 StaticActorNetIdOffset = ((1u << MaxConnectionIdBits) - 1) << ConnectionIdBitOffset;
+
+	// The user-space message between the spatial servers that carries the actors about to be handed over. Not defined in unrealpb::MessageType.
+	constexpr uint32 HandoverPrefetchMsgType = 110;
+	// The user-space message that reports the load of a spatial server to the owner of the global channel. See UChanneldSettings::SpatialLoadReportInterval.
+	constexpr uint32 SpatialLoadReportMsgType = 111;
+	// The user-space message that asks the owner of a spatial channel to update the subscription options of a client. See UAreaOfInterestBase::bOverrideSubOptions.
+	constexpr uint32 SpatialSubOptionsMsgType = 112;
+	// The user-space message that carries the simulated movement of a load test bot (see UChanneldLoadTestBot). The receivers can ignore it.
+	constexpr uint32 LoadTestInputMsgType = 113;
+	// The user-space message that carries the replicated classes of the actors in the spatial channels of a server to the clients. See UChanneldSettings::SpatialClassSummaryInterval.
+	constexpr uint32 SpatialClassSummaryMsgType = 114;
+	// The user-space message from the server that hands over the objects to the other spatial servers, which carries the new owning channel of the objects.
+	// See UChanneldSettings::bBroadcastOwnershipChanges.
+	constexpr uint32 OwnershipChangeMsgType = 115;
+	// The user-space message from the server that destroys multiple objects in a client. The payload is the repeated unrealpb::DestroyObjectMessage
+	// in field 1, i.e. the same bytes as a message with a repeated DestroyObjectMessage field. See UChanneldSettings::bBatchDestroyMessages.
+	constexpr uint32 DestroyObjectsMsgType = 116;
+	// The user-space message from the spatial server to the other servers, which carries the spatial channels it owns as a
+	// channeldpb::CreateSpatialChannelsResultMessage. See UChanneldSettings::SpatialOwnerHeartbeatInterval.
+	constexpr uint32 SpatialOwnerHeartbeatMsgType = 117;
 
 	const FName GameplayerDebuggerClassName = FName("GameplayDebuggerCategoryReplicator");
 	
@@ -79,6 +166,44 @@ enum class EChanneldBroadcastType : uint8
 	EBT_ADJACENT_CHANNELS = 0x10 UMETA(DisplayName = "AdjacentChannels"),
 };
 
+// The outgoing messages are queued in separate lanes. The lanes are flushed in the order below every tick, each with its own byte budget.
+UENUM(BlueprintType)
+enum class EChanneldSendLane : uint8
+{
+	// Latency-critical traffic, e.g. the LOW_LEVEL packets (movement) and RPCs.
+	ESL_Critical = 0 UMETA(DisplayName = "Critical"),
+	ESL_ChannelData = 1 UMETA(DisplayName = "ChannelData"),
+	// Bulk traffic that can be spread across multiple ticks, e.g. spawning the existing actors to a new player.
+	ESL_Bulk = 2 UMETA(DisplayName = "Bulk"),
+
+	ESL_Max UMETA(Hidden),
+	// Decide the lane by the message type. See UChanneldConnection::GetSendLane().
+	ESL_Auto = 0xff UMETA(Hidden),
+};
+
+// The transport between UChanneldConnection and channeld. See FChanneldTransport.
+UENUM(BlueprintType)
+enum class EChanneldTransportType : uint8
+{
+	ETT_TCP = 0 UMETA(DisplayName = "TCP"),
+	// KCP over UDP. channeld should listen for the clients with the KCP network type.
+	ETT_KCP = 1 UMETA(DisplayName = "KCP"),
+};
+
+// The priority of the network threads of UChanneldConnection. Mapped to EThreadPriority, which is not a UENUM.
+UENUM()
+enum class EChanneldThreadPriority : uint8
+{
+	ETP_Normal = 0 UMETA(DisplayName = "Normal"),
+	ETP_AboveNormal UMETA(DisplayName = "Above Normal"),
+	ETP_Highest UMETA(DisplayName = "Highest"),
+	// The highest priority of UE's threads, e.g. the audio mixer. On Linux, it's the only priority that raises the thread above the
+	// game thread without the privilege of the real-time scheduling.
+	ETP_TimeCritical UMETA(DisplayName = "Time Critical"),
+	ETP_BelowNormal UMETA(DisplayName = "Below Normal"),
+	ETP_Lowest UMETA(DisplayName = "Lowest"),
+};
+
 UENUM(BlueprintType)
 enum class EChannelDataAccess : uint8
 {
@@ -267,6 +392,40 @@ struct CHANNELDUE_API FListedChannelInfo
 	FString Metadata;
 };
 
+// A distance band of the replication LOD. See UChanneldSettings::ReplicationLODBands.
+USTRUCT(BlueprintType)
+struct CHANNELDUE_API FChanneldReplicationLODBand
+{
+	GENERATED_BODY()
+
+	// The max distance from the client's pawn to the entity in the band. The entities farther than all the bands are in the last band.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float MaxDistance = 0;
+
+	// The interval channeld fans out the entity channel data to the client.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1"))
+	int32 FanOutIntervalMs = 20;
+
+	// If not empty, only these fields of the entity channel data are fanned out to the client, e.g. only the location of the far entities.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> DataFieldMasks;
+};
+
+// How the unreliable calls of an RPC function are limited. See UChanneldSettings::UnreliableRPCLimits.
+USTRUCT(BlueprintType)
+struct CHANNELDUE_API FChanneldUnreliableRPCLimit
+{
+	GENERATED_BODY()
+
+	// The max calls per second of the function on the same target object. The calls over the limit are dropped. 0 means unlimited.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float MaxCallsPerSecond = 0;
+
+	// Only send the last call of the function on the same target object in a frame. Requires UChanneldSettings::bBatchUnreliableRPCs.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bLatestWins = false;
+};
+
 UENUM(BlueprintType)
 enum class EClientInterestAreaType : uint8
 {
@@ -295,6 +454,31 @@ struct CHANNELDUE_API FClientInterestSettingsPreset
 	UPROPERTY(Config, EditAnywhere, Category = "Default")
 	float MinDistanceToTriggerUpdate = 100.0f;
 
+	// Used by SphereAOI, BoxAOI and ConeAOI. The extra distance added to the interest area. The interest is not updated until the following
+	// actor moves beyond it, so moving back and forth along a cell border doesn't subscribe and unsubscribe the spatial channels repeatedly.
+	UPROPERTY(EditAnywhere, Category="Default")
+	float HysteresisMargin = 0.0f;
+
+	// Used by SphereAOI, BoxAOI and ConeAOI. Move the center of the interest area ahead along the velocity of the following pawn by the seconds.
+	UPROPERTY(EditAnywhere, Category="Default")
+	float LookAheadSeconds = 0.0f;
+
+	// Used by SphereAOI, BoxAOI and ConeAOI. Query the spatial regions the area overlaps, resolved from the local spatial region index,
+	// and only update the interest when they change.
+	UPROPERTY(EditAnywhere, Category="Default")
+	bool bQueryCoveredRegions = false;
+
+	// Used by SphereAOI, BoxAOI and ConeAOI. Subscribe the client to the spatial channels in the area with the fan-out interval and the data field masks below.
+	// The first active area that overlaps a spatial channel decides its options, so the inner areas should be added first.
+	UPROPERTY(EditAnywhere, Category="Default")
+	bool bOverrideSubOptions = false;
+
+	UPROPERTY(EditAnywhere, Category="Default", meta = (ClampMin = "1"))
+	int32 FanOutIntervalMs = 20;
+
+	UPROPERTY(EditAnywhere, Category="Default")
+	TArray<FString> DataFieldMasks;
+
 	// Used by SpotsAOI
 	UPROPERTY(EditAnywhere, Category="Spots AOI")
 	TMap<FVector, uint32> SpotsAndDists;
@@ -311,4 +495,8 @@ struct CHANNELDUE_API FClientInterestSettingsPreset
 	// Used by ConeAOI
 	UPROPERTY(EditAnywhere, Category="Cone AOI")
 	float Angle = 120.0f;
+
+	// Used by ConeAOI. The extra angle added to the cone. The direction is not updated until it turns beyond half of it.
+	UPROPERTY(EditAnywhere, Category="Cone AOI")
+	float AngleHysteresis = 0.0f;
 };
\ No newline at end of file
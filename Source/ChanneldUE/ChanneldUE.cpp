@@ -12,6 +12,9 @@
 #include "Replication/ChanneldActorComponentReplicator.h"
 #include "Replication/ChanneldSceneComponentReplicator.h"
 #include "Replication/ChanneldStaticMeshComponentReplicator.h"
+#include "Replication/ChanneldSkeletalMeshComponentReplicator.h"
+#include "Replication/ChanneldProjectileMovementComponentReplicator.h"
+#include "Replication/ChanneldAbilitySystemComponentReplicator.h"
 #include "Replication/ChanneldCharacterReplicator.h"
 #include "Replication/ChanneldControllerReplicator.h"
 #include "Replication/ChanneldPlayerControllerReplicator.h"
@@ -45,14 +48,31 @@ void FChanneldUEModule::StartupModule()
 	REGISTER_REPLICATOR(FChanneldActorComponentReplicator, UActorComponent);
 	REGISTER_REPLICATOR(FChanneldSceneComponentReplicator, USceneComponent);
 	REGISTER_REPLICATOR(FChanneldStaticMeshComponentReplicator, UStaticMeshComponent);
+	REGISTER_REPLICATOR(FChanneldSkeletalMeshComponentReplicator, USkeletalMeshComponent);
+	REGISTER_REPLICATOR(FChanneldProjectileMovementComponentReplicator, UProjectileMovementComponent);
+	// GameplayAbilities is an optional plugin, so the replicator is registered when its module is loaded.
+	if (!FChanneldAbilitySystemComponentReplicator::Register())
+	{
+		FModuleManager::Get().OnModulesChanged().AddRaw(this, &FChanneldUEModule::OnModulesChanged);
+	}
 
 	SpatialChannelDataProcessor = new FDefaultSpatialChannelDataProcessor();
 	ChanneldReplication::RegisterChannelDataProcessor(TEXT("unrealpb.SpatialChannelData"), SpatialChannelDataProcessor);
 }
 
+void FChanneldUEModule::OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	if (ModuleName == TEXT("GameplayAbilities") && Reason == EModuleChangeReason::ModuleLoaded && FChanneldAbilitySystemComponentReplicator::Register())
+	{
+		FModuleManager::Get().OnModulesChanged().RemoveAll(this);
+	}
+}
+
 void FChanneldUEModule::ShutdownModule()
 {
+	FModuleManager::Get().OnModulesChanged().RemoveAll(this);
 	delete SpatialChannelDataProcessor;
+	FChanneldReplicatorBase::EmptyStatePools();
 	
 	if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
 	{
@@ -14,4 +14,6 @@ public:
 
 private:
 	FDefaultSpatialChannelDataProcessor* SpatialChannelDataProcessor;
+
+	void OnModulesChanged(FName ModuleName, EModuleChangeReason Reason);
 };
@@ -2,10 +2,13 @@
 
 #include "ChanneldGameInstanceSubsystem.h"
 #include "ChanneldNetDriver.h"
+#include "ChanneldPackageMapClient.h"
+#include "ChanneldRepClassTable.h"
+#include "ChanneldSettings.h"
 #include "ChanneldTypes.h"
+#include "Misc/PackageName.h"
 
-TMap<uint32, TSharedRef<unrealpb::UnrealObjectRef>> ChanneldUtils::ObjRefCache;
-UChanneldNetConnection* ChanneldUtils::NetConnForSpawn;
+TArray<TWeakObjectPtr<AActor>>* ChanneldUtils::DeferredPostNetInitActors = nullptr;
 
 UObject* ChanneldUtils::GetObjectByRef(const unrealpb::UnrealObjectRef* Ref, UWorld* World, bool& bNetGUIDUnmapped, bool bCreateIfNotInCache, UChanneldNetConnection* ClientConn)
 {
@@ -34,7 +37,13 @@ UObject* ChanneldUtils::GetObjectByRef(const unrealpb::UnrealObjectRef* Ref, UWo
 		return nullptr;
 	}
 	auto GuidCache = World->GetNetDriver()->GuidCache;
-	auto Obj = GuidCache->GetObjectFromNetGUID(NetGUID, false);
+	FChanneldResolvedObjCache* ResolvedObjCache = GetResolvedObjCache(World);
+	UObject* Obj = ResolvedObjCache ? ResolvedObjCache->Find(NetGUID.Value) : nullptr;
+	const bool bResolvedFromCache = Obj != nullptr;
+	if (!bResolvedFromCache)
+	{
+		Obj = GuidCache->GetObjectFromNetGUID(NetGUID, false);
+	}
 	if (Obj == nullptr && bCreateIfNotInCache)
 	{
 		if (!GuidCache->IsNetGUIDAuthority() || ClientConn)
@@ -62,7 +71,7 @@ UObject* ChanneldUtils::GetObjectByRef(const unrealpb::UnrealObjectRef* Ref, UWo
 				}
 				*/
 				
-				FString PathName = UTF8_TO_TCHAR(CachedObj->pathname().c_str());
+				FString PathName = DecodeObjRefPath(CachedObj->pathname());
 				// Remap name for PIE
 				GEngine->NetworkRemapPath(Connection, PathName, true);
 				if (ClientConn)
@@ -122,7 +131,14 @@ UObject* ChanneldUtils::GetObjectByRef(const unrealpb::UnrealObjectRef* Ref, UWo
 						GEngine->Exec(nullptr, TEXT("log Actor off"));
 						*/
 						// After all properties have been initialized, call PostNetInit. This should call BeginPlay() so initialization can be done with proper starting values.
-						Actor->PostNetInit();
+						if (DeferredPostNetInitActors)
+						{
+							DeferredPostNetInitActors->Add(Actor);
+						}
+						else
+						{
+							Actor->PostNetInit();
+						}
 						// GEngine->Exec(nullptr, TEXT("log Actor on"));
 
 						UE_LOG(LogChanneld, Verbose, TEXT("[Client] Created new actor '%s' with NetGUID %d (%d)"), *Actor->GetName(), GuidCache->GetNetGUID(Actor).Value, ChanneldUtils::GetNativeNetId(Ref->netguid()));
@@ -132,10 +148,10 @@ UObject* ChanneldUtils::GetObjectByRef(const unrealpb::UnrealObjectRef* Ref, UWo
 						//Channel->ConditionalCleanUp(true, EChannelCloseReason::Destroyed);
 						*/
 						
-						if (ClientConn && ClientConn == NetConnForSpawn)
+						if (ClientConn && IsNetConnForSpawn(ClientConn))
 						{
 							// Always remember to reset the NetConnForSpawn after using it.
-							ResetNetConnForSpawn();
+							ResetNetConnForSpawn(ClientConn);
 						}
 						
 						Obj = Actor;
@@ -143,7 +159,7 @@ UObject* ChanneldUtils::GetObjectByRef(const unrealpb::UnrealObjectRef* Ref, UWo
 				}
 				else if (Ref->has_classpath())
 				{
-					FString PathName = UTF8_TO_TCHAR(Ref->classpath().c_str());
+					FString PathName = DecodeObjRefPath(Ref->classpath());
 					if (auto ObjClass = LoadObject<UClass>(nullptr, *PathName))
 					{
 						Obj = NewObject<UObject>(GetTransientPackage(), ObjClass);
@@ -163,7 +179,14 @@ UObject* ChanneldUtils::GetObjectByRef(const unrealpb::UnrealObjectRef* Ref, UWo
 							// Triggers UChanneldNetDriver::NotifyActorChannelOpen
 							World->GetNetDriver()->NotifyActorChannelOpen(nullptr, Actor);
 							// After all properties have been initialized, call PostNetInit. This should call BeginPlay() so initialization can be done with proper starting values.
-							Actor->PostNetInit();
+							if (DeferredPostNetInitActors)
+							{
+								DeferredPostNetInitActors->Add(Actor);
+							}
+							else
+							{
+								Actor->PostNetInit();
+							}
 						}
 					}
 					else
@@ -186,12 +209,17 @@ UObject* ChanneldUtils::GetObjectByRef(const unrealpb::UnrealObjectRef* Ref, UWo
 	}
 	else
 	{
+		if (ResolvedObjCache && !bResolvedFromCache)
+		{
+			ResolvedObjCache->Add(NetGUID.Value, Obj);
+		}
 		// Only cache the full-exported UnrealObjectRef
-		if (Ref->context_size() > 0 && !ObjRefCache.Contains(NetGUID.Value))
+		FChanneldObjRefCache* ObjRefCache = GetObjRefCache(World);
+		if (Ref->context_size() > 0 && ObjRefCache && !ObjRefCache->Contains(NetGUID.Value, Obj))
 		{
 			auto Cached = MakeShared<unrealpb::UnrealObjectRef>();
 			Cached->CopyFrom(*Ref);
-			ObjRefCache.Emplace(NetGUID.Value, Cached);
+			ObjRefCache->Add(NetGUID.Value, Obj, Cached);
 			UE_LOG(LogChanneld, Verbose, TEXT("Cached ObjRef: %d, context size: %d"), NetGUID.Value, Ref->context_size());
 		}
 	}
@@ -223,14 +251,18 @@ TSharedRef<unrealpb::UnrealObjectRef> ChanneldUtils::GetRefOfObject(UObject* Obj
 	}
 	/*
 	*/
-	if (const auto Cached = ObjRefCache.Find(NetGUID.Value))
+	FChanneldObjRefCache* ObjRefCache = GetObjRefCache(World);
+	if (ObjRefCache)
 	{
-		UE_LOG(LogChanneld, VeryVerbose, TEXT("Use cached ObjRef: %d"), NetGUID.Value);
-		return *Cached;
+		if (const auto Cached = ObjRefCache->Find(NetGUID.Value, Obj))
+		{
+			UE_LOG(LogChanneld, VeryVerbose, TEXT("Use cached ObjRef: %d"), NetGUID.Value);
+			return Cached.ToSharedRef();
+		}
 	}
 
 	// Always set the classpath as it will be used in USpatialChannelDataView::CheckUnspawnedObject
-	ObjRef->set_classpath(std::string(TCHAR_TO_UTF8(*Obj->GetClass()->GetPathName())));
+	ObjRef->set_classpath(EncodeObjRefPath(Obj->GetClass()->GetPathName()));
 	
 	if (Obj->IsA<AActor>() && GuidCache->IsNetGUIDAuthority())
 	{
@@ -241,7 +273,7 @@ TSharedRef<unrealpb::UnrealObjectRef> ChanneldUtils::GetRefOfObject(UObject* Obj
 		}
 		if (Connection == nullptr)
 		{
-			Connection = NetConnForSpawn;
+			Connection = GetNetConnForSpawn(Actor->GetWorld());
 		}
 		if (!IsValid(Connection))
 		{
@@ -249,9 +281,10 @@ TSharedRef<unrealpb::UnrealObjectRef> ChanneldUtils::GetRefOfObject(UObject* Obj
 			return ObjRef;
 		}
 		
-		ObjRef->set_owningconnid(CastChecked<UChanneldNetConnection>(Connection)->GetConnId());
+		UChanneldNetConnection* ChanneldConn = CastChecked<UChanneldNetConnection>(Connection);
+		ObjRef->set_owningconnid(ChanneldConn->GetConnId());
 		
-		auto PackageMap = Cast<UPackageMapClient>(Connection->PackageMap);
+		auto PackageMap = Cast<UChanneldPackageMapClient>(Connection->PackageMap);
 		
 		if (IsValid(PackageMap))
 		{
@@ -259,28 +292,24 @@ TSharedRef<unrealpb::UnrealObjectRef> ChanneldUtils::GetRefOfObject(UObject* Obj
 			// If the NetGUID is already created but hasn't been exported to the client yet, we need to send the CachedObjects as well.
 			if (!NetGUID.IsValid() || !PackageMap->NetGUIDExportCountMap.Contains(NetGUID))
 			{
-				TSet<FNetworkGUID> OldGUIDs;
-				PackageMap->NetGUIDExportCountMap.GetKeys(OldGUIDs);
+				// The NetGUIDs newly exported during SerializeNewActor()
+				TArray<FNetworkGUID> NewGUIDs;
+				PackageMap->BeginExportRecording(NewGUIDs);
 
 				//--------------------------------------------------
 				// Copied from UActorChannel::ReplicateActor (L3121)
 				//--------------------------------------------------
 				FOutBunch Ar(PackageMap);
 				Ar.bReliable = true;
-				UActorChannel* Channel = (UActorChannel*)Connection->CreateChannelByName(NAME_Actor, EChannelCreateFlags::None);
+				UActorChannel* Channel = ChanneldConn->BindExportChannel(Actor);
 				UE_LOG(LogChanneld, VeryVerbose, TEXT("[Server] ActorChannels: %d"), Connection->ActorChannelsNum());
-				Channel->SetChannelActor(Actor, ESetChannelActorFlags::None);
 				PackageMap->SerializeNewActor(Ar, Channel, Actor);
 				Actor->OnSerializeNewActor(Ar);
 				//--------------------------------------------------
 
+				PackageMap->EndExportRecording();
 				NetGUID = GuidCache->GetNetGUID(Obj);
 
-				TSet<FNetworkGUID> NewGUIDs;
-				PackageMap->NetGUIDExportCountMap.GetKeys(NewGUIDs);
-				// Find the newly-registered NetGUIDs during SerializeNewActor()
-				NewGUIDs = NewGUIDs.Difference(OldGUIDs);
-
 				for (FNetworkGUID& NewGUID : NewGUIDs)
 				{
 					// Don't send the target NetGUID in the context if it's dynamic
@@ -290,24 +319,27 @@ TSharedRef<unrealpb::UnrealObjectRef> ChanneldUtils::GetRefOfObject(UObject* Obj
 					auto NewCachedObj = GuidCache->GetCacheObject(NewGUID);
 					auto Context = ObjRef->add_context();
 					Context->set_netguid(NewGUID.Value);
-					Context->set_pathname(std::string(TCHAR_TO_UTF8(*NewCachedObj->PathName.ToString())));
+					Context->set_pathname(EncodeObjRefPath(NewCachedObj->PathName.ToString(), !NewCachedObj->OuterGUID.IsValid()));
 					Context->set_outerguid(NewCachedObj->OuterGUID.Value);
 					UE_LOG(LogChanneld, Verbose, TEXT("[Server] Send registered NetGUID %d with path: %s"), NewGUID.Value, *NewCachedObj->PathName.ToString());
 				}
 				ObjRef->set_netguidbunch(Ar.GetData(), Ar.GetNumBytes());
 				ObjRef->set_bunchbitsnum(Ar.GetNumBits());
 
-				// Remove the channel after using it
-				Channel->ConditionalCleanUp(true, EChannelCloseReason::Destroyed);
+				// Unbind the channel to reuse it for the next actor
+				ChanneldConn->UnbindExportChannel();
 
-				if (Connection == NetConnForSpawn)
+				if (IsNetConnForSpawn(Connection))
 				{
 					// Clear the export map and ack state so everytime we can get a full export.
-					ResetNetConnForSpawn();
+					ResetNetConnForSpawn(Connection);
 				}
 
 				// Only cache the full-exported UnrealObjectRef
-				ObjRefCache.Emplace(NetGUID.Value, ObjRef);
+				if (ObjRefCache)
+				{
+					ObjRefCache->Add(NetGUID.Value, Obj, ObjRef);
+				}
 				UE_LOG(LogChanneld, Verbose, TEXT("Cached ObjRef: %d, context size: %d"), NetGUID.Value, ObjRef->context_size());
 			}
 			//else
@@ -317,7 +349,7 @@ TSharedRef<unrealpb::UnrealObjectRef> ChanneldUtils::GetRefOfObject(UObject* Obj
 		}
 		else
 		{
-			UE_LOG(LogChanneld, Warning, TEXT("ChanneldUtils::GetRefOfObject: Failed to get the ref of %s: the Actor's NetConnection has no PackageMapClient"), *Obj->GetName());
+			UE_LOG(LogChanneld, Warning, TEXT("ChanneldUtils::GetRefOfObject: Failed to get the ref of %s: the Actor's NetConnection has no ChanneldPackageMapClient"), *Obj->GetName());
 		}
 	}
 
@@ -325,9 +357,112 @@ TSharedRef<unrealpb::UnrealObjectRef> ChanneldUtils::GetRefOfObject(UObject* Obj
 	return ObjRef;
 }
 
-void ChanneldUtils::ResetNetConnForSpawn()
+std::string ChanneldUtils::EncodeObjRefPath(const FString& PathName, bool bPackage)
+{
+	const FChanneldRepClassTable& ClassTable = FChanneldRepClassTable::Get();
+	if (GetMutableDefault<UChanneldSettings>()->bCompactObjRefPaths && ClassTable.IsLoaded())
+	{
+		// The package of a blueprint class, e.g. /Game/BP_Foo of /Game/BP_Foo.BP_Foo_C
+		const FString ClassPath = bPackage ? FString::Printf(TEXT("%s.%s_C"), *PathName, *FPackageName::GetShortName(PathName)) : PathName;
+		const int32 Index = ClassTable.FindClass(ClassPath);
+		if (Index != INDEX_NONE)
+		{
+			return std::string(TCHAR_TO_UTF8(*FString::Printf(TEXT("#%016llx%s"), ClassTable.GetEntry(Index).PathHash, bPackage ? TEXT(".") : TEXT(""))));
+		}
+	}
+	return std::string(TCHAR_TO_UTF8(*PathName));
+}
+
+FString ChanneldUtils::DecodeObjRefPath(const std::string& EncodedPath)
+{
+	// A path never starts with '#', so the plain strings pass through.
+	if (EncodedPath.size() < 17 || EncodedPath[0] != '#')
+	{
+		return UTF8_TO_TCHAR(EncodedPath.c_str());
+	}
+
+	const FChanneldRepClassTable& ClassTable = FChanneldRepClassTable::Get();
+	const uint64 PathHash = FCString::Strtoui64(UTF8_TO_TCHAR(EncodedPath.substr(1, 16).c_str()), nullptr, 16);
+	const int32 Index = ClassTable.FindClassByHash(PathHash);
+	if (Index == INDEX_NONE)
+	{
+		UE_LOG(LogChanneld, Warning, TEXT("ChanneldUtils::DecodeObjRefPath: %hs is not in the replicated class table. Make sure the servers and the clients package the same RepClassTable.bin."), EncodedPath.c_str());
+		return FString();
+	}
+	const FString ClassPath = ClassTable.GetPathName(Index);
+	return EncodedPath.size() > 17 && EncodedPath[17] == '.' ? FPackageName::ObjectPathToPackageName(ClassPath) : ClassPath;
+}
+
+FChanneldObjRefCache* ChanneldUtils::GetObjRefCache(const UWorld* World)
+{
+	if (UChanneldNetDriver* NetDriver = Cast<UChanneldNetDriver>(World->GetNetDriver()))
+	{
+		return &NetDriver->ObjRefCache;
+	}
+	return nullptr;
+}
+
+FChanneldResolvedObjCache* ChanneldUtils::GetResolvedObjCache(const UWorld* World)
 {
-	auto PacketMapClient = CastChecked<UPackageMapClient>(NetConnForSpawn->PackageMap);
+	UChanneldNetDriver* NetDriver = Cast<UChanneldNetDriver>(World->GetNetDriver());
+	if (NetDriver && !NetDriver->IsServer() && GetMutableDefault<UChanneldSettings>()->bCacheResolvedObjRefs)
+	{
+		return &NetDriver->ResolvedObjCache;
+	}
+	return nullptr;
+}
+
+void ChanneldUtils::InitNetConnForSpawn(UChanneldNetConnection* InNetConn)
+{
+	if (UChanneldNetDriver* NetDriver = Cast<UChanneldNetDriver>(InNetConn->Driver))
+	{
+		NetDriver->NetConnForSpawn = InNetConn;
+	}
+}
+
+UChanneldConnection* ChanneldUtils::GetConnToChanneld(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr)
+	{
+		if (UChanneldNetDriver* NetDriver = Cast<UChanneldNetDriver>(World->GetNetDriver()))
+		{
+			if (UChanneldConnection* Conn = NetDriver->GetConnToChanneld())
+			{
+				return Conn;
+			}
+		}
+		if (UGameInstance* GameInstance = World->GetGameInstance())
+		{
+			if (auto Subsystem = GameInstance->GetSubsystem<UChanneldGameInstanceSubsystem>())
+			{
+				if (UChanneldConnection* Conn = Subsystem->GetConnection())
+				{
+					return Conn;
+				}
+			}
+		}
+	}
+	return GEngine->GetEngineSubsystem<UChanneldConnection>();
+}
+
+UChanneldNetConnection* ChanneldUtils::GetNetConnForSpawn(const UWorld* World)
+{
+	if (UChanneldNetDriver* NetDriver = World ? Cast<UChanneldNetDriver>(World->GetNetDriver()) : nullptr)
+	{
+		return NetDriver->NetConnForSpawn.Get();
+	}
+	return nullptr;
+}
+
+bool ChanneldUtils::IsNetConnForSpawn(const UNetConnection* Connection)
+{
+	const UChanneldNetDriver* NetDriver = Connection ? Cast<UChanneldNetDriver>(Connection->Driver) : nullptr;
+	return NetDriver && NetDriver->NetConnForSpawn.Get() == Connection;
+}
+
+void ChanneldUtils::ResetNetConnForSpawn(UNetConnection* Connection)
+{
+	auto PacketMapClient = CastChecked<UPackageMapClient>(Connection->PackageMap);
 	PacketMapClient->NetGUIDExportCountMap.Empty();
 	const static FPackageMapAckState EmptyAckStatus;
 	PacketMapClient->RestorePackageMapExportAckStatus(EmptyAckStatus);
@@ -353,6 +488,15 @@ UActorComponent* ChanneldUtils::GetActorComponentByRefChecked(const unrealpb::Ac
 	}
 
 	FName CompName = FName(UTF8_TO_TCHAR(Ref->compname().c_str()));
+	// The owner is in the cache after GetObjectByRef().
+	FChanneldResolvedObjCache* ResolvedObjCache = GetResolvedObjCache(World);
+	if (ResolvedObjCache)
+	{
+		if (UActorComponent* CachedComp = ResolvedObjCache->FindComponent(Ref->owner().netguid(), CompName))
+		{
+			return CachedComp;
+		}
+	}
 	/* GetDefaultSubobjectByName() doesn't work for dynamic components (e.g. CollisionComponent in Landscape)
 	UObject* Comp = Actor->GetDefaultSubobjectByName(CompName);
 	if (Comp)
@@ -364,6 +508,10 @@ UActorComponent* ChanneldUtils::GetActorComponentByRefChecked(const unrealpb::Ac
 	{
 		if (Comp->GetFName() == CompName)
 		{
+			if (ResolvedObjCache)
+			{
+				ResolvedObjCache->AddComponent(Ref->owner().netguid(), CompName, Comp);
+			}
 			return Cast<UActorComponent>(Comp);
 		}
 	}
@@ -720,7 +868,7 @@ bool ChanneldUtils::SerializeNewActor_Server(UNetConnection* Connection, UPackag
 
 void ChanneldUtils::SetActorRoleByOwningConnId(AActor* Actor, Channeld::ConnectionId OwningConnId)
 {
-	UChanneldConnection* ConnToChanneld = GEngine->GetEngineSubsystem<UChanneldConnection>();
+	UChanneldConnection* ConnToChanneld = GetConnToChanneld(Actor);
 	ENetRole OldRole = Actor->GetLocalRole();
 	if (ConnToChanneld->GetConnId() == OwningConnId)
 	{
@@ -8,6 +8,7 @@
 #include "Engine/ActorChannel.h"
 #include "ChanneldConnection.h"
 #include "ChanneldNetConnection.h"
+#include "ChanneldObjRefCache.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Engine/DemoNetDriver.h"
 //#define CHANNELD_TOLERANCE (1.e-8f)
@@ -100,6 +101,22 @@ public:
 		return false;
 	}
 
+	/**
+	 * @brief Compare the location, rotation and scale with their baselines in one pass of vector instructions.
+	 * @return The bit mask of the differences beyond CHANNELD_TOLERANCE: 0x00F for the location, 0x0F0 for the rotation, and 0xF00 for the scale.
+	 */
+	static uint32 GetTransformDifferenceMask(const FVector& Location, const FRotator& Rotation, const FVector& Scale,
+		const FVector& BaseLocation, const FRotator& BaseRotation, const FVector& BaseScale)
+	{
+		const auto Tolerance = VectorSetFloat1(static_cast<decltype(FVector::X)>(CHANNELD_TOLERANCE));
+		const auto LocationDiff = VectorAbs(VectorSubtract(VectorLoadFloat3_W0(&Location.X), VectorLoadFloat3_W0(&BaseLocation.X)));
+		const auto RotationDiff = VectorAbs(VectorSubtract(VectorLoadFloat3_W0(&Rotation.Pitch), VectorLoadFloat3_W0(&BaseRotation.Pitch)));
+		const auto ScaleDiff = VectorAbs(VectorSubtract(VectorLoadFloat3_W0(&Scale.X), VectorLoadFloat3_W0(&BaseScale.X)));
+		return VectorMaskBits(VectorCompareGT(LocationDiff, Tolerance))
+			| VectorMaskBits(VectorCompareGT(RotationDiff, Tolerance)) << 4
+			| VectorMaskBits(VectorCompareGT(ScaleDiff, Tolerance)) << 8;
+	}
+
 	static bool CheckDifference(const FRotator& RotatorToCheck, const unrealpb::FVector* RotatorPBToCheck)
 	{
 		if (!FMath::IsNearlyEqual(RotatorPBToCheck->x(), RotatorToCheck.Pitch, CHANNELD_TOLERANCE))
@@ -174,6 +191,86 @@ public:
 		return bNotSame;
 	}
 
+	// Round the vector to the precision of the quantization level, the same as FRepMovement does in native UE replication.
+	static FVector QuantizeVector(const FVector& Vector, EVectorQuantization Level)
+	{
+		switch (Level)
+		{
+		case EVectorQuantization::RoundWholeNumber:
+			return FVector(FMath::RoundToFloat(Vector.X), FMath::RoundToFloat(Vector.Y), FMath::RoundToFloat(Vector.Z));
+		case EVectorQuantization::RoundOneDecimal:
+			return FVector(FMath::RoundToFloat(Vector.X * 10.f), FMath::RoundToFloat(Vector.Y * 10.f), FMath::RoundToFloat(Vector.Z * 10.f)) / 10.f;
+		case EVectorQuantization::RoundTwoDecimals:
+		default:
+			return FVector(FMath::RoundToFloat(Vector.X * 100.f), FMath::RoundToFloat(Vector.Y * 100.f), FMath::RoundToFloat(Vector.Z * 100.f)) / 100.f;
+		}
+	}
+
+	// Round the rotator to 8-bit or 16-bit axes, the same as FRepMovement does in native UE replication.
+	static FRotator QuantizeRotator(const FRotator& Rotator, ERotatorQuantization Level)
+	{
+		if (Level == ERotatorQuantization::ByteComponents)
+		{
+			return FRotator(
+				FRotator::DecompressAxisFromByte(FRotator::CompressAxisToByte(Rotator.Pitch)),
+				FRotator::DecompressAxisFromByte(FRotator::CompressAxisToByte(Rotator.Yaw)),
+				FRotator::DecompressAxisFromByte(FRotator::CompressAxisToByte(Rotator.Roll)));
+		}
+		return FRotator(
+			FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(Rotator.Pitch)),
+			FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(Rotator.Yaw)),
+			FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(Rotator.Roll)));
+	}
+
+	/**
+	 * @brief Encode the value to a fixed-point integer of the step. Used by the replicators generated from the properties with the ChanneldQuantize metadata.
+	 * @param Bits The number of bits of the encoded value (sign included). The value is clamped to the range it can represent.
+	 */
+	static int32 QuantizeFloat(double Value, float Step, int32 Bits)
+	{
+		const int64 MaxValue = (1ll << (FMath::Clamp(Bits, 2, 32) - 1)) - 1;
+		return static_cast<int32>(FMath::Clamp<int64>(FMath::RoundToInt64(Value / Step), -MaxValue, MaxValue));
+	}
+
+	static float DequantizeFloat(int32 Quantized, float Step)
+	{
+		return Quantized * Step;
+	}
+
+	// Pack the 3 components, each quantized to at most 21 bits and offset to be unsigned, into one integer. The packed vector always has x, y and z.
+	static uint64 QuantizeVectorPacked(const FVector& Vector, float Step, int32 Bits)
+	{
+		Bits = FMath::Clamp(Bits, 2, 21);
+		const int64 Offset = 1ll << (Bits - 1);
+		return static_cast<uint64>(QuantizeFloat(Vector.X, Step, Bits) + Offset)
+			| static_cast<uint64>(QuantizeFloat(Vector.Y, Step, Bits) + Offset) << Bits
+			| static_cast<uint64>(QuantizeFloat(Vector.Z, Step, Bits) + Offset) << (Bits * 2);
+	}
+
+	static FVector DequantizeVectorPacked(uint64 Packed, float Step, int32 Bits)
+	{
+		Bits = FMath::Clamp(Bits, 2, 21);
+		const int64 Offset = 1ll << (Bits - 1);
+		const uint64 Mask = (1ull << Bits) - 1;
+		return FVector(
+			(static_cast<int64>(Packed & Mask) - Offset) * Step,
+			(static_cast<int64>(Packed >> Bits & Mask) - Offset) * Step,
+			(static_cast<int64>(Packed >> (Bits * 2) & Mask) - Offset) * Step);
+	}
+
+	// Same as QuantizeVectorPacked, with the axes normalized to (-180, 180] first so the full range of the bits is used.
+	static uint64 QuantizeRotatorPacked(const FRotator& Rotator, float Step, int32 Bits)
+	{
+		const FRotator Normalized = Rotator.GetNormalized();
+		return QuantizeVectorPacked(FVector(Normalized.Pitch, Normalized.Yaw, Normalized.Roll), Step, Bits);
+	}
+
+	static FRotator DequantizeRotatorPacked(uint64 Packed, float Step, int32 Bits)
+	{
+		const FVector Vector = DequantizeVectorPacked(Packed, Step, Bits);
+		return FRotator(Vector.X, Vector.Y, Vector.Z);
+	}
+
 	static channeldpb::SpatialInfo ToSpatialInfo(const FVector& Location)
 	{
 		channeldpb::SpatialInfo SpatialInfo;
@@ -239,6 +336,15 @@ public:
 	
 	static TSharedRef<unrealpb::UnrealObjectRef> GetRefOfObject(UObject* Obj, UNetConnection* Connection = nullptr, bool bFullExport = false);
 
+	/**
+	 * The class path, or the context path of the NetGUID, to send in the UnrealObjectRef. If UChanneldSettings::bCompactObjRefPaths is set,
+	 * a class in FChanneldRepClassTable is sent as "#" + the hex of its hash, and the package of such class as the same plus ".".
+	 * @param bPackage Whether the path is the name of a top-level package, which is only compacted if it's the package of a blueprint class in the table.
+	 */
+	static std::string EncodeObjRefPath(const FString& PathName, bool bPackage = false);
+	// Restores the path of EncodeObjRefPath(). Returns an empty string if the hash is not in the table.
+	static FString DecodeObjRefPath(const std::string& EncodedPath);
+
 	static bool CheckObjectWithRef(UObject* Obj, const unrealpb::UnrealObjectRef* Ref, UWorld* World)
 	{
 		bool bUnmapped = false;
@@ -344,7 +450,7 @@ public:
 		for (auto ContextObj : ContextObjs)
 		{
 			FNetworkGUID NetGUID = FNetworkGUID(ContextObj->netguid());
-			FString PathName = UTF8_TO_TCHAR(ContextObj->pathname().c_str());
+			FString PathName = DecodeObjRefPath(ContextObj->pathname());
 			// Remap name for PIE
 			GEngine->NetworkRemapPath(World->GetNetDriver()->ServerConnection, PathName, true);
 			World->GetNetDriver()->GuidCache->RegisterNetGUIDFromPath_Client(NetGUID, PathName, ContextObj->outerguid(), 0, false, true);
@@ -358,12 +464,20 @@ public:
 	}
 	*/
 
-	static void InitNetConnForSpawn(UChanneldNetConnection* InNetConn)
-	{
-		NetConnForSpawn = InNetConn;
-	}
+	// Registers the virtual connection of the view with its NetDriver, so each world exports the spawned objects with its own connection.
+	static void InitNetConnForSpawn(UChanneldNetConnection* InNetConn);
+
+	// The connection to channeld of the world: the one of its game instance if UChanneldSettings::bConnectionPerGameInstance is set, otherwise the engine's.
+	static UChanneldConnection* GetConnToChanneld(const UObject* WorldContextObject);
+
+	// If set, GetObjectByRef() adds the newly spawned actors to the array instead of calling PostNetInit() on them. See UChanneldSettings::bClientDeferBeginPlay.
+	static TArray<TWeakObjectPtr<AActor>>* DeferredPostNetInitActors;
 private:
-	static TMap<uint32, TSharedRef<unrealpb::UnrealObjectRef>> ObjRefCache;
-	static UChanneldNetConnection* NetConnForSpawn;
-	static void ResetNetConnForSpawn();
+	// The cache of the full-exported refs is per NetDriver. Returns nullptr if the world doesn't use UChanneldNetDriver.
+	static FChanneldObjRefCache* GetObjRefCache(const UWorld* World);
+	// Returns nullptr on the server, or if UChanneldSettings::bCacheResolvedObjRefs is false.
+	static FChanneldResolvedObjCache* GetResolvedObjCache(const UWorld* World);
+	static UChanneldNetConnection* GetNetConnForSpawn(const UWorld* World);
+	static bool IsNetConnForSpawn(const UNetConnection* Connection);
+	static void ResetNetConnForSpawn(UNetConnection* Connection);
 };
@@ -0,0 +1,173 @@
+#include "ChanneldWireSizeSampler.h"
+#include "ChanneldTypes.h"
+#include "channeld.pb.h"
+#include "Async/Async.h"
+#include "google/protobuf/wire_format.h"
+
+// The channel data, the actor messages of the actor-centric channel data, the states, and the structs in the states.
+static constexpr int32 MaxWalkDepth = 4;
+// The updates sent while this many samples are still being walked are not sampled, so a slow walk doesn't pile up the copies.
+static constexpr int32 MaxPendingSamples = 4;
+
+FChanneldWireSizeSampler::~FChanneldWireSizeSampler()
+{
+	WaitForPendingSamples();
+}
+
+void FChanneldWireSizeSampler::Init(int32 InSampleRate)
+{
+	WaitForPendingSamples();
+	SampleRate = FMath::Max(InSampleRate, 0);
+	NumSentUpdates = 0;
+	Reset();
+}
+
+void FChanneldWireSizeSampler::OnSentUpdate(const std::string& Body)
+{
+	if (!IsEnabled() || ++NumSentUpdates < static_cast<uint32>(SampleRate))
+	{
+		return;
+	}
+	NumSentUpdates = 0;
+	if (NumPendingSamples.load() >= MaxPendingSamples)
+	{
+		return;
+	}
+
+	NumPendingSamples++;
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, Body]()
+	{
+		Sample(Body);
+		NumPendingSamples--;
+	});
+}
+
+void FChanneldWireSizeSampler::WaitForPendingSamples() const
+{
+	while (NumPendingSamples.load() > 0)
+	{
+		FPlatformProcess::Sleep(0.001f);
+	}
+}
+
+void FChanneldWireSizeSampler::Sample(const std::string& Body)
+{
+	channeldpb::ChannelDataUpdateMessage UpdateMsg;
+	if (!UpdateMsg.ParseFromString(Body))
+	{
+		return;
+	}
+	const std::string& TypeUrl = UpdateMsg.data().type_url();
+	const std::string TypeName = TypeUrl.substr(TypeUrl.find_last_of('/') + 1);
+	const google::protobuf::Descriptor* Descriptor = google::protobuf::DescriptorPool::generated_pool()->FindMessageTypeByName(TypeName);
+	if (Descriptor == nullptr)
+	{
+		return;
+	}
+	TUniquePtr<google::protobuf::Message> ChannelData(google::protobuf::MessageFactory::generated_factory()->GetPrototype(Descriptor)->New());
+	if (!ChannelData->ParseFromString(UpdateMsg.data().value()))
+	{
+		return;
+	}
+
+	TMap<FFieldKey, FFieldStats> Stats;
+	Walk(*ChannelData, 0, Stats);
+
+	FScopeLock ScopeLock(&Lock);
+	NumSampledUpdates++;
+	SampledUpdateBytes += Body.size();
+	for (const auto& Pair : Stats)
+	{
+		FFieldStats& Total = Totals.FindOrAdd(Pair.Key);
+		Total.Bytes += Pair.Value.Bytes;
+		Total.Count += Pair.Value.Count;
+		Deltas.FindOrAdd(Pair.Key) += Pair.Value.Bytes;
+	}
+}
+
+void FChanneldWireSizeSampler::Walk(const google::protobuf::Message& Msg, int32 Depth, TMap<FFieldKey, FFieldStats>& OutStats)
+{
+	using namespace google::protobuf;
+	const Reflection* Refl = Msg.GetReflection();
+	std::vector<const FieldDescriptor*> Fields;
+	Refl->ListFields(Msg, &Fields);
+	const FName TypeName(UTF8_TO_TCHAR(Msg.GetDescriptor()->full_name().c_str()));
+	for (const FieldDescriptor* Field : Fields)
+	{
+		FFieldStats& Stats = OutStats.FindOrAdd(MakeTuple(TypeName, FName(UTF8_TO_TCHAR(Field->name().c_str()))));
+		Stats.Bytes += internal::WireFormat::FieldByteSize(Field, Msg);
+		Stats.Count += Field->is_repeated() ? Refl->FieldSize(Msg, Field) : 1;
+
+		if (Field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE || Depth + 1 >= MaxWalkDepth)
+		{
+			continue;
+		}
+		if (Field->is_map())
+		{
+			// Skip the map entries, and walk the values.
+			const FieldDescriptor* ValueField = Field->message_type()->map_value();
+			if (ValueField->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE)
+			{
+				continue;
+			}
+			for (int32 i = 0; i < Refl->FieldSize(Msg, Field); i++)
+			{
+				const Message& Entry = Refl->GetRepeatedMessage(Msg, Field, i);
+				Walk(Entry.GetReflection()->GetMessage(Entry, ValueField), Depth + 1, OutStats);
+			}
+		}
+		else if (Field->is_repeated())
+		{
+			for (int32 i = 0; i < Refl->FieldSize(Msg, Field); i++)
+			{
+				Walk(Refl->GetRepeatedMessage(Msg, Field, i), Depth + 1, OutStats);
+			}
+		}
+		else
+		{
+			Walk(Refl->GetMessage(Msg, Field), Depth + 1, OutStats);
+		}
+	}
+}
+
+void FChanneldWireSizeSampler::ConsumeDeltas(TFunctionRef<void(const FFieldKey& Key, uint64 Bytes)> Func)
+{
+	FScopeLock ScopeLock(&Lock);
+	for (const auto& Pair : Deltas)
+	{
+		Func(Pair.Key, Pair.Value);
+	}
+	Deltas.Reset();
+}
+
+void FChanneldWireSizeSampler::Dump(int32 MaxRows) const
+{
+	FScopeLock ScopeLock(&Lock);
+	if (NumSampledUpdates == 0)
+	{
+		UE_LOG(LogChanneld, Display, TEXT("No channel data update is sampled. Set WireSizeSampleRate to enable the sampling."));
+		return;
+	}
+
+	TArray<TPair<FFieldKey, FFieldStats>> Sorted = Totals.Array();
+	Sorted.Sort([](const TPair<FFieldKey, FFieldStats>& Lhs, const TPair<FFieldKey, FFieldStats>& Rhs) { return Lhs.Value.Bytes > Rhs.Value.Bytes; });
+	UE_LOG(LogChanneld, Display, TEXT("Wire size of %llu sampled channel data updates (%llu bytes), 1 in %d sent:"), NumSampledUpdates, SampledUpdateBytes, SampleRate);
+	UE_LOG(LogChanneld, Display, TEXT("%-48s %-32s %12s %10s %10s %8s"), TEXT("Type"), TEXT("Field"), TEXT("Bytes"), TEXT("Count"), TEXT("Avg"), TEXT("Share"));
+	for (int32 i = 0; i < Sorted.Num() && i < MaxRows; i++)
+	{
+		const FFieldStats& Stats = Sorted[i].Value;
+		UE_LOG(LogChanneld, Display, TEXT("%-48s %-32s %12llu %10llu %10.1f %7.1f%%"),
+			*Sorted[i].Key.Key.ToString(), *Sorted[i].Key.Value.ToString(), Stats.Bytes, Stats.Count,
+			Stats.Count > 0 ? static_cast<double>(Stats.Bytes) / Stats.Count : 0.0,
+			SampledUpdateBytes > 0 ? 100.0 * Stats.Bytes / SampledUpdateBytes : 0.0);
+	}
+}
+
+void FChanneldWireSizeSampler::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	NumSampledUpdates = 0;
+	SampledUpdateBytes = 0;
+	Totals.Reset();
+	Deltas.Reset();
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include <string>
+
+namespace google
+{
+	namespace protobuf
+	{
+		class Message;
+	}
+}
+
+/**
+ * Breaks down the bytes of the sent channel data updates by the message type and the field, to find the fields worth quantizing or
+ * delta-compressing. One in SampleRate updates is copied on the game thread, and parsed and walked with the protobuf reflection on a
+ * background thread. The bytes of a field include its tag and length. The nested messages are walked as well, so the bytes of a state
+ * field (e.g. replicatedmovement of the ActorState) also show up in the fields of its own message type. See UChanneldSettings::WireSizeSampleRate.
+ */
+class CHANNELDUE_API FChanneldWireSizeSampler
+{
+public:
+	struct FFieldStats
+	{
+		uint64 Bytes = 0;
+		// The number of the times the field is set in the sampled updates. A field of the states in a map is counted once per state.
+		uint64 Count = 0;
+	};
+	// The full name of the message type, and the name of the field.
+	typedef TPair<FName, FName> FFieldKey;
+
+	~FChanneldWireSizeSampler();
+
+	void Init(int32 InSampleRate);
+	FORCEINLINE bool IsEnabled() const { return SampleRate > 0; }
+
+	// Called on the game thread with the body of each sent ChannelDataUpdateMessage.
+	void OnSentUpdate(const std::string& Body);
+	// Blocks until the sampled updates are all walked.
+	void WaitForPendingSamples() const;
+	// Passes the bytes of each field since the last call. Called on the game thread.
+	void ConsumeDeltas(TFunctionRef<void(const FFieldKey& Key, uint64 Bytes)> Func);
+	// Logs the fields with the most bytes since the start of the sampling.
+	void Dump(int32 MaxRows) const;
+	void Reset();
+
+private:
+	void Sample(const std::string& Body);
+	static void Walk(const google::protobuf::Message& Msg, int32 Depth, TMap<FFieldKey, FFieldStats>& OutStats);
+
+	int32 SampleRate = 0;
+	uint32 NumSentUpdates = 0;
+	std::atomic<int32> NumPendingSamples{0};
+
+	mutable FCriticalSection Lock;
+	uint64 NumSampledUpdates = 0;
+	uint64 SampledUpdateBytes = 0;
+	TMap<FFieldKey, FFieldStats> Totals;
+	TMap<FFieldKey, uint64> Deltas;
+};
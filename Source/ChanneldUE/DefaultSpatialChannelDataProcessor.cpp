@@ -29,6 +29,33 @@ bool FDefaultSpatialChannelDataProcessor::Merge(const google::protobuf::Message*
 	return true;
 }
 
+bool FDefaultSpatialChannelDataProcessor::MergeMove(google::protobuf::Message* SrcMsg, google::protobuf::Message* DstMsg)
+{
+	auto Src = static_cast<unrealpb::SpatialChannelData*>(SrcMsg);
+	auto DstEntities = static_cast<unrealpb::SpatialChannelData*>(DstMsg)->mutable_entities();
+
+	for (auto& Pair : *Src->mutable_entities())
+	{
+		if (Pair.second.removed())
+		{
+			DstEntities->erase(Pair.first);
+			continue;
+		}
+		auto Itr = DstEntities->find(Pair.first);
+		if (Itr != DstEntities->end())
+		{
+			Itr->second.MergeFrom(Pair.second);
+		}
+		else
+		{
+			// Both messages are on the heap, so swapping only exchanges the pointers of the fields.
+			(*DstEntities)[Pair.first].Swap(&Pair.second);
+		}
+	}
+
+	return true;
+}
+
 bool FDefaultSpatialChannelDataProcessor::UpdateChannelData(UObject* TargetObj, google::protobuf::Message* ChannelData)
 {
 	// Don't send Spatial channel data update to channeld, as the channel data is maintained via Spawn and Destroy messages.
@@ -65,18 +92,15 @@ void FDefaultSpatialChannelDataProcessor::SetStateToChannelData(const google::pr
 		return;
 	}
 
-	static unrealpb::SpatialEntityState RemovedEntityState;
-	RemovedEntityState.set_removed(true);
-	auto EntityState = State ? static_cast<const unrealpb::SpatialEntityState*>(State) : &RemovedEntityState;
-	auto SpatialChannelData = static_cast<unrealpb::SpatialChannelData*>(ChannelData);
-	auto Entry = SpatialChannelData->mutable_entities()->find(NetGUID);
-	if (Entry != SpatialChannelData->mutable_entities()->end())
+	// Construct the entry in place, instead of copying the state into a temporary pair first.
+	unrealpb::SpatialEntityState& Entry = (*static_cast<unrealpb::SpatialChannelData*>(ChannelData)->mutable_entities())[NetGUID];
+	if (State)
 	{
-		Entry->second.MergeFrom(*EntityState);
+		Entry.MergeFrom(*static_cast<const unrealpb::SpatialEntityState*>(State));
 	}
 	else
 	{
-		SpatialChannelData->mutable_entities()->insert({ NetGUID, *EntityState });
+		Entry.set_removed(true);
 	}
 }
 
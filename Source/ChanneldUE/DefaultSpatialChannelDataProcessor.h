@@ -5,6 +5,7 @@ class CHANNELDUE_API FDefaultSpatialChannelDataProcessor : public IChannelDataPr
 {
 public:
 	virtual bool Merge(const google::protobuf::Message* SrcMsg, google::protobuf::Message* DstMsg) override;
+	virtual bool MergeMove(google::protobuf::Message* SrcMsg, google::protobuf::Message* DstMsg) override;
 
 	virtual bool UpdateChannelData(UObject* TargetObj, google::protobuf::Message* ChannelData) override;
 	
@@ -1,5 +1,6 @@
 #include "ChanneldCharMoveComponent.h"
 
+#include "ChanneldSettings.h"
 #include "ChanneldUtils.h"
 #include "GameFramework/Character.h"
 
@@ -19,6 +20,37 @@ bool UChanneldCharMoveComponent::ForcePositionUpdate(float DeltaTime)
 	return Super::ForcePositionUpdate(DeltaTime);
 }
 
+void UChanneldCharMoveComponent::SendClientAdjustment()
+{
+	// The client needs a few acks in a row before being throttled, e.g. right after a correction or the handover.
+	static constexpr int32 MinGoodMoveAcksBeforeThrottle = 8;
+
+	const float AckInterval = GetMutableDefault<UChanneldSettings>()->GoodMoveAckInterval;
+	if (AckInterval > 0 && HasPredictionData_Server())
+	{
+		const FClientAdjustment& PendingAdjustment = GetPredictionData_Server_Character()->PendingAdjustment;
+		if (PendingAdjustment.TimeStamp > 0)
+		{
+			if (PendingAdjustment.bAckGoodMove)
+			{
+				const double Now = GetWorld()->GetTimeSeconds();
+				// Keep the pending ack, which is overwritten by the newer good moves. Acking the latest one acknowledges the ones before it in the client.
+				if (NumConsecutiveGoodMoveAcks >= MinGoodMoveAcksBeforeThrottle && Now - LastGoodMoveAckTime < AckInterval)
+				{
+					return;
+				}
+				NumConsecutiveGoodMoveAcks++;
+				LastGoodMoveAckTime = Now;
+			}
+			else
+			{
+				NumConsecutiveGoodMoveAcks = 0;
+			}
+		}
+	}
+	Super::SendClientAdjustment();
+}
+
 
 bool FChanneldCharacterMoveResponseDataContainer::Serialize(
 	UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap)
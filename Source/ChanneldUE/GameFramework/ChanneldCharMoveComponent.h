@@ -13,6 +13,7 @@ struct FChanneldCharacterMoveResponseDataContainer : FCharacterMoveResponseDataC
 // Responsibilities:
 // 1. Customize the serialization of FCharacterMoveResponseDataContainer (disabled for now)
 // 2. Adapt the cross-server handover situation
+// 3. Ack the good moves less often (see UChanneldSettings::GoodMoveAckInterval)
 UCLASS(BlueprintType, meta = (DisplayName = "Channeld Character Movement Component", BlueprintSpawnableComponent))
 class CHANNELDUE_API UChanneldCharMoveComponent : public UCharacterMovementComponent
 {
@@ -21,7 +22,13 @@ class CHANNELDUE_API UChanneldCharMoveComponent : public UCharacterMovementCompo
 public:
 	UChanneldCharMoveComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 	virtual bool ForcePositionUpdate(float DeltaTime) override;
+	virtual void SendClientAdjustment() override;
 	
 protected:
 	FChanneldCharacterMoveResponseDataContainer DefaultMoveResponseDataContainer;
+
+private:
+	// [Server] The number of the good moves acked since the last correction, and the time of the last ack.
+	int32 NumConsecutiveGoodMoveAcks = 0;
+	double LastGoodMoveAckTime = 0;
 };
\ No newline at end of file
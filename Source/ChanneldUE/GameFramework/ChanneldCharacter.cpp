@@ -1,6 +1,7 @@
 #include "ChanneldCharacter.h"
 
 #include "ChanneldCharMoveComponent.h"
+#include "ChanneldProxyInterpolationComponent.h"
 #include "ChanneldTypes.h"
 
 AChanneldCharacter::AChanneldCharacter(const FObjectInitializer& ObjectInitializer)
@@ -40,8 +41,28 @@ void AChanneldCharacter::PostNetReceiveLocationAndRotation()
 		UE_LOG(LogChanneld, Verbose, TEXT("Skip ACharacter::PostNetReceiveLocationAndRotation for SimulatedProxy on dedicated server."))
 		AActor::PostNetReceiveLocationAndRotation();
 	}
+	// The culled proxy doesn't simulate the movement, so the SmoothCorrection is skipped as well.
+	else if (ProxyInterpolation && ProxyInterpolation->IsCulled())
+	{
+		const FRepMovement& RepMovement = GetReplicatedMovement();
+		ProxyInterpolation->SetTargetTransform(FRepMovement::RebaseOntoLocalOrigin(RepMovement.Location, this), RepMovement.Rotation, RepMovement.LinearVelocity);
+	}
 	else
 	{
 		ACharacter::PostNetReceiveLocationAndRotation();
 	}
 }
+
+void AChanneldCharacter::SetProxyCulled(bool bCulled)
+{
+	if (ProxyInterpolation == nullptr)
+	{
+		if (!bCulled)
+		{
+			return;
+		}
+		ProxyInterpolation = NewObject<UChanneldProxyInterpolationComponent>(this, TEXT("ChanneldProxyInterpolation"));
+		ProxyInterpolation->RegisterComponent();
+	}
+	ProxyInterpolation->SetCulled(bCulled);
+}
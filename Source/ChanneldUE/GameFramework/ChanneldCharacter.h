@@ -4,10 +4,13 @@
 #include "GameFramework/Character.h"
 #include "ChanneldCharacter.generated.h"
 
+class UChanneldProxyInterpolationComponent;
+
 // Responsibilities:
 // 1. Replace the default CharacterMovementComponent with the customized UChanneldCharMoveComponent
 // 2. Route server's ProcessEvent to the cross-server RPC if no authority over the character
 // 3. Fix certain cross-server movement issues
+// 4. Follow the replicated transforms cheaply when culled as a simulated proxy (see UChanneldSettings::SimulatedProxyCullDistance)
 // REQUIRED for using the spatial channel.
 UCLASS(BlueprintType)
 class CHANNELDUE_API AChanneldCharacter : public ACharacter
@@ -18,4 +21,11 @@ public:
 	AChanneldCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 	virtual int32 GetFunctionCallspace(UFunction* Function, FFrame* Stack) override;
 	virtual void PostNetReceiveLocationAndRotation() override;
+
+	// [Client] Switch the simulated proxy between the full movement simulation and UChanneldProxyInterpolationComponent.
+	void SetProxyCulled(bool bCulled);
+
+private:
+	UPROPERTY(Transient)
+	UChanneldProxyInterpolationComponent* ProxyInterpolation = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "ChanneldProxyInterpolationComponent.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+UChanneldProxyInterpolationComponent::UChanneldProxyInterpolationComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	SetIsReplicatedByDefault(false);
+}
+
+void UChanneldProxyInterpolationComponent::SetCulled(bool bInCulled)
+{
+	ACharacter* Character = Cast<ACharacter>(GetOwner());
+	if (bCulled == bInCulled || Character == nullptr)
+	{
+		return;
+	}
+	bCulled = bInCulled;
+
+	UCharacterMovementComponent* MoveComp = Character->GetCharacterMovement();
+	USkeletalMeshComponent* Mesh = Character->GetMesh();
+	if (bCulled)
+	{
+		if (MoveComp)
+		{
+			bMovementTickWasEnabled = MoveComp->IsComponentTickEnabled();
+			MoveComp->SetComponentTickEnabled(false);
+			MoveComp->Velocity = FVector::ZeroVector;
+		}
+		if (Mesh)
+		{
+			bMeshTickWasEnabled = Mesh->IsComponentTickEnabled();
+			Mesh->SetComponentTickEnabled(false);
+			// Drop the offset of the network smoothing, which is no longer ticked.
+			Mesh->SetRelativeLocationAndRotation(Character->GetBaseTranslationOffset(), Character->GetBaseRotationOffset());
+		}
+		TargetLocation = Character->GetActorLocation();
+		TargetRotation = Character->GetActorRotation();
+		TargetVelocity = FVector::ZeroVector;
+		TargetTime = GetWorld()->GetTimeSeconds();
+	}
+	else
+	{
+		// Catch up with the latest replicated transform before the movement component takes over.
+		Character->SetActorLocationAndRotation(TargetLocation, TargetRotation, false, nullptr, ETeleportType::TeleportPhysics);
+		if (MoveComp)
+		{
+			MoveComp->SetComponentTickEnabled(bMovementTickWasEnabled);
+			MoveComp->Velocity = TargetVelocity;
+		}
+		if (Mesh)
+		{
+			Mesh->SetComponentTickEnabled(bMeshTickWasEnabled);
+		}
+	}
+	SetComponentTickEnabled(bCulled);
+}
+
+void UChanneldProxyInterpolationComponent::SetTargetTransform(const FVector& Location, const FRotator& Rotation, const FVector& Velocity)
+{
+	TargetLocation = Location;
+	TargetRotation = Rotation;
+	TargetVelocity = Velocity;
+	TargetTime = GetWorld()->GetTimeSeconds();
+}
+
+void UChanneldProxyInterpolationComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	AActor* Owner = GetOwner();
+	if (!bCulled || Owner == nullptr)
+	{
+		return;
+	}
+
+	const float ExtrapolationTime = FMath::Min(static_cast<float>(GetWorld()->GetTimeSeconds() - TargetTime), MaxExtrapolationTime);
+	const FVector Goal = TargetLocation + TargetVelocity * ExtrapolationTime;
+	const FVector NewLocation = FMath::VInterpTo(Owner->GetActorLocation(), Goal, DeltaTime, InterpSpeed);
+	const FRotator NewRotation = FMath::RInterpTo(Owner->GetActorRotation(), TargetRotation, DeltaTime, InterpSpeed);
+	Owner->SetActorLocationAndRotation(NewLocation, NewRotation, false, nullptr, ETeleportType::TeleportPhysics);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "ChanneldProxyInterpolationComponent.generated.h"
+
+// [Client] The cheap replacement of the movement simulation of a culled simulated proxy character (see UChanneldSettings::SimulatedProxyCullDistance).
+// While culled, the movement component and the mesh of the character don't tick, and the character is moved toward the replicated transforms.
+UCLASS(ClassGroup = "Channeld", meta = (DisplayName = "Channeld Proxy Interpolation Component"))
+class CHANNELDUE_API UChanneldProxyInterpolationComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UChanneldProxyInterpolationComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	void SetCulled(bool bInCulled);
+	bool IsCulled() const { return bCulled; }
+	// Called when the replicated movement of the culled character is received.
+	void SetTargetTransform(const FVector& Location, const FRotator& Rotation, const FVector& Velocity);
+
+	UPROPERTY(EditAnywhere, Category = "Components|Channeld")
+	float InterpSpeed = 10.f;
+
+	// The max seconds the location is extrapolated by the replicated velocity after the last update.
+	UPROPERTY(EditAnywhere, Category = "Components|Channeld")
+	float MaxExtrapolationTime = 0.25f;
+
+private:
+	bool bCulled = false;
+	FVector TargetLocation = FVector::ZeroVector;
+	FRotator TargetRotation = FRotator::ZeroRotator;
+	FVector TargetVelocity = FVector::ZeroVector;
+	double TargetTime = 0;
+	// The tick states to restore when the character is no longer culled.
+	bool bMovementTickWasEnabled = true;
+	bool bMeshTickWasEnabled = true;
+};
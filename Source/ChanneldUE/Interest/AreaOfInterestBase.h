@@ -19,10 +19,22 @@ public:
 	virtual void FollowActor(AActor* Target) {}
 	virtual void UnfollowActor(AActor* Target) {}
 	virtual bool TickQuery(channeldpb::SpatialInterestQuery* Query, float DeltaTime) {return false;}
+	// Does the area of the last query overlap the region on the XY plane? Used to pick the subscription options of the spatial channels.
+	virtual bool IntersectsRegion(const FBox2D& Region) const {return false;}
 
 	UPROPERTY(BlueprintReadOnly)
 	FName Name;
 
 	UPROPERTY(EditAnywhere)
 	float MinDistanceToTriggerUpdate;
+
+	// If any active area of the client overrides, the spatial channels overlapped by the area are subscribed with its fan-out interval and data field masks.
+	UPROPERTY(EditAnywhere)
+	bool bOverrideSubOptions = false;
+
+	UPROPERTY(EditAnywhere)
+	int32 FanOutIntervalMs = 20;
+
+	UPROPERTY(EditAnywhere)
+	TArray<FString> DataFieldMasks;
 };
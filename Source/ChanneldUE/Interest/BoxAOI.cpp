@@ -5,7 +5,15 @@
 void UBoxAOI::SetSpatialQuery(channeldpb::SpatialInterestQuery* Query, const FVector& PawnLocation, const FRotator& PawnRotation)
 {
 	ChanneldUtils::SetSpatialInfoPB(Query->mutable_boxaoi()->mutable_center(), PawnLocation);
-	ChanneldUtils::SetSpatialInfoPB(Query->mutable_boxaoi()->mutable_extent(), Extent);
+	const FVector PaddedExtent = Extent + FVector(HysteresisMargin);
+	ChanneldUtils::SetSpatialInfoPB(Query->mutable_boxaoi()->mutable_extent(), PaddedExtent);
 	
-	UE_LOG(LogChanneld, Verbose, TEXT("Updating the BoxAOI with center=%s, Extent=%s"), *PawnLocation.ToCompactString(), *Extent.ToCompactString());
+	UE_LOG(LogChanneld, Verbose, TEXT("Updating the BoxAOI with center=%s, Extent=%s"), *PawnLocation.ToCompactString(), *PaddedExtent.ToCompactString());
+}
+
+bool UBoxAOI::IntersectsRegion(const FBox2D& Region) const
+{
+	const FVector2D Center(LastUpdateLocation);
+	const FVector2D HalfSize(Extent.X + HysteresisMargin, Extent.Y + HysteresisMargin);
+	return Region.Intersect(FBox2D(Center - HalfSize, Center + HalfSize));
 }
@@ -11,6 +11,7 @@ class CHANNELDUE_API UBoxAOI : public UPlayerFollowingAOI
 public:
 	
 	virtual void SetSpatialQuery(channeldpb::SpatialInterestQuery* Query, const FVector& PawnLocation, const FRotator& PawnRotation) override;
+	virtual bool IntersectsRegion(const FBox2D& Region) const override;
 
 	UPROPERTY(EditAnywhere)
 	FVector Extent;
@@ -5,7 +5,10 @@
 #include "ChanneldGameInstanceSubsystem.h"
 #include "ChanneldNetDriver.h"
 #include "ChanneldSettings.h"
+#include "ChanneldUtils.h"
 #include "ConeAOI.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
 #include "SphereAOI.h"
 #include "StaticLocationsAOI.h"
 
@@ -43,6 +46,7 @@ void UClientInterestManager::ServerSetup(UChanneldNetConnection* InClientNetConn
 			AOI = Cone;
 			Cone->Radius = Preset.Radius;
 			Cone->Angle = Preset.Angle;
+			Cone->AngleHysteresis = Preset.AngleHysteresis;
 		}
 		else if (Preset.AreaType == EClientInterestAreaType::StaticLocations)
 		{
@@ -55,11 +59,21 @@ void UClientInterestManager::ServerSetup(UChanneldNetConnection* InClientNetConn
 		{
 			AOI->Name = Preset.PresetName;
 			AOI->MinDistanceToTriggerUpdate = Preset.MinDistanceToTriggerUpdate;
+			AOI->bOverrideSubOptions = Preset.bOverrideSubOptions;
+			AOI->FanOutIntervalMs = Preset.FanOutIntervalMs;
+			AOI->DataFieldMasks = Preset.DataFieldMasks;
+			if (auto PlayerFollowing = Cast<UPlayerFollowingAOI>(AOI))
+			{
+				PlayerFollowing->HysteresisMargin = Preset.HysteresisMargin;
+				PlayerFollowing->LookAheadSeconds = Preset.LookAheadSeconds;
+				PlayerFollowing->bQueryCoveredRegions = Preset.bQueryCoveredRegions;
+			}
 			AddAOI(AOI, Preset.bActivateByDefault);
 		}
 	}
 
 	InClientNetConn->PlayerEnterSpatialChannelEvent.AddUObject(this, &UClientInterestManager::OnPlayerEnterSpatialChannel);
+	InterestMetrics = GEngine->GetEngineSubsystem<UChanneldMetrics>()->AddInterestMetrics(InClientNetConn->GetConnId());
 
 	UE_LOG(LogChanneld, Log, TEXT("[Server] ClientInterestManager has been setup for client conn %d"), InClientNetConn->GetConnId());
 }
@@ -68,6 +82,13 @@ void UClientInterestManager::CleanUp()
 {
 	AvailableAOIs.Empty();
 	ActiveAOIs.Empty();
+	FollowTargets.Reset();
+	InterestMsg.Clear();
+	EntityLODBands.Empty();
+	SpatialChannelAOIs.Empty();
+	SubscribedSpatialChannels.Empty();
+	SubscribedEntityChannels.Empty();
+	GEngine->GetEngineSubsystem<UChanneldMetrics>()->RemoveInterestMetrics(InterestMetrics);
 	// QueryForTick->Clear();
 	// delete QueryForTick;
 	if (ClientNetConn.IsValid())
@@ -116,6 +137,7 @@ void UClientInterestManager::ActivateAOI(int Index)
 	
 	ActiveAOIs.Add(AvailableAOIs[Index]);
 	AvailableAOIs[Index]->OnActivate();
+	UpdateFollowTargets();
 }
 
 void UClientInterestManager::DeactivateAOI(int Index)
@@ -131,6 +153,7 @@ void UClientInterestManager::DeactivateAOI(int Index)
 		{
 			ActiveAOIs[i]->OnDeactivate();
 			ActiveAOIs.RemoveAt(i);
+			UpdateFollowTargets();
 			break;
 		}
 	}
@@ -149,6 +172,7 @@ void UClientInterestManager::FollowActor(AActor* Target, int IndexOfAOI)
 	{
 		AvailableAOIs[IndexOfAOI]->FollowActor(Target);
 	}
+	UpdateFollowTargets();
 }
 
 void UClientInterestManager::UnfollowActor(AActor* Target, int IndexOfAOI)
@@ -164,9 +188,30 @@ void UClientInterestManager::UnfollowActor(AActor* Target, int IndexOfAOI)
 	{
 		AvailableAOIs[IndexOfAOI]->UnfollowActor(Target);
 	}
+	UpdateFollowTargets();
 }
 
-bool UClientInterestManager::IsTickable() const
+void UClientInterestManager::UpdateFollowTargets()
+{
+	FollowTargets.Reset();
+	for (auto& AOI : ActiveAOIs)
+	{
+		if (auto PlayerFollowing = Cast<UPlayerFollowingAOI>(AOI))
+		{
+			if (APlayerController* PC = PlayerFollowing->GetFollowingPC())
+			{
+				PlayerFollowing->SetFollowTarget(&FollowTargets, FollowTargets.AddUnique(PC));
+			}
+			else
+			{
+				PlayerFollowing->SetFollowTarget(nullptr, INDEX_NONE);
+			}
+		}
+	}
+	FollowTargets.Gather();
+}
+
+bool UClientInterestManager::IsActive() const
 {
 	if (IsTemplate())
 	{
@@ -176,21 +221,256 @@ bool UClientInterestManager::IsTickable() const
 	return ClientNetConn.IsValid();
 }
 
-void UClientInterestManager::Tick(float DeltaTime)
+bool UClientInterestManager::TickQuery(float DeltaTime)
 {
+	// One gather for all the AOIs following the same targets.
+	FollowTargets.Gather();
+
 	bool bNewQuery = false;
 	for (auto& AOI : ActiveAOIs)
 	{
-		bNewQuery |= AOI->TickQuery(&QueryForTick, DeltaTime);
+		bNewQuery |= AOI->TickQuery(InterestMsg.mutable_query(), DeltaTime);
+	}
+	return bNewQuery;
+}
+
+void UClientInterestManager::SendQuery()
+{
+	InterestMsg.set_connid(ClientNetConn->GetConnId());
+	ChanneldUtils::GetConnToChanneld(ClientNetConn)->Send(ClientNetConn->GetSendToChannelId(), channeldpb::UPDATE_SPATIAL_INTEREST, InterestMsg);
+	// Clear() keeps the allocated sub-messages and spots for the next query.
+	InterestMsg.mutable_query()->Clear();
+
+	if (bHasSentQuery && InterestMetrics.IsValid())
+	{
+		InterestMetrics.SpawnsPerChange->Observe(NumSpawnsSinceQuery);
+	}
+	NumSpawnsSinceQuery = 0;
+	bHasSentQuery = true;
+
+	UpdateSpatialSubOptions();
+}
+
+void UClientInterestManager::UpdateSpatialSubOptions()
+{
+	if (!ActiveAOIs.ContainsByPredicate([](const UAreaOfInterestBase* AOI) { return AOI->bOverrideSubOptions; }))
+	{
+		return;
+	}
+
+	UChanneldConnection* Conn = ChanneldUtils::GetConnToChanneld(ClientNetConn);
+	const FChanneldSpatialRegionIndex& RegionIndex = Conn->GetSpatialRegionIndex();
+	if (RegionIndex.IsEmpty())
+	{
+		// The options are applied with the next query after the regions arrive.
+		Conn->RequestSpatialRegions();
+		return;
+	}
+
+	for (const FChanneldSpatialRegionIndex::FRegion& Region : RegionIndex.GetRegions())
+	{
+		const FBox2D RegionBounds(FVector2D(Region.Bounds.Min), FVector2D(Region.Bounds.Max));
+		const int32 AOIIndex = ActiveAOIs.IndexOfByPredicate([&RegionBounds](const UAreaOfInterestBase* AOI) { return AOI->IntersectsRegion(RegionBounds); });
+		const UAreaOfInterestBase* AOI = ActiveAOIs.IsValidIndex(AOIIndex) ? ActiveAOIs[AOIIndex] : nullptr;
+		// Out of the interest, or no change since the last query.
+		const UAreaOfInterestBase*& AppliedAOI = SpatialChannelAOIs.FindOrAdd(Region.ChId);
+		if (AOI == AppliedAOI)
+		{
+			continue;
+		}
+		AppliedAOI = AOI;
+		if (AOI == nullptr)
+		{
+			continue;
+		}
+
+		channeldpb::SubscribedToChannelMessage SubMsg;
+		SubMsg.set_connid(ClientNetConn->GetConnId());
+		SubMsg.mutable_suboptions()->set_dataaccess(channeldpb::READ_ACCESS);
+		SubMsg.mutable_suboptions()->set_fanoutintervalms(AOI->FanOutIntervalMs);
+		for (const FString& Mask : AOI->DataFieldMasks)
+		{
+			SubMsg.mutable_suboptions()->add_datafieldmasks(TCHAR_TO_UTF8(*Mask));
+		}
+
+		if (Conn->OwnedChannels.Contains(Region.ChId))
+		{
+			Conn->SubConnectionToChannel(SubMsg.connid(), Region.ChId, &SubMsg.suboptions());
+		}
+		else
+		{
+			// Only the owner of the channel can update the subscription of another connection. channeld forwards the message to the owner.
+			Conn->Send(Region.ChId, Channeld::SpatialSubOptionsMsgType, SubMsg);
+		}
+		UE_LOG(LogChanneld, Verbose, TEXT("[Server] Spatial channel %d uses the subscription options of AOI %s for client conn %d"), Region.ChId, *AOI->Name.ToString(), SubMsg.connid());
+	}
+}
+
+void UClientInterestManager::TickReplicationLOD(float DeltaTime)
+{
+	if (EntityLODBands.Num() > 0)
+	{
+		TimeSinceLODUpdate += DeltaTime;
+		if (TimeSinceLODUpdate >= GetMutableDefault<UChanneldSettings>()->ReplicationLODUpdateInterval)
+		{
+			TimeSinceLODUpdate = 0;
+			UpdateReplicationLOD();
+		}
+	}
+}
+
+bool UClientInterestManager::IsReplicationLODEnabled()
+{
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	return Settings->ReplicationLODBands.Num() > 0 || Settings->EntityInterestRadius > 0;
+}
+
+void UClientInterestManager::OnClientSubscribedToEntityChannel(Channeld::ChannelId ChId)
+{
+	if (IsReplicationLODEnabled())
+	{
+		// Also triggered by the subscription updated by UpdateReplicationLOD(), so don't reset the band.
+		EntityLODBands.FindOrAdd(ChId, INDEX_NONE);
+	}
+
+	bool bAlreadySubscribed = false;
+	SubscribedEntityChannels.Add(ChId, &bAlreadySubscribed);
+	if (!bAlreadySubscribed)
+	{
+		NumSpawnsSinceQuery++;
+	}
+	UpdateInterestMetrics(!bAlreadySubscribed);
+}
+
+void UClientInterestManager::OnClientUnsubscribedFromEntityChannel(Channeld::ChannelId ChId)
+{
+	EntityLODBands.Remove(ChId);
+	UpdateInterestMetrics(SubscribedEntityChannels.Remove(ChId) > 0);
+}
+
+void UClientInterestManager::OnClientSubscribedToSpatialChannel(Channeld::ChannelId ChId)
+{
+	bool bAlreadySubscribed = false;
+	SubscribedSpatialChannels.Add(ChId, &bAlreadySubscribed);
+	UpdateInterestMetrics(!bAlreadySubscribed);
+}
+
+void UClientInterestManager::OnClientUnsubscribedFromSpatialChannel(Channeld::ChannelId ChId)
+{
+	UpdateInterestMetrics(SubscribedSpatialChannels.Remove(ChId) > 0);
+}
+
+void UClientInterestManager::UpdateInterestMetrics(bool bChanged)
+{
+	if (!bChanged || !InterestMetrics.IsValid())
+	{
+		return;
+	}
+	InterestMetrics.SpatialChannels->Set(SubscribedSpatialChannels.Num());
+	InterestMetrics.EntityChannels->Set(SubscribedEntityChannels.Num());
+	InterestMetrics.Churn->Increment();
+}
+
+void UClientInterestManager::UpdateReplicationLOD()
+{
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	if (!IsReplicationLODEnabled() || !ClientNetConn->PlayerController || !ClientNetConn->Driver)
+	{
+		return;
+	}
+	APawn* Pawn = ClientNetConn->PlayerController->GetPawn();
+	if (!Pawn)
+	{
+		return;
 	}
 
-	if (bNewQuery)
+	const FVector PawnLocation = Pawn->GetActorLocation();
+	UChanneldConnection* Conn = ChanneldUtils::GetConnToChanneld(ClientNetConn);
+	// The entities in the entity interest use the default band if no band is configured.
+	TArray<FChanneldReplicationLODBand> Bands = Settings->ReplicationLODBands;
+	if (Bands.Num() == 0)
+	{
+		Bands.AddDefaulted();
+	}
+	// The last band is for the entities out of the entity interest. Only the objRef, which rarely changes, is fanned out.
+	const int32 CulledBand = Bands.Num();
+	FChanneldReplicationLODBand& Culled = Bands.AddDefaulted_GetRef();
+	Culled.FanOutIntervalMs = Settings->CulledEntityFanOutIntervalMs;
+	Culled.DataFieldMasks.Add(TEXT("objRef"));
+	const float EntityInterestRadiusSq = FMath::Square(Settings->EntityInterestRadius);
+	// The entity channels to subscribe the client again, by the new band. The entities that come back from the culled band need
+	// the full state, as the client hasn't received their updates meanwhile.
+	TArray<TArray<TPair<Channeld::ConnectionId, Channeld::ChannelId>>> SubsByBand, FullStateSubsByBand;
+	SubsByBand.SetNum(CulledBand + 1);
+	FullStateSubsByBand.SetNum(CulledBand + 1);
+	for (auto& Pair : EntityLODBands)
 	{
-		channeldpb::UpdateSpatialInterestMessage InterestMsg;
-		InterestMsg.set_connid(ClientNetConn->GetConnId());
-		InterestMsg.mutable_query()->MergeFrom(QueryForTick);
-		GEngine->GetEngineSubsystem<UChanneldConnection>()->Send(ClientNetConn->GetSendToChannelId(), channeldpb::UPDATE_SPATIAL_INTEREST, InterestMsg);
-		QueryForTick.Clear();
+		// The entity channel id is the NetGUID of the entity.
+		const AActor* Entity = Cast<AActor>(ClientNetConn->Driver->GuidCache->GetObjectFromNetGUID(FNetworkGUID(Pair.Key), false));
+		if (!Entity)
+		{
+			continue;
+		}
+
+		const float DistSq = FVector::DistSquared(PawnLocation, Entity->GetActorLocation());
+		int32 Band = CulledBand - 1;
+		for (int32 i = 0; i < CulledBand - 1; i++)
+		{
+			if (DistSq <= FMath::Square(Bands[i].MaxDistance))
+			{
+				Band = i;
+				break;
+			}
+		}
+		if (EntityInterestRadiusSq > 0 && !Entity->bAlwaysRelevant && Entity != Pawn)
+		{
+			if (DistSq > EntityInterestRadiusSq || (Settings->bUseNetRelevancyForUninterestedActors
+				&& !Entity->IsNetRelevantFor(ClientNetConn->PlayerController, Pawn, PawnLocation)))
+			{
+				Band = CulledBand;
+			}
+		}
+		if (Band == Pair.Value)
+		{
+			continue;
+		}
+		// Without the configured bands, the entities in the entity interest keep the options they are subscribed with.
+		if (Pair.Value == INDEX_NONE && Settings->ReplicationLODBands.Num() == 0 && Band != CulledBand)
+		{
+			Pair.Value = Band;
+			continue;
+		}
+		const bool bFullState = Pair.Value == CulledBand;
+		Pair.Value = Band;
+		(bFullState ? FullStateSubsByBand : SubsByBand)[Band].Emplace(ClientNetConn->GetConnId(), Pair.Key);
+		UE_LOG(LogChanneld, Verbose, TEXT("[Server] Entity %s is in LOD band %d of client conn %d"), *Entity->GetName(), Band, ClientNetConn->GetConnId());
+	}
+
+	for (int32 Band = 0; Band < Bands.Num(); Band++)
+	{
+		if (SubsByBand[Band].Num() == 0 && FullStateSubsByBand[Band].Num() == 0)
+		{
+			continue;
+		}
+
+		// Subscribing the client again updates the options of the existing subscription.
+		channeldpb::ChannelSubscriptionOptions SubOptions;
+		SubOptions.set_dataaccess(channeldpb::READ_ACCESS);
+		SubOptions.set_fanoutintervalms(Bands[Band].FanOutIntervalMs);
+		for (const FString& Mask : Bands[Band].DataFieldMasks)
+		{
+			SubOptions.add_datafieldmasks(TCHAR_TO_UTF8(*Mask));
+		}
+		if (FullStateSubsByBand[Band].Num() > 0)
+		{
+			Conn->SubConnectionsToChannels(FullStateSubsByBand[Band], &SubOptions);
+		}
+		if (SubsByBand[Band].Num() > 0)
+		{
+			// The client already has the full state of the entity.
+			SubOptions.set_skipfirstfanout(true);
+			Conn->SubConnectionsToChannels(SubsByBand[Band], &SubOptions);
+		}
 	}
 }
 
@@ -204,7 +484,7 @@ void UClientInterestManager::ForceUpdate()
 
 void UClientInterestManager::OnPlayerEnterSpatialChannel(UChanneldNetConnection* NetConn, Channeld::ChannelId SpatialChId)
 {
-	channeldpb::UpdateSpatialInterestMessage InterestMsg;
+	// The query of the tick is empty outside TickFlush(), so the message can be reused here.
 	InterestMsg.set_connid(NetConn->GetConnId());
 	FVector PawnLocation;
 	FRotator PawnRotation;
@@ -226,5 +506,6 @@ void UClientInterestManager::OnPlayerEnterSpatialChannel(UChanneldNetConnection*
 		AOI->SetSpatialQuery(Query, PawnLocation, PawnRotation);
 	}
 	
-	GEngine->GetEngineSubsystem<UChanneldConnection>()->Send(SpatialChId, channeldpb::UPDATE_SPATIAL_INTEREST, InterestMsg);
+	ChanneldUtils::GetConnToChanneld(ClientNetConn)->Send(SpatialChId, channeldpb::UPDATE_SPATIAL_INTEREST, InterestMsg);
+	Query->Clear();
 }
@@ -2,11 +2,17 @@
 
 #include "CoreMinimal.h"
 #include "AreaOfInterestBase.h"
+#include "PlayerFollowingAOI.h"
+#include "ChanneldMetrics.h"
 #include "ChanneldNetConnection.h"
 #include "ClientInterestManager.generated.h"
 
 UCLASS(BlueprintType)
-class CHANNELDUE_API UClientInterestManager : public UObject, public FTickableGameObject
+/**
+ * The spatial interest of a client connection in the server. Not ticked by itself: UChanneldNetDriver evaluates the interest of all
+ * the client connections in one pass in TickFlush(), before the outgoing messages are flushed to channeld.
+ */
+class CHANNELDUE_API UClientInterestManager : public UObject
 {
 	GENERATED_BODY()
 public:
@@ -14,9 +20,12 @@ public:
 	void ServerSetup(UChanneldNetConnection* InClientNetConn);
 	void CleanUp();
 
-	virtual bool IsTickable() const override;
-	virtual void Tick(float DeltaTime) override;
-	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UClientInterestManager, STATGROUP_Tickables); }
+	bool IsActive() const;
+	// Evaluate the active AOIs. Doesn't send anything, so it can run in parallel with the other clients'. Returns true if the query has changed.
+	bool TickQuery(float DeltaTime);
+	// Send the query evaluated in TickQuery() to channeld. Must be called from the game thread.
+	void SendQuery();
+	void TickReplicationLOD(float DeltaTime);
 
 	void AddAOI(UAreaOfInterestBase* AOI, bool bActivate = false);
 	
@@ -40,6 +49,13 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "Channeld|Interest")
 	void ForceUpdate();
+
+	// [Server] Track the entity channels the client is subscribed to, for the replication LOD. See UChanneldSettings::ReplicationLODBands.
+	void OnClientSubscribedToEntityChannel(Channeld::ChannelId ChId);
+	void OnClientUnsubscribedFromEntityChannel(Channeld::ChannelId ChId);
+	// [Server] Track the spatial channels owned by this server that the client is subscribed to, for the interest metrics.
+	void OnClientSubscribedToSpatialChannel(Channeld::ChannelId ChId);
+	void OnClientUnsubscribedFromSpatialChannel(Channeld::ChannelId ChId);
 	
 private:
 	
@@ -51,7 +67,33 @@ private:
 	UPROPERTY()
 	TArray<UAreaOfInterestBase*> ActiveAOIs;
 
-	channeldpb::SpatialInterestQuery QueryForTick;
+	// Reused for every query, so the sub-messages of the query are cleared and updated in place instead of being reallocated.
+	channeldpb::UpdateSpatialInterestMessage InterestMsg;
+
+	FChanneldFollowTargets FollowTargets;
+	// Collect the targets of the active player following AOIs. Called when the followed actors or the active AOIs change.
+	void UpdateFollowTargets();
+
+	// The LOD band of the entity channels the client is subscribed to, by the channel id. INDEX_NONE if not evaluated yet.
+	// The band after the last of UChanneldSettings::ReplicationLODBands means the entity is out of the client's entity interest.
+	TMap<Channeld::ChannelId, int32> EntityLODBands;
+
+	// The channels owned by this server that the client is subscribed to. Summed over the servers by connId in the metrics.
+	TSet<Channeld::ChannelId> SubscribedSpatialChannels;
+	TSet<Channeld::ChannelId> SubscribedEntityChannels;
+	FChanneldInterestMetrics InterestMetrics;
+	// The entity channels subscribed since the last query was sent, observed as the spawns of that interest change.
+	int32 NumSpawnsSinceQuery = 0;
+	bool bHasSentQuery = false;
+	void UpdateInterestMetrics(bool bChanged);
+
+	// The AOI whose subscription options are applied to each spatial channel. See UAreaOfInterestBase::bOverrideSubOptions.
+	TMap<Channeld::ChannelId, const UAreaOfInterestBase*> SpatialChannelAOIs;
+	void UpdateSpatialSubOptions();
+	static bool IsReplicationLODEnabled();
+	float TimeSinceLODUpdate = 0;
+	// Update the subscription options of the entities that have moved to another band.
+	void UpdateReplicationLOD();
 
 	// TWeakObjectPtr<APlayerController> FollowingPC;
 	//
@@ -16,9 +16,9 @@ void UConeAOI::SetSpatialQuery(channeldpb::SpatialInterestQuery* Query, const FV
 {
 	ChanneldUtils::SetSpatialInfoPB(Query->mutable_coneaoi()->mutable_center(), PawnLocation);
 	ChanneldUtils::SetSpatialInfoPB(Query->mutable_coneaoi()->mutable_direction(), PawnRotation.Vector());
-	Query->mutable_coneaoi()->set_radius(Radius);
+	Query->mutable_coneaoi()->set_radius(Radius + HysteresisMargin);
 	// Angle is in radians in channeld
-	Query->mutable_coneaoi()->set_angle(fmod(Angle, 360.f) * PI / 180.f);
+	Query->mutable_coneaoi()->set_angle(FMath::Min(Angle + AngleHysteresis, 360.f) * PI / 180.f);
 	
 	UE_LOG(LogChanneld, Verbose, TEXT("Updating the ConeAOI with %s"), UTF8_TO_TCHAR(Query->mutable_coneaoi()->ShortDebugString().c_str()));
 }
@@ -27,10 +27,18 @@ bool UConeAOI::TickQuery(channeldpb::SpatialInterestQuery* Query, float DeltaTim
 {
 	if (FollowingPC.IsValid())
 	{
-		FRotator CurrentRotation = FollowingPC->GetControlRotation();
-		if (!CurrentRotation.Equals(LastUpdateRotation))
+		FRotator CurrentRotation = GetFollowRotation();
+		if (bQueryCoveredRegions)
 		{
-			SetSpatialQuery(Query, FollowingPC->GetFocalLocation(), CurrentRotation);
+			// The covered regions are re-evaluated every tick, but only sent when they change.
+			LastUpdateRotation = CurrentRotation;
+			return Super::TickQuery(Query, DeltaTime);
+		}
+
+		// The cone is widened by the hysteresis, so it still covers the view until the player turns beyond half of it.
+		if (!CurrentRotation.Equals(LastUpdateRotation, FMath::Max(AngleHysteresis * 0.5f, KINDA_SMALL_NUMBER)))
+		{
+			SetSpatialQuery(Query, GetQueryLocation(), CurrentRotation);
 			LastUpdateRotation = CurrentRotation;
 			return true;
 		}
@@ -40,3 +48,67 @@ bool UConeAOI::TickQuery(channeldpb::SpatialInterestQuery* Query, float DeltaTim
 	
 	return false;
 }
+
+bool UConeAOI::IntersectsRegion(const FBox2D& Region) const
+{
+	const FVector2D Apex(LastUpdateLocation);
+	const float ConeRadius = Radius + HysteresisMargin;
+	if (FVector2D::DistSquared(Apex, Region.GetClosestPointTo(Apex)) > FMath::Square(ConeRadius))
+	{
+		return false;
+	}
+
+	// A cone wider than a half circle is not convex, so it's approximated as the sphere.
+	const float ConeAngle = FMath::Min(Angle + AngleHysteresis, 360.f);
+	FVector2D Direction(LastUpdateRotation.Vector());
+	if (ConeAngle >= 180.f || !Direction.Normalize())
+	{
+		return true;
+	}
+
+	// The sector on the XY plane as a convex polygon, with the arc points pushed out to enclose the arc.
+	constexpr int32 NumArcSegments = 8;
+	const float HalfAngle = FMath::DegreesToRadians(ConeAngle * 0.5f);
+	const float Step = HalfAngle * 2.f / NumArcSegments;
+	const float ArcRadius = ConeRadius / FMath::Cos(Step * 0.5f);
+	const float DirAngle = FMath::Atan2(Direction.Y, Direction.X);
+	TArray<FVector2D, TInlineAllocator<NumArcSegments + 2>> Polygon;
+	Polygon.Add(Apex);
+	for (int32 i = 0; i <= NumArcSegments; i++)
+	{
+		const float PointAngle = DirAngle - HalfAngle + Step * i;
+		// The ends of the arc are on the edges of the cone, so they don't need to be pushed out.
+		const float PointRadius = (i == 0 || i == NumArcSegments) ? ConeRadius : ArcRadius;
+		Polygon.Add(Apex + FVector2D(FMath::Cos(PointAngle), FMath::Sin(PointAngle)) * PointRadius);
+	}
+
+	// Separating axis test: the axes of the box, then the normals of the polygon's edges.
+	if (!Region.Intersect(FBox2D(Polygon.GetData(), Polygon.Num())))
+	{
+		return false;
+	}
+	const FVector2D Corners[4] = { Region.Min, FVector2D(Region.Max.X, Region.Min.Y), Region.Max, FVector2D(Region.Min.X, Region.Max.Y) };
+	for (int32 i = 0; i < Polygon.Num(); i++)
+	{
+		const FVector2D Edge = Polygon[(i + 1) % Polygon.Num()] - Polygon[i];
+		const FVector2D Normal(-Edge.Y, Edge.X);
+		double PolygonMin = MAX_dbl, PolygonMax = -MAX_dbl, BoxMin = MAX_dbl, BoxMax = -MAX_dbl;
+		for (const FVector2D& Point : Polygon)
+		{
+			const double Projection = FVector2D::DotProduct(Point, Normal);
+			PolygonMin = FMath::Min(PolygonMin, Projection);
+			PolygonMax = FMath::Max(PolygonMax, Projection);
+		}
+		for (const FVector2D& Corner : Corners)
+		{
+			const double Projection = FVector2D::DotProduct(Corner, Normal);
+			BoxMin = FMath::Min(BoxMin, Projection);
+			BoxMax = FMath::Max(BoxMax, Projection);
+		}
+		if (PolygonMax < BoxMin || BoxMax < PolygonMin)
+		{
+			return false;
+		}
+	}
+	return true;
+}
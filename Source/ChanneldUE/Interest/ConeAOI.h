@@ -11,6 +11,7 @@ class CHANNELDUE_API UConeAOI : public UPlayerFollowingAOI
 public:
 	virtual void FollowActor(AActor* Target) override;
 	virtual void SetSpatialQuery(channeldpb::SpatialInterestQuery* Query, const FVector& PawnLocation, const FRotator& PawnRotation) override;
+	virtual bool IntersectsRegion(const FBox2D& Region) const override;
 	virtual bool TickQuery(channeldpb::SpatialInterestQuery* Query, float DeltaTime) override;
 	
 	UPROPERTY(EditAnywhere)
@@ -19,6 +20,10 @@ public:
 	UPROPERTY(EditAnywhere)
 	float Angle;
 
+	// The extra angle (in degrees) added to the cone. The direction is not updated until the player turns beyond half of it.
+	UPROPERTY(EditAnywhere)
+	float AngleHysteresis = 0;
+
 protected:
 	FRotator LastUpdateRotation;
 };
\ No newline at end of file
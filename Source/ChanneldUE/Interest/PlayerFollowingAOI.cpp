@@ -1,11 +1,63 @@
 #include "PlayerFollowingAOI.h"
 
+#include "ChanneldConnection.h"
+#include "ChanneldUtils.h"
+#include "GameFramework/Pawn.h"
+
+int32 FChanneldFollowTargets::AddUnique(APlayerController* PC)
+{
+	int32 Index = PCs.IndexOfByKey(PC);
+	if (Index == INDEX_NONE)
+	{
+		Index = PCs.Add(PC);
+		FocalLocations.AddZeroed();
+		Velocities.AddZeroed();
+		ControlRotations.AddZeroed();
+	}
+	return Index;
+}
+
+void FChanneldFollowTargets::Reset()
+{
+	PCs.Reset();
+	FocalLocations.Reset();
+	Velocities.Reset();
+	ControlRotations.Reset();
+}
+
+void FChanneldFollowTargets::Gather()
+{
+	for (int32 i = 0; i < PCs.Num(); i++)
+	{
+		if (const APlayerController* PC = PCs[i].Get())
+		{
+			FocalLocations[i] = PC->GetFocalLocation();
+			ControlRotations[i] = PC->GetControlRotation();
+			const APawn* Pawn = PC->GetPawn();
+			Velocities[i] = Pawn ? Pawn->GetVelocity() : FVector::ZeroVector;
+		}
+	}
+}
+
+void UPlayerFollowingAOI::SetFollowTarget(const FChanneldFollowTargets* InTargets, int32 InIndex)
+{
+	FollowTargets = InTargets;
+	FollowTargetIndex = InIndex;
+}
+
 void UPlayerFollowingAOI::FollowActor(AActor* Target)
 {
 	if (auto PC = Cast<APlayerController>(Target))
 	{
 		FollowingPC = PC;
-		LastUpdateLocation = PC->GetFocalLocation();
+		// The gathered targets are stale until UClientInterestManager re-gathers them.
+		SetFollowTarget(nullptr, INDEX_NONE);
+		LastUpdateLocation = GetQueryLocation();
+		CoveredRegions.Reset();
+		if (bQueryCoveredRegions)
+		{
+			ChanneldUtils::GetConnToChanneld(FollowingPC.Get())->RequestSpatialRegions();
+		}
 	}
 }
 
@@ -14,29 +66,101 @@ void UPlayerFollowingAOI::UnfollowActor(AActor* Target)
 	if (Target == FollowingPC)
 	{
 		FollowingPC = nullptr;
+		SetFollowTarget(nullptr, INDEX_NONE);
 	}
 }
 
+FVector UPlayerFollowingAOI::GetQueryLocation() const
+{
+	if (HasGatheredTarget())
+	{
+		return FollowTargets->FocalLocations[FollowTargetIndex] + FollowTargets->Velocities[FollowTargetIndex] * LookAheadSeconds;
+	}
+
+	FVector Location = FollowingPC->GetFocalLocation();
+	if (LookAheadSeconds > 0)
+	{
+		if (const APawn* Pawn = FollowingPC->GetPawn())
+		{
+			Location += Pawn->GetVelocity() * LookAheadSeconds;
+		}
+	}
+	return Location;
+}
+
+FRotator UPlayerFollowingAOI::GetFollowRotation() const
+{
+	return HasGatheredTarget() ? FollowTargets->ControlRotations[FollowTargetIndex] : FollowingPC->GetControlRotation();
+}
+
 bool UPlayerFollowingAOI::TickQuery(channeldpb::SpatialInterestQuery* Query, float DeltaTime)
 {
 	if (FollowingPC.IsValid())
 	{
-		FVector CurrentLocation = FollowingPC->GetFocalLocation();
-		if (MinDistanceToTriggerUpdate > 0)
+		if (bQueryCoveredRegions)
 		{
-			if (!CurrentLocation.Equals(LastUpdateLocation, MinDistanceToTriggerUpdate))
+			// Fall back to the geometry until the regions arrive.
+			const FChanneldSpatialRegionIndex& RegionIndex = ChanneldUtils::GetConnToChanneld(FollowingPC.Get())->GetSpatialRegionIndex();
+			if (!RegionIndex.IsEmpty())
 			{
-				SetSpatialQuery(Query, CurrentLocation, FollowingPC->GetControlRotation());
+				LastUpdateLocation = GetQueryLocation();
+				return QueryCoveredRegions(Query, RegionIndex);
+			}
+		}
+
+		FVector CurrentLocation = GetQueryLocation();
+		// The area is padded with the margin, so it still covers the player until it moves beyond the margin.
+		const float TriggerDistance = FMath::Max(MinDistanceToTriggerUpdate, HysteresisMargin);
+		if (TriggerDistance > 0)
+		{
+			if (!CurrentLocation.Equals(LastUpdateLocation, TriggerDistance))
+			{
+				SetSpatialQuery(Query, CurrentLocation, GetFollowRotation());
 				LastUpdateLocation = CurrentLocation;
 				return true;
 			}
 		}
 		else
 		{
-			SetSpatialQuery(Query, CurrentLocation, FollowingPC->GetControlRotation());
+			SetSpatialQuery(Query, CurrentLocation, GetFollowRotation());
+			LastUpdateLocation = CurrentLocation;
 			return true;
 		}
 	}
 	
 	return false;
 }
+
+bool UPlayerFollowingAOI::QueryCoveredRegions(channeldpb::SpatialInterestQuery* Query, const FChanneldSpatialRegionIndex& RegionIndex)
+{
+	const TArray<FChanneldSpatialRegionIndex::FRegion>& Regions = RegionIndex.GetRegions();
+	TArray<int32, TInlineAllocator<64>> RegionIndices;
+	int32 NumUnchanged = 0;
+	for (int32 i = 0; i < Regions.Num(); i++)
+	{
+		if (IntersectsRegion(FBox2D(FVector2D(Regions[i].Bounds.Min), FVector2D(Regions[i].Bounds.Max))))
+		{
+			if (CoveredRegions.IsValidIndex(RegionIndices.Num()) && CoveredRegions[RegionIndices.Num()] == Regions[i].ChId)
+			{
+				NumUnchanged++;
+			}
+			RegionIndices.Add(i);
+		}
+	}
+	if (NumUnchanged == RegionIndices.Num() && NumUnchanged == CoveredRegions.Num())
+	{
+		return false;
+	}
+
+	CoveredRegions.Reset(RegionIndices.Num());
+	for (const int32 i : RegionIndices)
+	{
+		CoveredRegions.Add(Regions[i].ChId);
+		// The regions can be unbounded on the Z axis, so the spots are at the height of the player.
+		const FVector2D RegionCenter = FVector2D(Regions[i].Bounds.GetCenter());
+		ChanneldUtils::SetSpatialInfoPB(Query->mutable_spotsaoi()->add_spots(), FVector(RegionCenter, LastUpdateLocation.Z));
+		Query->mutable_spotsaoi()->add_dists(0);
+	}
+	UE_LOG(LogChanneld, Verbose, TEXT("Updating %s with %d covered regions"), *Name.ToString(), CoveredRegions.Num());
+	return true;
+}
@@ -2,6 +2,24 @@
 #include "AreaOfInterestBase.h"
 #include "PlayerFollowingAOI.generated.h"
 
+/**
+ * The targets followed by the active AOIs of a client, as a struct of arrays. Gathered once per tick by UClientInterestManager, so
+ * the AOIs following the same target read the cached state instead of querying the actor each.
+ */
+struct CHANNELDUE_API FChanneldFollowTargets
+{
+	TArray<TWeakObjectPtr<APlayerController>> PCs;
+	TArray<FVector> FocalLocations;
+	TArray<FVector> Velocities;
+	TArray<FRotator> ControlRotations;
+
+	int32 Num() const { return PCs.Num(); }
+	int32 AddUnique(APlayerController* PC);
+	void Reset();
+	// Cache the state of all the targets. The invalid targets keep the state of the last gather.
+	void Gather();
+};
+
 UCLASS(Abstract)
 class CHANNELDUE_API UPlayerFollowingAOI : public UAreaOfInterestBase
 {
@@ -13,8 +31,38 @@ public:
 	virtual void UnfollowActor(AActor* Target) override;
 
 	virtual bool TickQuery(channeldpb::SpatialInterestQuery* Query, float DeltaTime) override;
+
+	APlayerController* GetFollowingPC() const { return FollowingPC.Get(); }
+	// Read the state of the following PC from the gathered targets instead of the PC. Reset by FollowActor().
+	void SetFollowTarget(const FChanneldFollowTargets* InTargets, int32 InIndex);
+
+	// The extra distance added to the area. The query is not updated until the player moves beyond it, so the area always covers the player.
+	UPROPERTY(EditAnywhere)
+	float HysteresisMargin = 0;
+
+	// Move the center of the area ahead along the velocity of the player's pawn by the seconds, so the channels ahead are subscribed earlier.
+	UPROPERTY(EditAnywhere)
+	float LookAheadSeconds = 0;
+
+	// Query the spatial regions that the area overlaps (see IntersectsRegion()) as spots, resolved from the local spatial region index,
+	// instead of the geometry. The query is only sent when the set of the regions changes, e.g. not for every turn of a wide cone.
+	UPROPERTY(EditAnywhere)
+	bool bQueryCoveredRegions = false;
 	
 protected:
+	// Returns true and sets the spots of the query if the covered regions have changed.
+	bool QueryCoveredRegions(channeldpb::SpatialInterestQuery* Query, const class FChanneldSpatialRegionIndex& RegionIndex);
+	// The channels of the regions in the last query, in the order of the region index.
+	TArray<Channeld::ChannelId> CoveredRegions;
+
+	// The center of the area to query, with the look-ahead.
+	FVector GetQueryLocation() const;
+	FRotator GetFollowRotation() const;
+
+	const FChanneldFollowTargets* FollowTargets = nullptr;
+	int32 FollowTargetIndex = INDEX_NONE;
+	bool HasGatheredTarget() const { return FollowTargets && FollowTargets->PCs.IsValidIndex(FollowTargetIndex); }
+
 	TWeakObjectPtr<APlayerController> FollowingPC;
 	FVector LastUpdateLocation;
 
@@ -5,9 +5,15 @@
 void USphereAOI::SetSpatialQuery(channeldpb::SpatialInterestQuery* Query, const FVector& PawnLocation, const FRotator& PawnRotation)
 {
 	ChanneldUtils::SetSpatialInfoPB(Query->mutable_sphereaoi()->mutable_center(), PawnLocation);
-	Query->mutable_sphereaoi()->set_radius(Radius);
+	Query->mutable_sphereaoi()->set_radius(Radius + HysteresisMargin);
 	
-	UE_LOG(LogChanneld, Verbose, TEXT("Updating the SphereAOI with center=%s, radius=%f"), *PawnLocation.ToCompactString(), Radius);
+	UE_LOG(LogChanneld, Verbose, TEXT("Updating the SphereAOI with center=%s, radius=%f"), *PawnLocation.ToCompactString(), Radius + HysteresisMargin);
 
 	// DrawDebugSphere(GetWorld(), PawnLocation, Radius, 16, FColor::Red, false, 0.1f, 0, 1.0f);
 }
+
+bool USphereAOI::IntersectsRegion(const FBox2D& Region) const
+{
+	const FVector2D Center(LastUpdateLocation);
+	return FVector2D::DistSquared(Center, Region.GetClosestPointTo(Center)) <= FMath::Square(Radius + HysteresisMargin);
+}
@@ -12,6 +12,7 @@ public:
 	// USphereAOI(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get()) {}
 	
 	virtual void SetSpatialQuery(channeldpb::SpatialInterestQuery* Query, const FVector& PawnLocation, const FRotator& PawnRotation) override;
+	virtual bool IntersectsRegion(const FBox2D& Region) const override;
 
 	UPROPERTY(EditAnywhere)
 	float Radius;
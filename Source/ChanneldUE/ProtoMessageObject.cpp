@@ -2,6 +2,20 @@
 #include "ChanneldConnection.h"
 #include "google/protobuf/any.pb.h"
 
+namespace
+{
+	// The fields looked up by name, per message type. Only accessed on the game thread, by Blueprint.
+	TMap<TPair<const google::protobuf::Descriptor*, FName>, const google::protobuf::FieldDescriptor*> FieldDescriptorCache;
+
+	using FCppType = google::protobuf::FieldDescriptor::CppType;
+
+	FORCEINLINE bool IsFieldOfType(const google::protobuf::FieldDescriptor* FD, FCppType CppType)
+	{
+		// The reflection accessors crash on the field of another type or label.
+		return FD != nullptr && FD->cpp_type() == CppType && !FD->is_repeated();
+	}
+}
+
 UProtoMessageObject::~UProtoMessageObject()
 {
 	if (bMessageLifeTogether)
@@ -63,7 +77,7 @@ UProtoMessageObject* UProtoMessageObject::CloneEmptyFieldMessage(bool& bSuccess,
 
 bool UProtoMessageObject::GetBoolByName(bool& bSuccess, FString FieldName)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		bSuccess = true;
@@ -78,7 +92,7 @@ bool UProtoMessageObject::GetBoolByName(bool& bSuccess, FString FieldName)
 
 int32 UProtoMessageObject::GetInt32ByName(bool& bSuccess, FString FieldName)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		bSuccess = true;
@@ -93,7 +107,7 @@ int32 UProtoMessageObject::GetInt32ByName(bool& bSuccess, FString FieldName)
 
 int64 UProtoMessageObject::GetUint32ByName(bool& bSuccess, FString FieldName)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		bSuccess = true;
@@ -108,7 +122,7 @@ int64 UProtoMessageObject::GetUint32ByName(bool& bSuccess, FString FieldName)
 
 int64 UProtoMessageObject::GetInt64ByName(bool& bSuccess, FString FieldName)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		bSuccess = true;
@@ -129,7 +143,7 @@ int64 UProtoMessageObject::GetUInt64ByName(bool& bSuccess, FString FieldName)
 
 float UProtoMessageObject::GetFloatByName(bool& bSuccess, FString FieldName)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		bSuccess = true;
@@ -144,7 +158,7 @@ float UProtoMessageObject::GetFloatByName(bool& bSuccess, FString FieldName)
 
 FString UProtoMessageObject::GetStringByName(bool& bSuccess, FString FieldName)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		bSuccess = true;
@@ -159,7 +173,7 @@ FString UProtoMessageObject::GetStringByName(bool& bSuccess, FString FieldName)
 
 UProtoMessageObject* UProtoMessageObject::GetMessageByName(bool& bSuccess, FString FieldName)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	UProtoMessageObject* ChildMessage = NewObject<UProtoMessageObject>();
 	if (FD != NULL)
 	{
@@ -209,7 +223,7 @@ void UProtoMessageObject::UnpackMessageByFullProtoName(bool& bSuccess, UProtoMes
 
 void UProtoMessageObject::GetMessagesRepeatedByName(bool& bSuccess, TArray<UProtoMessageObject*>& MessageRepeated, FString FieldName)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		int Size = Message->GetReflection()->FieldSize(*Message, FD);
@@ -230,7 +244,7 @@ void UProtoMessageObject::GetMessagesRepeatedByName(bool& bSuccess, TArray<UProt
 
 UProtoMessageObject* UProtoMessageObject::SetBoolByName(bool& bSuccess, FString FieldName, bool Value)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		bSuccess = true;
@@ -245,7 +259,7 @@ UProtoMessageObject* UProtoMessageObject::SetBoolByName(bool& bSuccess, FString
 
 UProtoMessageObject* UProtoMessageObject::SetInt32ByName(bool& bSuccess, FString FieldName, int32 Value)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		bSuccess = true;
@@ -260,7 +274,7 @@ UProtoMessageObject* UProtoMessageObject::SetInt32ByName(bool& bSuccess, FString
 
 UProtoMessageObject* UProtoMessageObject::SetUint32ByName(bool& bSuccess, FString FieldName, int32 Value)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		bSuccess = true;
@@ -275,7 +289,7 @@ UProtoMessageObject* UProtoMessageObject::SetUint32ByName(bool& bSuccess, FStrin
 
 UProtoMessageObject* UProtoMessageObject::SetInt64ByName(bool& bSuccess, FString FieldName, int64 Value)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		bSuccess = true;
@@ -290,7 +304,7 @@ UProtoMessageObject* UProtoMessageObject::SetInt64ByName(bool& bSuccess, FString
 
 UProtoMessageObject* UProtoMessageObject::SetUint64ByName(bool& bSuccess, FString FieldName, int64 Value)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		bSuccess = true;
@@ -305,7 +319,7 @@ UProtoMessageObject* UProtoMessageObject::SetUint64ByName(bool& bSuccess, FStrin
 
 UProtoMessageObject* UProtoMessageObject::SetFloatByName(bool& bSuccess, FString FieldName, float Value)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		bSuccess = true;
@@ -320,7 +334,7 @@ UProtoMessageObject* UProtoMessageObject::SetFloatByName(bool& bSuccess, FString
 
 UProtoMessageObject* UProtoMessageObject::SetStringByName(bool& bSuccess, FString FieldName, FString Value)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		bSuccess = true;
@@ -336,7 +350,7 @@ UProtoMessageObject* UProtoMessageObject::SetStringByName(bool& bSuccess, FStrin
 void UProtoMessageObject::SetMessageByName(bool& bSuccess, FString FieldName,
 	UProtoMessageObject* Value)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		auto Copied = Value->GetMessage()->New();
@@ -352,7 +366,7 @@ void UProtoMessageObject::SetMessageByName(bool& bSuccess, FString FieldName,
 
 UProtoMessageObject* UProtoMessageObject::AddMessageToRepeatedField(bool& bSuccess, FString FieldName, UProtoMessageObject* ChildMessage)
 {
-	const google::protobuf::FieldDescriptor* FD = Message->GetDescriptor()->FindFieldByName(TCHAR_TO_UTF8(*FieldName));
+	const google::protobuf::FieldDescriptor* FD = FindField(FieldName);
 	if (FD != NULL)
 	{
 		google::protobuf::Message* NewMessage = Message->GetReflection()->AddMessage(Message, FD);
@@ -365,3 +379,215 @@ UProtoMessageObject* UProtoMessageObject::AddMessageToRepeatedField(bool& bSucce
 	}
 	return this;
 }
+
+const google::protobuf::FieldDescriptor* UProtoMessageObject::FindField(const FName& FieldName) const
+{
+	const google::protobuf::Descriptor* MessageType = Message->GetDescriptor();
+	const TPair<const google::protobuf::Descriptor*, FName> CacheKey(MessageType, FieldName);
+	if (const google::protobuf::FieldDescriptor* const* CachedField = FieldDescriptorCache.Find(CacheKey))
+	{
+		return *CachedField;
+	}
+	const google::protobuf::FieldDescriptor* FD = MessageType->FindFieldByName(TCHAR_TO_UTF8(*FieldName.ToString()));
+	if (FD != nullptr)
+	{
+		FieldDescriptorCache.Add(CacheKey, FD);
+	}
+	return FD;
+}
+
+const google::protobuf::FieldDescriptor* UProtoMessageObject::FindField(const FProtoFieldHandle& Handle) const
+{
+	if (Handle.MessageType == Message->GetDescriptor())
+	{
+		return Handle.Field;
+	}
+	return Handle.FieldName.IsNone() ? nullptr : FindField(Handle.FieldName);
+}
+
+FProtoFieldHandle UProtoMessageObject::FindFieldHandle(bool& bSuccess, FName FieldName)
+{
+	FProtoFieldHandle Handle;
+	Handle.FieldName = FieldName;
+	Handle.Field = FindField(FieldName);
+	bSuccess = Handle.Field != nullptr;
+	if (bSuccess)
+	{
+		Handle.MessageType = Message->GetDescriptor();
+	}
+	return Handle;
+}
+
+bool UProtoMessageObject::GetBoolByHandle(bool& bSuccess, const FProtoFieldHandle& Handle)
+{
+	const google::protobuf::FieldDescriptor* FD = FindField(Handle);
+	bSuccess = IsFieldOfType(FD, FCppType::CPPTYPE_BOOL);
+	return bSuccess ? Message->GetReflection()->GetBool(*Message, FD) : false;
+}
+
+int32 UProtoMessageObject::GetInt32ByHandle(bool& bSuccess, const FProtoFieldHandle& Handle)
+{
+	const google::protobuf::FieldDescriptor* FD = FindField(Handle);
+	bSuccess = IsFieldOfType(FD, FCppType::CPPTYPE_INT32);
+	return bSuccess ? Message->GetReflection()->GetInt32(*Message, FD) : 0;
+}
+
+int64 UProtoMessageObject::GetInt64ByHandle(bool& bSuccess, const FProtoFieldHandle& Handle)
+{
+	const google::protobuf::FieldDescriptor* FD = FindField(Handle);
+	bSuccess = IsFieldOfType(FD, FCppType::CPPTYPE_INT64);
+	return bSuccess ? Message->GetReflection()->GetInt64(*Message, FD) : 0;
+}
+
+float UProtoMessageObject::GetFloatByHandle(bool& bSuccess, const FProtoFieldHandle& Handle)
+{
+	const google::protobuf::FieldDescriptor* FD = FindField(Handle);
+	bSuccess = IsFieldOfType(FD, FCppType::CPPTYPE_FLOAT);
+	return bSuccess ? Message->GetReflection()->GetFloat(*Message, FD) : 0.f;
+}
+
+FString UProtoMessageObject::GetStringByHandle(bool& bSuccess, const FProtoFieldHandle& Handle)
+{
+	const google::protobuf::FieldDescriptor* FD = FindField(Handle);
+	bSuccess = IsFieldOfType(FD, FCppType::CPPTYPE_STRING);
+	if (!bSuccess)
+	{
+		return FString();
+	}
+	std::string Scratch;
+	const std::string& Value = Message->GetReflection()->GetStringReference(*Message, FD, &Scratch);
+	return FString(UTF8_TO_TCHAR(Value.c_str()));
+}
+
+UProtoMessageObject* UProtoMessageObject::SetBoolByHandle(bool& bSuccess, const FProtoFieldHandle& Handle, bool Value)
+{
+	const google::protobuf::FieldDescriptor* FD = FindField(Handle);
+	bSuccess = IsFieldOfType(FD, FCppType::CPPTYPE_BOOL);
+	if (bSuccess)
+	{
+		Message->GetReflection()->SetBool(Message, FD, Value);
+	}
+	return this;
+}
+
+UProtoMessageObject* UProtoMessageObject::SetInt32ByHandle(bool& bSuccess, const FProtoFieldHandle& Handle, int32 Value)
+{
+	const google::protobuf::FieldDescriptor* FD = FindField(Handle);
+	bSuccess = IsFieldOfType(FD, FCppType::CPPTYPE_INT32);
+	if (bSuccess)
+	{
+		Message->GetReflection()->SetInt32(Message, FD, Value);
+	}
+	return this;
+}
+
+UProtoMessageObject* UProtoMessageObject::SetInt64ByHandle(bool& bSuccess, const FProtoFieldHandle& Handle, int64 Value)
+{
+	const google::protobuf::FieldDescriptor* FD = FindField(Handle);
+	bSuccess = IsFieldOfType(FD, FCppType::CPPTYPE_INT64);
+	if (bSuccess)
+	{
+		Message->GetReflection()->SetInt64(Message, FD, Value);
+	}
+	return this;
+}
+
+UProtoMessageObject* UProtoMessageObject::SetFloatByHandle(bool& bSuccess, const FProtoFieldHandle& Handle, float Value)
+{
+	const google::protobuf::FieldDescriptor* FD = FindField(Handle);
+	bSuccess = IsFieldOfType(FD, FCppType::CPPTYPE_FLOAT);
+	if (bSuccess)
+	{
+		Message->GetReflection()->SetFloat(Message, FD, Value);
+	}
+	return this;
+}
+
+UProtoMessageObject* UProtoMessageObject::SetStringByHandle(bool& bSuccess, const FProtoFieldHandle& Handle, FString Value)
+{
+	const google::protobuf::FieldDescriptor* FD = FindField(Handle);
+	bSuccess = IsFieldOfType(FD, FCppType::CPPTYPE_STRING);
+	if (bSuccess)
+	{
+		Message->GetReflection()->SetString(Message, FD, TCHAR_TO_UTF8(*Value));
+	}
+	return this;
+}
+
+void UProtoMessageObject::GetInt32sByHandles(bool& bSuccess, const TArray<FProtoFieldHandle>& Handles, TArray<int32>& Values)
+{
+	bSuccess = true;
+	Values.SetNumUninitialized(Handles.Num());
+	const google::protobuf::Reflection* Reflection = Message->GetReflection();
+	for (int32 i = 0; i < Handles.Num(); i++)
+	{
+		const google::protobuf::FieldDescriptor* FD = FindField(Handles[i]);
+		if (IsFieldOfType(FD, FCppType::CPPTYPE_INT32))
+		{
+			Values[i] = Reflection->GetInt32(*Message, FD);
+		}
+		else
+		{
+			Values[i] = 0;
+			bSuccess = false;
+		}
+	}
+}
+
+void UProtoMessageObject::GetFloatsByHandles(bool& bSuccess, const TArray<FProtoFieldHandle>& Handles, TArray<float>& Values)
+{
+	bSuccess = true;
+	Values.SetNumUninitialized(Handles.Num());
+	const google::protobuf::Reflection* Reflection = Message->GetReflection();
+	for (int32 i = 0; i < Handles.Num(); i++)
+	{
+		const google::protobuf::FieldDescriptor* FD = FindField(Handles[i]);
+		if (IsFieldOfType(FD, FCppType::CPPTYPE_FLOAT))
+		{
+			Values[i] = Reflection->GetFloat(*Message, FD);
+		}
+		else
+		{
+			Values[i] = 0.f;
+			bSuccess = false;
+		}
+	}
+}
+
+UProtoMessageObject* UProtoMessageObject::SetInt32sByHandles(bool& bSuccess, const TArray<FProtoFieldHandle>& Handles, const TArray<int32>& Values)
+{
+	bSuccess = Handles.Num() == Values.Num();
+	const google::protobuf::Reflection* Reflection = Message->GetReflection();
+	for (int32 i = 0; i < FMath::Min(Handles.Num(), Values.Num()); i++)
+	{
+		const google::protobuf::FieldDescriptor* FD = FindField(Handles[i]);
+		if (IsFieldOfType(FD, FCppType::CPPTYPE_INT32))
+		{
+			Reflection->SetInt32(Message, FD, Values[i]);
+		}
+		else
+		{
+			bSuccess = false;
+		}
+	}
+	return this;
+}
+
+UProtoMessageObject* UProtoMessageObject::SetFloatsByHandles(bool& bSuccess, const TArray<FProtoFieldHandle>& Handles, const TArray<float>& Values)
+{
+	bSuccess = Handles.Num() == Values.Num();
+	const google::protobuf::Reflection* Reflection = Message->GetReflection();
+	for (int32 i = 0; i < FMath::Min(Handles.Num(), Values.Num()); i++)
+	{
+		const google::protobuf::FieldDescriptor* FD = FindField(Handles[i]);
+		if (IsFieldOfType(FD, FCppType::CPPTYPE_FLOAT))
+		{
+			Reflection->SetFloat(Message, FD, Values[i]);
+		}
+		else
+		{
+			bSuccess = false;
+		}
+	}
+	return this;
+}
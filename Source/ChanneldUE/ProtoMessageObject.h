@@ -6,6 +6,19 @@
 
 class UMessageRepeatedWrapper;
 
+// A field of a protobuf message type resolved once by UProtoMessageObject::FindFieldHandle(), so the ...ByHandle accessors skip the name lookup.
+USTRUCT(BlueprintType)
+struct FProtoFieldHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Channeld|Protobuf")
+	FName FieldName;
+
+	const google::protobuf::Descriptor* MessageType = nullptr;
+	const google::protobuf::FieldDescriptor* Field = nullptr;
+};
+
 UCLASS(BlueprintType)
 class UProtoMessageObject : public UObject
 {
@@ -90,7 +103,59 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf")
 		UProtoMessageObject* AddMessageToRepeatedField(bool& bSuccess, FString FieldName, UProtoMessageObject* ChildMessage);
 
+	// Resolve the field of the message type once, and reuse the handle with the messages of the same type.
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf", BlueprintPure)
+		FProtoFieldHandle FindFieldHandle(bool& bSuccess, FName FieldName);
+
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf", BlueprintPure)
+		bool GetBoolByHandle(bool& bSuccess, const FProtoFieldHandle& Handle);
+
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf", DisplayName = "Get Int32 By Handle", BlueprintPure)
+		int32 GetInt32ByHandle(bool& bSuccess, const FProtoFieldHandle& Handle);
+
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf", DisplayName = "Get Int64 By Handle", BlueprintPure)
+		int64 GetInt64ByHandle(bool& bSuccess, const FProtoFieldHandle& Handle);
+
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf", BlueprintPure)
+		float GetFloatByHandle(bool& bSuccess, const FProtoFieldHandle& Handle);
+
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf", BlueprintPure)
+		FString GetStringByHandle(bool& bSuccess, const FProtoFieldHandle& Handle);
+
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf")
+		UProtoMessageObject* SetBoolByHandle(bool& bSuccess, const FProtoFieldHandle& Handle, bool Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf", DisplayName = "Set Int32 By Handle")
+		UProtoMessageObject* SetInt32ByHandle(bool& bSuccess, const FProtoFieldHandle& Handle, int32 Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf", DisplayName = "Set Int64 By Handle")
+		UProtoMessageObject* SetInt64ByHandle(bool& bSuccess, const FProtoFieldHandle& Handle, int64 Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf")
+		UProtoMessageObject* SetFloatByHandle(bool& bSuccess, const FProtoFieldHandle& Handle, float Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf")
+		UProtoMessageObject* SetStringByHandle(bool& bSuccess, const FProtoFieldHandle& Handle, FString Value);
+
+	// Batch versions of the accessors above. bSuccess is false if any of the fields is not found, whose value is left as default.
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf", DisplayName = "Get Int32s By Handles", BlueprintPure)
+		void GetInt32sByHandles(bool& bSuccess, const TArray<FProtoFieldHandle>& Handles, TArray<int32>& Values);
+
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf", BlueprintPure)
+		void GetFloatsByHandles(bool& bSuccess, const TArray<FProtoFieldHandle>& Handles, TArray<float>& Values);
+
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf", DisplayName = "Set Int32s By Handles")
+		UProtoMessageObject* SetInt32sByHandles(bool& bSuccess, const TArray<FProtoFieldHandle>& Handles, const TArray<int32>& Values);
+
+	UFUNCTION(BlueprintCallable, Category = "Channeld|Protobuf")
+		UProtoMessageObject* SetFloatsByHandles(bool& bSuccess, const TArray<FProtoFieldHandle>& Handles, const TArray<float>& Values);
+
 protected:
+	// Look up the field in the cache of the message type. The names are cached as FName, so they are case-insensitive once cached.
+	const google::protobuf::FieldDescriptor* FindField(const FName& FieldName) const;
+	const google::protobuf::FieldDescriptor* FindField(const FString& FieldName) const { return FindField(FName(*FieldName)); }
+	// The handle's field if it's resolved for the type of the message, or the field looked up by its name.
+	const google::protobuf::FieldDescriptor* FindField(const FProtoFieldHandle& Handle) const;
 
 	// The protobuf message
 	google::protobuf::Message* Message;
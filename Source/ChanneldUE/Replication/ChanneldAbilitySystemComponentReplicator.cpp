@@ -0,0 +1,177 @@
+#include "ChanneldAbilitySystemComponentReplicator.h"
+#include "ChanneldTypes.h"
+#include "Replication/ChanneldReplication.h"
+#include "UObject/StructOnScope.h"
+
+FChanneldAbilitySystemComponentReplicator::FChanneldAbilitySystemComponentReplicator(UObject* InTargetObj) :
+	FChanneldReplicatorBase_AC(InTargetObj)
+{
+	Comp = CastChecked<UActorComponent>(InTargetObj);
+	// The other replicated properties of the component are left to the native replication.
+
+	FullState = AcquireState<unrealpb::AbilitySystemComponentState>();
+	DeltaState = AcquireState<unrealpb::AbilitySystemComponentState>();
+
+	SpawnedAttributesProperty = CastField<FArrayProperty>(InTargetObj->GetClass()->FindPropertyByName(FName("SpawnedAttributes")));
+	AttributeDataStruct = FindObject<UScriptStruct>(nullptr, TEXT("/Script/GameplayAbilities.GameplayAttributeData"));
+	if (AttributeDataStruct)
+	{
+		BaseValueProperty = CastField<FFloatProperty>(AttributeDataStruct->FindPropertyByName(FName("BaseValue")));
+		CurrentValueProperty = CastField<FFloatProperty>(AttributeDataStruct->FindPropertyByName(FName("CurrentValue")));
+	}
+	if (!SpawnedAttributesProperty || !BaseValueProperty || !CurrentValueProperty)
+	{
+		UE_LOG(LogChanneld, Warning, TEXT("Unable to find the attributes of %s, the gameplay attributes won't be replicated."), *InTargetObj->GetName());
+		SpawnedAttributesProperty = nullptr;
+	}
+}
+
+FChanneldAbilitySystemComponentReplicator::~FChanneldAbilitySystemComponentReplicator()
+{
+	ReleaseState(FullState);
+	ReleaseState(DeltaState);
+}
+
+UClass* FChanneldAbilitySystemComponentReplicator::FindTargetClass()
+{
+	static TWeakObjectPtr<UClass> TargetClass;
+	if (!TargetClass.IsValid())
+	{
+		TargetClass = FindObject<UClass>(nullptr, TEXT("/Script/GameplayAbilities.AbilitySystemComponent"));
+	}
+	return TargetClass.Get();
+}
+
+bool FChanneldAbilitySystemComponentReplicator::Register()
+{
+	const UClass* TargetClass = FindTargetClass();
+	if (!TargetClass)
+	{
+		return false;
+	}
+	ChanneldReplication::RegisterReplicator(TargetClass, [](UObject* InTargetObj){ return new FChanneldAbilitySystemComponentReplicator(InTargetObj); });
+	return true;
+}
+
+void FChanneldAbilitySystemComponentReplicator::ClearState()
+{
+	DeltaState->Clear();
+	bStateChanged = false;
+}
+
+void FChanneldAbilitySystemComponentReplicator::UpdateAttributes()
+{
+	FScriptArrayHelper SpawnedAttributes(SpawnedAttributesProperty, SpawnedAttributesProperty->ContainerPtrToValuePtr<void>(Comp.Get()));
+	bool bStale = SpawnedAttributes.Num() != NumSpawnedAttributes;
+	for (auto& Pair : Attributes)
+	{
+		bStale |= !Pair.Value.AttributeSet.IsValid();
+	}
+	if (!bStale)
+	{
+		return;
+	}
+
+	Attributes.Reset();
+	NumSpawnedAttributes = SpawnedAttributes.Num();
+	const FObjectPropertyBase* InnerProperty = CastFieldChecked<FObjectPropertyBase>(SpawnedAttributesProperty->Inner);
+	for (int32 i = 0; i < SpawnedAttributes.Num(); i++)
+	{
+		UObject* AttributeSet = InnerProperty->GetObjectPropertyValue(SpawnedAttributes.GetRawPtr(i));
+		if (!AttributeSet)
+		{
+			continue;
+		}
+		for (TFieldIterator<FStructProperty> It(AttributeSet->GetClass()); It; ++It)
+		{
+			if (!It->Struct->IsChildOf(AttributeDataStruct))
+			{
+				continue;
+			}
+			const uint32 Key = FCrc::StrCrc32(*FString::Printf(TEXT("%s.%s"), *AttributeSet->GetClass()->GetName(), *It->GetName()));
+			UFunction* RepNotifyFunc = It->HasAnyPropertyFlags(CPF_RepNotify) ? AttributeSet->FindFunction(It->RepNotifyFunc) : nullptr;
+			Attributes.Add(Key, FAttribute{AttributeSet, *It, RepNotifyFunc});
+		}
+	}
+}
+
+void FChanneldAbilitySystemComponentReplicator::Tick(float DeltaTime)
+{
+	if (!Comp.IsValid() || !Comp->GetOwner() || !SpawnedAttributesProperty)
+	{
+		return;
+	}
+
+	UpdateAttributes();
+	const auto& FullAttributes = FullState->attributes();
+	for (const auto& Pair : Attributes)
+	{
+		const UObject* AttributeSet = Pair.Value.AttributeSet.Get();
+		const void* AttributeData = Pair.Value.Property->ContainerPtrToValuePtr<void>(AttributeSet);
+		const float BaseValue = BaseValueProperty->GetPropertyValue_InContainer(AttributeData);
+		const float CurrentValue = CurrentValueProperty->GetPropertyValue_InContainer(AttributeData);
+		const auto Itr = FullAttributes.find(Pair.Key);
+		if (Itr == FullAttributes.end()
+			|| !FMath::IsNearlyEqual(Itr->second.basevalue(), BaseValue)
+			|| !FMath::IsNearlyEqual(Itr->second.currentvalue(), CurrentValue))
+		{
+			// The map entry is replaced as a whole when merged, so both the values are set.
+			unrealpb::GameplayAttributeValue& Value = (*DeltaState->mutable_attributes())[Pair.Key];
+			Value.set_basevalue(BaseValue);
+			Value.set_currentvalue(CurrentValue);
+			bStateChanged = true;
+		}
+	}
+
+	if (bStateChanged)
+	{
+		FullState->MergeFrom(*DeltaState);
+	}
+}
+
+void FChanneldAbilitySystemComponentReplicator::OnStateChanged(const google::protobuf::Message* InNewState)
+{
+	if (!Comp.IsValid() || !Comp->GetOwner() || !SpawnedAttributesProperty)
+	{
+		return;
+	}
+
+	// Only client needs to apply the new state
+	if (Comp->GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	const unrealpb::AbilitySystemComponentState* NewState = static_cast<const unrealpb::AbilitySystemComponentState*>(InNewState);
+	FullState->MergeFrom(*NewState);
+	bStateChanged = false;
+
+	UpdateAttributes();
+	for (const auto& Pair : NewState->attributes())
+	{
+		const FAttribute* Attribute = Attributes.Find(Pair.first);
+		UObject* AttributeSet = Attribute ? Attribute->AttributeSet.Get() : nullptr;
+		if (!AttributeSet)
+		{
+			UE_LOG(LogChanneld, Verbose, TEXT("Unable to find the attribute %u of %s"), Pair.first, *Comp->GetName());
+			continue;
+		}
+
+		void* AttributeData = Attribute->Property->ContainerPtrToValuePtr<void>(AttributeSet);
+		// The RepNotify of the attribute takes the old value as the parameter.
+		FStructOnScope OldValue(Attribute->Property->Struct);
+		Attribute->Property->CopyCompleteValue(OldValue.GetStructMemory(), AttributeData);
+		if (Pair.second.has_basevalue())
+		{
+			BaseValueProperty->SetPropertyValue_InContainer(AttributeData, Pair.second.basevalue());
+		}
+		if (Pair.second.has_currentvalue())
+		{
+			CurrentValueProperty->SetPropertyValue_InContainer(AttributeData, Pair.second.currentvalue());
+		}
+		if (Attribute->RepNotifyFunc)
+		{
+			AttributeSet->ProcessEvent(Attribute->RepNotifyFunc, Attribute->RepNotifyFunc->NumParms > 0 ? OldValue.GetStructMemory() : nullptr);
+		}
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Replication/ChanneldReplicatorBase.h"
+#include "unreal_components.pb.h"
+
+/**
+ * Replicates the gameplay attributes (FGameplayAttributeData) of the attribute sets of UAbilitySystemComponent. The attributes are
+ * accessed by the reflection, so ChanneldUE doesn't depend on the GameplayAbilities plugin. Only the changed attributes are sent,
+ * each with both the base and the current value; the clients call the RepNotify of the attributes as the native replication does.
+ */
+class CHANNELDUE_API FChanneldAbilitySystemComponentReplicator : public FChanneldReplicatorBase_AC
+{
+public:
+	FChanneldAbilitySystemComponentReplicator(UObject* InTargetObj);
+	virtual ~FChanneldAbilitySystemComponentReplicator() override;
+
+	// Registers the replicator if the GameplayAbilities module is loaded. Returns false if not.
+	static bool Register();
+	static UClass* FindTargetClass();
+
+	//~Begin FChanneldReplicatorBase Interface
+	virtual UClass* GetTargetClass() override { return FindTargetClass(); }
+	virtual google::protobuf::Message* GetDeltaState() override { return DeltaState; }
+	virtual google::protobuf::Message* GetFullState() override { return FullState; }
+	virtual void ClearState() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual void OnStateChanged(const google::protobuf::Message* NewState) override;
+	//~End FChanneldReplicatorBase Interface
+
+protected:
+	TWeakObjectPtr<UActorComponent> Comp;
+
+	// [Server+Client] The accumulated channel data of the target object
+	unrealpb::AbilitySystemComponentState* FullState;
+	// [Server] The accumulated delta change before next send
+	unrealpb::AbilitySystemComponentState* DeltaState;
+
+private:
+	struct FAttribute
+	{
+		TWeakObjectPtr<UObject> AttributeSet;
+		FStructProperty* Property;
+		UFunction* RepNotifyFunc;
+	};
+	// Keyed by the CRC32 of "AttributeSetClassName.AttributeName", which is the same on the server and the clients.
+	TMap<uint32, FAttribute> Attributes;
+
+	FArrayProperty* SpawnedAttributesProperty = nullptr;
+	int32 NumSpawnedAttributes = INDEX_NONE;
+	const UScriptStruct* AttributeDataStruct = nullptr;
+	FFloatProperty* BaseValueProperty = nullptr;
+	FFloatProperty* CurrentValueProperty = nullptr;
+
+	// Rebuilds the attributes when the attribute sets are added or removed.
+	void UpdateAttributes();
+};
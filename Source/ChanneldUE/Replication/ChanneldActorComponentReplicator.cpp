@@ -9,14 +9,14 @@ FChanneldActorComponentReplicator::FChanneldActorComponentReplicator(UObject* In
 	TArray<FLifetimeProperty> RepProps;
 	DisableAllReplicatedPropertiesOfClass(InTargetObj->GetClass(), UActorComponent::StaticClass(), EFieldIteratorFlags::ExcludeSuper, RepProps);
 
-	FullState = new unrealpb::ActorComponentState;
-	DeltaState = new unrealpb::ActorComponentState;
+	FullState = AcquireState<unrealpb::ActorComponentState>();
+	DeltaState = AcquireState<unrealpb::ActorComponentState>();
 }
 
 FChanneldActorComponentReplicator::~FChanneldActorComponentReplicator()
 {
-	delete FullState;
-	delete DeltaState;
+	ReleaseState(FullState);
+	ReleaseState(DeltaState);
 }
 
 google::protobuf::Message* FChanneldActorComponentReplicator::GetDeltaState()
@@ -1,6 +1,8 @@
 #include "ChanneldActorReplicator.h"
 #include "Net/UnrealNetwork.h"
 #include "ChanneldUtils.h"
+#include "ChanneldSettings.h"
+#include "GameFramework/Character.h"
 #include "GameFramework/Pawn.h"
 #include "GameFramework/GameStateBase.h"
 
@@ -16,8 +18,8 @@ FChanneldActorReplicator::FChanneldActorReplicator(UObject* InTargetObj) : FChan
 	TArray<FLifetimeProperty> RepProps;
 	DisableAllReplicatedPropertiesOfClass(InTargetObj->GetClass(), AActor::StaticClass(), EFieldIteratorFlags::ExcludeSuper, RepProps);
 
-	FullState = new unrealpb::ActorState;
-	DeltaState = new unrealpb::ActorState;
+	FullState = AcquireState<unrealpb::ActorState>();
+	DeltaState = AcquireState<unrealpb::ActorState>();
 
 	{
 		auto Property = CastFieldChecked<const FByteProperty>(Actor->GetClass()->FindPropertyByName(FName("RemoteRole")));
@@ -49,8 +51,8 @@ FChanneldActorReplicator::FChanneldActorReplicator(UObject* InTargetObj) : FChan
 
 FChanneldActorReplicator::~FChanneldActorReplicator()
 {
-	delete FullState;
-	delete DeltaState;
+	ReleaseState(FullState);
+	ReleaseState(DeltaState);
 }
 
 google::protobuf::Message* FChanneldActorReplicator::GetDeltaState()
@@ -64,6 +66,19 @@ void FChanneldActorReplicator::ClearState()
 	bStateChanged = false;
 }
 
+void FChanneldActorReplicator::ResetBaseline()
+{
+	FChanneldReplicatorBase::ResetBaseline();
+	ResetResolvedRefs();
+}
+
+void FChanneldActorReplicator::ResetResolvedRefs()
+{
+	ResolvedOwner.Reset();
+	ResolvedAttachParent.Reset();
+	ResolvedAttachComponent.Reset();
+}
+
 void FChanneldActorReplicator::Tick(float DeltaTime)
 {
 	if (!Actor.IsValid())
@@ -111,11 +126,19 @@ void FChanneldActorReplicator::Tick(float DeltaTime)
 		bStateChanged = true;
 	}
 
-	bool bOwnerUnmapped = false;
-	AActor* Owner = Cast<AActor>(ChanneldUtils::GetObjectByRef(FullState->mutable_owner(), Actor->GetWorld(), bOwnerUnmapped, false));
-	if (!bOwnerUnmapped && Actor->GetOwner() != Owner)
+	if (!ResolvedOwner.IsResolved())
+	{
+		bool bOwnerUnmapped = false;
+		AActor* Owner = Cast<AActor>(ChanneldUtils::GetObjectByRef(FullState->mutable_owner(), Actor->GetWorld(), bOwnerUnmapped, false));
+		if (!bOwnerUnmapped)
+		{
+			ResolvedOwner.Set(Owner);
+		}
+	}
+	if (ResolvedOwner.IsResolved() && Actor->GetOwner() != ResolvedOwner.Get())
 	{
 		DeltaState->mutable_owner()->CopyFrom(*ChanneldUtils::GetRefOfObject(Actor->GetOwner()));
+		ResolvedOwner.Set(Actor->GetOwner());
 		bStateChanged = true;
 	}
 
@@ -145,24 +168,29 @@ void FChanneldActorReplicator::Tick(float DeltaTime)
 		/* Optimization: Don't create the delta state until there's a change
 		unrealpb::FRepMovement* RepMovementDeltaState = DeltaState->mutable_replicatedmovement();
 		*/
-		if (ChanneldUtils::CheckDifference(RepMovement.LinearVelocity, RepMovementFullState->mutable_linearvelocity()))
+		// Apply the quantization levels of the actor, so the changes below the precision don't cause any update.
+		const FVector LinearVelocity = ChanneldUtils::QuantizeVector(RepMovement.LinearVelocity, RepMovement.VelocityQuantizationLevel);
+		if (ChanneldUtils::CheckDifference(LinearVelocity, RepMovementFullState->mutable_linearvelocity()))
 		{
-			ChanneldUtils::SetVectorToPB(DeltaState->mutable_replicatedmovement()->mutable_linearvelocity(), RepMovement.LinearVelocity, RepMovementFullState->mutable_linearvelocity());
+			ChanneldUtils::SetVectorToPB(DeltaState->mutable_replicatedmovement()->mutable_linearvelocity(), LinearVelocity, RepMovementFullState->mutable_linearvelocity());
 			bStateChanged = true;
 		}
-		if (ChanneldUtils::CheckDifference(RepMovement.AngularVelocity, RepMovementFullState->mutable_angularvelocity()))
+		const FVector AngularVelocity = ChanneldUtils::QuantizeVector(RepMovement.AngularVelocity, RepMovement.VelocityQuantizationLevel);
+		if (ChanneldUtils::CheckDifference(AngularVelocity, RepMovementFullState->mutable_angularvelocity()))
 		{
-			ChanneldUtils::SetVectorToPB(DeltaState->mutable_replicatedmovement()->mutable_angularvelocity(), RepMovement.AngularVelocity, RepMovementFullState->mutable_angularvelocity());
+			ChanneldUtils::SetVectorToPB(DeltaState->mutable_replicatedmovement()->mutable_angularvelocity(), AngularVelocity, RepMovementFullState->mutable_angularvelocity());
 			bStateChanged = true;
 		}
-		if (ChanneldUtils::CheckDifference(RepMovement.Location, RepMovementFullState->mutable_location()))
+		const FVector Location = ChanneldUtils::QuantizeVector(RepMovement.Location, RepMovement.LocationQuantizationLevel);
+		if (ChanneldUtils::CheckDifference(Location, RepMovementFullState->mutable_location()))
 		{
-			ChanneldUtils::SetVectorToPB(DeltaState->mutable_replicatedmovement()->mutable_location(), RepMovement.Location, RepMovementFullState->mutable_location());
+			ChanneldUtils::SetVectorToPB(DeltaState->mutable_replicatedmovement()->mutable_location(), Location, RepMovementFullState->mutable_location());
 			bStateChanged = true;
 		}
-		if (ChanneldUtils::CheckDifference(RepMovement.Rotation, RepMovementFullState->mutable_rotation()))
+		const FRotator Rotation = ChanneldUtils::QuantizeRotator(RepMovement.Rotation, RepMovement.RotationQuantizationLevel);
+		if (ChanneldUtils::CheckDifference(Rotation, RepMovementFullState->mutable_rotation()))
 		{
-			ChanneldUtils::SetRotatorToPB(DeltaState->mutable_replicatedmovement()->mutable_rotation(), RepMovement.Rotation, RepMovementFullState->mutable_rotation());
+			ChanneldUtils::SetRotatorToPB(DeltaState->mutable_replicatedmovement()->mutable_rotation(), Rotation, RepMovementFullState->mutable_rotation());
 			bStateChanged = true;
 		}
 		if (RepMovement.bSimulatedPhysicSleep != RepMovementFullState->bsimulatedphysicsleep())
@@ -185,15 +213,29 @@ void FChanneldActorReplicator::Tick(float DeltaTime)
 		/* Optimization: Don't create the delta state until there's a change
 		unrealpb::FRepAttachment* RepAttachmentDeltaState = DeltaState->mutable_attachmentreplication();
 		*/
-		if (RepAttachment.AttachParent != ChanneldUtils::GetObjectByRef(RepAttachmentFullState->mutable_attachparent(), Actor->GetWorld(), false))
+		if (!ResolvedAttachParent.IsResolved())
+		{
+			ResolvedAttachParent.Set(Cast<AActor>(ChanneldUtils::GetObjectByRef(RepAttachmentFullState->mutable_attachparent(), Actor->GetWorld(), false)));
+		}
+		if (RepAttachment.AttachParent != ResolvedAttachParent.Get())
 		{
 			DeltaState->mutable_attachmentreplication()->mutable_attachparent()->CopyFrom(*ChanneldUtils::GetRefOfObject(RepAttachment.AttachParent, Actor->GetNetConnection()));
+			ResolvedAttachParent.Set(RepAttachment.AttachParent);
 			bStateChanged = true;
 		}
-		bool bUnmapped = false;
-		if (RepAttachment.AttachComponent != Cast<USceneComponent>(ChanneldUtils::GetActorComponentByRefChecked(RepAttachmentFullState->mutable_attachcomponent(), Actor->GetWorld(), bUnmapped, false)) && !bUnmapped)
+		if (!ResolvedAttachComponent.IsResolved())
+		{
+			bool bUnmapped = false;
+			USceneComponent* AttachComponent = Cast<USceneComponent>(ChanneldUtils::GetActorComponentByRefChecked(RepAttachmentFullState->mutable_attachcomponent(), Actor->GetWorld(), bUnmapped, false));
+			if (!bUnmapped)
+			{
+				ResolvedAttachComponent.Set(AttachComponent);
+			}
+		}
+		if (ResolvedAttachComponent.IsResolved() && RepAttachment.AttachComponent != ResolvedAttachComponent.Get())
 		{
 			DeltaState->mutable_attachmentreplication()->mutable_attachcomponent()->CopyFrom(ChanneldUtils::GetRefOfActorComponent(RepAttachment.AttachComponent, Actor->GetNetConnection()));
+			ResolvedAttachComponent.Set(RepAttachment.AttachComponent);
 			bStateChanged = true;
 		}
 		
@@ -239,6 +281,7 @@ void FChanneldActorReplicator::OnStateChanged(const google::protobuf::Message* I
 	auto NewState = static_cast<const unrealpb::ActorState*>(InNewState);
 	FullState->MergeFrom(*NewState);
 	bStateChanged = false;
+	ResetResolvedRefs();
 
 	if (NewState->has_breplicatemovement())
 	{
@@ -395,7 +438,32 @@ void FChanneldActorReplicator::OnStateChanged(const google::protobuf::Message* I
 	}
 	if (NewState->has_replicatedmovement())
 	{
-		Actor->ProcessEvent(OnRep_ReplicatedMovementFunc, nullptr);
+		if (GetMutableDefault<UChanneldSettings>()->InterpolationDelayMs > 0 && !ReplicatedMovementPtr->bRepPhysics && !Actor->IsA<ACharacter>())
+		{
+			SnapshotBuffer.Add(FPlatformTime::Seconds(), FRepMovement::RebaseOntoLocalOrigin(ReplicatedMovementPtr->Location, Actor.Get()), ReplicatedMovementPtr->Rotation);
+			Actor->PostNetReceiveVelocity(ReplicatedMovementPtr->LinearVelocity);
+		}
+		else
+		{
+			Actor->ProcessEvent(OnRep_ReplicatedMovementFunc, nullptr);
+		}
 	}
 }
 
+bool FChanneldActorReplicator::TickInterpolation(double Time)
+{
+	if (SnapshotBuffer.IsEmpty() || !Actor.IsValid())
+	{
+		return false;
+	}
+
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	const double SampleTime = Time - Settings->InterpolationDelayMs * 0.001;
+	const double MaxExtrapolationTime = Settings->MaxExtrapolationMs * 0.001;
+	FVector Location;
+	FRotator Rotation;
+	SnapshotBuffer.Sample(SampleTime, MaxExtrapolationTime, Location, Rotation);
+	Actor->SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	return !SnapshotBuffer.IsSettled(SampleTime, MaxExtrapolationTime);
+}
+
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "ChanneldReplicatorBase.h"
+#include "ChanneldSnapshotBuffer.h"
 #include "ChanneldTypes.h"
 #include "unreal_common.pb.h"
 #include "GameFramework/Actor.h"
@@ -15,9 +16,12 @@ public:
 	//~Begin FChanneldReplicatorBase Interface
 	virtual UClass* GetTargetClass() override { return AActor::StaticClass(); }
 	virtual google::protobuf::Message* GetDeltaState() override;
+	virtual google::protobuf::Message* GetFullState() override { return FullState; }
 	virtual void ClearState() override;
+	virtual void ResetBaseline() override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void OnStateChanged(const google::protobuf::Message* NewState) override;
+	virtual bool TickInterpolation(double Time) override;
 	//~End FChanneldReplicatorBase Interface
 
 protected:
@@ -34,6 +38,15 @@ private:
 	FRepMovement* ReplicatedMovementPtr;
 	FRepAttachment* AttachmentReplicationPtr;
 
+	// The objects of the ref fields in FullState
+	TChanneldResolvedRef<AActor> ResolvedOwner;
+	TChanneldResolvedRef<AActor> ResolvedAttachParent;
+	TChanneldResolvedRef<USceneComponent> ResolvedAttachComponent;
+	void ResetResolvedRefs();
+
 	UFunction* OnRep_OwnerFunc;
 	UFunction* OnRep_ReplicatedMovementFunc;
+
+	// [Client] The received locations and rotations of the actor, if the interpolation is enabled. The characters smooth the movement themselves.
+	FChanneldTransformSnapshotBuffer SnapshotBuffer;
 };
\ No newline at end of file
@@ -7,6 +7,13 @@
 #include "Engine/NetSerialization.h"
 #include "GameFramework/CharacterMovementComponent.h"
 
+// Compared with the name of every RPC of the class, so they are not constructed on each call.
+namespace
+{
+	const FName NAME_ServerMovePacked(TEXT("ServerMovePacked"));
+	const FName NAME_ClientMoveResponsePacked(TEXT("ClientMoveResponsePacked"));
+}
+
 FChanneldCharacterReplicator::FChanneldCharacterReplicator(UObject* InTargetObj) : FChanneldReplicatorBase(InTargetObj)
 {
 	Character = CastChecked<ACharacter>(InTargetObj);
@@ -14,8 +21,8 @@ FChanneldCharacterReplicator::FChanneldCharacterReplicator(UObject* InTargetObj)
 	TArray<FLifetimeProperty> RepProps;
 	DisableAllReplicatedPropertiesOfClass(InTargetObj->GetClass(), ACharacter::StaticClass(), EFieldIteratorFlags::ExcludeSuper, RepProps);
 
-	FullState = new unrealpb::CharacterState;
-	DeltaState = new unrealpb::CharacterState;
+	FullState = AcquireState<unrealpb::CharacterState>();
+	DeltaState = AcquireState<unrealpb::CharacterState>();
 
 	// Prepare Reflection pointers
 	{
@@ -47,8 +54,8 @@ FChanneldCharacterReplicator::FChanneldCharacterReplicator(UObject* InTargetObj)
 
 FChanneldCharacterReplicator::~FChanneldCharacterReplicator()
 {
-	delete FullState;
-	delete DeltaState;
+	ReleaseState(FullState);
+	ReleaseState(DeltaState);
 }
 
 google::protobuf::Message* FChanneldCharacterReplicator::GetDeltaState()
@@ -359,7 +366,7 @@ void FChanneldCharacterReplicator::OnStateChanged(const google::protobuf::Messag
 TSharedPtr<google::protobuf::Message> FChanneldCharacterReplicator::SerializeFunctionParams(UFunction* Func, void* Params, FOutParmRec* OutParams, bool& bSuccess)
 {
 	bSuccess = true;
-	if (Func->GetFName() == FName("ServerMovePacked"))
+	if (Func->GetFName() == NAME_ServerMovePacked)
 	{
 		ServerMovePackedParams* TypedParams = (ServerMovePackedParams*)Params;
 		char* Data = (char*)TypedParams->PackedBits.DataBits.GetData();
@@ -369,7 +376,7 @@ TSharedPtr<google::protobuf::Message> FChanneldCharacterReplicator::SerializeFun
 		//UE_LOG(LogChanneld, Log, TEXT("Sending ServerMovePacked with PackedBits: %d, Timestamp: %d"), TypedParams->PackedBits.DataBits.Num(), *TypedParams->PackedBits.DataBits.GetData());
 		return Msg;
 	}
-	else if (Func->GetFName() == FName("ClientMoveResponsePacked"))
+	else if (Func->GetFName() == NAME_ClientMoveResponsePacked)
 	{
 		ClientMoveResponsePackedParams* TypedParams = (ClientMoveResponsePackedParams*)Params;
 		char* Data = (char*)TypedParams->PackedBits.DataBits.GetData();
@@ -386,7 +393,7 @@ TSharedPtr<google::protobuf::Message> FChanneldCharacterReplicator::SerializeFun
 TSharedPtr<void> FChanneldCharacterReplicator::DeserializeFunctionParams(UFunction* Func, const std::string& ParamsPayload, bool& bSuccess, bool& bDeferredRPC)
 {
 	bSuccess = true;
-	if (Func->GetFName() == FName("ServerMovePacked"))
+	if (Func->GetFName() == NAME_ServerMovePacked)
 	{
 		UNetConnection* NetConn = Character->GetNetConnection();
 		if (!NetConn)
@@ -420,7 +427,7 @@ TSharedPtr<void> FChanneldCharacterReplicator::DeserializeFunctionParams(UFuncti
 
 		return Params;
 	}
-	else if (Func->GetFName() == FName("ClientMoveResponsePacked"))
+	else if (Func->GetFName() == NAME_ClientMoveResponsePacked)
 	{
 		// The character doesn't have the owning NetConnection yet. Postpone the execution of the RPC.
 		UNetConnection* NetConn = Character->GetNetConnection();
@@ -11,14 +11,14 @@ FChanneldControllerReplicator::FChanneldControllerReplicator(UObject* InTargetOb
 	TArray<FLifetimeProperty> RepProps;
 	DisableAllReplicatedPropertiesOfClass(InTargetObj->GetClass(), AController::StaticClass(), EFieldIteratorFlags::ExcludeSuper, RepProps);
 
-	FullState = new unrealpb::ControllerState;
-	DeltaState = new unrealpb::ControllerState;
+	FullState = AcquireState<unrealpb::ControllerState>();
+	DeltaState = AcquireState<unrealpb::ControllerState>();
 }
 
 FChanneldControllerReplicator::~FChanneldControllerReplicator()
 {
-	delete FullState;
-	delete DeltaState;
+	ReleaseState(FullState);
+	ReleaseState(DeltaState);
 }
 
 google::protobuf::Message* FChanneldControllerReplicator::GetDeltaState()
@@ -12,8 +12,8 @@ FChanneldGameStateBaseReplicator::FChanneldGameStateBaseReplicator(UObject* InTa
 	TArray<FLifetimeProperty> RepProps;
 	DisableAllReplicatedPropertiesOfClass(InTargetObj->GetClass(), AGameStateBase::StaticClass(), EFieldIteratorFlags::ExcludeSuper, RepProps);
 
-	FullState = new unrealpb::GameStateBase;
-	DeltaState = new unrealpb::GameStateBase;
+	FullState = AcquireState<unrealpb::GameStateBase>();
+	DeltaState = AcquireState<unrealpb::GameStateBase>();
 
 	// Prepare Reflection pointers
 	{
@@ -49,8 +49,8 @@ FChanneldGameStateBaseReplicator::FChanneldGameStateBaseReplicator(UObject* InTa
 
 FChanneldGameStateBaseReplicator::~FChanneldGameStateBaseReplicator()
 {
-	delete FullState;
-	delete DeltaState;
+	ReleaseState(FullState);
+	ReleaseState(DeltaState);
 }
 
 uint32 FChanneldGameStateBaseReplicator::GetNetGUID()
@@ -83,18 +83,17 @@ void FChanneldGameStateBaseReplicator::Tick(float DeltaTime)
 		return;
 	}
 
-	// For LoadClass(), check if the class name is set before calling can avoid warning
-	TSubclassOf<ASpectatorPawn> SpectatorClass = FullState->has_spectatorclassname() ? LoadClass<ASpectatorPawn>(NULL, UTF8_TO_TCHAR(FullState->spectatorclassname().c_str())) : NULL;
-	if (GameStateBase->SpectatorClass != SpectatorClass)
+	if (GameStateBase->SpectatorClass.Get() != ReplicatedSpectatorClass.Get())
 	{
 		DeltaState->set_spectatorclassname(std::string(TCHAR_TO_UTF8(*GameStateBase->SpectatorClass->GetPathName())));
+		ReplicatedSpectatorClass = GameStateBase->SpectatorClass.Get();
 		bStateChanged = true;
 	}
 
-	TSubclassOf<AGameModeBase> GameModeClass = FullState->has_gamemodeclassname() ? LoadClass<AGameModeBase>(NULL, UTF8_TO_TCHAR(FullState->gamemodeclassname().c_str())) : NULL;
-	if (GameStateBase->GameModeClass != GameModeClass)
+	if (GameStateBase->GameModeClass.Get() != ReplicatedGameModeClass.Get())
 	{
 		DeltaState->set_gamemodeclassname(std::string(TCHAR_TO_UTF8(*GameStateBase->GameModeClass->GetPathName())));
+		ReplicatedGameModeClass = GameStateBase->GameModeClass.Get();
 		bStateChanged = true;
 	}
 
@@ -14,6 +14,7 @@ public:
 	virtual UClass* GetTargetClass() override { return AGameStateBase::StaticClass(); }
 	virtual uint32 GetNetGUID() override;
 	virtual google::protobuf::Message* GetDeltaState() override;
+	virtual google::protobuf::Message* GetFullState() override { return FullState; }
 	virtual void ClearState() override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void OnStateChanged(const google::protobuf::Message* NewState) override;
@@ -34,6 +35,9 @@ private:
 	double* ReplicatedWorldTimeSecondsPtr;
 #endif
 	bool* bReplicatedHasBegunPlayPtr;
+	// [Server] The classes in FullState, so Tick() compares the pointers instead of loading the classes by the names.
+	TWeakObjectPtr<UClass> ReplicatedSpectatorClass;
+	TWeakObjectPtr<UClass> ReplicatedGameModeClass;
 	UFunction* OnRep_GameModeClassFunc;
 	UFunction* OnRep_SpectatorClassFunc;
 	UFunction* OnRep_ReplicatedWorldTimeSecondsFunc;
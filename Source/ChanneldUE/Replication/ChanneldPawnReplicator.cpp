@@ -9,8 +9,8 @@ FChanneldPawnReplicator::FChanneldPawnReplicator(UObject* InTargetObj) : FChanne
 	TArray<FLifetimeProperty> RepProps;
 	DisableAllReplicatedPropertiesOfClass(InTargetObj->GetClass(), APawn::StaticClass(), EFieldIteratorFlags::ExcludeSuper, RepProps);
 
-	FullState = new unrealpb::PawnState;
-	DeltaState = new unrealpb::PawnState;
+	FullState = AcquireState<unrealpb::PawnState>();
+	DeltaState = AcquireState<unrealpb::PawnState>();
 	
 	// Prepare Reflection pointers
 	{
@@ -22,8 +22,8 @@ FChanneldPawnReplicator::FChanneldPawnReplicator(UObject* InTargetObj) : FChanne
 
 FChanneldPawnReplicator::~FChanneldPawnReplicator()
 {
-	delete FullState;
-	delete DeltaState;
+	ReleaseState(FullState);
+	ReleaseState(DeltaState);
 }
 
 google::protobuf::Message* FChanneldPawnReplicator::GetDeltaState()
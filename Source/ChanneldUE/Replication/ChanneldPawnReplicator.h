@@ -14,6 +14,7 @@ public:
 	//~Begin FChanneldReplicatorBase Interface
 	virtual UClass* GetTargetClass() override { return APawn::StaticClass(); }
 	virtual google::protobuf::Message* GetDeltaState() override;
+	virtual google::protobuf::Message* GetFullState() override { return FullState; }
 	virtual void ClearState() override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void OnStateChanged(const google::protobuf::Message* NewState) override;
@@ -6,6 +6,23 @@
 #include "Components/PrimitiveComponent.h"
 #include "Engine/NetSerialization.h"
 
+// Compared with the name of every RPC of the class, so they are not constructed on each call.
+namespace
+{
+	const FName NAME_ServerUpdateCamera(TEXT("ServerUpdateCamera"));
+	const FName NAME_ClientSetHUD(TEXT("ClientSetHUD"));
+	const FName NAME_ClientSetViewTarget(TEXT("ClientSetViewTarget"));
+	const FName NAME_ClientEnableNetworkVoice(TEXT("ClientEnableNetworkVoice"));
+	const FName NAME_ClientCapBandwidth(TEXT("ClientCapBandwidth"));
+	const FName NAME_ClientRestart(TEXT("ClientRestart"));
+	const FName NAME_ClientSetCameraMode(TEXT("ClientSetCameraMode"));
+	const FName NAME_ClientRetryClientRestart(TEXT("ClientRetryClientRestart"));
+	const FName NAME_ServerSetSpectatorLocation(TEXT("ServerSetSpectatorLocation"));
+	const FName NAME_ServerAcknowledgePossession(TEXT("ServerAcknowledgePossession"));
+	const FName NAME_ClientGotoState(TEXT("ClientGotoState"));
+	const FName NAME_ClientReceiveLocalizedMessage(TEXT("ClientReceiveLocalizedMessage"));
+}
+
 FChanneldPlayerControllerReplicator::FChanneldPlayerControllerReplicator(UObject* InTargetObj) : FChanneldReplicatorBase(InTargetObj)
 {
 	PC = CastChecked<APlayerController>(InTargetObj);
@@ -15,8 +32,8 @@ FChanneldPlayerControllerReplicator::FChanneldPlayerControllerReplicator(UObject
 	TArray<FLifetimeProperty> RepProps;
 	DisableAllReplicatedPropertiesOfClass(InTargetObj->GetClass(), APlayerController::StaticClass(), EFieldIteratorFlags::ExcludeSuper, RepProps);
 
-	FullState = new unrealpb::PlayerControllerState;
-	DeltaState = new unrealpb::PlayerControllerState;
+	FullState = AcquireState<unrealpb::PlayerControllerState>();
+	DeltaState = AcquireState<unrealpb::PlayerControllerState>();
 
 	// Prepare Reflection pointers
 	{
@@ -28,8 +45,8 @@ FChanneldPlayerControllerReplicator::FChanneldPlayerControllerReplicator(UObject
 
 FChanneldPlayerControllerReplicator::~FChanneldPlayerControllerReplicator()
 {
-	delete FullState;
-	delete DeltaState;
+	ReleaseState(FullState);
+	ReleaseState(DeltaState);
 }
 
 google::protobuf::Message* FChanneldPlayerControllerReplicator::GetDeltaState()
@@ -82,7 +99,7 @@ void FChanneldPlayerControllerReplicator::OnStateChanged(const google::protobuf:
 TSharedPtr<google::protobuf::Message> FChanneldPlayerControllerReplicator::SerializeFunctionParams(UFunction* Func, void* Params, FOutParmRec* OutParams, bool& bSuccess)
 {
 	bSuccess = true;
-	if (Func->GetFName() == FName("ServerUpdateCamera"))
+	if (Func->GetFName() == NAME_ServerUpdateCamera)
 	{
 		ServerUpdateCameraParams* TypedParams = (ServerUpdateCameraParams*)Params;
 		auto Msg = MakeShared<unrealpb::PlayerController_ServerUpdateCamera_Params>();
@@ -90,7 +107,7 @@ TSharedPtr<google::protobuf::Message> FChanneldPlayerControllerReplicator::Seria
 		Msg->set_campitchandyaw(TypedParams->CamPitchAndYaw);
 		return Msg;
 	}
-	else if (Func->GetFName() == FName("ClientSetHUD"))
+	else if (Func->GetFName() == NAME_ClientSetHUD)
 	{
 		ClientSetHUDParams* TypedParams = (ClientSetHUDParams*)Params;
 		auto Msg = MakeShared<unrealpb::PlayerController_ClientSetHUD_Params>();
@@ -100,7 +117,7 @@ TSharedPtr<google::protobuf::Message> FChanneldPlayerControllerReplicator::Seria
 		}
 		return Msg;
 	}
-	else if (Func->GetFName() == FName("ClientSetViewTarget"))
+	else if (Func->GetFName() == NAME_ClientSetViewTarget)
 	{
 		ClientSetViewTargetParams* TypedParams = (ClientSetViewTargetParams*)Params;
 		auto Msg = MakeShared<unrealpb::PlayerController_ClientSetViewTarget_Params>();
@@ -111,42 +128,42 @@ TSharedPtr<google::protobuf::Message> FChanneldPlayerControllerReplicator::Seria
 		Msg->set_blockoutgoing(TypedParams->TransitionParams.bLockOutgoing);
 		return Msg;
 	}
-	else if (Func->GetFName() == FName("ClientEnableNetworkVoice"))
+	else if (Func->GetFName() == NAME_ClientEnableNetworkVoice)
 	{
 		ClientEnableNetworkVoiceParams* TypedParams = (ClientEnableNetworkVoiceParams*)Params;
 		auto Msg = MakeShared<unrealpb::PlayerController_ClientEnableNetworkVoice_Params>();
 		Msg->set_benable(TypedParams->bEnable);
 		return Msg;
 	}
-	else if (Func->GetFName() == FName("ClientCapBandwidth"))
+	else if (Func->GetFName() == NAME_ClientCapBandwidth)
 	{
 		ClientCapBandwidthParams* TypedParams = (ClientCapBandwidthParams*)Params;
 		auto Msg = MakeShared<unrealpb::PlayerController_ClientCapBandwidth_Params>();
 		Msg->set_cap(TypedParams->Cap);
 		return Msg;
 	}
-	else if (Func->GetFName() == FName("ClientRestart"))
+	else if (Func->GetFName() == NAME_ClientRestart)
 	{
 		ClientRestartParams* TypedParams = (ClientRestartParams*)Params;
 		auto Msg = MakeShared<unrealpb::PlayerController_ClientRestart_Params>();
 		Msg->mutable_pawn()->MergeFrom(*ChanneldUtils::GetRefOfObject(TypedParams->Pawn));
 		return Msg;
 	}
-	else if (Func->GetFName() == FName("ClientSetCameraMode"))
+	else if (Func->GetFName() == NAME_ClientSetCameraMode)
 	{
 		ClientSetCameraModeParams* TypedParams = (ClientSetCameraModeParams*)Params;
 		auto Msg = MakeShared<unrealpb::PlayerController_ClientSetCameraMode_Params>();
 		Msg->set_newcammode(std::string(TCHAR_TO_UTF8(*TypedParams->NewCamMode.ToString())));
 		return Msg;
 	}
-	else if (Func->GetFName() == FName("ClientRetryClientRestart"))
+	else if (Func->GetFName() == NAME_ClientRetryClientRestart)
 	{
 		ClientRetryClientRestartParams* TypedParams = (ClientRetryClientRestartParams*)Params;
 		auto Msg = MakeShared<unrealpb::PlayerController_ClientRetryClientRestart_Params>();
 		Msg->mutable_pawn()->MergeFrom(*ChanneldUtils::GetRefOfObject(TypedParams->Pawn));
 		return Msg;
 	}
-	else if (Func->GetFName() == FName("ServerSetSpectatorLocation"))
+	else if (Func->GetFName() == NAME_ServerSetSpectatorLocation)
 	{
 		ServerSetSpectatorLocationParams* TypedParams = (ServerSetSpectatorLocationParams*)Params;
 		auto Msg = MakeShared<unrealpb::PlayerController_ServerSetSpectatorLocation_Params>();
@@ -154,21 +171,21 @@ TSharedPtr<google::protobuf::Message> FChanneldPlayerControllerReplicator::Seria
 		ChanneldUtils::SetRotatorToPB(Msg->mutable_newrot(), TypedParams->NewRot);
 		return Msg;
 	}
-	else if (Func->GetFName() == FName("ServerAcknowledgePossession"))
+	else if (Func->GetFName() == NAME_ServerAcknowledgePossession)
 	{
 		ServerAcknowledgePossessionParams* TypedParams = (ServerAcknowledgePossessionParams*)Params;
 		auto Msg = MakeShared<unrealpb::PlayerController_ServerAcknowledgePossession_Params>();
 		Msg->mutable_pawn()->MergeFrom(*ChanneldUtils::GetRefOfObject(TypedParams->Pawn));
 		return Msg;
 	}
-	else if (Func->GetFName() == FName("ClientGotoState"))
+	else if (Func->GetFName() == NAME_ClientGotoState)
 	{
 		ClientGotoStateParams* TypedParams = (ClientGotoStateParams*)Params;
 		auto Msg = MakeShared<unrealpb::PlayerController_ClientGotoState_Params>();
 		Msg->set_newstate(std::string(TCHAR_TO_UTF8(*TypedParams->NewState.ToString())));
 		return Msg;
 	}
-	else if (Func->GetFName() == FName("ClientReceiveLocalizedMessage"))
+	else if (Func->GetFName() == NAME_ClientReceiveLocalizedMessage)
 	{
 		ClientReceiveLocalizedMessageParams* TypedParams = (ClientReceiveLocalizedMessageParams*)Params;
 		auto Msg = MakeShared<unrealpb::PlayerController_ClientReceiveLocalizedMessage_Params>();
@@ -195,7 +212,7 @@ TSharedPtr<google::protobuf::Message> FChanneldPlayerControllerReplicator::Seria
 TSharedPtr<void> FChanneldPlayerControllerReplicator::DeserializeFunctionParams(UFunction* Func, const std::string& ParamsPayload, bool& bSuccess, bool& bDeferredRPC)
 {
 	bSuccess = true;
-	if (Func->GetFName() == FName("ServerUpdateCamera"))
+	if (Func->GetFName() == NAME_ServerUpdateCamera)
 	{
 		unrealpb::PlayerController_ServerUpdateCamera_Params Msg;
 		Msg.ParseFromString(ParamsPayload);
@@ -204,7 +221,7 @@ TSharedPtr<void> FChanneldPlayerControllerReplicator::DeserializeFunctionParams(
 		Params->CamPitchAndYaw = Msg.campitchandyaw();
 		return Params;
 	}
-	else if (Func->GetFName() == FName("ClientSetHUD"))
+	else if (Func->GetFName() == NAME_ClientSetHUD)
 	{
 		unrealpb::PlayerController_ClientSetHUD_Params Msg;
 		Msg.ParseFromString(ParamsPayload);
@@ -215,7 +232,7 @@ TSharedPtr<void> FChanneldPlayerControllerReplicator::DeserializeFunctionParams(
 		}
 		return Params;
 	}
-	else if (Func->GetFName() == FName("ClientSetViewTarget"))
+	else if (Func->GetFName() == NAME_ClientSetViewTarget)
 	{
 		unrealpb::PlayerController_ClientSetViewTarget_Params Msg;
 		Msg.ParseFromString(ParamsPayload);
@@ -233,7 +250,7 @@ TSharedPtr<void> FChanneldPlayerControllerReplicator::DeserializeFunctionParams(
 		Params->TransitionParams.bLockOutgoing = (uint32)Msg.blockoutgoing();
 		return Params;
 	}
-	else if (Func->GetFName() == FName("ClientEnableNetworkVoice"))
+	else if (Func->GetFName() == NAME_ClientEnableNetworkVoice)
 	{
 		unrealpb::PlayerController_ClientEnableNetworkVoice_Params Msg;
 		Msg.ParseFromString(ParamsPayload);
@@ -241,7 +258,7 @@ TSharedPtr<void> FChanneldPlayerControllerReplicator::DeserializeFunctionParams(
 		Params->bEnable = Msg.benable();
 		return Params;
 	}
-	else if (Func->GetFName() == FName("ClientCapBandwidth"))
+	else if (Func->GetFName() == NAME_ClientCapBandwidth)
 	{
 		unrealpb::PlayerController_ClientCapBandwidth_Params Msg;
 		Msg.ParseFromString(ParamsPayload);
@@ -249,7 +266,7 @@ TSharedPtr<void> FChanneldPlayerControllerReplicator::DeserializeFunctionParams(
 		Params->Cap = Msg.cap();
 		return Params;
 	}
-	else if (Func->GetFName() == FName("ClientRestart"))
+	else if (Func->GetFName() == NAME_ClientRestart)
 	{
 		unrealpb::PlayerController_ClientRestart_Params Msg;
 		Msg.ParseFromString(ParamsPayload);
@@ -263,7 +280,7 @@ TSharedPtr<void> FChanneldPlayerControllerReplicator::DeserializeFunctionParams(
 		Params->Pawn = Pawn;
 		return Params;
 	}
-	else if (Func->GetFName() == FName("ClientSetCameraMode"))
+	else if (Func->GetFName() == NAME_ClientSetCameraMode)
 	{
 		unrealpb::PlayerController_ClientSetCameraMode_Params Msg;
 		Msg.ParseFromString(ParamsPayload);
@@ -271,7 +288,7 @@ TSharedPtr<void> FChanneldPlayerControllerReplicator::DeserializeFunctionParams(
 		Params->NewCamMode = FName(UTF8_TO_TCHAR(Msg.newcammode().c_str()));
 		return Params;
 	}
-	else if (Func->GetFName() == FName("ClientRetryClientRestart"))
+	else if (Func->GetFName() == NAME_ClientRetryClientRestart)
 	{
 		unrealpb::PlayerController_ClientRetryClientRestart_Params Msg;
 		Msg.ParseFromString(ParamsPayload);
@@ -285,7 +302,7 @@ TSharedPtr<void> FChanneldPlayerControllerReplicator::DeserializeFunctionParams(
 		Params->Pawn = Pawn;
 		return Params;
 	}
-	else if (Func->GetFName() == FName("ServerSetSpectatorLocation"))
+	else if (Func->GetFName() == NAME_ServerSetSpectatorLocation)
 	{
 		unrealpb::PlayerController_ServerSetSpectatorLocation_Params Msg;
 		Msg.ParseFromString(ParamsPayload);
@@ -294,7 +311,7 @@ TSharedPtr<void> FChanneldPlayerControllerReplicator::DeserializeFunctionParams(
 		ChanneldUtils::SetRotatorFromPB(Params->NewRot, Msg.newrot());
 		return Params;
 	}
-	else if (Func->GetFName() == FName("ServerAcknowledgePossession"))
+	else if (Func->GetFName() == NAME_ServerAcknowledgePossession)
 	{
 		unrealpb::PlayerController_ServerAcknowledgePossession_Params Msg;
 		Msg.ParseFromString(ParamsPayload);
@@ -314,7 +331,7 @@ TSharedPtr<void> FChanneldPlayerControllerReplicator::DeserializeFunctionParams(
 		Params->Pawn = Pawn;
 		return Params;
 	}
-	else if (Func->GetFName() == FName("ClientGotoState"))
+	else if (Func->GetFName() == NAME_ClientGotoState)
 	{
 		unrealpb::PlayerController_ClientGotoState_Params Msg;
 		Msg.ParseFromString(ParamsPayload);
@@ -322,7 +339,7 @@ TSharedPtr<void> FChanneldPlayerControllerReplicator::DeserializeFunctionParams(
 		Params->NewState = FName(UTF8_TO_TCHAR(Msg.newstate().c_str()));
 		return Params;
 	}
-	else if (Func->GetFName() == FName("ClientReceiveLocalizedMessage"))
+	else if (Func->GetFName() == NAME_ClientReceiveLocalizedMessage)
 	{
 		unrealpb::PlayerController_ClientReceiveLocalizedMessage_Params Msg;
 		Msg.ParseFromString(ParamsPayload);
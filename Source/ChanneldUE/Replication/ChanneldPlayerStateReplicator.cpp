@@ -9,8 +9,8 @@ FChanneldPlayerStateReplicator::FChanneldPlayerStateReplicator(UObject* InTarget
 	TArray<FLifetimeProperty> RepProps;
 	DisableAllReplicatedPropertiesOfClass(InTargetObj->GetClass(), APlayerState::StaticClass(), EFieldIteratorFlags::ExcludeSuper, RepProps);
 
-	FullState = new unrealpb::PlayerState;
-	DeltaState = new unrealpb::PlayerState;
+	FullState = AcquireState<unrealpb::PlayerState>();
+	DeltaState = AcquireState<unrealpb::PlayerState>();
 
 	{
 		auto Property = CastFieldChecked<const FFloatProperty>(PlayerState->GetClass()->FindPropertyByName(FName("Score")));
@@ -34,8 +34,8 @@ FChanneldPlayerStateReplicator::FChanneldPlayerStateReplicator(UObject* InTarget
 
 FChanneldPlayerStateReplicator::~FChanneldPlayerStateReplicator()
 {
-	delete FullState;
-	delete DeltaState;
+	ReleaseState(FullState);
+	ReleaseState(DeltaState);
 }
 
 google::protobuf::Message* FChanneldPlayerStateReplicator::GetDeltaState()
@@ -0,0 +1,98 @@
+#include "ChanneldProjectileMovementComponentReplicator.h"
+#include "ChanneldUtils.h"
+
+FChanneldProjectileMovementComponentReplicator::FChanneldProjectileMovementComponentReplicator(UObject* InTargetObj) :
+	FChanneldReplicatorBase_AC(InTargetObj)
+{
+	Comp = CastChecked<UProjectileMovementComponent>(InTargetObj);
+	// Remove the registered DOREP() properties in the Actor
+	TArray<FLifetimeProperty> RepProps;
+	DisableAllReplicatedPropertiesOfClass(InTargetObj->GetClass(), GetTargetClass(), EFieldIteratorFlags::ExcludeSuper, RepProps);
+
+	FullState = AcquireState<unrealpb::ProjectileMovementComponentState>();
+	DeltaState = AcquireState<unrealpb::ProjectileMovementComponentState>();
+}
+
+FChanneldProjectileMovementComponentReplicator::~FChanneldProjectileMovementComponentReplicator()
+{
+	ReleaseState(FullState);
+	ReleaseState(DeltaState);
+}
+
+void FChanneldProjectileMovementComponentReplicator::ClearState()
+{
+	DeltaState->Clear();
+	bStateChanged = false;
+}
+
+void FChanneldProjectileMovementComponentReplicator::Tick(float DeltaTime)
+{
+	if (!Comp.IsValid() || !Comp->GetOwner())
+	{
+		return;
+	}
+
+	// StopSimulating() clears the UpdatedComponent.
+	const bool bStopped = Comp->UpdatedComponent == nullptr;
+	if (bStopped != FullState->isstopped())
+	{
+		DeltaState->set_isstopped(bStopped);
+		bStateChanged = true;
+	}
+
+	SecondsSinceSent += DeltaTime;
+	if (!bStopped)
+	{
+		// The clients apply the same gravity to the last received velocity.
+		const FVector PredictedVelocity = LastSentVelocity + FVector(0.f, 0.f, Comp->GetGravityZ() * SecondsSinceSent);
+		if (!FullState->has_velocity() || !Comp->Velocity.Equals(PredictedVelocity, VelocityTolerance))
+		{
+			// All the components are sent, as the clients don't have the last sent velocity after simulating.
+			unrealpb::FVector* Velocity = DeltaState->mutable_velocity();
+			Velocity->set_x(Comp->Velocity.X);
+			Velocity->set_y(Comp->Velocity.Y);
+			Velocity->set_z(Comp->Velocity.Z);
+			LastSentVelocity = Comp->Velocity;
+			SecondsSinceSent = 0.f;
+			bStateChanged = true;
+		}
+	}
+
+	if (bStateChanged)
+	{
+		FullState->MergeFrom(*DeltaState);
+	}
+}
+
+void FChanneldProjectileMovementComponentReplicator::OnStateChanged(const google::protobuf::Message* InNewState)
+{
+	if (!Comp.IsValid() || !Comp->GetOwner())
+	{
+		return;
+	}
+
+	// Only client needs to apply the new state
+	if (Comp->GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	const unrealpb::ProjectileMovementComponentState* NewState = static_cast<const unrealpb::ProjectileMovementComponentState*>(InNewState);
+	FullState->MergeFrom(*NewState);
+	bStateChanged = false;
+
+	if (FullState->isstopped())
+	{
+		if (Comp->UpdatedComponent)
+		{
+			Comp->StopSimulating(FHitResult());
+		}
+		return;
+	}
+
+	if (NewState->has_velocity())
+	{
+		ChanneldUtils::SetVectorFromPB(Comp->Velocity, NewState->velocity());
+		Comp->UpdateComponentVelocity();
+	}
+}
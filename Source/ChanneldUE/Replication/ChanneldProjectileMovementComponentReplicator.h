@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Replication/ChanneldReplicatorBase.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "unreal_components.pb.h"
+
+/**
+ * Replicates the velocity of the projectile only when it deviates from the ballistic prediction of the last sent velocity
+ * (e.g. bounced or homing), as the clients simulate the same trajectory in between. The stop of the simulation is also replicated.
+ */
+class CHANNELDUE_API FChanneldProjectileMovementComponentReplicator : public FChanneldReplicatorBase_AC
+{
+public:
+	FChanneldProjectileMovementComponentReplicator(UObject* InTargetObj);
+	virtual ~FChanneldProjectileMovementComponentReplicator() override;
+
+	//~Begin FChanneldReplicatorBase Interface
+	virtual UClass* GetTargetClass() override { return UProjectileMovementComponent::StaticClass(); }
+	virtual google::protobuf::Message* GetDeltaState() override { return DeltaState; }
+	virtual google::protobuf::Message* GetFullState() override { return FullState; }
+	virtual void ClearState() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual void OnStateChanged(const google::protobuf::Message* NewState) override;
+	//~End FChanneldReplicatorBase Interface
+
+protected:
+	TWeakObjectPtr<UProjectileMovementComponent> Comp;
+
+	// [Server+Client] The accumulated channel data of the target object
+	unrealpb::ProjectileMovementComponentState* FullState;
+	// [Server] The accumulated delta change before next send
+	unrealpb::ProjectileMovementComponentState* DeltaState;
+
+private:
+	// [Server] The deviation (in cm/s) from the predicted velocity to send the velocity again
+	static constexpr float VelocityTolerance = 1.f;
+	FVector LastSentVelocity = FVector::ZeroVector;
+	float SecondsSinceSent = 0.f;
+};
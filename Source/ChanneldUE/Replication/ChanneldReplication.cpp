@@ -1,10 +1,22 @@
 #include "ChanneldReplication.h"
+#include "ChanneldSettings.h"
+#include "unreal_common.pb.h"
 
 TMap<const UClass*, const FReplicatorCreateFunc> ChanneldReplication::ReplicatorRegistry;
 TMap<const FString, const FReplicatorCreateFunc> ChanneldReplication::BPReplicatorRegistry;
 TArray<FReplicatorStateInProto> ChanneldReplication::ReplicatorStatesInProto;
 TMap<const UClass*, FReplicatorStateInProto> ChanneldReplication::ReplicatorTargetClassToStateInProto;
 TMap<const FName, IChannelDataProcessor*> ChanneldReplication::ChannelDataProcessorRegistry;
+TMap<const FName, FChannelDataProcessorCreateFunc> ChanneldReplication::ChannelDataProcessorFactories;
+TMap<const FName, TUniquePtr<IChannelDataProcessor>> ChanneldReplication::OwnedChannelDataProcessors;
+TMap<TPair<const google::protobuf::Descriptor*, const UClass*>, FChanneldStateBinding> ChanneldReplication::StateBindingRegistry;
+TMap<TPair<const UClass*, const UClass*>, ChanneldReplication::FResolvedReplicatorFactories> ChanneldReplication::ResolvedFactoriesCache;
+TMap<const FString, TWeakObjectPtr<UClass>> ChanneldReplication::BlueprintClassCache;
+TArray<FName> ChanneldReplication::RPCFunctionNames;
+TMap<FString, int32> ChanneldReplication::RPCFunctionIds;
+
+// The function name in RemoteFunctionMessage that starts with this character is an id. Not a legal character of the function names.
+static constexpr char RPCFunctionIdPrefix = '#';
 
 FReplicatorStateInProto* ChanneldReplication::FindReplicatorStateInProto(const UClass* TargetClass)
 {
@@ -16,6 +28,7 @@ FReplicatorStateInProto* ChanneldReplication::FindReplicatorStateInProto(const U
 	}
 
 	// Find in the original array
+	FName TargetClassPathFName;
 	for (FReplicatorStateInProto& State : ReplicatorStatesInProto)
 	{
 		if (State.TargetClass)
@@ -28,7 +41,12 @@ FReplicatorStateInProto* ChanneldReplication::FindReplicatorStateInProto(const U
 		}
 		else
 		{
-			if (State.TargetClassPathName == TargetClass->GetPathName())
+			// Build the path name once, only if there's any state registered by the path name.
+			if (TargetClassPathFName.IsNone())
+			{
+				TargetClassPathFName = FName(*TargetClass->GetPathName());
+			}
+			if (State.TargetClassPathFName == TargetClassPathFName)
 			{
 				State.TargetClass = TargetClass;
 				Result = &State;
@@ -55,8 +73,9 @@ void ChanneldReplication::RegisterReplicator(const UClass* TargetClass, const FR
 		return;
 	}
 	ReplicatorRegistry.Add(TargetClass, Func);
-	ReplicatorRegistry.Emplace(TargetClass, Func);
-	UE_LOG(LogChanneld, Log, TEXT("Registered replicator for %s, registry size: %d"), *TargetClass->GetFullName(), ReplicatorRegistry.Num());
+	// The cache holds the pointers to the functions in the registry.
+	ResolvedFactoriesCache.Reset();
+	UE_LOG(LogChanneld, Verbose, TEXT("Registered replicator for %s, registry size: %d"), *TargetClass->GetFullName(), ReplicatorRegistry.Num());
 
 	if (!bExists)
 	{
@@ -73,7 +92,8 @@ void ChanneldReplication::RegisterReplicator(const FString& PathName, const FRep
 		return;
 	}
 	BPReplicatorRegistry.Add(PathName, Func);
-	UE_LOG(LogChanneld, Log, TEXT("Registered replicator for %s, registry size: %d"), *PathName, BPReplicatorRegistry.Num());
+	ResolvedFactoriesCache.Reset();
+	UE_LOG(LogChanneld, Verbose, TEXT("Registered replicator for %s, registry size: %d"), *PathName, BPReplicatorRegistry.Num());
 
 	if (!bExists)
 	{
@@ -84,33 +104,42 @@ void ChanneldReplication::RegisterReplicator(const FString& PathName, const FRep
 // TODO: use the pool
 TArray<FChanneldReplicatorBase*> ChanneldReplication::FindAndCreateReplicators(UObject* ReplicatedObj, const UClass* SkipRootClass /*= nullptr*/)
 {
-	TArray<FChanneldReplicatorBase*> Result;
-	// Recurse the base class until find the matching replicator
-	for (const UClass* Class = ReplicatedObj->GetClass(); Class != SkipRootClass; Class = Class->GetSuperClass())
+	const UClass* ObjClass = ReplicatedObj->GetClass();
+	FResolvedReplicatorFactories& Resolved = ResolvedFactoriesCache.FindOrAdd(MakeTuple(ObjClass, SkipRootClass));
+	// A stale entry can be left by an unloaded class whose address is reused.
+	if (Resolved.Class.Get() != ObjClass)
 	{
-		const FReplicatorCreateFunc* Func = nullptr;
-		if (ReplicatorRegistry.Contains(Class))
-		{
-			Func = ReplicatorRegistry.Find(Class);
-		}
-		else if (Class->HasAnyClassFlags(CLASS_CompiledFromBlueprint) && BPReplicatorRegistry.Contains(Class->GetPathName()))
-		{
-			Func = BPReplicatorRegistry.Find(Class->GetPathName());
-		}
-		else
+		Resolved.Class = ObjClass;
+		Resolved.Factories.Reset();
+		// Recurse the base class until find the matching replicator
+		for (const UClass* Class = ObjClass; Class != SkipRootClass; Class = Class->GetSuperClass())
 		{
-			continue;
-		}
-		if (Func == nullptr)
-		{
-			UE_LOG(LogChanneld, Log, TEXT("Class %s was registered, but the replicator construction function is nullptr"), *ReplicatedObj->GetName(), BPReplicatorRegistry.Num());
-			continue;
+			const FReplicatorCreateFunc* Func = ReplicatorRegistry.Find(Class);
+			if (Func == nullptr && Class->HasAnyClassFlags(CLASS_CompiledFromBlueprint))
+			{
+				Func = BPReplicatorRegistry.Find(Class->GetPathName());
+			}
+			if (Func == nullptr)
+			{
+				continue;
+			}
+			if (!(*Func))
+			{
+				UE_LOG(LogChanneld, Log, TEXT("Class %s was registered, but the replicator construction function is nullptr"), *Class->GetName());
+				continue;
+			}
+			// Add the replicators in the order as base class -> inherited class (e.g. Actor->GameStateBase),
+			// to make sure the property updates are executed in the right order (e.g. Actor.Role -> GameStateBase.bReplicatedHasBegunPlay)
+			Resolved.Factories.Insert(MakeTuple(Class, Func), 0);
 		}
-		auto Replicator = (*Func)(ReplicatedObj);
-		UE_LOG(LogChanneld, Verbose, TEXT("Created %sReplicator for object: %s"), *Class->GetName(), *ReplicatedObj->GetName());
-		// Add the replicators in the order as base class -> inherited class (e.g. Actor->GameStateBase),
-		// to make sure the property updates are executed in the right order (e.g. Actor.Role -> GameStateBase.bReplicatedHasBegunPlay)
-		Result.Insert(Replicator, 0);
+	}
+
+	TArray<FChanneldReplicatorBase*> Result;
+	Result.Reserve(Resolved.Factories.Num());
+	for (auto& Pair : Resolved.Factories)
+	{
+		Result.Add((*Pair.Value)(ReplicatedObj));
+		UE_LOG(LogChanneld, Verbose, TEXT("Created %sReplicator for object: %s"), *Pair.Key->GetName(), *ReplicatedObj->GetName());
 	}
 
 	//if (Result.Num() == 0)
@@ -120,12 +149,70 @@ TArray<FChanneldReplicatorBase*> ChanneldReplication::FindAndCreateReplicators(U
 	return Result;
 }
 
+UClass* ChanneldReplication::LoadBlueprintClass(const FString& BlueprintPath)
+{
+	TWeakObjectPtr<UClass>& CachedClass = BlueprintClassCache.FindOrAdd(BlueprintPath);
+	if (!CachedClass.IsValid())
+	{
+		CachedClass = LoadClass<UObject>(nullptr, *FString::Printf(TEXT("Blueprint'%s'"), *BlueprintPath));
+	}
+	return CachedClass.Get();
+}
+
 void ChanneldReplication::RegisterChannelDataProcessor(const FName& MessageFullName, IChannelDataProcessor* Processor)
 {
 	ChannelDataProcessorRegistry.Add(MessageFullName, Processor);
 	UE_LOG(LogChanneld, Log, TEXT("Registered processor for %s"), *MessageFullName.ToString());
 }
 
+void ChanneldReplication::RegisterChannelDataProcessorFactory(const FName& MessageFullName, const FChannelDataProcessorCreateFunc& Func)
+{
+	// Replace the processor created by the last factory, e.g. after the registration subsystem is re-initialized.
+	UnregisterChannelDataProcessor(MessageFullName);
+	ChannelDataProcessorFactories.Add(MessageFullName, Func);
+}
+
+void ChanneldReplication::UnregisterChannelDataProcessor(const FName& MessageFullName)
+{
+	ChannelDataProcessorRegistry.Remove(MessageFullName);
+	ChannelDataProcessorFactories.Remove(MessageFullName);
+	OwnedChannelDataProcessors.Remove(MessageFullName);
+}
+
+IChannelDataProcessor* ChanneldReplication::CreateChannelDataProcessor(const FName& MessageFullName)
+{
+	const FChannelDataProcessorCreateFunc* Func = ChannelDataProcessorFactories.Find(MessageFullName);
+	if (Func == nullptr || !(*Func))
+	{
+		return nullptr;
+	}
+	IChannelDataProcessor* Processor = (*Func)();
+	OwnedChannelDataProcessors.Add(MessageFullName, TUniquePtr<IChannelDataProcessor>(Processor));
+	RegisterChannelDataProcessor(MessageFullName, Processor);
+	return Processor;
+}
+
+void ChanneldReplication::CreateAllChannelDataProcessors()
+{
+	TArray<FName> MessageFullNames;
+	ChannelDataProcessorFactories.GetKeys(MessageFullNames);
+	for (const FName& MessageFullName : MessageFullNames)
+	{
+		FindChannelDataProcessor(MessageFullName);
+	}
+}
+
+void ChanneldReplication::RegisterStateBinding(const google::protobuf::Descriptor* ChannelDataDescriptor, const UClass* TargetClass, const FChanneldStateBinding& Binding)
+{
+	StateBindingRegistry.Add(MakeTuple(ChannelDataDescriptor, TargetClass), Binding);
+	UE_LOG(LogChanneld, Verbose, TEXT("Registered state binding of %s in %s"), *TargetClass->GetName(), UTF8_TO_TCHAR(ChannelDataDescriptor->full_name().c_str()));
+}
+
+const FChanneldStateBinding* ChanneldReplication::FindStateBinding(const google::protobuf::Descriptor* ChannelDataDescriptor, const UClass* TargetClass)
+{
+	return StateBindingRegistry.Find(MakeTuple(ChannelDataDescriptor, TargetClass));
+}
+
 uint32 ChanneldReplication::GetUnrealObjectType(const UObject* Obj)
 {
 	if (Obj == nullptr)
@@ -163,3 +250,47 @@ uint32 ChanneldReplication::GetUnrealObjectType(const UObject* Obj)
 
 	return 0;
 }
+
+void ChanneldReplication::RegisterRPCFunctionNames(const TArray<FName>& FuncNames)
+{
+	for (const FName& FuncName : FuncNames)
+	{
+		FString FuncNameStr = FuncName.ToString();
+		if (!RPCFunctionIds.Contains(FuncNameStr))
+		{
+			RPCFunctionIds.Add(MoveTemp(FuncNameStr), RPCFunctionNames.Add(FuncName));
+		}
+	}
+	UE_LOG(LogChanneld, Log, TEXT("Registered %d RPC function ids"), RPCFunctionNames.Num());
+}
+
+void ChanneldReplication::SetRPCFunctionName(unrealpb::RemoteFunctionMessage& RpcMsg, const FString& FuncName)
+{
+	if (GetMutableDefault<UChanneldSettings>()->bUseRPCFunctionIds)
+	{
+		if (const int32* FuncId = RPCFunctionIds.Find(FuncName))
+		{
+			std::string* Name = RpcMsg.mutable_functionname();
+			Name->assign(1, RPCFunctionIdPrefix);
+			Name->append(std::to_string(*FuncId));
+			return;
+		}
+	}
+	RpcMsg.set_functionname(TCHAR_TO_UTF8(*FuncName), FuncName.Len());
+}
+
+FName ChanneldReplication::GetRPCFunctionName(const unrealpb::RemoteFunctionMessage& RpcMsg)
+{
+	const std::string& Name = RpcMsg.functionname();
+	if (Name.size() > 1 && Name[0] == RPCFunctionIdPrefix)
+	{
+		const int32 FuncId = std::atoi(Name.c_str() + 1);
+		if (RPCFunctionNames.IsValidIndex(FuncId))
+		{
+			return RPCFunctionNames[FuncId];
+		}
+		UE_LOG(LogChanneld, Warning, TEXT("Unknown RPC function id: %d. The server and the client should have the same generated replication code."), FuncId);
+		return NAME_None;
+	}
+	return FName(UTF8_TO_TCHAR(Name.c_str()));
+}
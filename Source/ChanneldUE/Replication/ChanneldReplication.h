@@ -3,10 +3,16 @@
 #include "ChannelDataInterfaces.h"
 #include "ChanneldTypes.h"
 #include "UObject/SoftObjectPtr.h"
+#include "google/protobuf/map.h"
 
 class FChanneldReplicatorBase;
+namespace unrealpb
+{
+	class RemoteFunctionMessage;
+}
 
 typedef TFunction<FChanneldReplicatorBase*(UObject*)> FReplicatorCreateFunc;
+typedef TFunction<IChannelDataProcessor*()> FChannelDataProcessorCreateFunc;
 
 struct FReplicatorStateInProto
 {
@@ -23,6 +29,16 @@ struct FReplicatorStateInProto
 		, bIsInMap(InIsInMap){}
 };
 
+// The direct accessors of the states of a replicated class in a type of channel data. IChannelDataProcessor finds the state by comparing
+// the TargetClass against each of its replicated classes, while the binding is resolved once per replicator. See TChanneldStateBinding.
+struct FChanneldStateBinding
+{
+	const google::protobuf::Message* (*GetState)(google::protobuf::Message* ChannelData, uint32 NetGUID, bool& bIsRemoved) = nullptr;
+	void (*SetState)(const google::protobuf::Message* State, google::protobuf::Message* ChannelData, uint32 NetGUID) = nullptr;
+
+	FORCEINLINE bool IsValid() const { return GetState != nullptr && SetState != nullptr; }
+};
+
 namespace ChanneldReplication
 {
 	extern TMap<const UClass*, const FReplicatorCreateFunc> ReplicatorRegistry;
@@ -30,21 +46,108 @@ namespace ChanneldReplication
 	CHANNELDUE_API void RegisterReplicator(const UClass* TargetClass, const FReplicatorCreateFunc& Func, bool bOverride = true, bool bIsInMap = true);
 	CHANNELDUE_API void RegisterReplicator(const FString& PathName, const FReplicatorCreateFunc& Func, bool bOverride = true, bool bIsInMap = true);
 	CHANNELDUE_API TArray<FChanneldReplicatorBase*> FindAndCreateReplicators(UObject* ReplicatedObj, const UClass* SkipRootClass = nullptr);
+	// Load the blueprint class of the path name once. The result is cached until the class is unloaded.
+	CHANNELDUE_API UClass* LoadBlueprintClass(const FString& BlueprintPath);
+
+	// The registered classes in the hierarchy of a class and their replicator construction functions, in the order as base class -> inherited class.
+	struct FResolvedReplicatorFactories
+	{
+		TWeakObjectPtr<const UClass> Class;
+		TArray<TPair<const UClass*, const FReplicatorCreateFunc*>> Factories;
+	};
+	// Keyed by the replicated class and the SkipRootClass. Invalidated when any replicator is registered.
+	extern TMap<TPair<const UClass*, const UClass*>, FResolvedReplicatorFactories> ResolvedFactoriesCache;
+	extern TMap<const FString, TWeakObjectPtr<UClass>> BlueprintClassCache;
 	
 	extern TArray<FReplicatorStateInProto> ReplicatorStatesInProto;
 	extern TMap<const UClass*, FReplicatorStateInProto> ReplicatorTargetClassToStateInProto;
 	CHANNELDUE_API FReplicatorStateInProto* FindReplicatorStateInProto(const UClass* TargetClass);
 
-	extern TMap<const FName, IChannelDataProcessor*> ChannelDataProcessorRegistry;
+	// Keyed by the descriptor of the channel data and the replicated class.
+	extern TMap<TPair<const google::protobuf::Descriptor*, const UClass*>, FChanneldStateBinding> StateBindingRegistry;
+	CHANNELDUE_API void RegisterStateBinding(const google::protobuf::Descriptor* ChannelDataDescriptor, const UClass* TargetClass, const FChanneldStateBinding& Binding);
+	// Returns nullptr if the states of the class are only accessible via the IChannelDataProcessor of the channel data.
+	CHANNELDUE_API const FChanneldStateBinding* FindStateBinding(const google::protobuf::Descriptor* ChannelDataDescriptor, const UClass* TargetClass);
+
+	extern CHANNELDUE_API TMap<const FName, IChannelDataProcessor*> ChannelDataProcessorRegistry;
 	CHANNELDUE_API void RegisterChannelDataProcessor(const FName& MessageFullName, IChannelDataProcessor* Processor);
+	// The processors registered by their factories are created at the first lookup of the message type, and owned by the registry.
+	extern TMap<const FName, FChannelDataProcessorCreateFunc> ChannelDataProcessorFactories;
+	extern TMap<const FName, TUniquePtr<IChannelDataProcessor>> OwnedChannelDataProcessors;
+	CHANNELDUE_API void RegisterChannelDataProcessorFactory(const FName& MessageFullName, const FChannelDataProcessorCreateFunc& Func);
+	// Removes the processor of the message type, and deletes it if it's created by the factory.
+	CHANNELDUE_API void UnregisterChannelDataProcessor(const FName& MessageFullName);
+	// Creates the processor of the message type from its factory. Returns nullptr if there's no factory.
+	CHANNELDUE_API IChannelDataProcessor* CreateChannelDataProcessor(const FName& MessageFullName);
+	// Creates all the processors that have not been looked up yet, e.g. to iterate ChannelDataProcessorRegistry.
+	CHANNELDUE_API void CreateAllChannelDataProcessors();
 	FORCEINLINE CHANNELDUE_API IChannelDataProcessor* FindChannelDataProcessor(const FName& MessageFullName)
 	{
-		return ChannelDataProcessorRegistry.FindRef(MessageFullName);
+		IChannelDataProcessor* Processor = ChannelDataProcessorRegistry.FindRef(MessageFullName);
+		return Processor ? Processor : CreateChannelDataProcessor(MessageFullName);
 	}
 
 	uint32 GetUnrealObjectType(const UObject* Obj);
+
+	// The dense ids of the RPC functions, written to RemoteFunctionMessage instead of the names if UChanneldSettings::bUseRPCFunctionIds is set.
+	// The generated UChanneldReplicatorRegistration registers the names in sorted order, so the server and the client built from the same generated code have the same ids.
+	extern TArray<FName> RPCFunctionNames;
+	extern TMap<FString, int32> RPCFunctionIds;
+	CHANNELDUE_API void RegisterRPCFunctionNames(const TArray<FName>& FuncNames);
+	// Set the function name of the RPC message, or its id if registered.
+	CHANNELDUE_API void SetRPCFunctionName(unrealpb::RemoteFunctionMessage& RpcMsg, const FString& FuncName);
+	// Get the function name of the RPC message. Returns NAME_None if the message has an unknown id.
+	CHANNELDUE_API FName GetRPCFunctionName(const unrealpb::RemoteFunctionMessage& RpcMsg);
 }
 
+/**
+ * The accessors of the states in a map<uint32, StateType> field of the channel data, with the field accessor as a template argument,
+ * so the compiler inlines the map lookup. The removable states (of the actors and the actor components) are set with the 'removed'
+ * flag when the state is null, like the Removed state of the generated processor.
+ */
+template <typename ChannelDataType, typename StateType, google::protobuf::Map<uint32, StateType>* (ChannelDataType::*MutableStates)(), bool bRemovable>
+struct TChanneldStateBinding
+{
+	static const google::protobuf::Message* GetState(google::protobuf::Message* ChannelData, uint32 NetGUID, bool& bIsRemoved)
+	{
+		auto States = (static_cast<ChannelDataType*>(ChannelData)->*MutableStates)();
+		auto Itr = States->find(NetGUID);
+		if (Itr == States->end())
+		{
+			return nullptr;
+		}
+		if constexpr (bRemovable)
+		{
+			bIsRemoved = Itr->second.removed();
+		}
+		else
+		{
+			bIsRemoved = false;
+		}
+		return &Itr->second;
+	}
+
+	static void SetState(const google::protobuf::Message* State, google::protobuf::Message* ChannelData, uint32 NetGUID)
+	{
+		auto States = (static_cast<ChannelDataType*>(ChannelData)->*MutableStates)();
+		if (State)
+		{
+			(*States)[NetGUID] = *static_cast<const StateType*>(State);
+		}
+		else if constexpr (bRemovable)
+		{
+			StateType& RemovedState = (*States)[NetGUID];
+			RemovedState.Clear();
+			RemovedState.set_removed(true);
+		}
+	}
+
+	static FChanneldStateBinding Get() { return FChanneldStateBinding{&GetState, &SetState}; }
+};
+
+#define REGISTER_STATE_BINDING(ChannelDataType, TargetClass, StateType, FieldName, bRemovable) \
+	ChanneldReplication::RegisterStateBinding(ChannelDataType::descriptor(), TargetClass::StaticClass(), TChanneldStateBinding<ChannelDataType, StateType, &ChannelDataType::mutable_##FieldName, bRemovable>::Get())
+
 #define REGISTER_REPLICATOR_BASE(ReplicatorClass, TargetClass, bOverride, bIsInMap) \
 	ChanneldReplication::RegisterReplicator(TargetClass::StaticClass(), [](UObject* InTargetObj){ return new ReplicatorClass(CastChecked<TargetClass>(InTargetObj)); }, bOverride, bIsInMap)
 
@@ -9,10 +9,33 @@
 #include "ChanneldSettings.h"
 #include "GameFramework/GameStateBase.h"
 
+TMap<const AActor*, TWeakObjectPtr<UChanneldReplicationComponent>> UChanneldReplicationComponent::ActorToComponent;
+
 UChanneldReplicationComponent::UChanneldReplicationComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	PrimaryComponentTick.bCanEverTick = false;
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UChanneldReplicationComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	TickInterpolation();
+}
+
+void UChanneldReplicationComponent::TickInterpolation()
+{
+	const double Time = FPlatformTime::Seconds();
+	bool bInterpolating = false;
+	for (auto& Replicator : Replicators)
+	{
+		bInterpolating |= Replicator->TickInterpolation(Time);
+	}
+	if (IsComponentTickEnabled() != bInterpolating)
+	{
+		SetComponentTickEnabled(bInterpolating);
+	}
 }
 
 void UChanneldReplicationComponent::InitOnce()
@@ -71,10 +94,19 @@ void UChanneldReplicationComponent::InitOnce()
 		}
 	}
 
+	// The movement is the most common change, so wake up the idle component when the owner moves.
+	if ((Settings->ProviderIdleUpdates > 0 || Settings->bScheduledReplication) && GetOwner()->GetRootComponent())
+	{
+		GetOwner()->GetRootComponent()->TransformUpdated.AddUObject(this, &UChanneldReplicationComponent::OnOwnerTransformUpdated);
+	}
+
 	/* Server and client have different processes of adding the DataProvider.
 	// Make sure the DataProvider is always registered
 	GameInstance->GetSubsystem<UChanneldGameInstanceSubsystem>()->RegisterDataProvider(this);
 	*/
+
+	RPCReplicatorCache.Reset();
+	ActorToComponent.Add(GetOwner(), this);
 	
 	bInitialized = true;
 }
@@ -96,6 +128,17 @@ void UChanneldReplicationComponent::UninitOnce()
 	if (bUninitialized)
 		return;
 
+	if (GetOwner()->GetRootComponent())
+	{
+		GetOwner()->GetRootComponent()->TransformUpdated.RemoveAll(this);
+	}
+
+	RPCReplicatorCache.Reset();
+	if (ActorToComponent.FindRef(GetOwner()) == this)
+	{
+		ActorToComponent.Remove(GetOwner());
+	}
+
 	if (auto ChanneldSubsystem = GetOwner()->GetGameInstance()->GetSubsystem<UChanneldGameInstanceSubsystem>())
 	{
 		if (auto View = ChanneldSubsystem->GetChannelDataView())
@@ -183,7 +226,8 @@ bool UChanneldReplicationComponent::UpdateChannelData(google::protobuf::Message*
 		return false;
 	}
 
-	if (!IsRemoved())
+	// The scheduler applies AActor::NetUpdateFrequency itself.
+	if (!IsRemoved() && !GetMutableDefault<UChanneldSettings>()->bScheduledReplication)
 	{
 		// Apply AActor::NetUpdateFrequency
 		float t = GetWorld()->GetTimeSeconds();
@@ -194,7 +238,7 @@ bool UChanneldReplicationComponent::UpdateChannelData(google::protobuf::Message*
 		LastUpdateTime = t;
 	}
 
-	auto Processor = ChanneldReplication::FindChannelDataProcessor(UTF8_TO_TCHAR(ChannelData->GetTypeName().c_str()));
+	auto Processor = FindChannelDataProcessor(ChannelData);
 	ensureMsgf(Processor, TEXT("Unable to find channel data processor for message: %s"), UTF8_TO_TCHAR(ChannelData->GetTypeName().c_str()));
 	if (!Processor)
 	{
@@ -207,8 +251,10 @@ bool UChanneldReplicationComponent::UpdateChannelData(google::protobuf::Message*
 	}
 	
 	bool bUpdated = IsRemoved();
-	for (auto& Replicator : Replicators)
+	for (int32 i = 0; i < Replicators.Num(); i++)
 	{
+		auto& Replicator = Replicators[i];
+		const FChanneldStateBinding& Binding = CachedStateBindings[i];
 		uint32 NetGUID = Replicator->GetNetGUID();
 		if (NetGUID == 0)
 		{
@@ -218,22 +264,200 @@ bool UChanneldReplicationComponent::UpdateChannelData(google::protobuf::Message*
 		
 		if (IsRemoved())
 		{
-			Processor->SetStateToChannelData(nullptr, ChannelData, Replicator->GetTargetClass(), Replicator->GetTargetObject(), NetGUID);
+			if (Binding.IsValid())
+			{
+				Binding.SetState(nullptr, ChannelData, NetGUID);
+			}
+			else
+			{
+				Processor->SetStateToChannelData(nullptr, ChannelData, Replicator->GetTargetClass(), Replicator->GetTargetObject(), NetGUID);
+			}
 			continue;
 		}
 		
-		Replicator->Tick(FApp::GetDeltaTime());
+		{
+			CHANNELD_TRACE_SCOPE_TEXT(Replicator->GetTraceName());
+			Replicator->Tick(FApp::GetDeltaTime());
+		}
 		if (Replicator->IsStateChanged())
 		{
-			Processor->SetStateToChannelData(Replicator->GetDeltaState(), ChannelData, Replicator->GetTargetClass(), Replicator->GetTargetObject(), NetGUID);
+			if (Binding.IsValid())
+			{
+				Binding.SetState(Replicator->GetDeltaState(), ChannelData, NetGUID);
+			}
+			else
+			{
+				Processor->SetStateToChannelData(Replicator->GetDeltaState(), ChannelData, Replicator->GetTargetClass(), Replicator->GetTargetObject(), NetGUID);
+			}
 			Replicator->ClearState();
 			bUpdated = true;
 		}
 	}
 
+	if (!IsRemoved())
+	{
+		UnchangedUpdates = bUpdated ? 0 : UnchangedUpdates + 1;
+		bDormancyFlushPending = false;
+	}
+
 	return bUpdated;
 }
 
+bool UChanneldReplicationComponent::GetNetGUIDs(TArray<uint32>& OutNetGUIDs)
+{
+	for (auto& Replicator : Replicators)
+	{
+		const uint32 NetGUID = Replicator->GetNetGUID();
+		if (NetGUID == 0)
+		{
+			return false;
+		}
+		OutNetGUIDs.AddUnique(NetGUID);
+	}
+	return OutNetGUIDs.Num() > 0;
+}
+
+IChannelDataProcessor* UChanneldReplicationComponent::FindChannelDataProcessor(const google::protobuf::Message* ChannelData)
+{
+	if (ChannelData->GetDescriptor() != CachedChannelDataDescriptor || CachedProcessor == nullptr || CachedStateBindings.Num() != Replicators.Num())
+	{
+		CachedChannelDataDescriptor = ChannelData->GetDescriptor();
+		CachedProcessor = ChanneldReplication::FindChannelDataProcessor(UTF8_TO_TCHAR(ChannelData->GetTypeName().c_str()));
+		CachedStateBindings.SetNum(Replicators.Num());
+		for (int32 i = 0; i < Replicators.Num(); i++)
+		{
+			const FChanneldStateBinding* Binding = ChanneldReplication::FindStateBinding(CachedChannelDataDescriptor, Replicators[i]->GetTargetClass());
+			CachedStateBindings[i] = Binding ? *Binding : FChanneldStateBinding();
+		}
+	}
+	return CachedProcessor;
+}
+
+bool UChanneldReplicationComponent::IsIdle()
+{
+	const int32 IdleUpdates = GetMutableDefault<UChanneldSettings>()->ProviderIdleUpdates;
+	return IdleUpdates > 0 && !bRemoved && UnchangedUpdates >= IdleUpdates;
+}
+
+bool UChanneldReplicationComponent::IsDormant()
+{
+	if (bRemoved || bDormancyFlushPending)
+	{
+		return false;
+	}
+	// DORM_DormantPartial depends on the connection, which the channel data doesn't, so it's replicated as awake.
+	const ENetDormancy Dormancy = GetOwner()->NetDormancy;
+	return Dormancy == DORM_DormantAll || Dormancy == DORM_Initial;
+}
+
+float UChanneldReplicationComponent::GetUpdateInterval()
+{
+	const float BaseInterval = 1.0f / FMath::Max(GetOwner()->NetUpdateFrequency, KINDA_SMALL_NUMBER);
+	const float MaxInterval = FMath::Max(GetMutableDefault<UChanneldSettings>()->MaxScheduledUpdateInterval, BaseInterval);
+	// Double the interval for each update in a row without any change.
+	return FMath::Min(BaseInterval * (1 << FMath::Min(UnchangedUpdates, 16)), MaxInterval);
+}
+
+float UChanneldReplicationComponent::GetUpdatePriority()
+{
+	return GetOwner()->NetPriority;
+}
+
+void UChanneldReplicationComponent::ResendFullState()
+{
+	for (auto& Replicator : Replicators)
+	{
+		Replicator->ResetBaseline();
+	}
+	MarkDirty();
+}
+
+void UChanneldReplicationComponent::MarkPropertyDirty(UObject* Object, FName PropertyName)
+{
+	for (auto& Replicator : Replicators)
+	{
+		if (Replicator->GetTargetObject() == Object)
+		{
+			Replicator->MarkPropertyDirty(PropertyName);
+		}
+	}
+	MarkDirty();
+}
+
+void UChanneldReplicationComponent::MarkObjectPropertyDirty(UObject* Object, FName PropertyName)
+{
+	AActor* Actor = Cast<AActor>(Object);
+	if (Actor == nullptr)
+	{
+		if (UActorComponent* Comp = Cast<UActorComponent>(Object))
+		{
+			Actor = Comp->GetOwner();
+		}
+	}
+	if (Actor == nullptr)
+	{
+		return;
+	}
+	if (UChanneldReplicationComponent* RepComp = FindForActor(Actor))
+	{
+		RepComp->MarkPropertyDirty(Object, PropertyName);
+	}
+}
+
+UChanneldReplicationComponent* UChanneldReplicationComponent::FindForActor(const AActor* Actor)
+{
+	if (const TWeakObjectPtr<UChanneldReplicationComponent>* CachedComp = ActorToComponent.Find(Actor))
+	{
+		// The address may have been reused by another actor if the component wasn't uninitialized.
+		if (CachedComp->IsValid() && (*CachedComp)->GetOwner() == Actor)
+		{
+			return CachedComp->Get();
+		}
+		ActorToComponent.Remove(Actor);
+	}
+	return Actor->FindComponentByClass<UChanneldReplicationComponent>();
+}
+
+void UChanneldReplicationComponent::MarkDirty()
+{
+	// Only the idle or backed off component needs to be woken up. The dormant one waits for FlushDormancy().
+	if (UnchangedUpdates == 0 || IsDormant() || !(IsIdle() || GetMutableDefault<UChanneldSettings>()->bScheduledReplication))
+	{
+		return;
+	}
+
+	UnchangedUpdates = 0;
+	WakeUpInView();
+}
+
+void UChanneldReplicationComponent::FlushDormancy()
+{
+	if (bUninitialized)
+	{
+		return;
+	}
+
+	bDormancyFlushPending = true;
+	UnchangedUpdates = 0;
+	WakeUpInView();
+}
+
+void UChanneldReplicationComponent::WakeUpInView()
+{
+	if (auto ChanneldSubsystem = GetOwner()->GetGameInstance()->GetSubsystem<UChanneldGameInstanceSubsystem>())
+	{
+		if (auto View = ChanneldSubsystem->GetChannelDataView())
+		{
+			View->WakeProvider(this);
+		}
+	}
+}
+
+void UChanneldReplicationComponent::OnOwnerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	MarkDirty();
+}
+
 void UChanneldReplicationComponent::OnChannelDataUpdated(google::protobuf::Message* ChannelData)
 {
 	if (bUninitialized)
@@ -246,7 +470,7 @@ void UChanneldReplicationComponent::OnChannelDataUpdated(google::protobuf::Messa
 		return;
 	}
 
-	auto Processor = ChanneldReplication::FindChannelDataProcessor(UTF8_TO_TCHAR(ChannelData->GetTypeName().c_str()));
+	auto Processor = FindChannelDataProcessor(ChannelData);
 	ensureMsgf(Processor, TEXT("Unable to find channel data processor for message: %s"), UTF8_TO_TCHAR(ChannelData->GetTypeName().c_str()));
 	if (!Processor)
 	{
@@ -260,8 +484,9 @@ void UChanneldReplicationComponent::OnChannelDataUpdated(google::protobuf::Messa
 	
 	GetOwner()->PreNetReceive();
 
-	for (auto& Replicator : Replicators)
+	for (int32 i = 0; i < Replicators.Num(); i++)
 	{
+		auto& Replicator = Replicators[i];
 		auto TargetObj = Replicator->GetTargetObject();
 		if (!TargetObj)
 		{
@@ -277,7 +502,9 @@ void UChanneldReplicationComponent::OnChannelDataUpdated(google::protobuf::Messa
 			continue;
 		}
 		bool bIsRemoved = false;
-		auto State = Processor->GetStateFromChannelData(ChannelData, Replicator->GetTargetClass(), Replicator->GetTargetObject(), NetGUID, bIsRemoved);
+		const FChanneldStateBinding& Binding = CachedStateBindings[i];
+		auto State = Binding.IsValid() ? Binding.GetState(ChannelData, NetGUID, bIsRemoved)
+			: Processor->GetStateFromChannelData(ChannelData, Replicator->GetTargetClass(), Replicator->GetTargetObject(), NetGUID, bIsRemoved);
 		if (State)
 		{
 			if (bIsRemoved)
@@ -300,10 +527,22 @@ void UChanneldReplicationComponent::OnChannelDataUpdated(google::protobuf::Messa
 	{
 		Owner->PostNetReceive();
 	}
+
+	if (GetMutableDefault<UChanneldSettings>()->InterpolationDelayMs > 0)
+	{
+		TickInterpolation();
+	}
 }
 
 TSharedPtr<google::protobuf::Message> UChanneldReplicationComponent::SerializeFunctionParams(UObject* Object, UFunction* Func, void* Params, FOutParmRec* OutParams, bool& bSuccess)
 {
+	CHANNELD_TRACE_SCOPE(Channeld_SerializeRPC);
+	const TPair<const UObject*, const UFunction*> CacheKey(Object, Func);
+	if (FChanneldReplicatorBase* CachedReplicator = RPCReplicatorCache.FindRef(CacheKey))
+	{
+		return CachedReplicator->SerializeFunctionParams(Func, Params, OutParams, bSuccess);
+	}
+	
 	for (auto& Replicator : Replicators)
 	{
 		if (Replicator->GetTargetObject() == Object)
@@ -311,6 +550,7 @@ TSharedPtr<google::protobuf::Message> UChanneldReplicationComponent::SerializeFu
 			auto ParamsMsg = Replicator->SerializeFunctionParams(Func, Params, OutParams, bSuccess);
 			if (bSuccess)
 			{
+				RPCReplicatorCache.Add(CacheKey, Replicator.Get());
 				return ParamsMsg;
 			}
 		}
@@ -322,6 +562,13 @@ TSharedPtr<google::protobuf::Message> UChanneldReplicationComponent::SerializeFu
 
 TSharedPtr<void> UChanneldReplicationComponent::DeserializeFunctionParams(UObject* Object, UFunction* Func, const std::string& ParamsPayload, bool& bSuccess, bool& bDeferredRPC)
 {
+	CHANNELD_TRACE_SCOPE(Channeld_DeserializeRPC);
+	const TPair<const UObject*, const UFunction*> CacheKey(Object, Func);
+	if (FChanneldReplicatorBase* CachedReplicator = RPCReplicatorCache.FindRef(CacheKey))
+	{
+		return CachedReplicator->DeserializeFunctionParams(Func, ParamsPayload, bSuccess, bDeferredRPC);
+	}
+	
 	for (auto& Replicator : Replicators)
 	{
 		if (Replicator->GetTargetObject() == Object)
@@ -329,6 +576,7 @@ TSharedPtr<void> UChanneldReplicationComponent::DeserializeFunctionParams(UObjec
 			TSharedPtr<void> Params = Replicator->DeserializeFunctionParams(Func, ParamsPayload, bSuccess, bDeferredRPC);
 			if (bSuccess)
 			{
+				RPCReplicatorCache.Add(CacheKey, Replicator.Get());
 				return Params;
 			}
 		}
@@ -7,6 +7,7 @@
 #include "Replication/ChanneldReplicatorBase.h"
 #include "Components/ActorComponent.h"
 #include "google/protobuf/message.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "ChanneldReplicationComponent.generated.h"
 
 class UChanneldReplicationComponent;
@@ -15,6 +16,14 @@ DECLARE_DYNAMIC_MULTICAST_SPARSE_DELEGATE_OneParam(FComponentRemovedFromChannelS
 DECLARE_DYNAMIC_MULTICAST_SPARSE_DELEGATE(FCrossServerHandoverSignature, UChanneldReplicationComponent, OnCrossServerHandover);
 DECLARE_DYNAMIC_MULTICAST_SPARSE_DELEGATE_OneParam(FEntityChannelCreatedSignature, UChanneldReplicationComponent, OnEntityChannelCreated, int64, ChId);
 
+/**
+ * Marks the property dirty for both UE's push model and the replicators using the push model (see UChanneldSettings::bPushModelReplication).
+ * Use it instead of MARK_PROPERTY_DIRTY_FROM_NAME for the properties replicated via channeld.
+ */
+#define CHANNELD_MARK_PROPERTY_DIRTY_FROM_NAME(ClassName, PropertyName, Object) \
+	MARK_PROPERTY_DIRTY_FROM_NAME(ClassName, PropertyName, Object); \
+	UChanneldReplicationComponent::MarkObjectPropertyDirty(Object, GET_MEMBER_NAME_CHECKED(ClassName, PropertyName))
+
 // Responsible for replicating the owning Actor and its replicated components via ChannelDataUpdate
 UCLASS(BlueprintType, ClassGroup = "Channeld", meta = (DisplayName = "Channeld Replication Component", BlueprintSpawnableComponent))
 class CHANNELDUE_API UChanneldReplicationComponent : public UActorComponent, public IChannelDataProvider
@@ -38,6 +47,11 @@ public:
 	
 	TSet<Channeld::ChannelId> AddedToChannelIds;
 
+	// Set it if the replicators of the owner only read the state of the owner and its components, so the component can be updated on a worker thread.
+	// See UChanneldSettings::bParallelProviderCollection.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Channeld")
+	bool bThreadSafeUpdate = false;
+
 protected:
 	bool bInitialized = false;
 	bool bUninitialized = false;
@@ -46,15 +60,40 @@ protected:
 	// Channeld::ChannelId OwningChannelId;
 	bool bRemoved = false;
 	float LastUpdateTime = 0;
+	// The number of the updates in a row that didn't change any state. See UChanneldSettings::ProviderIdleUpdates.
+	int32 UnchangedUpdates = 0;
+	// The dormant owner is still updated once after it's added or flushed, so the clients have its last state. See FlushDormancy().
+	bool bDormancyFlushPending = true;
+
+	// Let the view update the component in the next tick.
+	void WakeUpInView();
+
+	// The processor of the last channel data type the component updated or consumed.
+	const google::protobuf::Descriptor* CachedChannelDataDescriptor = nullptr;
+	IChannelDataProcessor* CachedProcessor = nullptr;
+	// The state bindings of the replicators (in the same order) in the cached channel data type. Invalid if the replicator's states
+	// are only accessible via the processor.
+	TArray<FChanneldStateBinding> CachedStateBindings;
+	IChannelDataProcessor* FindChannelDataProcessor(const google::protobuf::Message* ChannelData);
+
+	// [Client] Tick the interpolation of the replicators, and keep the component ticking until all of them are settled.
+	void TickInterpolation();
 
 	TArray< TUniquePtr<FChanneldReplicatorBase> > Replicators;
 
+	// The replicator that handled the RPC of the target object (the owner or one of its components) last time.
+	TMap<TPair<const UObject*, const UFunction*>, FChanneldReplicatorBase*> RPCReplicatorCache;
+	// The initialized replication components by their owners, so the RPC routing doesn't have to search the components of the actor.
+	static TMap<const AActor*, TWeakObjectPtr<UChanneldReplicationComponent>> ActorToComponent;
+
 public:
 
 	virtual void BeginPlay() override;
 	virtual void InitOnce();
 	virtual void UninitOnce();
 	virtual void EndPlay(EEndPlayReason::Type Reason) override;
+	// [Client] Only ticks while the replicators are interpolating. See UChanneldSettings::InterpolationDelayMs.
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	/* Only EndPlay() will be triggered on the server when the Actor is being destroy!
 	virtual void DestroyComponent(bool bPromoteChildren = false) override;
 	virtual void BeginDestroy() override;
@@ -68,8 +107,44 @@ public:
 	virtual void SetRemoved(bool bInRemoved) override;
 	virtual bool UpdateChannelData(google::protobuf::Message* ChannelData) override;
 	virtual void OnChannelDataUpdated(google::protobuf::Message* ChannelData) override;
+	virtual bool IsIdle() override;
+	virtual bool IsDormant() override;
+	virtual bool IsThreadSafeUpdate() override { return bThreadSafeUpdate; }
+	virtual bool GetNetGUIDs(TArray<uint32>& OutNetGUIDs) override;
+	virtual float GetUpdateInterval() override;
+	virtual float GetUpdatePriority() override;
 	//~ End IChannelDataProvider Interface.
 
+	// Make an idle (or backed off by the scheduler) component get updated in the next tick. Call it after changing a replicated property of an actor that rarely changes.
+	UFUNCTION(BlueprintCallable, Category = "Components|Channeld")
+	void MarkDirty();
+
+	// [Server] Update the dormant owner once in the next tick. Called by UChanneldNetDriver when AActor::FlushNetDormancy() is called or the dormancy of the owner changes.
+	void FlushDormancy();
+
+	// Send the full states of the replicators in the next update, instead of the deltas against what has been sent.
+	// Call it when the sent updates may not have been applied by channeld, e.g. the channel data is reset.
+	UFUNCTION(BlueprintCallable, Category = "Components|Channeld")
+	void ResendFullState();
+
+	/**
+	 * [Server] Mark a replicated property of the owner or one of its components changed, for the replicators using the push model
+	 * (see UChanneldSettings::bPushModelReplication), which only diff the properties marked dirty. Also wakes the idle component up.
+	 * @param Object The owner actor or its component that has the property.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|Channeld")
+	void MarkPropertyDirty(UObject* Object, FName PropertyName);
+
+	// Find the replication component of the object (an actor or its component) and mark the property dirty. See MarkPropertyDirty().
+	static void MarkObjectPropertyDirty(UObject* Object, FName PropertyName);
+
+	// Find the replication component of the actor. Faster than FindComponentByClass() once the component is initialized.
+	static UChanneldReplicationComponent* FindForActor(const AActor* Actor);
+
+protected:
+	void OnOwnerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+public:
 	TSharedPtr<google::protobuf::Message> SerializeFunctionParams(UObject* Object, UFunction* Func, void* Params, FOutParmRec* OutParams, bool& bSuccess);
 	TSharedPtr<void> DeserializeFunctionParams(UObject* Object, UFunction* Func, const std::string& ParamsPayload, bool& bSuccess, bool& bDeferredRPC);
 };
\ No newline at end of file
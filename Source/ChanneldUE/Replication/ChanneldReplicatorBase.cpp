@@ -2,6 +2,111 @@
 #include "ChanneldReplicationComponent.h"
 #include "Engine/PackageMapClient.h"
 #include "Engine/NetDriver.h"
+#include "ChanneldSettings.h"
+#include "ChanneldReplication.h"
+#include "unreal_common.pb.h"
+#include "unreal_components.pb.h"
+
+namespace
+{
+	// The replicators are created and destroyed in the game thread only.
+	struct FStatePool
+	{
+		TArray<google::protobuf::Message*> FreeStates;
+		// The states created as the pool is empty.
+		int32 Created = 0;
+		int32 Reused = 0;
+		// The states deleted as the pool is full.
+		int32 Deleted = 0;
+	};
+	TMap<const google::protobuf::Descriptor*, FStatePool> StatePools;
+
+	// Only the states of the built-in replicators are pooled. The states of the generated replicators belong to the game module, which is
+	// unloaded (or hot reloaded) before this module, so they can't be kept until EmptyStatePools().
+	bool IsPooledStateType(const google::protobuf::Descriptor* Descriptor)
+	{
+		const google::protobuf::FileDescriptor* File = Descriptor->file();
+		return File == unrealpb::ActorState::descriptor()->file() || File == unrealpb::SkeletalMeshComponentState::descriptor()->file();
+	}
+
+	FAutoConsoleCommand LogStatePoolStatsCommand(
+		TEXT("channeld.ReplicatorStatePoolStats"),
+		TEXT("Log the stats of the replicator state pools"),
+		FConsoleCommandDelegate::CreateStatic(&FChanneldReplicatorBase::LogStatePoolStats));
+}
+
+google::protobuf::Message* FChanneldReplicatorBase::AcquirePooledState(const google::protobuf::Descriptor* Descriptor)
+{
+	if (!IsPooledStateType(Descriptor))
+	{
+		return nullptr;
+	}
+	FStatePool& Pool = StatePools.FindOrAdd(Descriptor);
+	if (Pool.FreeStates.Num() > 0)
+	{
+		Pool.Reused++;
+		return Pool.FreeStates.Pop(false);
+	}
+	Pool.Created++;
+	return nullptr;
+}
+
+void FChanneldReplicatorBase::ReleaseState(google::protobuf::Message* State)
+{
+	if (State == nullptr)
+	{
+		return;
+	}
+
+	if (!IsPooledStateType(State->GetDescriptor()))
+	{
+		delete State;
+		return;
+	}
+	FStatePool& Pool = StatePools.FindOrAdd(State->GetDescriptor());
+	if (Pool.FreeStates.Num() < GetMutableDefault<UChanneldSettings>()->MaxPooledReplicatorStates)
+	{
+		State->Clear();
+		Pool.FreeStates.Add(State);
+	}
+	else
+	{
+		Pool.Deleted++;
+		delete State;
+	}
+}
+
+int32 FChanneldReplicatorBase::FindPropertyOffset(const UClass* Class, const TCHAR* PropertyName, int32 DefaultOffset)
+{
+	if (const FProperty* Property = Class->FindPropertyByName(FName(PropertyName)))
+	{
+		return Property->GetOffset_ForInternal();
+	}
+	UE_LOG(LogChanneld, Error, TEXT("%s Replicator construct, but could not find property(%s) by name."), *Class->GetName(), PropertyName);
+	return DefaultOffset;
+}
+
+void FChanneldReplicatorBase::EmptyStatePools()
+{
+	for (auto& Pair : StatePools)
+	{
+		for (google::protobuf::Message* State : Pair.Value.FreeStates)
+		{
+			delete State;
+		}
+	}
+	StatePools.Empty();
+}
+
+void FChanneldReplicatorBase::LogStatePoolStats()
+{
+	for (auto& Pair : StatePools)
+	{
+		const FStatePool& Pool = Pair.Value;
+		UE_LOG(LogChanneld, Log, TEXT("Replicator state pool of %s: created: %d, reused: %d, deleted: %d, free: %d"),
+			UTF8_TO_TCHAR(Pair.Key->full_name().c_str()), Pool.Created, Pool.Reused, Pool.Deleted, Pool.FreeStates.Num());
+	}
+}
 
 FChanneldReplicatorBase::FChanneldReplicatorBase(UObject* InTargetObj)
 {
@@ -20,6 +125,72 @@ FChanneldReplicatorBase::FChanneldReplicatorBase(UObject* InTargetObj)
 	bStateChanged = false;
 }
 
+void FChanneldReplicatorBase::ResetBaseline()
+{
+	if (google::protobuf::Message* FullState = GetFullState())
+	{
+		FullState->Clear();
+	}
+	ResetShadowState();
+	bInitialStateDiffed = false;
+	// All the properties need to be diffed against the cleared baseline.
+	if (DirtyProperties.Num() > 0)
+	{
+		DirtyProperties.SetRange(0, DirtyProperties.Num(), true);
+	}
+	for (FStringDiffCache& Cache : StringDiffCaches)
+	{
+		Cache.Len = INDEX_NONE;
+	}
+}
+
+void FChanneldReplicatorBase::InitPushModel(int32 NumProperties)
+{
+	if (NumProperties > 0 && GetMutableDefault<UChanneldSettings>()->bPushModelReplication)
+	{
+		// The first Tick() diffs all the properties.
+		DirtyProperties.Init(true, NumProperties);
+	}
+}
+
+bool FChanneldReplicatorBase::IsStringChanged(int32 Index, const FString& Value)
+{
+	FStringDiffCache& Cache = StringDiffCaches[Index];
+	// Case-sensitive, unlike GetTypeHash(FString).
+	const uint32 Hash = FCrc::StrCrc32(*Value);
+	if (Cache.Len == Value.Len() && Cache.Hash == Hash)
+	{
+		return false;
+	}
+	Cache.Hash = Hash;
+	Cache.Len = Value.Len();
+	return true;
+}
+
+bool FChanneldReplicatorBase::MarkPropertyDirty(const FName& PropertyName)
+{
+	if (DirtyProperties.Num() == 0)
+	{
+		return false;
+	}
+	const int32 Index = GetPushModelPropertyIndex(PropertyName);
+	if (!DirtyProperties.IsValidIndex(Index))
+	{
+		return false;
+	}
+	DirtyProperties[Index] = true;
+	return true;
+}
+
+const TCHAR* FChanneldReplicatorBase::GetTraceName()
+{
+	if (TraceName.IsEmpty())
+	{
+		TraceName = FString::Printf(TEXT("Channeld_Replicate_%s"), *GetNameSafe(GetTargetClass()));
+	}
+	return *TraceName;
+}
+
 uint32 FChanneldReplicatorBase::GetNetGUID()
 {
 	if (!NetGUID.IsValid())
@@ -51,3 +222,47 @@ uint32 FChanneldReplicatorBase_AC::GetNetGUID()
 	}
 	return NetGUID.Value;
 }
+
+const FChanneldBlueprintPropertyTable& FChanneldBlueprintPropertyTables::FindOrAdd(UClass* Class, TArrayView<const TCHAR* const> PropertyNames, TArrayView<const int32> DefaultOffsets, TArrayView<const TCHAR* const> RepNotifyNames)
+{
+	if (const TUniquePtr<FChanneldBlueprintPropertyTable>* Table = Tables.Find(Class))
+	{
+		return **Table;
+	}
+
+	// Drop the tables of the unloaded and the recompiled classes.
+	for (auto It = Tables.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TUniquePtr<FChanneldBlueprintPropertyTable> Table = MakeUnique<FChanneldBlueprintPropertyTable>();
+	Table->Offsets.SetNumUninitialized(PropertyNames.Num());
+	Table->RepNotifies.SetNumZeroed(PropertyNames.Num());
+	for (int32 i = 0; i < PropertyNames.Num(); i++)
+	{
+		if (const FProperty* Property = Class->FindPropertyByName(FName(PropertyNames[i])))
+		{
+			Table->Offsets[i] = Property->GetOffset_ForInternal();
+		}
+		else
+		{
+			UE_LOG(LogChanneld, Error, TEXT("%s Replicator construct, but could not find property(%s) by name."), *Class->GetName(), PropertyNames[i]);
+			Table->Offsets[i] = DefaultOffsets[i];
+		}
+		if (RepNotifyNames[i] != nullptr)
+		{
+			// Found on the class of the target objects, so the RepNotify overridden by a subclass is called.
+			Table->RepNotifies[i] = Class->FindFunctionByName(FName(RepNotifyNames[i]));
+		}
+	}
+	return *Tables.Add(Class, MoveTemp(Table));
+}
+
+FChanneldReplicatorBase_BP::FChanneldReplicatorBase_BP(UObject* InTargetObj, const FString& BlueprintPath) : FChanneldReplicatorBase(InTargetObj)
+{
+	BpClass = ChanneldReplication::LoadBlueprintClass(BlueprintPath);
+}
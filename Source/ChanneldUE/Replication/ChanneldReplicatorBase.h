@@ -17,6 +17,8 @@ public:
     FORCEINLINE UObject* GetTargetObject() { return TargetObject.Get(); }
     virtual UClass* GetTargetClass() = 0;
     virtual uint32 GetNetGUID();
+    // The name of the Tick() scope in the trace, by the target class. Built on the first call.
+    const TCHAR* GetTraceName();
 
     // [Server] Is the state changed since last send?
     FORCEINLINE bool IsStateChanged() { return bStateChanged; }
@@ -24,21 +26,116 @@ public:
     virtual google::protobuf::Message* GetDeltaState() = 0;
     // [Server] Reset the state change (after send)
 	virtual void ClearState() { bStateChanged = false; }
+    // [Server+Client] The accumulated state of the target object. On the server, it's the baseline the delta state is diffed against.
+    virtual google::protobuf::Message* GetFullState() { return nullptr; }
+    // [Server] Forget the baseline, so the next Tick() diffs against the default state and sends the full state again, as in the first send.
+    virtual void ResetBaseline();
+    // [Server] Reset the plain struct of the last sent values that the generated replicators diff some properties against instead of the full state.
+    virtual void ResetShadowState() {}
 	// [Server] Collect State change for sending ChannelDataUpdate to channeld
     virtual void Tick(float DeltaTime) = 0;
 	// [Client] Apply ChannelDataUpdate received from channeld
     virtual void OnStateChanged(const google::protobuf::Message* NewState) = 0;
+    // [Client] Move the target object along the buffered transforms (see UChanneldSettings::InterpolationDelayMs). Time is in FPlatformTime::Seconds().
+    // Returns true if it needs to be called again in the next frame.
+    virtual bool TickInterpolation(double Time) { return false; }
 
     virtual TSharedPtr<google::protobuf::Message> SerializeFunctionParams(UFunction* Func, void* Params, FOutParmRec* OutParams, bool& bSuccess) { bSuccess = false; return nullptr; }
     virtual TSharedPtr<void> DeserializeFunctionParams(UFunction* Func, const std::string& ParamsPayload, bool& bSuccess, bool& bDeferredRPC) { bSuccess = false; return nullptr; }
 
+    // [Server] Mark a property changed for the push model. Returns false if the replicator doesn't diff the property by the push model.
+    bool MarkPropertyDirty(const FName& PropertyName);
+    FORCEINLINE bool IsPushModelEnabled() const { return DirtyProperties.Num() > 0; }
+
+    // Free the pooled states of the built-in replicators. See UChanneldSettings::MaxPooledReplicatorStates.
+    static void EmptyStatePools();
+    static void LogStatePoolStats();
+
 protected:
+    // Get a cleared state message from the pool, or create one. The replicators of the actors spawned and destroyed frequently reuse the states
+    // (including the allocated nested messages and strings) of the destroyed ones, instead of allocating them every time.
+    // Only the unrealpb states of the built-in replicators are pooled; the states of the generated replicators are created and deleted as before.
+    template<typename T>
+    static T* AcquireState()
+    {
+        if (google::protobuf::Message* State = AcquirePooledState(T::descriptor()))
+        {
+            return static_cast<T*>(State);
+        }
+        return new T;
+    }
+    // Return the state acquired by AcquireState() to the pool. The state is deleted if the pool is full.
+    static void ReleaseState(google::protobuf::Message* State);
+
+    // Used by the generated replicators to resolve the offsets of the inaccessible properties of the native classes once per replicator class.
+    // Returns DefaultOffset (the offset at generation time) if the property is not found.
+    static int32 FindPropertyOffset(const UClass* Class, const TCHAR* PropertyName, int32 DefaultOffset);
+
+    /**
+     * Push model (see UChanneldSettings::bPushModelReplication): Tick() only diffs the properties marked dirty since the last Tick() instead of all of them.
+     * The replicators that support it call InitPushModel() in the constructor, wrap the diff of each property in IsPropertyDirty(), and call ClearDirtyProperties() at the end of Tick().
+     */
+    void InitPushModel(int32 NumProperties);
+    // The index of the property in the dirty bits, or INDEX_NONE.
+    virtual int32 GetPushModelPropertyIndex(const FName& PropertyName) const { return INDEX_NONE; }
+    FORCEINLINE bool IsPropertyDirty(int32 Index) const { return DirtyProperties.Num() == 0 || DirtyProperties[Index]; }
+    FORCEINLINE void ClearDirtyProperties() { if (DirtyProperties.Num() > 0) { DirtyProperties.SetRange(0, DirtyProperties.Num(), false); } }
+
+    /**
+     * [Server] The generated replicators only convert a string property to UTF-8 and compare it with the full state when its hash or length
+     * differs from the last Tick(). The replicators that support it call InitStringDiffCaches() in the constructor.
+     */
+    FORCEINLINE void InitStringDiffCaches(int32 NumStrings) { StringDiffCaches.SetNum(NumStrings); }
+    // Returns true if the string is different from the one of the last call with the same index, or the baseline is reset since then.
+    bool IsStringChanged(int32 Index, const FString& Value);
+
+    // Has Tick() diffed the state since the replicator is created or the baseline is reset? Used for COND_InitialOnly.
+    FORCEINLINE bool IsInitialStateDiffed() const { return bInitialStateDiffed; }
+    FORCEINLINE void SetInitialStateDiffed() { bInitialStateDiffed = true; }
+
     TWeakObjectPtr<UObject> TargetObject;
 
     FNetworkGUID NetGUID;
 
     bool bStateChanged;
 
+private:
+    static google::protobuf::Message* AcquirePooledState(const google::protobuf::Descriptor* Descriptor);
+
+    // Empty if the push model is not enabled for the replicator.
+    TBitArray<> DirtyProperties;
+    bool bInitialStateDiffed = false;
+
+    struct FStringDiffCache
+    {
+        uint32 Hash = 0;
+        int32 Len = INDEX_NONE;
+    };
+    TArray<FStringDiffCache> StringDiffCaches;
+    FString TraceName;
+};
+
+/**
+ * The offsets of the replicated properties and the RepNotify functions of a Blueprint class, in the order of the properties in the generated
+ * replicator. Looked up by name when the first replicator of the class is created, and shared by the rest.
+ */
+struct FChanneldBlueprintPropertyTable
+{
+    TArray<int32> Offsets;
+    // nullptr for the properties without RepNotify.
+    TArray<UFunction*> RepNotifies;
+};
+
+// The property tables of a generated Blueprint replicator, by the class of the target objects (the Blueprint class or its subclasses).
+class CHANNELDUE_API FChanneldBlueprintPropertyTables
+{
+public:
+    // DefaultOffsets are the offsets at generation time, used for the properties not found. RepNotifyNames are nullptr for the properties without RepNotify.
+    const FChanneldBlueprintPropertyTable& FindOrAdd(UClass* Class, TArrayView<const TCHAR* const> PropertyNames, TArrayView<const int32> DefaultOffsets, TArrayView<const TCHAR* const> RepNotifyNames);
+
+private:
+    // A recompiled Blueprint is a new class, so it gets a new table.
+    TMap<TWeakObjectPtr<UClass>, TUniquePtr<FChanneldBlueprintPropertyTable>> Tables;
 };
 
 /**
@@ -47,10 +144,7 @@ protected:
 class CHANNELDUE_API FChanneldReplicatorBase_BP : public FChanneldReplicatorBase
 {
 public:
-    FChanneldReplicatorBase_BP(UObject* InTargetObj, const FString& BlueprintPath) : FChanneldReplicatorBase(InTargetObj)
-    {
-        BpClass = LoadClass<UObject>(nullptr, *FString::Printf(TEXT("Blueprint'%s'"), *BlueprintPath));
-    }
+    FChanneldReplicatorBase_BP(UObject* InTargetObj, const FString& BlueprintPath);
     virtual UClass* GetTargetClass() override { return BpClass; }
 
     /*
@@ -66,6 +160,24 @@ protected:
     UClass* BpClass;
 };
 
+/**
+ * @brief The object of an object ref field in the full state. Resolving the ref every tick costs a GuidCache lookup,
+ * so the object is kept after the first resolution, until the full state is changed by anything other than Tick().
+ */
+template<typename T>
+struct TChanneldResolvedRef
+{
+    FORCEINLINE bool IsResolved() const { return bResolved; }
+    // Pending kill objects still compare as themselves, as the ref in the full state does.
+    FORCEINLINE T* Get() const { return Object.Get(true); }
+    FORCEINLINE void Set(T* InObject) { Object = InObject; bResolved = true; }
+    FORCEINLINE void Reset() { Object.Reset(); bResolved = false; }
+
+private:
+    TWeakObjectPtr<T> Object;
+    bool bResolved = false;
+};
+
 /**
  * @brief Base class for all replicators of the UActorComponent
  */
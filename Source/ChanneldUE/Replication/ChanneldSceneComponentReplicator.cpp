@@ -4,6 +4,8 @@
 #include "ChanneldSceneComponentReplicator.h"
 #include "unreal_common.pb.h"
 #include "ChanneldUtils.h"
+#include "ChanneldSettings.h"
+#include "GameFramework/Character.h"
 #include "Net/UnrealNetwork.h"
 
 FChanneldSceneComponentReplicator::FChanneldSceneComponentReplicator(USceneComponent* InSceneComp) : FChanneldReplicatorBase_AC(InSceneComp)
@@ -14,8 +16,8 @@ FChanneldSceneComponentReplicator::FChanneldSceneComponentReplicator(USceneCompo
 	TArray<FLifetimeProperty> RepProps;
 	DisableAllReplicatedPropertiesOfClass(InSceneComp->GetClass(), USceneComponent::StaticClass(), EFieldIteratorFlags::ExcludeSuper, RepProps);
 
-	FullState = new unrealpb::SceneComponentState;
-	DeltaState = new unrealpb::SceneComponentState;
+	FullState = AcquireState<unrealpb::SceneComponentState>();
+	DeltaState = AcquireState<unrealpb::SceneComponentState>();
 
 	// Prepare Reflection pointers
 	{
@@ -42,8 +44,8 @@ FChanneldSceneComponentReplicator::~FChanneldSceneComponentReplicator()
 		SceneComp->TransformUpdated.RemoveAll(this);
 	}
 
-	delete FullState;
-	delete DeltaState;
+	ReleaseState(FullState);
+	ReleaseState(DeltaState);
 }
 
 void FChanneldSceneComponentReplicator::Tick(float DeltaTime)
@@ -101,8 +103,13 @@ void FChanneldSceneComponentReplicator::Tick(float DeltaTime)
 		bStateChanged = true;
 	}
 
-	if (ChanneldUtils::GetActorComponentByRef(FullState->mutable_attachparent(), SceneComp->GetWorld(), false) != SceneComp->GetAttachParent())
+	if (!ResolvedAttachParent.IsResolved())
 	{
+		ResolvedAttachParent.Set(Cast<USceneComponent>(ChanneldUtils::GetActorComponentByRef(FullState->mutable_attachparent(), SceneComp->GetWorld(), false)));
+	}
+	if (ResolvedAttachParent.Get() != SceneComp->GetAttachParent())
+	{
+		ResolvedAttachParent.Set(SceneComp->GetAttachParent());
 		if (SceneComp->GetAttachParent() == nullptr)
 		{
 			// Catch warn_unused_result error for Linux build
@@ -116,13 +123,37 @@ void FChanneldSceneComponentReplicator::Tick(float DeltaTime)
 		bStateChanged = true;
 	}
 
-	if (FullState->mutable_attachchildren()->size() != SceneComp->GetAttachChildren().Num())
+	const TArray<USceneComponent*>& AttachChildren = SceneComp->GetAttachChildren();
+	bool bAttachChildrenChanged;
+	if (bAttachChildrenResolved)
+	{
+		bAttachChildrenChanged = ReplicatedAttachChildren.Num() != AttachChildren.Num();
+		for (int32 i = 0; !bAttachChildrenChanged && i < AttachChildren.Num(); i++)
+		{
+			bAttachChildrenChanged = ReplicatedAttachChildren[i].Get(true) != AttachChildren[i];
+		}
+	}
+	else
+	{
+		// The refs in FullState are not resolved, only the count is compared.
+		bAttachChildrenChanged = FullState->attachchildren_size() != AttachChildren.Num();
+		if (!bAttachChildrenChanged)
+		{
+			ReplicatedAttachChildren.Reset(AttachChildren.Num());
+			ReplicatedAttachChildren.Append(AttachChildren);
+			bAttachChildrenResolved = true;
+		}
+	}
+	if (bAttachChildrenChanged)
 	{
 		DeltaState->clear_attachchildren();
-		for (auto Child : SceneComp->GetAttachChildren())
+		ReplicatedAttachChildren.Reset(AttachChildren.Num());
+		for (auto Child : AttachChildren)
 		{
 			*DeltaState->mutable_attachchildren()->Add() = ChanneldUtils::GetRefOfActorComponent(Child);
+			ReplicatedAttachChildren.Add(Child);
 		}
+		bAttachChildrenResolved = true;
 		bStateChanged = true;
 	}
 
@@ -133,19 +164,23 @@ void FChanneldSceneComponentReplicator::Tick(float DeltaTime)
 		bStateChanged = true;
 	}
 
-	if (ChanneldUtils::CheckDifference(SceneComp->GetRelativeLocation(), FullState->mutable_relativelocation()))
+	const uint32 TransformDiffMask = ChanneldUtils::GetTransformDifferenceMask(
+		SceneComp->GetRelativeLocation(), SceneComp->GetRelativeRotation(), SceneComp->GetRelativeScale3D(),
+		BaseLocation, BaseRotation, BaseScale);
+
+	if (TransformDiffMask & 0x00F)
 	{
 		ChanneldUtils::SetVectorToPB(DeltaState->mutable_relativelocation(), SceneComp->GetRelativeLocation(), FullState->mutable_relativelocation());
 		bStateChanged = true;
 	}
 
-	if (ChanneldUtils::CheckDifference(SceneComp->GetRelativeRotation(), FullState->mutable_relativerotation()))
+	if (TransformDiffMask & 0x0F0)
 	{
 		ChanneldUtils::SetRotatorToPB(DeltaState->mutable_relativerotation(), SceneComp->GetRelativeRotation(), FullState->mutable_relativerotation());
 		bStateChanged = true;
 	}
 
-	if (ChanneldUtils::CheckDifference(SceneComp->GetRelativeScale3D(), FullState->mutable_relativescale()))
+	if (TransformDiffMask & 0xF00)
 	{
 		ChanneldUtils::SetVectorToPB(DeltaState->mutable_relativescale(), SceneComp->GetRelativeScale3D(), FullState->mutable_relativescale());
 		bStateChanged = true;
@@ -154,9 +189,52 @@ void FChanneldSceneComponentReplicator::Tick(float DeltaTime)
 	if (bStateChanged)
 	{
 		FullState->MergeFrom(*DeltaState);
+		if (TransformDiffMask)
+		{
+			UpdateBaseTransform();
+		}
 	}
 }
 
+bool FChanneldSceneComponentReplicator::TickInterpolation(double Time)
+{
+	if (SnapshotBuffer.IsEmpty() || !SceneComp.IsValid())
+	{
+		return false;
+	}
+
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	const double SampleTime = Time - Settings->InterpolationDelayMs * 0.001;
+	const double MaxExtrapolationTime = Settings->MaxExtrapolationMs * 0.001;
+	FVector Location;
+	FRotator Rotation;
+	SnapshotBuffer.Sample(SampleTime, MaxExtrapolationTime, Location, Rotation);
+	SceneComp->SetRelativeLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	return !SnapshotBuffer.IsSettled(SampleTime, MaxExtrapolationTime);
+}
+
+void FChanneldSceneComponentReplicator::ResetBaseline()
+{
+	FChanneldReplicatorBase_AC::ResetBaseline();
+	UpdateBaseTransform();
+	ResetResolvedRefs();
+}
+
+void FChanneldSceneComponentReplicator::ResetResolvedRefs()
+{
+	ResolvedAttachParent.Reset();
+	ReplicatedAttachChildren.Reset();
+	bAttachChildrenResolved = false;
+}
+
+void FChanneldSceneComponentReplicator::UpdateBaseTransform()
+{
+	// The unset fields read as 0, the same as the messages compared before.
+	BaseLocation = FVector(FullState->relativelocation().x(), FullState->relativelocation().y(), FullState->relativelocation().z());
+	BaseRotation = FRotator(FullState->relativerotation().x(), FullState->relativerotation().y(), FullState->relativerotation().z());
+	BaseScale = FVector(FullState->relativescale().x(), FullState->relativescale().y(), FullState->relativescale().z());
+}
+
 void FChanneldSceneComponentReplicator::ClearState()
 {
 	DeltaState->Clear();
@@ -173,18 +251,43 @@ void FChanneldSceneComponentReplicator::OnStateChanged(const google::protobuf::M
 	auto NewState = static_cast<const unrealpb::SceneComponentState*>(InNewState);
 	FullState->MergeFrom(*NewState);
 	bStateChanged = false;
+	ResetResolvedRefs();
+	if (NewState->has_relativelocation() || NewState->has_relativerotation() || NewState->has_relativescale())
+	{
+		UpdateBaseTransform();
+	}
 
-	bool bTransformChanged = false;
-	if (NewState->has_relativelocation())
+	bool bInterpolate = GetMutableDefault<UChanneldSettings>()->InterpolationDelayMs > 0;
+	bool bApplyLocationAndRotation = true;
+	const AActor* Owner = SceneComp->GetOwner();
+	if (bInterpolate && SceneComp.Get() == Owner->GetRootComponent() && Owner->IsReplicatingMovement())
 	{
-		ChanneldUtils::SetVectorFromPB(SceneComp->GetRelativeLocation_DirectMutable(), NewState->relativelocation());
-		bTransformChanged = true;
+		// The character smooths its own movement. The root of the other actors is interpolated by FChanneldActorReplicator.
+		bInterpolate = false;
+		bApplyLocationAndRotation = Owner->IsA<ACharacter>();
 	}
 
-	if (NewState->has_relativerotation())
+	bool bTransformChanged = false;
+	if (bInterpolate)
 	{
-		ChanneldUtils::SetRotatorFromPB(SceneComp->GetRelativeRotation_DirectMutable(), NewState->relativerotation());
-		bTransformChanged = true;
+		if (NewState->has_relativelocation() || NewState->has_relativerotation())
+		{
+			SnapshotBuffer.Add(FPlatformTime::Seconds(), BaseLocation, BaseRotation);
+		}
+	}
+	else if (bApplyLocationAndRotation)
+	{
+		if (NewState->has_relativelocation())
+		{
+			ChanneldUtils::SetVectorFromPB(SceneComp->GetRelativeLocation_DirectMutable(), NewState->relativelocation());
+			bTransformChanged = true;
+		}
+
+		if (NewState->has_relativerotation())
+		{
+			ChanneldUtils::SetRotatorFromPB(SceneComp->GetRelativeRotation_DirectMutable(), NewState->relativerotation());
+			bTransformChanged = true;
+		}
 	}
 
 	if (NewState->has_relativescale())
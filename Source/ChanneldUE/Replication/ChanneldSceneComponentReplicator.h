@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Components/SceneComponent.h"
 #include "ChanneldReplicatorBase.h"
+#include "ChanneldSnapshotBuffer.h"
 #include "unreal_common.pb.h"
 
 class CHANNELDUE_API FChanneldSceneComponentReplicator : public FChanneldReplicatorBase_AC
@@ -14,9 +15,12 @@ public:
 	//~Begin FChanneldReplicatorBase Interface
 	virtual UClass* GetTargetClass() override { return USceneComponent::StaticClass(); }
 	virtual google::protobuf::Message* GetDeltaState() override { return DeltaState; }
+	virtual google::protobuf::Message* GetFullState() override { return FullState; }
 	virtual void ClearState() override;
+	virtual void ResetBaseline() override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void OnStateChanged(const google::protobuf::Message* NewState) override;
+	virtual bool TickInterpolation(double Time) override;
 	//~End FChanneldReplicatorBase Interface
 
 protected:
@@ -26,6 +30,25 @@ protected:
 
 	static EAttachmentRule GetAttachmentRule(bool bShouldSnapWhenAttached, bool bAbsolute);
 
+	// The objects of the ref fields in FullState
+	TChanneldResolvedRef<USceneComponent> ResolvedAttachParent;
+	// The children whose refs are in FullState
+	TArray<TWeakObjectPtr<USceneComponent>> ReplicatedAttachChildren;
+	bool bAttachChildrenResolved = false;
+
+	void ResetResolvedRefs();
+
+	// Copy the relative transform in FullState to the baseline below.
+	void UpdateBaseTransform();
+
+	// The relative transform in FullState, kept in the native types so the component's transform can be compared without reading the messages.
+	FVector BaseLocation = FVector::ZeroVector;
+	FRotator BaseRotation = FRotator::ZeroRotator;
+	FVector BaseScale = FVector::ZeroVector;
+
+	// [Client] The received relative transforms, if the interpolation is enabled.
+	FChanneldTransformSnapshotBuffer SnapshotBuffer;
+
 private:
 	// Pointers to the inaccessible Replicated properties 
 	uint8* bShouldBeAttachedPtr;
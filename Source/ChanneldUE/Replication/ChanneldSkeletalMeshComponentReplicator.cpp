@@ -0,0 +1,155 @@
+#include "ChanneldSkeletalMeshComponentReplicator.h"
+#include "ChanneldUtils.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+
+FChanneldSkeletalMeshComponentReplicator::FChanneldSkeletalMeshComponentReplicator(UObject* InTargetObj) :
+	FChanneldReplicatorBase_AC(InTargetObj)
+{
+	Comp = CastChecked<USkeletalMeshComponent>(InTargetObj);
+	// Remove the registered DOREP() properties in the Actor
+	TArray<FLifetimeProperty> RepProps;
+	DisableAllReplicatedPropertiesOfClass(InTargetObj->GetClass(), GetTargetClass(), EFieldIteratorFlags::ExcludeSuper, RepProps);
+
+	FullState = AcquireState<unrealpb::SkeletalMeshComponentState>();
+	DeltaState = AcquireState<unrealpb::SkeletalMeshComponentState>();
+}
+
+FChanneldSkeletalMeshComponentReplicator::~FChanneldSkeletalMeshComponentReplicator()
+{
+	ReleaseState(FullState);
+	ReleaseState(DeltaState);
+}
+
+void FChanneldSkeletalMeshComponentReplicator::ClearState()
+{
+	DeltaState->Clear();
+	bStateChanged = false;
+}
+
+void FChanneldSkeletalMeshComponentReplicator::Tick(float DeltaTime)
+{
+	if (!Comp.IsValid() || !Comp->GetOwner())
+	{
+		return;
+	}
+
+	const UAnimInstance* AnimInstance = Comp->GetAnimInstance();
+	const FAnimMontageInstance* MontageInstance = AnimInstance ? AnimInstance->GetActiveMontageInstance() : nullptr;
+	if (MontageInstance && MontageInstance->IsStopped())
+	{
+		MontageInstance = nullptr;
+	}
+
+	if (MontageInstance)
+	{
+		const bool bNewMontage = MontageInstance->GetInstanceID() != LastMontageInstanceId;
+		// The baseline is reset or the montage is played: send the whole montage state.
+		if (bNewMontage || !FullState->has_montage())
+		{
+			if (bNewMontage)
+			{
+				LastMontageInstanceId = MontageInstance->GetInstanceID();
+				PlayCount++;
+			}
+			LastSection = MontageInstance->GetCurrentSection();
+			LastPlayRate = MontageInstance->GetPlayRate();
+			unrealpb::AnimMontageState* MontageState = DeltaState->mutable_montage();
+			MontageState->mutable_montage()->CopyFrom(ChanneldUtils::GetAssetRef(MontageInstance->Montage));
+			MontageState->set_playcount(PlayCount);
+			MontageState->set_playrate(LastPlayRate);
+			MontageState->set_position(MontageInstance->GetPosition());
+			MontageState->set_section(TCHAR_TO_UTF8(*LastSection.ToString()));
+			MontageState->set_isstopped(false);
+			bStateChanged = true;
+		}
+		else
+		{
+			if (MontageInstance->GetCurrentSection() != LastSection)
+			{
+				LastSection = MontageInstance->GetCurrentSection();
+				DeltaState->mutable_montage()->set_section(TCHAR_TO_UTF8(*LastSection.ToString()));
+				DeltaState->mutable_montage()->set_position(MontageInstance->GetPosition());
+				bStateChanged = true;
+			}
+			if (!FMath::IsNearlyEqual(MontageInstance->GetPlayRate(), LastPlayRate))
+			{
+				LastPlayRate = MontageInstance->GetPlayRate();
+				DeltaState->mutable_montage()->set_playrate(LastPlayRate);
+				bStateChanged = true;
+			}
+		}
+	}
+	else if (FullState->has_montage() && !FullState->montage().isstopped())
+	{
+		DeltaState->mutable_montage()->set_isstopped(true);
+		bStateChanged = true;
+	}
+
+	if (bStateChanged)
+	{
+		FullState->MergeFrom(*DeltaState);
+	}
+}
+
+void FChanneldSkeletalMeshComponentReplicator::OnStateChanged(const google::protobuf::Message* InNewState)
+{
+	if (!Comp.IsValid() || !Comp->GetOwner())
+	{
+		return;
+	}
+
+	// Only client needs to apply the new state
+	if (Comp->GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	const unrealpb::SkeletalMeshComponentState* NewState = static_cast<const unrealpb::SkeletalMeshComponentState*>(InNewState);
+	FullState->MergeFrom(*NewState);
+	bStateChanged = false;
+
+	UAnimInstance* AnimInstance = Comp->GetAnimInstance();
+	if (!NewState->has_montage() || !AnimInstance)
+	{
+		return;
+	}
+
+	const unrealpb::AnimMontageState& MontageState = FullState->montage();
+	UAnimMontage* Montage = Cast<UAnimMontage>(ChanneldUtils::GetAssetByRef(&MontageState.montage()));
+	if (!Montage)
+	{
+		return;
+	}
+
+	if (MontageState.isstopped())
+	{
+		if (AnimInstance->Montage_IsPlaying(Montage))
+		{
+			AnimInstance->Montage_Stop(Montage->BlendOut.GetBlendTime(), Montage);
+		}
+		return;
+	}
+
+	const unrealpb::AnimMontageState& NewMontageState = NewState->montage();
+	// The whole state is also sent when the baseline of the server is reset, which shouldn't restart the montage that is playing.
+	if (NewMontageState.has_playcount() && (NewMontageState.playcount() != AppliedPlayCount || !AnimInstance->Montage_IsPlaying(Montage)))
+	{
+		AppliedPlayCount = NewMontageState.playcount();
+		AnimInstance->Montage_Play(Montage, MontageState.playrate(), EMontagePlayReturnType::MontageLength, MontageState.position());
+		return;
+	}
+
+	if (NewMontageState.has_section())
+	{
+		AnimInstance->Montage_JumpToSection(FName(UTF8_TO_TCHAR(MontageState.section().c_str())), Montage);
+		if (NewMontageState.has_position())
+		{
+			AnimInstance->Montage_SetPosition(Montage, MontageState.position());
+		}
+	}
+	if (NewMontageState.has_playrate())
+	{
+		AnimInstance->Montage_SetPlayRate(Montage, MontageState.playrate());
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Replication/ChanneldReplicatorBase.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "unreal_components.pb.h"
+
+/**
+ * Replicates the active montage of the anim instance, which is not a replicated property of the engine. Only the play, the section
+ * jump, the play rate change and the stop are sent; the clients play the montage locally in between.
+ */
+class CHANNELDUE_API FChanneldSkeletalMeshComponentReplicator : public FChanneldReplicatorBase_AC
+{
+public:
+	FChanneldSkeletalMeshComponentReplicator(UObject* InTargetObj);
+	virtual ~FChanneldSkeletalMeshComponentReplicator() override;
+
+	//~Begin FChanneldReplicatorBase Interface
+	virtual UClass* GetTargetClass() override { return USkeletalMeshComponent::StaticClass(); }
+	virtual google::protobuf::Message* GetDeltaState() override { return DeltaState; }
+	virtual google::protobuf::Message* GetFullState() override { return FullState; }
+	virtual void ClearState() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual void OnStateChanged(const google::protobuf::Message* NewState) override;
+	//~End FChanneldReplicatorBase Interface
+
+protected:
+	TWeakObjectPtr<USkeletalMeshComponent> Comp;
+
+	// [Server+Client] The accumulated channel data of the target object
+	unrealpb::SkeletalMeshComponentState* FullState;
+	// [Server] The accumulated delta change before next send
+	unrealpb::SkeletalMeshComponentState* DeltaState;
+
+private:
+	// [Server] The last sent montage instance, to tell the replay of the same montage from the one already playing.
+	int32 LastMontageInstanceId = INDEX_NONE;
+	FName LastSection;
+	float LastPlayRate = 0.f;
+	uint32 PlayCount = 0;
+	// [Client] The playCount of the last played montage
+	uint32 AppliedPlayCount = 0;
+};
@@ -0,0 +1,65 @@
+#include "ChanneldSnapshotBuffer.h"
+
+void FChanneldTransformSnapshotBuffer::Add(double Time, const FVector& Location, const FRotator& Rotation)
+{
+	if (Snapshots.Num() >= MaxSnapshots)
+	{
+		Snapshots.RemoveAt(0, 1, false);
+	}
+	// The updates received in the same frame are applied together.
+	if (Snapshots.Num() > 0 && Snapshots.Last().Time >= Time)
+	{
+		Snapshots.Last().Location = Location;
+		Snapshots.Last().Rotation = Rotation;
+		return;
+	}
+	Snapshots.Add(FSnapshot{Time, Location, Rotation});
+}
+
+bool FChanneldTransformSnapshotBuffer::Sample(double Time, double MaxExtrapolationTime, FVector& OutLocation, FRotator& OutRotation)
+{
+	if (Snapshots.Num() == 0)
+	{
+		return false;
+	}
+
+	// Keep the last snapshot before the time to interpolate from, and at least two snapshots to extrapolate with.
+	int32 NumExpired = 0;
+	while (NumExpired + 2 < Snapshots.Num() && Snapshots[NumExpired + 1].Time <= Time)
+	{
+		NumExpired++;
+	}
+	if (NumExpired > 0)
+	{
+		Snapshots.RemoveAt(0, NumExpired, false);
+	}
+
+	const FSnapshot& From = Snapshots[0];
+	if (Snapshots.Num() == 1 || Time <= From.Time)
+	{
+		OutLocation = From.Location;
+		OutRotation = From.Rotation;
+		return true;
+	}
+
+	const FSnapshot& To = Snapshots[1];
+	if (Time <= To.Time)
+	{
+		const float Alpha = (Time - From.Time) / (To.Time - From.Time);
+		OutLocation = FMath::Lerp(From.Location, To.Location, Alpha);
+		OutRotation = FQuat::Slerp(From.Rotation.Quaternion(), To.Rotation.Quaternion(), Alpha).Rotator();
+		return true;
+	}
+
+	// The next update is late. Keep moving at the last velocity for a while, then stop.
+	const double ExtrapolationTime = FMath::Min(Time - To.Time, MaxExtrapolationTime);
+	const FVector Velocity = (To.Location - From.Location) / (To.Time - From.Time);
+	OutLocation = To.Location + Velocity * ExtrapolationTime;
+	OutRotation = To.Rotation;
+	return true;
+}
+
+bool FChanneldTransformSnapshotBuffer::IsSettled(double Time, double MaxExtrapolationTime) const
+{
+	return Snapshots.Num() <= 1 || Time >= Snapshots.Last().Time + MaxExtrapolationTime;
+}
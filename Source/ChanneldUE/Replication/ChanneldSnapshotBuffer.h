@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * [Client] The timestamped transforms received for an object, sampled with a delay (see UChanneldSettings::InterpolationDelayMs),
+ * so the object moves smoothly even if the updates arrive unevenly. The time is the local time when the update is received.
+ */
+struct CHANNELDUE_API FChanneldTransformSnapshotBuffer
+{
+	struct FSnapshot
+	{
+		double Time;
+		FVector Location;
+		FRotator Rotation;
+	};
+
+	static constexpr int32 MaxSnapshots = 16;
+
+	FORCEINLINE bool IsEmpty() const { return Snapshots.Num() == 0; }
+	void Add(double Time, const FVector& Location, const FRotator& Rotation);
+	void Reset() { Snapshots.Reset(); }
+
+	/**
+	 * @brief Interpolate between the snapshots around the time, or extrapolate by the last two snapshots for at most MaxExtrapolationTime seconds.
+	 * The snapshots older than the one before the time are removed.
+	 * @return False if there's no snapshot.
+	 */
+	bool Sample(double Time, double MaxExtrapolationTime, FVector& OutLocation, FRotator& OutRotation);
+
+	// Whether the sampled transform will no longer change after the time, until the next snapshot is added.
+	bool IsSettled(double Time, double MaxExtrapolationTime) const;
+
+private:
+	TArray<FSnapshot, TInlineAllocator<MaxSnapshots>> Snapshots;
+};
@@ -8,8 +8,8 @@ FChanneldStaticMeshComponentReplicator::FChanneldStaticMeshComponentReplicator(U
 	TArray<FLifetimeProperty> RepProps;
 	DisableAllReplicatedPropertiesOfClass(InTargetObj->GetClass(), GetTargetClass(), EFieldIteratorFlags::ExcludeSuper,RepProps);
 
-	FullState = new unrealpb::StaticMeshComponentState;
-	DeltaState = new unrealpb::StaticMeshComponentState;
+	FullState = AcquireState<unrealpb::StaticMeshComponentState>();
+	DeltaState = AcquireState<unrealpb::StaticMeshComponentState>();
 
 	{
 		auto Property = CastFieldChecked<const FObjectProperty>(InTargetObj->GetClass()->FindPropertyByName(FName("StaticMesh")));
@@ -23,8 +23,8 @@ FChanneldStaticMeshComponentReplicator::FChanneldStaticMeshComponentReplicator(U
 
 FChanneldStaticMeshComponentReplicator::~FChanneldStaticMeshComponentReplicator()
 {
-	delete FullState;
-	delete DeltaState;
+	ReleaseState(FullState);
+	ReleaseState(DeltaState);
 }
 
 google::protobuf::Message* FChanneldStaticMeshComponentReplicator::GetDeltaState()
@@ -15,6 +15,7 @@ public:
 	virtual uint32 GetNetGUID() override;
 	virtual UClass* GetTargetClass() override { return UStaticMeshComponent::StaticClass(); }
 	virtual google::protobuf::Message* GetDeltaState() override;
+	virtual google::protobuf::Message* GetFullState() override { return FullState; }
 	virtual void ClearState() override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void OnStateChanged(const google::protobuf::Message* NewState) override;
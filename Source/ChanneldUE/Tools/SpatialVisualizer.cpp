@@ -2,9 +2,12 @@
 
 #include "ChanneldConnection.h"
 #include "ChanneldSettings.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Engine/RendererSettings.h"
+#include "Engine/StaticMesh.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Materials/MaterialInterface.h"
 
 USpatialVisualizer::USpatialVisualizer(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -29,6 +32,11 @@ void USpatialVisualizer::Initialize(UChanneldConnection* Conn)
 void USpatialVisualizer::HandleSpatialRegionsUpdate(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
 {
 	const auto ResultMsg = static_cast<const channeldpb::SpatialRegionsUpdateMessage*>(Msg);
+	TMap<Channeld::ChannelId, channeldpb::SpatialRegion> OldRegions;
+	for (const auto& Region : Regions)
+	{
+		OldRegions.Add(Region.channelid(), Region);
+	}
 	Regions.Empty();
 	uint32 MaxServerIndex = 0;
 	for (auto Region : ResultMsg->regions())
@@ -38,9 +46,29 @@ void USpatialVisualizer::HandleSpatialRegionsUpdate(UChanneldConnection* Conn, C
 		{
 			MaxServerIndex = Region.serverindex();
 		}
+
+		channeldpb::SpatialRegion OldRegion;
+		if (!OldRegions.RemoveAndCopyValue(Region.channelid(), OldRegion) || OldRegion.SerializeAsString() != Region.SerializeAsString())
+		{
+			ChangedRegions.Add(Region.channelid());
+		}
+	}
+	// The removed regions
+	for (auto& Pair : OldRegions)
+	{
+		ChangedRegions.Add(Pair.Key);
 	}
 
 	const uint32 ServerCount = MaxServerIndex + 1;
+	if (static_cast<uint32>(RegionColors.Num()) != ServerCount)
+	{
+		// The colors of all the regions are changed.
+		for (const auto& Region : Regions)
+		{
+			ChangedRegions.Add(Region.channelid());
+		}
+	}
+	RegionColors.Reset();
 	for (uint32 i = 0; i < ServerCount; i++)
 	{
 		RegionColors.Add(FLinearColor::MakeFromHSV8(256 * i / ServerCount, 0x60, 0x80));
@@ -52,6 +80,13 @@ void USpatialVisualizer::HandleSpatialRegionsUpdate(UChanneldConnection* Conn, C
 		ColorsByChId.Add(Region.channelid(), FLinearColor::MakeFromHSV8(256 * Region.serverindex() / ServerCount, 0xcc, 0xff));
 	}
 
+	// The instanced boxes are updated in place.
+	if (bRegionBoxesSpawned && IsInstanced())
+	{
+		SpawnRegionBoxes();
+		return;
+	}
+
 	FTimerHandle Handle;
 	// Wait a couple of seconds for the client travel to finish, otherwise the actors created by the visualizer will be removed.
 	GetWorld()->GetTimerManager().SetTimer(Handle, [&, Conn]()
@@ -68,13 +103,6 @@ void USpatialVisualizer::HandleSpatialRegionsUpdate(UChanneldConnection* Conn, C
 void USpatialVisualizer::SpawnRegionBoxes()
 {
 	const auto Settings = GetMutableDefault<UChanneldSettings>();
-	ensureMsgf(Settings->RegionBoxClass, TEXT("RegionBoxClass is not set!"));
-
-	for (const auto Pair : RegionBoxes)
-	{
-		GetWorld()->DestroyActor(Pair.Value);
-	}
-	RegionBoxes.Empty();
 
 	// Get the default character movement component for finding the floor.
 	UCharacterMovementComponent* CharMove = nullptr;
@@ -99,26 +127,53 @@ void USpatialVisualizer::SpawnRegionBoxes()
 		}
 	}
 	
-	for (auto Region : Regions)
+	if (IsInstanced())
 	{
-		// Swap the Y and Z as UE uses the Z-Up rule but channeld uses the Y-up rule.
-		FVector BoundsMin = FVector(Region.min().x(), Region.min().z(), Region.min().y());
-		FVector BoundsMax = FVector(Region.max().x(), Region.max().z(), Region.max().y());
-		FVector Location = 0.5f * (BoundsMin + BoundsMax);
-		
-		if (Settings->bRegionBoxOnFloor && CharMove)
+		if (!CreateBoxInstances())
+		{
+			return;
+		}
+		for (const auto& Region : Regions)
+		{
+			if (bRegionBoxesSpawned && !ChangedRegions.Contains(Region.channelid()))
+			{
+				continue;
+			}
+			const FVector BoundsMin = FVector(Region.min().x(), Region.min().z(), Region.min().y());
+			const FVector BoundsMax = FVector(Region.max().x(), Region.max().z(), Region.max().y());
+			SetBoxInstance(RegionBoxInstances, RegionBoxIndices, Region.channelid(), GetRegionBoxLocation(Region, CharMove, DefaultFloorLoc),
+				ClampVector(BoundsMax - BoundsMin, Settings->RegionBoxMinSize, Settings->RegionBoxMaxSize), RegionColors[Region.serverindex()]);
+		}
+		for (const Channeld::ChannelId ChId : ChangedRegions)
 		{
-			FFindFloorResult FloorResult;
-			CharMove->FindFloor(FVector(Location.X, Location.Y, CharMove->GetActorLocation().Z), FloorResult, true);
-			if (FloorResult.bBlockingHit)
+			if (!Regions.ContainsByPredicate([ChId](const channeldpb::SpatialRegion& Region) { return Region.channelid() == ChId; }))
 			{
-				Location = FloorResult.HitResult.ImpactPoint;
+				RemoveBoxInstance(RegionBoxInstances, RegionBoxIndices, ChId);
+				RemoveSubBox(ChId);
 			}
-			else if (DefaultFloorLoc != FVector::ZeroVector)
+			else if (SubBoxIndices.Contains(ChId))
 			{
-				Location = FVector(Location.X, Location.Y, DefaultFloorLoc.Z);
+				SpawnSubBox(ChId);
 			}
 		}
+		ChangedRegions.Reset();
+		bRegionBoxesSpawned = true;
+		return;
+	}
+
+	ensureMsgf(Settings->RegionBoxClass, TEXT("RegionBoxClass is not set!"));
+	for (const auto Pair : RegionBoxes)
+	{
+		GetWorld()->DestroyActor(Pair.Value);
+	}
+	RegionBoxes.Empty();
+
+	for (auto Region : Regions)
+	{
+		// Swap the Y and Z as UE uses the Z-Up rule but channeld uses the Y-up rule.
+		FVector BoundsMin = FVector(Region.min().x(), Region.min().z(), Region.min().y());
+		FVector BoundsMax = FVector(Region.max().x(), Region.max().z(), Region.max().y());
+		FVector Location = GetRegionBoxLocation(Region, CharMove, DefaultFloorLoc);
 		
 		ATintActor* Box = CastChecked<ATintActor>(GetWorld()->SpawnActor(Settings->RegionBoxClass, &Location));
 		FVector BoundsSize = ClampVector(BoundsMax - BoundsMin, Settings->RegionBoxMinSize, Settings->RegionBoxMaxSize);
@@ -127,12 +182,140 @@ void USpatialVisualizer::SpawnRegionBoxes()
 		Box->SetColor(RegionColors[Region.serverindex()]);
 		RegionBoxes.Add(Region.channelid(), Box);
 	}
+	ChangedRegions.Reset();
+	bRegionBoxesSpawned = true;
+}
+
+FVector USpatialVisualizer::GetRegionBoxLocation(const channeldpb::SpatialRegion& Region, UCharacterMovementComponent* CharMove, const FVector& DefaultFloorLoc) const
+{
+	// Swap the Y and Z as UE uses the Z-Up rule but channeld uses the Y-up rule.
+	const FVector BoundsMin = FVector(Region.min().x(), Region.min().z(), Region.min().y());
+	const FVector BoundsMax = FVector(Region.max().x(), Region.max().z(), Region.max().y());
+	FVector Location = 0.5f * (BoundsMin + BoundsMax);
+
+	if (GetMutableDefault<UChanneldSettings>()->bRegionBoxOnFloor && CharMove)
+	{
+		FFindFloorResult FloorResult;
+		CharMove->FindFloor(FVector(Location.X, Location.Y, CharMove->GetActorLocation().Z), FloorResult, true);
+		if (FloorResult.bBlockingHit)
+		{
+			Location = FloorResult.HitResult.ImpactPoint;
+		}
+		else if (DefaultFloorLoc != FVector::ZeroVector)
+		{
+			Location = FVector(Location.X, Location.Y, DefaultFloorLoc.Z);
+		}
+	}
+	return Location;
+}
+
+bool USpatialVisualizer::IsInstanced() const
+{
+	return GetMutableDefault<UChanneldSettings>()->bInstancedSpatialVisualizer;
+}
+
+bool USpatialVisualizer::CreateBoxInstances()
+{
+	if (IsValid(BoxInstancesActor))
+	{
+		return true;
+	}
+	// The actor is removed by the travel.
+	RegionBoxIndices.Reset();
+	SubBoxIndices.Reset();
+
+	const auto Settings = GetMutableDefault<UChanneldSettings>();
+	UStaticMesh* Mesh = Settings->InstancedBoxMesh.LoadSynchronous();
+	if (!ensureMsgf(Mesh, TEXT("InstancedBoxMesh is not set!")))
+	{
+		return false;
+	}
+	UMaterialInterface* Material = Settings->InstancedBoxMaterial.LoadSynchronous();
+
+	BoxInstancesActor = GetWorld()->SpawnActor<AActor>();
+	USceneComponent* Root = NewObject<USceneComponent>(BoxInstancesActor, TEXT("Root"));
+	BoxInstancesActor->SetRootComponent(Root);
+	Root->RegisterComponent();
+
+	auto CreateInstances = [&](const TCHAR* Name)
+	{
+		UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(BoxInstancesActor, Name);
+		Instances->SetStaticMesh(Mesh);
+		if (Material)
+		{
+			Instances->SetMaterial(0, Material);
+		}
+		// R, G, B, A
+		Instances->NumCustomDataFloats = 4;
+		Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Instances->SetCastShadow(false);
+		Instances->SetupAttachment(Root);
+		Instances->RegisterComponent();
+		return Instances;
+	};
+	RegionBoxInstances = CreateInstances(TEXT("RegionBoxes"));
+	SubBoxInstances = CreateInstances(TEXT("SubscriptionBoxes"));
+	return true;
+}
+
+void USpatialVisualizer::SetBoxInstance(UInstancedStaticMeshComponent* Instances, TMap<Channeld::ChannelId, int32>& Indices, Channeld::ChannelId ChId, const FVector& Location, const FVector& Size, const FLinearColor& Color)
+{
+	const FVector MeshSize = Instances->GetStaticMesh()->GetBounds().BoxExtent * 2;
+	const FTransform Transform(FRotator::ZeroRotator, Location, Size / MeshSize);
+	int32 Index;
+	if (const int32* ExistingIndex = Indices.Find(ChId))
+	{
+		Index = *ExistingIndex;
+		Instances->UpdateInstanceTransform(Index, Transform, true, false);
+	}
+	else
+	{
+		Index = Instances->AddInstance(Transform);
+		Indices.Add(ChId, Index);
+	}
+	Instances->SetCustomData(Index, {Color.R, Color.G, Color.B, Color.A}, true);
+}
+
+void USpatialVisualizer::RemoveBoxInstance(UInstancedStaticMeshComponent* Instances, TMap<Channeld::ChannelId, int32>& Indices, Channeld::ChannelId ChId)
+{
+	int32 Index;
+	if (!Indices.RemoveAndCopyValue(ChId, Index))
+	{
+		return;
+	}
+	Instances->RemoveInstance(Index);
+	// The instances after the removed one are shifted down.
+	for (auto& Pair : Indices)
+	{
+		if (Pair.Value > Index)
+		{
+			Pair.Value--;
+		}
+	}
+}
+
+void USpatialVisualizer::RemoveSubBox(Channeld::ChannelId ChId)
+{
+	if (IsInstanced())
+	{
+		if (IsValid(SubBoxInstances))
+		{
+			RemoveBoxInstance(SubBoxInstances, SubBoxIndices, ChId);
+		}
+		return;
+	}
+
+	ATintActor* SubBox;
+	if (SubBoxes.RemoveAndCopyValue(ChId, SubBox))
+	{
+		GetWorld()->DestroyActor(SubBox);
+	}
 }
 
 void USpatialVisualizer::SpawnSubBox(Channeld::ChannelId ChId)
 {
 	const auto Settings = GetMutableDefault<UChanneldSettings>();
-	if (!Settings->SubscriptionBoxClass)
+	if (!IsInstanced() && !Settings->SubscriptionBoxClass)
 	{
 		return;
 	}
@@ -147,8 +330,18 @@ void USpatialVisualizer::SpawnSubBox(Channeld::ChannelId ChId)
 	FVector BoundsMin = FVector(Region.min().x(), Region.min().z(), Region.min().y());
 	FVector BoundsMax = FVector(Region.max().x(), Region.max().z(), Region.max().y());
 	FVector Location = 0.5f * (BoundsMin + BoundsMax) + Settings->SubscriptionBoxOffset;
-	ATintActor* Box = CastChecked<ATintActor>(GetWorld()->SpawnActor(Settings->SubscriptionBoxClass, &Location));
 	FVector BoundsSize = ClampVector(BoundsMax - BoundsMin, Settings->SubscriptionBoxMinSize, Settings->SubscriptionBoxMaxSize);
+	if (IsInstanced())
+	{
+		if (CreateBoxInstances())
+		{
+			SetBoxInstance(SubBoxInstances, SubBoxIndices, ChId, Location, BoundsSize, RegionColors[Region.serverindex()]);
+		}
+		return;
+	}
+
+	RemoveSubBox(ChId);
+	ATintActor* Box = CastChecked<ATintActor>(GetWorld()->SpawnActor(Settings->SubscriptionBoxClass, &Location));
 	FVector BoxSize = Box->GetRootComponent()->Bounds.BoxExtent * 2;
 	Box->SetActorScale3D(BoundsSize / BoxSize);
 	Box->SetColor(RegionColors[Region.serverindex()]);
@@ -157,20 +350,35 @@ void USpatialVisualizer::SpawnSubBox(Channeld::ChannelId ChId)
 
 void USpatialVisualizer::HandleSubToChannel(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
 {
-	// We should wait the region boxes to be spawned before spawning the subscription box.
-	if (RegionBoxes.Num() == 0)
+	const auto ResultMsg = static_cast<const channeldpb::SubscribedToChannelResultMessage*>(Msg);
+	if (ResultMsg->connid() != Conn->GetConnId())
 	{
 		return;
 	}
 
-	// Subscription box already exists.
-	if (SubBoxes.Contains(ChId))
+	// The re-subscriptions with the updated options don't change the interest.
+	bool bAlreadySubscribed = true;
+	if (ResultMsg->channeltype() == channeldpb::SPATIAL)
+	{
+		SubscribedSpatialChannels.Add(ChId, &bAlreadySubscribed);
+	}
+	else if (ResultMsg->channeltype() == channeldpb::ENTITY)
+	{
+		SubscribedEntityChannels.Add(ChId, &bAlreadySubscribed);
+	}
+	if (!bAlreadySubscribed)
+	{
+		OnInterestChanged(Conn);
+	}
+
+	// We should wait the region boxes to be spawned before spawning the subscription box.
+	if (!bRegionBoxesSpawned)
 	{
 		return;
 	}
-	
-	const auto ResultMsg = static_cast<const channeldpb::SubscribedToChannelResultMessage*>(Msg);
-	if (ResultMsg->connid() != Conn->GetConnId())
+
+	// Subscription box already exists.
+	if (SubBoxes.Contains(ChId) || SubBoxIndices.Contains(ChId))
 	{
 		return;
 	}
@@ -180,26 +388,58 @@ void USpatialVisualizer::HandleSubToChannel(UChanneldConnection* Conn, Channeld:
 
 void USpatialVisualizer::HandleUnsubFromChannel(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
 {
-	if (RegionBoxes.Num() == 0)
+	const auto ResultMsg = static_cast<const channeldpb::UnsubscribedFromChannelResultMessage*>(Msg);
+	if (ResultMsg->connid() != Conn->GetConnId())
 	{
 		return;
 	}
-	
-	const auto ResultMsg = static_cast<const channeldpb::UnsubscribedFromChannelResultMessage*>(Msg);
-	if (ResultMsg->connid() != Conn->GetConnId())
+
+	if (SubscribedSpatialChannels.Remove(ChId) > 0 || SubscribedEntityChannels.Remove(ChId) > 0)
+	{
+		OnInterestChanged(Conn);
+	}
+
+	if (!bRegionBoxesSpawned)
 	{
 		return;
 	}
 
-	ATintActor* SubBox;
-	if (SubBoxes.RemoveAndCopyValue(ChId, SubBox))
+	RemoveSubBox(ChId);
+}
+
+void USpatialVisualizer::OnInterestChanged(UChanneldConnection* Conn)
+{
+	if (!InterestMetrics.IsValid())
 	{
-		GetWorld()->DestroyActor(SubBox);
+		InterestMetrics = GEngine->GetEngineSubsystem<UChanneldMetrics>()->AddInterestMetrics(Conn->GetConnId());
+	}
+
+	if (GFrameCounter != LastInterestChangeFrame)
+	{
+		if (LastInterestChangeFrame > 0)
+		{
+			InterestMetrics.SpawnsPerChange->Observe(NumSpawnsSinceChange);
+			NumLastChangeSpawns = NumSpawnsSinceChange;
+		}
+		NumSpawnsSinceChange = 0;
+		LastInterestChangeFrame = GFrameCounter;
+	}
+	InterestMetrics.SpatialChannels->Set(SubscribedSpatialChannels.Num());
+	InterestMetrics.EntityChannels->Set(SubscribedEntityChannels.Num());
+	InterestMetrics.Churn->Increment();
+
+	if (GEngine)
+	{
+		GEngine->AddOnScreenDebugMessage(static_cast<uint64>(GetUniqueID()), 10.f, FColor::Cyan, FString::Printf(
+			TEXT("Interest: %d spatial channels, %d entity channels, %d changes, %d spawns of the last change"),
+			SubscribedSpatialChannels.Num(), SubscribedEntityChannels.Num(), static_cast<int32>(InterestMetrics.Churn->Value()), NumLastChangeSpawns));
 	}
 }
 
 void USpatialVisualizer::OnSpawnedObject(UObject* Obj, Channeld::ChannelId ChId)
 {
+	NumSpawnsSinceChange++;
+
 	if (Outliners.Contains(Obj))
 	{
 		return;
@@ -224,6 +464,7 @@ void USpatialVisualizer::OnSpawnedObject(UObject* Obj, Channeld::ChannelId ChId)
 		Outliner->SetFollowTarget(Actor);
 		Outliner->SetOutlineColor(ChId, GetColorByChannelId(ChId));
 		Outliners.Add(Obj, Outliner);
+		OutlinedChannels.Add(Obj, ChId);
 		
 		UE_LOG(LogChanneld, Log, TEXT("Created spatial outliner for %s, size: %s"), *Actor->GetName(), *Actor->GetActorRelativeScale3D().ToCompactString());
 	}
@@ -234,10 +475,57 @@ void USpatialVisualizer::OnUpdateOwningChannel(UObject* Obj, Channeld::ChannelId
 	AOutlinerActor* Outliner = Outliners.FindRef(Obj);
 	if (Outliner)
 	{
+		// The mapping is set again by each spawn or handover, which doesn't always change the channel.
+		Channeld::ChannelId& OutlinedChId = OutlinedChannels.FindOrAdd(Obj);
+		if (OutlinedChId == NewChId)
+		{
+			return;
+		}
+		OutlinedChId = NewChId;
 		Outliner->SetOutlineColor(NewChId, GetColorByChannelId(NewChId));
 	}
 }
 
+void USpatialVisualizer::ShowReplicationCosts(const TMap<Channeld::ChannelId, FChannelReplicationCost>& ChannelCosts, const TMap<FName, double>& ClassCollectSeconds)
+{
+	if (!GEngine)
+	{
+		return;
+	}
+
+	constexpr int32 MaxShownEntries = 5;
+	const float Interval = GetMutableDefault<UChanneldSettings>()->ReplicationProfileInterval;
+
+	TArray<TPair<Channeld::ChannelId, const FChannelReplicationCost*>> SpatialCosts;
+	for (auto& Pair : ChannelCosts)
+	{
+		if (ColorsByChId.Contains(Pair.Key))
+		{
+			SpatialCosts.Emplace(Pair.Key, &Pair.Value);
+		}
+	}
+	SpatialCosts.Sort([](const auto& A, const auto& B) { return A.Value->GetTotalSeconds() > B.Value->GetTotalSeconds(); });
+
+	FString Text = TEXT("Replication cost per second:");
+	for (int32 i = 0; i < FMath::Min(SpatialCosts.Num(), MaxShownEntries); i++)
+	{
+		const FChannelReplicationCost& Cost = *SpatialCosts[i].Value;
+		Text += FString::Printf(TEXT("\n  Channel %d: %.2f ms (collect %.2f, merge %.2f, consume %.2f), sent %.1f KB, received %.1f KB"),
+			SpatialCosts[i].Key, Cost.GetTotalSeconds() * 1000.0 / Interval, Cost.CollectSeconds * 1000.0 / Interval, Cost.MergeSeconds * 1000.0 / Interval,
+			Cost.ConsumeSeconds * 1000.0 / Interval, Cost.SentBytes / 1024.0 / Interval, Cost.ReceivedBytes / 1024.0 / Interval);
+	}
+
+	TArray<TPair<FName, double>> ClassCosts = ClassCollectSeconds.Array();
+	ClassCosts.Sort([](const auto& A, const auto& B) { return A.Value > B.Value; });
+	for (int32 i = 0; i < FMath::Min(ClassCosts.Num(), MaxShownEntries); i++)
+	{
+		Text += FString::Printf(TEXT("\n  %s: collect %.2f ms"), *ClassCosts[i].Key.ToString(), ClassCosts[i].Value * 1000.0 / Interval);
+	}
+
+	// Keyed next to the interest stats, and replaced by the next report.
+	GEngine->AddOnScreenDebugMessage(static_cast<uint64>(GetUniqueID()) + 1, Interval + 1.f, FColor::Orange, Text);
+}
+
 const FLinearColor& USpatialVisualizer::GetColorByChannelId(Channeld::ChannelId ChId)
 {
 	const FLinearColor* Color = ColorsByChId.Find(ChId);
@@ -4,9 +4,13 @@
 #include "TintActor.h"
 #include "channeld.pb.h"
 #include "ChanneldConnection.h"
+#include "ChanneldMetrics.h"
 #include "OutlinerActor.h"
 #include "SpatialVisualizer.generated.h"
 
+class UCharacterMovementComponent;
+class UInstancedStaticMeshComponent;
+
 UCLASS()
 class USpatialVisualizer : public UObject
 {
@@ -21,11 +25,46 @@ public:
 	void OnSpawnedObject(UObject* Obj, Channeld::ChannelId ChId);
 	void OnUpdateOwningChannel(UObject* Obj, Channeld::ChannelId NewChId);
 	const FLinearColor& GetColorByChannelId(Channeld::ChannelId ChId);
+	// Show the costliest spatial channels and provider classes of the last report interval on screen. See UChanneldSettings::ReplicationProfileInterval.
+	void ShowReplicationCosts(const TMap<Channeld::ChannelId, FChannelReplicationCost>& ChannelCosts, const TMap<FName, double>& ClassCollectSeconds);
 
 private:
 
 	void SpawnRegionBoxes();
 	void SpawnSubBox(Channeld::ChannelId ChId);
+	void RemoveSubBox(Channeld::ChannelId ChId);
+	// Returns the location of the region box, on the floor if UChanneldSettings::bRegionBoxOnFloor is set.
+	FVector GetRegionBoxLocation(const channeldpb::SpatialRegion& Region, UCharacterMovementComponent* CharMove, const FVector& DefaultFloorLoc) const;
+
+	// See UChanneldSettings::bInstancedSpatialVisualizer.
+	bool IsInstanced() const;
+	bool CreateBoxInstances();
+	// Add or update the instance of the box of a channel.
+	void SetBoxInstance(UInstancedStaticMeshComponent* Instances, TMap<Channeld::ChannelId, int32>& Indices, Channeld::ChannelId ChId, const FVector& Location, const FVector& Size, const FLinearColor& Color);
+	void RemoveBoxInstance(UInstancedStaticMeshComponent* Instances, TMap<Channeld::ChannelId, int32>& Indices, Channeld::ChannelId ChId);
+	UPROPERTY()
+	AActor* BoxInstancesActor = nullptr;
+	UPROPERTY()
+	UInstancedStaticMeshComponent* RegionBoxInstances = nullptr;
+	UPROPERTY()
+	UInstancedStaticMeshComponent* SubBoxInstances = nullptr;
+	TMap<Channeld::ChannelId, int32> RegionBoxIndices;
+	TMap<Channeld::ChannelId, int32> SubBoxIndices;
+	// The regions that have been changed since the boxes were updated. Only used by the instanced boxes.
+	TSet<Channeld::ChannelId> ChangedRegions;
+	bool bRegionBoxesSpawned = false;
+	// The owning channel of each outlined object, to skip the updates that don't change the channel.
+	TMap<TWeakObjectPtr<UObject>, Channeld::ChannelId> OutlinedChannels;
+	// Update the interest metrics and the on-screen stats when the subscriptions of the client have changed.
+	void OnInterestChanged(UChanneldConnection* Conn);
+
+	TSet<Channeld::ChannelId> SubscribedSpatialChannels;
+	TSet<Channeld::ChannelId> SubscribedEntityChannels;
+	FChanneldInterestMetrics InterestMetrics;
+	// The entities spawned since the last interest change. The changes in the same frame are counted as one.
+	int32 NumSpawnsSinceChange = 0;
+	int32 NumLastChangeSpawns = 0;
+	uint64 LastInterestChangeFrame = 0;
 
 	TArray<channeldpb::SpatialRegion> Regions;
 	UPROPERTY()
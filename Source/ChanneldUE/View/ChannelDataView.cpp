@@ -9,6 +9,11 @@
 #include "GameFramework/PlayerState.h"
 #include "Replication/ChanneldReplication.h"
 #include "Replication/ChanneldReplicationComponent.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopeExit.h"
+#include "google/protobuf/io/coded_stream.h"
+
+TRACE_DECLARE_INT_COUNTER(ChanneldReplicatedProviders, TEXT("Channeld/ReplicatedProviders"));
 
 UChannelDataView::UChannelDataView(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -37,8 +42,14 @@ void UChannelDataView::Initialize(UChanneldConnection* InConn)
 
 		LoadCmdLineArgs();
 
-		Connection->AddMessageHandler(channeldpb::CHANNEL_DATA_UPDATE, this, &UChannelDataView::HandleChannelDataUpdate);
+		Connection->AddMessageHandler(channeldpb::CHANNEL_DATA_UPDATE, this, &UChannelDataView::HandleChannelDataUpdateMessage);
+		Connection->OnIncomingDispatched.AddUObject(this, &UChannelDataView::ConsumeCoalescedChannelUpdates);
 		Connection->AddMessageHandler(channeldpb::UNSUB_FROM_CHANNEL, this, &UChannelDataView::HandleUnsub);
+		// The templates registered before the connection is set.
+		for (auto& Pair : ChannelDataTypeUrls)
+		{
+			Connection->RegisterChannelDataPrototype(Pair.Value, ChannelDataTemplates[Pair.Key]);
+		}
 	}
 
 	const auto Settings = GetMutableDefault<UChanneldSettings>();
@@ -48,18 +59,31 @@ void UChannelDataView::Initialize(UChanneldConnection* InConn)
 		RegisterChannelDataType(Pair.Key, Pair.Value);
 	}
 
+	if (bSingleChannel)
+	{
+		BindGlobalChannelDataType();
+	}
+
+	if (Settings->ReplicationProfileInterval > 0)
+	{
+		bProfileReplication = true;
+		GetWorld()->GetTimerManager().SetTimer(ReplicationProfileTimer, this, &UChannelDataView::ReportReplicationCosts, Settings->ReplicationProfileInterval, true);
+	}
+
+	if (Settings->ReceivedUpdateDataBudgetBytes > 0)
+	{
+		GetWorld()->GetTimerManager().SetTimer(ReceivedUpdateDataTrimTimer, this, &UChannelDataView::TrimReceivedUpdateData, Settings->ReceivedUpdateDataTrimInterval, true);
+	}
+
+	if (Settings->OwningChannelRetentionSeconds > 0)
+	{
+		GetWorld()->GetTimerManager().SetTimer(OwningChannelCompactTimer, this, &UChannelDataView::CompactOwningChannels, Settings->OwningChannelRetentionSeconds, true);
+	}
+
+	// DelayViewInitInSeconds is already applied by the caller (see UChanneldGameInstanceSubsystem::InitChannelDataView()).
 	if (Connection->IsServer())
 	{
-		const float InitDelay = Settings->DelayViewInitInSeconds;
-		if (InitDelay > 0)
-		{
-			FTimerHandle Handle;
-			GetWorld()->GetTimerManager().SetTimer(Handle, [&](){InitServer();}, 1, false, InitDelay);
-		}
-		else
-		{
-			InitServer();
-		}
+		InitServer();
 	}
 	else if (Connection->IsClient())
 	{
@@ -114,6 +138,28 @@ void UChannelDataView::Unintialize()
 	if (Connection != nullptr)
 	{
 		Connection->RemoveMessageHandler(channeldpb::CHANNEL_DATA_UPDATE, this);
+		Connection->UnregisterChannelDataPrototypes();
+		Connection->OnIncomingDispatched.RemoveAll(this);
+		CoalescedUpdateChannels.Empty();
+		ConnsWaitingForOwningChannel.Empty();
+		FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+		bBufferingForTravel = false;
+		TravelBufferedChannels.Empty();
+		if (bProfileReplication)
+		{
+			if (UWorld* World = GetWorld())
+			{
+				World->GetTimerManager().ClearTimer(ReplicationProfileTimer);
+			}
+			bProfileReplication = false;
+			ChannelReplicationCosts.Empty();
+			ProviderClassCollectSeconds.Empty();
+		}
+		if (UWorld* World = GetWorld())
+		{
+			World->GetTimerManager().ClearTimer(ReceivedUpdateDataTrimTimer);
+			World->GetTimerManager().ClearTimer(OwningChannelCompactTimer);
+		}
 	}
 	else
 	{
@@ -164,21 +210,90 @@ void UChannelDataView::BeginDestroy()
 	// }
 	ReceivedUpdateDataInChannels.Empty();
 
-	for (auto Itr = RemovedProvidersData.CreateIterator(); Itr; ++Itr)
+	for (auto& Pair : PendingUpdateDataInChannels)
 	{
-		delete Itr.Value();
+		delete Pair.Value;
 	}
-	// for (auto& Pair : RemovedProvidersData)
-	// {
-	// 	delete Pair.Value;
-	// }
+	PendingUpdateDataInChannels.Empty();
+
+	for (auto& Pair : HeldUpdateDataInChannels)
+	{
+		delete Pair.Value;
+	}
+	HeldUpdateDataInChannels.Empty();
+	HoldingUpdatesNetGUIDs.Empty();
+
+	// Allocated in the frame arena.
 	RemovedProvidersData.Empty();
+	FrameArena.Reset();
 	
 	ChannelDataProviders.Empty();
+	ProviderIndices.Empty();
+	GlobalProviders.Empty();
+	ConsumingGlobalProviders.Empty();
+	ProviderSchedules.Empty();
 
 	Super::BeginDestroy();
 }
 
+bool UChannelDataView::FChannelProviders::Add(IChannelDataProvider* Provider)
+{
+	if (const int32* Slot = Slots.Find(Provider))
+	{
+		FEntry& Entry = Entries[*Slot];
+		if (Entry.Provider.Get() == Provider)
+		{
+			return false;
+		}
+		// The slot of a destroyed provider that is not cleaned up yet, and the new provider is allocated at the same address.
+		Entry.Provider = FProviderInternal(Provider);
+		Entry.bSleeping = false;
+		return true;
+	}
+	Slots.Add(Provider, Entries.Num());
+	Entries.Add(FEntry{FProviderInternal(Provider), Provider, false});
+	return true;
+}
+
+bool UChannelDataView::FChannelProviders::Remove(const IChannelDataProvider* Provider)
+{
+	const int32 Slot = Find(Provider);
+	if (Slot == INDEX_NONE)
+	{
+		return false;
+	}
+	RemoveAt(Slot);
+	return true;
+}
+
+void UChannelDataView::FChannelProviders::RemoveAt(int32 Slot)
+{
+	Slots.Remove(Entries[Slot].RawProvider);
+	Entries.RemoveAtSwap(Slot, 1, false);
+	if (Slot < Entries.Num())
+	{
+		Slots.FindChecked(Entries[Slot].RawProvider) = Slot;
+	}
+}
+
+void UChannelDataView::FChannelProviders::SetSleeping(const IChannelDataProvider* Provider, bool bSleeping)
+{
+	const int32 Slot = Find(Provider);
+	if (Slot != INDEX_NONE)
+	{
+		Entries[Slot].bSleeping = bSleeping;
+	}
+}
+
+void UChannelDataView::FChannelProviders::GetProviders(TArray<FProviderInternal>& OutProviders) const
+{
+	OutProviders.Reserve(OutProviders.Num() + Entries.Num());
+	for (const FEntry& Entry : Entries)
+	{
+		OutProviders.Add(Entry.Provider);
+	}
+}
+
 void UChannelDataView::AddProvider(Channeld::ChannelId ChId, IChannelDataProvider* Provider)
 {
 	/*
@@ -192,30 +307,73 @@ void UChannelDataView::AddProvider(Channeld::ChannelId ChId, IChannelDataProvide
 	// Make sure provider is not set as removed when adding to a channel.
 	Provider->SetRemoved(false);
 
-	TSet<FProviderInternal>& Providers = ChannelDataProviders.FindOrAdd(ChId);
-	if (Providers.Contains(Provider))
+	FChannelProviders& Providers = ChannelDataProviders.FindOrAdd(ChId);
+	if (!Providers.Add(Provider))
 	{
 		UE_LOG(LogChanneld, Verbose, TEXT("Channel data provider already exists in channel %d: %s"), ChId, *IChannelDataProvider::GetName(Provider));
 		return;
 	}
 	
-	Providers.Add(Provider);
-	ChannelDataProviders[ChId] = Providers;
+	MarkProviderIndexDirty(ChId);
+	if (FProviderSchedule* Schedule = ProviderSchedules.Find(ChId))
+	{
+		ScheduleProvider(*Schedule, Provider, FPlatformTime::Seconds(), 0);
+	}
 	UE_LOG(LogChanneld, Verbose, TEXT("Added channel data provider %s to channel %d"), *IChannelDataProvider::GetName(Provider), ChId);
 	
 	Provider->OnAddedToChannel(ChId);
 
-	if (auto SavedUpdates = UnprocessedUpdateDataInChannels.Find(ChId))
+	if (google::protobuf::Message* PendingData = PendingUpdateDataInChannels.FindRef(ChId))
 	{
-		UE_LOG(LogChanneld, Verbose, TEXT("Consuming %d saved ChannelDataUpdate(s) in channel %d"), SavedUpdates->Num(), ChId);
+		UE_LOG(LogChanneld, Verbose, TEXT("Replaying the pending ChannelDataUpdate in channel %d to %s"), ChId, *IChannelDataProvider::GetName(Provider));
+		Provider->OnChannelDataUpdated(PendingData);
+	}
 
-		for (auto Itr = SavedUpdates->CreateIterator(); Itr; ++Itr)
+	if (HoldingUpdatesNetGUIDs.Num() > 0)
+	{
+		TArray<uint32> ProviderNetGUIDs;
+		if (!Provider->GetNetGUIDs(ProviderNetGUIDs))
 		{
-			auto UpdateData = *Itr;
-			Provider->OnChannelDataUpdated(UpdateData);
-			Itr.RemoveCurrent();
-			delete UpdateData;
+			ProviderNetGUIDs.Add(GetNetId(Provider).Value);
+		}
+		bool bHeld = false;
+		for (const uint32 NetGUID : ProviderNetGUIDs)
+		{
+			bHeld |= HoldingUpdatesNetGUIDs.Remove(NetGUID) > 0;
+		}
+		if (bHeld)
+		{
+			if (google::protobuf::Message* HeldData = HeldUpdateDataInChannels.FindRef(ChId))
+			{
+				UE_LOG(LogChanneld, Verbose, TEXT("Replaying the held ChannelDataUpdate in channel %d to %s"), ChId, *IChannelDataProvider::GetName(Provider));
+				Provider->OnChannelDataUpdated(HeldData);
+			}
+			if (HoldingUpdatesNetGUIDs.Num() == 0)
+			{
+				for (auto& Pair : HeldUpdateDataInChannels)
+				{
+					delete Pair.Value;
+				}
+				HeldUpdateDataInChannels.Empty();
+			}
+		}
+	}
+}
+
+void UChannelDataView::HoldUpdatesUntilSpawned(const FNetworkGUID NetId)
+{
+	HoldingUpdatesNetGUIDs.Add(NetId.Value);
+}
+
+void UChannelDataView::StopHoldingUpdates(const FNetworkGUID NetId)
+{
+	if (HoldingUpdatesNetGUIDs.Remove(NetId.Value) > 0 && HoldingUpdatesNetGUIDs.Num() == 0)
+	{
+		for (auto& Pair : HeldUpdateDataInChannels)
+		{
+			delete Pair.Value;
 		}
+		HeldUpdateDataInChannels.Empty();
 	}
 }
 
@@ -329,11 +487,18 @@ void UChannelDataView::RemoveProvider(Channeld::ChannelId ChId, IChannelDataProv
 	
 	Provider->SetRemoved(true);
 	
-	TSet<FProviderInternal>* Providers = ChannelDataProviders.Find(ChId);
+	FChannelProviders* Providers = ChannelDataProviders.Find(ChId);
 	if (Providers != nullptr)
 	{
 		UE_LOG(LogChanneld, Verbose, TEXT("Removing channel data provider %s from channel %d"), *IChannelDataProvider::GetName(Provider), ChId);
 
+		// The removed provider is cleaned up in SendChannelUpdate(), so it shouldn't be skipped or delayed.
+		Providers->SetSleeping(Provider, false);
+		if (FProviderSchedule* Schedule = ProviderSchedules.Find(ChId))
+		{
+			ScheduleProvider(*Schedule, Provider, 0, 0);
+		}
+
 		const auto ChannelInfo = Connection->SubscribedChannels.Find(ChId);
 
 		// Don't send removal update to the spatial or entity channel
@@ -347,10 +512,11 @@ void UChannelDataView::RemoveProvider(Channeld::ChannelId ChId, IChannelDataProv
 				if (!ensureMsgf(MsgTemplate, TEXT("Can't find channel data message template of channel type: %s"), *UEnum::GetValueAsString(ChannelInfo->ChannelType)))
 				{
 					Providers->Remove(Provider);
+					MarkProviderIndexDirty(ChId);
 					Provider->OnRemovedFromChannel(ChId);
 					return;
 				}
-				RemovedData = MsgTemplate->New();
+				RemovedData = MsgTemplate->New(GetFrameArena());
 				RemovedProvidersData.Add(ChId, RemovedData);
 			}
 			Provider->UpdateChannelData(RemovedData);
@@ -358,6 +524,7 @@ void UChannelDataView::RemoveProvider(Channeld::ChannelId ChId, IChannelDataProv
 		else
 		{
 			Providers->Remove(Provider);
+			MarkProviderIndexDirty(ChId);
 			Provider->OnRemovedFromChannel(ChId);
 		}
 	}
@@ -459,18 +626,112 @@ void UChannelDataView::OnClientPostLogin(AGameModeBase* GameMode, APlayerControl
 
 void UChannelDataView::SendExistingActorsToNewPlayer(APlayerController* NewPlayer, UChanneldNetConnection* NewPlayerConn)
 {
-	if (auto NetDriver = GetChanneldSubsystem()->GetNetDriver())
+	if (!GetMutableDefault<UChanneldSettings>()->bStreamLateJoinSpawns)
 	{
 		for(TActorIterator<AActor> It(GetWorld(), AActor::StaticClass()); It; ++It)
 		{
 			AActor* Actor = *It;
-		
-			if (!Actor->IsA<AGameModeBase>() && Actor != NewPlayer && Actor != NewPlayer->PlayerState)
+			if (ShouldSendExistingActorToNewPlayer(Actor, NewPlayer))
+			{
+				SendExistingActorToNewPlayer(Actor, NewPlayer, NewPlayerConn);
+			}
+		}
+		return;
+	}
+
+	const FVector StartLocation = NewPlayer->GetPawn() ? NewPlayer->GetPawn()->GetActorLocation() : NewPlayer->GetSpawnLocation();
+	TArray<TPair<float, AActor*>> Actors;
+	for(TActorIterator<AActor> It(GetWorld(), AActor::StaticClass()); It; ++It)
+	{
+		AActor* Actor = *It;
+		if (ShouldSendExistingActorToNewPlayer(Actor, NewPlayer))
+		{
+			// The actors without a location, e.g. GameState and the managers, go first.
+			const float DistSquared = Actor->GetRootComponent() ? FVector::DistSquared(Actor->GetActorLocation(), StartLocation) : -1.0f;
+			Actors.Emplace(DistSquared, Actor);
+		}
+	}
+	Actors.Sort([](const TPair<float, AActor*>& A, const TPair<float, AActor*>& B) { return A.Key < B.Key; });
+
+	NewPlayerConn->LateJoinSpawnQueue.Reset(Actors.Num());
+	NewPlayerConn->LateJoinSpawnIndex = 0;
+	for (const auto& Pair : Actors)
+	{
+		NewPlayerConn->LateJoinSpawnQueue.Add(Pair.Value);
+	}
+	LateJoinConnections.AddUnique(NewPlayerConn);
+	UE_LOG(LogChanneld, Log, TEXT("Streaming %d existing actors to the new player of conn %d"), Actors.Num(), NewPlayerConn->GetConnId());
+
+	TickLateJoinSpawns();
+}
+
+bool UChannelDataView::ShouldSendExistingActorToNewPlayer(AActor* Actor, APlayerController* NewPlayer)
+{
+	return !Actor->IsA<AGameModeBase>() && Actor != NewPlayer && Actor != NewPlayer->PlayerState;
+}
+
+void UChannelDataView::SendExistingActorToNewPlayer(AActor* Actor, APlayerController* NewPlayer, UChanneldNetConnection* NewPlayerConn)
+{
+	if (auto NetDriver = GetChanneldSubsystem()->GetNetDriver())
+	{
+		NetDriver->OnServerSpawnedActor(Actor);
+	}
+}
+
+void UChannelDataView::OnLateJoinSpawnTimer()
+{
+	bLateJoinTickScheduled = false;
+	TickLateJoinSpawns();
+}
+
+void UChannelDataView::TickLateJoinSpawns()
+{
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	for (auto Itr = LateJoinConnections.CreateIterator(); Itr; ++Itr)
+	{
+		UChanneldNetConnection* NetConn = Itr->Get();
+		APlayerController* NewPlayer = NetConn ? NetConn->PlayerController : nullptr;
+		if (NewPlayer == nullptr)
+		{
+			if (NetConn)
 			{
-				NetDriver->OnServerSpawnedActor(Actor);
+				NetConn->LateJoinSpawnQueue.Empty();
+				NetConn->LateJoinSpawnIndex = 0;
 			}
+			Itr.RemoveCurrent();
+			continue;
+		}
+
+		// The actors spawned via the other paths don't count in the bytes, so the number of spawns is also limited.
+		const uint64 StartBytes = NetConn->GetSentSpawnBytes();
+		int32 SpawnCount = 0;
+		while (NetConn->LateJoinSpawnIndex < NetConn->LateJoinSpawnQueue.Num()
+			&& NetConn->GetSentSpawnBytes() - StartBytes < static_cast<uint64>(Settings->LateJoinSpawnBytesPerTick)
+			&& SpawnCount < Settings->LateJoinMaxSpawnsPerTick)
+		{
+			AActor* Actor = NetConn->LateJoinSpawnQueue[NetConn->LateJoinSpawnIndex++].Get();
+			// The actor can be destroyed, or already sent (e.g. the new player's pawn) since it's queued.
+			if (IsValid(Actor) && ShouldSendExistingActorToNewPlayer(Actor, NewPlayer))
+			{
+				SendExistingActorToNewPlayer(Actor, NewPlayer, NetConn);
+				SpawnCount++;
+			}
+		}
+
+		if (NetConn->LateJoinSpawnIndex >= NetConn->LateJoinSpawnQueue.Num())
+		{
+			UE_LOG(LogChanneld, Log, TEXT("Finished streaming %d existing actors to the new player of conn %d"), NetConn->LateJoinSpawnQueue.Num(), NetConn->GetConnId());
+			NetConn->LateJoinSpawnQueue.Empty();
+			NetConn->LateJoinSpawnIndex = 0;
+			Itr.RemoveCurrent();
 		}
 	}
+
+	if (LateJoinConnections.Num() > 0 && !bLateJoinTickScheduled)
+	{
+		bLateJoinTickScheduled = true;
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UChannelDataView::OnLateJoinSpawnTimer);
+	}
 }
 
 FNetworkGUID UChannelDataView::GetNetId(UObject* Obj, bool bAssignOnServer/* = true*/) const
@@ -517,14 +778,87 @@ void UChannelDataView::SendSpawnToClients(UObject* Obj, uint32 OwningConnId)
 		UE_LOG(LogChanneld, Error, TEXT("UChannelDataView::SendSpawnToClients: Unable to get ChanneldNetDriver"));
 		return;
 	}
-	
+
+	if (!GetMutableDefault<UChanneldSettings>()->bBroadcastSpawnToClients)
+	{
+		for (auto& Pair : NetDriver->GetClientConnectionMap())
+		{
+			if (IsValid(Pair.Value))
+			{
+				SendSpawnToConn(Obj, Pair.Value, OwningConnId);
+			}
+		}
+		return;
+	}
+
+	// Gameplay Debugger is not supported yet.
+	if (Obj->GetClass()->GetFName() == Channeld::GameplayerDebuggerClassName)
+	{
+		return;
+	}
+
+	const FNetworkGUID NetId = NetDriver->GuidCache->GetOrAssignNetGUID(Obj);
+	// Looked up once for all the connections.
+	const int32 SpawnIndex = NetDriver->GetSpawnTrackingIndex(NetId);
+	int32 NumConns = 0;
+	TArray<UChanneldNetConnection*> TargetConns;
 	for (auto& Pair : NetDriver->GetClientConnectionMap())
 	{
 		if (IsValid(Pair.Value))
 		{
-			SendSpawnToConn(Obj, Pair.Value, OwningConnId);
+			NumConns++;
+			if (!Pair.Value->HasSentSpawn(NetId, SpawnIndex))
+			{
+				// The destroy of the object batched in this frame (if any) goes first.
+				Pair.Value->FlushDestroyMessages();
+				TargetConns.Add(Pair.Value);
+			}
+		}
+	}
+
+	const Channeld::ChannelId OwningChId = GetOwningChannelId(NetId);
+	// Without the owning channel, the connections queue the spawn until the mapping is set.
+	if (OwningChId == Channeld::InvalidChannelId || TargetConns.Num() < 2)
+	{
+		for (UChanneldNetConnection* NetConn : TargetConns)
+		{
+			SendSpawnToConn(Obj, NetConn, OwningConnId);
+		}
+		return;
+	}
+
+	// The message is shared by the clients, so export the object with the virtual connection, which has nothing exported.
+	unrealpb::SpawnObjectMessage SpawnMsg;
+	SpawnMsg.mutable_obj()->CopyFrom(*ChanneldUtils::GetRefOfObject(Obj, NetConnForSpawn, true));
+	SpawnMsg.set_channelid(OwningChId);
+	if (const AActor* Actor = Cast<AActor>(Obj))
+	{
+		SpawnMsg.set_localrole(Actor->GetRemoteRole());
+	}
+	// The owner doesn't need its own message, as the clients derive their roles from it. See ChanneldUtils::SetActorRoleByOwningConnId().
+	if (OwningConnId > 0)
+	{
+		SpawnMsg.mutable_obj()->set_owningconnid(OwningConnId);
+	}
+
+	if (TargetConns.Num() == NumConns)
+	{
+		Connection->Broadcast(OwningChId, unrealpb::SPAWN, SpawnMsg, channeldpb::ALL_BUT_SERVER);
+	}
+	else
+	{
+		const std::string Payload = SpawnMsg.SerializeAsString();
+		for (UChanneldNetConnection* NetConn : TargetConns)
+		{
+			NetConn->SendData(unrealpb::SPAWN, reinterpret_cast<const uint8*>(Payload.data()), Payload.size(), OwningChId);
 		}
 	}
+	for (UChanneldNetConnection* NetConn : TargetConns)
+	{
+		NetConn->SetSentSpawned(NetId, SpawnIndex);
+	}
+	UE_LOG(LogChanneld, Verbose, TEXT("[Server] Sent Spawn message to %d/%d conns, obj: %s, netId: %d, owning channel: %d, owningConnId: %d"),
+		TargetConns.Num(), NumConns, *GetNameSafe(Obj), NetId.Value, OwningChId, OwningConnId);
 }
 
 void UChannelDataView::SendDestroyToClients(UObject* Obj, const FNetworkGUID NetId)
@@ -573,19 +907,42 @@ void UChannelDataView::OnDestroyedActor(AActor* Actor, const FNetworkGUID NetId)
 		return;
 
  	Channeld::ChannelId RemovedChId = NetIdOwningChannels.Remove(NetId);
+	RecentOwningChannelNetIds.Remove(NetId);
 	UE_LOG(LogChanneld, Log, TEXT("Removed mapping of netId: %d (%d) -> channelId: %d"), NetId.Value, ChanneldUtils::GetNativeNetId(NetId.Value), RemovedChId);
+	ConnsWaitingForOwningChannel.Remove(NetId);
 
 	RemoveObjectProviderAll(Actor, false);
 }
 
+void UChannelDataView::WaitForOwningChannelId(const FNetworkGUID NetId, UChanneldNetConnection* NetConn)
+{
+	ConnsWaitingForOwningChannel.FindOrAdd(NetId).AddUnique(NetConn);
+}
+
 void UChannelDataView::SetOwningChannelId(const FNetworkGUID NetId, Channeld::ChannelId ChId)
 {
 	if (!NetId.IsValid())
 		return;
 	
 	NetIdOwningChannels.Add(NetId, ChId);
+	if (OwningChannelCompactTimer.IsValid())
+	{
+		RecentOwningChannelNetIds.Add(NetId);
+	}
 	UE_LOG(LogChanneld, Log, TEXT("Set up mapping of netId: %d (%d) -> channelId: %d"), NetId.Value, ChanneldUtils::GetNativeNetId(NetId.Value), ChId);
 
+	TArray<TWeakObjectPtr<UChanneldNetConnection>> WaitingConns;
+	if (ConnsWaitingForOwningChannel.Num() > 0 && ConnsWaitingForOwningChannel.RemoveAndCopyValue(NetId, WaitingConns))
+	{
+		for (auto& NetConn : WaitingConns)
+		{
+			if (NetConn.IsValid())
+			{
+				NetConn->OnOwningChannelIdSet(NetId);
+			}
+		}
+	}
+
 	/*
 	if (Connection->IsServer())
 	{
@@ -605,6 +962,15 @@ void UChannelDataView::SetOwningChannelId(const FNetworkGUID NetId, Channeld::Ch
 	*/
 }
 
+void UChannelDataView::GetNetIdsInUse(TSet<uint32>& OutNetIds) const
+{
+	// The handed over objects are removed from the GuidCache, but the mappings are kept.
+	for (const auto& Pair : NetIdOwningChannels)
+	{
+		OutNetIds.Add(Pair.Key.Value);
+	}
+}
+
 Channeld::ChannelId UChannelDataView::GetOwningChannelId(const FNetworkGUID NetId) const
 {
 	const Channeld::ChannelId* ChId = NetIdOwningChannels.Find(NetId);
@@ -644,13 +1010,10 @@ bool UChannelDataView::SendMulticastRPC(AActor* Actor, const FString& FuncName,
 {
 	unrealpb::RemoteFunctionMessage RpcMsg;
 	RpcMsg.mutable_targetobj()->set_netguid(GetNetId(Actor).Value);
-	RpcMsg.set_functionname(TCHAR_TO_UTF8(*FuncName), FuncName.Len());
+	ChanneldReplication::SetRPCFunctionName(RpcMsg, FuncName);
 	RpcMsg.set_subobjectpath(TCHAR_TO_UTF8(*SubObjectPathName), SubObjectPathName.Len());
-	if (ParamsMsg)
-	{
-		RpcMsg.set_paramspayload(ParamsMsg->SerializeAsString());
-		UE_LOG(LogChanneld, VeryVerbose, TEXT("Serialized RPC parameters to %d bytes"), RpcMsg.paramspayload().size());
-	}
+	// The parameters are encoded straight into the message body as the paramsPayload.
+	constexpr int32 PayloadFieldNumber = unrealpb::RemoteFunctionMessage::kParamsPayloadFieldNumber;
 
 	auto ChId = GetOwningChannelId(Actor);
 	// Does this server owns the channel that owns the actor?
@@ -658,11 +1021,11 @@ bool UChannelDataView::SendMulticastRPC(AActor* Actor, const FString& FuncName,
 	{
 		if (ChannelInfo->ChannelType == EChanneldChannelType::ECT_Global || ChannelInfo->ChannelType == EChanneldChannelType::ECT_SubWorld)
 		{
-			Connection->Broadcast(ChId, unrealpb::RPC, RpcMsg, channeldpb::ALL_BUT_SERVER);
+			Connection->ForwardWithPayload(ChId, unrealpb::RPC, RpcMsg, PayloadFieldNumber, ParamsMsg.Get(), 0, channeldpb::ALL_BUT_SERVER);
 		}
 		else if (ChannelInfo->ChannelType == EChanneldChannelType::ECT_Spatial)
 		{
-			Connection->Broadcast(ChId, unrealpb::RPC, RpcMsg, channeldpb::ADJACENT_CHANNELS | channeldpb::ALL_BUT_SERVER);
+			Connection->ForwardWithPayload(ChId, unrealpb::RPC, RpcMsg, PayloadFieldNumber, ParamsMsg.Get(), 0, channeldpb::ADJACENT_CHANNELS | channeldpb::ALL_BUT_SERVER);
 		}
 		else
 		{
@@ -674,7 +1037,7 @@ bool UChannelDataView::SendMulticastRPC(AActor* Actor, const FString& FuncName,
 	else
 	{
 		// Forward the RPC to the server that owns the channel / actor.
-		Connection->Broadcast(ChId, unrealpb::RPC, RpcMsg, channeldpb::SINGLE_CONNECTION);
+		Connection->ForwardWithPayload(ChId, unrealpb::RPC, RpcMsg, PayloadFieldNumber, ParamsMsg.Get());
 		UE_LOG(LogChanneld, Log, TEXT("Forwarded RPC %s::%s to the owner of channel %d"), *Actor->GetName(), *FuncName, ChId);
 	}
 
@@ -690,14 +1053,17 @@ void UChannelDataView::OnDisconnect()
 {
 	for (auto& Pair : ChannelDataProviders)
 	{
-		for (FProviderInternal& Provider : Pair.Value)
+		for (FChannelProviders::FEntry& Entry : Pair.Value.Entries)
 		{
-			if (Provider.IsValid())
+			if (Entry.Provider.IsValid())
 			{
-				Provider->SetRemoved(true);
+				Entry.Provider->SetRemoved(true);
 			}
+			Entry.bSleeping = false;
 		}
 	}
+	ProviderSchedules.Empty();
+	NextChannelSendTimes.Empty();
 
 	// Force to send the channel update data with the removed states to channeld
 	SendAllChannelUpdates();
@@ -705,6 +1071,7 @@ void UChannelDataView::OnDisconnect()
 
 int32 UChannelDataView::SendChannelUpdate(Channeld::ChannelId ChId)
 {
+	CHANNELD_TRACE_SCOPE(Channeld_SendChannelUpdate);
 	auto ChannelInfo = Connection->SubscribedChannels.Find(ChId);
 	if (ChannelInfo == nullptr)
 	{
@@ -716,7 +1083,7 @@ int32 UChannelDataView::SendChannelUpdate(Channeld::ChannelId ChId)
 		return 0;
 	}
 	
-	TSet<FProviderInternal>* Providers = ChannelDataProviders.Find(ChId);
+	FChannelProviders* Providers = ChannelDataProviders.Find(ChId);
 	if (Providers == nullptr || Providers->Num() == 0)
 	{
 		return 0;
@@ -728,37 +1095,159 @@ int32 UChannelDataView::SendChannelUpdate(Channeld::ChannelId ChId)
 		return 0;
 	}
 
-	auto DeltaChannelData = MsgTemplate->New(&ArenaForSend);
+	auto DeltaChannelData = MsgTemplate->New(GetFrameArena());
+
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	// Skip the idle providers, except for the periodic check. The scheduler backs off the idle providers instead.
+	const bool bTrackIdle = Settings->ProviderIdleUpdates > 0 && !Settings->bScheduledReplication;
+	// Otherwise all the providers are updated in this check, and the ones that are still idle go back to sleep.
+	const bool bSkipSleeping = bTrackIdle && FPlatformTime::Seconds() < NextSleepingProviderCheckTime;
 
+	UChanneldMetrics* Metrics = Connection->GetMetrics();
+	// See UChanneldSettings::NetFrameBudgetMs
+	const bool bTrackOffenders = Metrics->IsTrackingFrameOffenders();
+	const double CollectStartTime = bProfileReplication || bTrackOffenders ? FPlatformTime::Seconds() : 0;
 	int UpdateCount = 0;
 	int RemovedCount = 0;
-	for (auto Itr = Providers->CreateIterator(); Itr; ++Itr)
+	// The thread-safe providers that are updated in parallel after the loop.
+	TArray<IChannelDataProvider*> ParallelProviders;
+	const bool bCollectInParallel = Settings->bParallelProviderCollection && Settings->MinParallelProviderBatch > 0 && Providers->Num() >= Settings->MinParallelProviderBatch * 2;
+	// Set by UpdateProvider() if the provider is updated and idle.
+	bool bUpdatedIdle = false;
+	// Returns false if the provider is removed from the channel.
+	auto UpdateProvider = [&](const FProviderInternal& Provider)
+	{
+		bUpdatedIdle = false;
+		// The clients keep the last state of the dormant providers.
+		if (Provider->IsDormant() && !Provider->IsRemoved())
+		{
+			return true;
+		}
+		if (bCollectInParallel && !Provider->IsRemoved() && Provider->IsThreadSafeUpdate())
+		{
+			ParallelProviders.Add(Provider.Get());
+			return true;
+		}
+		/* Pre-replication logic should be implemented in the replicator.
+		Provider->GetTargetObject()->CallPreReplication();
+		*/
+		// The target object may be gone after the update if the provider is removed.
+		const UObject* ProfiledObj = bProfileReplication || bTrackOffenders ? Provider->GetTargetObject() : nullptr;
+		const double ProviderStartTime = ProfiledObj ? FPlatformTime::Seconds() : 0;
+		if (Provider->UpdateChannelData(DeltaChannelData))
+		{
+			UpdateCount++;
+		}
+		if (ProfiledObj)
+		{
+			const double ProviderSeconds = FPlatformTime::Seconds() - ProviderStartTime;
+			if (bProfileReplication)
+			{
+				ProviderClassCollectSeconds.FindOrAdd(ProfiledObj->GetClass()->GetFName()) += ProviderSeconds;
+			}
+			if (bTrackOffenders)
+			{
+				Metrics->FrameOffenders.ActorClass.Add(ProfiledObj->GetClass()->GetFName(), ProviderSeconds);
+			}
+		}
+		if (Provider->IsRemoved())
+		{
+			return false;
+		}
+		bUpdatedIdle = bTrackIdle && Provider->IsIdle();
+		return true;
+	};
+
+	// The providers updated by the scheduler in this tick.
+	TArray<FProviderInternal> DueProviders;
+	if (Settings->bScheduledReplication)
+	{
+		PopDueProviders(ChId, *Providers, DueProviders);
+		for (const FProviderInternal& Provider : DueProviders)
+		{
+			if (!UpdateProvider(Provider))
+			{
+				Providers->Remove(Provider.Get());
+				RemovedCount++;
+				Provider->OnRemovedFromChannel(ChId);
+			}
+		}
+	}
+	else
 	{
-		auto Provider = Itr.ElementIt->Value;
-		if (Provider.IsValid())
+		// Backwards, so the swap-removal only moves the providers that are already visited.
+		for (int32 i = Providers->Num() - 1; i >= 0; i--)
 		{
-			/* Pre-replication logic should be implemented in the replicator.
-			Provider->GetTargetObject()->CallPreReplication();
-			*/
-			if (Provider->UpdateChannelData(DeltaChannelData))
+			const FChannelProviders::FEntry& Entry = Providers->Entries[i];
+			if (!Entry.Provider.IsValid())
+			{
+				Providers->RemoveAt(i);
+				RemovedCount++;
+				continue;
+			}
+			if (bSkipSleeping && Entry.bSleeping)
 			{
-				UpdateCount++;
+				continue;
 			}
-			if (Provider->IsRemoved())
+			// The entries can be changed by the update.
+			const FProviderInternal Provider = Entry.Provider;
+			const IChannelDataProvider* RawProvider = Entry.RawProvider;
+			const bool bUpdated = UpdateProvider(Provider);
+			const int32 Slot = Providers->Find(RawProvider, i);
+			if (Slot == INDEX_NONE)
 			{
-				Itr.RemoveCurrent();
+				continue;
+			}
+			if (!bUpdated)
+			{
+				Providers->RemoveAt(Slot);
 				RemovedCount++;
 				Provider->OnRemovedFromChannel(ChId);
 			}
+			else if (bTrackIdle)
+			{
+				Providers->Entries[Slot].bSleeping = bUpdatedIdle;
+			}
 		}
-		else
+	}
+
+	if (ParallelProviders.Num() > 0)
+	{
+		UpdateCount += CollectInParallel(ParallelProviders, MsgTemplate, DeltaChannelData);
+		if (bTrackIdle)
 		{
-			Itr.RemoveCurrent();
-			RemovedCount++;
+			for (IChannelDataProvider* Provider : ParallelProviders)
+			{
+				if (Provider->IsIdle())
+				{
+					Providers->SetSleeping(Provider, true);
+				}
+			}
+		}
+	}
+
+	// Schedule the next updates after the parallel collection, as the intervals depend on the results.
+	if (DueProviders.Num() > 0)
+	{
+		RescheduleProviders(ChId, *Providers, DueProviders);
+	}
+
+	if (bProfileReplication || bTrackOffenders)
+	{
+		const double CollectSeconds = FPlatformTime::Seconds() - CollectStartTime;
+		if (bProfileReplication)
+		{
+			GetReplicationCost(ChId).CollectSeconds += CollectSeconds;
+		}
+		if (bTrackOffenders)
+		{
+			Metrics->FrameOffenders.Channel.Add(ChId, CollectSeconds);
 		}
 	}
+
 	if (RemovedCount > 0)
 	{
+		MarkProviderIndexDirty(ChId);
 		UE_LOG(LogChanneld, Log, TEXT("Removed %d channel data provider(s) from channel %d"), RemovedCount, ChId);
 	}
 
@@ -769,25 +1258,296 @@ int32 UChannelDataView::SendChannelUpdate(Channeld::ChannelId ChId)
 		if (RemovedProvidersData.RemoveAndCopyValue(ChId, RemovedData))
 		{
 			DeltaChannelData->MergeFrom(*RemovedData);
-			delete RemovedData;
 		}
 				
-		channeldpb::ChannelDataUpdateMessage UpdateMsg;
-		UpdateMsg.mutable_data()->PackFrom(*DeltaChannelData);
-		Connection->Send(ChId, channeldpb::CHANNEL_DATA_UPDATE, UpdateMsg);
+		std::string Body;
+		EncodeChannelDataUpdate(*DeltaChannelData, ChannelDataTypeUrls.FindChecked(static_cast<int>(ChannelInfo->ChannelType)), Body);
+		SentChannelDataBytes.FindOrAdd(ChId) += Body.size();
+		if (bProfileReplication)
+		{
+			GetReplicationCost(ChId).SentBytes += Body.size();
+		}
+		Metrics->SentChannelUpdateSize_Histogram->Observe(Body.size());
+		if (Metrics->WireSizeSampler.IsEnabled())
+		{
+			Metrics->WireSizeSampler.OnSentUpdate(Body);
+		}
+		Connection->SendRaw(ChId, channeldpb::CHANNEL_DATA_UPDATE, MoveTemp(Body));
 
-		UE_LOG(LogChanneld, Verbose, TEXT("Sent %s update: %s"), UTF8_TO_TCHAR(DeltaChannelData->GetTypeName().c_str()), UTF8_TO_TCHAR(DeltaChannelData->DebugString().c_str()));
+		// The DebugString() of the whole channel data is too costly for Verbose, which may be enabled on a production server.
+		UE_LOG(LogChanneld, Verbose, TEXT("Sent %s update of channel %d, %d providers"), UTF8_TO_TCHAR(DeltaChannelData->GetTypeName().c_str()), ChId, UpdateCount);
+		UE_LOG(LogChanneld, VeryVerbose, TEXT("Sent %s update: %s"), UTF8_TO_TCHAR(DeltaChannelData->GetTypeName().c_str()), UTF8_TO_TCHAR(DeltaChannelData->DebugString().c_str()));
 	}
 
 	return UpdateCount;
 }
 
+google::protobuf::Arena* UChannelDataView::GetFrameArena()
+{
+	if (!FrameArena.IsValid())
+	{
+		google::protobuf::ArenaOptions Options;
+		const int32 StartBlockSize = GetMutableDefault<UChanneldSettings>()->FrameArenaStartBlockSize;
+		if (StartBlockSize > 0)
+		{
+			Options.start_block_size = StartBlockSize;
+			Options.max_block_size = FMath::Max<size_t>(Options.max_block_size, StartBlockSize);
+		}
+		FrameArena = MakeUnique<google::protobuf::Arena>(Options);
+	}
+	return FrameArena.Get();
+}
+
+void UChannelDataView::ResetFrameArena()
+{
+	if (!FrameArena.IsValid())
+	{
+		return;
+	}
+
+	// The removed states collected after their channel is sent in this frame are carried over to the next frame.
+	TArray<TPair<Channeld::ChannelId, TUniquePtr<google::protobuf::Message>>> CarriedOver;
+	for (auto& Pair : RemovedProvidersData)
+	{
+		google::protobuf::Message* Copy = Pair.Value->New();
+		Copy->CopyFrom(*Pair.Value);
+		CarriedOver.Emplace(Pair.Key, TUniquePtr<google::protobuf::Message>(Copy));
+	}
+	RemovedProvidersData.Reset();
+
+	const uint64 SpaceUsed = FrameArena->SpaceUsed();
+	FrameArena->Reset();
+	if (SpaceUsed > FrameArenaHighWater)
+	{
+		FrameArenaHighWater = SpaceUsed;
+		GEngine->GetEngineSubsystem<UChanneldMetrics>()->FrameArenaHighWater_Gauge->Set(SpaceUsed);
+		UE_LOG(LogChanneld, Verbose, TEXT("New high-water mark of the frame arena: %llu bytes"), SpaceUsed);
+	}
+
+	for (auto& Pair : CarriedOver)
+	{
+		google::protobuf::Message* RemovedData = Pair.Value->New(FrameArena.Get());
+		RemovedData->CopyFrom(*Pair.Value);
+		RemovedProvidersData.Add(Pair.Key, RemovedData);
+	}
+}
+
+void UChannelDataView::EncodeChannelDataUpdate(const google::protobuf::Message& Data, const std::string& TypeUrl, std::string& Body)
+{
+	using google::protobuf::io::CodedOutputStream;
+	constexpr uint8 DataTag = (channeldpb::ChannelDataUpdateMessage::kDataFieldNumber << 3) | 2;
+	constexpr uint8 TypeUrlTag = (google::protobuf::Any::kTypeUrlFieldNumber << 3) | 2;
+	constexpr uint8 ValueTag = (google::protobuf::Any::kValueFieldNumber << 3) | 2;
+
+	// Same as PackFrom() + SerializeAsString(): the empty value and the default contextConnId are not written.
+	const uint32 TypeUrlSize = TypeUrl.size();
+	const uint32 ValueSize = Data.ByteSizeLong();
+	const uint32 AnySize = 1 + CodedOutputStream::VarintSize32(TypeUrlSize) + TypeUrlSize
+		+ (ValueSize > 0 ? 1 + CodedOutputStream::VarintSize32(ValueSize) + ValueSize : 0);
+	Body.resize(1 + CodedOutputStream::VarintSize32(AnySize) + AnySize);
+
+	uint8* Ptr = reinterpret_cast<uint8*>(&Body[0]);
+	*Ptr++ = DataTag;
+	Ptr = CodedOutputStream::WriteVarint32ToArray(AnySize, Ptr);
+	*Ptr++ = TypeUrlTag;
+	Ptr = CodedOutputStream::WriteVarint32ToArray(TypeUrlSize, Ptr);
+	FMemory::Memcpy(Ptr, TypeUrl.data(), TypeUrlSize);
+	Ptr += TypeUrlSize;
+	if (ValueSize > 0)
+	{
+		*Ptr++ = ValueTag;
+		Ptr = CodedOutputStream::WriteVarint32ToArray(ValueSize, Ptr);
+		Data.SerializeWithCachedSizesToArray(Ptr);
+	}
+}
+
+int32 UChannelDataView::CollectInParallel(const TArray<IChannelDataProvider*>& InProviders, const google::protobuf::Message* MsgTemplate, google::protobuf::Message* DeltaChannelData)
+{
+	const int32 MinBatch = GetMutableDefault<UChanneldSettings>()->MinParallelProviderBatch;
+	const int32 NumBatches = FMath::Clamp(InProviders.Num() / MinBatch, 1, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+	const int32 BatchSize = FMath::DivideAndRoundUp(InProviders.Num(), NumBatches);
+
+	// Each batch writes into its own message, as the channel data is not thread-safe.
+	// The arena is thread-safe, so the messages and their fields can be allocated from any worker.
+	TArray<google::protobuf::Message*, TInlineAllocator<16>> BatchData;
+	TArray<int32, TInlineAllocator<16>> BatchUpdateCounts;
+	BatchData.SetNum(NumBatches);
+	BatchUpdateCounts.SetNumZeroed(NumBatches);
+	for (int32 i = 0; i < NumBatches; i++)
+	{
+		BatchData[i] = MsgTemplate->New(GetFrameArena());
+	}
+
+	ParallelFor(NumBatches, [&](int32 BatchIndex)
+	{
+		const int32 End = FMath::Min((BatchIndex + 1) * BatchSize, InProviders.Num());
+		for (int32 i = BatchIndex * BatchSize; i < End; i++)
+		{
+			if (InProviders[i]->UpdateChannelData(BatchData[BatchIndex]))
+			{
+				BatchUpdateCounts[BatchIndex]++;
+			}
+		}
+	});
+
+	// Merge in the batch order, so the result doesn't depend on the scheduling of the workers.
+	int32 UpdateCount = 0;
+	for (int32 i = 0; i < NumBatches; i++)
+	{
+		if (BatchUpdateCounts[i] > 0)
+		{
+			DeltaChannelData->MergeFrom(*BatchData[i]);
+			UpdateCount += BatchUpdateCounts[i];
+		}
+	}
+	return UpdateCount;
+}
+
+void UChannelDataView::SetChannelSendInterval(int32 ChId, float Interval)
+{
+	if (Interval < 0)
+	{
+		ChannelSendIntervals.Remove(ChId);
+	}
+	else
+	{
+		ChannelSendIntervals.Add(ChId, Interval);
+	}
+	NextChannelSendTimes.Remove(ChId);
+}
+
+void UChannelDataView::WakeProvider(IChannelDataProvider* Provider)
+{
+	for (auto& Pair : ChannelDataProviders)
+	{
+		Pair.Value.SetSleeping(Provider, false);
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	for (auto& Pair : ProviderSchedules)
+	{
+		const double* DueTime = Pair.Value.DueTimes.Find(Provider);
+		if (DueTime && *DueTime > Now)
+		{
+			ScheduleProvider(Pair.Value, Provider, Now, 0);
+		}
+	}
+}
+
+void UChannelDataView::ScheduleProvider(FProviderSchedule& Schedule, const FProviderInternal& Provider, double DueTime, float Interval)
+{
+	// The previous entry of the provider (if any) becomes stale, and is dropped when popped.
+	Schedule.DueTimes.Add(Provider, DueTime);
+	Schedule.Heap.HeapPush(FScheduledProvider{DueTime, Interval, Provider}, FScheduledProvider::FEarlier());
+}
+
+void UChannelDataView::PopDueProviders(Channeld::ChannelId ChId, const FChannelProviders& Providers, TArray<FProviderInternal>& OutDueProviders)
+{
+	FProviderSchedule& Schedule = ProviderSchedules.FindOrAdd(ChId);
+	const double Now = FPlatformTime::Seconds();
+	// The destroyed providers can't be removed from DueTimes, so start over when there are too many of them.
+	if (Schedule.DueTimes.Num() > Providers.Num() * 2)
+	{
+		Schedule.Heap.Reset();
+		Schedule.DueTimes.Reset();
+	}
+	if (Schedule.DueTimes.Num() == 0)
+	{
+		for (const FChannelProviders::FEntry& Entry : Providers.Entries)
+		{
+			ScheduleProvider(Schedule, Entry.Provider, Now, 0);
+		}
+	}
+
+	TArray<FScheduledProvider> Due;
+	while (Schedule.Heap.Num() > 0 && Schedule.Heap.HeapTop().DueTime <= Now)
+	{
+		FScheduledProvider Entry{0, 0, nullptr};
+		Schedule.Heap.HeapPop(Entry, FScheduledProvider::FEarlier(), false);
+		const double* DueTime = Schedule.DueTimes.Find(Entry.Provider);
+		if (DueTime == nullptr || *DueTime != Entry.DueTime)
+		{
+			continue;
+		}
+		if (!Entry.Provider.IsValid() || !Providers.Contains(Entry.Provider.Get()))
+		{
+			Schedule.DueTimes.Remove(Entry.Provider);
+			continue;
+		}
+		Due.Add(Entry);
+	}
+
+	const int32 MaxUpdates = GetMutableDefault<UChanneldSettings>()->MaxScheduledUpdatesPerTick;
+	if (MaxUpdates > 0 && Due.Num() > MaxUpdates)
+	{
+		// Same as the NetPriority of UE: the longer a provider waits, the higher its priority gets. The removed providers go first.
+		auto GetScore = [Now](const FScheduledProvider& Entry)
+		{
+			return Entry.Provider->IsRemoved() ? MAX_flt : Entry.Provider->GetUpdatePriority() * (Now - Entry.DueTime + Entry.Interval);
+		};
+		Due.Sort([&GetScore](const FScheduledProvider& A, const FScheduledProvider& B) { return GetScore(A) > GetScore(B); });
+		// The deferred providers keep their due time, so they are still due in the next tick.
+		for (int32 i = MaxUpdates; i < Due.Num(); i++)
+		{
+			Schedule.Heap.HeapPush(Due[i], FScheduledProvider::FEarlier());
+		}
+		Due.SetNum(MaxUpdates, false);
+	}
+
+	OutDueProviders.Reserve(Due.Num());
+	for (const FScheduledProvider& Entry : Due)
+	{
+		OutDueProviders.Add(Entry.Provider);
+	}
+}
+
+void UChannelDataView::RescheduleProviders(Channeld::ChannelId ChId, const FChannelProviders& Providers, const TArray<FProviderInternal>& UpdatedProviders)
+{
+	FProviderSchedule& Schedule = ProviderSchedules.FindOrAdd(ChId);
+	const double Now = FPlatformTime::Seconds();
+	for (const FProviderInternal& Provider : UpdatedProviders)
+	{
+		if (Provider.IsValid() && Providers.Contains(Provider.Get()))
+		{
+			if (Provider->IsDormant())
+			{
+				// Keep the provider out of the heap. WakeProvider() schedules it again, as the due time is never reached.
+				Schedule.DueTimes.Add(Provider, MAX_dbl);
+				continue;
+			}
+			const float Interval = Provider->GetUpdateInterval();
+			ScheduleProvider(Schedule, Provider, Now + Interval, Interval);
+		}
+		else
+		{
+			Schedule.DueTimes.Remove(Provider);
+		}
+	}
+}
+
 int32 UChannelDataView::SendAllChannelUpdates()
 {
+	CHANNELD_TRACE_SCOPE(Channeld_SendAllChannelUpdates);
 	if (Connection == nullptr)
 		return 0;
 
+	// Under the send pressure, skip some ticks to lower the update frequency. The replicators compare against the last
+	// sent state, so the changes in the skipped ticks are sent with the next update.
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	const float Pressure = Connection->GetSendPressure();
+	if (Pressure > Settings->ChannelDataThrottlePressure && Settings->ChannelDataThrottlePressure < 1.0f)
+	{
+		const float Ratio = (Pressure - Settings->ChannelDataThrottlePressure) / (1.0f - Settings->ChannelDataThrottlePressure);
+		if (ThrottledTicks < FMath::CeilToInt(Ratio * Settings->MaxChannelDataThrottleTicks))
+		{
+			ThrottledTicks++;
+			return 0;
+		}
+	}
+	ThrottledTicks = 0;
+
 	int32 TotalUpdateCount = 0;
+	const double Now = FPlatformTime::Seconds();
 	for (auto& Pair : Connection->SubscribedChannels)
 	{
 		// Skip sending updates for spatial channels. The channel data is maintained by channeld (by handling the Spawn and Destroy messages)
@@ -795,16 +1555,37 @@ int32 UChannelDataView::SendAllChannelUpdates()
 		{
 			continue;
 		}
+
+		// The providers are not updated until the next send, so the changes keep accumulating in the replicators.
+		const float* Interval = ChannelSendIntervals.Find(Pair.Key);
+		if (Interval == nullptr)
+		{
+			Interval = Settings->ChannelTypeSendIntervals.Find(Pair.Value.ChannelType);
+		}
+		if (Interval && *Interval > 0)
+		{
+			double& NextSendTime = NextChannelSendTimes.FindOrAdd(Pair.Key, 0);
+			if (Now < NextSendTime)
+			{
+				continue;
+			}
+			NextSendTime = Now + *Interval;
+		}
 		
 		TotalUpdateCount += SendChannelUpdate(Pair.Key);
 	}
 
-	ArenaForSend.Reset();
+	if (Now >= NextSleepingProviderCheckTime)
+	{
+		NextSleepingProviderCheckTime = Now + Settings->SleepingProviderCheckInterval;
+	}
+
+	ResetFrameArena();
+	TRACE_COUNTER_SET(ChanneldReplicatedProviders, TotalUpdateCount);
 
 	if (TotalUpdateCount > 0)
 	{
-		UChanneldMetrics* Metrics = GEngine->GetEngineSubsystem<UChanneldMetrics>();
-		Metrics->ReplicatedProviders_Counter->Increment(TotalUpdateCount);
+		Connection->GetMetrics()->ReplicatedProviders_Counter->Increment(TotalUpdateCount);
 	}
 
 	return TotalUpdateCount;
@@ -857,12 +1638,23 @@ void UChannelDataView::HandleUnsub(UChanneldConnection* _, Channeld::ChannelId C
 	// When current connection unsubs from a channel, remove all providers in that channel.
 	if (UnsubMsg->connid() == Connection->GetConnId())
 	{
-		TSet<FProviderInternal> Providers;
+		FChannelProviders Providers;
+		ProviderIndices.Remove(ChId);
+		ChannelDataTypeCaches.Remove(ChId);
+		if (ChId == Channeld::GlobalChannelId)
+		{
+			bGlobalProvidersDirty = true;
+		}
+		ProviderSchedules.Remove(ChId);
+		NextChannelSendTimes.Remove(ChId);
+		DiscardPendingUpdateData(ChId);
+		ReleaseReceivedUpdateData(ChId);
 		if (ChannelDataProviders.RemoveAndCopyValue(ChId, Providers))
 		{
 			UE_LOG(LogChanneld, Log, TEXT("Received Unsub message. Removed all data providers(%d) from channel %d"), Providers.Num(), ChId);
 			OnRemovedProvidersFromChannel(ChId, UnsubMsg->channeltype(), Providers);
 		}
+		OnUnsubscribedFromChannel(ChId, UnsubMsg->channeltype());
 	}
 
 	if (Connection->IsServer())
@@ -885,16 +1677,178 @@ void UChannelDataView::ServerHandleClientUnsub(Channeld::ConnectionId ClientConn
 
 void UChannelDataView::HandleChannelDataUpdate(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
 {
-	auto UpdateMsg = static_cast<const channeldpb::ChannelDataUpdateMessage*>(Msg);
-	
-	FString TypeUrl(UTF8_TO_TCHAR(UpdateMsg->data().type_url().c_str()));
-	auto MsgTemplate = ChannelDataTemplatesByTypeUrl.FindRef(TypeUrl);
-	if (MsgTemplate == nullptr)
+	if (google::protobuf::Message* UpdateData = MergeChannelDataUpdate(ChId, static_cast<const channeldpb::ChannelDataUpdateMessage*>(Msg)))
 	{
-		UE_LOG(LogChanneld, Error, TEXT("Unable to find channel data template by typeUrl: %s"), *TypeUrl);
+		// The coalesced updates of the channel (if any) are consumed together.
+		CoalescedUpdateChannels.Remove(ChId);
+		ConsumeMergedChannelUpdate(ChId, UpdateData);
+	}
+}
+
+void UChannelDataView::HandleChannelDataUpdateMessage(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+{
+	const size_t UpdateSize = static_cast<const channeldpb::ChannelDataUpdateMessage*>(Msg)->data().value().size();
+	UChanneldMetrics* Metrics = Conn->GetMetrics();
+	Metrics->ReceivedChannelUpdateSize_Histogram->Observe(UpdateSize);
+	if (Conn->IsServer() && !Conn->OwnedChannels.Contains(ChId))
+	{
+		Metrics->ServerInterestBytes_Counter->Increment(UpdateSize);
+	}
+
+	if (!GetMutableDefault<UChanneldSettings>()->bCoalesceChannelDataUpdates)
+	{
+		HandleChannelDataUpdate(Conn, ChId, Msg);
 		return;
 	}
 
+	// The processor merges the consecutive updates the same way as it does across ticks, so only the merged result is consumed.
+	if (MergeChannelDataUpdate(ChId, static_cast<const channeldpb::ChannelDataUpdateMessage*>(Msg)))
+	{
+		CoalescedUpdateChannels.AddUnique(ChId);
+	}
+}
+
+void UChannelDataView::ReleaseReceivedUpdateData(Channeld::ChannelId ChId)
+{
+	google::protobuf::Message* UpdateData;
+	if (ReceivedUpdateDataInChannels.RemoveAndCopyValue(ChId, UpdateData))
+	{
+		delete UpdateData;
+	}
+	CoalescedUpdateChannels.Remove(ChId);
+	TravelBufferedChannels.Remove(ChId);
+}
+
+void UChannelDataView::CompactOwningChannels()
+{
+	// A mapping is kept for at least one interval after it's last set, so the RPCs of a handed over object can still be redirected.
+	int32 RemovedNum = 0;
+	for (auto It = NetIdOwningChannels.CreateIterator(); It; ++It)
+	{
+		const FNetworkGUID NetId = It.Key();
+		if (RecentOwningChannelNetIds.Contains(NetId) || IsHandoverPending(NetId) || ConnsWaitingForOwningChannel.Contains(NetId))
+		{
+			continue;
+		}
+		// The mapping of an existing object is removed in OnDestroyedActor().
+		if (GetObjectFromNetGUID(NetId) != nullptr)
+		{
+			continue;
+		}
+		It.RemoveCurrent();
+		RemovedNum++;
+	}
+	RecentOwningChannelNetIds.Reset();
+	UE_CLOG(RemovedNum > 0, LogChanneld, Verbose, TEXT("Removed %d stale NetId to owning channel mappings, %d left"), RemovedNum, NetIdOwningChannels.Num());
+}
+
+void UChannelDataView::TrimReceivedUpdateData()
+{
+	const int64 BudgetBytes = GetMutableDefault<UChanneldSettings>()->ReceivedUpdateDataBudgetBytes;
+	int32 TrimmedNum = 0;
+	int64 TrimmedBytes = 0;
+	for (auto It = ReceivedUpdateDataInChannels.CreateIterator(); It; ++It)
+	{
+		// The message still holds the states to consume.
+		if (CoalescedUpdateChannels.Contains(It.Key()) || TravelBufferedChannels.Contains(It.Key()) || It.Value()->ByteSizeLong() > 0)
+		{
+			continue;
+		}
+		const int64 SpaceUsed = It.Value()->SpaceUsedLong();
+		if (SpaceUsed > BudgetBytes)
+		{
+			// Allocated again from the template by the next update of the channel.
+			delete It.Value();
+			It.RemoveCurrent();
+			TrimmedNum++;
+			TrimmedBytes += SpaceUsed;
+		}
+	}
+	if (TrimmedNum > 0)
+	{
+		UE_LOG(LogChanneld, Verbose, TEXT("Freed the received channel data of %d channel(s) over the budget, %lld bytes in total"), TrimmedNum, TrimmedBytes);
+	}
+}
+
+void UChannelDataView::ConsumeCoalescedChannelUpdates(UChanneldConnection* Conn)
+{
+	if (CoalescedUpdateChannels.Num() == 0)
+	{
+		return;
+	}
+
+	// Consuming can trigger a direct HandleChannelDataUpdate() (e.g. handover), which modifies the array.
+	TArray<Channeld::ChannelId> Channels = MoveTemp(CoalescedUpdateChannels);
+	CoalescedUpdateChannels.Reset();
+	for (const Channeld::ChannelId ChId : Channels)
+	{
+		if (google::protobuf::Message* UpdateData = ReceivedUpdateDataInChannels.FindRef(ChId))
+		{
+			ConsumeMergedChannelUpdate(ChId, UpdateData);
+		}
+	}
+}
+
+void UChannelDataView::BindGlobalChannelDataType()
+{
+	const std::string* TypeUrl = ChannelDataTypeUrls.Find(static_cast<int>(channeldpb::GLOBAL));
+	if (TypeUrl == nullptr)
+	{
+		UE_LOG(LogChanneld, Warning, TEXT("No channel data template is registered for the global channel."));
+		return;
+	}
+	ResolveChannelDataType(Channeld::GlobalChannelId, *TypeUrl);
+	if (GlobalChannelDataType.Processor == nullptr)
+	{
+		UE_LOG(LogChanneld, Log, TEXT("The channel data processor of %s is not registered yet, will be bound at the first update."), UTF8_TO_TCHAR(TypeUrl->c_str()));
+	}
+}
+
+const UChannelDataView::FChannelDataTypeCache* UChannelDataView::ResolveChannelDataType(Channeld::ChannelId ChId, const std::string& TypeUrl)
+{
+	FChannelDataTypeCache& Cache = bSingleChannel && ChId == Channeld::GlobalChannelId ? GlobalChannelDataType : ChannelDataTypeCaches.FindOrAdd(ChId);
+	// The processor can be registered after the first update, so keep resolving until it's found.
+	if (Cache.Template == nullptr || Cache.Processor == nullptr || Cache.TypeUrl != TypeUrl)
+	{
+		Cache.TypeUrl = TypeUrl;
+		Cache.Template = ChannelDataTemplatesByTypeUrl.FindRef(FString(UTF8_TO_TCHAR(TypeUrl.c_str())));
+		Cache.Processor = Cache.Template ? ChanneldReplication::FindChannelDataProcessor(UTF8_TO_TCHAR(Cache.Template->GetTypeName().c_str())) : nullptr;
+	}
+	return Cache.Template ? &Cache : nullptr;
+}
+
+IChannelDataProcessor* UChannelDataView::FindChannelDataProcessor(Channeld::ChannelId ChId, const google::protobuf::Message* ChannelData) const
+{
+	const FChannelDataTypeCache* Cache = bSingleChannel && ChId == Channeld::GlobalChannelId ? &GlobalChannelDataType : ChannelDataTypeCaches.Find(ChId);
+	if (Cache && Cache->Template && Cache->Template->GetDescriptor() == ChannelData->GetDescriptor())
+	{
+		return Cache->Processor;
+	}
+	return ChanneldReplication::FindChannelDataProcessor(UTF8_TO_TCHAR(ChannelData->GetTypeName().c_str()));
+}
+
+google::protobuf::Message* UChannelDataView::MergeChannelDataUpdate(Channeld::ChannelId ChId, const channeldpb::ChannelDataUpdateMessage* UpdateMsg)
+{
+	CHANNELD_TRACE_SCOPE(Channeld_MergeChannelUpdate);
+	const double MergeStartTime = bProfileReplication ? FPlatformTime::Seconds() : 0;
+	ON_SCOPE_EXIT
+	{
+		if (bProfileReplication)
+		{
+			FChannelReplicationCost& Cost = GetReplicationCost(ChId);
+			Cost.MergeSeconds += FPlatformTime::Seconds() - MergeStartTime;
+			Cost.ReceivedBytes += UpdateMsg->data().value().size();
+		}
+	};
+
+	const FChannelDataTypeCache* TypeCache = ResolveChannelDataType(ChId, UpdateMsg->data().type_url());
+	if (TypeCache == nullptr)
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Unable to find channel data template by typeUrl: %s"), UTF8_TO_TCHAR(UpdateMsg->data().type_url().c_str()));
+		return nullptr;
+	}
+	google::protobuf::Message* MsgTemplate = TypeCache->Template;
+
 	google::protobuf::Message* UpdateData;
 	if (ReceivedUpdateDataInChannels.Contains(ChId))
 	{
@@ -906,64 +1860,197 @@ void UChannelDataView::HandleChannelDataUpdate(UChanneldConnection* Conn, Channe
 		ReceivedUpdateDataInChannels.Add(ChId, UpdateData);
 	}
 
-	UE_LOG(LogChanneld, Verbose, TEXT("Received %s channel %d update(%d B): %s"), *GetChanneldSubsystem()->GetChannelTypeNameByChId(ChId), ChId, UpdateMsg->data().value().size(), UTF8_TO_TCHAR(UpdateMsg->DebugString().c_str()));
+	UE_LOG(LogChanneld, Verbose, TEXT("Received %s channel %d update(%d B)"), *GetChanneldSubsystem()->GetChannelTypeNameByChId(ChId), ChId, UpdateMsg->data().value().size());
+	UE_LOG(LogChanneld, VeryVerbose, TEXT("Received channel %d update: %s"), ChId, UTF8_TO_TCHAR(UpdateMsg->DebugString().c_str()));
 
-	const FName MessageName = UTF8_TO_TCHAR(UpdateData->GetTypeName().c_str());
-	auto Processor = ChanneldReplication::FindChannelDataProcessor(MessageName);
-	if (Processor)
+	IChannelDataProcessor* Processor = TypeCache->Processor;
+	google::protobuf::Message* UnpackedData = Connection->GetUnpackedChannelData(UpdateMsg);
+	if (Processor && UnpackedData && UnpackedData->GetDescriptor() == MsgTemplate->GetDescriptor())
+	{
+		// Parsed on the receive thread, and only merged by this view, so its states can be moved.
+		if (!Processor->MergeMove(UnpackedData, UpdateData))
+		{
+			CHANNELD_LOG_RATE_LIMITED(LogChanneld, Warning, 1.0, TEXT("Failed to merge %s channel data: %s"), *GetChanneldSubsystem()->GetChannelTypeNameByChId(ChId), UTF8_TO_TCHAR(UnpackedData->ShortDebugString().c_str()));
+			return nullptr;
+		}
+	}
+	else if (Processor && Processor->SupportsMergeFromString())
+	{
+		if (!Processor->MergeFromString(UpdateMsg->data().value(), UpdateData))
+		{
+			UE_LOG(LogChanneld, Warning, TEXT("Failed to merge %s channel data, typeUrl: %s"), *GetChanneldSubsystem()->GetChannelTypeNameByChId(ChId), UTF8_TO_TCHAR(UpdateMsg->data().type_url().c_str()));
+			return nullptr;
+		}
+	}
+	else if (Processor)
 	{
 		// Use the message template as the temporary message to unpack the any data.
 		if (!UpdateMsg->data().UnpackTo(MsgTemplate))
 		{
 			UE_LOG(LogChanneld, Warning, TEXT("Failed to unpack %s channel data, typeUrl: %s"), *GetChanneldSubsystem()->GetChannelTypeNameByChId(ChId), UTF8_TO_TCHAR(UpdateMsg->data().type_url().c_str()));
-			return;
+			return nullptr;
 		}
-		if (!Processor->Merge(MsgTemplate, UpdateData))
+		// The template is parsed again for the next update, so its states can be moved.
+		if (!Processor->MergeMove(MsgTemplate, UpdateData))
 		{
-			UE_LOG(LogChanneld, Warning, TEXT("Failed to merge %s channel data: %s"), *GetChanneldSubsystem()->GetChannelTypeNameByChId(ChId), UTF8_TO_TCHAR(MsgTemplate->DebugString().c_str()));
-			return;
+			CHANNELD_LOG_RATE_LIMITED(LogChanneld, Warning, 1.0, TEXT("Failed to merge %s channel data: %s"), *GetChanneldSubsystem()->GetChannelTypeNameByChId(ChId), UTF8_TO_TCHAR(MsgTemplate->ShortDebugString().c_str()));
+			return nullptr;
 		}
 	}
 	else
 	{
-		UE_LOG(LogChanneld, Log, TEXT("ChannelDataProcessor not found for type: %s, fall back to ParsePartialFromString. Risk: The state with the same NetId will be overwritten instead of merged."), *MessageName.ToString());
+		UE_LOG(LogChanneld, Log, TEXT("ChannelDataProcessor not found for type: %s, fall back to ParsePartialFromString. Risk: The state with the same NetId will be overwritten instead of merged."), UTF8_TO_TCHAR(UpdateData->GetTypeName().c_str()));
 		// Call ParsePartial instead of Parse to keep the existing value from being reset.
 		if (!UpdateData->ParsePartialFromString(UpdateMsg->data().value()))
 		{
 			UE_LOG(LogChanneld, Error, TEXT("Failed to parse %s channel data, typeUrl: %s"), *GetChanneldSubsystem()->GetChannelTypeNameByChId(ChId), UTF8_TO_TCHAR(UpdateMsg->data().type_url().c_str()));
-			return;
+			return nullptr;
 		}
 	}
 
+	return UpdateData;
+}
+
+void UChannelDataView::ConsumeMergedChannelUpdate(Channeld::ChannelId ChId, google::protobuf::Message* UpdateData)
+{
+	// Keep merging into the received data until the new world is ready.
+	if (bBufferingForTravel)
+	{
+		TravelBufferedChannels.AddUnique(ChId);
+		return;
+	}
+
+	if (HoldingUpdatesNetGUIDs.Num() > 0)
+	{
+		HoldUpdateData(ChId, UpdateData);
+	}
+
 	if (CheckUnspawnedObject(ChId, UpdateData))
 	{
 		UE_LOG(LogChanneld, Verbose, TEXT("Resolving unspawned object, the channel data will not be consumed."));
 		return;
 	}
-	
+
+	CHANNELD_TRACE_SCOPE(Channeld_ConsumeChannelUpdate);
+	const double ConsumeStartTime = bProfileReplication ? FPlatformTime::Seconds() : 0;
 	ConsumeChannelUpdateData(ChId, UpdateData);
+	if (bProfileReplication)
+	{
+		GetReplicationCost(ChId).ConsumeSeconds += FPlatformTime::Seconds() - ConsumeStartTime;
+	}
+}
+
+FChannelReplicationCost& UChannelDataView::GetReplicationCost(Channeld::ChannelId ChId)
+{
+	FChannelReplicationCost& Cost = ChannelReplicationCosts.FindOrAdd(ChId);
+	if (Cost.ChannelTypeName.IsEmpty())
+	{
+		Cost.ChannelTypeName = GetChanneldSubsystem()->GetChannelTypeNameByChId(ChId);
+	}
+	return Cost;
+}
+
+void UChannelDataView::ReportReplicationCosts()
+{
+	UChanneldMetrics* Metrics = GEngine->GetEngineSubsystem<UChanneldMetrics>();
+	for (auto& Pair : ChannelReplicationCosts)
+	{
+		Metrics->OnChannelReplicationCost(Pair.Value);
+	}
+	for (auto& Pair : ProviderClassCollectSeconds)
+	{
+		Metrics->OnProviderCollectTime(Pair.Key, Pair.Value);
+	}
+	ChannelReplicationCosts.Reset();
+	ProviderClassCollectSeconds.Reset();
 }
 
 bool UChannelDataView::ConsumeChannelUpdateData(Channeld::ChannelId ChId, google::protobuf::Message* UpdateData)
 {
-	TSet<FProviderInternal>* Providers = ChannelDataProviders.Find(ChId);
+	if (bSingleChannel && ChId == Channeld::GlobalChannelId && !GetMutableDefault<UChanneldSettings>()->bIndexedChannelDataDispatch)
+	{
+		if (bGlobalProvidersDirty)
+		{
+			GlobalProviders.Reset();
+			if (const FChannelProviders* Providers = ChannelDataProviders.Find(ChId))
+			{
+				Providers->GetProviders(GlobalProviders);
+			}
+			bGlobalProvidersDirty = false;
+		}
+
+		if (GlobalProviders.Num() > 0)
+		{
+			DiscardPendingUpdateData(ChId);
+
+			// A nested call (if any) gets an empty array and allocates its own one.
+			TArray<FProviderInternal> ProvidersArr = MoveTemp(ConsumingGlobalProviders);
+			ProvidersArr.Reset();
+			ProvidersArr.Append(GlobalProviders);
+			bool bConsumed = false;
+			for (FProviderInternal& Provider : ProvidersArr)
+			{
+				if (Provider.IsValid() && !Provider->IsRemoved())
+				{
+					Provider->OnChannelDataUpdated(UpdateData);
+					bConsumed = true;
+				}
+			}
+			ConsumingGlobalProviders = MoveTemp(ProvidersArr);
+
+			if (bConsumed)
+			{
+				UpdateData->Clear();
+			}
+			return bConsumed;
+		}
+	}
+
+	FChannelProviders* Providers = ChannelDataProviders.Find(ChId);
 	if (Providers == nullptr || Providers->Num() == 0)
 	{
-		UE_LOG(LogChanneld, Log, TEXT("No provider registered for channel %d. The update will not be applied."), ChId);
+		if (SavePendingUpdateData(ChId, UpdateData))
+		{
+			UE_LOG(LogChanneld, Verbose, TEXT("No provider registered for channel %d. The update is saved until a provider is added."), ChId);
+			UpdateData->Clear();
+			return true;
+		}
 
-		/* Saving the update data with removed=true can caused the provider gets destroyed immediately after AddProvider.
-		auto UnprocessedUpdateData = UpdateData->New();
-		UnprocessedUpdateData->CopyFrom(*UpdateData);
-		UnprocessedUpdateDataInChannels.FindOrAdd(ChId).Add(UnprocessedUpdateData);
-		*/
-		
+		UE_LOG(LogChanneld, Log, TEXT("No provider registered for channel %d. The update will not be applied."), ChId);
 		return false;
 	}
 
+	// The pending states are only complete until the providers start to consume the updates.
+	DiscardPendingUpdateData(ChId);
+
 	// The set can be changed during the iteration, when a new provider is created from the UnrealObjectRef during any replicator's OnStateChanged(),
 	// or the provider's owner actor got destroyed by removed=true. So we use a const array to iterate.
-	TArray<FProviderInternal> ProvidersArr = Providers->Array();
+	TArray<FProviderInternal> ProvidersArr;
 	bool bConsumed = false;
+
+	// Only notify the providers of the states in the update, instead of letting every provider look for its state.
+	TSet<uint32> NetGUIDs;
+	IChannelDataProcessor* Processor = GetMutableDefault<UChanneldSettings>()->bIndexedChannelDataDispatch ? FindChannelDataProcessor(ChId, UpdateData) : nullptr;
+	if (Processor && Processor->GetNetGUIDsInChannelData(UpdateData, NetGUIDs))
+	{
+		const FProviderIndex& Index = GetProviderIndex(ChId, *Providers);
+		TSet<FProviderInternal> Affected(Index.Unindexed);
+		for (const uint32 NetGUID : NetGUIDs)
+		{
+			if (auto Found = Index.ByNetGUID.Find(NetGUID))
+			{
+				Affected.Append(*Found);
+			}
+		}
+		ProvidersArr = Affected.Array();
+		// The states of the objects without a provider are dropped, same as notifying all the providers.
+		bConsumed = true;
+	}
+	else
+	{
+		Providers->GetProviders(ProvidersArr);
+	}
+
 	for (FProviderInternal& Provider : ProvidersArr)
 	{
 		if (Provider.IsValid() && !Provider->IsRemoved())
@@ -982,6 +2069,156 @@ bool UChannelDataView::ConsumeChannelUpdateData(Channeld::ChannelId ChId, google
 	return bConsumed;
 }
 
+void UChannelDataView::OnClientTravel(Channeld::ChannelId DstChId)
+{
+	if (!GetMutableDefault<UChanneldSettings>()->bPrefetchInterestOnTravel || Connection == nullptr || !Connection->IsClient() || bBufferingForTravel)
+	{
+		return;
+	}
+
+	bBufferingForTravel = true;
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UChannelDataView::OnPostLoadMapAfterTravel);
+	UE_LOG(LogChanneld, Log, TEXT("[Client] Buffering the channel data during the travel to channel %d"), DstChId);
+}
+
+void UChannelDataView::OnPostLoadMapAfterTravel(UWorld* LoadedWorld)
+{
+	if (LoadedWorld == nullptr || LoadedWorld->GetGameInstance() != GetChanneldSubsystem()->GetGameInstance())
+	{
+		return;
+	}
+
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	bBufferingForTravel = false;
+
+	// The actors of the new map have begun play and registered their providers.
+	TArray<Channeld::ChannelId> Channels = MoveTemp(TravelBufferedChannels);
+	TravelBufferedChannels.Reset();
+	UE_LOG(LogChanneld, Log, TEXT("[Client] Map loaded, applying the channel data of %d channels buffered during the travel"), Channels.Num());
+	for (const Channeld::ChannelId ChId : Channels)
+	{
+		if (google::protobuf::Message* UpdateData = ReceivedUpdateDataInChannels.FindRef(ChId))
+		{
+			ConsumeMergedChannelUpdate(ChId, UpdateData);
+		}
+	}
+}
+
+bool UChannelDataView::SavePendingUpdateData(Channeld::ChannelId ChId, const google::protobuf::Message* UpdateData)
+{
+	const int32 MaxStates = GetMutableDefault<UChanneldSettings>()->MaxPendingChannelDataStates;
+	IChannelDataProcessor* Processor = MaxStates > 0 ? FindChannelDataProcessor(ChId, UpdateData) : nullptr;
+	if (Processor == nullptr)
+	{
+		return false;
+	}
+
+	google::protobuf::Message*& PendingData = PendingUpdateDataInChannels.FindOrAdd(ChId);
+	if (PendingData == nullptr)
+	{
+		PendingData = UpdateData->New();
+	}
+	if (!Processor->Merge(UpdateData, PendingData))
+	{
+		DiscardPendingUpdateData(ChId);
+		return false;
+	}
+	// Replaying removed = true would destroy the object right after its provider is added.
+	Processor->EraseRemovedStatesInChannelData(PendingData);
+
+	TSet<uint32> NetGUIDs;
+	if (Processor->GetNetGUIDsInChannelData(PendingData, NetGUIDs) && NetGUIDs.Num() > MaxStates)
+	{
+		UE_LOG(LogChanneld, Warning, TEXT("Too many pending states (%d) in channel %d, discarded them. Max: %d"), NetGUIDs.Num(), ChId, MaxStates);
+		DiscardPendingUpdateData(ChId);
+		return false;
+	}
+	return true;
+}
+
+void UChannelDataView::HoldUpdateData(Channeld::ChannelId ChId, const google::protobuf::Message* UpdateData)
+{
+	IChannelDataProcessor* Processor = FindChannelDataProcessor(ChId, UpdateData);
+	TSet<uint32> NetGUIDs;
+	if (Processor == nullptr || !Processor->GetNetGUIDsInChannelData(UpdateData, NetGUIDs) || NetGUIDs.Intersect(HoldingUpdatesNetGUIDs).Num() == 0)
+	{
+		return;
+	}
+
+	google::protobuf::Message*& HeldData = HeldUpdateDataInChannels.FindOrAdd(ChId);
+	if (HeldData == nullptr)
+	{
+		HeldData = UpdateData->New();
+	}
+	NetGUIDs.Reset();
+	const int32 MaxStates = GetMutableDefault<UChanneldSettings>()->MaxPendingChannelDataStates;
+	if (!Processor->Merge(UpdateData, HeldData) || (Processor->GetNetGUIDsInChannelData(HeldData, NetGUIDs) && NetGUIDs.Num() > MaxStates))
+	{
+		UE_LOG(LogChanneld, Warning, TEXT("Failed to hold the update of channel %d for the objects waiting for their classes to load (%d states, max: %d)"), ChId, NetGUIDs.Num(), MaxStates);
+		delete HeldData;
+		HeldUpdateDataInChannels.Remove(ChId);
+	}
+}
+
+void UChannelDataView::DiscardPendingUpdateData(Channeld::ChannelId ChId)
+{
+	google::protobuf::Message* PendingData;
+	if (PendingUpdateDataInChannels.RemoveAndCopyValue(ChId, PendingData))
+	{
+		delete PendingData;
+	}
+}
+
+UChannelDataView::FProviderIndex& UChannelDataView::GetProviderIndex(Channeld::ChannelId ChId, const FChannelProviders& Providers)
+{
+	FProviderIndex& Index = ProviderIndices.FindOrAdd(ChId);
+	TArray<uint32> ProviderNetGUIDs;
+	if (Index.bDirty)
+	{
+		Index.ByNetGUID.Reset();
+		Index.Unindexed.Reset();
+		for (const FChannelProviders::FEntry& Entry : Providers.Entries)
+		{
+			const FProviderInternal& Provider = Entry.Provider;
+			if (!Provider.IsValid())
+			{
+				continue;
+			}
+			ProviderNetGUIDs.Reset();
+			if (Provider->GetNetGUIDs(ProviderNetGUIDs))
+			{
+				for (const uint32 NetGUID : ProviderNetGUIDs)
+				{
+					Index.ByNetGUID.FindOrAdd(NetGUID).Add(Provider);
+				}
+			}
+			else
+			{
+				Index.Unindexed.Add(Provider);
+			}
+		}
+		Index.bDirty = false;
+	}
+	else
+	{
+		// The NetGUIDs of the unindexed providers can be assigned since the last update.
+		for (int32 i = Index.Unindexed.Num() - 1; i >= 0; i--)
+		{
+			const FProviderInternal& Provider = Index.Unindexed[i];
+			ProviderNetGUIDs.Reset();
+			if (Provider.IsValid() && Provider->GetNetGUIDs(ProviderNetGUIDs))
+			{
+				for (const uint32 NetGUID : ProviderNetGUIDs)
+				{
+					Index.ByNetGUID.FindOrAdd(NetGUID).Add(Provider);
+				}
+				Index.Unindexed.RemoveAtSwap(i);
+			}
+		}
+	}
+	return Index;
+}
+
 /* The following comment no longer applies since we added caching for ChanneldUtils::GetRefOfObject.
 // Warning: DO NOT use this function before sending the Spawn message!
 // Calling Provider->UpdateChannelData can cause FChanneldActorReplicator::Tick to be called, which will call
@@ -1015,7 +2252,7 @@ const google::protobuf::Message* UChannelDataView::GetEntityData(UObject* Obj)
 		return nullptr;
 	}
 
-	auto ChannelData = MsgTemplate->New(&ArenaForSend);
+	auto ChannelData = MsgTemplate->New(GetFrameArena());
 	Provider->UpdateChannelData(ChannelData);
 
 	return ChannelData;
@@ -10,6 +10,23 @@
 #include "UObject/WeakInterfacePtr.h"
 #include "ChannelDataView.generated.h"
 
+// The replication cost of a channel, accumulated between the reports. See UChanneldSettings::ReplicationProfileInterval.
+struct FChannelReplicationCost
+{
+	// The channel type name, resolved when the channel is first recorded in the report interval.
+	FString ChannelTypeName;
+	// Updating the providers in SendChannelUpdate().
+	double CollectSeconds = 0;
+	// Merging the received updates with the channel data processor.
+	double MergeSeconds = 0;
+	// Consuming the merged updates by the providers.
+	double ConsumeSeconds = 0;
+	uint64 SentBytes = 0;
+	uint64 ReceivedBytes = 0;
+
+	double GetTotalSeconds() const { return CollectSeconds + MergeSeconds + ConsumeSeconds; }
+};
+
 // Owned by UChanneldGameInstanceSubsystem.
 UCLASS(Blueprintable, Abstract, Config=ChanneldUE)
 class CHANNELDUE_API UChannelDataView : public UObject
@@ -31,6 +48,11 @@ public:
 			AnyForTypeUrl = new google::protobuf::Any;
 		AnyForTypeUrl->PackFrom(*MsgTemplate);
 		ChannelDataTemplatesByTypeUrl.Add(FString(UTF8_TO_TCHAR(AnyForTypeUrl->type_url().c_str())), MsgTemplate);
+		ChannelDataTypeUrls.Add(ChannelType, AnyForTypeUrl->type_url());
+		if (Connection)
+		{
+			Connection->RegisterChannelDataPrototype(AnyForTypeUrl->type_url(), MsgTemplate);
+		}
 		UE_LOG(LogChanneld, Log, TEXT("Registered %s for channel type %d"), UTF8_TO_TCHAR(MsgTemplate->GetTypeName().c_str()), ChannelType);
 	}
 
@@ -72,7 +94,7 @@ public:
 	 * @return Should the NetDriver send the spawn message to the clients?
 	 */
 	virtual bool OnServerSpawnedObject(UObject* Obj, const FNetworkGUID NetId);
-	// Send the Spawn message to all interested clients.
+	// Send the Spawn message to all interested clients. The message is made once for all the clients, unless UChanneldSettings::bBroadcastSpawnToClients is off.
 	virtual void SendSpawnToClients(UObject* Obj, uint32 OwningConnId);
 	// Send the Destroy message to all interested clients.
 	virtual void SendDestroyToClients(UObject* Obj, const FNetworkGUID NetId);
@@ -83,15 +105,36 @@ public:
 	virtual void OnNetSpawnedObject(UObject* Obj, const Channeld::ChannelId ChId) {}
 	virtual void OnDestroyedActor(AActor* Actor, const FNetworkGUID NetId);
 	virtual void SetOwningChannelId(const FNetworkGUID NetId, Channeld::ChannelId ChId);
+	// [Client] Hold the channel data updates that have the state of the object, until its provider is added or StopHoldingUpdates() is called.
+	// Used when the spawn of the object waits for its class to load. See UChanneldSettings::bAsyncLoadSpawnClasses.
+	void HoldUpdatesUntilSpawned(const FNetworkGUID NetId);
+	void StopHoldingUpdates(const FNetworkGUID NetId);
+	// [Server] Whether the handover of the object is received but not processed yet.
+	virtual bool IsHandoverPending(const FNetworkGUID NetId) const { return false; }
+	// The connection is notified by UChanneldNetConnection::OnOwningChannelIdSet() when the mapping of the NetId is set.
+	void WaitForOwningChannelId(const FNetworkGUID NetId, UChanneldNetConnection* NetConn);
 	virtual Channeld::ChannelId GetOwningChannelId(const FNetworkGUID NetId) const;
 	virtual Channeld::ChannelId GetOwningChannelId(AActor* Actor) const;
+	int32 GetNumOwningChannelMappings() const { return NetIdOwningChannels.Num(); }
+	// [Server] Add the NetIds known to be in use besides the ones in the GuidCache, e.g. of the objects handed over to the other servers.
+	// The recycling of the dynamic NetGUIDs never reuses them. See UChanneldSettings::bRecycleDynamicNetIds.
+	virtual void GetNetIdsInUse(TSet<uint32>& OutNetIds) const;
 
 	virtual bool SendMulticastRPC(AActor* Actor, const FString& FuncName, TSharedPtr<google::protobuf::Message> ParamsMsg, const FString& SubObjectPathName);
 
 	int32 SendChannelUpdate(Channeld::ChannelId ChId);
 	int32 SendAllChannelUpdates();
+	// Override UChanneldSettings::ChannelTypeSendIntervals for a channel. A negative interval removes the override.
+	UFUNCTION(BlueprintCallable)
+	void SetChannelSendInterval(int32 ChId, float Interval);
+	// Resume calling UpdateChannelData() of an idle provider every tick.
+	void WakeProvider(IChannelDataProvider* Provider);
 
-	void OnDisconnect();
+	virtual void OnDisconnect();
+
+	// [Client] Called before travelling to another level. The channel data received during the travel is buffered until the new map
+	// has loaded, instead of being applied to the old world. DstChId is the channel the client travels to, if known. See UChanneldSettings::bPrefetchInterestOnTravel.
+	virtual void OnClientTravel(Channeld::ChannelId DstChId);
 
 	// UPROPERTY(EditAnywhere)
 	// EChanneldChannelType DefaultChannelType = EChanneldChannelType::ECT_Global;
@@ -117,6 +160,54 @@ protected:
 		}
 	};
 
+	/**
+	 * The providers of a channel in a dense array. The slots are looked up by the raw pointers, so adding, removing and finding a provider
+	 * don't resolve the weak pointers, and the updates iterate over a flat array. The removal swaps the last provider into the slot.
+	 */
+	struct FChannelProviders
+	{
+		struct FEntry
+		{
+			FProviderInternal Provider;
+			// The key of the slot, which is still valid after the provider is destroyed.
+			const IChannelDataProvider* RawProvider;
+			// Skipped by SendChannelUpdate() until the next check of the idle providers. See UChanneldSettings::ProviderIdleUpdates.
+			bool bSleeping;
+		};
+		TArray<FEntry> Entries;
+		TMap<const IChannelDataProvider*, int32> Slots;
+
+		FORCEINLINE int32 Num() const { return Entries.Num(); }
+		FORCEINLINE bool Contains(const IChannelDataProvider* Provider) const { return Slots.Contains(Provider); }
+		// Returns the slot of the provider or INDEX_NONE. The hint is checked first, as the slots are only changed by the removals.
+		FORCEINLINE int32 Find(const IChannelDataProvider* Provider, int32 Hint = INDEX_NONE) const
+		{
+			if (Entries.IsValidIndex(Hint) && Entries[Hint].RawProvider == Provider)
+			{
+				return Hint;
+			}
+			const int32* Slot = Slots.Find(Provider);
+			return Slot ? *Slot : INDEX_NONE;
+		}
+		// Returns false if the provider is already in the channel.
+		bool Add(IChannelDataProvider* Provider);
+		bool Remove(const IChannelDataProvider* Provider);
+		void RemoveAt(int32 Slot);
+		void SetSleeping(const IChannelDataProvider* Provider, bool bSleeping);
+		// Appends the providers to the array.
+		void GetProviders(TArray<FProviderInternal>& OutProviders) const;
+	};
+
+	// Looks up the providers of a channel by the NetGUIDs in an update. See IChannelDataProvider::GetNetGUIDs().
+	struct FProviderIndex
+	{
+		TMap<uint32, TArray<FProviderInternal, TInlineAllocator<1>>> ByNetGUID;
+		// The providers that don't know their NetGUIDs yet. They are notified of every update.
+		TArray<FProviderInternal> Unindexed;
+		// Set when the providers of the channel are changed.
+		bool bDirty = true;
+	};
+
 	virtual void LoadCmdLineArgs() {}
 
 	UFUNCTION(BlueprintCallable, BlueprintPure/*, meta=(CallableWithoutWorldContext)*/)
@@ -140,8 +231,77 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, meta = (DisplayName = "BeginUninitClient"))
 	void ReceiveUninitClient();
 
+	// Merge the update into ReceivedUpdateDataInChannels and consume it right away.
 	void HandleChannelDataUpdate(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
+	// The handler of the CHANNEL_DATA_UPDATE messages. Defers the consumption to the end of the tick if bCoalesceChannelDataUpdates is set.
+	void HandleChannelDataUpdateMessage(UChanneldConnection* Conn, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
+	struct FScheduledProvider
+	{
+		double DueTime;
+		// The interval the provider was scheduled with, used to age its priority.
+		float Interval;
+		FProviderInternal Provider;
+
+		struct FEarlier
+		{
+			FORCEINLINE bool operator()(const FScheduledProvider& A, const FScheduledProvider& B) const { return A.DueTime < B.DueTime; }
+		};
+	};
+
+	// The providers of a channel ordered by the next update time. See UChanneldSettings::bScheduledReplication.
+	struct FProviderSchedule
+	{
+		TArray<FScheduledProvider> Heap;
+		// The current due time of each scheduled provider. The entries in the heap with a different due time are stale.
+		TMap<FProviderInternal, double> DueTimes;
+	};
+
+	void ScheduleProvider(FProviderSchedule& Schedule, const FProviderInternal& Provider, double DueTime, float Interval);
+	// Pop the providers that are due, and at most UChanneldSettings::MaxScheduledUpdatesPerTick of them by priority.
+	void PopDueProviders(Channeld::ChannelId ChId, const FChannelProviders& Providers, TArray<FProviderInternal>& OutDueProviders);
+	void RescheduleProviders(Channeld::ChannelId ChId, const FChannelProviders& Providers, const TArray<FProviderInternal>& UpdatedProviders);
+
+	// The template and the processor of the channel data in a channel, resolved from the type URL of the updates.
+	struct FChannelDataTypeCache
+	{
+		std::string TypeUrl;
+		google::protobuf::Message* Template = nullptr;
+		IChannelDataProcessor* Processor = nullptr;
+	};
+	// Returns nullptr if no template is registered for the type URL.
+	const FChannelDataTypeCache* ResolveChannelDataType(Channeld::ChannelId ChId, const std::string& TypeUrl);
+	IChannelDataProcessor* FindChannelDataProcessor(Channeld::ChannelId ChId, const google::protobuf::Message* ChannelData) const;
+	// Returns the merged update data of the channel, or nullptr if the update can't be merged.
+	google::protobuf::Message* MergeChannelDataUpdate(Channeld::ChannelId ChId, const channeldpb::ChannelDataUpdateMessage* UpdateMsg);
+	void ConsumeMergedChannelUpdate(Channeld::ChannelId ChId, google::protobuf::Message* UpdateData);
+
+	bool bBufferingForTravel = false;
+	// The channels whose merged updates are held in ReceivedUpdateDataInChannels during the travel.
+	TArray<Channeld::ChannelId> TravelBufferedChannels;
+	FDelegateHandle PostLoadMapHandle;
+	void OnPostLoadMapAfterTravel(UWorld* LoadedWorld);
+	FProviderIndex& GetProviderIndex(Channeld::ChannelId ChId, const FChannelProviders& Providers);
+	FORCEINLINE void MarkProviderIndexDirty(Channeld::ChannelId ChId)
+	{
+		if (FProviderIndex* Index = ProviderIndices.Find(ChId))
+		{
+			Index->bDirty = true;
+		}
+		if (ChId == Channeld::GlobalChannelId)
+		{
+			bGlobalProvidersDirty = true;
+		}
+	}
+	// Consume the updates merged in this tick, once per channel.
+	void ConsumeCoalescedChannelUpdates(UChanneldConnection* Conn);
+	// Encode a ChannelDataUpdateMessage with Data packed as the Any, serializing Data straight into Body.
+	static void EncodeChannelDataUpdate(const google::protobuf::Message& Data, const std::string& TypeUrl, std::string& Body);
+	// Update the thread-safe providers with ParallelFor and merge the results into DeltaChannelData. Returns the number of the updated providers.
+	int32 CollectInParallel(const TArray<IChannelDataProvider*>& InProviders, const google::protobuf::Message* MsgTemplate, google::protobuf::Message* DeltaChannelData);
 	virtual bool ConsumeChannelUpdateData(Channeld::ChannelId ChId, google::protobuf::Message* UpdateData);
+	// Merge the update into the pending update data of a channel without any provider. Returns false if the update can't be kept.
+	bool SavePendingUpdateData(Channeld::ChannelId ChId, const google::protobuf::Message* UpdateData);
+	void DiscardPendingUpdateData(Channeld::ChannelId ChId);
 
 	const google::protobuf::Message* GetEntityData(UObject* Obj);
 
@@ -149,10 +309,19 @@ protected:
 	virtual void ServerHandleClientUnsub(Channeld::ConnectionId ClientConnId, channeldpb::ChannelType ChannelType, Channeld::ChannelId ChId);
 	
 	// Give the subclass a chance to mess with the removed providers, e.g. add a provider back to a channel.
-	virtual void OnRemovedProvidersFromChannel(Channeld::ChannelId ChId, channeldpb::ChannelType ChannelType, const TSet<FProviderInternal>& RemovedProviders) {}
+	virtual void OnRemovedProvidersFromChannel(Channeld::ChannelId ChId, channeldpb::ChannelType ChannelType, const FChannelProviders& RemovedProviders) {}
+	// Called when current connection unsubscribed from the channel, whether or not it had any provider in it.
+	virtual void OnUnsubscribedFromChannel(Channeld::ChannelId ChId, channeldpb::ChannelType ChannelType) {}
 	
 	// Send all the existing actors to the new player (including the static level actors) at the end of PostLogin.
+	// If UChanneldSettings::bStreamLateJoinSpawns is true, the actors are sent across the frames, nearest to the player first.
 	virtual void SendExistingActorsToNewPlayer(APlayerController* NewPlayer, UChanneldNetConnection* NewPlayerConn);
+	virtual bool ShouldSendExistingActorToNewPlayer(AActor* Actor, APlayerController* NewPlayer);
+	virtual void SendExistingActorToNewPlayer(AActor* Actor, APlayerController* NewPlayer, UChanneldNetConnection* NewPlayerConn);
+	// Send the queued existing actors to the new players under the budget of this frame. Schedules the next tick if there's any left.
+	void TickLateJoinSpawns();
+	// The next-tick timer of TickLateJoinSpawns().
+	void OnLateJoinSpawnTimer();
 
 	/**
 	 * @brief Checks if the channel data contains any unsolved NetworkGUID.
@@ -170,11 +339,44 @@ protected:
 	// Reuse the message objects to 1) decrease the memory footprint; 2) save the data for the next update if no state is consumed.
 	TMap<Channeld::ChannelId, google::protobuf::Message*> ReceivedUpdateDataInChannels;
 
-	// Received ChannelUpdateData that don't have any provider to consume. Will be consumed as soon as a provider is added to the channel.
-	TMap<Channeld::ChannelId, TArray<google::protobuf::Message*>> UnprocessedUpdateDataInChannels;
+	// The channels that have merged but not yet consumed updates, in the order of the first update received in this tick.
+	TArray<Channeld::ChannelId> CoalescedUpdateChannels;
+
+	// The merged ChannelUpdateData received when the channel doesn't have any provider to consume it. Replayed to the providers added to the channel,
+	// until the next update is consumed by them. See UChanneldSettings::MaxPendingChannelDataStates.
+	TMap<Channeld::ChannelId, google::protobuf::Message*> PendingUpdateDataInChannels;
+
+	// The objects whose spawns are waiting for their classes to load. See HoldUpdatesUntilSpawned().
+	TSet<uint32> HoldingUpdatesNetGUIDs;
+	// The merged updates that have the states of HoldingUpdatesNetGUIDs, replayed to the providers of these objects when they are added.
+	TMap<Channeld::ChannelId, google::protobuf::Message*> HeldUpdateDataInChannels;
+	void HoldUpdateData(Channeld::ChannelId ChId, const google::protobuf::Message* UpdateData);
 
 	// The spawned object's NetGUID mapping to the ID of the channel that owns the object.
 	TMap<const FNetworkGUID, Channeld::ChannelId> NetIdOwningChannels;
+	// The connections that have the spawn of the object queued until the mapping is set.
+	TMap<FNetworkGUID, TArray<TWeakObjectPtr<UChanneldNetConnection>>> ConnsWaitingForOwningChannel;
+	// The NetIds whose mappings are set since the last CompactOwningChannels(). See UChanneldSettings::OwningChannelRetentionSeconds.
+	TSet<FNetworkGUID> RecentOwningChannelNetIds;
+	FTimerHandle OwningChannelCompactTimer;
+	// Remove the mappings of the objects that don't exist in this process and are not set in the last two generations.
+	void CompactOwningChannels();
+
+	// The bytes of the ChannelDataUpdates sent to each channel, since the subclass last reset it.
+	TMap<Channeld::ChannelId, uint64> SentChannelDataBytes;
+
+	// Set by the views that keep every object in the global channel, e.g. USingleChannelDataView. The providers of the global channel
+	// are consumed from a flat array, and the template and the processor of the global channel data are bound once at the initialization.
+	bool bSingleChannel = false;
+
+	// Only collected if UChanneldSettings::ReplicationProfileInterval is greater than 0.
+	bool bProfileReplication = false;
+	TMap<Channeld::ChannelId, FChannelReplicationCost> ChannelReplicationCosts;
+	// The seconds spent in UpdateChannelData() by the class of the target objects. The providers collected in parallel are not included.
+	TMap<FName, double> ProviderClassCollectSeconds;
+	FChannelReplicationCost& GetReplicationCost(Channeld::ChannelId ChId);
+	// Send the costs since the last report to UChanneldMetrics and reset them.
+	virtual void ReportReplicationCosts();
 
 	// Virtual NetConnection for sending Spawn message to channeld to broadcast.
 	// Exporting the NetId of the spawned object requires a NetConnection, but we don't have a specific client when broadcasting.
@@ -182,14 +384,58 @@ protected:
 	UPROPERTY()
 	UChanneldNetConnection* NetConnForSpawn;
 
+	// The arena for the transient messages, e.g. the channel data updates to send, the removed states and the entity data.
+	// The messages allocated in it are freed at the end of the next SendAllChannelUpdates(), so they should never be kept longer.
+	google::protobuf::Arena* GetFrameArena();
+
 private:
 	
 	// Use the Arena for faster allocation. See https://developers.google.com/protocol-buffers/docs/reference/arenas
-	google::protobuf::Arena ArenaForSend;
+	TUniquePtr<google::protobuf::Arena> FrameArena;
+	// The max bytes used by FrameArena in a frame, reported as the ue_frame_arena_high_water metric.
+	uint64 FrameArenaHighWater = 0;
+	// Free the transient messages at the end of SendAllChannelUpdates().
+	void ResetFrameArena();
+
+	// The number of the SendAllChannelUpdates() calls skipped in a row due to the send pressure.
+	int32 ThrottledTicks = 0;
+
+	FTimerHandle ReplicationProfileTimer;
+
+	// Free the consumed messages in ReceivedUpdateDataInChannels that are over UChanneldSettings::ReceivedUpdateDataBudgetBytes.
+	void TrimReceivedUpdateData();
+	FTimerHandle ReceivedUpdateDataTrimTimer;
+	void ReleaseReceivedUpdateData(Channeld::ChannelId ChId);
+
+	// See SetChannelSendInterval().
+	TMap<Channeld::ChannelId, float> ChannelSendIntervals;
+	// The time (FPlatformTime::Seconds) when the channel can be sent again. Only for the channels with a send interval.
+	TMap<Channeld::ChannelId, double> NextChannelSendTimes;
+
+	// The new players that have existing actors queued to spawn. See UChanneldNetConnection::LateJoinSpawnQueue.
+	TArray<TWeakObjectPtr<UChanneldNetConnection>> LateJoinConnections;
+	// Only cleared by OnLateJoinSpawnTimer(), so the direct calls of TickLateJoinSpawns() don't schedule another timer.
+	bool bLateJoinTickScheduled = false;
 
 	google::protobuf::Any* AnyForTypeUrl;
 	TMap<FString, google::protobuf::Message*> ChannelDataTemplatesByTypeUrl;
-
-	TMap<Channeld::ChannelId, TSet<FProviderInternal>> ChannelDataProviders;
+	// The type URLs of the registered templates, used to encode the ChannelDataUpdateMessage without packing an Any.
+	TMap<int, std::string> ChannelDataTypeUrls;
+
+	TMap<Channeld::ChannelId, FChannelProviders> ChannelDataProviders;
+	// The time (FPlatformTime::Seconds()) when SendChannelUpdate() updates the sleeping providers as well.
+	double NextSleepingProviderCheckTime = 0;
+	TMap<Channeld::ChannelId, FProviderIndex> ProviderIndices;
+	TMap<Channeld::ChannelId, FChannelDataTypeCache> ChannelDataTypeCaches;
+	// The template and the processor of the global channel in the single channel mode, instead of the lookup in ChannelDataTypeCaches.
+	FChannelDataTypeCache GlobalChannelDataType;
+	void BindGlobalChannelDataType();
+	// The providers of the global channel in the single channel mode, rebuilt from ChannelDataProviders after they are changed.
+	TArray<FProviderInternal> GlobalProviders;
+	bool bGlobalProvidersDirty = true;
+	// Reused by ConsumeChannelUpdateData() to iterate GlobalProviders, as the providers can be changed by OnChannelDataUpdated().
+	TArray<FProviderInternal> ConsumingGlobalProviders;
+	TMap<Channeld::ChannelId, FProviderSchedule> ProviderSchedules;
+	// The removed states to send with the next update of the channel. Allocated in the frame arena.
 	TMap<Channeld::ChannelId, google::protobuf::Message*> RemovedProvidersData;
 };
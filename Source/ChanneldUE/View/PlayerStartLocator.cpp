@@ -1,5 +1,7 @@
 #include "PlayerStartLocator.h"
 
+#include "ChanneldConnection.h"
+#include "ChanneldUtils.h"
 #include "EngineUtils.h"
 #include "GameFramework/PlayerStart.h"
 
@@ -37,3 +39,117 @@ FVector UPlayerStartLocator_ModByConnId::GetPlayerStartPosition_Implementation(i
 	}
 	return FVector::ZeroVector;
 }
+
+UPlayerStartLocator_Slots::UPlayerStartLocator_Slots(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+void UPlayerStartLocator_Slots::BuildSlots() const
+{
+	TArray<AActor*> PlayerStarts;
+	for (auto Itr = TActorIterator<APlayerStart>(GetWorld()); Itr; ++Itr)
+	{
+		PlayerStarts.Add(*Itr);
+	}
+	PlayerStarts.Sort([](const AActor& A, const AActor& B) { return A.GetFName().LexicalLess(B.GetFName()); });
+	for (AActor* PlayerStart : PlayerStarts)
+	{
+		Slots.Add(FSlot{PlayerStart, PlayerStart->GetActorLocation()});
+	}
+}
+
+bool UPlayerStartLocator_Slots::MapSlotsToChannels() const
+{
+	if (SlotsByChannel.Num() > 0)
+	{
+		return true;
+	}
+	UChanneldConnection* Conn = ChanneldUtils::GetConnToChanneld(this);
+	if (Conn == nullptr || Conn->GetSpatialRegionIndex().IsEmpty())
+	{
+		return false;
+	}
+	for (int32 i = 0; i < Slots.Num(); i++)
+	{
+		const Channeld::ChannelId ChId = Conn->GetSpatialChannelId(Slots[i].Location);
+		if (ChId != Channeld::InvalidChannelId)
+		{
+			SlotsByChannel.FindOrAdd(ChId).Add(i);
+		}
+	}
+	UE_LOG(LogChanneld, Log, TEXT("Mapped %d player start slots to %d spatial channels"), Slots.Num(), SlotsByChannel.Num());
+	return SlotsByChannel.Num() > 0;
+}
+
+FVector UPlayerStartLocator_Slots::GetPlayerStartPosition_Implementation(int64 ConnId, AActor*& StartSpot) const
+{
+	if (Slots.Num() == 0)
+	{
+		BuildSlots();
+		if (Slots.Num() == 0)
+		{
+			return FVector::ZeroVector;
+		}
+	}
+
+	int32 SlotIndex = ConnId % Slots.Num();
+	if (const Channeld::ChannelId* StartChId = StartChannels.Find(ConnId))
+	{
+		if (MapSlotsToChannels())
+		{
+			if (const TArray<int32>* ChannelSlots = SlotsByChannel.Find(*StartChId))
+			{
+				SlotIndex = (*ChannelSlots)[ConnId % ChannelSlots->Num()];
+			}
+		}
+	}
+
+	const FSlot& Slot = Slots[SlotIndex];
+	StartSpot = Slot.StartSpot.Get();
+	return Slot.Location;
+}
+
+Channeld::ChannelId UPlayerStartLocator_Slots::AssignStartChannel(Channeld::ConnectionId ConnId)
+{
+	if (Slots.Num() == 0)
+	{
+		BuildSlots();
+	}
+	if (!MapSlotsToChannels())
+	{
+		return Channeld::InvalidChannelId;
+	}
+
+	Channeld::ChannelId BestChId = Channeld::InvalidChannelId;
+	int32 BestLoad = MAX_int32;
+	for (auto& Pair : SlotsByChannel)
+	{
+		const int32 Load = ReportedLoads.FindRef(Pair.Key) + AssignedSinceReport.FindRef(Pair.Key);
+		// The ties go to the lower channel id, so the result doesn't depend on the order of the map.
+		if (Load < BestLoad || (Load == BestLoad && Pair.Key < BestChId))
+		{
+			BestChId = Pair.Key;
+			BestLoad = Load;
+		}
+	}
+	AssignedSinceReport.FindOrAdd(BestChId)++;
+	StartChannels.Add(ConnId, BestChId);
+	return BestChId;
+}
+
+void UPlayerStartLocator_Slots::OnChannelLoadReported(Channeld::ChannelId ChId, int32 NumEntities)
+{
+	ReportedLoads.Add(ChId, NumEntities);
+	AssignedSinceReport.Remove(ChId);
+}
+
+void UPlayerStartLocator_Slots::SetStartChannel(Channeld::ConnectionId ConnId, Channeld::ChannelId ChId)
+{
+	StartChannels.Add(ConnId, ChId);
+}
+
+void UPlayerStartLocator_Slots::RemoveConn(Channeld::ConnectionId ConnId)
+{
+	StartChannels.Remove(ConnId);
+}
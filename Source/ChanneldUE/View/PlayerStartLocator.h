@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ChanneldTypes.h"
 #include "PlayerStartLocator.generated.h"
 
 UCLASS(Blueprintable)
@@ -27,3 +28,47 @@ public:
 
 	virtual FVector GetPlayerStartPosition_Implementation(int64 ConnId, AActor*& StartSpot) const override;
 };
+
+/**
+ * The PlayerStarts are collected once (in the order of the names, so all the servers have the same slots) and grouped by the spatial channels
+ * they are in, using the spatial regions from channeld (see UChanneldConnection::GetSpatialRegionIndex()).
+ * The Master server picks the least loaded spatial channel for a new player by AssignStartChannel(), so the player is spawned by the server
+ * that will own it, without querying channeld. The spatial server learns the start channel when the client connection is added (SetStartChannel()).
+ * Both then pick the slot by the ConnId among the slots of the channel, so they agree on the position.
+ * Falls back to UPlayerStartLocator_ModByConnId if the regions are not received yet.
+ */
+UCLASS()
+class UPlayerStartLocator_Slots : public UPlayerStartLocatorBase
+{
+	GENERATED_BODY()
+public:
+	UPlayerStartLocator_Slots(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	virtual FVector GetPlayerStartPosition_Implementation(int64 ConnId, AActor*& StartSpot) const override;
+
+	// [Master] Returns the spatial channel with the least load that has any slot, or InvalidChannelId if the slots are not mapped to the channels yet.
+	Channeld::ChannelId AssignStartChannel(Channeld::ConnectionId ConnId);
+	// [Master] The number of the entities in the spatial channel, from the load report of the spatial server. See UChanneldSettings::SpatialLoadReportInterval.
+	void OnChannelLoadReported(Channeld::ChannelId ChId, int32 NumEntities);
+	// [Spatial] The channel the client logs in to, which is the one assigned by the Master server.
+	void SetStartChannel(Channeld::ConnectionId ConnId, Channeld::ChannelId ChId);
+	void RemoveConn(Channeld::ConnectionId ConnId);
+
+private:
+	struct FSlot
+	{
+		TWeakObjectPtr<AActor> StartSpot;
+		FVector Location;
+	};
+	// Built on the first use, as the PlayerStarts don't move.
+	mutable TArray<FSlot> Slots;
+	// The indices of the slots by the spatial channel. Built once the spatial regions are received.
+	mutable TMap<Channeld::ChannelId, TArray<int32>> SlotsByChannel;
+	void BuildSlots() const;
+	bool MapSlotsToChannels() const;
+
+	TMap<Channeld::ConnectionId, Channeld::ChannelId> StartChannels;
+	// [Master] The reported entities, and the players assigned since the last report, by the spatial channel.
+	TMap<Channeld::ChannelId, int32> ReportedLoads;
+	TMap<Channeld::ChannelId, int32> AssignedSinceReport;
+};
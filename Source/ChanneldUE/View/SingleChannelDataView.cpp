@@ -15,6 +15,14 @@ Channeld::ChannelId USingleChannelDataView::GetOwningChannelId(const FNetworkGUI
 	return Channeld::GlobalChannelId;
 }
 
+void USingleChannelDataView::LoadCmdLineArgs()
+{
+	Super::LoadCmdLineArgs();
+
+	// Called by Initialize() before the channel data types are registered.
+	bSingleChannel = bSingleChannelFastPath;
+}
+
 void USingleChannelDataView::InitServer()
 {
 	Super::InitServer();
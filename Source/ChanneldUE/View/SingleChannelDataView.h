@@ -18,6 +18,8 @@ public:
 	USingleChannelDataView(const FObjectInitializer& ObjectInitializer);
 
 	virtual Channeld::ChannelId GetOwningChannelId(const FNetworkGUID NetId) const override;
+	// Every object is owned by the global channel, so the mapping is not kept.
+	virtual void SetOwningChannelId(const FNetworkGUID NetId, Channeld::ChannelId ChId) override {}
 
 	UPROPERTY(EditAnywhere)
 	FString Metadata;
@@ -28,8 +30,13 @@ public:
 	UPROPERTY(EditAnywhere)
 	int GlobalChannelFanOutDelayMs = 2000;
 
+	// Consume the global channel updates from a flat array of the providers, with the channel data processor bound at the initialization.
+	UPROPERTY(EditAnywhere)
+	bool bSingleChannelFastPath = true;
+
 protected:
 
+	virtual void LoadCmdLineArgs() override;
 	virtual void InitServer() override;
 	virtual void InitClient() override;
 	
@@ -5,6 +5,8 @@
 #include "ChanneldNetDriver.h"
 #include "ChanneldUtils.h"
 #include "ChanneldMetrics.h"
+#include "ChanneldRepClassTable.h"
+#include "ChanneldStaticActorTable.h"
 #include "EngineUtils.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -16,7 +18,9 @@
 #include "GameFramework/PlayerState.h"
 #include "Interest/ClientInterestManager.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/ScopeExit.h"
 #include "Replication/ChanneldReplication.h"
+#include "google/protobuf/struct.pb.h"
 
 USpatialChannelDataView::USpatialChannelDataView(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -29,9 +33,9 @@ UChanneldNetConnection* USpatialChannelDataView::CreateClientConnection(Channeld
 
 	if (auto NetDriver = GetChanneldSubsystem()->GetNetDriver())//NetDriver.IsValid())
 	{
-		if (NetDriver->GetClientConnectionMap().Contains(ConnId))
+		if (UChanneldNetConnection* ExistingConn = NetDriver->GetClientConnection(ConnId))
 		{
-			return NetDriver->GetClientConnectionMap()[ConnId];
+			return ExistingConn;
 		}
 		UChanneldNetConnection* ClientConn = NetDriver->AddChanneldClientConnection(ConnId, ChId);
 		// Create the ControlChannel and set OpenAcked = 1
@@ -153,38 +157,163 @@ void USpatialChannelDataView::ServerHandleHandover(UChanneldConnection* _, Chann
 	unrealpb::SpatialChannelData HandoverData;
 	HandoverMsg->data().UnpackTo(&HandoverData);
 
+	BroadcastOwnershipChange(HandoverMsg->srcchannelid(), HandoverMsg->dstchannelid(), HandoverData);
+
+	if (GetMutableDefault<UChanneldSettings>()->HandoverTimeBudgetMs <= 0)
+	{
+		ProcessHandover(HandoverMsg->srcchannelid(), HandoverMsg->dstchannelid(), HandoverData);
+		return;
+	}
+
+	for (auto& Pair : HandoverData.entities())
+	{
+		FPendingHandover* Pending = PendingHandovers.Find(Pair.first);
+		if (Pending && Pending->DstChId != HandoverMsg->srcchannelid())
+		{
+			// The handovers of the entity are out of order. Don't merge them.
+			FlushPendingHandovers(0);
+			Pending = nullptr;
+		}
+
+		if (Pending == nullptr)
+		{
+			Pending = &PendingHandovers.Emplace(Pair.first, FPendingHandover{HandoverMsg->srcchannelid(), HandoverMsg->dstchannelid(), MakeShared<unrealpb::SpatialEntityState>(Pair.second)});
+		}
+		// The entity moves on before its last handover is processed, e.g. bouncing between the cells. Only the latest state is needed.
+		else
+		{
+			Pending->DstChId = HandoverMsg->dstchannelid();
+			Pending->EntityState = MakeShared<unrealpb::SpatialEntityState>(Pair.second);
+			UE_LOG(LogChanneld, Verbose, TEXT("Coalesced the handovers of entity %d: %d -> %d"), Pair.first, Pending->SrcChId, Pending->DstChId);
+		}
+
+		// Back to where it was.
+		if (Pending->SrcChId == Pending->DstChId)
+		{
+			PendingHandovers.Remove(Pair.first);
+		}
+	}
+
+	if (PendingHandovers.Num() > 0 && !bHandoverTickScheduled)
+	{
+		bHandoverTickScheduled = true;
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &USpatialChannelDataView::TickPendingHandovers);
+	}
+}
+
+void USpatialChannelDataView::TickPendingHandovers()
+{
+	bHandoverTickScheduled = false;
+	FlushPendingHandovers(GetMutableDefault<UChanneldSettings>()->HandoverTimeBudgetMs);
+
+	if (PendingHandovers.Num() > 0 && !bHandoverTickScheduled)
+	{
+		bHandoverTickScheduled = true;
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &USpatialChannelDataView::TickPendingHandovers);
+	}
+}
+
+void USpatialChannelDataView::FlushPendingHandovers(float TimeBudgetMs)
+{
+	CHANNELD_TRACE_SCOPE(Channeld_FlushPendingHandovers);
+	struct FHandoverBatch
+	{
+		Channeld::ChannelId SrcChId;
+		Channeld::ChannelId DstChId;
+		// The PlayerController, Pawn and PlayerState of a player are handed over in the same batch.
+		Channeld::ConnectionId OwningConnId;
+		unrealpb::SpatialChannelData Data;
+	};
+	TArray<FHandoverBatch> Batches;
+	for (auto& Pair : PendingHandovers)
+	{
+		const Channeld::ConnectionId OwningConnId = Pair.Value.EntityState->objref().owningconnid();
+		FHandoverBatch* Batch = Batches.FindByPredicate([&Pair, OwningConnId](const FHandoverBatch& B)
+		{
+			return B.SrcChId == Pair.Value.SrcChId && B.DstChId == Pair.Value.DstChId && B.OwningConnId == OwningConnId;
+		});
+		if (Batch == nullptr)
+		{
+			Batch = &Batches.Add_GetRef(FHandoverBatch{Pair.Value.SrcChId, Pair.Value.DstChId, OwningConnId});
+		}
+		(*Batch->Data.mutable_entities())[Pair.Key].CopyFrom(*Pair.Value.EntityState);
+	}
+	// The players' handovers go first, as the players feel the delay the most.
+	Batches.StableSort([](const FHandoverBatch& A, const FHandoverBatch& B) { return A.OwningConnId > 0 && B.OwningConnId == 0; });
+
+	const double EndTime = FPlatformTime::Seconds() + TimeBudgetMs * 0.001;
+	for (const FHandoverBatch& Batch : Batches)
+	{
+		// At least one batch is processed per flush.
+		if (TimeBudgetMs > 0 && &Batch != Batches.GetData() && FPlatformTime::Seconds() > EndTime)
+		{
+			UE_LOG(LogChanneld, Verbose, TEXT("Deferred %d handover objects to the next tick"), PendingHandovers.Num());
+			break;
+		}
+		for (auto& Pair : Batch.Data.entities())
+		{
+			PendingHandovers.Remove(Pair.first);
+		}
+		ProcessHandover(Batch.SrcChId, Batch.DstChId, Batch.Data);
+	}
+}
+
+void USpatialChannelDataView::ProcessHandover(Channeld::ChannelId SrcChId, Channeld::ChannelId DstChId, const unrealpb::SpatialChannelData& HandoverData)
+{
+	CHANNELD_TRACE_SCOPE(Channeld_Handover);
+	const double StartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
+	{
+		GEngine->GetEngineSubsystem<UChanneldMetrics>()->HandoverDuration_Histogram->Observe((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	};
+
 	// Does current server has interest over the handover objects?
-	const bool bHasInterest = Connection->SubscribedChannels.Contains(HandoverMsg->dstchannelid());
+	const bool bHasInterest = Connection->SubscribedChannels.Contains(DstChId);
 	// Does current server has authority over the handover objects?
-	const bool bHasAuthority = Connection->OwnedChannels.Contains(HandoverMsg->dstchannelid());
+	const bool bHasAuthority = Connection->OwnedChannels.Contains(DstChId);
 	
-	FString NetIds;
-	for (auto& Pair : HandoverData.entities())
+	UE_LOG(LogChanneld, Log, TEXT("ChannelDataHandover from channel %d to %d(%s), %d objects"), SrcChId, DstChId,
+		bHasAuthority ? TEXT("A") : (bHasInterest ? TEXT("I") : TEXT("N")), HandoverData.entities_size());
+	if (UE_LOG_ACTIVE(LogChanneld, Verbose))
 	{
-		NetIds.Appendf(TEXT("%d[%d], "), Pair.second.objref().netguid(), Pair.second.objref().owningconnid());
+		FString NetIds;
+		for (auto& Pair : HandoverData.entities())
+		{
+			NetIds.Appendf(TEXT("%d[%d], "), Pair.second.objref().netguid(), Pair.second.objref().owningconnid());
+		}
+		UE_LOG(LogChanneld, Verbose, TEXT("Handover object netIds: %s"), *NetIds);
 	}
-	UE_LOG(LogChanneld, Log, TEXT("ChannelDataHandover from channel %d to %d(%s), object netIds: %s"), HandoverMsg->srcchannelid(), HandoverMsg->dstchannelid(),
-		bHasAuthority ? TEXT("A") : (bHasInterest ? TEXT("I") : TEXT("N")), *NetIds);
 	
 	// ===== Pass 1: Handle the logic of the source channel =====
-	bool bHasAuthorityOverSourceChannel = Connection->OwnedChannels.Contains(HandoverMsg->srcchannelid());
+	bool bHasAuthorityOverSourceChannel = Connection->OwnedChannels.Contains(SrcChId);
 	for (auto& Pair : HandoverData.entities())
 	{
 		const unrealpb::UnrealObjectRef& HandoverObjRef = Pair.second.objref();
 		FNetworkGUID NetId(HandoverObjRef.netguid());
+		// The owning connection in the cached ref may have changed.
+		if (FChanneldObjRefCache* ObjRefCache = ChanneldUtils::GetObjRefCache(GetWorld()))
+		{
+			ObjRefCache->Remove(NetId.Value);
+		}
 		
 		// Source spatial server - the channel data is handed over from
-		if (Connection->SubscribedChannels.Contains(HandoverMsg->srcchannelid()))
+		if (Connection->SubscribedChannels.Contains(SrcChId))
 		{
 			UObject* HandoverObj = GetObjectFromNetGUID(NetId);
 			// Check if object is already destroyed
 			if (IsValid(HandoverObj))
 			{
-				RemoveObjectProvider(HandoverMsg->srcchannelid(), HandoverObj, bHasAuthorityOverSourceChannel);
+				RemoveObjectProvider(SrcChId, HandoverObj, bHasAuthorityOverSourceChannel);
 				
 				// If the handover actor is no longer in the interest area of current server, delete it.
 				if (!bHasInterest)
 				{
+					// Keep the non-player actor that may come back soon, e.g. moving along the border, instead of spawning it again.
+					if (HandoverObjRef.owningconnid() == 0 && PoolHandoverActor(Cast<AActor>(HandoverObj), NetId))
+					{
+						continue;
+					}
+
 					UE_LOG(LogChanneld, Log, TEXT("[Server] Deleting object %s as it leaves the interest area"), *HandoverObj->GetName());
 					if (AActor* HandoverActor = Cast<AActor>(HandoverObj))
 					{
@@ -215,25 +344,9 @@ void USpatialChannelDataView::ServerHandleHandover(UChanneldConnection* _, Chann
 						// Don't send "removed: true" update to the channel, because the state still exists.
 						RemoveActorProvider(HandoverActor, false);
 						*/
-
-						// HACK: turn off SendDestroyToClients() temporarily - we don't want the actor to be destroyed in the clients.
-						bSuppressSendOnServerDestroy = true;
-						GetWorld()->DestroyActor(HandoverActor, true);
-						bSuppressSendOnServerDestroy = false;
-					}
-					else
-					{
-						HandoverObj->ConditionalBeginDestroy();
 					}
 
-					/* Don't remove the mapping, as it may be used for getting the target channel of unresolvable RPC
-					NetIdOwningChannels.Remove(NetId);
-					*/
-
-					// Remove from the GuidCache so that the object can be re-created in the future cross-server handover.
-					auto GuidCache = GetWorld()->NetDriver->GuidCache;
-					GuidCache->ObjectLookup.Remove(NetId);
-					GuidCache->NetGUIDLookup.Remove(HandoverObj);
+					DestroyHandoverObject(HandoverObj, NetId);
 				}
 				// If the handover actor is no longer in the authority area of current server,
 				// make sure it no longer sends ChannelDataUpdate message.
@@ -252,7 +365,7 @@ void USpatialChannelDataView::ServerHandleHandover(UChanneldConnection* _, Chann
 	if (bHasAuthorityOverSourceChannel && bUpdateSourceChannel)
 	{
 		// Send removal update to the source channel
-		SendChannelUpdate(HandoverMsg->srcchannelid());
+		SendChannelUpdate(SrcChId);
 	}
 	*/
 
@@ -269,11 +382,13 @@ void USpatialChannelDataView::ServerHandleHandover(UChanneldConnection* _, Chann
 		FNetworkGUID NetId(HandoverObjRef.netguid());
 		
 		// Set the NetId-ChannelId mapping before spawn the object, so AddProviderToDefaultChannel won't have to query the spatial channel.
-		SetOwningChannelId(NetId, HandoverMsg->dstchannelid());
+		SetOwningChannelId(NetId, DstChId);
 		
 		// Destination spatial server - the channel data is handed over to
 		if (bHasInterest)
 		{
+			// The actor left the interest area lately. It's updated with the handover data below, like the existing objects.
+			ReactivatePooledHandoverActor(NetId);
 			UObject* HandoverObj = GetObjectFromNetGUID(NetId);
 			// We need to know which client connection causes the handover, in order to spawn the object. 
 			UChanneldNetConnection* ClientConn = nullptr;
@@ -290,13 +405,13 @@ void USpatialChannelDataView::ServerHandleHandover(UChanneldConnection* _, Chann
 					if (ClientInChannels.Contains(ClientConnId))
 					{
 						// Update the channelId for LowLevelSend()
-						ClientInChannels.Emplace(ClientConnId, HandoverMsg->dstchannelid());
-						UE_LOG(LogChanneld, Log, TEXT("[Server] Updated mapping of connId: %d -> channelId: %d"), ClientConnId, HandoverMsg->dstchannelid());
+						ClientInChannels.Emplace(ClientConnId, DstChId);
+						UE_LOG(LogChanneld, Log, TEXT("[Server] Updated mapping of connId: %d -> channelId: %d"), ClientConnId, DstChId);
 					}
 					else
 					{
 						// Create the client connection if it doesn't exist yet. Don't create the PlayerController for now.
-						ClientConn = CreateClientConnection(ClientConnId, HandoverMsg->dstchannelid());
+						ClientConn = CreateClientConnection(ClientConnId, DstChId);
 						UE_LOG(LogChanneld, Log, TEXT("[Server] Create client connection %d during handover, context obj: %d"), ClientConnId, NetId.Value);
 					}
 				
@@ -332,13 +447,13 @@ void USpatialChannelDataView::ServerHandleHandover(UChanneldConnection* _, Chann
 				
 				// Now the NetId is properly set, call AddProviderToDefaultChannel().
 				AddObjectProviderToDefaultChannel(HandoverObj);
-				// MoveObjectProvider(HandoverMsg->srcchannelid(), HandoverMsg->dstchannelid(), HandoverObj, true);
+				// MoveObjectProvider(SrcChId, DstChId, HandoverObj, true);
 				// bUpdateSourceChannel = true;
 				
 				if (bHasAuthority)
 				{
 					// In-server handover - the srcChannel and dstChannel are in the same server
-					if (Connection->OwnedChannels.Contains(HandoverMsg->srcchannelid()))
+					if (Connection->OwnedChannels.Contains(SrcChId))
 					{
 					}
 					// Cross-server handover
@@ -367,7 +482,7 @@ void USpatialChannelDataView::ServerHandleHandover(UChanneldConnection* _, Chann
 			}
 			else if (HandoverObj == nullptr)
 			{
-				UE_LOG(LogChanneld, Error, TEXT("[Server] Failed to spawn object of netId %d from handover obj ref: %s"), NetId.Value, UTF8_TO_TCHAR(HandoverObjRef.DebugString().c_str()));
+				CHANNELD_LOG_RATE_LIMITED(LogChanneld, Error, 1.0, TEXT("[Server] Failed to spawn object of netId %d from handover obj ref: %s"), NetId.Value, UTF8_TO_TCHAR(HandoverObjRef.ShortDebugString().c_str()));
 			}
 			else
 			{
@@ -394,7 +509,7 @@ void USpatialChannelDataView::ServerHandleHandover(UChanneldConnection* _, Chann
 				channeldpb::ChannelDataUpdateMessage UpdateMsg;
 				UpdateMsg.mutable_data()->CopyFrom(Pair->second.entitydata());
 				UE_LOG(LogChanneld, Verbose, TEXT("Applying handover channel data to entity %d"), Pair->first);
-				HandleChannelDataUpdate(_, Pair->first, &UpdateMsg);
+				HandleChannelDataUpdate(Connection, Pair->first, &UpdateMsg);
 			}
 		}
 	}
@@ -447,7 +562,7 @@ void USpatialChannelDataView::ServerHandleHandover(UChanneldConnection* _, Chann
 					if (auto ClientConn = Cast<UChanneldNetConnection>(PC->NetConnection))
 					{
 						// Authority server updates the client's interest area no matter if it's cross-server handover.
-						ClientConn->PlayerEnterSpatialChannelEvent.Broadcast(ClientConn, HandoverMsg->dstchannelid());
+						ClientConn->PlayerEnterSpatialChannelEvent.Broadcast(ClientConn, DstChId);
 					}
 					else
 					{
@@ -477,223 +592,798 @@ void USpatialChannelDataView::ServerHandleHandover(UChanneldConnection* _, Chann
 	GEngine->GetEngineSubsystem<UChanneldMetrics>()->Handovers->Add({{"handoverObjs", std::to_string(HandoverData.entities_size())}, {"crossServerObjs", std::to_string(CrossServerActors.Num())}}).Increment();
 }
 
-void USpatialChannelDataView::ServerHandleSubToChannel(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+void USpatialChannelDataView::DestroyHandoverObject(UObject* HandoverObj, const FNetworkGUID NetId)
 {
-	const auto SubResultMsg = static_cast<const channeldpb::SubscribedToChannelResultMessage*>(Msg);
-	UE_LOG(LogChanneld, Log, TEXT("[Server] Sub %s conn %d to %s channel %d, data access: %s"),
-		SubResultMsg->conntype() == channeldpb::CLIENT ? TEXT("client") : TEXT("server"),
-		SubResultMsg->connid(),
-		UTF8_TO_TCHAR(channeldpb::ChannelType_Name(SubResultMsg->channeltype()).c_str()),
-		ChId,
-		UTF8_TO_TCHAR(channeldpb::ChannelDataAccess_Name(SubResultMsg->suboptions().dataaccess()).c_str()));
-	
-	if (SubResultMsg->channeltype() == channeldpb::SPATIAL)
+	if (AActor* HandoverActor = Cast<AActor>(HandoverObj))
 	{
-		// A client is subscribed to a spatial channel the server owns
-		if (SubResultMsg->conntype() == channeldpb::CLIENT)
-		{
-			/* No need to do anything here - just wait for the client to send the handshake or Hello message.
-			 * Then the server will add the client connection and call OnAddClientConnection()
-			ClientInChannels.Emplace(SubResultMsg->connid(), ChId);
-			if (auto ClientConn = CreateClientConnection(SubResultMsg->connid(), ChId))
-			{
-				GetWorld()->GetAuthGameMode()->RestartPlayer(ClientConn->PlayerController);
-			}
-			*/
-		}
-		// This server has created a spatial channel and has been subscribed to it.
-		else
-		{
-			GetChanneldSubsystem()->SetLowLevelSendToChannelId(ChId);
-		}
+		// HACK: turn off SendDestroyToClients() temporarily - we don't want the actor to be destroyed in the clients.
+		bSuppressSendOnServerDestroy = true;
+		GetWorld()->DestroyActor(HandoverActor, true);
+		bSuppressSendOnServerDestroy = false;
+	}
+	else
+	{
+		HandoverObj->ConditionalBeginDestroy();
 	}
+
+	/* Don't remove the mapping, as it may be used for getting the target channel of unresolvable RPC
+	NetIdOwningChannels.Remove(NetId);
+	*/
+
+	// Remove from the GuidCache so that the object can be re-created in the future cross-server handover.
+	auto GuidCache = GetWorld()->NetDriver->GuidCache;
+	GuidCache->ObjectLookup.Remove(NetId);
+	GuidCache->NetGUIDLookup.Remove(HandoverObj);
 }
 
-void USpatialChannelDataView::ServerHandleClientUnsub(Channeld::ConnectionId ClientConnId, channeldpb::ChannelType ChannelType, Channeld::ChannelId ChId)
+void USpatialChannelDataView::GetNetIdsInUse(TSet<uint32>& OutNetIds) const
 {
-	// A client leaves the spatial channel
-	if (ChannelType == channeldpb::SPATIAL)
+	Super::GetNetIdsInUse(OutNetIds);
+	for (const auto& Pair : PooledHandoverActors)
 	{
-		ClientInChannels.Remove(ClientConnId);
+		OutNetIds.Add(Pair.Key);
 	}
-	// A client leaves the game - close and remove the client connection.
-	else if (ChannelType == channeldpb::GLOBAL)
+	for (const auto& Pair : PendingHandovers)
 	{
-		Super::ServerHandleClientUnsub(ClientConnId, ChannelType, ChId);
+		OutNetIds.Add(Pair.Key);
 	}
 }
 
-void USpatialChannelDataView::OnRemovedProvidersFromChannel(Channeld::ChannelId ChId, channeldpb::ChannelType ChannelType, const TSet<FProviderInternal>& RemovedProviders)
+bool USpatialChannelDataView::PoolHandoverActor(AActor* Actor, const FNetworkGUID NetId)
 {
-	if (Connection->IsServer())
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	if (Actor == nullptr || Settings->HandoverActorPoolTTL <= 0 || Actor->IsA<APlayerController>())
 	{
-		return;
+		return false;
 	}
 
-	if (ChannelType != channeldpb::SPATIAL)
+	int32& NumPooled = NumPooledHandoverActors.FindOrAdd(Actor->GetClass());
+	if (NumPooled >= Settings->MaxPooledHandoverActorsPerClass)
 	{
-		return;
+		return false;
 	}
+	NumPooled++;
 
-	for (const auto& Provider : RemovedProviders)
+	FPooledHandoverActor& Pooled = PooledHandoverActors.Add(NetId.Value);
+	Pooled.Actor = Actor;
+	Pooled.Class = Actor->GetClass();
+	Pooled.ExpireTime = FPlatformTime::Seconds() + Settings->HandoverActorPoolTTL;
+	Pooled.bHidden = Actor->IsHidden();
+	Pooled.bCollisionEnabled = Actor->GetActorEnableCollision();
+	Pooled.bTickEnabled = Actor->IsActorTickEnabled();
+	Actor->ForEachComponent(true, [&Pooled](UActorComponent* Comp)
 	{
-		if (!Provider.IsValid())
+		if (Comp->IsComponentTickEnabled())
 		{
-			continue;
+			Pooled.TickingComponents.Add(Comp);
+			Comp->SetComponentTickEnabled(false);
 		}
+	});
 
-		if (UObject* Obj = Provider->GetTargetObject())
-		{
-			if (!ClientDeleteObject(Obj))
-			{
-				UE_LOG(LogChanneld, Log, TEXT("Skipped deleting the net relevant actor. Now add the provider back to the channel."));
-				AddProvider(ChId, Provider.Get());
-			}
-		}
+	// Make sure it no longer sends ChannelDataUpdate message.
+	Actor->SetRole(ROLE_SimulatedProxy);
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+	UE_LOG(LogChanneld, Verbose, TEXT("[Server] Pooled handover actor %s as it leaves the interest area, netId: %d"), *Actor->GetName(), NetId.Value);
+
+	if (!GetWorld()->GetTimerManager().IsTimerActive(HandoverActorPoolTimer))
+	{
+		GetWorld()->GetTimerManager().SetTimer(HandoverActorPoolTimer, this, &USpatialChannelDataView::RemoveExpiredHandoverActors, 1.0f, true);
 	}
+	return true;
 }
 
-bool USpatialChannelDataView::ClientDeleteObject(UObject* Obj)
+bool USpatialChannelDataView::ReactivatePooledHandoverActor(const FNetworkGUID NetId)
 {
-	UE_LOG(LogChanneld, Log, TEXT("Deleting object that is no longer in the client's interest area: %s"), *Obj->GetName());
-	if (auto Actor = Cast<AActor>(Obj))
+	FPooledHandoverActor Pooled;
+	if (!PooledHandoverActors.RemoveAndCopyValue(NetId.Value, Pooled))
 	{
-		// Skip well-known actors
-		if (Actor->bAlwaysRelevant)
-		{
-			return false;
-		}
-		
-		// AutonomousProxy actors (PlayerControllers, Pawn, PlayerStates, etc.) are always relevant to the client.
-		if (Actor->GetLocalRole() == ROLE_AutonomousProxy)
-		{
-			return false;
-		}
-		
-		// Call the actor's IsNetRelevantFor() to determine if the actor should be deleted or not.
-		if (GetMutableDefault<UChanneldSettings>()->bUseNetRelevancyForUninterestedActors)
-		{
-			if (auto NetDriver = GetChanneldSubsystem()->GetNetDriver())
-			{
-				if (auto PC = NetDriver->GetServerConnection()->PlayerController)
-				{
-					FVector ViewLocation;
-					FRotator ViewRotation;
-					PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
-					if (Actor->IsNetRelevantFor(PC, PC->GetViewTarget(), ViewLocation))
-					{
-						return false;
-					}
-				}
-			}
-		}
-				
-		GetWorld()->DestroyActor(Actor, true);
+		return false;
 	}
-	else
+	NumPooledHandoverActors.FindOrAdd(Pooled.Class)--;
+
+	AActor* Actor = Pooled.Actor.Get();
+	if (!IsValid(Actor))
 	{
-		Obj->ConditionalBeginDestroy();
+		return false;
 	}
-			
-	FNetworkGUID NetId = GetNetId(Obj, false);
 
-	/* Moved to OnDestroyedActor
-	// Unsub from the entity channel
-	if (Connection->SubscribedChannels.Contains(NetId.Value))
+	Actor->SetActorHiddenInGame(Pooled.bHidden);
+	Actor->SetActorEnableCollision(Pooled.bCollisionEnabled);
+	Actor->SetActorTickEnabled(Pooled.bTickEnabled);
+	for (auto& Comp : Pooled.TickingComponents)
 	{
-		Connection->UnsubFromChannel(NetId.Value);
+		if (Comp.IsValid())
+		{
+			Comp->SetComponentTickEnabled(true);
+		}
 	}
-	*/
-	
-	// Remove the object from the GuidCache so it can be re-created in CheckUnspawnedObject() when the client regain the interest.
-	auto GuidCache = GetWorld()->NetDriver->GuidCache;
-	GuidCache->NetGUIDLookup.Remove(Obj);
-	GuidCache->ObjectLookup.Remove(NetId);
-	
+	UE_LOG(LogChanneld, Verbose, TEXT("[Server] Reactivated pooled handover actor %s, netId: %d"), *Actor->GetName(), NetId.Value);
 	return true;
 }
 
-bool USpatialChannelDataView::ConsumeChannelUpdateData(Channeld::ChannelId ChId, google::protobuf::Message* UpdateData)
+void USpatialChannelDataView::RemoveExpiredHandoverActors()
 {
-	// We can't consume the spatial channel update data in the normal merge process.
-	if (auto ChannelInfo = Connection->SubscribedChannels.Find(ChId))
+	const double Now = FPlatformTime::Seconds();
+	for (auto Itr = PooledHandoverActors.CreateIterator(); Itr; ++Itr)
 	{
-		if (ChannelInfo->ChannelType == EChanneldChannelType::ECT_Spatial)
+		if (Itr.Value().ExpireTime > Now)
 		{
-			return false;
+			continue;
+		}
+
+		NumPooledHandoverActors.FindOrAdd(Itr.Value().Class)--;
+		AActor* Actor = Itr.Value().Actor.Get();
+		const FNetworkGUID NetId(Itr.Key());
+		Itr.RemoveCurrent();
+		if (IsValid(Actor))
+		{
+			UE_LOG(LogChanneld, Log, TEXT("[Server] Deleting pooled handover actor %s as it expires"), *Actor->GetName());
+			DestroyHandoverObject(Actor, NetId);
 		}
 	}
-	
-	return Super::ConsumeChannelUpdateData(ChId, UpdateData);
+
+	if (PooledHandoverActors.Num() == 0)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(HandoverActorPoolTimer);
+	}
 }
 
-bool USpatialChannelDataView::CheckUnspawnedObject(Channeld::ChannelId ChId, const google::protobuf::Message* ChannelData)
+void USpatialChannelDataView::ReportReplicationCosts()
 {
-	// Only client needs to spawn the objects.
-	if (Connection->IsServer())
+	if (Visualizer)
 	{
-		return false;
+		Visualizer->ShowReplicationCosts(ChannelReplicationCosts, ProviderClassCollectSeconds);
 	}
+	Super::ReportReplicationCosts();
+}
 
-	auto NetDriver = GetChanneldSubsystem()->GetNetDriver();
-	if (!NetDriver)
+void USpatialChannelDataView::SendSpatialLoadReport()
+{
+	TMap<Channeld::ChannelId, int32> NumEntities;
+	for (auto& Pair : NetIdOwningChannels)
 	{
-		return false;
+		NumEntities.FindOrAdd(Pair.Value)++;
 	}
 
-	EChanneldChannelType ChannelType = GetChanneldSubsystem()->GetChannelTypeByChId(ChId);
-	if (ChannelType == EChanneldChannelType::ECT_Entity)
+	google::protobuf::Struct Report;
+	auto& Fields = *Report.mutable_fields();
+	Fields["gameThreadMs"].set_number_value(FPlatformTime::ToMilliseconds(GGameThreadTime));
+	auto& ChannelFields = *Fields["channels"].mutable_struct_value()->mutable_fields();
+	int32 NumOwnedChannels = 0, NumOwnedEntities = 0;
+	for (auto& Pair : Connection->OwnedChannels)
 	{
-		FNetworkGUID NetGUID(ChId);
-		// Don't use IsGUIDRegistered - the object may still exist in GuidCache but has been deleted.
-		if (auto CacheObj = NetDriver->GuidCache->ObjectLookup.Find(NetGUID))
+		if (Pair.Value.ChannelType != EChanneldChannelType::ECT_Spatial)
 		{
-			if (CacheObj->Object.IsValid())
-			{
-				return false;
-			}
+			continue;
 		}
+		NumOwnedChannels++;
+		NumOwnedEntities += NumEntities.FindRef(Pair.Key);
 
-		auto ObjRefField = ChannelData->GetDescriptor()->field(0);
-		if (ObjRefField == nullptr)
+		// Struct only has string keys.
+		auto& LoadFields = *ChannelFields[TCHAR_TO_UTF8(*FString::FromInt(Pair.Key))].mutable_struct_value()->mutable_fields();
+		LoadFields["entities"].set_number_value(NumEntities.FindRef(Pair.Key));
+		LoadFields["sentBytes"].set_number_value(SentChannelDataBytes.FindRef(Pair.Key));
+	}
+	// The bytes are counted per report interval.
+	SentChannelDataBytes.Reset();
+
+	// The load of the whole server, so channeld can hand over the regions to the less loaded (e.g. newly scaled-out) servers.
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	double Load = Fields["gameThreadMs"].number_value() / Settings->SpatialServerTargetFrameMs;
+	if (Settings->SpatialServerTargetEntities > 0)
+	{
+		Load = FMath::Max(Load, static_cast<double>(NumOwnedEntities) / Settings->SpatialServerTargetEntities);
+	}
+	Fields["load"].set_number_value(Load);
+	GEngine->GetEngineSubsystem<UChanneldMetrics>()->OnSpatialLoadReport(NumOwnedChannels, NumOwnedEntities, Load);
+
+	Connection->Send(Channeld::GlobalChannelId, Channeld::SpatialLoadReportMsgType, Report);
+	UE_LOG(LogChanneld, VeryVerbose, TEXT("[Server] Sent the spatial load report: %s"), UTF8_TO_TCHAR(Report.ShortDebugString().c_str()));
+}
+
+void USpatialChannelDataView::SendSpatialClassSummary()
+{
+	const FChanneldRepClassTable& ClassTable = FChanneldRepClassTable::Get();
+	UChanneldNetDriver* NetDriver = GetChanneldSubsystem()->GetNetDriver();
+	if (!ClassTable.IsLoaded() || NetDriver == nullptr)
+	{
+		return;
+	}
+
+	TMap<Channeld::ChannelId, TSet<int32>> ClassesByChId;
+	for (auto& Pair : NetIdOwningChannels)
+	{
+		const FOwnedChannelInfo* ChannelInfo = Connection->OwnedChannels.Find(Pair.Value);
+		if (ChannelInfo == nullptr || ChannelInfo->ChannelType != EChanneldChannelType::ECT_Spatial)
 		{
-			return true;
+			continue;
 		}
-		if (!ensureMsgf(ObjRefField->name() == "objRef", TEXT("EntityChannelData's first field should be 'objRef' but is '%s'"), UTF8_TO_TCHAR(ObjRefField->name().c_str())))
+		const AActor* Actor = Cast<AActor>(NetDriver->GuidCache->GetObjectFromNetGUID(Pair.Key, false));
+		if (Actor == nullptr)
 		{
-			return true;
+			continue;
 		}
-		if (!ChannelData->GetReflection()->HasField(*ChannelData, ObjRefField))
+		int32* ClassIndex = RepClassTableIndices.Find(Actor->GetClass());
+		if (ClassIndex == nullptr)
 		{
-			return true;
+			ClassIndex = &RepClassTableIndices.Add(Actor->GetClass(), ClassTable.FindClass(Actor->GetClass()->GetPathName()));
 		}
-	
-		auto& ObjRef = static_cast<const unrealpb::UnrealObjectRef&>(ChannelData->GetReflection()->GetMessage(*ChannelData, ObjRefField));
-		TCHAR* ClassPath = UTF8_TO_TCHAR(ObjRef.classpath().c_str());
-		if (UClass* EntityClass = LoadObject<UClass>(nullptr, ClassPath))
+		if (*ClassIndex != INDEX_NONE)
 		{
-			// Do not resolve other PlayerController or PlayerState on the client.
-			if (EntityClass->IsChildOf(APlayerController::StaticClass()) || EntityClass->IsChildOf(APlayerState::StaticClass()))
-			{
-				return true;
-			}
+			ClassesByChId.FindOrAdd(Pair.Value).Add(*ClassIndex);
 		}
+	}
+	if (ClassesByChId.Num() == 0)
+	{
+		return;
+	}
 
-		UE_LOG(LogChanneld, Verbose, TEXT("[Client] Spawning object from unresolved EntityChannelData, NetId: %d"), ObjRef.netguid());
-		UObject* NewObj = ChanneldUtils::GetObjectByRef(&ObjRef, GetWorld());
-		if (NewObj)
+	// Struct only has string keys, and the indices fit in the doubles.
+	google::protobuf::Struct Summary;
+	auto& Fields = *Summary.mutable_fields();
+	for (auto& Pair : ClassesByChId)
+	{
+		auto& ClassList = *Fields[TCHAR_TO_UTF8(*FString::FromInt(Pair.Key))].mutable_list_value();
+		for (const int32 ClassIndex : Pair.Value)
 		{
-			AddObjectProvider(ChId, NewObj);
-			/* We don't know the spatial channel id of the entity yet.
-			OnNetSpawnedObject(NewObj, ChId);
-			*/
+			ClassList.add_values()->set_number_value(ClassIndex);
 		}
 	}
-	else if (ChannelType == EChanneldChannelType::ECT_Spatial)
+	Connection->Broadcast(Channeld::GlobalChannelId, Channeld::SpatialClassSummaryMsgType, Summary, channeldpb::ALL_BUT_SERVER, EChanneldSendLane::ESL_Bulk);
+	UE_LOG(LogChanneld, VeryVerbose, TEXT("[Server] Sent the class summary of %d spatial channels"), ClassesByChId.Num());
+}
+
+void USpatialChannelDataView::ClientHandleSpatialClassSummary(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+{
+	google::protobuf::Struct Summary;
+	if (!Summary.ParseFromString(static_cast<const channeldpb::ServerForwardMessage*>(Msg)->payload()))
 	{
-		auto SpatialChannelData = static_cast<const unrealpb::SpatialChannelData*>(ChannelData);
-		for (auto& Pair : SpatialChannelData->entities())
+		UE_LOG(LogChanneld, Error, TEXT("Failed to parse the payload of the spatial class summary message"));
+		return;
+	}
+
+	for (auto& Pair : Summary.fields())
+	{
+		TArray<int32>& Classes = ChannelClassSummaries.FindOrAdd(FCString::Atoi(UTF8_TO_TCHAR(Pair.first.c_str())));
+		Classes.Reset();
+		for (auto& Value : Pair.second.list_value().values())
+		{
+			Classes.Add(static_cast<int32>(Value.number_value()));
+		}
+	}
+	PreloadNearbyClasses();
+}
+
+void USpatialChannelDataView::PreloadNearbyClasses()
+{
+	const FChanneldRepClassTable& ClassTable = FChanneldRepClassTable::Get();
+	const APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	if (!ClassTable.IsLoaded() || PC == nullptr)
+	{
+		return;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	const float MaxDistSq = FMath::Square(GetMutableDefault<UChanneldSettings>()->ClassPreloadDistance);
+	for (const FChanneldSpatialRegionIndex::FRegion& Region : Connection->GetSpatialRegionIndex().GetRegions())
+	{
+		const TArray<int32>* Classes = ChannelClassSummaries.Find(Region.ChId);
+		if (Classes == nullptr || FBox2D(FVector2D(Region.Bounds.Min), FVector2D(Region.Bounds.Max)).ComputeSquaredDistanceToPoint(FVector2D(ViewLocation)) > MaxDistSq)
+		{
+			continue;
+		}
+
+		for (const int32 ClassIndex : *Classes)
+		{
+			if (ClassIndex < 0 || ClassIndex >= ClassTable.Num() || PreloadRequestedClasses.Contains(ClassIndex))
+			{
+				continue;
+			}
+			PreloadRequestedClasses.Add(ClassIndex);
+
+			const FSoftClassPath ClassPath(ClassTable.GetPathName(ClassIndex));
+			if (UClass* LoadedClass = ClassPath.ResolveClass())
+			{
+				PreloadedClasses.Add(LoadedClass);
+				continue;
+			}
+			UE_LOG(LogChanneld, Verbose, TEXT("[Client] Preloading %s of spatial channel %d"), *ClassPath.ToString(), Region.ChId);
+			LoadPackageAsync(ClassPath.GetLongPackageName(), FLoadPackageAsyncDelegate::CreateWeakLambda(this, [this, ClassPath](const FName&, UPackage*, EAsyncLoadingResult::Type Result)
+			{
+				if (UClass* LoadedClass = ClassPath.ResolveClass())
+				{
+					PreloadedClasses.Add(LoadedClass);
+				}
+			}));
+		}
+	}
+}
+
+void USpatialChannelDataView::SendHandoverPrefetch()
+{
+	const float PrefetchDistance = GetMutableDefault<UChanneldSettings>()->HandoverPrefetchDistance;
+	TMap<Channeld::ChannelId, unrealpb::SpatialChannelData> PrefetchDataByChId;
+	for (auto& Pair : NetIdOwningChannels)
+	{
+		if (!Connection->OwnedChannels.Contains(Pair.Value))
+		{
+			continue;
+		}
+
+		// Only the non-player actors can be pooled in the destination server.
+		AActor* Actor = Cast<AActor>(GetObjectFromNetGUID(Pair.Key));
+		if (!IsValid(Actor) || !Actor->HasAuthority() || Actor->IsA<APlayerController>() || Actor->GetNetConnection() != nullptr)
+		{
+			continue;
+		}
+
+		const FVector Velocity = Actor->GetVelocity();
+		if (Velocity.IsNearlyZero())
+		{
+			continue;
+		}
+
+		// Where the actor will be if it keeps moving for the distance.
+		const FVector ProbeLocation = Actor->GetActorLocation() + Velocity.GetSafeNormal() * PrefetchDistance;
+		const Channeld::ChannelId DstChId = Connection->GetSpatialChannelId(ProbeLocation);
+		if (DstChId == Channeld::InvalidChannelId || Connection->OwnedChannels.Contains(DstChId))
+		{
+			continue;
+		}
+
+		auto& EntityState = (*PrefetchDataByChId.FindOrAdd(DstChId).mutable_entities())[Pair.Key.Value];
+		// The destination server may have none of the NetGUIDs exported yet.
+		EntityState.mutable_objref()->CopyFrom(*ChanneldUtils::GetRefOfObject(Actor, nullptr, true));
+	}
+
+	for (auto& Pair : PrefetchDataByChId)
+	{
+		channeldpb::ChannelDataHandoverMessage PrefetchMsg;
+		PrefetchMsg.set_dstchannelid(Pair.Key);
+		PrefetchMsg.mutable_data()->PackFrom(Pair.Value);
+		Connection->Broadcast(Channeld::GlobalChannelId, Channeld::HandoverPrefetchMsgType, PrefetchMsg, channeldpb::ALL_BUT_CLIENT | channeldpb::ALL_BUT_SENDER, EChanneldSendLane::ESL_Bulk);
+		UE_LOG(LogChanneld, Verbose, TEXT("[Server] Sent handover prefetch of %d entities to channel %d"), Pair.Value.entities_size(), Pair.Key);
+	}
+}
+
+void USpatialChannelDataView::BroadcastOwnershipChange(Channeld::ChannelId SrcChId, Channeld::ChannelId DstChId, const unrealpb::SpatialChannelData& HandoverData)
+{
+	// Only the source server sends it, as soon as the handover arrives. The destination server updates the mapping itself.
+	if (!GetMutableDefault<UChanneldSettings>()->bBroadcastOwnershipChanges || !Connection->OwnedChannels.Contains(SrcChId) || Connection->OwnedChannels.Contains(DstChId))
+	{
+		return;
+	}
+
+	// Only the NetGUIDs are needed, not the states.
+	unrealpb::SpatialChannelData OwnershipData;
+	for (auto& Pair : HandoverData.entities())
+	{
+		(*OwnershipData.mutable_entities())[Pair.first].mutable_objref()->set_netguid(Pair.second.objref().netguid());
+	}
+	if (OwnershipData.entities_size() == 0)
+	{
+		return;
+	}
+
+	channeldpb::ChannelDataHandoverMessage OwnershipMsg;
+	OwnershipMsg.set_srcchannelid(SrcChId);
+	OwnershipMsg.set_dstchannelid(DstChId);
+	OwnershipMsg.mutable_data()->PackFrom(OwnershipData);
+	Connection->Broadcast(Channeld::GlobalChannelId, Channeld::OwnershipChangeMsgType, OwnershipMsg, channeldpb::ALL_BUT_CLIENT | channeldpb::ALL_BUT_SENDER);
+	UE_LOG(LogChanneld, Verbose, TEXT("[Server] Sent the ownership change of %d entities: %d -> %d"), OwnershipData.entities_size(), SrcChId, DstChId);
+}
+
+void USpatialChannelDataView::ServerHandleOwnershipChange(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+{
+	channeldpb::ChannelDataHandoverMessage OwnershipMsg;
+	if (!OwnershipMsg.ParseFromString(static_cast<const channeldpb::ServerForwardMessage*>(Msg)->payload()))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to parse the payload of the ownership change message"));
+		return;
+	}
+
+	// The destination server updates the mapping when it processes the handover.
+	const Channeld::ChannelId DstChId = OwnershipMsg.dstchannelid();
+	if (Connection->OwnedChannels.Contains(DstChId))
+	{
+		return;
+	}
+
+	unrealpb::SpatialChannelData OwnershipData;
+	OwnershipMsg.data().UnpackTo(&OwnershipData);
+	int32 NumUpdated = 0;
+	for (auto& Pair : OwnershipData.entities())
+	{
+		const FNetworkGUID NetId(Pair.first);
+		// Only correct the known mappings, so the map doesn't grow with the objects this server never sees.
+		const Channeld::ChannelId* OwningChId = NetIdOwningChannels.Find(NetId);
+		if (OwningChId == nullptr || *OwningChId == DstChId || IsHandoverPending(NetId))
+		{
+			continue;
+		}
+		SetOwningChannelId(NetId, DstChId);
+		NumUpdated++;
+	}
+	UE_LOG(LogChanneld, Verbose, TEXT("[Server] Updated the owning channel of %d entities to %d"), NumUpdated, DstChId);
+}
+
+void USpatialChannelDataView::ServerHandleSpatialSubOptions(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+{
+	channeldpb::SubscribedToChannelMessage SubMsg;
+	if (!SubMsg.ParseFromString(static_cast<const channeldpb::ServerForwardMessage*>(Msg)->payload()))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to parse the payload of the spatial subscription options message"));
+		return;
+	}
+
+	if (!Connection->OwnedChannels.Contains(ChId))
+	{
+		return;
+	}
+
+	Connection->SubConnectionToChannel(SubMsg.connid(), ChId, &SubMsg.suboptions());
+}
+
+void USpatialChannelDataView::ServerHandleHandoverPrefetch(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+{
+	channeldpb::ChannelDataHandoverMessage PrefetchMsg;
+	if (!PrefetchMsg.ParseFromString(static_cast<const channeldpb::ServerForwardMessage*>(Msg)->payload()))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to parse the payload of the handover prefetch message"));
+		return;
+	}
+
+	// The message is broadcast to all the spatial servers. Only the one that owns the destination channel keeps the actors.
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	if (!Connection->OwnedChannels.Contains(PrefetchMsg.dstchannelid()) || Settings->HandoverActorPoolTTL <= 0)
+	{
+		return;
+	}
+
+	unrealpb::SpatialChannelData PrefetchData;
+	PrefetchMsg.data().UnpackTo(&PrefetchData);
+	for (auto& Pair : PrefetchData.entities())
+	{
+		const FNetworkGUID NetId(Pair.first);
+		if (GetObjectFromNetGUID(NetId) != nullptr)
+		{
+			// Keep the pooled actor as long as it stays close.
+			if (FPooledHandoverActor* Pooled = PooledHandoverActors.Find(NetId.Value))
+			{
+				Pooled->ExpireTime = FPlatformTime::Seconds() + Settings->HandoverActorPoolTTL;
+			}
+			continue;
+		}
+
+		bSuppressAddProviderAndSendOnServerSpawn = true;
+		UObject* PrefetchObj = ChanneldUtils::GetObjectByRef(&Pair.second.objref(), GetWorld(), true, NetConnForSpawn);
+		bSuppressAddProviderAndSendOnServerSpawn = false;
+		if (!IsValid(PrefetchObj))
+		{
+			UE_LOG(LogChanneld, Warning, TEXT("[Server] Failed to spawn the prefetched object of netId %d"), NetId.Value);
+			continue;
+		}
+
+		// The pooled actor is reactivated when the handover arrives, or destroyed when it expires.
+		if (!PoolHandoverActor(Cast<AActor>(PrefetchObj), NetId))
+		{
+			DestroyHandoverObject(PrefetchObj, NetId);
+			continue;
+		}
+		UE_LOG(LogChanneld, Verbose, TEXT("[Server] Spawned the prefetched handover obj: %s"), *PrefetchObj->GetName());
+	}
+}
+
+void USpatialChannelDataView::ServerHandleSubToChannel(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+{
+	const auto SubResultMsg = static_cast<const channeldpb::SubscribedToChannelResultMessage*>(Msg);
+	UE_LOG(LogChanneld, Log, TEXT("[Server] Sub %s conn %d to %s channel %d, data access: %s"),
+		SubResultMsg->conntype() == channeldpb::CLIENT ? TEXT("client") : TEXT("server"),
+		SubResultMsg->connid(),
+		UTF8_TO_TCHAR(channeldpb::ChannelType_Name(SubResultMsg->channeltype()).c_str()),
+		ChId,
+		UTF8_TO_TCHAR(channeldpb::ChannelDataAccess_Name(SubResultMsg->suboptions().dataaccess()).c_str()));
+	
+	if (SubResultMsg->channeltype() == channeldpb::SPATIAL)
+	{
+		// A client is subscribed to a spatial channel the server owns
+		if (SubResultMsg->conntype() == channeldpb::CLIENT)
+		{
+			if (UClientInterestManager* ClientInterestManager = GetClientInterestManager(SubResultMsg->connid()))
+			{
+				ClientInterestManager->OnClientSubscribedToSpatialChannel(ChId);
+			}
+			/* No need to do anything here - just wait for the client to send the handshake or Hello message.
+			 * Then the server will add the client connection and call OnAddClientConnection()
+			ClientInChannels.Emplace(SubResultMsg->connid(), ChId);
+			if (auto ClientConn = CreateClientConnection(SubResultMsg->connid(), ChId))
+			{
+				GetWorld()->GetAuthGameMode()->RestartPlayer(ClientConn->PlayerController);
+			}
+			*/
+		}
+		// This server has created a spatial channel and has been subscribed to it.
+		else
+		{
+			GetChanneldSubsystem()->SetLowLevelSendToChannelId(ChId);
+
+			// Or channeld has subscribed the server to a neighbouring cell.
+			const int32 ServerInterestFanOutIntervalMs = GetMutableDefault<UChanneldSettings>()->ServerInterestFanOutIntervalMs;
+			if (ServerInterestFanOutIntervalMs > 0 && SubResultMsg->connid() == Connection->GetConnId() && !Connection->OwnedChannels.Contains(ChId)
+				// Re-subscribing triggers another result with the new options.
+				&& SubResultMsg->suboptions().fanoutintervalms() != static_cast<uint32>(ServerInterestFanOutIntervalMs))
+			{
+				channeldpb::ChannelSubscriptionOptions SubOptions;
+				SubOptions.set_dataaccess(channeldpb::READ_ACCESS);
+				SubOptions.set_fanoutintervalms(ServerInterestFanOutIntervalMs);
+				for (const FString& Mask : GetMutableDefault<UChanneldSettings>()->ServerInterestDataFieldMasks)
+				{
+					SubOptions.add_datafieldmasks(TCHAR_TO_UTF8(*Mask));
+				}
+				// The server already has the full state of the channel.
+				SubOptions.set_skipfirstfanout(true);
+				Connection->SubToChannel(ChId, &SubOptions);
+				UE_LOG(LogChanneld, Log, TEXT("[Server] Re-subscribed to spatial channel %d with the server interest fan-out interval %dms"), ChId, ServerInterestFanOutIntervalMs);
+			}
+		}
+	}
+	// A client is subscribed to an entity channel the server owns
+	else if (SubResultMsg->channeltype() == channeldpb::ENTITY && SubResultMsg->conntype() == channeldpb::CLIENT)
+	{
+		if (UClientInterestManager* ClientInterestManager = GetClientInterestManager(SubResultMsg->connid()))
+		{
+			ClientInterestManager->OnClientSubscribedToEntityChannel(ChId);
+		}
+	}
+}
+
+UClientInterestManager* USpatialChannelDataView::GetClientInterestManager(Channeld::ConnectionId ClientConnId) const
+{
+	if (auto NetDriver = GetChanneldSubsystem()->GetNetDriver())
+	{
+		if (UChanneldNetConnection* ClientConn = NetDriver->GetClientConnection(ClientConnId))
+		{
+			return ClientConn->ClientInterestManager;
+		}
+	}
+	return nullptr;
+}
+
+void USpatialChannelDataView::ServerHandleClientUnsub(Channeld::ConnectionId ClientConnId, channeldpb::ChannelType ChannelType, Channeld::ChannelId ChId)
+{
+	// A client leaves the spatial channel
+	if (ChannelType == channeldpb::SPATIAL)
+	{
+		ClientInChannels.Remove(ClientConnId);
+		if (UClientInterestManager* ClientInterestManager = GetClientInterestManager(ClientConnId))
+		{
+			ClientInterestManager->OnClientUnsubscribedFromSpatialChannel(ChId);
+		}
+	}
+	else if (ChannelType == channeldpb::ENTITY)
+	{
+		if (UClientInterestManager* ClientInterestManager = GetClientInterestManager(ClientConnId))
+		{
+			ClientInterestManager->OnClientUnsubscribedFromEntityChannel(ChId);
+		}
+	}
+	// A client leaves the game - close and remove the client connection.
+	else if (ChannelType == channeldpb::GLOBAL)
+	{
+		Super::ServerHandleClientUnsub(ClientConnId, ChannelType, ChId);
+	}
+}
+
+void USpatialChannelDataView::OnRemovedProvidersFromChannel(Channeld::ChannelId ChId, channeldpb::ChannelType ChannelType, const FChannelProviders& RemovedProviders)
+{
+	if (Connection->IsServer())
+	{
+		return;
+	}
+
+	if (ChannelType != channeldpb::SPATIAL)
+	{
+		return;
+	}
+
+	for (const FChannelProviders::FEntry& Entry : RemovedProviders.Entries)
+	{
+		const FProviderInternal& Provider = Entry.Provider;
+		if (!Provider.IsValid())
+		{
+			continue;
+		}
+
+		if (UObject* Obj = Provider->GetTargetObject())
+		{
+			if (!ClientDeleteObject(Obj))
+			{
+				UE_LOG(LogChanneld, Log, TEXT("Skipped deleting the net relevant actor. Now add the provider back to the channel."));
+				AddProvider(ChId, Provider.Get());
+			}
+		}
+	}
+}
+
+void USpatialChannelDataView::OnUnsubscribedFromChannel(Channeld::ChannelId ChId, channeldpb::ChannelType ChannelType)
+{
+	if (Connection->IsServer())
+	{
+		return;
+	}
+
+	// The client has lost interest in the objects found in the channel. Check their classes again if they come back.
+	for (auto It = IgnoredUnresolvedNetIds.CreateIterator(); It; ++It)
+	{
+		if (It.Value() == ChId)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void USpatialChannelDataView::OnDisconnect()
+{
+	IgnoredUnresolvedNetIds.Empty();
+	Super::OnDisconnect();
+}
+
+bool USpatialChannelDataView::ClientDeleteObject(UObject* Obj)
+{
+	UE_LOG(LogChanneld, Log, TEXT("Deleting object that is no longer in the client's interest area: %s"), *Obj->GetName());
+	if (auto Actor = Cast<AActor>(Obj))
+	{
+		// Skip well-known actors
+		if (Actor->bAlwaysRelevant)
+		{
+			return false;
+		}
+		
+		// AutonomousProxy actors (PlayerControllers, Pawn, PlayerStates, etc.) are always relevant to the client.
+		if (Actor->GetLocalRole() == ROLE_AutonomousProxy)
+		{
+			return false;
+		}
+		
+		// Call the actor's IsNetRelevantFor() to determine if the actor should be deleted or not.
+		if (GetMutableDefault<UChanneldSettings>()->bUseNetRelevancyForUninterestedActors)
+		{
+			if (auto NetDriver = GetChanneldSubsystem()->GetNetDriver())
+			{
+				if (auto PC = NetDriver->GetServerConnection()->PlayerController)
+				{
+					FVector ViewLocation;
+					FRotator ViewRotation;
+					PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+					if (Actor->IsNetRelevantFor(PC, PC->GetViewTarget(), ViewLocation))
+					{
+						return false;
+					}
+				}
+			}
+		}
+				
+		GetWorld()->DestroyActor(Actor, true);
+	}
+	else
+	{
+		Obj->ConditionalBeginDestroy();
+	}
+			
+	FNetworkGUID NetId = GetNetId(Obj, false);
+
+	/* Moved to OnDestroyedActor
+	// Unsub from the entity channel
+	if (Connection->SubscribedChannels.Contains(NetId.Value))
+	{
+		Connection->UnsubFromChannel(NetId.Value);
+	}
+	*/
+	
+	// Remove the object from the GuidCache so it can be re-created in CheckUnspawnedObject() when the client regain the interest.
+	auto GuidCache = GetWorld()->NetDriver->GuidCache;
+	GuidCache->NetGUIDLookup.Remove(Obj);
+	GuidCache->ObjectLookup.Remove(NetId);
+	
+	return true;
+}
+
+bool USpatialChannelDataView::ConsumeChannelUpdateData(Channeld::ChannelId ChId, google::protobuf::Message* UpdateData)
+{
+	// We can't consume the spatial channel update data in the normal merge process.
+	if (auto ChannelInfo = Connection->SubscribedChannels.Find(ChId))
+	{
+		if (ChannelInfo->ChannelType == EChanneldChannelType::ECT_Spatial)
+		{
+			return false;
+		}
+		if (ChannelInfo->ChannelType == EChanneldChannelType::ECT_Entity && Connection->IsClient() && GetMutableDefault<UChanneldSettings>()->bGroupLowImportanceEntities)
+		{
+			AddEntityGroupMembers(ChId, UpdateData);
+		}
+	}
+	
+	return Super::ConsumeChannelUpdateData(ChId, UpdateData);
+}
+
+bool USpatialChannelDataView::CheckUnspawnedObject(Channeld::ChannelId ChId, const google::protobuf::Message* ChannelData)
+{
+	// Only client needs to spawn the objects, except the standby server for the channels of the server it backs up.
+	if (Connection->IsServer() && !IsStandbyChannel(ChId))
+	{
+		return false;
+	}
+
+	auto NetDriver = GetChanneldSubsystem()->GetNetDriver();
+	if (!NetDriver)
+	{
+		return false;
+	}
+
+	EChanneldChannelType ChannelType = GetChanneldSubsystem()->GetChannelTypeByChId(ChId);
+	if (ChannelType == EChanneldChannelType::ECT_Entity)
+	{
+		FNetworkGUID NetGUID(ChId);
+		// Don't use IsGUIDRegistered - the object may still exist in GuidCache but has been deleted.
+		if (auto CacheObj = NetDriver->GuidCache->ObjectLookup.Find(NetGUID))
+		{
+			if (CacheObj->Object.IsValid())
+			{
+				return false;
+			}
+		}
+
+		auto ObjRefField = ChannelData->GetDescriptor()->field(0);
+		if (ObjRefField == nullptr)
+		{
+			return true;
+		}
+		if (!ensureMsgf(ObjRefField->name() == "objRef", TEXT("EntityChannelData's first field should be 'objRef' but is '%s'"), UTF8_TO_TCHAR(ObjRefField->name().c_str())))
+		{
+			return true;
+		}
+		if (!ChannelData->GetReflection()->HasField(*ChannelData, ObjRefField))
+		{
+			return true;
+		}
+		// The entity is going to be spawned from the spatial channel data. Hold the update until then.
+		if (PendingSpawnObjRefs.Contains(ChId))
+		{
+			return true;
+		}
+	
+		auto& ObjRef = static_cast<const unrealpb::UnrealObjectRef&>(ChannelData->GetReflection()->GetMessage(*ChannelData, ObjRefField));
+		if (!ShouldSpawnUnresolvedObject(ObjRef, ChId))
+		{
+			return true;
+		}
+		TryCountClientSpawn();
+
+		UE_LOG(LogChanneld, Verbose, TEXT("[Client] Spawning object from unresolved EntityChannelData, NetId: %d"), ObjRef.netguid());
+		UObject* NewObj = ChanneldUtils::GetObjectByRef(&ObjRef, GetWorld());
+		if (NewObj)
+		{
+			AddObjectProvider(ChId, NewObj);
+			/* We don't know the spatial channel id of the entity yet.
+			OnNetSpawnedObject(NewObj, ChId);
+			*/
+		}
+	}
+	else if (ChannelType == EChanneldChannelType::ECT_Spatial)
+	{
+		auto SpatialChannelData = static_cast<const unrealpb::SpatialChannelData*>(ChannelData);
+		for (auto& Pair : SpatialChannelData->entities())
 		{
+			// The entity has left the spatial channel.
+			if (Pair.second.removed())
+			{
+				IgnoredUnresolvedNetIds.Remove(Pair.first);
+				continue;
+			}
 			FNetworkGUID NetGUID(Pair.first);
 			// Don't use IsGUIDRegistered - the object may still exist in GuidCache but has been deleted.
 			if (auto CacheObj = NetDriver->GuidCache->ObjectLookup.Find(NetGUID))
@@ -704,37 +1394,161 @@ bool USpatialChannelDataView::CheckUnspawnedObject(Channeld::ChannelId ChId, con
 				}
 			}
 
-			auto& ObjRef = Pair.second.objref();
-			TCHAR* ClassPath = UTF8_TO_TCHAR(ObjRef.classpath().c_str());
-			if (UClass* EntityClass = LoadObject<UClass>(nullptr, ClassPath))
+			if (PendingSpawnObjRefs.Contains(Pair.first))
+			{
+				continue;
+			}
+
+			auto& ObjRef = Pair.second.objref();
+			if (!ShouldSpawnUnresolvedObject(ObjRef, ChId))
+			{
+				continue;
+			}
+
+			// Set up the mapping before actually spawn it, so AddProvider() can find the mapping.
+			SetOwningChannelId(ObjRef.netguid(), ChId);
+			
+			// Also add the mapping of all context NetGUIDs
+			for (auto& ContextObj : ObjRef.context())
+			{
+				SetOwningChannelId(ContextObj.netguid(), ChId);
+			}
+
+			if (!TryCountClientSpawn())
+			{
+				// The rest of the update is still applied to the spawned entities.
+				PendingSpawnObjRefs.Add(Pair.first, ObjRef);
+				if (!bPendingSpawnTickScheduled)
+				{
+					bPendingSpawnTickScheduled = true;
+					GetWorld()->GetTimerManager().SetTimerForNextTick(this, &USpatialChannelDataView::SpawnPendingObjects);
+				}
+				continue;
+			}
+
+			UE_LOG(LogChanneld, Verbose, TEXT("[Client] Spawning object from unresolved SpatialEntityState, NetId: %d"), ObjRef.netguid());
+			UObject* NewObj = SpawnUnresolvedObject(ObjRef);
+			if (NewObj)
+			{
+				AddObjectProviderToDefaultChannel(NewObj);
+				OnNetSpawnedObject(NewObj, ChId);
+			}
+		}
+	}
+	
+	return false;
+}
+
+bool USpatialChannelDataView::ShouldSpawnUnresolvedObject(const unrealpb::UnrealObjectRef& ObjRef, Channeld::ChannelId ChId)
+{
+	if (IgnoredUnresolvedNetIds.Contains(ObjRef.netguid()))
+	{
+		return false;
+	}
+	// The spawn message is waiting for the class to load.
+	if (HoldingUpdatesNetGUIDs.Contains(ObjRef.netguid()))
+	{
+		return false;
+	}
+
+	const FString ClassPath = ChanneldUtils::DecodeObjRefPath(ObjRef.classpath());
+	if (UClass* EntityClass = LoadObject<UClass>(nullptr, *ClassPath))
+	{
+		// Do not resolve other PlayerController or PlayerState on the client.
+		if (EntityClass->IsChildOf(APlayerController::StaticClass()) || EntityClass->IsChildOf(APlayerState::StaticClass()))
+		{
+			IgnoredUnresolvedNetIds.Add(ObjRef.netguid(), ChId);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool USpatialChannelDataView::TryCountClientSpawn()
+{
+	if (ClientSpawnFrame != GFrameCounter)
+	{
+		ClientSpawnFrame = GFrameCounter;
+		NumClientSpawnsInFrame = 0;
+	}
+
+	const int32 MaxSpawns = GetMutableDefault<UChanneldSettings>()->MaxClientSpawnsPerTick;
+	if (MaxSpawns > 0 && NumClientSpawnsInFrame >= MaxSpawns)
+	{
+		return false;
+	}
+	NumClientSpawnsInFrame++;
+	return true;
+}
+
+void USpatialChannelDataView::SpawnPendingObjects()
+{
+	bPendingSpawnTickScheduled = false;
+	auto NetDriver = GetChanneldSubsystem()->GetNetDriver();
+	if (!NetDriver)
+	{
+		PendingSpawnObjRefs.Empty();
+		return;
+	}
+
+	for (auto It = PendingSpawnObjRefs.CreateIterator(); It; ++It)
+	{
+		if (!TryCountClientSpawn())
+		{
+			break;
+		}
+
+		const unrealpb::UnrealObjectRef ObjRef = MoveTemp(It->Value);
+		It.RemoveCurrent();
+		FNetworkGUID NetGUID(ObjRef.netguid());
+		if (auto CacheObj = NetDriver->GuidCache->ObjectLookup.Find(NetGUID))
+		{
+			if (CacheObj->Object.IsValid())
 			{
-				// Do not resolve other PlayerController on the client.
-				if (EntityClass->IsChildOf(APlayerController::StaticClass()) || EntityClass->IsChildOf(APlayerState::StaticClass()))
-				{
-					continue;
-				}
+				continue;
 			}
+		}
 
-			// Set up the mapping before actually spawn it, so AddProvider() can find the mapping.
-			SetOwningChannelId(ObjRef.netguid(), ChId);
-			
-			// Also add the mapping of all context NetGUIDs
-			for (auto& ContextObj : ObjRef.context())
-			{
-				SetOwningChannelId(ContextObj.netguid(), ChId);
-			}
+		// The entity may have been handed over since it's queued.
+		const Channeld::ChannelId ChId = GetOwningChannelId(NetGUID);
+		UE_LOG(LogChanneld, Verbose, TEXT("[Client] Spawning object from pending SpatialEntityState, NetId: %d"), ObjRef.netguid());
+		UObject* NewObj = SpawnUnresolvedObject(ObjRef);
+		if (NewObj)
+		{
+			AddObjectProviderToDefaultChannel(NewObj);
+			OnNetSpawnedObject(NewObj, ChId);
 
-			UE_LOG(LogChanneld, Verbose, TEXT("[Client] Spawning object from unresolved SpatialEntityState, NetId: %d"), ObjRef.netguid());
-			UObject* NewObj = ChanneldUtils::GetObjectByRef(&ObjRef, GetWorld());
-			if (NewObj)
+			// The update of the entity channel (which channelId equals to the NetId) is held until the entity is spawned.
+			if (auto UpdateData = ReceivedUpdateDataInChannels.FindRef(NetGUID.Value))
 			{
-				AddObjectProviderToDefaultChannel(NewObj);
-				OnNetSpawnedObject(NewObj, ChId);
+				ConsumeChannelUpdateData(NetGUID.Value, UpdateData);
 			}
 		}
 	}
-	
-	return false;
+
+	if (PendingSpawnObjRefs.Num() > 0)
+	{
+		bPendingSpawnTickScheduled = true;
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &USpatialChannelDataView::SpawnPendingObjects);
+	}
+}
+
+UObject* USpatialChannelDataView::SpawnUnresolvedObject(const unrealpb::UnrealObjectRef& ObjRef)
+{
+	if (Connection->IsClient())
+	{
+		return ChanneldUtils::GetObjectByRef(&ObjRef, GetWorld());
+	}
+
+	// The standby server doesn't create the entity channel or send the spawn, as the entity is still owned by the other server.
+	bSuppressAddProviderAndSendOnServerSpawn = true;
+	UObject* NewObj = ChanneldUtils::GetObjectByRef(&ObjRef, GetWorld(), true, NetConnForSpawn);
+	bSuppressAddProviderAndSendOnServerSpawn = false;
+	if (AActor* Actor = Cast<AActor>(NewObj))
+	{
+		Actor->SetRole(ROLE_SimulatedProxy);
+	}
+	return NewObj;
 }
 
 void USpatialChannelDataView::SendExistingActorsToNewPlayer(APlayerController* NewPlayer, UChanneldNetConnection* NewPlayerConn)
@@ -744,35 +1558,38 @@ void USpatialChannelDataView::SendExistingActorsToNewPlayer(APlayerController* N
 	// FIXME: move to the ServerAcknowledgePossession()
 	GetWorld()->GetTimerManager().SetTimer(Handle, [this, NewPlayer, NewPlayerConn]()
 	{
-		for(TActorIterator<AActor> It(GetWorld(), AActor::StaticClass()); It; ++It)
-		{
-			AActor* Actor = *It;
-			if (Actor != NewPlayer->GetPawn() && Actor->HasAuthority() && Actor->GetIsReplicated() &&
-				!Actor->IsA<AGameModeBase>() && !Actor->IsA<APlayerController>() && !Actor->IsA<APlayerState>())
-			{
-				if (Actor->GetWorld() == nullptr)
-				{
-					UE_LOG(LogChanneld, Warning, TEXT("%s->GetWorld() is null!"), *GetNameSafe(Actor));
-					continue;
-				}
+		UChannelDataView::SendExistingActorsToNewPlayer(NewPlayer, NewPlayerConn);
+	}, 1, false, 2.0f);
+}
+
+bool USpatialChannelDataView::ShouldSendExistingActorToNewPlayer(AActor* Actor, APlayerController* NewPlayer)
+{
+	return Actor != NewPlayer->GetPawn() && Actor->HasAuthority() && Actor->GetIsReplicated() &&
+		!Actor->IsA<AGameModeBase>() && !Actor->IsA<APlayerController>() && !Actor->IsA<APlayerState>();
+}
 
-				// No need to call OnServerSpawnedObject -> AddObjectProviderToDefaultChannel
-				// as static actor are already added in SyncNetGUIDs()
+void USpatialChannelDataView::SendExistingActorToNewPlayer(AActor* Actor, APlayerController* NewPlayer, UChanneldNetConnection* NewPlayerConn)
+{
+	if (Actor->GetWorld() == nullptr)
+	{
+		UE_LOG(LogChanneld, Warning, TEXT("%s->GetWorld() is null!"), *GetNameSafe(Actor));
+		return;
+	}
 
-				uint32 OwningConnId = 0;
-				if (auto NetConn = Cast<UChanneldNetConnection>(Actor->GetNetConnection()))
-				{
-					OwningConnId = NetConn->GetConnId();
-				}
-				else
-				{
-					// Character should have owner connection at this moment.
-					ensureAlwaysMsgf(!Actor->IsA<ACharacter>(), TEXT("%s doesn't have a valid NetConnection"), *GetNameSafe(Actor));
-				}
-				SendSpawnToConn(Actor, NewPlayerConn, OwningConnId);
-			}
-		}
-	}, 1, false, 2.0f);
+	// No need to call OnServerSpawnedObject -> AddObjectProviderToDefaultChannel
+	// as static actor are already added in SyncNetGUIDs()
+
+	uint32 OwningConnId = 0;
+	if (auto NetConn = Cast<UChanneldNetConnection>(Actor->GetNetConnection()))
+	{
+		OwningConnId = NetConn->GetConnId();
+	}
+	else
+	{
+		// Character should have owner connection at this moment.
+		ensureAlwaysMsgf(!Actor->IsA<ACharacter>(), TEXT("%s doesn't have a valid NetConnection"), *GetNameSafe(Actor));
+	}
+	SendSpawnToConn(Actor, NewPlayerConn, OwningConnId);
 }
 
 void USpatialChannelDataView::ClientHandleGetUnrealObjectRef(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
@@ -800,110 +1617,424 @@ void USpatialChannelDataView::ClientHandleGetUnrealObjectRef(UChanneldConnection
 		ResolvingNetGUIDs.Remove(ObjRef.netguid());
 	}
 
-	// Now there should be no unresolved object in the channel, so we can consume the accumulated data.
-	if (auto UpdateData = ReceivedUpdateDataInChannels.FindRef(ChId))
+	// Now there should be no unresolved object in the channel, so we can consume the accumulated data.
+	if (auto UpdateData = ReceivedUpdateDataInChannels.FindRef(ChId))
+	{
+		ConsumeChannelUpdateData(ChId, UpdateData);
+	}
+}
+
+void USpatialChannelDataView::InitServer()
+{
+	// Spatial server has no authority over the GameState.
+	GetWorld()->GetAuthGameMode()->GameState->SetRole(ENetRole::ROLE_SimulatedProxy);
+	Super::InitServer();
+	
+	if (UClass* PlayerStartLocatorClass = GetMutableDefault<UChanneldSettings>()->PlayerStartLocatorClass)
+	{
+		PlayerStartLocator = NewObject<UPlayerStartLocatorBase>(this, PlayerStartLocatorClass);
+	}
+	ensureAlwaysMsgf(PlayerStartLocator, TEXT("[Server] SpatialChannelDataView has not specified the PlayerStartLocatorClass."));
+
+	// Set the player's start position selected by the locator.
+	FGameModeEvents::GameModePostLoginEvent.AddLambda([&](AGameModeBase* GameMode, APlayerController* NewPlayer)
+	{
+		auto NetConn = Cast<UChanneldNetConnection>(NewPlayer->GetNetConnection());
+		AActor* StartSpot = nullptr;
+		FVector StartPos = PlayerStartLocator->GetPlayerStartPosition(NetConn->GetConnId(), StartSpot);
+		// Spawn a PlayerStart actor if it doesn't exist.
+		if (!StartSpot)
+		{
+			StartSpot = GetWorld()->SpawnActor<APlayerStart>();
+			StartSpot->SetActorLocation(StartPos);
+		}
+		NewPlayer->StartSpot = StartSpot;
+		NewPlayer->SetInitialLocationAndRotation(StartPos, NewPlayer->GetControlRotation());
+		UE_LOG(LogChanneld, Log, TEXT("%s selected %s for client %d"), *PlayerStartLocator->GetName(), *StartPos.ToCompactString(), NetConn->GetConnId());
+	});
+	
+	Connection->AddMessageHandler(channeldpb::SUB_TO_CHANNEL, this, &USpatialChannelDataView::ServerHandleSubToChannel);
+	
+	Connection->AddMessageHandler(channeldpb::CHANNEL_DATA_HANDOVER, this, &USpatialChannelDataView::ServerHandleHandover);
+
+	Connection->RegisterMessageHandler(channeldpb::SPATIAL_CHANNELS_READY, new channeldpb::SpatialChannelsReadyMessage, this, &USpatialChannelDataView::ServerHandleSpatialChannelsReady);
+	Connection->RegisterMessageHandler(unrealpb::SYNC_NET_ID, new channeldpb::ServerForwardMessage, this, &USpatialChannelDataView::ServerHandleSyncNetId);
+	Connection->RegisterMessageHandler(Channeld::HandoverPrefetchMsgType, new channeldpb::ServerForwardMessage, this, &USpatialChannelDataView::ServerHandleHandoverPrefetch);
+	Connection->RegisterMessageHandler(Channeld::OwnershipChangeMsgType, new channeldpb::ServerForwardMessage, this, &USpatialChannelDataView::ServerHandleOwnershipChange);
+	Connection->RegisterMessageHandler(Channeld::SpatialSubOptionsMsgType, new channeldpb::ServerForwardMessage, this, &USpatialChannelDataView::ServerHandleSpatialSubOptions);
+
+	Connection->RegisterMessageHandler(unrealpb::SERVER_PLAYER_LEAVE, new channeldpb::ServerForwardMessage, [&](UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+	{
+		channeldpb::UnsubscribedFromChannelResultMessage UnsubMsg;
+		if (UnsubMsg.ParseFromString(static_cast<const channeldpb::ServerForwardMessage*>(Msg)->payload()))
+		{
+			ServerHandleClientUnsub(UnsubMsg.connid(), UnsubMsg.channeltype(), ChId);
+		}
+		else
+		{
+			UE_LOG(LogChanneld, Error, TEXT("Failed to parse the payload of the SERVER_PLAYER_LEAVE message to UnsubscribedFromChannelResultMessage. ChannelId: %d"), ChId);
+		}
+	});
+
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	for (const int32 StandbyChId : Settings->StandbySpatialChannelIds)
+	{
+		StandbyHeartbeatTimes.Add(StandbyChId, 0);
+	}
+	if (StandbyHeartbeatTimes.Num() > 0)
+	{
+		Connection->RegisterMessageHandler(Channeld::SpatialOwnerHeartbeatMsgType, new channeldpb::ServerForwardMessage, this, &USpatialChannelDataView::ServerHandleSpatialOwnerHeartbeat);
+		GetWorld()->GetTimerManager().SetTimer(StandbyFailoverTimer, this, &USpatialChannelDataView::CheckStandbyOwners, Settings->StandbyFailoverTimeout * 0.5f, true);
+	}
+
+	// Only the master server has the write access to the GLOBAL channel.
+	channeldpb::ChannelSubscriptionOptions SubOptions;
+	SubOptions.set_dataaccess(channeldpb::READ_ACCESS);
+	Connection->SubToChannel(Channeld::GlobalChannelId, &SubOptions, [&](const channeldpb::SubscribedToChannelResultMessage* _)
+	{
+		// The standby server keeps the entities of the channels warm, until it takes over them.
+		if (StandbyHeartbeatTimes.Num() > 0)
+		{
+			channeldpb::ChannelSubscriptionOptions StandbySubOptions;
+			StandbySubOptions.set_dataaccess(channeldpb::READ_ACCESS);
+			for (auto& Pair : StandbyHeartbeatTimes)
+			{
+				Connection->SubToChannel(Pair.Key, &StandbySubOptions);
+			}
+			UE_LOG(LogChanneld, Log, TEXT("[Server] Running as the standby server of %d spatial channels"), StandbyHeartbeatTimes.Num());
+			return;
+		}
+
+		channeldpb::ChannelSubscriptionOptions SpatialSubOptions;
+		SpatialSubOptions.set_dataaccess(channeldpb::WRITE_ACCESS);
+		
+		Connection->CreateSpatialChannel(TEXT(""), &SpatialSubOptions, ChannelInitData ? ChannelInitData->GetMessage() : nullptr, nullptr,
+			[this](const channeldpb::CreateSpatialChannelsResultMessage* ResultMsg)
+		{
+			FString StrChIds;
+			for (int i = 0; i < ResultMsg->spatialchannelid_size(); i++)
+			{
+				StrChIds.AppendInt(ResultMsg->spatialchannelid(i));
+				if (i < ResultMsg->spatialchannelid_size() - 1)
+					StrChIds.AppendChar(',');
+			}
+			UE_LOG(LogChanneld, Log, TEXT("Created spatial channels: %s"), *StrChIds);
+		});
+	});
+}
+
+void USpatialChannelDataView::ServerHandleSpatialChannelsReady(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+{
+	auto readyMsg = static_cast<const channeldpb::SpatialChannelsReadyMessage*>(Msg);
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	if (Settings->SpatialClassSummaryInterval > 0)
+	{
+		GetWorld()->GetTimerManager().SetTimer(SpatialClassSummaryTimer, this, &USpatialChannelDataView::SendSpatialClassSummary, Settings->SpatialClassSummaryInterval, true);
+	}
+	if (Settings->SpatialOwnerHeartbeatInterval > 0)
+	{
+		GetWorld()->GetTimerManager().SetTimer(SpatialOwnerHeartbeatTimer, this, &USpatialChannelDataView::SendSpatialOwnerHeartbeat, Settings->SpatialOwnerHeartbeatInterval, true);
+	}
+
+	if (readyMsg->servercount() > 1)
+	{
+		bIsSyncingNetId = true;
+		UE_LOG(LogChanneld, Log, TEXT("All spatial channels are ready. Start synchronizing NetIds between spatial servers."));
+		SyncNetIds();
+
+		if (Settings->bSyncStreamedLevelActors)
+		{
+			LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &USpatialChannelDataView::OnLevelAddedToWorld);
+			LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &USpatialChannelDataView::OnLevelRemovedFromWorld);
+		}
+
+		if (Settings->HandoverPrefetchDistance > 0)
+		{
+			// The prefetch looks up the destination channel in the spatial region index.
+			Connection->RequestSpatialRegions();
+			GetWorld()->GetTimerManager().SetTimer(HandoverPrefetchTimer, this, &USpatialChannelDataView::SendHandoverPrefetch, Settings->HandoverPrefetchInterval, true);
+		}
+		if (Settings->SpatialLoadReportInterval > 0)
+		{
+			SentChannelDataBytes.Reset();
+			GetWorld()->GetTimerManager().SetTimer(SpatialLoadReportTimer, this, &USpatialChannelDataView::SendSpatialLoadReport, Settings->SpatialLoadReportInterval, true);
+		}
+	}
+}
+
+void USpatialChannelDataView::SendSpatialOwnerHeartbeat()
+{
+	channeldpb::CreateSpatialChannelsResultMessage HeartbeatMsg;
+	for (auto& Pair : Connection->OwnedChannels)
+	{
+		if (Pair.Value.ChannelType == EChanneldChannelType::ECT_Spatial)
+		{
+			HeartbeatMsg.add_spatialchannelid(Pair.Key);
+		}
+	}
+	if (HeartbeatMsg.spatialchannelid_size() == 0)
+	{
+		return;
+	}
+	HeartbeatMsg.set_ownerconnid(Connection->GetConnId());
+	Connection->Broadcast(Channeld::GlobalChannelId, Channeld::SpatialOwnerHeartbeatMsgType, HeartbeatMsg, channeldpb::ALL_BUT_CLIENT | channeldpb::ALL_BUT_SENDER);
+}
+
+void USpatialChannelDataView::ServerHandleSpatialOwnerHeartbeat(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+{
+	channeldpb::CreateSpatialChannelsResultMessage HeartbeatMsg;
+	if (!HeartbeatMsg.ParseFromString(static_cast<const channeldpb::ServerForwardMessage*>(Msg)->payload()))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to parse the payload of the spatial owner heartbeat message"));
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	for (const Channeld::ChannelId SpatialChId : HeartbeatMsg.spatialchannelid())
+	{
+		if (double* LastTime = StandbyHeartbeatTimes.Find(SpatialChId))
+		{
+			*LastTime = Now;
+		}
+	}
+}
+
+void USpatialChannelDataView::CheckStandbyOwners()
+{
+	const double Now = FPlatformTime::Seconds();
+	const float Timeout = GetMutableDefault<UChanneldSettings>()->StandbyFailoverTimeout;
+	TArray<Channeld::ChannelId> LostChIds;
+	for (auto& Pair : StandbyHeartbeatTimes)
+	{
+		// Never take over a channel without a heartbeat, as its owner may just not send them.
+		if (Pair.Value > 0 && Now - Pair.Value > Timeout)
+		{
+			LostChIds.Add(Pair.Key);
+		}
+	}
+
+	for (const Channeld::ChannelId LostChId : LostChIds)
+	{
+		StandbyHeartbeatTimes.Remove(LostChId);
+		TakeOverStandbyChannel(LostChId);
+	}
+	if (StandbyHeartbeatTimes.Num() == 0)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(StandbyFailoverTimer);
+	}
+}
+
+void USpatialChannelDataView::TakeOverStandbyChannel(Channeld::ChannelId ChId)
+{
+	UE_LOG(LogChanneld, Warning, TEXT("[Server] The owning server of the standby channel %d is lost, taking over the channel"), ChId);
+	channeldpb::ChannelSubscriptionOptions SubOptions;
+	SubOptions.set_dataaccess(channeldpb::WRITE_ACCESS);
+	Connection->SubToChannel(ChId, &SubOptions, [this, ChId, SubOptions](const channeldpb::SubscribedToChannelResultMessage* ResultMsg)
+	{
+		if (ResultMsg->suboptions().dataaccess() != channeldpb::WRITE_ACCESS)
+		{
+			UE_LOG(LogChanneld, Error, TEXT("[Server] Failed to take over the standby channel %d, as channeld didn't grant the write access"), ChId);
+			return;
+		}
+
+		FOwnedChannelInfo ChannelInfo;
+		ChannelInfo.ChannelType = EChanneldChannelType::ECT_Spatial;
+		ChannelInfo.ChannelId = ChId;
+		ChannelInfo.OwnerConnId = Connection->GetConnId();
+		Connection->OwnedChannels.Add(ChId, ChannelInfo);
+
+		// The entities are already spawned and up to date. Only the authority moves to this server.
+		int32 NumPromoted = 0;
+		for (auto& Pair : NetIdOwningChannels)
+		{
+			if (Pair.Value != ChId)
+			{
+				continue;
+			}
+			AActor* Actor = Cast<AActor>(GetObjectFromNetGUID(Pair.Key));
+			if (!IsValid(Actor))
+			{
+				continue;
+			}
+			// The entity channel was owned by the lost server as well.
+			if (Connection->SubscribedChannels.Contains(Pair.Key.Value))
+			{
+				Connection->SubToChannel(Pair.Key.Value, &SubOptions);
+			}
+			Actor->SetRole(ChanneldUtils::ServerGetActorNetRole(Actor));
+			NumPromoted++;
+		}
+		UE_LOG(LogChanneld, Log, TEXT("[Server] Took over the spatial channel %d and promoted %d actors to authority"), ChId, NumPromoted);
+
+		const float HeartbeatInterval = GetMutableDefault<UChanneldSettings>()->SpatialOwnerHeartbeatInterval;
+		if (HeartbeatInterval > 0 && !GetWorld()->GetTimerManager().IsTimerActive(SpatialOwnerHeartbeatTimer))
+		{
+			GetWorld()->GetTimerManager().SetTimer(SpatialOwnerHeartbeatTimer, this, &USpatialChannelDataView::SendSpatialOwnerHeartbeat, HeartbeatInterval, true);
+		}
+	});
+}
+
+// Re-key the cached object with the NetId, as ServerHandleSyncNetId() does.
+static void SetStaticNetId(FNetGUIDCache& GuidCache, AActor* Actor, const FNetworkGUID NetId)
+{
+	const FNetworkGUID OldNetId = GuidCache.GetOrAssignNetGUID(Actor);
+	if (OldNetId == NetId)
+	{
+		return;
+	}
+
+	FNetGuidCacheObject CachedObj;
+	GuidCache.ObjectLookup.RemoveAndCopyValue(OldNetId, CachedObj);
+	GuidCache.ObjectLookup.Emplace(NetId, CachedObj);
+	GuidCache.NetGUIDLookup.Emplace(Actor, NetId);
+}
+
+void USpatialChannelDataView::UninitClient()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(SpectatorInterestTimer);
+	}
+	SpectatingChannels.Empty();
+	IgnoredUnresolvedNetIds.Empty();
+	Super::UninitClient();
+}
+
+void USpatialChannelDataView::UninitServer()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(SpatialOwnerHeartbeatTimer);
+		World->GetTimerManager().ClearTimer(StandbyFailoverTimer);
+	}
+	StandbyHeartbeatTimes.Empty();
+	Super::UninitServer();
+}
+
+void USpatialChannelDataView::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld() || Level == nullptr)
 	{
-		ConsumeChannelUpdateData(ChId, UpdateData);
+		return;
 	}
+	UE_LOG(LogChanneld, Log, TEXT("Synchronizing the actors of the streamed in level: %s"), *Level->GetOutermost()->GetName());
+	SyncNetIds(Level);
 }
 
-void USpatialChannelDataView::InitServer()
+void USpatialChannelDataView::OnLevelRemovedFromWorld(ULevel* Level, UWorld* World)
 {
-	// Spatial server has no authority over the GameState.
-	GetWorld()->GetAuthGameMode()->GameState->SetRole(ENetRole::ROLE_SimulatedProxy);
-	Super::InitServer();
-	
-	if (UClass* PlayerStartLocatorClass = GetMutableDefault<UChanneldSettings>()->PlayerStartLocatorClass)
+	// A null level means all the levels are removed, e.g. when the world is torn down.
+	if (World != GetWorld() || Level == nullptr)
 	{
-		PlayerStartLocator = NewObject<UPlayerStartLocatorBase>(this, PlayerStartLocatorClass);
+		return;
 	}
-	ensureAlwaysMsgf(PlayerStartLocator, TEXT("[Server] SpatialChannelDataView has not specified the PlayerStartLocatorClass."));
 
-	// Set the player's start position selected by the locator.
-	FGameModeEvents::GameModePostLoginEvent.AddLambda([&](AGameModeBase* GameMode, APlayerController* NewPlayer)
+	int32 NumRemoved = 0;
+	for (AActor* Actor : Level->Actors)
 	{
-		auto NetConn = Cast<UChanneldNetConnection>(NewPlayer->GetNetConnection());
-		AActor* StartSpot = nullptr;
-		FVector StartPos = PlayerStartLocator->GetPlayerStartPosition(NetConn->GetConnId(), StartSpot);
-		// Spawn a PlayerStart actor if it doesn't exist.
-		if (!StartSpot)
+		if (IsValid(Actor) && !Actor->IsA<AInfo>())
 		{
-			StartSpot = GetWorld()->SpawnActor<APlayerStart>();
-			StartSpot->SetActorLocation(StartPos);
+			// The actors of the level are gone without being destroyed. Same as the server handles a destroyed actor: the NetId-ChannelId mapping is kept for the cross-server RPC.
+			OnDestroyedActor(Actor, GetNetId(Actor, false));
+			NumRemoved++;
 		}
-		NewPlayer->StartSpot = StartSpot;
-		NewPlayer->SetInitialLocationAndRotation(StartPos, NewPlayer->GetControlRotation());
-		UE_LOG(LogChanneld, Log, TEXT("%s selected %s for client %d"), *PlayerStartLocator->GetName(), *StartPos.ToCompactString(), NetConn->GetConnId());
-	});
-	
-	Connection->AddMessageHandler(channeldpb::SUB_TO_CHANNEL, this, &USpatialChannelDataView::ServerHandleSubToChannel);
-	
-	Connection->AddMessageHandler(channeldpb::CHANNEL_DATA_HANDOVER, this, &USpatialChannelDataView::ServerHandleHandover);
-
-	Connection->RegisterMessageHandler(channeldpb::SPATIAL_CHANNELS_READY, new channeldpb::SpatialChannelsReadyMessage, this, &USpatialChannelDataView::ServerHandleSpatialChannelsReady);
-	Connection->RegisterMessageHandler(unrealpb::SYNC_NET_ID, new channeldpb::ServerForwardMessage, this, &USpatialChannelDataView::ServerHandleSyncNetId);
+	}
+	UE_LOG(LogChanneld, Log, TEXT("Removed %d actors of the streamed out level: %s"), NumRemoved, *Level->GetOutermost()->GetName());
+}
 
-	Connection->RegisterMessageHandler(unrealpb::SERVER_PLAYER_LEAVE, new channeldpb::ServerForwardMessage, [&](UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+void USpatialChannelDataView::SyncNetIds(ULevel* InLevel)
+{
+	if (auto NetDriver = GetChanneldSubsystem()->GetNetDriver())
 	{
-		channeldpb::UnsubscribedFromChannelResultMessage UnsubMsg;
-		if (UnsubMsg.ParseFromString(static_cast<const channeldpb::ServerForwardMessage*>(Msg)->payload()))
+		const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+		FChanneldStaticActorTable StaticActorTable;
+		TMap<FString, const FChanneldStaticActor*> StaticActorsByPath;
+		if (Settings->bUseStaticActorTable && StaticActorTable.Load(UWorld::RemovePIEPrefix(GetWorld()->GetOutermost()->GetName())))
 		{
-			ServerHandleClientUnsub(UnsubMsg.connid(), UnsubMsg.channeltype(), ChId);
+			StaticActorsByPath.Reserve(StaticActorTable.Actors.Num());
+			for (const FChanneldStaticActor& StaticActor : StaticActorTable.Actors)
+			{
+				StaticActorsByPath.Add(StaticActor.Path, &StaticActor);
+			}
+		}
+
+		// The actors not in the static actor table.
+		TArray<AActor*> Actors;
+		TArray<FVector> ActorPositions;
+		TArray<AActor*> TableActors;
+		TArray<FVector> TableActorPositions;
+		auto CollectActor = [&](AActor* Actor)
+		{
+			if (IsValid(Actor) && /*Actor->GetIsReplicated() &&*/ !Actor->IsA<AInfo>())
+			{
+				if (const FChanneldStaticActor* StaticActor = StaticActorsByPath.FindRef(UWorld::RemovePIEPrefix(Actor->GetPathName())))
+				{
+					// Every spatial server assigns the same NetId, so there's nothing to synchronize.
+					SetStaticNetId(*NetDriver->GuidCache, Actor, FNetworkGUID(StaticActor->NetId));
+					TableActors.Add(Actor);
+					TableActorPositions.Add(StaticActor->Location);
+				}
+				else
+				{
+					Actors.Add(Actor);
+					ActorPositions.Add(Actor->GetActorLocation());
+				}
+			}
+		};
+		if (InLevel)
+		{
+			for (AActor* Actor : InLevel->Actors)
+			{
+				CollectActor(Actor);
+			}
 		}
 		else
 		{
-			UE_LOG(LogChanneld, Error, TEXT("Failed to parse the payload of the SERVER_PLAYER_LEAVE message to UnsubscribedFromChannelResultMessage. ChannelId: %d"), ChId);
+			for(TActorIterator<AActor> It(GetWorld(), AActor::StaticClass()); It; ++It)
+			{
+				CollectActor(*It);
+			}
 		}
-	});
 
-	// Only the master server has the write access to the GLOBAL channel.
-	channeldpb::ChannelSubscriptionOptions SubOptions;
-	SubOptions.set_dataaccess(channeldpb::READ_ACCESS);
-	Connection->SubToChannel(Channeld::GlobalChannelId, &SubOptions, [&](const channeldpb::SubscribedToChannelResultMessage* _)
-	{
-		channeldpb::ChannelSubscriptionOptions SpatialSubOptions;
-		SpatialSubOptions.set_dataaccess(channeldpb::WRITE_ACCESS);
-		
-		Connection->CreateSpatialChannel(TEXT(""), &SpatialSubOptions, ChannelInitData ? ChannelInitData->GetMessage() : nullptr, nullptr,
-			[this](const channeldpb::CreateSpatialChannelsResultMessage* ResultMsg)
+		if (TableActors.Num() > 0)
 		{
-			FString StrChIds;
-			for (int i = 0; i < ResultMsg->spatialchannelid_size(); i++)
+			UE_LOG(LogChanneld, Log, TEXT("Assigned the precomputed NetIds to %d static actors, %d actors left to synchronize"), TableActors.Num(), Actors.Num());
+			Connection->QuerySpatialChannel(TableActorPositions, [this, TableActors](const channeldpb::QuerySpatialChannelResultMessage* ResultMsg)
 			{
-				StrChIds.AppendInt(ResultMsg->spatialchannelid(i));
-				if (i < ResultMsg->spatialchannelid_size() - 1)
-					StrChIds.AppendChar(',');
-			}
-			UE_LOG(LogChanneld, Log, TEXT("Created spatial channels: %s"), *StrChIds);
-		});
-	});
-}
+				for (int i = 0; i < ResultMsg->channelid_size(); i++)
+				{
+					const Channeld::ChannelId SpatialChId = ResultMsg->channelid(i);
+					AActor* Actor = TableActors[i];
+					SetOwningChannelId(GetNetId(Actor), SpatialChId);
+					AddObjectProvider(SpatialChId, Actor);
 
-void USpatialChannelDataView::ServerHandleSpatialChannelsReady(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
-{
-	auto readyMsg = static_cast<const channeldpb::SpatialChannelsReadyMessage*>(Msg);
-	if (readyMsg->servercount() > 1)
-	{
-		bIsSyncingNetId = true;
-		UE_LOG(LogChanneld, Log, TEXT("All spatial channels are ready. Start synchronizing NetIds between spatial servers."));
-		SyncNetIds();
-	}
-}
+					if (!Connection->OwnedChannels.Contains(SpatialChId))
+					{
+						// The server should have no authority over the actor in other servers' channels.
+						Actor->SetRole(ROLE_SimulatedProxy);
+					}
+					else if (IsObjectProvider(Actor))
+					{
+						PendingStaticEntityChannels.Emplace(Actor, SpatialChId);
+					}
+				}
+				CreatePendingStaticEntityChannels();
+			});
+		}
 
-void USpatialChannelDataView::SyncNetIds()
-{
-	if (auto NetDriver = GetChanneldSubsystem()->GetNetDriver())
-	{
-		TArray<AActor*> Actors;
-		TArray<FVector> ActorPositions;
-		for(TActorIterator<AActor> It(GetWorld(), AActor::StaticClass()); It; ++It)
+		if (Actors.Num() == 0)
 		{
-			AActor* Actor = *It;
-			if (/*Actor->GetIsReplicated() &&*/ !Actor->IsA<AInfo>())
+			// The synchronization of a streamed in level doesn't block the handovers.
+			if (InLevel)
 			{
-				Actors.Add(Actor);
-				ActorPositions.Add(Actor->GetActorLocation());
+				return;
 			}
+			bIsSyncingNetId = false;
+			UE_LOG(LogChanneld, Log, TEXT("Finish synchronizing NetIds between spatial servers."));
+			GetChanneldSubsystem()->OnSynchronizedNetIds.Broadcast(this);
+			return;
 		}
 
 		Connection->QuerySpatialChannel(ActorPositions, [this, NetDriver, Actors](const channeldpb::QuerySpatialChannelResultMessage* ResultMsg)
@@ -931,15 +2062,10 @@ void USpatialChannelDataView::SyncNetIds()
 				// Create the entity channel for the channel data provider.
 				if (IsObjectProvider(Actor))
 				{
-					channeldpb::ChannelSubscriptionOptions SubOptions;
-					SubOptions.set_dataaccess(channeldpb::WRITE_ACCESS);
-					Connection->CreateEntityChannel(SpatialChId, Actor, NetId.Value, TEXT(""), &SubOptions, GetEntityData(Actor)/*nullptr*/, nullptr,
-					[this, Actor](const channeldpb::CreateChannelResultMessage* ResultMsg)
-					{
-						AddObjectProvider(ResultMsg->channelid(), Actor);
-					});
+					PendingStaticEntityChannels.Emplace(Actor, SpatialChId);
 				}
 			}
+			CreatePendingStaticEntityChannels();
 
 			if (SyncMsg.netidpaths_size() > 0)
 			{
@@ -949,6 +2075,158 @@ void USpatialChannelDataView::SyncNetIds()
 	}
 }
 
+void USpatialChannelDataView::CreatePendingStaticEntityChannels()
+{
+	bStaticEntityChannelsTickScheduled = false;
+	const int32 MaxNum = GetMutableDefault<UChanneldSettings>()->StaticEntityChannelsPerTick;
+	TArray<UChanneldConnection::FEntityChannelToCreate> ToCreate;
+	while (PendingStaticEntityChannels.Num() > 0 && (MaxNum <= 0 || ToCreate.Num() < MaxNum))
+	{
+		const TPair<TWeakObjectPtr<AActor>, Channeld::ChannelId> Pending = PendingStaticEntityChannels.Pop(false);
+		AActor* Actor = Pending.Key.Get();
+		if (IsValid(Actor) && !TryJoinEntityGroup(Actor, Pending.Value))
+		{
+			ToCreate.Add({Pending.Value, Actor, GetNetId(Actor).Value, GetEntityData(Actor)});
+		}
+	}
+
+	channeldpb::ChannelSubscriptionOptions SubOptions;
+	SubOptions.set_dataaccess(channeldpb::WRITE_ACCESS);
+	Connection->CreateEntityChannels(ToCreate, &SubOptions, [this](const channeldpb::CreateChannelResultMessage* ResultMsg)
+	{
+		// The entity channel id is the NetGUID of the entity.
+		if (UObject* Entity = GetObjectFromNetGUID(FNetworkGUID(ResultMsg->channelid())))
+		{
+			AddObjectProvider(ResultMsg->channelid(), Entity);
+		}
+		// The members that joined the group before the entity channel was created.
+		if (const FEntityGroup* Group = EntityGroups.Find(ResultMsg->channelid()))
+		{
+			for (const TWeakObjectPtr<AActor>& Member : Group->Members)
+			{
+				if (Member.IsValid())
+				{
+					AddObjectProvider(ResultMsg->channelid(), Member.Get());
+				}
+			}
+		}
+	});
+
+	if (PendingStaticEntityChannels.Num() > 0)
+	{
+		UE_LOG(LogChanneld, Verbose, TEXT("Created %d entity channels for the static actors, %d left for the next tick"), ToCreate.Num(), PendingStaticEntityChannels.Num());
+		if (!bStaticEntityChannelsTickScheduled)
+		{
+			bStaticEntityChannelsTickScheduled = true;
+			GetWorld()->GetTimerManager().SetTimerForNextTick(this, &USpatialChannelDataView::CreatePendingStaticEntityChannels);
+		}
+	}
+}
+
+bool USpatialChannelDataView::IsLowImportanceEntity(const AActor* Actor) const
+{
+	return !Actor->IsReplicatingMovement() && !Actor->bAlwaysRelevant && Actor->NetPriority <= GetMutableDefault<UChanneldSettings>()->EntityGroupMaxNetPriority;
+}
+
+bool USpatialChannelDataView::TryJoinEntityGroup(AActor* Actor, Channeld::ChannelId SpatialChId)
+{
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	if (!Settings->bGroupLowImportanceEntities || !IsLowImportanceEntity(Actor))
+	{
+		return false;
+	}
+
+	if (const uint32* OpenGroup = OpenEntityGroups.Find(SpatialChId))
+	{
+		const uint32 LeaderNetId = *OpenGroup;
+		FEntityGroup& Group = EntityGroups.FindChecked(LeaderNetId);
+		Group.Members.Add(Actor);
+		if (Group.Members.Num() + 1 >= Settings->MaxEntitiesPerGroup)
+		{
+			OpenEntityGroups.Remove(SpatialChId);
+		}
+		// Otherwise the provider is added once the entity channel is created.
+		if (Connection->SubscribedChannels.Contains(LeaderNetId))
+		{
+			AddObjectProvider(LeaderNetId, Actor);
+		}
+		UE_LOG(LogChanneld, Verbose, TEXT("Static actor %s joined the entity group of %d in spatial channel %d"), *Actor->GetName(), LeaderNetId, SpatialChId);
+		return true;
+	}
+
+	// The actor leads a new group with its own entity channel.
+	const uint32 NetId = GetNetId(Actor).Value;
+	EntityGroups.Add(NetId, {SpatialChId});
+	OpenEntityGroups.Add(SpatialChId, NetId);
+	return false;
+}
+
+void USpatialChannelDataView::DisbandEntityGroup(const uint32 LeaderNetId)
+{
+	FEntityGroup Group;
+	if (!EntityGroups.RemoveAndCopyValue(LeaderNetId, Group))
+	{
+		return;
+	}
+	if (OpenEntityGroups.FindRef(Group.SpatialChId) == LeaderNetId)
+	{
+		OpenEntityGroups.Remove(Group.SpatialChId);
+	}
+
+	UWorld* World = GetWorld();
+	if (World == nullptr || World->bIsTearingDown)
+	{
+		return;
+	}
+
+	// The shared entity channel is removed along with the leader (the providers are removed by the unsub), so the members join or lead the other groups.
+	for (const TWeakObjectPtr<AActor>& Member : Group.Members)
+	{
+		if (Member.IsValid() && !Member->IsActorBeingDestroyed())
+		{
+			PendingStaticEntityChannels.Emplace(Member, Group.SpatialChId);
+		}
+	}
+	if (PendingStaticEntityChannels.Num() > 0 && !bStaticEntityChannelsTickScheduled)
+	{
+		bStaticEntityChannelsTickScheduled = true;
+		World->GetTimerManager().SetTimerForNextTick(this, &USpatialChannelDataView::CreatePendingStaticEntityChannels);
+	}
+}
+
+void USpatialChannelDataView::AddEntityGroupMembers(Channeld::ChannelId ChId, const google::protobuf::Message* UpdateData)
+{
+	using google::protobuf::FieldDescriptor;
+	const google::protobuf::Reflection* Reflection = UpdateData->GetReflection();
+	std::vector<const FieldDescriptor*> Fields;
+	Reflection->ListFields(*UpdateData, &Fields);
+	TSet<uint32>& KnownNetIds = ClientEntityGroupMembers.FindOrAdd(ChId);
+	for (const FieldDescriptor* Field : Fields)
+	{
+		// The states are in the map<uint32, State> fields, keyed by the NetId of the entity.
+		if (!Field->is_map() || Field->message_type()->map_key()->cpp_type() != FieldDescriptor::CPPTYPE_UINT32)
+		{
+			continue;
+		}
+		const FieldDescriptor* KeyField = Field->message_type()->map_key();
+		const int Num = Reflection->FieldSize(*UpdateData, Field);
+		for (int i = 0; i < Num; i++)
+		{
+			const google::protobuf::Message& Entry = Reflection->GetRepeatedMessage(*UpdateData, Field, i);
+			const uint32 NetId = Entry.GetReflection()->GetUInt32(Entry, KeyField);
+			if (NetId == ChId || KnownNetIds.Contains(NetId))
+			{
+				continue;
+			}
+			if (UObject* Member = GetObjectFromNetGUID(FNetworkGUID(NetId)))
+			{
+				KnownNetIds.Add(NetId);
+				AddObjectProvider(ChId, Member);
+			}
+		}
+	}
+}
+
 void USpatialChannelDataView::ServerHandleSyncNetId(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
 {
 	bIsSyncingNetId = false;
@@ -1018,6 +2296,7 @@ void USpatialChannelDataView::ClientHandleSubToChannel(UChanneldConnection* _, C
 			UE_LOG(LogChanneld, Log, TEXT("==================== Client no longer in Master server ===================="));
 			
 			GetChanneldSubsystem()->SetLowLevelSendToChannelId(ChId);
+			OnClientTravel(ChId);
 
 			// Join the spatial server which Master server chooses for the player.
 			const FName LevelName("127.0.0.1");
@@ -1034,6 +2313,109 @@ void USpatialChannelDataView::ClientHandleSubToChannel(UChanneldConnection* _, C
 	}
 }
 
+void USpatialChannelDataView::OnClientTravel(Channeld::ChannelId DstChId)
+{
+	const bool bWasBuffering = bBufferingForTravel;
+	Super::OnClientTravel(DstChId);
+	if (bBufferingForTravel && !bWasBuffering && DstChId != Channeld::InvalidChannelId)
+	{
+		PrefetchTravelInterest(DstChId);
+	}
+}
+
+void USpatialChannelDataView::PrefetchTravelInterest(Channeld::ChannelId DstChId)
+{
+	const TArray<FChanneldSpatialRegionIndex::FRegion>& Regions = Connection->GetSpatialRegionIndex().GetRegions();
+	const FChanneldSpatialRegionIndex::FRegion* DstRegion = Regions.FindByPredicate([DstChId](const FChanneldSpatialRegionIndex::FRegion& Region)
+	{
+		return Region.ChId == DstChId;
+	});
+	if (DstRegion == nullptr)
+	{
+		UE_LOG(LogChanneld, Log, TEXT("[Client] Spatial region of channel %d is unknown, skipped prefetching the interest"), DstChId);
+		return;
+	}
+
+	float Radius = 0;
+	for (const FClientInterestSettingsPreset& Preset : GetMutableDefault<UChanneldSettings>()->ClientInterestPresets)
+	{
+		if (!Preset.bActivateByDefault)
+		{
+			continue;
+		}
+		if (Preset.AreaType == EClientInterestAreaType::Sphere || Preset.AreaType == EClientInterestAreaType::Cone)
+		{
+			Radius = FMath::Max(Radius, Preset.Radius + Preset.HysteresisMargin);
+		}
+		else if (Preset.AreaType == EClientInterestAreaType::Box)
+		{
+			Radius = FMath::Max(Radius, FMath::Max(Preset.Extent.X, Preset.Extent.Y) + Preset.HysteresisMargin);
+		}
+	}
+
+	// The start spot in the channel is unknown to the client, so the area covers the whole destination region.
+	const FBox2D Area(FVector2D(DstRegion->Bounds.Min) - FVector2D(Radius), FVector2D(DstRegion->Bounds.Max) + FVector2D(Radius));
+	channeldpb::ChannelSubscriptionOptions SubOptions;
+	SubOptions.set_dataaccess(channeldpb::READ_ACCESS);
+	int32 NumPrefetched = 0;
+	for (const FChanneldSpatialRegionIndex::FRegion& Region : Regions)
+	{
+		if (Region.ChId != DstChId && !Connection->SubscribedChannels.Contains(Region.ChId)
+			&& Area.Intersect(FBox2D(FVector2D(Region.Bounds.Min), FVector2D(Region.Bounds.Max))))
+		{
+			Connection->SubToChannel(Region.ChId, &SubOptions);
+			NumPrefetched++;
+		}
+	}
+	UE_LOG(LogChanneld, Log, TEXT("[Client] Prefetching %d spatial channels around channel %d, radius: %f"), NumPrefetched, DstChId, Radius);
+}
+
+void USpatialChannelDataView::UpdateSpectatorInterest()
+{
+	const APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	if (PC == nullptr || Connection->GetSpatialRegionIndex().IsEmpty())
+	{
+		return;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	const float SubDistSq = FMath::Square(Settings->SpectatorInterestRadius);
+	// Keep the channels a bit farther than the radius, so the ones on the edge don't flap as the view moves back and forth.
+	const float UnsubDistSq = FMath::Square(Settings->SpectatorInterestRadius * 1.25f);
+	channeldpb::ChannelSubscriptionOptions SubOptions;
+	SubOptions.set_dataaccess(channeldpb::READ_ACCESS);
+	SubOptions.set_fanoutintervalms(Settings->SpectatorFanOutIntervalMs);
+	int32 NumSubs = 0, NumUnsubs = 0;
+	for (const FChanneldSpatialRegionIndex::FRegion& Region : Connection->GetSpatialRegionIndex().GetRegions())
+	{
+		const float DistSq = FBox2D(FVector2D(Region.Bounds.Min), FVector2D(Region.Bounds.Max)).ComputeSquaredDistanceToPoint(FVector2D(ViewLocation));
+		if (SpectatingChannels.Contains(Region.ChId))
+		{
+			if (DistSq > UnsubDistSq)
+			{
+				// The entities of the channel are deleted in OnRemovedProvidersFromChannel() when the unsub result arrives.
+				Connection->UnsubFromChannel(Region.ChId);
+				SpectatingChannels.Remove(Region.ChId);
+				NumUnsubs++;
+			}
+		}
+		else if (DistSq <= SubDistSq)
+		{
+			Connection->SubToChannel(Region.ChId, &SubOptions);
+			SpectatingChannels.Add(Region.ChId);
+			NumSubs++;
+		}
+	}
+
+	if (NumSubs > 0 || NumUnsubs > 0)
+	{
+		UE_LOG(LogChanneld, Log, TEXT("[Spectator] Subscribed to %d and unsubscribed from %d spatial channels around %s"), NumSubs, NumUnsubs, *ViewLocation.ToString());
+	}
+}
+
 void USpatialChannelDataView::ClientHandleHandover(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
 {
 	auto HandoverMsg = static_cast<const channeldpb::ChannelDataHandoverMessage*>(Msg);
@@ -1041,12 +2423,16 @@ void USpatialChannelDataView::ClientHandleHandover(UChanneldConnection* _, Chann
 	unrealpb::SpatialChannelData HandoverData;
 	HandoverMsg->data().UnpackTo(&HandoverData);
 
-	TArray<FString> NetIds;
-	for (auto& Pair : HandoverData.entities())
+	UE_LOG(LogChanneld, Log, TEXT("ChannelDataHandover from channel %d to %d, %d objects"), HandoverMsg->srcchannelid(), HandoverMsg->dstchannelid(), HandoverData.entities_size());
+	if (UE_LOG_ACTIVE(LogChanneld, Verbose))
 	{
-		NetIds.Add(FString::FromInt(Pair.second.objref().netguid()));
+		FString NetIds;
+		for (auto& Pair : HandoverData.entities())
+		{
+			NetIds.Appendf(TEXT("%d,"), Pair.second.objref().netguid());
+		}
+		UE_LOG(LogChanneld, Verbose, TEXT("Handover object netIds: %s"), *NetIds);
 	}
-	UE_LOG(LogChanneld, Log, TEXT("ChannelDataHandover from channel %d to %d, object netIds: %s"), HandoverMsg->srcchannelid(), HandoverMsg->dstchannelid(), *FString::Join(NetIds, TEXT(",")));
 
 	SuppressedNetIdsToResolve.Empty();
 
@@ -1066,6 +2452,11 @@ void USpatialChannelDataView::ClientHandleHandover(UChanneldConnection* _, Chann
 		// Update NetId-ChannelId mapping
 		SetOwningChannelId(NetId, HandoverMsg->dstchannelid());
 
+		if (!bHasInterest)
+		{
+			PendingSpawnObjRefs.Remove(NetId.Value);
+		}
+
 		UObject* Obj = GetObjectFromNetGUID(NetId);
 		if (!Obj)
 		{
@@ -1151,11 +2542,32 @@ void USpatialChannelDataView::InitClient()
 
 	Connection->AddMessageHandler(channeldpb::SUB_TO_CHANNEL, this, &USpatialChannelDataView::ClientHandleSubToChannel);
 	Connection->AddMessageHandler(channeldpb::CHANNEL_DATA_HANDOVER, this, &USpatialChannelDataView::ClientHandleHandover);
+
+	const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+	// The regions must be known before the client travels to the spatial server, or before the spectator picks the channels of its view.
+	if (Settings->bPrefetchInterestOnTravel || Settings->ClassPreloadDistance > 0 || Settings->bSpectatorMode)
+	{
+		Connection->RequestSpatialRegions();
+	}
+	if (Settings->ClassPreloadDistance > 0)
+	{
+		Connection->RegisterMessageHandler(Channeld::SpatialClassSummaryMsgType, new channeldpb::ServerForwardMessage, this, &USpatialChannelDataView::ClientHandleSpatialClassSummary);
+	}
 	
 	channeldpb::ChannelSubscriptionOptions GlobalSubOptions;
 	GlobalSubOptions.set_dataaccess(channeldpb::READ_ACCESS);
-	GlobalSubOptions.set_fanoutintervalms(GlobalChannelFanOutIntervalMs);
+	GlobalSubOptions.set_fanoutintervalms(Settings->bSpectatorMode ? Settings->SpectatorFanOutIntervalMs : GlobalChannelFanOutIntervalMs);
 	GlobalSubOptions.set_fanoutdelayms(GlobalChannelFanOutDelayMs);
+
+	if (Settings->bSpectatorMode)
+	{
+		// The spectator never joins the Master server, so it doesn't travel to a spatial server either.
+		Connection->SubToChannel(Channeld::GlobalChannelId, &GlobalSubOptions);
+		GetWorld()->GetTimerManager().SetTimer(SpectatorInterestTimer, this, &USpatialChannelDataView::UpdateSpectatorInterest, Settings->SpectatorInterestUpdateInterval, true);
+		UE_LOG(LogChanneld, Log, TEXT("==================== Client starts spectating ===================="));
+		return;
+	}
+
 	Connection->SubToChannel(Channeld::GlobalChannelId, &GlobalSubOptions, [&](const channeldpb::SubscribedToChannelResultMessage* Msg)
 	{
 		// GetChanneldSubsystem()->SetLowLevelSendToChannelId(Channeld::GlobalChannelId);
@@ -1293,11 +2705,19 @@ void USpatialChannelDataView::AddProviderToDefaultChannel(IChannelDataProvider*
 void USpatialChannelDataView::OnAddClientConnection(UChanneldNetConnection* ClientConnection, Channeld::ChannelId ChId)
 {
 	ClientInChannels.Emplace(ClientConnection->GetConnId(), ChId);
+	if (UPlayerStartLocator_Slots* SlotLocator = Cast<UPlayerStartLocator_Slots>(PlayerStartLocator))
+	{
+		SlotLocator->SetStartChannel(ClientConnection->GetConnId(), ChId);
+	}
 }
 
 void USpatialChannelDataView::OnRemoveClientConnection(UChanneldNetConnection* ClientConn)
 {
 	ClientInChannels.Remove(ClientConn->GetConnId());
+	if (UPlayerStartLocator_Slots* SlotLocator = Cast<UPlayerStartLocator_Slots>(PlayerStartLocator))
+	{
+		SlotLocator->RemoveConn(ClientConn->GetConnId());
+	}
 }
 
 void USpatialChannelDataView::OnClientPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer, UChanneldNetConnection* NewPlayerConn)
@@ -1333,7 +2753,11 @@ void USpatialChannelDataView::OnNetSpawnedObject(UObject* Obj, const Channeld::C
 	{
 		// Sub to the entity channel which channelId equals to the NetId
 		// TODO: subOptions should reflect the RepConditions of the properties
-		Connection->SubToChannel(NetId, nullptr, [this, Obj, NetId](const channeldpb::SubscribedToChannelResultMessage* ResultMsg)
+		const UChanneldSettings* Settings = GetMutableDefault<UChanneldSettings>();
+		channeldpb::ChannelSubscriptionOptions SpectatorSubOptions;
+		SpectatorSubOptions.set_dataaccess(channeldpb::READ_ACCESS);
+		SpectatorSubOptions.set_fanoutintervalms(Settings->SpectatorFanOutIntervalMs);
+		Connection->SubToChannel(NetId, Settings->bSpectatorMode ? &SpectatorSubOptions : nullptr, [this, Obj, NetId](const channeldpb::SubscribedToChannelResultMessage* ResultMsg)
 		{
 			AddObjectProvider(NetId, Obj);
 		});
@@ -1378,9 +2802,12 @@ void USpatialChannelDataView::OnDestroyedActor(AActor* Actor, const FNetworkGUID
 	if (Connection->IsServer())
 	{
 		RemoveObjectProviderAll(Actor, false);
+		DisbandEntityGroup(NetId.Value);
 		return;
 	}
-	
+
+	ClientEntityGroupMembers.Remove(NetId.Value);
+	IgnoredUnresolvedNetIds.Remove(NetId.Value);
 	Super::OnDestroyedActor(Actor, NetId);
 }
 
@@ -1467,7 +2894,7 @@ void USpatialChannelDataView::SendSpawnToClients_EntityChannelReady(const FNetwo
 		}
 	}
 	
-	unrealpb::SpawnObjectMessage SpawnMsg;
+	unrealpb::SpawnObjectMessage& SpawnMsg = *google::protobuf::Arena::CreateMessage<unrealpb::SpawnObjectMessage>(GetFrameArena());
 	// As we don't have any specific NetConnection to export the NetId, use a virtual one.
 	SpawnMsg.mutable_obj()->CopyFrom(*ChanneldUtils::GetRefOfObject(Obj, NetConnForSpawn, true));
 	/* Moved to ChanneldUtils::GetRefOfObject
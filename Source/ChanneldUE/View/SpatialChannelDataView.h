@@ -21,9 +21,13 @@ public:
 
 	virtual void InitServer() override;
 	virtual void InitClient() override;
+	virtual void UninitServer() override;
+	virtual void UninitClient() override;
 
 	virtual Channeld::ChannelId GetOwningChannelId(AActor* Actor) const override;
 	virtual void SetOwningChannelId(const FNetworkGUID NetId, Channeld::ChannelId ChId) override;
+	virtual bool IsHandoverPending(const FNetworkGUID NetId) const override { return PendingHandovers.Contains(NetId.Value); }
+	virtual void GetNetIdsInUse(TSet<uint32>& OutNetIds) const override;
 	virtual bool GetSendToChannelId(UChanneldNetConnection* NetConn, uint32& OutChId) const override;
 	
 	virtual void AddProviderToDefaultChannel(IChannelDataProvider* Provider) override;
@@ -32,6 +36,7 @@ public:
 	virtual void OnRemoveClientConnection(UChanneldNetConnection* ClientConn) override;
 	virtual void OnClientPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer, UChanneldNetConnection* NewPlayerConn) override;
 	virtual void OnNetSpawnedObject(UObject* Obj, const Channeld::ChannelId ChId) override;
+	virtual void OnClientTravel(Channeld::ChannelId DstChId) override;
 	
 	virtual bool OnServerSpawnedObject(UObject* Obj, const FNetworkGUID NetId) override;
 	virtual void OnDestroyedActor(AActor* Actor, const FNetworkGUID NetId) override;
@@ -55,7 +60,9 @@ protected:
 	virtual void SendSpawnToClients_EntityChannelReady(const FNetworkGUID NetId, UObject* Obj, uint32 OwningConnId, Channeld::ChannelId SpatialChId);
 	virtual void SendSpawnToConn_EntityChannelReady(UObject* Obj, UChanneldNetConnection* NetConn, uint32 OwningConnId);
 	// The client need to destroy the objects that are no longer relevant to the client.
-	virtual void OnRemovedProvidersFromChannel(Channeld::ChannelId ChId, channeldpb::ChannelType ChannelType, const TSet<FProviderInternal>& RemovedProviders) override;
+	virtual void OnRemovedProvidersFromChannel(Channeld::ChannelId ChId, channeldpb::ChannelType ChannelType, const FChannelProviders& RemovedProviders) override;
+	virtual void OnUnsubscribedFromChannel(Channeld::ChannelId ChId, channeldpb::ChannelType ChannelType) override;
+	virtual void OnDisconnect() override;
 	bool ClientDeleteObject(UObject* Obj);
 
 	virtual bool ConsumeChannelUpdateData(Channeld::ChannelId ChId, google::protobuf::Message* UpdateData) override;
@@ -65,6 +72,8 @@ protected:
 	virtual bool CheckUnspawnedObject(Channeld::ChannelId ChId, const google::protobuf::Message* ChannelData) override;
 
 	virtual void SendExistingActorsToNewPlayer(APlayerController* NewPlayer, UChanneldNetConnection* NewPlayerConn) override;
+	virtual bool ShouldSendExistingActorToNewPlayer(AActor* Actor, APlayerController* NewPlayer) override;
+	virtual void SendExistingActorToNewPlayer(AActor* Actor, APlayerController* NewPlayer, UChanneldNetConnection* NewPlayerConn) override;
 	
 	/**
 	 * @brief The source server decides which objects get handed over to the destination server.
@@ -103,18 +112,150 @@ private:
 	bool bSuppressAddProviderAndSendOnServerSpawn = false;
 	bool bSuppressSendOnServerDestroy = false;
 
+	struct FPendingHandover
+	{
+		Channeld::ChannelId SrcChId;
+		Channeld::ChannelId DstChId;
+		TSharedPtr<unrealpb::SpatialEntityState> EntityState;
+	};
+	// [Server] The handovers that are not processed yet, by the NetId of the entity. See UChanneldSettings::HandoverTimeBudgetMs.
+	TMap<uint32, FPendingHandover> PendingHandovers;
+	bool bHandoverTickScheduled = false;
+
+	struct FPooledHandoverActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		const UClass* Class = nullptr;
+		double ExpireTime = 0;
+		// The states to restore when the actor is reactivated.
+		bool bHidden = false;
+		bool bCollisionEnabled = true;
+		bool bTickEnabled = true;
+		TArray<TWeakObjectPtr<UActorComponent>> TickingComponents;
+	};
+	// [Server] The actors that left the interest area lately, by NetId. They stay in the GuidCache, so they are reused when coming back.
+	TMap<uint32, FPooledHandoverActor> PooledHandoverActors;
+	TMap<const UClass*, int32> NumPooledHandoverActors;
+	FTimerHandle HandoverActorPoolTimer;
+	FTimerHandle HandoverPrefetchTimer;
+	FTimerHandle SpatialLoadReportTimer;
+	FTimerHandle SpatialClassSummaryTimer;
+
+	// [Server] The indices in FChanneldRepClassTable of the classes, INDEX_NONE if the class is not in the table.
+	TMap<const UClass*, int32> RepClassTableIndices;
+	// [Client] The indices in FChanneldRepClassTable of the classes in each spatial channel, from the latest summary.
+	TMap<Channeld::ChannelId, TArray<int32>> ChannelClassSummaries;
+	// [Client] The classes that are loading or loaded by PreloadNearbyClasses().
+	TSet<int32> PreloadRequestedClasses;
+	UPROPERTY()
+	TArray<UClass*> PreloadedClasses;
+
+	// [Spectator] The spatial channels subscribed around the spectator's view. See UChanneldSettings::bSpectatorMode.
+	TSet<Channeld::ChannelId> SpectatingChannels;
+	FTimerHandle SpectatorInterestTimer;
+
 	// [Client-Only] The NetId of objects that are deleted during the handover. They should not be spawned again via CheckUnspawnedObject(),
 	// until the client gains interest in them again.
 	TSet<uint32> SuppressedNetIdsToResolve;
 
+	// [Client] Check the class of the unresolved object only once. The NetIds of the objects that should not be spawned, e.g. other players' PlayerControllers,
+	// mapped to the channel they were found in. An id is forgotten when the object is removed from or destroyed, or the client unsubscribes from the channel.
+	bool ShouldSpawnUnresolvedObject(const unrealpb::UnrealObjectRef& ObjRef, Channeld::ChannelId ChId);
+	TMap<uint32, Channeld::ChannelId> IgnoredUnresolvedNetIds;
+	// [Client] Returns false if MaxClientSpawnsPerTick is reached in this tick.
+	bool TryCountClientSpawn();
+	uint64 ClientSpawnFrame = 0;
+	int32 NumClientSpawnsInFrame = 0;
+	// [Client] The unresolved spatial entities to spawn in the next ticks, by NetId. See UChanneldSettings::MaxClientSpawnsPerTick.
+	TMap<uint32, unrealpb::UnrealObjectRef> PendingSpawnObjRefs;
+	bool bPendingSpawnTickScheduled = false;
+	void SpawnPendingObjects();
+	// Spawn the unresolved entity of the spatial channel data. The standby server spawns it as a simulated proxy, without sending the spawn.
+	UObject* SpawnUnresolvedObject(const unrealpb::UnrealObjectRef& ObjRef);
+
 	bool bIsSyncingNetId = false;
-	// Synchronize the NetworkGUIDs of the static and well-known objects across the spatial servers.
-	void SyncNetIds();
+	// Synchronize the NetworkGUIDs of the static and well-known objects across the spatial servers, and add them to the spatial channels.
+	// The actors in the static actor table of the map (see FChanneldStaticActorTable) get the precomputed NetIds instead.
+	// Only the actors of InLevel if it's set, otherwise all the loaded actors.
+	void SyncNetIds(ULevel* InLevel = nullptr);
+	// See UChanneldSettings::bSyncStreamedLevelActors
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+	void OnLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+	// Create the entity channels of the static actors, StaticEntityChannelsPerTick at most per tick.
+	void CreatePendingStaticEntityChannels();
+	TArray<TPair<TWeakObjectPtr<AActor>, Channeld::ChannelId>> PendingStaticEntityChannels;
+	bool bStaticEntityChannelsTickScheduled = false;
+
+	// [Server] The low-importance static actors that share the entity channel of the group leader. See UChanneldSettings::bGroupLowImportanceEntities.
+	struct FEntityGroup
+	{
+		Channeld::ChannelId SpatialChId;
+		// Not including the leader.
+		TArray<TWeakObjectPtr<AActor>> Members;
+	};
+	// By the NetId of the leader, which is also the channel id of the shared entity channel.
+	TMap<uint32, FEntityGroup> EntityGroups;
+	// The group of each spatial channel that still accepts new members.
+	TMap<Channeld::ChannelId, uint32> OpenEntityGroups;
+	bool IsLowImportanceEntity(const AActor* Actor) const;
+	// Returns true if the actor joins an existing group. Otherwise, the actor should have its own entity channel.
+	bool TryJoinEntityGroup(AActor* Actor, Channeld::ChannelId SpatialChId);
+	// Regroup the members after the leader is destroyed.
+	void DisbandEntityGroup(const uint32 LeaderNetId);
+	// [Client] Add the providers of the group members found in the update of a shared entity channel.
+	void AddEntityGroupMembers(Channeld::ChannelId ChId, const google::protobuf::Message* UpdateData);
+	TMap<Channeld::ChannelId, TSet<uint32>> ClientEntityGroupMembers;
 
 	void ServerHandleSpatialChannelsReady(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
+	// See UChanneldSettings::SpatialOwnerHeartbeatInterval
+	void SendSpatialOwnerHeartbeat();
+	FTimerHandle SpatialOwnerHeartbeatTimer;
+	// [Standby server] The time of the last heartbeat of the owning server of each standby channel, or 0 if none is received yet.
+	// See UChanneldSettings::StandbySpatialChannelIds.
+	TMap<Channeld::ChannelId, double> StandbyHeartbeatTimes;
+	FTimerHandle StandbyFailoverTimer;
+	bool IsStandbyChannel(Channeld::ChannelId ChId) const { return StandbyHeartbeatTimes.Contains(ChId); }
+	void ServerHandleSpatialOwnerHeartbeat(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
+	void CheckStandbyOwners();
+	// Take the ownership of the standby channel and its entities from the lost server, and promote the entities to authority.
+	void TakeOverStandbyChannel(Channeld::ChannelId ChId);
 	void ServerHandleSyncNetId(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
 	void ServerHandleSubToChannel(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
+	class UClientInterestManager* GetClientInterestManager(Channeld::ConnectionId ClientConnId) const;
 	void ServerHandleHandover(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
+	void ProcessHandover(Channeld::ChannelId SrcChId, Channeld::ChannelId DstChId, const unrealpb::SpatialChannelData& HandoverData);
+	void TickPendingHandovers();
+	// Destroy the object that leaves the interest area of the server, without destroying it in the clients.
+	void DestroyHandoverObject(UObject* HandoverObj, const FNetworkGUID NetId);
+	// Hide and deactivate the actor that leaves the interest area instead of destroying it. See UChanneldSettings::HandoverActorPoolTTL.
+	bool PoolHandoverActor(AActor* Actor, const FNetworkGUID NetId);
+	bool ReactivatePooledHandoverActor(const FNetworkGUID NetId);
+	void RemoveExpiredHandoverActors();
+	// Send the non-player actors that are about to leave for another server, so the destination server has them spawned (and pooled) before the handover.
+	void SendHandoverPrefetch();
+	void ServerHandleHandoverPrefetch(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
+	// Tell the other spatial servers the new owning channel of the objects handed over from an owned channel. See UChanneldSettings::bBroadcastOwnershipChanges.
+	void BroadcastOwnershipChange(Channeld::ChannelId SrcChId, Channeld::ChannelId DstChId, const unrealpb::SpatialChannelData& HandoverData);
+	void ServerHandleOwnershipChange(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
+	// Update the subscription options of a client in an owned spatial channel, on behalf of the server that has the client's interest.
+	void ServerHandleSpatialSubOptions(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
+	// Report the load of the owned spatial channels, so channeld can rebalance them. The resulting handovers go through PendingHandovers as usual.
+	void SendSpatialLoadReport();
+	// Send the replicated classes of the actors in the owned spatial channels to the clients. See UChanneldSettings::SpatialClassSummaryInterval.
+	void SendSpatialClassSummary();
+	// [Client] Keep the class summary of the spatial channels, and load the classes of the channels near the player.
+	void ClientHandleSpatialClassSummary(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
+	void PreloadNearbyClasses();
+	// Show the costs in the spatial visualizer before they are reset.
+	virtual void ReportReplicationCosts() override;
+	// Process the pending handovers in batches, by the source and destination channels and the owning player. 0 means no time budget.
+	void FlushPendingHandovers(float TimeBudgetMs);
+	// [Client] Subscribe to the spatial channels the client's interest is likely to cover in the destination channel. See UChanneldSettings::bPrefetchInterestOnTravel.
+	void PrefetchTravelInterest(Channeld::ChannelId DstChId);
+	// [Spectator] Subscribe to the spatial channels that come into the spectator's view, and unsubscribe from the ones that leave it.
+	void UpdateSpectatorInterest();
 	void ClientHandleSubToChannel(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
 	void ClientHandleHandover(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
 	void ClientHandleGetUnrealObjectRef(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
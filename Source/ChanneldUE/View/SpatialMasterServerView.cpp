@@ -7,6 +7,7 @@
 #include "GameFramework/GameModeBase.h"
 #include "GameFramework/GameStateBase.h"
 #include "GameFramework/PlayerStart.h"
+#include "google/protobuf/struct.pb.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Replication/ChanneldReplicationComponent.h"
 
@@ -42,9 +43,17 @@ void USpatialMasterServerView::InitServer()
 		if (SubResultMsg->conntype() == channeldpb::CLIENT && SubResultMsg->channeltype() == channeldpb::GLOBAL)
 		{
 			Channeld::ConnectionId ClientConnId = SubResultMsg->connid();
+			// The slots already know their spatial channels. No need to query channeld.
+			UPlayerStartLocator_Slots* SlotLocator = Cast<UPlayerStartLocator_Slots>(PlayerStartLocator);
+			const Channeld::ChannelId AssignedChId = SlotLocator ? SlotLocator->AssignStartChannel(ClientConnId) : Channeld::InvalidChannelId;
 			AActor* StartSpot;
 			FVector StartPos = PlayerStartLocator->GetPlayerStartPosition(ClientConnId, StartSpot);
 			UE_LOG(LogChanneld, Log, TEXT("%s selected %s for client %d"), *PlayerStartLocator->GetName(), *StartPos.ToCompactString(), ClientConnId);
+			if (AssignedChId != Channeld::InvalidChannelId)
+			{
+				SubClientToStartChannel(ClientConnId, AssignedChId);
+				return;
+			}
 			
 			TArray<FVector> Positions;
 			Positions.Add(StartPos);
@@ -59,19 +68,7 @@ void USpatialMasterServerView::InitServer()
 					return;
 				}
 
-				/*
-				channeldpb::ChannelSubscriptionOptions AuthoritySubOptions;
-				AuthoritySubOptions.set_dataaccess(channeldpb::WRITE_ACCESS);
-				AuthoritySubOptions.set_fanoutintervalms(ClientFanOutIntervalMs);
-				AuthoritySubOptions.set_fanoutdelayms(ClientFanOutDelayMs);
-				*/
-				channeldpb::ChannelSubscriptionOptions NonAuthoritySubOptions;
-				NonAuthoritySubOptions.set_dataaccess(channeldpb::READ_ACCESS);
-				NonAuthoritySubOptions.set_fanoutintervalms(ClientFanOutIntervalMs);
-				NonAuthoritySubOptions.set_fanoutdelayms(ClientFanOutDelayMs);
-
-				// The start spatial channelId MUST be sent at first.
-				Connection->SubConnectionToChannel(ClientConnId, StartChannelId, &NonAuthoritySubOptions);
+				SubClientToStartChannel(ClientConnId, StartChannelId);
 
 				/* The spatial server will sub the client to the spatial channels according to the interest settings.
 				// Delay the sub of other spatial channels, so the client can treat the first spatial channelId as the one to log in.
@@ -96,6 +93,10 @@ void USpatialMasterServerView::InitServer()
 		auto UnsubMsg = static_cast<const channeldpb::UnsubscribedFromChannelResultMessage*>(Msg);
 		if (UnsubMsg->channeltype() == channeldpb::GLOBAL && UnsubMsg->conntype() == channeldpb::CLIENT)
 		{
+			if (UPlayerStartLocator_Slots* SlotLocator = Cast<UPlayerStartLocator_Slots>(PlayerStartLocator))
+			{
+				SlotLocator->RemoveConn(UnsubMsg->connid());
+			}
 			// Broadcast the unsub message to all other servers so they can remove the client connection.
 			Connection->Broadcast(Channeld::GlobalChannelId, unrealpb::SERVER_PLAYER_LEAVE, *UnsubMsg, channeldpb::ALL_BUT_CLIENT | channeldpb::ALL_BUT_SENDER);
 			/* Should not only send to spatial servers. The sub-world servers may also need to know the player leave.
@@ -126,6 +127,8 @@ void USpatialMasterServerView::InitServer()
 		AllSpatialChannelIds.Remove(RemoveMsg->channelid());
 	});
 
+	Connection->RegisterMessageHandler(Channeld::SpatialLoadReportMsgType, new channeldpb::ServerForwardMessage, this, &USpatialMasterServerView::HandleSpatialLoadReport);
+
 	channeldpb::ChannelSubscriptionOptions GlobalSubOptions;
 	GlobalSubOptions.set_dataaccess(channeldpb::WRITE_ACCESS);
 	GlobalSubOptions.set_fanoutintervalms(ClientFanOutIntervalMs);
@@ -138,6 +141,53 @@ void USpatialMasterServerView::InitServer()
 		});
 }
 
+void USpatialMasterServerView::SubClientToStartChannel(Channeld::ConnectionId ClientConnId, Channeld::ChannelId StartChannelId)
+{
+	/*
+	channeldpb::ChannelSubscriptionOptions AuthoritySubOptions;
+	AuthoritySubOptions.set_dataaccess(channeldpb::WRITE_ACCESS);
+	AuthoritySubOptions.set_fanoutintervalms(ClientFanOutIntervalMs);
+	AuthoritySubOptions.set_fanoutdelayms(ClientFanOutDelayMs);
+	*/
+	channeldpb::ChannelSubscriptionOptions NonAuthoritySubOptions;
+	NonAuthoritySubOptions.set_dataaccess(channeldpb::READ_ACCESS);
+	NonAuthoritySubOptions.set_fanoutintervalms(ClientFanOutIntervalMs);
+	NonAuthoritySubOptions.set_fanoutdelayms(ClientFanOutDelayMs);
+
+	// The start spatial channelId MUST be sent at first.
+	Connection->SubConnectionToChannel(ClientConnId, StartChannelId, &NonAuthoritySubOptions);
+}
+
+void USpatialMasterServerView::HandleSpatialLoadReport(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg)
+{
+	UPlayerStartLocator_Slots* SlotLocator = Cast<UPlayerStartLocator_Slots>(PlayerStartLocator);
+	if (SlotLocator == nullptr)
+	{
+		return;
+	}
+
+	google::protobuf::Struct Report;
+	if (!Report.ParseFromString(static_cast<const channeldpb::ServerForwardMessage*>(Msg)->payload()))
+	{
+		UE_LOG(LogChanneld, Error, TEXT("Failed to parse the payload of the spatial load report"));
+		return;
+	}
+	auto ChannelsIt = Report.fields().find("channels");
+	if (ChannelsIt == Report.fields().end())
+	{
+		return;
+	}
+	for (auto& Pair : ChannelsIt->second.struct_value().fields())
+	{
+		const auto& LoadFields = Pair.second.struct_value().fields();
+		auto EntitiesIt = LoadFields.find("entities");
+		if (EntitiesIt != LoadFields.end())
+		{
+			SlotLocator->OnChannelLoadReported(FCString::Atoi64(UTF8_TO_TCHAR(Pair.first.c_str())), EntitiesIt->second.number_value());
+		}
+	}
+}
+
 void USpatialMasterServerView::AddProvider(Channeld::ChannelId ChId, IChannelDataProvider* Provider)
 {
 	// Should only replicates the GameStateBase
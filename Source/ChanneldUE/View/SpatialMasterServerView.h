@@ -31,6 +31,10 @@ private:
 	// Maintains all the channels Master server has created and which spatial server they belong to.
 	TMap<Channeld::ChannelId, Channeld::ConnectionId> AllSpatialChannelIds;
 
+	void SubClientToStartChannel(Channeld::ConnectionId ClientConnId, Channeld::ChannelId StartChannelId);
+	// Feed the loads of the spatial channels to UPlayerStartLocator_Slots. See UChanneldSettings::SpatialLoadReportInterval.
+	void HandleSpatialLoadReport(UChanneldConnection* _, Channeld::ChannelId ChId, const google::protobuf::Message* Msg);
+
 	// Use by the server to locate the player start position. In order to spawn the player's pawn in the right spatial channel,
 	// the Master server and spatial servers should have the EXACTLY SAME position for a player.
 	UPROPERTY()
@@ -0,0 +1,1590 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: unreal_components.proto
+
+#ifdef _MSC_VER
+#	pragma warning(disable: 4125)
+#	pragma warning(disable: 4647)
+#	pragma warning(disable: 4668)
+#	pragma warning(disable: 4800)
+#	pragma warning(disable: 4946)
+#endif
+
+#include "unreal_components.pb.h"
+
+#include <algorithm>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/extension_set.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/reflection_ops.h>
+#include <google/protobuf/wire_format.h>
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+
+namespace _pb = ::PROTOBUF_NAMESPACE_ID;
+namespace _pbi = _pb::internal;
+
+namespace unrealpb {
+PROTOBUF_CONSTEXPR AnimMontageState::AnimMontageState(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.section_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.montage_)*/nullptr
+  , /*decltype(_impl_.playcount_)*/0u
+  , /*decltype(_impl_.playrate_)*/0
+  , /*decltype(_impl_.position_)*/0
+  , /*decltype(_impl_.isstopped_)*/false} {}
+struct AnimMontageStateDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR AnimMontageStateDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~AnimMontageStateDefaultTypeInternal() {}
+  union {
+    AnimMontageState _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 AnimMontageStateDefaultTypeInternal _AnimMontageState_default_instance_;
+PROTOBUF_CONSTEXPR SkeletalMeshComponentState::SkeletalMeshComponentState(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.montage_)*/nullptr} {}
+struct SkeletalMeshComponentStateDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR SkeletalMeshComponentStateDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~SkeletalMeshComponentStateDefaultTypeInternal() {}
+  union {
+    SkeletalMeshComponentState _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 SkeletalMeshComponentStateDefaultTypeInternal _SkeletalMeshComponentState_default_instance_;
+PROTOBUF_CONSTEXPR ProjectileMovementComponentState::ProjectileMovementComponentState(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.velocity_)*/nullptr
+  , /*decltype(_impl_.isstopped_)*/false} {}
+struct ProjectileMovementComponentStateDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR ProjectileMovementComponentStateDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~ProjectileMovementComponentStateDefaultTypeInternal() {}
+  union {
+    ProjectileMovementComponentState _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ProjectileMovementComponentStateDefaultTypeInternal _ProjectileMovementComponentState_default_instance_;
+PROTOBUF_CONSTEXPR GameplayAttributeValue::GameplayAttributeValue(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.basevalue_)*/0
+  , /*decltype(_impl_.currentvalue_)*/0} {}
+struct GameplayAttributeValueDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR GameplayAttributeValueDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~GameplayAttributeValueDefaultTypeInternal() {}
+  union {
+    GameplayAttributeValue _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 GameplayAttributeValueDefaultTypeInternal _GameplayAttributeValue_default_instance_;
+PROTOBUF_CONSTEXPR AbilitySystemComponentState_AttributesEntry_DoNotUse::AbilitySystemComponentState_AttributesEntry_DoNotUse(
+    ::_pbi::ConstantInitialized) {}
+struct AbilitySystemComponentState_AttributesEntry_DoNotUseDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR AbilitySystemComponentState_AttributesEntry_DoNotUseDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~AbilitySystemComponentState_AttributesEntry_DoNotUseDefaultTypeInternal() {}
+  union {
+    AbilitySystemComponentState_AttributesEntry_DoNotUse _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 AbilitySystemComponentState_AttributesEntry_DoNotUseDefaultTypeInternal _AbilitySystemComponentState_AttributesEntry_DoNotUse_default_instance_;
+PROTOBUF_CONSTEXPR AbilitySystemComponentState::AbilitySystemComponentState(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.attributes_)*/{::_pbi::ConstantInitialized()}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct AbilitySystemComponentStateDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR AbilitySystemComponentStateDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~AbilitySystemComponentStateDefaultTypeInternal() {}
+  union {
+    AbilitySystemComponentState _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 AbilitySystemComponentStateDefaultTypeInternal _AbilitySystemComponentState_default_instance_;
+}  // namespace unrealpb
+static ::_pb::Metadata file_level_metadata_unreal_5fcomponents_2eproto[6];
+static constexpr ::_pb::EnumDescriptor const** file_level_enum_descriptors_unreal_5fcomponents_2eproto = nullptr;
+static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_unreal_5fcomponents_2eproto = nullptr;
+
+const uint32_t TableStruct_unreal_5fcomponents_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  PROTOBUF_FIELD_OFFSET(::unrealpb::AnimMontageState, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::unrealpb::AnimMontageState, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::unrealpb::AnimMontageState, _impl_.montage_),
+  PROTOBUF_FIELD_OFFSET(::unrealpb::AnimMontageState, _impl_.playcount_),
+  PROTOBUF_FIELD_OFFSET(::unrealpb::AnimMontageState, _impl_.playrate_),
+  PROTOBUF_FIELD_OFFSET(::unrealpb::AnimMontageState, _impl_.position_),
+  PROTOBUF_FIELD_OFFSET(::unrealpb::AnimMontageState, _impl_.section_),
+  PROTOBUF_FIELD_OFFSET(::unrealpb::AnimMontageState, _impl_.isstopped_),
+  1,
+  2,
+  3,
+  4,
+  0,
+  5,
+  PROTOBUF_FIELD_OFFSET(::unrealpb::SkeletalMeshComponentState, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::unrealpb::SkeletalMeshComponentState, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::unrealpb::SkeletalMeshComponentState, _impl_.montage_),
+  0,
+  PROTOBUF_FIELD_OFFSET(::unrealpb::ProjectileMovementComponentState, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::unrealpb::ProjectileMovementComponentState, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::unrealpb::ProjectileMovementComponentState, _impl_.velocity_),
+  PROTOBUF_FIELD_OFFSET(::unrealpb::ProjectileMovementComponentState, _impl_.isstopped_),
+  0,
+  1,
+  PROTOBUF_FIELD_OFFSET(::unrealpb::GameplayAttributeValue, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::unrealpb::GameplayAttributeValue, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::unrealpb::GameplayAttributeValue, _impl_.basevalue_),
+  PROTOBUF_FIELD_OFFSET(::unrealpb::GameplayAttributeValue, _impl_.currentvalue_),
+  0,
+  1,
+  PROTOBUF_FIELD_OFFSET(::unrealpb::AbilitySystemComponentState_AttributesEntry_DoNotUse, _has_bits_),
+  PROTOBUF_FIELD_OFFSET(::unrealpb::AbilitySystemComponentState_AttributesEntry_DoNotUse, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::unrealpb::AbilitySystemComponentState_AttributesEntry_DoNotUse, key_),
+  PROTOBUF_FIELD_OFFSET(::unrealpb::AbilitySystemComponentState_AttributesEntry_DoNotUse, value_),
+  0,
+  1,
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::unrealpb::AbilitySystemComponentState, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::unrealpb::AbilitySystemComponentState, _impl_.attributes_),
+};
+static const ::_pbi::MigrationSchema schemas_unreal_5fcomponents_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  { 0, 12, -1, sizeof(::unrealpb::AnimMontageState)},
+  { 18, 25, -1, sizeof(::unrealpb::SkeletalMeshComponentState)},
+  { 26, 34, -1, sizeof(::unrealpb::ProjectileMovementComponentState)},
+  { 36, 44, -1, sizeof(::unrealpb::GameplayAttributeValue)},
+  { 46, 54, -1, sizeof(::unrealpb::AbilitySystemComponentState_AttributesEntry_DoNotUse)},
+  { 56, -1, -1, sizeof(::unrealpb::AbilitySystemComponentState)},
+};
+
+static const ::_pb::Message* const file_default_instances_unreal_5fcomponents_2eproto[] = {
+  &::unrealpb::_AnimMontageState_default_instance_._instance,
+  &::unrealpb::_SkeletalMeshComponentState_default_instance_._instance,
+  &::unrealpb::_ProjectileMovementComponentState_default_instance_._instance,
+  &::unrealpb::_GameplayAttributeValue_default_instance_._instance,
+  &::unrealpb::_AbilitySystemComponentState_AttributesEntry_DoNotUse_default_instance_._instance,
+  &::unrealpb::_AbilitySystemComponentState_default_instance_._instance,
+};
+
+const char descriptor_table_protodef_unreal_5fcomponents_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
+  "\n\027unreal_components.proto\022\010unrealpb\032\023unr"
+  "eal_common.proto\"\376\001\n\020AnimMontageState\022(\n"
+  "\007montage\030\001 \001(\0132\022.unrealpb.AssetRefH\000\210\001\001\022"
+  "\026\n\tplayCount\030\002 \001(\rH\001\210\001\001\022\025\n\010playRate\030\003 \001("
+  "\002H\002\210\001\001\022\025\n\010position\030\004 \001(\002H\003\210\001\001\022\024\n\007section"
+  "\030\005 \001(\tH\004\210\001\001\022\026\n\tisStopped\030\006 \001(\010H\005\210\001\001B\n\n\010_"
+  "montageB\014\n\n_playCountB\013\n\t_playRateB\013\n\t_p"
+  "ositionB\n\n\010_sectionB\014\n\n_isStopped\"Z\n\032Ske"
+  "letalMeshComponentState\0220\n\007montage\030\001 \001(\013"
+  "2\032.unrealpb.AnimMontageStateH\000\210\001\001B\n\n\010_mo"
+  "ntage\"\177\n ProjectileMovementComponentStat"
+  "e\022(\n\010velocity\030\001 \001(\0132\021.unrealpb.FVectorH\000"
+  "\210\001\001\022\026\n\tisStopped\030\002 \001(\010H\001\210\001\001B\013\n\t_velocity"
+  "B\014\n\n_isStopped\"j\n\026GameplayAttributeValue"
+  "\022\026\n\tbaseValue\030\001 \001(\002H\000\210\001\001\022\031\n\014currentValue"
+  "\030\002 \001(\002H\001\210\001\001B\014\n\n_baseValueB\017\n\r_currentVal"
+  "ue\"\275\001\n\033AbilitySystemComponentState\022I\n\nat"
+  "tributes\030\001 \003(\01325.unrealpb.AbilitySystemC"
+  "omponentState.AttributesEntry\032S\n\017Attribu"
+  "tesEntry\022\013\n\003key\030\001 \001(\r\022/\n\005value\030\002 \001(\0132 .u"
+  "nrealpb.GameplayAttributeValue:\0028\001B.Z,gi"
+  "thub.com/metaworking/channeld/pkg/unreal"
+  "pbb\006proto3"
+  ;
+static const ::_pbi::DescriptorTable* const descriptor_table_unreal_5fcomponents_2eproto_deps[1] = {
+  &::descriptor_table_unreal_5fcommon_2eproto,
+};
+static ::_pbi::once_flag descriptor_table_unreal_5fcomponents_2eproto_once;
+const ::_pbi::DescriptorTable descriptor_table_unreal_5fcomponents_2eproto = {
+    false, false, 890, descriptor_table_protodef_unreal_5fcomponents_2eproto,
+    "unreal_components.proto",
+    &descriptor_table_unreal_5fcomponents_2eproto_once, descriptor_table_unreal_5fcomponents_2eproto_deps, 1, 6,
+    schemas_unreal_5fcomponents_2eproto, file_default_instances_unreal_5fcomponents_2eproto, TableStruct_unreal_5fcomponents_2eproto::offsets,
+    file_level_metadata_unreal_5fcomponents_2eproto, file_level_enum_descriptors_unreal_5fcomponents_2eproto,
+    file_level_service_descriptors_unreal_5fcomponents_2eproto,
+};
+PROTOBUF_ATTRIBUTE_WEAK const ::_pbi::DescriptorTable* descriptor_table_unreal_5fcomponents_2eproto_getter() {
+  return &descriptor_table_unreal_5fcomponents_2eproto;
+}
+
+// Force running AddDescriptors() at dynamic initialization time.
+PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 static ::_pbi::AddDescriptorsRunner dynamic_init_dummy_unreal_5fcomponents_2eproto(&descriptor_table_unreal_5fcomponents_2eproto);
+namespace unrealpb {
+
+// ===================================================================
+
+class AnimMontageState::_Internal {
+ public:
+  using HasBits = decltype(std::declval<AnimMontageState>()._impl_._has_bits_);
+  static const ::unrealpb::AssetRef& montage(const AnimMontageState* msg);
+  static void set_has_montage(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_playcount(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_playrate(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static void set_has_position(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static void set_has_section(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_isstopped(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+};
+
+const ::unrealpb::AssetRef&
+AnimMontageState::_Internal::montage(const AnimMontageState* msg) {
+  return *msg->_impl_.montage_;
+}
+void AnimMontageState::clear_montage() {
+  if (_impl_.montage_ != nullptr) _impl_.montage_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+AnimMontageState::AnimMontageState(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:unrealpb.AnimMontageState)
+}
+AnimMontageState::AnimMontageState(const AnimMontageState& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  AnimMontageState* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.section_){}
+    , decltype(_impl_.montage_){nullptr}
+    , decltype(_impl_.playcount_){}
+    , decltype(_impl_.playrate_){}
+    , decltype(_impl_.position_){}
+    , decltype(_impl_.isstopped_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.section_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.section_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_section()) {
+    _this->_impl_.section_.Set(from._internal_section(), 
+      _this->GetArenaForAllocation());
+  }
+  if (from._internal_has_montage()) {
+    _this->_impl_.montage_ = new ::unrealpb::AssetRef(*from._impl_.montage_);
+  }
+  ::memcpy(&_impl_.playcount_, &from._impl_.playcount_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.isstopped_) -
+    reinterpret_cast<char*>(&_impl_.playcount_)) + sizeof(_impl_.isstopped_));
+  // @@protoc_insertion_point(copy_constructor:unrealpb.AnimMontageState)
+}
+
+inline void AnimMontageState::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.section_){}
+    , decltype(_impl_.montage_){nullptr}
+    , decltype(_impl_.playcount_){0u}
+    , decltype(_impl_.playrate_){0}
+    , decltype(_impl_.position_){0}
+    , decltype(_impl_.isstopped_){false}
+  };
+  _impl_.section_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.section_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+AnimMontageState::~AnimMontageState() {
+  // @@protoc_insertion_point(destructor:unrealpb.AnimMontageState)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void AnimMontageState::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.section_.Destroy();
+  if (this != internal_default_instance()) delete _impl_.montage_;
+}
+
+void AnimMontageState::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void AnimMontageState::Clear() {
+// @@protoc_insertion_point(message_clear_start:unrealpb.AnimMontageState)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _impl_.section_.ClearNonDefaultToEmpty();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.montage_ != nullptr);
+      _impl_.montage_->Clear();
+    }
+  }
+  if (cached_has_bits & 0x0000003cu) {
+    ::memset(&_impl_.playcount_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.isstopped_) -
+        reinterpret_cast<char*>(&_impl_.playcount_)) + sizeof(_impl_.isstopped_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* AnimMontageState::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional .unrealpb.AssetRef montage = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_montage(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint32 playCount = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_playcount(&has_bits);
+          _impl_.playcount_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional float playRate = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 29)) {
+          _Internal::set_has_playrate(&has_bits);
+          _impl_.playrate_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr);
+          ptr += sizeof(float);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional float position = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 37)) {
+          _Internal::set_has_position(&has_bits);
+          _impl_.position_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr);
+          ptr += sizeof(float);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional string section = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 42)) {
+          auto str = _internal_mutable_section();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "unrealpb.AnimMontageState.section"));
+        } else
+          goto handle_unusual;
+        continue;
+      // optional bool isStopped = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 48)) {
+          _Internal::set_has_isstopped(&has_bits);
+          _impl_.isstopped_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* AnimMontageState::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:unrealpb.AnimMontageState)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // optional .unrealpb.AssetRef montage = 1;
+  if (_internal_has_montage()) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::montage(this),
+        _Internal::montage(this).GetCachedSize(), target, stream);
+  }
+
+  // optional uint32 playCount = 2;
+  if (_internal_has_playcount()) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(2, this->_internal_playcount(), target);
+  }
+
+  // optional float playRate = 3;
+  if (_internal_has_playrate()) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFloatToArray(3, this->_internal_playrate(), target);
+  }
+
+  // optional float position = 4;
+  if (_internal_has_position()) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFloatToArray(4, this->_internal_position(), target);
+  }
+
+  // optional string section = 5;
+  if (_internal_has_section()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_section().data(), static_cast<int>(this->_internal_section().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "unrealpb.AnimMontageState.section");
+    target = stream->WriteStringMaybeAliased(
+        5, this->_internal_section(), target);
+  }
+
+  // optional bool isStopped = 6;
+  if (_internal_has_isstopped()) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(6, this->_internal_isstopped(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:unrealpb.AnimMontageState)
+  return target;
+}
+
+size_t AnimMontageState::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:unrealpb.AnimMontageState)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003fu) {
+    // optional string section = 5;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_section());
+    }
+
+    // optional .unrealpb.AssetRef montage = 1;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.montage_);
+    }
+
+    // optional uint32 playCount = 2;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_playcount());
+    }
+
+    // optional float playRate = 3;
+    if (cached_has_bits & 0x00000008u) {
+      total_size += 1 + 4;
+    }
+
+    // optional float position = 4;
+    if (cached_has_bits & 0x00000010u) {
+      total_size += 1 + 4;
+    }
+
+    // optional bool isStopped = 6;
+    if (cached_has_bits & 0x00000020u) {
+      total_size += 1 + 1;
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData AnimMontageState::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    AnimMontageState::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*AnimMontageState::GetClassData() const { return &_class_data_; }
+
+
+void AnimMontageState::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<AnimMontageState*>(&to_msg);
+  auto& from = static_cast<const AnimMontageState&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:unrealpb.AnimMontageState)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_section(from._internal_section());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_montage()->::unrealpb::AssetRef::MergeFrom(
+          from._internal_montage());
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.playcount_ = from._impl_.playcount_;
+    }
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.playrate_ = from._impl_.playrate_;
+    }
+    if (cached_has_bits & 0x00000010u) {
+      _this->_impl_.position_ = from._impl_.position_;
+    }
+    if (cached_has_bits & 0x00000020u) {
+      _this->_impl_.isstopped_ = from._impl_.isstopped_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void AnimMontageState::CopyFrom(const AnimMontageState& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:unrealpb.AnimMontageState)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool AnimMontageState::IsInitialized() const {
+  return true;
+}
+
+void AnimMontageState::InternalSwap(AnimMontageState* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.section_, lhs_arena,
+      &other->_impl_.section_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(AnimMontageState, _impl_.isstopped_)
+      + sizeof(AnimMontageState::_impl_.isstopped_)
+      - PROTOBUF_FIELD_OFFSET(AnimMontageState, _impl_.montage_)>(
+          reinterpret_cast<char*>(&_impl_.montage_),
+          reinterpret_cast<char*>(&other->_impl_.montage_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata AnimMontageState::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_unreal_5fcomponents_2eproto_getter, &descriptor_table_unreal_5fcomponents_2eproto_once,
+      file_level_metadata_unreal_5fcomponents_2eproto[0]);
+}
+
+// ===================================================================
+
+class SkeletalMeshComponentState::_Internal {
+ public:
+  using HasBits = decltype(std::declval<SkeletalMeshComponentState>()._impl_._has_bits_);
+  static const ::unrealpb::AnimMontageState& montage(const SkeletalMeshComponentState* msg);
+  static void set_has_montage(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+};
+
+const ::unrealpb::AnimMontageState&
+SkeletalMeshComponentState::_Internal::montage(const SkeletalMeshComponentState* msg) {
+  return *msg->_impl_.montage_;
+}
+SkeletalMeshComponentState::SkeletalMeshComponentState(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:unrealpb.SkeletalMeshComponentState)
+}
+SkeletalMeshComponentState::SkeletalMeshComponentState(const SkeletalMeshComponentState& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  SkeletalMeshComponentState* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.montage_){nullptr}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  if (from._internal_has_montage()) {
+    _this->_impl_.montage_ = new ::unrealpb::AnimMontageState(*from._impl_.montage_);
+  }
+  // @@protoc_insertion_point(copy_constructor:unrealpb.SkeletalMeshComponentState)
+}
+
+inline void SkeletalMeshComponentState::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.montage_){nullptr}
+  };
+}
+
+SkeletalMeshComponentState::~SkeletalMeshComponentState() {
+  // @@protoc_insertion_point(destructor:unrealpb.SkeletalMeshComponentState)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void SkeletalMeshComponentState::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  if (this != internal_default_instance()) delete _impl_.montage_;
+}
+
+void SkeletalMeshComponentState::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void SkeletalMeshComponentState::Clear() {
+// @@protoc_insertion_point(message_clear_start:unrealpb.SkeletalMeshComponentState)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    GOOGLE_DCHECK(_impl_.montage_ != nullptr);
+    _impl_.montage_->Clear();
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* SkeletalMeshComponentState::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional .unrealpb.AnimMontageState montage = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_montage(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* SkeletalMeshComponentState::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:unrealpb.SkeletalMeshComponentState)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // optional .unrealpb.AnimMontageState montage = 1;
+  if (_internal_has_montage()) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::montage(this),
+        _Internal::montage(this).GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:unrealpb.SkeletalMeshComponentState)
+  return target;
+}
+
+size_t SkeletalMeshComponentState::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:unrealpb.SkeletalMeshComponentState)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // optional .unrealpb.AnimMontageState montage = 1;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.montage_);
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData SkeletalMeshComponentState::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    SkeletalMeshComponentState::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*SkeletalMeshComponentState::GetClassData() const { return &_class_data_; }
+
+
+void SkeletalMeshComponentState::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<SkeletalMeshComponentState*>(&to_msg);
+  auto& from = static_cast<const SkeletalMeshComponentState&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:unrealpb.SkeletalMeshComponentState)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from._internal_has_montage()) {
+    _this->_internal_mutable_montage()->::unrealpb::AnimMontageState::MergeFrom(
+        from._internal_montage());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void SkeletalMeshComponentState::CopyFrom(const SkeletalMeshComponentState& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:unrealpb.SkeletalMeshComponentState)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool SkeletalMeshComponentState::IsInitialized() const {
+  return true;
+}
+
+void SkeletalMeshComponentState::InternalSwap(SkeletalMeshComponentState* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  swap(_impl_.montage_, other->_impl_.montage_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata SkeletalMeshComponentState::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_unreal_5fcomponents_2eproto_getter, &descriptor_table_unreal_5fcomponents_2eproto_once,
+      file_level_metadata_unreal_5fcomponents_2eproto[1]);
+}
+
+// ===================================================================
+
+class ProjectileMovementComponentState::_Internal {
+ public:
+  using HasBits = decltype(std::declval<ProjectileMovementComponentState>()._impl_._has_bits_);
+  static const ::unrealpb::FVector& velocity(const ProjectileMovementComponentState* msg);
+  static void set_has_velocity(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_isstopped(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+};
+
+const ::unrealpb::FVector&
+ProjectileMovementComponentState::_Internal::velocity(const ProjectileMovementComponentState* msg) {
+  return *msg->_impl_.velocity_;
+}
+void ProjectileMovementComponentState::clear_velocity() {
+  if (_impl_.velocity_ != nullptr) _impl_.velocity_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+ProjectileMovementComponentState::ProjectileMovementComponentState(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:unrealpb.ProjectileMovementComponentState)
+}
+ProjectileMovementComponentState::ProjectileMovementComponentState(const ProjectileMovementComponentState& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  ProjectileMovementComponentState* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.velocity_){nullptr}
+    , decltype(_impl_.isstopped_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  if (from._internal_has_velocity()) {
+    _this->_impl_.velocity_ = new ::unrealpb::FVector(*from._impl_.velocity_);
+  }
+  _this->_impl_.isstopped_ = from._impl_.isstopped_;
+  // @@protoc_insertion_point(copy_constructor:unrealpb.ProjectileMovementComponentState)
+}
+
+inline void ProjectileMovementComponentState::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.velocity_){nullptr}
+    , decltype(_impl_.isstopped_){false}
+  };
+}
+
+ProjectileMovementComponentState::~ProjectileMovementComponentState() {
+  // @@protoc_insertion_point(destructor:unrealpb.ProjectileMovementComponentState)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void ProjectileMovementComponentState::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  if (this != internal_default_instance()) delete _impl_.velocity_;
+}
+
+void ProjectileMovementComponentState::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void ProjectileMovementComponentState::Clear() {
+// @@protoc_insertion_point(message_clear_start:unrealpb.ProjectileMovementComponentState)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    GOOGLE_DCHECK(_impl_.velocity_ != nullptr);
+    _impl_.velocity_->Clear();
+  }
+  _impl_.isstopped_ = false;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* ProjectileMovementComponentState::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional .unrealpb.FVector velocity = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_velocity(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional bool isStopped = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_isstopped(&has_bits);
+          _impl_.isstopped_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* ProjectileMovementComponentState::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:unrealpb.ProjectileMovementComponentState)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // optional .unrealpb.FVector velocity = 1;
+  if (_internal_has_velocity()) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::velocity(this),
+        _Internal::velocity(this).GetCachedSize(), target, stream);
+  }
+
+  // optional bool isStopped = 2;
+  if (_internal_has_isstopped()) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(2, this->_internal_isstopped(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:unrealpb.ProjectileMovementComponentState)
+  return target;
+}
+
+size_t ProjectileMovementComponentState::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:unrealpb.ProjectileMovementComponentState)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    // optional .unrealpb.FVector velocity = 1;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.velocity_);
+    }
+
+    // optional bool isStopped = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 + 1;
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData ProjectileMovementComponentState::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    ProjectileMovementComponentState::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*ProjectileMovementComponentState::GetClassData() const { return &_class_data_; }
+
+
+void ProjectileMovementComponentState::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<ProjectileMovementComponentState*>(&to_msg);
+  auto& from = static_cast<const ProjectileMovementComponentState&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:unrealpb.ProjectileMovementComponentState)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_velocity()->::unrealpb::FVector::MergeFrom(
+          from._internal_velocity());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.isstopped_ = from._impl_.isstopped_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void ProjectileMovementComponentState::CopyFrom(const ProjectileMovementComponentState& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:unrealpb.ProjectileMovementComponentState)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool ProjectileMovementComponentState::IsInitialized() const {
+  return true;
+}
+
+void ProjectileMovementComponentState::InternalSwap(ProjectileMovementComponentState* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(ProjectileMovementComponentState, _impl_.isstopped_)
+      + sizeof(ProjectileMovementComponentState::_impl_.isstopped_)
+      - PROTOBUF_FIELD_OFFSET(ProjectileMovementComponentState, _impl_.velocity_)>(
+          reinterpret_cast<char*>(&_impl_.velocity_),
+          reinterpret_cast<char*>(&other->_impl_.velocity_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata ProjectileMovementComponentState::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_unreal_5fcomponents_2eproto_getter, &descriptor_table_unreal_5fcomponents_2eproto_once,
+      file_level_metadata_unreal_5fcomponents_2eproto[2]);
+}
+
+// ===================================================================
+
+class GameplayAttributeValue::_Internal {
+ public:
+  using HasBits = decltype(std::declval<GameplayAttributeValue>()._impl_._has_bits_);
+  static void set_has_basevalue(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_currentvalue(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+};
+
+GameplayAttributeValue::GameplayAttributeValue(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:unrealpb.GameplayAttributeValue)
+}
+GameplayAttributeValue::GameplayAttributeValue(const GameplayAttributeValue& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  GameplayAttributeValue* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.basevalue_){}
+    , decltype(_impl_.currentvalue_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.basevalue_, &from._impl_.basevalue_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.currentvalue_) -
+    reinterpret_cast<char*>(&_impl_.basevalue_)) + sizeof(_impl_.currentvalue_));
+  // @@protoc_insertion_point(copy_constructor:unrealpb.GameplayAttributeValue)
+}
+
+inline void GameplayAttributeValue::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.basevalue_){0}
+    , decltype(_impl_.currentvalue_){0}
+  };
+}
+
+GameplayAttributeValue::~GameplayAttributeValue() {
+  // @@protoc_insertion_point(destructor:unrealpb.GameplayAttributeValue)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void GameplayAttributeValue::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+}
+
+void GameplayAttributeValue::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void GameplayAttributeValue::Clear() {
+// @@protoc_insertion_point(message_clear_start:unrealpb.GameplayAttributeValue)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    ::memset(&_impl_.basevalue_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.currentvalue_) -
+        reinterpret_cast<char*>(&_impl_.basevalue_)) + sizeof(_impl_.currentvalue_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* GameplayAttributeValue::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional float baseValue = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 13)) {
+          _Internal::set_has_basevalue(&has_bits);
+          _impl_.basevalue_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr);
+          ptr += sizeof(float);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional float currentValue = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 21)) {
+          _Internal::set_has_currentvalue(&has_bits);
+          _impl_.currentvalue_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr);
+          ptr += sizeof(float);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* GameplayAttributeValue::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:unrealpb.GameplayAttributeValue)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // optional float baseValue = 1;
+  if (_internal_has_basevalue()) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFloatToArray(1, this->_internal_basevalue(), target);
+  }
+
+  // optional float currentValue = 2;
+  if (_internal_has_currentvalue()) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFloatToArray(2, this->_internal_currentvalue(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:unrealpb.GameplayAttributeValue)
+  return target;
+}
+
+size_t GameplayAttributeValue::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:unrealpb.GameplayAttributeValue)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    // optional float baseValue = 1;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 + 4;
+    }
+
+    // optional float currentValue = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 + 4;
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData GameplayAttributeValue::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    GameplayAttributeValue::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GameplayAttributeValue::GetClassData() const { return &_class_data_; }
+
+
+void GameplayAttributeValue::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<GameplayAttributeValue*>(&to_msg);
+  auto& from = static_cast<const GameplayAttributeValue&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:unrealpb.GameplayAttributeValue)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.basevalue_ = from._impl_.basevalue_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.currentvalue_ = from._impl_.currentvalue_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void GameplayAttributeValue::CopyFrom(const GameplayAttributeValue& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:unrealpb.GameplayAttributeValue)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool GameplayAttributeValue::IsInitialized() const {
+  return true;
+}
+
+void GameplayAttributeValue::InternalSwap(GameplayAttributeValue* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(GameplayAttributeValue, _impl_.currentvalue_)
+      + sizeof(GameplayAttributeValue::_impl_.currentvalue_)
+      - PROTOBUF_FIELD_OFFSET(GameplayAttributeValue, _impl_.basevalue_)>(
+          reinterpret_cast<char*>(&_impl_.basevalue_),
+          reinterpret_cast<char*>(&other->_impl_.basevalue_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata GameplayAttributeValue::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_unreal_5fcomponents_2eproto_getter, &descriptor_table_unreal_5fcomponents_2eproto_once,
+      file_level_metadata_unreal_5fcomponents_2eproto[3]);
+}
+
+// ===================================================================
+
+AbilitySystemComponentState_AttributesEntry_DoNotUse::AbilitySystemComponentState_AttributesEntry_DoNotUse() {}
+AbilitySystemComponentState_AttributesEntry_DoNotUse::AbilitySystemComponentState_AttributesEntry_DoNotUse(::PROTOBUF_NAMESPACE_ID::Arena* arena)
+    : SuperType(arena) {}
+void AbilitySystemComponentState_AttributesEntry_DoNotUse::MergeFrom(const AbilitySystemComponentState_AttributesEntry_DoNotUse& other) {
+  MergeFromInternal(other);
+}
+::PROTOBUF_NAMESPACE_ID::Metadata AbilitySystemComponentState_AttributesEntry_DoNotUse::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_unreal_5fcomponents_2eproto_getter, &descriptor_table_unreal_5fcomponents_2eproto_once,
+      file_level_metadata_unreal_5fcomponents_2eproto[4]);
+}
+
+// ===================================================================
+
+class AbilitySystemComponentState::_Internal {
+ public:
+};
+
+AbilitySystemComponentState::AbilitySystemComponentState(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  if (arena != nullptr && !is_message_owned) {
+    arena->OwnCustomDestructor(this, &AbilitySystemComponentState::ArenaDtor);
+  }
+  // @@protoc_insertion_point(arena_constructor:unrealpb.AbilitySystemComponentState)
+}
+AbilitySystemComponentState::AbilitySystemComponentState(const AbilitySystemComponentState& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  AbilitySystemComponentState* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_.attributes_)*/{}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _this->_impl_.attributes_.MergeFrom(from._impl_.attributes_);
+  // @@protoc_insertion_point(copy_constructor:unrealpb.AbilitySystemComponentState)
+}
+
+inline void AbilitySystemComponentState::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_.attributes_)*/{::_pbi::ArenaInitialized(), arena}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+AbilitySystemComponentState::~AbilitySystemComponentState() {
+  // @@protoc_insertion_point(destructor:unrealpb.AbilitySystemComponentState)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    ArenaDtor(this);
+    return;
+  }
+  SharedDtor();
+}
+
+inline void AbilitySystemComponentState::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.attributes_.Destruct();
+  _impl_.attributes_.~MapField();
+}
+
+void AbilitySystemComponentState::ArenaDtor(void* object) {
+  AbilitySystemComponentState* _this = reinterpret_cast< AbilitySystemComponentState* >(object);
+  _this->_impl_.attributes_.Destruct();
+}
+void AbilitySystemComponentState::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void AbilitySystemComponentState::Clear() {
+// @@protoc_insertion_point(message_clear_start:unrealpb.AbilitySystemComponentState)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.attributes_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* AbilitySystemComponentState::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // map<uint32, .unrealpb.GameplayAttributeValue> attributes = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(&_impl_.attributes_, ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<10>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* AbilitySystemComponentState::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:unrealpb.AbilitySystemComponentState)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // map<uint32, .unrealpb.GameplayAttributeValue> attributes = 1;
+  if (!this->_internal_attributes().empty()) {
+    using MapType = ::_pb::Map<uint32_t, ::unrealpb::GameplayAttributeValue>;
+    using WireHelper = AbilitySystemComponentState_AttributesEntry_DoNotUse::Funcs;
+    const auto& map_field = this->_internal_attributes();
+
+    if (stream->IsSerializationDeterministic() && map_field.size() > 1) {
+      for (const auto& entry : ::_pbi::MapSorterFlat<MapType>(map_field)) {
+        target = WireHelper::InternalSerialize(1, entry.first, entry.second, target, stream);
+      }
+    } else {
+      for (const auto& entry : map_field) {
+        target = WireHelper::InternalSerialize(1, entry.first, entry.second, target, stream);
+      }
+    }
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:unrealpb.AbilitySystemComponentState)
+  return target;
+}
+
+size_t AbilitySystemComponentState::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:unrealpb.AbilitySystemComponentState)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // map<uint32, .unrealpb.GameplayAttributeValue> attributes = 1;
+  total_size += 1 *
+      ::PROTOBUF_NAMESPACE_ID::internal::FromIntSize(this->_internal_attributes_size());
+  for (::PROTOBUF_NAMESPACE_ID::Map< uint32_t, ::unrealpb::GameplayAttributeValue >::const_iterator
+      it = this->_internal_attributes().begin();
+      it != this->_internal_attributes().end(); ++it) {
+    total_size += AbilitySystemComponentState_AttributesEntry_DoNotUse::Funcs::ByteSizeLong(it->first, it->second);
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData AbilitySystemComponentState::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    AbilitySystemComponentState::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*AbilitySystemComponentState::GetClassData() const { return &_class_data_; }
+
+
+void AbilitySystemComponentState::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<AbilitySystemComponentState*>(&to_msg);
+  auto& from = static_cast<const AbilitySystemComponentState&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:unrealpb.AbilitySystemComponentState)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.attributes_.MergeFrom(from._impl_.attributes_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void AbilitySystemComponentState::CopyFrom(const AbilitySystemComponentState& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:unrealpb.AbilitySystemComponentState)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool AbilitySystemComponentState::IsInitialized() const {
+  return true;
+}
+
+void AbilitySystemComponentState::InternalSwap(AbilitySystemComponentState* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.attributes_.InternalSwap(&other->_impl_.attributes_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata AbilitySystemComponentState::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_unreal_5fcomponents_2eproto_getter, &descriptor_table_unreal_5fcomponents_2eproto_once,
+      file_level_metadata_unreal_5fcomponents_2eproto[5]);
+}
+
+// @@protoc_insertion_point(namespace_scope)
+}  // namespace unrealpb
+PROTOBUF_NAMESPACE_OPEN
+template<> PROTOBUF_NOINLINE ::unrealpb::AnimMontageState*
+Arena::CreateMaybeMessage< ::unrealpb::AnimMontageState >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::unrealpb::AnimMontageState >(arena);
+}
+template<> PROTOBUF_NOINLINE ::unrealpb::SkeletalMeshComponentState*
+Arena::CreateMaybeMessage< ::unrealpb::SkeletalMeshComponentState >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::unrealpb::SkeletalMeshComponentState >(arena);
+}
+template<> PROTOBUF_NOINLINE ::unrealpb::ProjectileMovementComponentState*
+Arena::CreateMaybeMessage< ::unrealpb::ProjectileMovementComponentState >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::unrealpb::ProjectileMovementComponentState >(arena);
+}
+template<> PROTOBUF_NOINLINE ::unrealpb::GameplayAttributeValue*
+Arena::CreateMaybeMessage< ::unrealpb::GameplayAttributeValue >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::unrealpb::GameplayAttributeValue >(arena);
+}
+template<> PROTOBUF_NOINLINE ::unrealpb::AbilitySystemComponentState_AttributesEntry_DoNotUse*
+Arena::CreateMaybeMessage< ::unrealpb::AbilitySystemComponentState_AttributesEntry_DoNotUse >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::unrealpb::AbilitySystemComponentState_AttributesEntry_DoNotUse >(arena);
+}
+template<> PROTOBUF_NOINLINE ::unrealpb::AbilitySystemComponentState*
+Arena::CreateMaybeMessage< ::unrealpb::AbilitySystemComponentState >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::unrealpb::AbilitySystemComponentState >(arena);
+}
+PROTOBUF_NAMESPACE_CLOSE
+
+// @@protoc_insertion_point(global_scope)
+#include <google/protobuf/port_undef.inc>
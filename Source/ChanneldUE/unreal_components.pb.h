@@ -0,0 +1,1612 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: unreal_components.proto
+
+#ifndef GOOGLE_PROTOBUF_INCLUDED_unreal_5fcomponents_2eproto
+#define GOOGLE_PROTOBUF_INCLUDED_unreal_5fcomponents_2eproto
+
+#include <limits>
+#include <string>
+
+#include <google/protobuf/port_def.inc>
+#if PROTOBUF_VERSION < 3021000
+#error This file was generated by a newer version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please update
+#error your headers.
+#endif
+#if 3021005 < PROTOBUF_MIN_PROTOC_VERSION
+#error This file was generated by an older version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please
+#error regenerate this file with a newer version of protoc.
+#endif
+
+#include <google/protobuf/port_undef.inc>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/arena.h>
+#include <google/protobuf/arenastring.h>
+#include <google/protobuf/generated_message_util.h>
+#include <google/protobuf/metadata_lite.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/repeated_field.h>  // IWYU pragma: export
+#include <google/protobuf/extension_set.h>  // IWYU pragma: export
+#include <google/protobuf/map.h>  // IWYU pragma: export
+#include <google/protobuf/map_entry.h>
+#include <google/protobuf/map_field_inl.h>
+#include <google/protobuf/unknown_field_set.h>
+#include "unreal_common.pb.h"
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+#define PROTOBUF_INTERNAL_EXPORT_unreal_5fcomponents_2eproto CHANNELDUE_API
+PROTOBUF_NAMESPACE_OPEN
+namespace internal {
+class AnyMetadata;
+}  // namespace internal
+PROTOBUF_NAMESPACE_CLOSE
+
+// Internal implementation detail -- do not use these members.
+struct CHANNELDUE_API TableStruct_unreal_5fcomponents_2eproto {
+  static const uint32_t offsets[];
+};
+CHANNELDUE_API extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_unreal_5fcomponents_2eproto;
+namespace unrealpb {
+class AbilitySystemComponentState;
+struct AbilitySystemComponentStateDefaultTypeInternal;
+CHANNELDUE_API extern AbilitySystemComponentStateDefaultTypeInternal _AbilitySystemComponentState_default_instance_;
+class AbilitySystemComponentState_AttributesEntry_DoNotUse;
+struct AbilitySystemComponentState_AttributesEntry_DoNotUseDefaultTypeInternal;
+CHANNELDUE_API extern AbilitySystemComponentState_AttributesEntry_DoNotUseDefaultTypeInternal _AbilitySystemComponentState_AttributesEntry_DoNotUse_default_instance_;
+class AnimMontageState;
+struct AnimMontageStateDefaultTypeInternal;
+CHANNELDUE_API extern AnimMontageStateDefaultTypeInternal _AnimMontageState_default_instance_;
+class GameplayAttributeValue;
+struct GameplayAttributeValueDefaultTypeInternal;
+CHANNELDUE_API extern GameplayAttributeValueDefaultTypeInternal _GameplayAttributeValue_default_instance_;
+class ProjectileMovementComponentState;
+struct ProjectileMovementComponentStateDefaultTypeInternal;
+CHANNELDUE_API extern ProjectileMovementComponentStateDefaultTypeInternal _ProjectileMovementComponentState_default_instance_;
+class SkeletalMeshComponentState;
+struct SkeletalMeshComponentStateDefaultTypeInternal;
+CHANNELDUE_API extern SkeletalMeshComponentStateDefaultTypeInternal _SkeletalMeshComponentState_default_instance_;
+}  // namespace unrealpb
+PROTOBUF_NAMESPACE_OPEN
+template<> CHANNELDUE_API ::unrealpb::AbilitySystemComponentState* Arena::CreateMaybeMessage<::unrealpb::AbilitySystemComponentState>(Arena*);
+template<> CHANNELDUE_API ::unrealpb::AbilitySystemComponentState_AttributesEntry_DoNotUse* Arena::CreateMaybeMessage<::unrealpb::AbilitySystemComponentState_AttributesEntry_DoNotUse>(Arena*);
+template<> CHANNELDUE_API ::unrealpb::AnimMontageState* Arena::CreateMaybeMessage<::unrealpb::AnimMontageState>(Arena*);
+template<> CHANNELDUE_API ::unrealpb::GameplayAttributeValue* Arena::CreateMaybeMessage<::unrealpb::GameplayAttributeValue>(Arena*);
+template<> CHANNELDUE_API ::unrealpb::ProjectileMovementComponentState* Arena::CreateMaybeMessage<::unrealpb::ProjectileMovementComponentState>(Arena*);
+template<> CHANNELDUE_API ::unrealpb::SkeletalMeshComponentState* Arena::CreateMaybeMessage<::unrealpb::SkeletalMeshComponentState>(Arena*);
+PROTOBUF_NAMESPACE_CLOSE
+namespace unrealpb {
+
+// ===================================================================
+
+class CHANNELDUE_API AnimMontageState final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:unrealpb.AnimMontageState) */ {
+ public:
+  inline AnimMontageState() : AnimMontageState(nullptr) {}
+  ~AnimMontageState() override;
+  explicit PROTOBUF_CONSTEXPR AnimMontageState(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  AnimMontageState(const AnimMontageState& from);
+  AnimMontageState(AnimMontageState&& from) noexcept
+    : AnimMontageState() {
+    *this = ::std::move(from);
+  }
+
+  inline AnimMontageState& operator=(const AnimMontageState& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline AnimMontageState& operator=(AnimMontageState&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const AnimMontageState& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const AnimMontageState* internal_default_instance() {
+    return reinterpret_cast<const AnimMontageState*>(
+               &_AnimMontageState_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    0;
+
+  friend void swap(AnimMontageState& a, AnimMontageState& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(AnimMontageState* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(AnimMontageState* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  AnimMontageState* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<AnimMontageState>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const AnimMontageState& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const AnimMontageState& from) {
+    AnimMontageState::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(AnimMontageState* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "unrealpb.AnimMontageState";
+  }
+  protected:
+  explicit AnimMontageState(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kSectionFieldNumber = 5,
+    kMontageFieldNumber = 1,
+    kPlayCountFieldNumber = 2,
+    kPlayRateFieldNumber = 3,
+    kPositionFieldNumber = 4,
+    kIsStoppedFieldNumber = 6,
+  };
+  // optional string section = 5;
+  bool has_section() const;
+  private:
+  bool _internal_has_section() const;
+  public:
+  void clear_section();
+  const std::string& section() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_section(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_section();
+  PROTOBUF_NODISCARD std::string* release_section();
+  void set_allocated_section(std::string* section);
+  private:
+  const std::string& _internal_section() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_section(const std::string& value);
+  std::string* _internal_mutable_section();
+  public:
+
+  // optional .unrealpb.AssetRef montage = 1;
+  bool has_montage() const;
+  private:
+  bool _internal_has_montage() const;
+  public:
+  void clear_montage();
+  const ::unrealpb::AssetRef& montage() const;
+  PROTOBUF_NODISCARD ::unrealpb::AssetRef* release_montage();
+  ::unrealpb::AssetRef* mutable_montage();
+  void set_allocated_montage(::unrealpb::AssetRef* montage);
+  private:
+  const ::unrealpb::AssetRef& _internal_montage() const;
+  ::unrealpb::AssetRef* _internal_mutable_montage();
+  public:
+  void unsafe_arena_set_allocated_montage(
+      ::unrealpb::AssetRef* montage);
+  ::unrealpb::AssetRef* unsafe_arena_release_montage();
+
+  // optional uint32 playCount = 2;
+  bool has_playcount() const;
+  private:
+  bool _internal_has_playcount() const;
+  public:
+  void clear_playcount();
+  uint32_t playcount() const;
+  void set_playcount(uint32_t value);
+  private:
+  uint32_t _internal_playcount() const;
+  void _internal_set_playcount(uint32_t value);
+  public:
+
+  // optional float playRate = 3;
+  bool has_playrate() const;
+  private:
+  bool _internal_has_playrate() const;
+  public:
+  void clear_playrate();
+  float playrate() const;
+  void set_playrate(float value);
+  private:
+  float _internal_playrate() const;
+  void _internal_set_playrate(float value);
+  public:
+
+  // optional float position = 4;
+  bool has_position() const;
+  private:
+  bool _internal_has_position() const;
+  public:
+  void clear_position();
+  float position() const;
+  void set_position(float value);
+  private:
+  float _internal_position() const;
+  void _internal_set_position(float value);
+  public:
+
+  // optional bool isStopped = 6;
+  bool has_isstopped() const;
+  private:
+  bool _internal_has_isstopped() const;
+  public:
+  void clear_isstopped();
+  bool isstopped() const;
+  void set_isstopped(bool value);
+  private:
+  bool _internal_isstopped() const;
+  void _internal_set_isstopped(bool value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:unrealpb.AnimMontageState)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr section_;
+    ::unrealpb::AssetRef* montage_;
+    uint32_t playcount_;
+    float playrate_;
+    float position_;
+    bool isstopped_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_unreal_5fcomponents_2eproto;
+};
+// -------------------------------------------------------------------
+
+class CHANNELDUE_API SkeletalMeshComponentState final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:unrealpb.SkeletalMeshComponentState) */ {
+ public:
+  inline SkeletalMeshComponentState() : SkeletalMeshComponentState(nullptr) {}
+  ~SkeletalMeshComponentState() override;
+  explicit PROTOBUF_CONSTEXPR SkeletalMeshComponentState(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  SkeletalMeshComponentState(const SkeletalMeshComponentState& from);
+  SkeletalMeshComponentState(SkeletalMeshComponentState&& from) noexcept
+    : SkeletalMeshComponentState() {
+    *this = ::std::move(from);
+  }
+
+  inline SkeletalMeshComponentState& operator=(const SkeletalMeshComponentState& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline SkeletalMeshComponentState& operator=(SkeletalMeshComponentState&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const SkeletalMeshComponentState& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const SkeletalMeshComponentState* internal_default_instance() {
+    return reinterpret_cast<const SkeletalMeshComponentState*>(
+               &_SkeletalMeshComponentState_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    1;
+
+  friend void swap(SkeletalMeshComponentState& a, SkeletalMeshComponentState& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(SkeletalMeshComponentState* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(SkeletalMeshComponentState* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  SkeletalMeshComponentState* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<SkeletalMeshComponentState>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const SkeletalMeshComponentState& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const SkeletalMeshComponentState& from) {
+    SkeletalMeshComponentState::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(SkeletalMeshComponentState* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "unrealpb.SkeletalMeshComponentState";
+  }
+  protected:
+  explicit SkeletalMeshComponentState(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kMontageFieldNumber = 1,
+  };
+  // optional .unrealpb.AnimMontageState montage = 1;
+  bool has_montage() const;
+  private:
+  bool _internal_has_montage() const;
+  public:
+  void clear_montage();
+  const ::unrealpb::AnimMontageState& montage() const;
+  PROTOBUF_NODISCARD ::unrealpb::AnimMontageState* release_montage();
+  ::unrealpb::AnimMontageState* mutable_montage();
+  void set_allocated_montage(::unrealpb::AnimMontageState* montage);
+  private:
+  const ::unrealpb::AnimMontageState& _internal_montage() const;
+  ::unrealpb::AnimMontageState* _internal_mutable_montage();
+  public:
+  void unsafe_arena_set_allocated_montage(
+      ::unrealpb::AnimMontageState* montage);
+  ::unrealpb::AnimMontageState* unsafe_arena_release_montage();
+
+  // @@protoc_insertion_point(class_scope:unrealpb.SkeletalMeshComponentState)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::unrealpb::AnimMontageState* montage_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_unreal_5fcomponents_2eproto;
+};
+// -------------------------------------------------------------------
+
+class CHANNELDUE_API ProjectileMovementComponentState final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:unrealpb.ProjectileMovementComponentState) */ {
+ public:
+  inline ProjectileMovementComponentState() : ProjectileMovementComponentState(nullptr) {}
+  ~ProjectileMovementComponentState() override;
+  explicit PROTOBUF_CONSTEXPR ProjectileMovementComponentState(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  ProjectileMovementComponentState(const ProjectileMovementComponentState& from);
+  ProjectileMovementComponentState(ProjectileMovementComponentState&& from) noexcept
+    : ProjectileMovementComponentState() {
+    *this = ::std::move(from);
+  }
+
+  inline ProjectileMovementComponentState& operator=(const ProjectileMovementComponentState& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ProjectileMovementComponentState& operator=(ProjectileMovementComponentState&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ProjectileMovementComponentState& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ProjectileMovementComponentState* internal_default_instance() {
+    return reinterpret_cast<const ProjectileMovementComponentState*>(
+               &_ProjectileMovementComponentState_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    2;
+
+  friend void swap(ProjectileMovementComponentState& a, ProjectileMovementComponentState& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(ProjectileMovementComponentState* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ProjectileMovementComponentState* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  ProjectileMovementComponentState* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<ProjectileMovementComponentState>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const ProjectileMovementComponentState& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const ProjectileMovementComponentState& from) {
+    ProjectileMovementComponentState::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(ProjectileMovementComponentState* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "unrealpb.ProjectileMovementComponentState";
+  }
+  protected:
+  explicit ProjectileMovementComponentState(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kVelocityFieldNumber = 1,
+    kIsStoppedFieldNumber = 2,
+  };
+  // optional .unrealpb.FVector velocity = 1;
+  bool has_velocity() const;
+  private:
+  bool _internal_has_velocity() const;
+  public:
+  void clear_velocity();
+  const ::unrealpb::FVector& velocity() const;
+  PROTOBUF_NODISCARD ::unrealpb::FVector* release_velocity();
+  ::unrealpb::FVector* mutable_velocity();
+  void set_allocated_velocity(::unrealpb::FVector* velocity);
+  private:
+  const ::unrealpb::FVector& _internal_velocity() const;
+  ::unrealpb::FVector* _internal_mutable_velocity();
+  public:
+  void unsafe_arena_set_allocated_velocity(
+      ::unrealpb::FVector* velocity);
+  ::unrealpb::FVector* unsafe_arena_release_velocity();
+
+  // optional bool isStopped = 2;
+  bool has_isstopped() const;
+  private:
+  bool _internal_has_isstopped() const;
+  public:
+  void clear_isstopped();
+  bool isstopped() const;
+  void set_isstopped(bool value);
+  private:
+  bool _internal_isstopped() const;
+  void _internal_set_isstopped(bool value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:unrealpb.ProjectileMovementComponentState)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::unrealpb::FVector* velocity_;
+    bool isstopped_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_unreal_5fcomponents_2eproto;
+};
+// -------------------------------------------------------------------
+
+class CHANNELDUE_API GameplayAttributeValue final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:unrealpb.GameplayAttributeValue) */ {
+ public:
+  inline GameplayAttributeValue() : GameplayAttributeValue(nullptr) {}
+  ~GameplayAttributeValue() override;
+  explicit PROTOBUF_CONSTEXPR GameplayAttributeValue(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  GameplayAttributeValue(const GameplayAttributeValue& from);
+  GameplayAttributeValue(GameplayAttributeValue&& from) noexcept
+    : GameplayAttributeValue() {
+    *this = ::std::move(from);
+  }
+
+  inline GameplayAttributeValue& operator=(const GameplayAttributeValue& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline GameplayAttributeValue& operator=(GameplayAttributeValue&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const GameplayAttributeValue& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const GameplayAttributeValue* internal_default_instance() {
+    return reinterpret_cast<const GameplayAttributeValue*>(
+               &_GameplayAttributeValue_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    3;
+
+  friend void swap(GameplayAttributeValue& a, GameplayAttributeValue& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(GameplayAttributeValue* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(GameplayAttributeValue* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  GameplayAttributeValue* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<GameplayAttributeValue>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const GameplayAttributeValue& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const GameplayAttributeValue& from) {
+    GameplayAttributeValue::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(GameplayAttributeValue* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "unrealpb.GameplayAttributeValue";
+  }
+  protected:
+  explicit GameplayAttributeValue(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kBaseValueFieldNumber = 1,
+    kCurrentValueFieldNumber = 2,
+  };
+  // optional float baseValue = 1;
+  bool has_basevalue() const;
+  private:
+  bool _internal_has_basevalue() const;
+  public:
+  void clear_basevalue();
+  float basevalue() const;
+  void set_basevalue(float value);
+  private:
+  float _internal_basevalue() const;
+  void _internal_set_basevalue(float value);
+  public:
+
+  // optional float currentValue = 2;
+  bool has_currentvalue() const;
+  private:
+  bool _internal_has_currentvalue() const;
+  public:
+  void clear_currentvalue();
+  float currentvalue() const;
+  void set_currentvalue(float value);
+  private:
+  float _internal_currentvalue() const;
+  void _internal_set_currentvalue(float value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:unrealpb.GameplayAttributeValue)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    float basevalue_;
+    float currentvalue_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_unreal_5fcomponents_2eproto;
+};
+// -------------------------------------------------------------------
+
+class AbilitySystemComponentState_AttributesEntry_DoNotUse : public ::PROTOBUF_NAMESPACE_ID::internal::MapEntry<AbilitySystemComponentState_AttributesEntry_DoNotUse, 
+    uint32_t, ::unrealpb::GameplayAttributeValue,
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::TYPE_UINT32,
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::TYPE_MESSAGE> {
+public:
+  typedef ::PROTOBUF_NAMESPACE_ID::internal::MapEntry<AbilitySystemComponentState_AttributesEntry_DoNotUse, 
+    uint32_t, ::unrealpb::GameplayAttributeValue,
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::TYPE_UINT32,
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::TYPE_MESSAGE> SuperType;
+  AbilitySystemComponentState_AttributesEntry_DoNotUse();
+  explicit PROTOBUF_CONSTEXPR AbilitySystemComponentState_AttributesEntry_DoNotUse(
+      ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+  explicit AbilitySystemComponentState_AttributesEntry_DoNotUse(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  void MergeFrom(const AbilitySystemComponentState_AttributesEntry_DoNotUse& other);
+  static const AbilitySystemComponentState_AttributesEntry_DoNotUse* internal_default_instance() { return reinterpret_cast<const AbilitySystemComponentState_AttributesEntry_DoNotUse*>(&_AbilitySystemComponentState_AttributesEntry_DoNotUse_default_instance_); }
+  static bool ValidateKey(void*) { return true; }
+  static bool ValidateValue(void*) { return true; }
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+  friend struct ::TableStruct_unreal_5fcomponents_2eproto;
+};
+
+// -------------------------------------------------------------------
+
+class CHANNELDUE_API AbilitySystemComponentState final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:unrealpb.AbilitySystemComponentState) */ {
+ public:
+  inline AbilitySystemComponentState() : AbilitySystemComponentState(nullptr) {}
+  ~AbilitySystemComponentState() override;
+  explicit PROTOBUF_CONSTEXPR AbilitySystemComponentState(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  AbilitySystemComponentState(const AbilitySystemComponentState& from);
+  AbilitySystemComponentState(AbilitySystemComponentState&& from) noexcept
+    : AbilitySystemComponentState() {
+    *this = ::std::move(from);
+  }
+
+  inline AbilitySystemComponentState& operator=(const AbilitySystemComponentState& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline AbilitySystemComponentState& operator=(AbilitySystemComponentState&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const AbilitySystemComponentState& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const AbilitySystemComponentState* internal_default_instance() {
+    return reinterpret_cast<const AbilitySystemComponentState*>(
+               &_AbilitySystemComponentState_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    5;
+
+  friend void swap(AbilitySystemComponentState& a, AbilitySystemComponentState& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(AbilitySystemComponentState* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(AbilitySystemComponentState* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  AbilitySystemComponentState* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<AbilitySystemComponentState>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const AbilitySystemComponentState& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const AbilitySystemComponentState& from) {
+    AbilitySystemComponentState::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(AbilitySystemComponentState* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "unrealpb.AbilitySystemComponentState";
+  }
+  protected:
+  explicit AbilitySystemComponentState(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  private:
+  static void ArenaDtor(void* object);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kAttributesFieldNumber = 1,
+  };
+  // map<uint32, .unrealpb.GameplayAttributeValue> attributes = 1;
+  int attributes_size() const;
+  private:
+  int _internal_attributes_size() const;
+  public:
+  void clear_attributes();
+  private:
+  const ::PROTOBUF_NAMESPACE_ID::Map< uint32_t, ::unrealpb::GameplayAttributeValue >&
+      _internal_attributes() const;
+  ::PROTOBUF_NAMESPACE_ID::Map< uint32_t, ::unrealpb::GameplayAttributeValue >*
+      _internal_mutable_attributes();
+  public:
+  const ::PROTOBUF_NAMESPACE_ID::Map< uint32_t, ::unrealpb::GameplayAttributeValue >&
+      attributes() const;
+  ::PROTOBUF_NAMESPACE_ID::Map< uint32_t, ::unrealpb::GameplayAttributeValue >*
+      mutable_attributes();
+
+  // @@protoc_insertion_point(class_scope:unrealpb.AbilitySystemComponentState)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::MapField<
+        AbilitySystemComponentState_AttributesEntry_DoNotUse,
+        uint32_t, ::unrealpb::GameplayAttributeValue,
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::TYPE_UINT32,
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::TYPE_MESSAGE> attributes_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_unreal_5fcomponents_2eproto;
+};
+// ===================================================================
+
+
+// ===================================================================
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// AnimMontageState
+
+// optional .unrealpb.AssetRef montage = 1;
+inline bool AnimMontageState::_internal_has_montage() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.montage_ != nullptr);
+  return value;
+}
+inline bool AnimMontageState::has_montage() const {
+  return _internal_has_montage();
+}
+inline const ::unrealpb::AssetRef& AnimMontageState::_internal_montage() const {
+  const ::unrealpb::AssetRef* p = _impl_.montage_;
+  return p != nullptr ? *p : reinterpret_cast<const ::unrealpb::AssetRef&>(
+      ::unrealpb::_AssetRef_default_instance_);
+}
+inline const ::unrealpb::AssetRef& AnimMontageState::montage() const {
+  // @@protoc_insertion_point(field_get:unrealpb.AnimMontageState.montage)
+  return _internal_montage();
+}
+inline void AnimMontageState::unsafe_arena_set_allocated_montage(
+    ::unrealpb::AssetRef* montage) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.montage_);
+  }
+  _impl_.montage_ = montage;
+  if (montage) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:unrealpb.AnimMontageState.montage)
+}
+inline ::unrealpb::AssetRef* AnimMontageState::release_montage() {
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::unrealpb::AssetRef* temp = _impl_.montage_;
+  _impl_.montage_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::unrealpb::AssetRef* AnimMontageState::unsafe_arena_release_montage() {
+  // @@protoc_insertion_point(field_release:unrealpb.AnimMontageState.montage)
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::unrealpb::AssetRef* temp = _impl_.montage_;
+  _impl_.montage_ = nullptr;
+  return temp;
+}
+inline ::unrealpb::AssetRef* AnimMontageState::_internal_mutable_montage() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  if (_impl_.montage_ == nullptr) {
+    auto* p = CreateMaybeMessage<::unrealpb::AssetRef>(GetArenaForAllocation());
+    _impl_.montage_ = p;
+  }
+  return _impl_.montage_;
+}
+inline ::unrealpb::AssetRef* AnimMontageState::mutable_montage() {
+  ::unrealpb::AssetRef* _msg = _internal_mutable_montage();
+  // @@protoc_insertion_point(field_mutable:unrealpb.AnimMontageState.montage)
+  return _msg;
+}
+inline void AnimMontageState::set_allocated_montage(::unrealpb::AssetRef* montage) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete reinterpret_cast< ::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.montage_);
+  }
+  if (montage) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(
+                reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(montage));
+    if (message_arena != submessage_arena) {
+      montage = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, montage, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.montage_ = montage;
+  // @@protoc_insertion_point(field_set_allocated:unrealpb.AnimMontageState.montage)
+}
+
+// optional uint32 playCount = 2;
+inline bool AnimMontageState::_internal_has_playcount() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool AnimMontageState::has_playcount() const {
+  return _internal_has_playcount();
+}
+inline void AnimMontageState::clear_playcount() {
+  _impl_.playcount_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline uint32_t AnimMontageState::_internal_playcount() const {
+  return _impl_.playcount_;
+}
+inline uint32_t AnimMontageState::playcount() const {
+  // @@protoc_insertion_point(field_get:unrealpb.AnimMontageState.playCount)
+  return _internal_playcount();
+}
+inline void AnimMontageState::_internal_set_playcount(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.playcount_ = value;
+}
+inline void AnimMontageState::set_playcount(uint32_t value) {
+  _internal_set_playcount(value);
+  // @@protoc_insertion_point(field_set:unrealpb.AnimMontageState.playCount)
+}
+
+// optional float playRate = 3;
+inline bool AnimMontageState::_internal_has_playrate() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
+inline bool AnimMontageState::has_playrate() const {
+  return _internal_has_playrate();
+}
+inline void AnimMontageState::clear_playrate() {
+  _impl_.playrate_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline float AnimMontageState::_internal_playrate() const {
+  return _impl_.playrate_;
+}
+inline float AnimMontageState::playrate() const {
+  // @@protoc_insertion_point(field_get:unrealpb.AnimMontageState.playRate)
+  return _internal_playrate();
+}
+inline void AnimMontageState::_internal_set_playrate(float value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.playrate_ = value;
+}
+inline void AnimMontageState::set_playrate(float value) {
+  _internal_set_playrate(value);
+  // @@protoc_insertion_point(field_set:unrealpb.AnimMontageState.playRate)
+}
+
+// optional float position = 4;
+inline bool AnimMontageState::_internal_has_position() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
+  return value;
+}
+inline bool AnimMontageState::has_position() const {
+  return _internal_has_position();
+}
+inline void AnimMontageState::clear_position() {
+  _impl_.position_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000010u;
+}
+inline float AnimMontageState::_internal_position() const {
+  return _impl_.position_;
+}
+inline float AnimMontageState::position() const {
+  // @@protoc_insertion_point(field_get:unrealpb.AnimMontageState.position)
+  return _internal_position();
+}
+inline void AnimMontageState::_internal_set_position(float value) {
+  _impl_._has_bits_[0] |= 0x00000010u;
+  _impl_.position_ = value;
+}
+inline void AnimMontageState::set_position(float value) {
+  _internal_set_position(value);
+  // @@protoc_insertion_point(field_set:unrealpb.AnimMontageState.position)
+}
+
+// optional string section = 5;
+inline bool AnimMontageState::_internal_has_section() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool AnimMontageState::has_section() const {
+  return _internal_has_section();
+}
+inline void AnimMontageState::clear_section() {
+  _impl_.section_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& AnimMontageState::section() const {
+  // @@protoc_insertion_point(field_get:unrealpb.AnimMontageState.section)
+  return _internal_section();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void AnimMontageState::set_section(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.section_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:unrealpb.AnimMontageState.section)
+}
+inline std::string* AnimMontageState::mutable_section() {
+  std::string* _s = _internal_mutable_section();
+  // @@protoc_insertion_point(field_mutable:unrealpb.AnimMontageState.section)
+  return _s;
+}
+inline const std::string& AnimMontageState::_internal_section() const {
+  return _impl_.section_.Get();
+}
+inline void AnimMontageState::_internal_set_section(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.section_.Set(value, GetArenaForAllocation());
+}
+inline std::string* AnimMontageState::_internal_mutable_section() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.section_.Mutable(GetArenaForAllocation());
+}
+inline std::string* AnimMontageState::release_section() {
+  // @@protoc_insertion_point(field_release:unrealpb.AnimMontageState.section)
+  if (!_internal_has_section()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.section_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.section_.IsDefault()) {
+    _impl_.section_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void AnimMontageState::set_allocated_section(std::string* section) {
+  if (section != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.section_.SetAllocated(section, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.section_.IsDefault()) {
+    _impl_.section_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:unrealpb.AnimMontageState.section)
+}
+
+// optional bool isStopped = 6;
+inline bool AnimMontageState::_internal_has_isstopped() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000020u) != 0;
+  return value;
+}
+inline bool AnimMontageState::has_isstopped() const {
+  return _internal_has_isstopped();
+}
+inline void AnimMontageState::clear_isstopped() {
+  _impl_.isstopped_ = false;
+  _impl_._has_bits_[0] &= ~0x00000020u;
+}
+inline bool AnimMontageState::_internal_isstopped() const {
+  return _impl_.isstopped_;
+}
+inline bool AnimMontageState::isstopped() const {
+  // @@protoc_insertion_point(field_get:unrealpb.AnimMontageState.isStopped)
+  return _internal_isstopped();
+}
+inline void AnimMontageState::_internal_set_isstopped(bool value) {
+  _impl_._has_bits_[0] |= 0x00000020u;
+  _impl_.isstopped_ = value;
+}
+inline void AnimMontageState::set_isstopped(bool value) {
+  _internal_set_isstopped(value);
+  // @@protoc_insertion_point(field_set:unrealpb.AnimMontageState.isStopped)
+}
+
+// -------------------------------------------------------------------
+
+// SkeletalMeshComponentState
+
+// optional .unrealpb.AnimMontageState montage = 1;
+inline bool SkeletalMeshComponentState::_internal_has_montage() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.montage_ != nullptr);
+  return value;
+}
+inline bool SkeletalMeshComponentState::has_montage() const {
+  return _internal_has_montage();
+}
+inline void SkeletalMeshComponentState::clear_montage() {
+  if (_impl_.montage_ != nullptr) _impl_.montage_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const ::unrealpb::AnimMontageState& SkeletalMeshComponentState::_internal_montage() const {
+  const ::unrealpb::AnimMontageState* p = _impl_.montage_;
+  return p != nullptr ? *p : reinterpret_cast<const ::unrealpb::AnimMontageState&>(
+      ::unrealpb::_AnimMontageState_default_instance_);
+}
+inline const ::unrealpb::AnimMontageState& SkeletalMeshComponentState::montage() const {
+  // @@protoc_insertion_point(field_get:unrealpb.SkeletalMeshComponentState.montage)
+  return _internal_montage();
+}
+inline void SkeletalMeshComponentState::unsafe_arena_set_allocated_montage(
+    ::unrealpb::AnimMontageState* montage) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.montage_);
+  }
+  _impl_.montage_ = montage;
+  if (montage) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:unrealpb.SkeletalMeshComponentState.montage)
+}
+inline ::unrealpb::AnimMontageState* SkeletalMeshComponentState::release_montage() {
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::unrealpb::AnimMontageState* temp = _impl_.montage_;
+  _impl_.montage_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::unrealpb::AnimMontageState* SkeletalMeshComponentState::unsafe_arena_release_montage() {
+  // @@protoc_insertion_point(field_release:unrealpb.SkeletalMeshComponentState.montage)
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::unrealpb::AnimMontageState* temp = _impl_.montage_;
+  _impl_.montage_ = nullptr;
+  return temp;
+}
+inline ::unrealpb::AnimMontageState* SkeletalMeshComponentState::_internal_mutable_montage() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  if (_impl_.montage_ == nullptr) {
+    auto* p = CreateMaybeMessage<::unrealpb::AnimMontageState>(GetArenaForAllocation());
+    _impl_.montage_ = p;
+  }
+  return _impl_.montage_;
+}
+inline ::unrealpb::AnimMontageState* SkeletalMeshComponentState::mutable_montage() {
+  ::unrealpb::AnimMontageState* _msg = _internal_mutable_montage();
+  // @@protoc_insertion_point(field_mutable:unrealpb.SkeletalMeshComponentState.montage)
+  return _msg;
+}
+inline void SkeletalMeshComponentState::set_allocated_montage(::unrealpb::AnimMontageState* montage) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.montage_;
+  }
+  if (montage) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(montage);
+    if (message_arena != submessage_arena) {
+      montage = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, montage, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.montage_ = montage;
+  // @@protoc_insertion_point(field_set_allocated:unrealpb.SkeletalMeshComponentState.montage)
+}
+
+// -------------------------------------------------------------------
+
+// ProjectileMovementComponentState
+
+// optional .unrealpb.FVector velocity = 1;
+inline bool ProjectileMovementComponentState::_internal_has_velocity() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.velocity_ != nullptr);
+  return value;
+}
+inline bool ProjectileMovementComponentState::has_velocity() const {
+  return _internal_has_velocity();
+}
+inline const ::unrealpb::FVector& ProjectileMovementComponentState::_internal_velocity() const {
+  const ::unrealpb::FVector* p = _impl_.velocity_;
+  return p != nullptr ? *p : reinterpret_cast<const ::unrealpb::FVector&>(
+      ::unrealpb::_FVector_default_instance_);
+}
+inline const ::unrealpb::FVector& ProjectileMovementComponentState::velocity() const {
+  // @@protoc_insertion_point(field_get:unrealpb.ProjectileMovementComponentState.velocity)
+  return _internal_velocity();
+}
+inline void ProjectileMovementComponentState::unsafe_arena_set_allocated_velocity(
+    ::unrealpb::FVector* velocity) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.velocity_);
+  }
+  _impl_.velocity_ = velocity;
+  if (velocity) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:unrealpb.ProjectileMovementComponentState.velocity)
+}
+inline ::unrealpb::FVector* ProjectileMovementComponentState::release_velocity() {
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::unrealpb::FVector* temp = _impl_.velocity_;
+  _impl_.velocity_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::unrealpb::FVector* ProjectileMovementComponentState::unsafe_arena_release_velocity() {
+  // @@protoc_insertion_point(field_release:unrealpb.ProjectileMovementComponentState.velocity)
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::unrealpb::FVector* temp = _impl_.velocity_;
+  _impl_.velocity_ = nullptr;
+  return temp;
+}
+inline ::unrealpb::FVector* ProjectileMovementComponentState::_internal_mutable_velocity() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  if (_impl_.velocity_ == nullptr) {
+    auto* p = CreateMaybeMessage<::unrealpb::FVector>(GetArenaForAllocation());
+    _impl_.velocity_ = p;
+  }
+  return _impl_.velocity_;
+}
+inline ::unrealpb::FVector* ProjectileMovementComponentState::mutable_velocity() {
+  ::unrealpb::FVector* _msg = _internal_mutable_velocity();
+  // @@protoc_insertion_point(field_mutable:unrealpb.ProjectileMovementComponentState.velocity)
+  return _msg;
+}
+inline void ProjectileMovementComponentState::set_allocated_velocity(::unrealpb::FVector* velocity) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete reinterpret_cast< ::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.velocity_);
+  }
+  if (velocity) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(
+                reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(velocity));
+    if (message_arena != submessage_arena) {
+      velocity = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, velocity, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.velocity_ = velocity;
+  // @@protoc_insertion_point(field_set_allocated:unrealpb.ProjectileMovementComponentState.velocity)
+}
+
+// optional bool isStopped = 2;
+inline bool ProjectileMovementComponentState::_internal_has_isstopped() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool ProjectileMovementComponentState::has_isstopped() const {
+  return _internal_has_isstopped();
+}
+inline void ProjectileMovementComponentState::clear_isstopped() {
+  _impl_.isstopped_ = false;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline bool ProjectileMovementComponentState::_internal_isstopped() const {
+  return _impl_.isstopped_;
+}
+inline bool ProjectileMovementComponentState::isstopped() const {
+  // @@protoc_insertion_point(field_get:unrealpb.ProjectileMovementComponentState.isStopped)
+  return _internal_isstopped();
+}
+inline void ProjectileMovementComponentState::_internal_set_isstopped(bool value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.isstopped_ = value;
+}
+inline void ProjectileMovementComponentState::set_isstopped(bool value) {
+  _internal_set_isstopped(value);
+  // @@protoc_insertion_point(field_set:unrealpb.ProjectileMovementComponentState.isStopped)
+}
+
+// -------------------------------------------------------------------
+
+// GameplayAttributeValue
+
+// optional float baseValue = 1;
+inline bool GameplayAttributeValue::_internal_has_basevalue() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool GameplayAttributeValue::has_basevalue() const {
+  return _internal_has_basevalue();
+}
+inline void GameplayAttributeValue::clear_basevalue() {
+  _impl_.basevalue_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline float GameplayAttributeValue::_internal_basevalue() const {
+  return _impl_.basevalue_;
+}
+inline float GameplayAttributeValue::basevalue() const {
+  // @@protoc_insertion_point(field_get:unrealpb.GameplayAttributeValue.baseValue)
+  return _internal_basevalue();
+}
+inline void GameplayAttributeValue::_internal_set_basevalue(float value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.basevalue_ = value;
+}
+inline void GameplayAttributeValue::set_basevalue(float value) {
+  _internal_set_basevalue(value);
+  // @@protoc_insertion_point(field_set:unrealpb.GameplayAttributeValue.baseValue)
+}
+
+// optional float currentValue = 2;
+inline bool GameplayAttributeValue::_internal_has_currentvalue() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool GameplayAttributeValue::has_currentvalue() const {
+  return _internal_has_currentvalue();
+}
+inline void GameplayAttributeValue::clear_currentvalue() {
+  _impl_.currentvalue_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline float GameplayAttributeValue::_internal_currentvalue() const {
+  return _impl_.currentvalue_;
+}
+inline float GameplayAttributeValue::currentvalue() const {
+  // @@protoc_insertion_point(field_get:unrealpb.GameplayAttributeValue.currentValue)
+  return _internal_currentvalue();
+}
+inline void GameplayAttributeValue::_internal_set_currentvalue(float value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.currentvalue_ = value;
+}
+inline void GameplayAttributeValue::set_currentvalue(float value) {
+  _internal_set_currentvalue(value);
+  // @@protoc_insertion_point(field_set:unrealpb.GameplayAttributeValue.currentValue)
+}
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// AbilitySystemComponentState
+
+// map<uint32, .unrealpb.GameplayAttributeValue> attributes = 1;
+inline int AbilitySystemComponentState::_internal_attributes_size() const {
+  return _impl_.attributes_.size();
+}
+inline int AbilitySystemComponentState::attributes_size() const {
+  return _internal_attributes_size();
+}
+inline void AbilitySystemComponentState::clear_attributes() {
+  _impl_.attributes_.Clear();
+}
+inline const ::PROTOBUF_NAMESPACE_ID::Map< uint32_t, ::unrealpb::GameplayAttributeValue >&
+AbilitySystemComponentState::_internal_attributes() const {
+  return _impl_.attributes_.GetMap();
+}
+inline const ::PROTOBUF_NAMESPACE_ID::Map< uint32_t, ::unrealpb::GameplayAttributeValue >&
+AbilitySystemComponentState::attributes() const {
+  // @@protoc_insertion_point(field_map:unrealpb.AbilitySystemComponentState.attributes)
+  return _internal_attributes();
+}
+inline ::PROTOBUF_NAMESPACE_ID::Map< uint32_t, ::unrealpb::GameplayAttributeValue >*
+AbilitySystemComponentState::_internal_mutable_attributes() {
+  return _impl_.attributes_.MutableMap();
+}
+inline ::PROTOBUF_NAMESPACE_ID::Map< uint32_t, ::unrealpb::GameplayAttributeValue >*
+AbilitySystemComponentState::mutable_attributes() {
+  // @@protoc_insertion_point(field_mutable_map:unrealpb.AbilitySystemComponentState.attributes)
+  return _internal_mutable_attributes();
+}
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic pop
+#endif  // __GNUC__
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+
+// @@protoc_insertion_point(namespace_scope)
+
+}  // namespace unrealpb
+
+// @@protoc_insertion_point(global_scope)
+
+#include <google/protobuf/port_undef.inc>
+#endif  // GOOGLE_PROTOBUF_INCLUDED_GOOGLE_PROTOBUF_INCLUDED_unreal_5fcomponents_2eproto
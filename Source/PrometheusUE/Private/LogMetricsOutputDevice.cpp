@@ -1,5 +1,54 @@
 #include "LogMetricsOutputDevice.h"
 
+#include "HAL/RunnableThread.h"
+
+FLogMetricsOutputDevice::~FLogMetricsOutputDevice()
+{
+	Shutdown();
+}
+
+void FLogMetricsOutputDevice::SetSampleRate(const FName& Category, int32 SampleRate)
+{
+	check(Thread == nullptr);
+	TSharedRef<FCategorySampler> Sampler = MakeShared<FCategorySampler>();
+	Sampler->SampleRate = FMath::Max(1, SampleRate);
+	Samplers.Add(Category, Sampler);
+}
+
+void FLogMetricsOutputDevice::ParseSampleRates(const FString& SampleRatesStr)
+{
+	TArray<FString> Entries;
+	SampleRatesStr.ParseIntoArray(Entries, TEXT(","));
+	for (const FString& Entry : Entries)
+	{
+		FString CategoryStr, RateStr;
+		if (Entry.Split(TEXT(":"), &CategoryStr, &RateStr))
+		{
+			SetSampleRate(FName(*CategoryStr.TrimStartAndEnd()), FCString::Atoi(*RateStr));
+		}
+	}
+}
+
+void FLogMetricsOutputDevice::Start()
+{
+	if (Thread == nullptr)
+	{
+		bStopping = false;
+		Thread = FRunnableThread::Create(this, TEXT("LogMetricsWorker"), 0, TPri_BelowNormal);
+	}
+}
+
+void FLogMetricsOutputDevice::Shutdown()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+	DrainQueue();
+}
+
 void FLogMetricsOutputDevice::Serialize(const TCHAR* Message, ELogVerbosity::Type Verbosity, const FName& Category)
 {
 	if (Verbosity > ThresholdVerbosity)
@@ -7,19 +56,48 @@ void FLogMetricsOutputDevice::Serialize(const TCHAR* Message, ELogVerbosity::Typ
 		return;
 	}
 
-	TTuple<FName, ELogVerbosity::Type> Key(Category, Verbosity);
-	if (Counter* Ctr = CountersByCategory.FindRef(Key))
+	int32 Count = 1;
+	if (const TSharedRef<FCategorySampler>* Sampler = Samplers.Find(Category))
 	{
-		Ctr->Increment();
+		Count = (*Sampler)->SampleRate;
+		if (Count > 1 && (*Sampler)->NumLogs.Increment() % Count != 0)
+		{
+			return;
+		}
 	}
-	else
+	Queue.Enqueue({Category, Verbosity, Count});
+}
+
+uint32 FLogMetricsOutputDevice::Run()
+{
+	while (!bStopping)
+	{
+		DrainQueue();
+		// The counters are only scraped every few seconds, so there's no need to wake up for every log.
+		FPlatformProcess::Sleep(0.1f);
+	}
+	return 0;
+}
+
+void FLogMetricsOutputDevice::DrainQueue()
+{
+	FQueuedLog Log;
+	while (Queue.Dequeue(Log))
 	{
-		Counter* NewCounter = &Family->Add({
-			{"category", TCHAR_TO_UTF8(*Category.ToString())},
-			{"level", TCHAR_TO_UTF8(ToString(Verbosity))},
-			{"node", TCHAR_TO_UTF8(FPlatformProcess::ComputerName())},
-		});
-		CountersByCategory.Add(Key, NewCounter);
-		NewCounter->Increment();
+		TTuple<FName, ELogVerbosity::Type> Key(Log.Category, Log.Verbosity);
+		if (Counter* Ctr = CountersByCategory.FindRef(Key))
+		{
+			Ctr->Increment(Log.Count);
+		}
+		else
+		{
+			Counter* NewCounter = &Family->Add({
+				{"category", TCHAR_TO_UTF8(*Log.Category.ToString())},
+				{"level", TCHAR_TO_UTF8(ToString(Log.Verbosity))},
+				{"node", TCHAR_TO_UTF8(FPlatformProcess::ComputerName())},
+			});
+			CountersByCategory.Add(Key, NewCounter);
+			NewCounter->Increment(Log.Count);
+		}
 	}
 }
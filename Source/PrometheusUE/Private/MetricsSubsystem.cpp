@@ -73,6 +73,13 @@ void UMetricsSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 		LogMetricsCounterFamily = TSharedPtr<Family<Counter>>(LogMetricsFamily);
 		LogMetricsOutputDevice = MakeShared<FLogMetricsOutputDevice>(*LogMetricsFamily);
 		LogMetricsOutputDevice->ThresholdVerbosity = static_cast<ELogVerbosity::Type>(MetricsLogLevel);
+		FString MetricsLogSampling;
+		if (FParse::Value(CmdLine, TEXT("metricsLogSampling="), MetricsLogSampling))
+		{
+			UE_LOG(LogPrometheus, Log, TEXT("Parsed MetricsLogSampling from CLI: %s"), *MetricsLogSampling);
+			LogMetricsOutputDevice->ParseSampleRates(MetricsLogSampling);
+		}
+		LogMetricsOutputDevice->Start();
 		FOutputDeviceRedirector::Get()->AddOutputDevice(LogMetricsOutputDevice.Get());
 	}
 
@@ -88,6 +95,7 @@ void UMetricsSubsystem::Deinitialize()
 	if (LogMetricsOutputDevice.IsValid())
 	{
 		FOutputDeviceRedirector::Get()->RemoveOutputDevice(LogMetricsOutputDevice.Get());
+		LogMetricsOutputDevice->Shutdown();
 	}
 	if (LogMetricsCounterFamily.IsValid())
 	{
@@ -109,6 +117,18 @@ void UMetricsSubsystem::Deinitialize()
 		RegistryPtr->Remove(*Pair.Value->Family);
 	}
 	GaugeFamilies.Empty();
+
+	for (auto& Pair : HistogramFamilies)
+	{
+		RegistryPtr->Remove(*Pair.Value->Family);
+	}
+	HistogramFamilies.Empty();
+
+	for (auto& Pair : SummaryFamilies)
+	{
+		RegistryPtr->Remove(*Pair.Value->Family);
+	}
+	SummaryFamilies.Empty();
 	
 	if (ExposerPtr)
 	{
@@ -132,6 +152,22 @@ Family<Gauge>& UMetricsSubsystem::AddGaugeFamily(const FName& Name, const FStrin
 		.Register(*RegistryPtr);
 }
 
+Family<Histogram>& UMetricsSubsystem::AddHistogramFamily(const FName& Name, const FString& Help)
+{
+	return BuildHistogram()
+		.Name(std::string(TCHAR_TO_UTF8(*Name.ToString())))
+		.Help(std::string(TCHAR_TO_UTF8(*Help)))
+		.Register(*RegistryPtr);
+}
+
+Family<Summary>& UMetricsSubsystem::AddSummaryFamily(const FName& Name, const FString& Help)
+{
+	return BuildSummary()
+		.Name(std::string(TCHAR_TO_UTF8(*Name.ToString())))
+		.Help(std::string(TCHAR_TO_UTF8(*Help)))
+		.Register(*RegistryPtr);
+}
+
 void UMetricsSubsystem::Remove(const Family<Counter>& CounterFamily)
 {
 	RegistryPtr->Remove(CounterFamily);
@@ -141,3 +177,13 @@ void UMetricsSubsystem::Remove(const Family<Gauge>& GaugeFamily)
 {
 	RegistryPtr->Remove(GaugeFamily);
 }
+
+void UMetricsSubsystem::Remove(const Family<Histogram>& HistogramFamily)
+{
+	RegistryPtr->Remove(HistogramFamily);
+}
+
+void UMetricsSubsystem::Remove(const Family<Summary>& SummaryFamily)
+{
+	RegistryPtr->Remove(SummaryFamily);
+}
@@ -1,21 +1,68 @@
 #pragma once
 
 #include "Misc/OutputDevice.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "prometheus/family.h"
 #include "prometheus/counter.h"
 
 using namespace prometheus;
 
-class FLogMetricsOutputDevice : public FOutputDevice
+/**
+ * Counts the logs by category and verbosity. Serialize() only pushes the log to a lock-free queue on the logging thread,
+ * and a background worker updates the counters, so a log storm doesn't contend on the counters of the game thread.
+ */
+class FLogMetricsOutputDevice : public FOutputDevice, public FRunnable
 {
 public:
 	FLogMetricsOutputDevice(Family<Counter>& InFamily) : Family(&InFamily) {}
+	virtual ~FLogMetricsOutputDevice() override;
 
 	ELogVerbosity::Type ThresholdVerbosity = ELogVerbosity::Warning;
-	
+
+	// Only 1 in N logs of the category is queued, and counted as N logs. Should be set before Start().
+	void SetSampleRate(const FName& Category, int32 SampleRate);
+	// Parse "Category:N,Category:N", e.g. "LogChanneld:10,LogNet:5".
+	void ParseSampleRates(const FString& SampleRatesStr);
+
+	// Start the worker thread that drains the queue.
+	void Start();
+	// Stop the worker thread and count the remaining logs in the queue.
+	void Shutdown();
+
+	virtual bool CanBeUsedOnAnyThread() const override { return true; }
+	virtual bool CanBeUsedOnMultipleThreads() const override { return true; }
+
 protected:
 	Family<Counter>* Family;
+	// Only accessed by the worker thread.
 	TMap<TTuple<FName, ELogVerbosity::Type>, Counter*> CountersByCategory;
-	
+
+	struct FQueuedLog
+	{
+		FName Category;
+		ELogVerbosity::Type Verbosity;
+		int32 Count;
+	};
+	TQueue<FQueuedLog, EQueueMode::Mpsc> Queue;
+
+	struct FCategorySampler
+	{
+		int32 SampleRate = 1;
+		FThreadSafeCounter NumLogs;
+	};
+	// Read-only after Start(), so the logging threads can look it up without locking.
+	TMap<FName, TSharedRef<FCategorySampler>> Samplers;
+
+	FRunnableThread* Thread = nullptr;
+	FThreadSafeBool bStopping = false;
+
 	virtual void Serialize(const TCHAR* Message, ELogVerbosity::Type Verbosity, const class FName& Category) override;
+
+	virtual uint32 Run() override;
+	virtual void Stop() override { bStopping = true; }
+
+	void DrainQueue();
 };
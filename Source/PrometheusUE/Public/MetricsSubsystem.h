@@ -3,6 +3,9 @@
 #include "CoreMinimal.h"
 #include "prometheus/counter.h"
 #include "prometheus/gauge.h"
+#include "prometheus/histogram.h"
+#include "prometheus/summary.h"
+#include <algorithm>
 #include "prometheus/exposer.h"
 #include "prometheus/registry.h"
 #include "LogMetricsOutputDevice.h"
@@ -145,6 +148,154 @@ public:
 	}
 };
 
+UCLASS(BlueprintType)
+class PROMETHEUSUE_API UHistogram : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	Histogram* Histogram;
+
+	UFUNCTION(BlueprintCallable, Category = "Prometheus|Histogram")
+	void Observe(const float Value)
+	{
+		if (Histogram)
+		{
+			Histogram->Observe(Value);
+		}
+	}
+
+	// Same as UCounter, the histogram is not removed from the family when the UObject is destroyed, as that will reset the buckets.
+};
+
+UCLASS(BlueprintType)
+class PROMETHEUSUE_API UHistogramFamily : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	
+	Family<Histogram>* Family;
+
+	// The upper bounds of the buckets, in any order. The +Inf bucket is always added.
+	static Histogram::BucketBoundaries ToBucketBoundaries(const TArray<float>& Buckets)
+	{
+		Histogram::BucketBoundaries Boundaries(Buckets.GetData(), Buckets.GetData() + Buckets.Num());
+		std::sort(Boundaries.begin(), Boundaries.end());
+		return Boundaries;
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Prometheus|Histogram")
+	UHistogram* AddHistogram(const FName LabelName, const FString& Value, const TArray<float>& Buckets)
+	{
+		auto HistogramObj = NewObject<UHistogram>(this);
+		HistogramObj->Histogram = &Family->Add({{TCHAR_TO_UTF8(*LabelName.ToString()), TCHAR_TO_UTF8(*Value)}}, ToBucketBoundaries(Buckets));
+		return HistogramObj;
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Prometheus|Histogram")
+	UHistogram* AddDefaultHistogram(const TArray<float>& Buckets)
+	{
+		auto HistogramObj = NewObject<UHistogram>(this);
+		HistogramObj->Histogram = &Family->Add({}, ToBucketBoundaries(Buckets));
+		return HistogramObj;
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Prometheus|Histogram")
+	UHistogram* AddHistogramWithLabels(const TMap<FName, FString>& Labels, const TArray<float>& Buckets)
+	{
+		auto HistogramObj = NewObject<UHistogram>(this);
+		std::map<std::string, std::string> LabelMap;
+		for (const auto& Label : Labels)
+		{
+			LabelMap.insert({TCHAR_TO_UTF8(*Label.Key.ToString()), TCHAR_TO_UTF8(*Label.Value)});
+		}
+		HistogramObj->Histogram = &Family->Add(LabelMap, ToBucketBoundaries(Buckets));
+		return HistogramObj;
+	}
+};
+
+UCLASS(BlueprintType)
+class PROMETHEUSUE_API USummary : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	Summary* Summary;
+
+	UFUNCTION(BlueprintCallable, Category = "Prometheus|Summary")
+	void Observe(const float Value)
+	{
+		if (Summary)
+		{
+			Summary->Observe(Value);
+		}
+	}
+};
+
+UCLASS(BlueprintType)
+class PROMETHEUSUE_API USummaryFamily : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	
+	Family<Summary>* Family;
+
+	// The quantiles (0 to 1) mapped to their tolerated errors. Empty means the median, the 90th and the 99th percentiles.
+	static Summary::Quantiles ToQuantiles(const TMap<float, float>& Quantiles)
+	{
+		if (Quantiles.Num() == 0)
+		{
+			return {{0.5, 0.05}, {0.9, 0.01}, {0.99, 0.001}};
+		}
+		Summary::Quantiles Result;
+		for (const auto& Pair : Quantiles)
+		{
+			Result.emplace_back(FMath::Clamp(Pair.Key, 0.f, 1.f), Pair.Value);
+		}
+		return Result;
+	}
+
+	// The quantiles are calculated over the sliding window of MaxAgeSeconds.
+	UFUNCTION(BlueprintCallable, Category = "Prometheus|Summary")
+	USummary* AddSummary(const FName LabelName, const FString& Value, const TMap<float, float>& Quantiles, const float MaxAgeSeconds = 60.f)
+	{
+		auto SummaryObj = NewObject<USummary>(this);
+		SummaryObj->Summary = &Family->Add({{TCHAR_TO_UTF8(*LabelName.ToString()), TCHAR_TO_UTF8(*Value)}}, ToQuantiles(Quantiles), ToMaxAge(MaxAgeSeconds));
+		return SummaryObj;
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Prometheus|Summary")
+	USummary* AddDefaultSummary(const TMap<float, float>& Quantiles, const float MaxAgeSeconds = 60.f)
+	{
+		auto SummaryObj = NewObject<USummary>(this);
+		SummaryObj->Summary = &Family->Add({}, ToQuantiles(Quantiles), ToMaxAge(MaxAgeSeconds));
+		return SummaryObj;
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Prometheus|Summary")
+	USummary* AddSummaryWithLabels(const TMap<FName, FString>& Labels, const TMap<float, float>& Quantiles, const float MaxAgeSeconds = 60.f)
+	{
+		auto SummaryObj = NewObject<USummary>(this);
+		std::map<std::string, std::string> LabelMap;
+		for (const auto& Label : Labels)
+		{
+			LabelMap.insert({TCHAR_TO_UTF8(*Label.Key.ToString()), TCHAR_TO_UTF8(*Label.Value)});
+		}
+		SummaryObj->Summary = &Family->Add(LabelMap, ToQuantiles(Quantiles), ToMaxAge(MaxAgeSeconds));
+		return SummaryObj;
+	}
+
+private:
+	static std::chrono::milliseconds ToMaxAge(const float MaxAgeSeconds)
+	{
+		return std::chrono::milliseconds(FMath::Max(1, FMath::RoundToInt(MaxAgeSeconds * 1000.f)));
+	}
+};
+
 UCLASS(Transient, config = Engine)
 class PROMETHEUSUE_API UMetricsSubsystem : public UEngineSubsystem
 {
@@ -157,8 +308,12 @@ public:
 
 	Family<Counter>& AddCounterFamily(const FName& Name, const FString& Help);
 	Family<Gauge>& AddGaugeFamily(const FName& Name, const FString& Help);
+	Family<Histogram>& AddHistogramFamily(const FName& Name, const FString& Help);
+	Family<Summary>& AddSummaryFamily(const FName& Name, const FString& Help);
 	void Remove(const Family<Counter>& CounterFamily);
 	void Remove(const Family<Gauge>& GaugeFamily);
+	void Remove(const Family<Histogram>& HistogramFamily);
+	void Remove(const Family<Summary>& SummaryFamily);
 
 	UFUNCTION(BlueprintCallable, Category = "Prometheus", meta=(DisplayName="AddCounterFamily", ScriptName="AddCounterFamily"))
 	UCounterFamily* K2_AddCounterFamily(const FName Name, const FString& Help)
@@ -202,6 +357,48 @@ public:
 		return GaugeFamilies.FindRef(Name);
 	}
 
+	UFUNCTION(BlueprintCallable, Category = "Prometheus", meta=(DisplayName="AddHistogramFamily", ScriptName="AddHistogramFamily"))
+	UHistogramFamily* K2_AddHistogramFamily(const FName Name, const FString& Help)
+	{
+		auto FamilyObj = GetHistogramFamily(Name);
+		if (FamilyObj)
+		{
+			return FamilyObj;
+		}
+		
+		FamilyObj = NewObject<UHistogramFamily>(this);
+		FamilyObj->Family = &AddHistogramFamily(Name, Help);
+		HistogramFamilies.Add(Name, FamilyObj);
+		return FamilyObj;
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Prometheus")
+	UHistogramFamily* GetHistogramFamily(const FName Name)
+	{
+		return HistogramFamilies.FindRef(Name);
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Prometheus", meta=(DisplayName="AddSummaryFamily", ScriptName="AddSummaryFamily"))
+	USummaryFamily* K2_AddSummaryFamily(const FName Name, const FString& Help)
+	{
+		auto FamilyObj = GetSummaryFamily(Name);
+		if (FamilyObj)
+		{
+			return FamilyObj;
+		}
+		
+		FamilyObj = NewObject<USummaryFamily>(this);
+		FamilyObj->Family = &AddSummaryFamily(Name, Help);
+		SummaryFamilies.Add(Name, FamilyObj);
+		return FamilyObj;
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Prometheus")
+	USummaryFamily* GetSummaryFamily(const FName Name)
+	{
+		return SummaryFamilies.FindRef(Name);
+	}
+
 	UPROPERTY(Config)
 	int32 ExposerPort = 8081;
 
@@ -217,4 +414,8 @@ private:
 	TMap<FName, UCounterFamily*> CounterFamilies;
 	UPROPERTY()
 	TMap<FName, UGaugeFamily*> GaugeFamilies;
+	UPROPERTY()
+	TMap<FName, UHistogramFamily*> HistogramFamilies;
+	UPROPERTY()
+	TMap<FName, USummaryFamily*> SummaryFamilies;
 };
\ No newline at end of file
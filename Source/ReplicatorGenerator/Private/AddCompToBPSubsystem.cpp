@@ -1,5 +1,6 @@
 #include "AddCompToBPSubsystem.h"
 #include "ReplicatorGeneratorUtils.h"
+#include "Algo/Reverse.h"
 #include "Async/Async.h"
 #include "Commandlets/CommandletHelpers.h"
 #include "Commandlets/CookAndFilterRepActorCommandlet.h"
@@ -7,6 +8,7 @@
 #include "Framework/Notifications/NotificationManager.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/PackageName.h"
 #include "Widgets/Notifications/SNotificationList.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogAddRepCompToBP, Log, All);
@@ -21,6 +23,11 @@ Else if ((MsgIndex = OutMsg.Find(TEXT(#Type ":"))) != INDEX_NONE) \
 
 namespace AddCompToBPSubsystem
 {
+	// The editor time spent in modifying the Blueprints per tick.
+	constexpr double TimeSliceSeconds = 0.02;
+	// The max number of the Blueprint packages being loaded asynchronously at the same time.
+	constexpr int32 MaxLoadingPackages = 32;
+
 	struct FRestoreSelectedInstanceComponent
 	{
 		TWeakObjectPtr<UClass> ActorClass;
@@ -98,7 +105,7 @@ namespace AddCompToBPSubsystem
 	};
 }
 
-void UAddCompToBPSubsystem::ApplyChangesToBP(AActor* ActorContex)
+void UAddCompToBPSubsystem::ApplyChangesToBP(AActor* ActorContex, bool bNotify)
 {
 	int32 NumChangedProperties = 0;
 
@@ -158,6 +165,13 @@ void UAddCompToBPSubsystem::ApplyChangesToBP(AActor* ActorContex)
 			}
 		}
 
+		// The progress of the batch is shown by a single notification.
+		if (!bNotify)
+		{
+			UE_LOG(LogAddRepCompToBP, Verbose, TEXT("Updated Blueprint %s (%d property changes applied)"), *Blueprint->GetName(), NumChangedProperties);
+			return;
+		}
+
 		// Set up a notification record to indicate success/failure
 		FNotificationInfo NotificationInfo(FText::GetEmpty());
 		NotificationInfo.FadeInDuration = 1.0f;
@@ -230,6 +244,10 @@ void UAddCompToBPSubsystem::Tick(float DeltaTime)
 			}
 		}
 	}
+	else if (FilterRepActorProcessStatus == AddingComp)
+	{
+		TickAddingComp();
+	}
 	else if (FilterRepActorProcessStatus == Busy)
 	{
 		int32 ProcReturnCode;
@@ -237,10 +255,7 @@ void UAddCompToBPSubsystem::Tick(float DeltaTime)
 		{
 			if (ProcReturnCode == 0)
 			{
-				FilterRepActorProcessStatus = AddingComp;
-				AddCompToActorBPInternal(true);
-				FilterRepActorProcessStatus = Completed;
-				SpawnFilterRepActorSucceedNotification();
+				StartAddingComp();
 			}
 			else
 			{
@@ -275,7 +290,7 @@ void UAddCompToBPSubsystem::AddComponentToBlueprints(UClass* InCompClass, FName
 {
 	SpawnRunningFilterRepActorNotification();
 
-	if (FilterRepActorProcessStatus == Busy || FilterRepActorProcessStatus == Canceling)
+	if (FilterRepActorProcessStatus == Busy || FilterRepActorProcessStatus == AddingComp || FilterRepActorProcessStatus == Canceling)
 	{
 		return;
 	}
@@ -322,6 +337,22 @@ void UAddCompToBPSubsystem::AddComponentToBlueprints(UClass* InCompClass, FName
 
 void UAddCompToBPSubsystem::CancelFilterRepActor()
 {
+	if (FilterRepActorProcessStatus == AddingComp)
+	{
+		UE_LOG(LogAddRepCompToBP, Warning, TEXT("Canceled adding the replication components, %d of %d blueprints are processed"), NumProcessedBPs, NumTotalBPs);
+		AddingCompRunId++;
+		FilterRepActorProcessStatus = Canceled;
+		FinishAddingComp(true);
+		if (TSharedPtr<SNotificationItem> NotificationItem = FilterRepActorNotiPtr.Pin())
+		{
+			NotificationItem->SetText(LOCTEXT("AddingCompCanceled", "Canceled adding replication components"));
+			NotificationItem->SetCompletionState(SNotificationItem::CS_Fail);
+			NotificationItem->ExpireAndFadeout();
+			FilterRepActorNotiPtr.Reset();
+		}
+		return;
+	}
+
 	if (FilterRepActorProcessStatus != Busy)
 	{
 		return;
@@ -337,57 +368,148 @@ void UAddCompToBPSubsystem::CancelFilterRepActor()
 	FilterRepActorProcessStatus = Canceled;
 }
 
-void UAddCompToBPSubsystem::AddCompToActorBPInternal(bool ShowDialog)
+void UAddCompToBPSubsystem::StartAddingComp()
 {
 	TArray<FString> Result;
 	bool bLoadSuccess;
 	UCookAndFilterRepActorCommandlet::LoadResult(Result, bLoadSuccess);
-	TArray<FString> TargetAssetPathList;
+
+	AddingCompRunId++;
+	PendingBPPaths.Reset();
+	LoadedBPPaths.Reset();
+	ModifiedBPPaths.Reset();
+	NumLoadingBPs = 0;
+	NumProcessedBPs = 0;
 	for (FString ClassPath : Result)
 	{
 		if (ClassPath.RemoveFromEnd(TEXT("_C")))
 		{
-			UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *ClassPath);
-			if (BP == nullptr)
-			{
-				UE_LOG(LogAddRepCompToBP, Warning, TEXT("We could not load blueprint: %s"), *ClassPath);
-				continue;
-			}
-			if (BP->GeneratedClass != nullptr && !ChanneldReplicatorGeneratorUtils::HasRepComponent(BP->GeneratedClass))
+			PendingBPPaths.Add(ClassPath);
+		}
+	}
+	NumTotalBPs = PendingBPPaths.Num();
+	// Popped from the end
+	Algo::Reverse(PendingBPPaths);
+
+	FilterRepActorProcessStatus = AddingComp;
+	UE_LOG(LogAddRepCompToBP, Log, TEXT("Adding the replication component to %d blueprints"), NumTotalBPs);
+	RequestBPLoads();
+	UpdateAddingCompNotification();
+}
+
+void UAddCompToBPSubsystem::RequestBPLoads()
+{
+	while (PendingBPPaths.Num() > 0 && NumLoadingBPs < AddCompToBPSubsystem::MaxLoadingPackages)
+	{
+		const FString BPPath = PendingBPPaths.Pop(false);
+		NumLoadingBPs++;
+		TWeakObjectPtr<UAddCompToBPSubsystem> WeakThis(this);
+		const int32 RunId = AddingCompRunId;
+		LoadPackageAsync(FPackageName::ObjectPathToPackageName(BPPath), FLoadPackageAsyncDelegate::CreateLambda(
+			[WeakThis, BPPath, RunId](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
 			{
-				TargetAssetPathList.Add(ClassPath);
-				AActor* TargetCDO = Cast<AActor>(BP->GeneratedClass->GetDefaultObject());
-				TSharedPtr<IBlueprintEditor> BlueprintEditor = FKismetEditorUtilities::GetIBlueprintEditorForObject(TargetCDO, false);
-
-				UActorComponent* NewInstanceComponent = NewObject<UActorComponent>(TargetCDO, TargetRepCompClass, RepCompName, RF_Transactional);
-				// NewInstanceComponent->RegisterComponentWithWorld()
-				TargetCDO->Modify();
-				TargetCDO->AddInstanceComponent(NewInstanceComponent);
-				NewInstanceComponent->OnComponentCreated();
-				NewInstanceComponent->RegisterComponentWithWorld(TargetCDO->GetWorld());
-				// NewInstanceComponent->RegisterComponent();
-				// TargetCDO->RerunConstructionScripts();
-
-				ApplyChangesToBP(TargetCDO);
-			}
+				if (WeakThis.IsValid())
+				{
+					WeakThis->OnBPPackageLoaded(BPPath, RunId);
+				}
+			}));
+	}
+}
+
+void UAddCompToBPSubsystem::OnBPPackageLoaded(const FString& BPPath, int32 RunId)
+{
+	if (RunId != AddingCompRunId || FilterRepActorProcessStatus != AddingComp)
+	{
+		return;
+	}
+	NumLoadingBPs--;
+	// The failed loads are reported by AddCompToBP().
+	LoadedBPPaths.Add(BPPath);
+}
+
+void UAddCompToBPSubsystem::TickAddingComp()
+{
+	const double EndTime = FPlatformTime::Seconds() + AddCompToBPSubsystem::TimeSliceSeconds;
+	while (LoadedBPPaths.Num() > 0 && FPlatformTime::Seconds() < EndTime)
+	{
+		const FString BPPath = LoadedBPPaths.Pop(false);
+		if (AddCompToBP(BPPath))
+		{
+			ModifiedBPPaths.Add(BPPath);
 		}
+		NumProcessedBPs++;
+	}
+	RequestBPLoads();
+	UpdateAddingCompNotification();
+
+	if (NumProcessedBPs >= NumTotalBPs)
+	{
+		FilterRepActorProcessStatus = Completed;
+		FinishAddingComp(true);
+		SpawnFilterRepActorSucceedNotification();
+	}
+}
+
+bool UAddCompToBPSubsystem::AddCompToBP(const FString& BPPath)
+{
+	// Already loaded by the async loading, unless it failed.
+	UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *BPPath);
+	if (BP == nullptr)
+	{
+		UE_LOG(LogAddRepCompToBP, Warning, TEXT("We could not load blueprint: %s"), *BPPath);
+		return false;
+	}
+	if (BP->GeneratedClass == nullptr || ChanneldReplicatorGeneratorUtils::HasRepComponent(BP->GeneratedClass))
+	{
+		return false;
 	}
 
-	if (ShowDialog)
+	AActor* TargetCDO = Cast<AActor>(BP->GeneratedClass->GetDefaultObject());
+	TSharedPtr<IBlueprintEditor> BlueprintEditor = FKismetEditorUtilities::GetIBlueprintEditorForObject(TargetCDO, false);
+
+	UActorComponent* NewInstanceComponent = NewObject<UActorComponent>(TargetCDO, TargetRepCompClass, RepCompName, RF_Transactional);
+	// NewInstanceComponent->RegisterComponentWithWorld()
+	TargetCDO->Modify();
+	TargetCDO->AddInstanceComponent(NewInstanceComponent);
+	NewInstanceComponent->OnComponentCreated();
+	NewInstanceComponent->RegisterComponentWithWorld(TargetCDO->GetWorld());
+	// NewInstanceComponent->RegisterComponent();
+	// TargetCDO->RerunConstructionScripts();
+
+	ApplyChangesToBP(TargetCDO, false);
+	return true;
+}
+
+void UAddCompToBPSubsystem::FinishAddingComp(bool ShowDialog)
+{
+	PendingBPPaths.Empty();
+	LoadedBPPaths.Empty();
+	NumLoadingBPs = 0;
+
+	if (ShowDialog && ModifiedBPPaths.Num() > 0)
 	{
 		FString TargetAssetPathStr;
-		for (FString& TargetAssetPath : TargetAssetPathList)
+		for (FString& TargetAssetPath : ModifiedBPPaths)
 		{
 			TargetAssetPathStr.Append(FString::Printf(TEXT("  - %s\n"), *TargetAssetPath));
 		}
 		FText DialogText = FText::Format(
 			LOCTEXT("PluginButtonDialogText", "A total of {0} blueprints have been added replication component [{1}].\n\nBelow blueprint assets are unsaved, please save them manually!!!\n\n{2}"),
-			FText::FromString(FString::Printf(TEXT("%d"), TargetAssetPathList.Num())),
+			FText::FromString(FString::Printf(TEXT("%d"), ModifiedBPPaths.Num())),
 			FText::FromString(TargetRepCompClass->GetPathName()),
 			FText::FromString(TargetAssetPathStr)
 		);
 		FMessageDialog::Open(EAppMsgType::Ok, DialogText);
 	}
+	ModifiedBPPaths.Empty();
+}
+
+void UAddCompToBPSubsystem::UpdateAddingCompNotification()
+{
+	if (TSharedPtr<SNotificationItem> NotificationItem = FilterRepActorNotiPtr.Pin())
+	{
+		NotificationItem->SetText(FText::Format(LOCTEXT("AddingCompProgress", "Adding replication components ({0}/{1})"), NumProcessedBPs, NumTotalBPs));
+	}
 }
 
 void UAddCompToBPSubsystem::SpawnRunningFilterRepActorNotification()
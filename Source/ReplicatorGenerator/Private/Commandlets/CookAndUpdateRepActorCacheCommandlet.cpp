@@ -3,8 +3,12 @@
 
 #include "Commandlets/CookAndUpdateRepActorCacheCommandlet.h"
 
+#include "ChanneldRepClassTable.h"
+#include "ChanneldStaticActorTable.h"
 #include "ReplicatorGeneratorUtils.h"
 #include "Components/TimelineComponent.h"
+#include "GameFramework/Info.h"
+#include "Misc/PackageName.h"
 #include "Persistence/RepActorCacheController.h"
 
 void FLoadedObjectListener::StartListen()
@@ -20,6 +24,10 @@ void FLoadedObjectListener::StopListen()
 void FLoadedObjectListener::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
 {
 	const UClass* LoadedClass = Object->GetClass();
+	if (LoadedClass == UWorld::StaticClass() && Object->GetOuter() != nullptr)
+	{
+		LoadedMapPackages.Add(Object->GetOuter()->GetName());
+	}
 	while (LoadedClass != nullptr)
 	{
 		const FString ClassPath = LoadedClass->GetPathName();
@@ -56,32 +64,99 @@ UCookAndUpdateRepActorCacheCommandlet::UCookAndUpdateRepActorCacheCommandlet()
 
 int32 UCookAndUpdateRepActorCacheCommandlet::Main(const FString& CmdLineParams)
 {
-	FReplicatorGeneratorManager& GeneratorManager = FReplicatorGeneratorManager::Get();
+	URepActorCacheController* RepActorCacheController = GEditor->GetEditorSubsystem<URepActorCacheController>();
+	if (RepActorCacheController == nullptr)
+	{
+		return 1;
+	}
 
-	TSet<FSoftClassPath> LoadedRepClasses;
+	const TMap<FString, FRepActorAssetCache> LastAssetCaches = RepActorCacheController->GetAssetCaches();
+	TMap<FString, FRepActorAssetCache> AssetCaches;
+	URepActorCacheController::ScanProjectAssets(LastAssetCaches, AssetCaches);
+	URepActorCacheController::UpdateDependencyHashes(AssetCaches);
 
 	FLoadedObjectListener ObjLoadedListener;
-	ObjLoadedListener.StartListen();
-
-	const FString AdditionalParam(TEXT(" -SkipShaderCompile"));
-	FString NewCmdLine = CmdLineParams;
-	NewCmdLine.Append(AdditionalParam);
-	int32 Result = Super::Main(NewCmdLine);
-	
-	ObjLoadedListener.StopListen();
-	if (Result != 0)
+	const bool bIncremental = LastAssetCaches.Num() > 0 && !FParse::Param(*CmdLineParams, TEXT("FullScan"));
+	if (bIncremental)
 	{
-		return Result;
+		// Only the changed assets and the assets depending on them (e.g. the child Blueprints) need to be loaded again.
+		// The replicated classes of the other assets are taken from the last scan.
+		TArray<FString> ChangedPackages;
+		for (TPair<FString, FRepActorAssetCache>& Pair : AssetCaches)
+		{
+			const FRepActorAssetCache* LastAssetCache = LastAssetCaches.Find(Pair.Key);
+			if (LastAssetCache == nullptr || LastAssetCache->DependencyHash != Pair.Value.DependencyHash)
+			{
+				ChangedPackages.Add(Pair.Key);
+			}
+			else
+			{
+				Pair.Value.ClassPaths = LastAssetCache->ClassPaths;
+			}
+		}
+		int32 RemovedNum = 0;
+		for (const TPair<FString, FRepActorAssetCache>& Pair : LastAssetCaches)
+		{
+			if (FPackageName::IsScriptPackage(Pair.Key))
+			{
+				AssetCaches.Add(Pair.Key, Pair.Value);
+			}
+			else if (!AssetCaches.Contains(Pair.Key))
+			{
+				RemovedNum++;
+			}
+		}
+		if (ChangedPackages.Num() == 0 && RemovedNum == 0)
+		{
+			UE_LOG(LogChanneldRepGenerator, Display, TEXT("The replication actor cache is up to date"));
+			return 0;
+		}
+		UE_LOG(LogChanneldRepGenerator, Display, TEXT("Scanning %d changed assets (%d removed) of %d"), ChangedPackages.Num(), RemovedNum, AssetCaches.Num());
+
+		ObjLoadedListener.StartListen();
+		for (int32 i = 0; i < ChangedPackages.Num(); i++)
+		{
+			LoadPackage(nullptr, *ChangedPackages[i], LOAD_None);
+			if ((i + 1) % 100 == 0)
+			{
+				CollectGarbage(RF_NoFlags);
+			}
+		}
+		ObjLoadedListener.StopListen();
+	}
+	else
+	{
+		ObjLoadedListener.StartListen();
+
+		const FString AdditionalParam(TEXT(" -SkipShaderCompile"));
+		FString NewCmdLine = CmdLineParams;
+		NewCmdLine.Append(AdditionalParam);
+		int32 Result = Super::Main(NewCmdLine);
+
+		ObjLoadedListener.StopListen();
+		if (Result != 0)
+		{
+			return Result;
+		}
+	}
+
+	for (const FSoftClassPath& ObjSoftPath : ObjLoadedListener.FilteredClasses)
+	{
+		AssetCaches.FindOrAdd(ObjSoftPath.GetLongPackageName()).ClassPaths.AddUnique(ObjSoftPath.ToString());
 	}
 
-	LoadedRepClasses.Append(ObjLoadedListener.FilteredClasses);
 	TArray<const UClass*> TargetClasses;
 	bool bHasTimelineComponent = false;
-	for (const FSoftClassPath& ObjSoftPath : LoadedRepClasses)
+	for (const TPair<FString, FRepActorAssetCache>& Pair : AssetCaches)
 	{
-		if (const UClass* LoadedClass = ObjSoftPath.TryLoadClass<UObject>())
+		for (const FString& ClassPath : Pair.Value.ClassPaths)
 		{
-			TargetClasses.Add(LoadedClass);
+			const UClass* LoadedClass = FSoftClassPath(ClassPath).TryLoadClass<UObject>();
+			if (LoadedClass == nullptr)
+			{
+				continue;
+			}
+			TargetClasses.AddUnique(LoadedClass);
 			if (LoadedClass == UTimelineComponent::StaticClass())
 			{
 				bHasTimelineComponent = true;
@@ -90,17 +165,94 @@ int32 UCookAndUpdateRepActorCacheCommandlet::Main(const FString& CmdLineParams)
 			{
 				if (ChanneldReplicatorGeneratorUtils::HasTimelineComponent(LoadedClass))
 				{
-					TargetClasses.Add(UTimelineComponent::StaticClass());
+					TargetClasses.AddUnique(UTimelineComponent::StaticClass());
 					bHasTimelineComponent = true;
 				}
 			}
 		}
 	}
-	URepActorCacheController* RepActorCacheController = GEditor->GetEditorSubsystem<URepActorCacheController>();
-	if (RepActorCacheController == nullptr || !RepActorCacheController->SaveRepActorCache(TargetClasses))
+	if (!RepActorCacheController->SaveRepActorCache(TargetClasses, AssetCaches) || !SaveRepClassTable(TargetClasses))
 	{
 		return 1;
 	}
 
+	// In the incremental scan, only the changed maps are loaded.
+	for (const FString& MapPackageName : ObjLoadedListener.LoadedMapPackages)
+	{
+		// Skip the transient worlds, e.g. /Temp/Untitled
+		if (FPackageName::DoesPackageExist(MapPackageName) && !SaveStaticActorTable(MapPackageName))
+		{
+			return 1;
+		}
+	}
+
 	return 0;
 }
+
+bool UCookAndUpdateRepActorCacheCommandlet::SaveRepClassTable(const TArray<const UClass*>& TargetClasses)
+{
+	const FRepActorCache RepActorCache = URepActorCacheController::ConvertClassesToRepActorCache(TargetClasses);
+	TArray<FChanneldRepClassTable::FClassInfo> Classes;
+	Classes.Reserve(RepActorCache.RepActorRelationCaches.Num());
+	for (const FRepActorRelationCache& RelationCache : RepActorCache.RepActorRelationCaches)
+	{
+		FChanneldRepClassTable::FClassInfo& ClassInfo = Classes.AddDefaulted_GetRef();
+		ClassInfo.PathName = RelationCache.TargetClassPath;
+		ClassInfo.ParentPathName = RelationCache.ParentClassPath;
+		if (RelationCache.bIsComponent)
+		{
+			ClassInfo.Flags |= FChanneldRepClassTable::Flag_Component;
+		}
+		if (RelationCache.bIsChildOfGameState)
+		{
+			ClassInfo.Flags |= FChanneldRepClassTable::Flag_ChildOfGameState;
+		}
+		if (RelationCache.bIsChildOfWorldSetting)
+		{
+			ClassInfo.Flags |= FChanneldRepClassTable::Flag_ChildOfWorldSettings;
+		}
+	}
+	return FChanneldRepClassTable::Save(Classes);
+}
+
+bool UCookAndUpdateRepActorCacheCommandlet::SaveStaticActorTable(const FString& MapPackageName)
+{
+	UPackage* MapPackage = LoadPackage(nullptr, *MapPackageName, LOAD_None);
+	const UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+	if (World == nullptr || World->PersistentLevel == nullptr)
+	{
+		UE_LOG(LogChanneldRepGenerator, Warning, TEXT("Failed to load the map %s for the static actor table"), *MapPackageName);
+		return true;
+	}
+
+	FChanneldStaticActorTable Table;
+	Table.MapName = MapPackageName;
+	for (const AActor* Actor : World->PersistentLevel->Actors)
+	{
+		// The same filter as USpatialChannelDataView::SyncNetIds()
+		if (Actor == nullptr || Actor->IsA<AInfo>() || Actor->IsEditorOnly())
+		{
+			continue;
+		}
+		FChanneldStaticActor& StaticActor = Table.Actors.AddDefaulted_GetRef();
+		StaticActor.Path = Actor->GetPathName();
+		StaticActor.Location = Actor->GetActorLocation();
+	}
+
+	// The NetIds only change when the actors are added or removed.
+	Table.Actors.Sort([](const FChanneldStaticActor& Lhs, const FChanneldStaticActor& Rhs)
+	{
+		return Lhs.Path < Rhs.Path;
+	});
+	if (Table.Actors.Num() > FChanneldStaticActorTable::MaxNum)
+	{
+		UE_LOG(LogChanneldRepGenerator, Warning, TEXT("The map %s has %d static actors, only the first %d get the precomputed NetIds"), *MapPackageName, Table.Actors.Num(), FChanneldStaticActorTable::MaxNum);
+		Table.Actors.SetNum(FChanneldStaticActorTable::MaxNum);
+	}
+	for (int32 i = 0; i < Table.Actors.Num(); i++)
+	{
+		Table.Actors[i].NetId = FChanneldStaticActorTable::GetNetIdByIndex(i);
+	}
+
+	return Table.Save();
+}
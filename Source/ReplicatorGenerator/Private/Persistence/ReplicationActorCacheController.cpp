@@ -1,6 +1,11 @@
 ﻿#include "ReplicatorGeneratorUtils.h"
 #include "Persistence/RepActorCacheController.h"
 
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+
 void URepActorCacheController::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
@@ -52,36 +57,140 @@ FRepActorCache URepActorCacheController::ConvertClassesToRepActorCache(const TAr
 	return FRepActorCache(NewRepActorRelationCaches);
 }
 
-bool URepActorCacheController::SaveRepActorCache(const TArray<const UClass*>& InRepActorClasses)
+void URepActorCacheController::ScanProjectAssets(const TMap<FString, FRepActorAssetCache>& LastAssetCaches, TMap<FString, FRepActorAssetCache>& OutAssetCaches)
 {
-	ChanneldReplicatorGeneratorUtils::EnsureRepGenIntermediateDir();
-	return RepActorCacheModel.SaveData(ConvertClassesToRepActorCache(InRepActorClasses));
+	IFileManager& FileManager = IFileManager::Get();
+	TArray<FString> Files;
+	FileManager.FindFilesRecursive(Files, *FPaths::ProjectContentDir(), TEXT("*.uasset"), true, false);
+	FileManager.FindFilesRecursive(Files, *FPaths::ProjectContentDir(), TEXT("*.umap"), true, false, false);
+
+	OutAssetCaches.Empty(Files.Num());
+	TArray<uint8> FileContent;
+	for (const FString& File : Files)
+	{
+		FString PackageName;
+		if (!FPackageName::TryConvertFilenameToLongPackageName(File, PackageName))
+		{
+			continue;
+		}
+		const FFileStatData StatData = FileManager.GetStatData(*File);
+		FRepActorAssetCache& AssetCache = OutAssetCaches.Add(PackageName);
+		AssetCache.FileTime = StatData.ModificationTime;
+		AssetCache.FileSize = StatData.FileSize;
+
+		const FRepActorAssetCache* LastAssetCache = LastAssetCaches.Find(PackageName);
+		if (LastAssetCache != nullptr && LastAssetCache->FileTime == AssetCache.FileTime && LastAssetCache->FileSize == AssetCache.FileSize)
+		{
+			AssetCache.FileHash = LastAssetCache->FileHash;
+			continue;
+		}
+		FileContent.Reset();
+		if (FFileHelper::LoadFileToArray(FileContent, *File))
+		{
+			AssetCache.FileHash = CityHash64(reinterpret_cast<const char*>(FileContent.GetData()), FileContent.Num());
+		}
+	}
 }
 
-bool URepActorCacheController::NeedToRefreshCache()
+void URepActorCacheController::UpdateDependencyHashes(TMap<FString, FRepActorAssetCache>& InOutAssetCaches)
 {
-	EnsureLatestRepActorCache();
-	TArray<FString> Dirs = {FPaths::ProjectContentDir()};
-	while (Dirs.Num() > 0)
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	for (TPair<FString, FRepActorAssetCache>& Pair : InOutAssetCaches)
+	{
+		Pair.Value.DependencyHash = 0;
+	}
+
+	TSet<FString> VisitingPackages;
+	TFunction<uint64(const FString&)> GetDependencyHash = [&](const FString& PackageName) -> uint64
 	{
-		FString Dir = Dirs.Pop(false);
-		TArray<FString> Files;
-		IFileManager::Get().FindFiles(Files, *(Dir / TEXT("*.uasset")), true, false);
-		for (FString File : Files)
+		// The assets outside the project content directory, e.g. the engine content, are not tracked.
+		FRepActorAssetCache* AssetCache = InOutAssetCaches.Find(PackageName);
+		if (AssetCache == nullptr)
 		{
-			FDateTime FileTime = IFileManager::Get().GetTimeStamp(*(Dir / File));
-			if (FileTime > LatestRepActorCacheTime)
+			return 0;
+		}
+		if (AssetCache->DependencyHash != 0)
+		{
+			return AssetCache->DependencyHash;
+		}
+		// Circular reference
+		if (VisitingPackages.Contains(PackageName))
+		{
+			return AssetCache->FileHash;
+		}
+		VisitingPackages.Add(PackageName);
+
+		TArray<FName> Dependencies;
+		AssetRegistry.GetDependencies(FName(*PackageName), Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+		Dependencies.Sort(FNameLexicalLess());
+		uint64 Hash = AssetCache->FileHash;
+		for (const FName& Dependency : Dependencies)
+		{
+			const uint64 DependencyHash = GetDependencyHash(Dependency.ToString());
+			if (DependencyHash != 0)
 			{
-				UE_LOG(LogChanneldRepGenerator, Verbose, TEXT("File: %s, FileTime: %s, LatestRepActorCacheTime: %s"), *File, *FileTime.ToString(), *LatestRepActorCacheTime.ToString());
-				return true;
+				Hash = CityHash64WithSeed(reinterpret_cast<const char*>(&DependencyHash), sizeof(DependencyHash), Hash);
 			}
 		}
 
-		TArray<FString> DirsInDir;
-		IFileManager::Get().FindFiles(DirsInDir, *(Dir / TEXT("*")), false, true);
-		for (FString DirInDir : DirsInDir)
+		VisitingPackages.Remove(PackageName);
+		// No element is added to the map during the recursion, so the pointer is still valid.
+		AssetCache->DependencyHash = Hash;
+		return Hash;
+	};
+
+	// Visit in a fixed order so the hashes of the circular references are stable.
+	TArray<FString> PackageNames;
+	InOutAssetCaches.GetKeys(PackageNames);
+	PackageNames.Sort();
+	for (const FString& PackageName : PackageNames)
+	{
+		GetDependencyHash(PackageName);
+	}
+}
+
+bool URepActorCacheController::SaveRepActorCache(const TArray<const UClass*>& InRepActorClasses, const TMap<FString, FRepActorAssetCache>& InAssetCaches)
+{
+	ChanneldReplicatorGeneratorUtils::EnsureRepGenIntermediateDir();
+	FRepActorCache RepActorCache = ConvertClassesToRepActorCache(InRepActorClasses);
+	RepActorCache.AssetCaches = InAssetCaches;
+	return RepActorCacheModel.SaveData(RepActorCache);
+}
+
+const TMap<FString, FRepActorAssetCache>& URepActorCacheController::GetAssetCaches()
+{
+	EnsureLatestRepActorCache();
+	return AssetCaches;
+}
+
+bool URepActorCacheController::NeedToRefreshCache()
+{
+	EnsureLatestRepActorCache();
+	if (!RepActorCacheModel.IsLoadedDataValid())
+	{
+		return true;
+	}
+
+	// Only the file hashes are compared here, as any change of the dependencies is also a change of some project asset.
+	TMap<FString, FRepActorAssetCache> CurrentAssetCaches;
+	ScanProjectAssets(AssetCaches, CurrentAssetCaches);
+	for (const TPair<FString, FRepActorAssetCache>& Pair : CurrentAssetCaches)
+	{
+		const FRepActorAssetCache* LastAssetCache = AssetCaches.Find(Pair.Key);
+		if (LastAssetCache == nullptr || LastAssetCache->FileHash != Pair.Value.FileHash)
+		{
+			UE_LOG(LogChanneldRepGenerator, Verbose, TEXT("Asset changed: %s, FileTime: %s, LatestRepActorCacheTime: %s"), *Pair.Key, *Pair.Value.FileTime.ToString(), *LatestRepActorCacheTime.ToString());
+			return true;
+		}
+	}
+	for (const TPair<FString, FRepActorAssetCache>& Pair : AssetCaches)
+	{
+		if (!FPackageName::IsScriptPackage(Pair.Key) && !CurrentAssetCaches.Contains(Pair.Key))
 		{
-			Dirs.Add(Dir / DirInDir);
+			UE_LOG(LogChanneldRepGenerator, Verbose, TEXT("Asset removed: %s"), *Pair.Key);
+			return true;
 		}
 	}
 	return false;
@@ -239,6 +348,7 @@ void URepActorCacheController::EnsureLatestRepActorCache()
 		FRepActorCache NewRepActorCache;
 		RepActorCacheModel.GetData(NewRepActorCache);
 		LatestRepActorCacheTime = NewRepActorCache.CacheTime;
+		AssetCaches = MoveTemp(NewRepActorCache.AssetCaches);
 		SetRepActorRelationCaches(NewRepActorCache.RepActorRelationCaches);
 	}
 }
@@ -177,20 +177,37 @@ FString FPropertyDecorator::GetCode_AssignPropPointerStatic(const FString& Conta
 	return FString::Format(PropDecorator_AssignPropPtrStatic, FormatArgs);
 }
 
-FString FPropertyDecorator::GetCode_AssignPropPointerDynamic(const FString& Container, const FString& AssignTo)
+FString FPropertyDecorator::GetCode_AssignPropPointerByTable(const FString& Container, const FString& AssignTo, const FString& OffsetCode)
+{
+	FStringFormatNamedArguments FormatArgs;
+	FormatArgs.Add(TEXT("Ref_AssignTo"), AssignTo);
+	FormatArgs.Add(TEXT("Ref_ContainerAddr"), Container);
+	FormatArgs.Add(TEXT("Declare_PropertyCPPType"), GetCPPType());
+	FormatArgs.Add(TEXT("Num_PropMemOffset"), OffsetCode);
+
+	return FString::Format(PropDecorator_AssignPropPtrStatic, FormatArgs);
+}
+
+FString FPropertyDecorator::GetCode_AssignPropPointerNative(const FString& Container, const FString& AssignTo)
 {
 	FStringFormatNamedArguments FormatArgs;
 	FormatArgs.Add(TEXT("Ref_AssignTo"), AssignTo);
 	FormatArgs.Add(TEXT("Ref_ContainerAddr"), Container);
 	FormatArgs.Add(TEXT("Declare_PropertyCPPType"), GetCPPType());
 	FormatArgs.Add(TEXT("Num_PropMemOffset"), GetMemOffset());
-    FormatArgs.Add(TEXT("Declare_PropertyName"), GetPropertyName());
+	FormatArgs.Add(TEXT("Declare_PropertyName"), GetPropertyName());
 
-	return FString::Format(PropDecorator_AssignPropPtrDynamic, FormatArgs);
+	return FString::Format(PropDecorator_AssignPropPtrNative, FormatArgs);
 }
 
 FString FPropertyDecorator::GetCode_GetProtoFieldValueFrom(const FString& StateName)
 {
+	if (IsPackedInFlags())
+	{
+		return GetPackedFlagsWidth() == 1
+			? FString::Printf(TEXT("(((%s->packed_flags() >> %d) & 1u) != 0)"), *StateName, PackedFlagsShift)
+			: FString::Printf(TEXT("static_cast<uint8>(%s->packed_flags() >> %d)"), *StateName, PackedFlagsShift);
+	}
 	return FString::Printf(TEXT("%s->%s()"), *StateName, *GetProtoFieldName());
 }
 
@@ -201,9 +218,200 @@ FString FPropertyDecorator::GetCode_SetProtoFieldValueTo(const FString& StateNam
 
 FString FPropertyDecorator::GetCode_HasProtoFieldValueIn(const FString& StateName)
 {
+	if (IsPackedInFlags())
+	{
+		// The packed_flags field always carries all the packed properties.
+		return FString::Printf(TEXT("%s->has_packed_flags()"), *StateName);
+	}
 	return FString::Printf(TEXT("%s->has_%s()"), *StateName, *GetProtoFieldName());
 }
 
+FString FPropertyDecorator::GetCode_HasMergeableProtoFieldValueIn(const FString& StateName)
+{
+	const FString FieldName = GetProtoFieldName();
+	const FString FieldRule = GetProtoFieldRule();
+	if (FieldRule == TEXT("repeated"))
+	{
+		return FString::Printf(TEXT("%s->%s_size() > 0"), *StateName, *FieldName);
+	}
+	if (FieldRule.IsEmpty())
+	{
+		// Field without presence (e.g. bytes): only the non-default value is merged.
+		return GetProtoFieldType() == TEXT("bytes") || GetProtoFieldType() == TEXT("string")
+			? FString::Printf(TEXT("!%s->%s().empty()"), *StateName, *FieldName)
+			: FString::Printf(TEXT("%s->%s() != 0"), *StateName, *FieldName);
+	}
+	return GetCode_HasProtoFieldValueIn(StateName);
+}
+
+FString FPropertyDecorator::GetCode_MergeProtoField(const FString& DstStateName, const FString& SrcStateName)
+{
+	const FString FieldName = GetProtoFieldName();
+	FString Code_Merge;
+	if (GetProtoFieldRule() == TEXT("repeated") || !IsProtoFieldScalar())
+	{
+		// Same as MergeFrom(): the repeated elements are appended, and the message fields are merged.
+		Code_Merge = FString::Printf(TEXT("%s->mutable_%s()->MergeFrom(%s->%s());"), *DstStateName, *FieldName, *SrcStateName, *FieldName);
+	}
+	else
+	{
+		Code_Merge = FString::Printf(TEXT("%s->set_%s(%s->%s());"), *DstStateName, *FieldName, *SrcStateName, *FieldName);
+	}
+	return FString::Printf(TEXT("if (%s)\n{\n  %s\n}\n"), *GetCode_HasMergeableProtoFieldValueIn(SrcStateName), *Code_Merge);
+}
+
+FString FPropertyDecorator::GetProtoFieldNameGo()
+{
+	// Same as the GoCamelCase() of protoc-gen-go
+	const FString FieldName = GetProtoFieldName();
+	FString GoName;
+	for (int32 i = 0; i < FieldName.Len(); ++i)
+	{
+		const TCHAR C = FieldName[i];
+		if (C == '_' && i == 0)
+		{
+			GoName.AppendChar('X');
+		}
+		else if (C == '_' && i + 1 < FieldName.Len() && FChar::IsLower(FieldName[i + 1]))
+		{
+			// Skip the '_' in "_{lowercase}"
+		}
+		else if (FChar::IsDigit(C))
+		{
+			GoName.AppendChar(C);
+		}
+		else
+		{
+			// The start of a word
+			GoName.AppendChar(FChar::IsLower(C) ? FChar::ToUpper(C) : C);
+			while (i + 1 < FieldName.Len() && FChar::IsLower(FieldName[i + 1]))
+			{
+				GoName.AppendChar(FieldName[++i]);
+			}
+		}
+	}
+	return GoName;
+}
+
+FString FPropertyDecorator::GetCode_MergeProtoFieldGo(const FString& DstStateName, const FString& SrcStateName)
+{
+	const FString FieldName = GetProtoFieldNameGo();
+	const FString FieldRule = GetProtoFieldRule();
+	if (FieldRule == TEXT("repeated"))
+	{
+		return FString::Printf(TEXT("if len(%s.%s) > 0 {\n\t%s.%s = append(%s.%s, %s.%s...)\n}\n"),
+			*SrcStateName, *FieldName, *DstStateName, *FieldName, *DstStateName, *FieldName, *SrcStateName, *FieldName);
+	}
+	if (FieldRule.IsEmpty())
+	{
+		return FString::Printf(TEXT("if len(%s.%s) > 0 {\n\t%s.%s = %s.%s\n}\n"),
+			*SrcStateName, *FieldName, *DstStateName, *FieldName, *SrcStateName, *FieldName);
+	}
+	if (IsProtoFieldScalar())
+	{
+		// The merge never writes through the pointers, so the value can be shared.
+		return FString::Printf(TEXT("if %s.%s != nil {\n\t%s.%s = %s.%s\n}\n"),
+			*SrcStateName, *FieldName, *DstStateName, *FieldName, *SrcStateName, *FieldName);
+	}
+	return FString::Printf(TEXT("if %s.%s != nil {\n\tif %s.%s == nil {\n\t\t%s.%s = %s.%s\n\t} else {\n\t\tproto.Merge(%s.%s, %s.%s)\n\t}\n}\n"),
+		*SrcStateName, *FieldName, *DstStateName, *FieldName, *DstStateName, *FieldName, *SrcStateName, *FieldName,
+		*DstStateName, *FieldName, *SrcStateName, *FieldName);
+}
+
+FString FPropertyDecorator::GetCode_ProtoFieldSampleValueGo()
+{
+	if (GetProtoFieldRule() != TEXT("optional") || IsPackedInFlags())
+	{
+		return FString();
+	}
+	static const TMap<FString, FString> SampleValues = {
+		{TEXT("bool"), TEXT("proto.Bool(true)")},
+		{TEXT("int32"), TEXT("proto.Int32(1)")},
+		{TEXT("sint32"), TEXT("proto.Int32(1)")},
+		{TEXT("int64"), TEXT("proto.Int64(1)")},
+		{TEXT("sint64"), TEXT("proto.Int64(1)")},
+		{TEXT("uint32"), TEXT("proto.Uint32(1)")},
+		{TEXT("uint64"), TEXT("proto.Uint64(1)")},
+		{TEXT("float"), TEXT("proto.Float32(1)")},
+		{TEXT("double"), TEXT("proto.Float64(1)")},
+		{TEXT("string"), TEXT("proto.String(\"a\")")},
+	};
+	const FString* SampleValue = SampleValues.Find(GetProtoFieldType());
+	return SampleValue ? *SampleValue : FString();
+}
+
+int32 FPropertyDecorator::GetPackedFlagsWidth()
+{
+	// The InitialOnly properties can't share the field with the properties that are diffed after the initial state.
+	if (GetProtoFieldRule() != TEXT("optional") || RepCondition == COND_InitialOnly)
+	{
+		return 0;
+	}
+	if (OriginalProperty->IsA<FBoolProperty>())
+	{
+		return 1;
+	}
+	if (OriginalProperty->IsA<FByteProperty>())
+	{
+		return 8;
+	}
+	return 0;
+}
+
+FString FPropertyDecorator::GetCode_PackedFlagsValueFrom(const FString& TargetInstance)
+{
+	return FString::Printf(TEXT("(static_cast<uint32>(%s) << %d)"), *GetCode_GetPropertyValueFrom(TargetInstance), PackedFlagsShift);
+}
+
+bool FPropertyDecorator::IsProtoFieldScalar()
+{
+	static const TSet<FString> ScalarTypes = {
+		TEXT("double"), TEXT("float"), TEXT("int32"), TEXT("int64"), TEXT("uint32"), TEXT("uint64"),
+		TEXT("sint32"), TEXT("sint64"), TEXT("fixed32"), TEXT("fixed64"), TEXT("sfixed32"), TEXT("sfixed64"),
+		TEXT("bool"), TEXT("string"), TEXT("bytes")
+	};
+	return ScalarTypes.Contains(GetProtoFieldType());
+}
+
+void FPropertyDecorator::EstimateProtoFieldSize(int32& OutTypicalBytes, int32& OutWorstCaseBytes)
+{
+	if (IsPackedInFlags())
+	{
+		// Counted in the packed_flags field of the owner state
+		OutTypicalBytes = OutWorstCaseBytes = 0;
+		return;
+	}
+	// The typical and the worst-case bytes of the values, without the tag
+	static const TMap<FString, TPair<int32, int32>> ValueSizes = {
+		{TEXT("bool"), {1, 1}},
+		// The negative int32 is encoded as a 10-byte varint.
+		{TEXT("int32"), {2, 10}},
+		{TEXT("sint32"), {2, 5}},
+		{TEXT("uint32"), {2, 5}},
+		{TEXT("int64"), {3, 10}},
+		{TEXT("sint64"), {3, 10}},
+		{TEXT("uint64"), {3, 10}},
+		{TEXT("float"), {4, 4}},
+		{TEXT("fixed32"), {4, 4}},
+		{TEXT("sfixed32"), {4, 4}},
+		{TEXT("double"), {8, 8}},
+		{TEXT("fixed64"), {8, 8}},
+		{TEXT("sfixed64"), {8, 8}},
+		{TEXT("string"), {1 + GenManager_EstimatedTypicalStringBytes, 2 + GenManager_EstimatedMaxStringBytes}},
+		{TEXT("bytes"), {1 + GenManager_EstimatedTypicalStringBytes, 2 + GenManager_EstimatedMaxStringBytes}},
+		// The messages in unreal_common.proto, with the length prefix. FVector has 3 floats.
+		{TEXT("unrealpb.FVector"), {16, 16}},
+		// Only the NetGUID in most cases, or the full export of the object with the outer chain.
+		{TEXT("unrealpb.UnrealObjectRef"), {7, 2 + GenManager_EstimatedMaxStringBytes}},
+		{TEXT("unrealpb.ActorComponentRef"), {10 + GenManager_EstimatedTypicalStringBytes, 4 + 2 * GenManager_EstimatedMaxStringBytes}},
+		{TEXT("unrealpb.AssetRef"), {3 + 4 * GenManager_EstimatedTypicalStringBytes, 4 + GenManager_EstimatedMaxStringBytes}},
+	};
+	// The field numbers of the states are small, so the tag takes 1 byte, or 2 bytes if the number is greater than 15.
+	const TPair<int32, int32>* ValueSize = ValueSizes.Find(GetProtoFieldType());
+	OutTypicalBytes = 1 + (ValueSize ? ValueSize->Key : 2 + GenManager_EstimatedTypicalStringBytes);
+	OutWorstCaseBytes = 2 + (ValueSize ? ValueSize->Value : 2 + GenManager_EstimatedMaxStringBytes);
+}
+
 FString FPropertyDecorator::GetCode_ActorPropEqualToProtoState(const FString& FromActor, const FString& FromState)
 {
 	return FString::Printf(TEXT("%s == %s"), *GetCode_GetPropertyValueFrom(FromActor), *GetCode_GetProtoFieldValueFrom(FromState));
@@ -223,6 +431,17 @@ FString FPropertyDecorator::GetCode_SetDeltaState(const FString& TargetInstance,
 	return FString::Format(PropDecorator_SetDeltaStateTemplate, FormatArgs);
 }
 
+FString FPropertyDecorator::GetCode_SetDeltaStateByStringDiffCache(const FString& StringValueCode, const FString& FullStateName, const FString& DeltaStateName)
+{
+	FStringFormatNamedArguments FormatArgs;
+	FormatArgs.Add(TEXT("Num_StringDiffCacheIndex"), StringDiffCacheIndex);
+	FormatArgs.Add(TEXT("Code_GetStringValue"), StringValueCode);
+	FormatArgs.Add(TEXT("Declare_FullStateName"), FullStateName);
+	FormatArgs.Add(TEXT("Declare_DeltaStateName"), DeltaStateName);
+	FormatArgs.Add(TEXT("Definition_ProtoName"), GetProtoFieldName());
+	return FString::Format(PropDeco_SetDeltaStateByStringDiffCacheTemp, FormatArgs);
+}
+
 FString FPropertyDecorator::GetCode_SetDeltaStateByMemOffset(const FString& ContainerName, const FString& FullStateName, const FString& DeltaStateName, bool ConditionFullStateIsNull)
 {
 	FStringFormatNamedArguments FormatArgs;
@@ -251,19 +470,48 @@ FString FPropertyDecorator::GetCode_SetDeltaStateArrayInner(const FString& Prope
 	return FString::Format(PropDeco_SetDeltaStateArrayInnerTemp, FormatArgs);
 }
 
+FString FPropertyDecorator::GetDeclaration_ShadowMember()
+{
+	return FString::Printf(TEXT("%s %s{};"), *GetCPPType(), *GetPropertyName());
+}
+
+FString FPropertyDecorator::GetCode_SetDeltaStateByShadow(const FString& TargetInstance, const FString& ShadowName, const FString& DeltaStateName)
+{
+	const FString Code_GetShadowValue = FString::Printf(TEXT("%s.%s"), *ShadowName, *GetPropertyName());
+	FStringFormatNamedArguments FormatArgs;
+	FormatArgs.Add(TEXT("Code_GetPropertyValue"), GetCode_GetPropertyValueFrom(TargetInstance));
+	FormatArgs.Add(TEXT("Code_GetShadowValue"), Code_GetShadowValue);
+	FormatArgs.Add(TEXT("Declare_ShadowType"), GetCPPType());
+	FormatArgs.Add(TEXT("Code_SetProtoFieldValue"), GetCode_SetProtoFieldValueTo(DeltaStateName, Code_GetShadowValue));
+	return FString::Format(PropDecorator_SetDeltaStateByShadowTemplate, FormatArgs);
+}
+
+FString FPropertyDecorator::GetCode_MergeShadowMember(const FString& ShadowName, const FString& NewStateName)
+{
+	return FString::Printf(TEXT("if (%s) { %s.%s = static_cast<%s>(%s); }\n"),
+		*GetCode_HasProtoFieldValueIn(NewStateName), *ShadowName, *GetPropertyName(), *GetCPPType(), *GetCode_GetProtoFieldValueFrom(NewStateName));
+}
+
 bool FPropertyDecorator::HasOnRepNotifyParam()
 {
 	return OriginalProperty->HasAnyPropertyFlags(CPF_RepNotify) && Owner->FindFunctionByName(OriginalProperty->RepNotifyFunc)->NumParms > 0;
 }
 
-FString FPropertyDecorator::GetCode_CallRepNotify(const FString& TargetInstanceName, const FString& OldValuePointer)
+FString FPropertyDecorator::GetRepNotifyFuncName()
+{
+	return OriginalProperty->HasAnyPropertyFlags(CPF_RepNotify) ? OriginalProperty->RepNotifyFunc.ToString() : FString();
+}
+
+FString FPropertyDecorator::GetCode_CallRepNotify(const FString& TargetInstanceName, const FString& OldValuePointer, const FString& RepNotifyFuncCode)
 {
 	if (OriginalProperty->HasAnyPropertyFlags(CPF_RepNotify))
 	{
 		FStringFormatNamedArguments FormatArgs;
 		FormatArgs.Add(TEXT("Declare_PropertyName"), GetPropertyName());
 		FormatArgs.Add(TEXT("Declare_TargetInstance"), TargetInstanceName);
-		FormatArgs.Add(TEXT("Declare_FunctionName"), OriginalProperty->RepNotifyFunc.ToString());
+		FormatArgs.Add(TEXT("Code_RepNotifyFunc"), RepNotifyFuncCode.IsEmpty()
+			? FString::Printf(TEXT("%s->GetClass()->FindFunctionByName(FName(TEXT(\"%s\")))"), *TargetInstanceName, *OriginalProperty->RepNotifyFunc.ToString())
+			: RepNotifyFuncCode);
 		const UFunction* RepNotifyFunc = Owner->FindFunctionByName(OriginalProperty->RepNotifyFunc);
 		FormatArgs.Add(TEXT("Code_OnRepParams"),RepNotifyFunc->NumParms > 0 ? OldValuePointer: TEXT("nullptr"));
 		return FString::Format(PropDecorator_CallRepNotifyTemplate, FormatArgs);
@@ -1,6 +1,7 @@
 ﻿#include "PropertyDecorator/ArrayPropertyDecorator.h"
 #include "PropertyDecorator/StructPropertyDecorator.h"
 #include "PropertyDecoratorFactory.h"
+#include "ReplicatorGeneratorDefinition.h"
 
 FArrayPropertyDecorator::FArrayPropertyDecorator(FProperty* InProperty, IPropertyDecoratorOwner* InOwner)
 	: FPropertyDecorator(InProperty, InOwner)
@@ -204,6 +205,20 @@ FString FArrayPropertyDecorator::GetCode_GetWorldRef()
 	return Owner->GetCode_GetWorldRef();
 }
 
+void FArrayPropertyDecorator::EstimateProtoFieldSize(int32& OutTypicalBytes, int32& OutWorstCaseBytes)
+{
+	if (bIsByteArray)
+	{
+		FPropertyDecorator::EstimateProtoFieldSize(OutTypicalBytes, OutWorstCaseBytes);
+		return;
+	}
+	// Each element is encoded as a field with the tag.
+	int32 ElementTypicalBytes, ElementWorstCaseBytes;
+	InnerProperty->EstimateProtoFieldSize(ElementTypicalBytes, ElementWorstCaseBytes);
+	OutTypicalBytes = ElementTypicalBytes * GenManager_EstimatedTypicalArrayNum;
+	OutWorstCaseBytes = ElementWorstCaseBytes * GenManager_EstimatedMaxArrayNum;
+}
+
 TArray<TSharedPtr<FStructPropertyDecorator>> FArrayPropertyDecorator::GetStructPropertyDecorators()
 {
 	TArray<TSharedPtr<FStructPropertyDecorator>> StructPropertyDecorators;
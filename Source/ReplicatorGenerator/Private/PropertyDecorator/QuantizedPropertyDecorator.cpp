@@ -0,0 +1,95 @@
+﻿#include "PropertyDecorator/QuantizedPropertyDecorator.h"
+
+#include "ReplicatorGeneratorDefinition.h"
+
+FQuantizedPropertyDecorator::FQuantizedPropertyDecorator(FProperty* InProperty, IPropertyDecoratorOwner* InOwner, EQuantizedType InQuantizedType)
+	: FPropertyDecorator(InProperty, InOwner), QuantizedType(InQuantizedType)
+{
+	ProtoFieldType = QuantizedType == EQuantizedType::Float ? TEXT("sint32") : TEXT("uint64");
+
+	Step = FCString::Atof(*InProperty->GetMetaData(TEXT("ChanneldQuantize")));
+	if (Step <= 0.f)
+	{
+		UE_LOG(LogChanneldRepGenerator, Warning, TEXT("Invalid ChanneldQuantize of property %s: %s, using 1 instead."), *InProperty->GetName(), *InProperty->GetMetaData(TEXT("ChanneldQuantize")));
+		Step = 1.f;
+	}
+
+	// The packed vector has 64 bits for the 3 components.
+	const int32 MaxBits = QuantizedType == EQuantizedType::Float ? 32 : 21;
+	Bits = InProperty->HasMetaData(TEXT("ChanneldBits")) ? FCString::Atoi(*InProperty->GetMetaData(TEXT("ChanneldBits"))) : MaxBits;
+	if (Bits < 2 || Bits > MaxBits)
+	{
+		UE_LOG(LogChanneldRepGenerator, Warning, TEXT("Invalid ChanneldBits of property %s: %d, should be in [2, %d]."), *InProperty->GetName(), Bits, MaxBits);
+		Bits = FMath::Clamp(Bits, 2, MaxBits);
+	}
+}
+
+FString FQuantizedPropertyDecorator::GetPropertyType()
+{
+	switch (QuantizedType)
+	{
+	case EQuantizedType::Vector:
+		return TEXT("FVector");
+	case EQuantizedType::Rotator:
+		return TEXT("FRotator");
+	default:
+		return GetCPPType();
+	}
+}
+
+FString FQuantizedPropertyDecorator::GetCode_QuantizeValue(const FString& GetValueCode)
+{
+	static const TCHAR* QuantizeFunctions[] = {TEXT("QuantizeFloat"), TEXT("QuantizeVectorPacked"), TEXT("QuantizeRotatorPacked")};
+	return FString::Printf(TEXT("ChanneldUtils::%s(%s, %sf, %d)"), QuantizeFunctions[static_cast<uint8>(QuantizedType)], *GetValueCode, *FString::SanitizeFloat(Step), Bits);
+}
+
+FString FQuantizedPropertyDecorator::GetCode_GetProtoFieldValueFrom(const FString& StateName)
+{
+	const FString Code_GetEncodedValue = FPropertyDecorator::GetCode_GetProtoFieldValueFrom(StateName);
+	switch (QuantizedType)
+	{
+	case EQuantizedType::Vector:
+		return FString::Printf(TEXT("ChanneldUtils::DequantizeVectorPacked(%s, %sf, %d)"), *Code_GetEncodedValue, *FString::SanitizeFloat(Step), Bits);
+	case EQuantizedType::Rotator:
+		return FString::Printf(TEXT("ChanneldUtils::DequantizeRotatorPacked(%s, %sf, %d)"), *Code_GetEncodedValue, *FString::SanitizeFloat(Step), Bits);
+	default:
+		return FString::Printf(TEXT("ChanneldUtils::DequantizeFloat(%s, %sf)"), *Code_GetEncodedValue, *FString::SanitizeFloat(Step));
+	}
+}
+
+FString FQuantizedPropertyDecorator::GetCode_SetProtoFieldValueTo(const FString& StateName, const FString& GetValueCode)
+{
+	return FPropertyDecorator::GetCode_SetProtoFieldValueTo(StateName, GetCode_QuantizeValue(GetValueCode));
+}
+
+FString FQuantizedPropertyDecorator::GetCode_ActorPropEqualToProtoState(const FString& FromActor, const FString& FromState)
+{
+	return FString::Printf(TEXT("%s == %s"), *GetCode_QuantizeValue(GetCode_GetPropertyValueFrom(FromActor)), *FPropertyDecorator::GetCode_GetProtoFieldValueFrom(FromState));
+}
+
+FString FQuantizedPropertyDecorator::GetCode_ActorPropEqualToProtoState(const FString& FromActor, const FString& FromState, bool ForceFromPointer)
+{
+	return FString::Printf(TEXT("%s == %s"), *GetCode_QuantizeValue(GetCode_GetPropertyValueFrom(FromActor, ForceFromPointer)), *FPropertyDecorator::GetCode_GetProtoFieldValueFrom(FromState));
+}
+
+FString FQuantizedPropertyDecorator::GetCode_SetDeltaStateByMemOffset(const FString& ContainerName, const FString& FullStateName, const FString& DeltaStateName, bool ConditionFullStateIsNull)
+{
+	FStringFormatNamedArguments FormatArgs;
+	FormatArgs.Add(
+		TEXT("Code_AssignPropPointers"),
+		GetCode_AssignPropPointerStatic(
+			ContainerName,
+			FString::Printf(TEXT("%s* PropAddr"), *GetCPPType())
+		)
+	);
+	FormatArgs.Add(TEXT("Code_BeforeCondition"), ConditionFullStateIsNull ? TEXT("bIsFullStateNull ? true :") : TEXT(""));
+	FormatArgs.Add(TEXT("Code_QuantizePropValue"), GetCode_QuantizeValue(TEXT("*PropAddr")));
+	FormatArgs.Add(TEXT("Code_GetQuantizedProtoFieldValue"), FPropertyDecorator::GetCode_GetProtoFieldValueFrom(FullStateName));
+	FormatArgs.Add(TEXT("Code_SetProtoFieldValue"), GetCode_SetProtoFieldValueTo(DeltaStateName, TEXT("*PropAddr")));
+	return FString::Format(QuantizedPropDeco_SetDeltaStateByMemOffsetTemp, FormatArgs);
+}
+
+TArray<FString> FQuantizedPropertyDecorator::GetAdditionalIncludes()
+{
+	return TArray<FString>{TEXT("ChanneldUtils.h")};
+}
@@ -0,0 +1,45 @@
+﻿#include "PropertyDecorator/QuantizedPropertyDecoratorBuilder.h"
+
+#include "PropertyDecorator/QuantizedPropertyDecorator.h"
+
+static bool GetQuantizedType(FProperty* Property, FQuantizedPropertyDecorator::EQuantizedType& OutType)
+{
+	if (Property->IsA<FFloatProperty>() || Property->IsA<FDoubleProperty>())
+	{
+		OutType = FQuantizedPropertyDecorator::EQuantizedType::Float;
+		return true;
+	}
+	if (Property->IsA<FStructProperty>())
+	{
+		const FString StructName = CastFieldChecked<FStructProperty>(Property)->Struct->GetStructCPPName();
+		if (StructName.Equals(TEXT("FVector")) || StructName.StartsWith(TEXT("FVector_NetQuantize")))
+		{
+			OutType = FQuantizedPropertyDecorator::EQuantizedType::Vector;
+			return true;
+		}
+		if (StructName.Equals(TEXT("FRotator")))
+		{
+			OutType = FQuantizedPropertyDecorator::EQuantizedType::Rotator;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FQuantizedPropertyDecoratorBuilder::IsSpecialProperty(FProperty* Property)
+{
+	// The elements of the arrays are still replicated as the full values.
+	if (Property->GetOwner<FArrayProperty>() != nullptr || !Property->HasMetaData(TEXT("ChanneldQuantize")))
+	{
+		return false;
+	}
+	FQuantizedPropertyDecorator::EQuantizedType QuantizedType;
+	return GetQuantizedType(Property, QuantizedType);
+}
+
+FPropertyDecorator* FQuantizedPropertyDecoratorBuilder::ConstructPropertyDecorator(FProperty* Property, IPropertyDecoratorOwner* InOwner)
+{
+	FQuantizedPropertyDecorator::EQuantizedType QuantizedType = FQuantizedPropertyDecorator::EQuantizedType::Float;
+	GetQuantizedType(Property, QuantizedType);
+	return new FQuantizedPropertyDecorator(Property, InOwner, QuantizedType);
+}
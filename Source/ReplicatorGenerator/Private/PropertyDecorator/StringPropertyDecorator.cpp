@@ -15,6 +15,20 @@ FString FStringPropertyDecorator::GetCode_SetProtoFieldValueTo(const FString& St
 	return FString::Printf(TEXT("%s->set_%s(std::string(TCHAR_TO_UTF8(*%s)))"), *StateName, *GetProtoFieldName(), *GetValueCode);
 }
 
+bool FStringPropertyDecorator::SupportsStringDiffCache()
+{
+	return GetProtoFieldRule() == TEXT("optional");
+}
+
+FString FStringPropertyDecorator::GetCode_SetDeltaState(const FString& TargetInstance, const FString& FullStateName, const FString& DeltaStateName, bool ConditionFullStateIsNull)
+{
+	if (StringDiffCacheIndex == INDEX_NONE)
+	{
+		return FPropertyDecorator::GetCode_SetDeltaState(TargetInstance, FullStateName, DeltaStateName, ConditionFullStateIsNull);
+	}
+	return GetCode_SetDeltaStateByStringDiffCache(FString::Printf(TEXT("(%s)"), *GetCode_GetPropertyValueFrom(TargetInstance)), FullStateName, DeltaStateName);
+}
+
 FString FStringPropertyDecorator::GetCode_SetDeltaStateArrayInner(const FString& PropertyPointer, const FString& FullStateName, const FString& DeltaStateName, bool ConditionFullStateIsNull)
 {
 	FStringFormatNamedArguments FormatArgs;
@@ -3,6 +3,7 @@
 #include "PropertyDecoratorFactory.h"
 #include "ReplicatorGeneratorDefinition.h"
 #include "ReplicatorTemplate/CppReplicatorTemplate.h"
+#include "UObject/EnumProperty.h"
 
 FStructPropertyDecorator::FStructPropertyDecorator(FProperty* InProperty, IPropertyDecoratorOwner* InOwner) : FPropertyDecorator(InProperty, InOwner)
 {
@@ -74,17 +75,27 @@ FString FStructPropertyDecorator::GetCode_AssignPropPointerStatic(const FString&
 	return FString::Format(StructPropDeco_AssignPropPtrStatic, FormatArgs);
 }
 
-FString FStructPropertyDecorator::GetCode_AssignPropPointerDynamic(const FString& Container, const FString& AssignTo)
+FString FStructPropertyDecorator::GetCode_AssignPropPointerByTable(const FString& Container, const FString& AssignTo, const FString& OffsetCode)
+{
+	FStringFormatNamedArguments FormatArgs;
+	FormatArgs.Add(TEXT("Ref_AssignTo"), AssignTo);
+	FormatArgs.Add(TEXT("Ref_ContainerAddr"), Container);
+	FormatArgs.Add(TEXT("Num_PropMemOffset"), OffsetCode);
+	FormatArgs.Add(TEXT("Declare_PropPtrGroupStructName"), GetDeclaration_PropPtrGroupStructName());
+
+	return FString::Format(StructPropDeco_AssignPropPtrStatic, FormatArgs);
+}
+
+FString FStructPropertyDecorator::GetCode_AssignPropPointerNative(const FString& Container, const FString& AssignTo)
 {
 	FStringFormatNamedArguments FormatArgs;
 	FormatArgs.Add(TEXT("Ref_AssignTo"), AssignTo);
 	FormatArgs.Add(TEXT("Ref_ContainerAddr"), Container);
-	FormatArgs.Add(TEXT("Declare_PropertyCPPType"), GetCPPType());
 	FormatArgs.Add(TEXT("Num_PropMemOffset"), GetMemOffset());
 	FormatArgs.Add(TEXT("Declare_PropPtrGroupStructName"), GetDeclaration_PropPtrGroupStructName());
-    FormatArgs.Add(TEXT("Declare_PropertyName"), GetPropertyName());
+	FormatArgs.Add(TEXT("Declare_PropertyName"), GetPropertyName());
 
-	return FString::Format(StructPropDeco_AssignPropPtrDynamic, FormatArgs);
+	return FString::Format(StructPropDeco_AssignPropPtrNative, FormatArgs);
 }
 
 TArray<FString> FStructPropertyDecorator::GetAdditionalIncludes()
@@ -253,6 +264,28 @@ FString FStructPropertyDecorator::GetDeclaration_PropPtrGroupStruct()
 	FormatArgs.Add(TEXT("Code_OnStateChange"), OnStateChangeCodes);
 	FormatArgs.Add(TEXT("Code_StaticOnStateChange"), StaticOnStateChangeCodes);
 
+	if (IsPlainOldData())
+	{
+		FStringFormatNamedArguments ShadowFormatArgs;
+		ShadowFormatArgs.Add(TEXT("Num_StructSize"), GetPropertySize());
+		ShadowFormatArgs.Add(TEXT("Declare_ProtoNamespace"), GetProtoNamespace());
+		ShadowFormatArgs.Add(TEXT("Declare_ProtoStateMsgName"), GetProtoStateMessageType());
+		FormatArgs.Add(TEXT("Code_AssignShadowStructAddr"), TEXT("    ShadowStructAddr = Container;"));
+		FormatArgs.Add(TEXT("Declare_ShadowMembers"), FString::Format(StructPropDeco_ShadowMembersTemp, ShadowFormatArgs));
+		FormatArgs.Add(TEXT("Code_SkipUnchangedShadow"), FString::Format(StructPropDeco_SkipUnchangedShadowTemp, ShadowFormatArgs));
+		FormatArgs.Add(TEXT("Code_UpdateShadow"), StructPropDeco_UpdateShadowTemp);
+		// The new state is applied to the struct, but not necessarily to the full state of the replicator.
+		FormatArgs.Add(TEXT("Code_InvalidateShadow"), TEXT("    bShadowValid = false;"));
+	}
+	else
+	{
+		FormatArgs.Add(TEXT("Code_AssignShadowStructAddr"), TEXT(""));
+		FormatArgs.Add(TEXT("Declare_ShadowMembers"), TEXT(""));
+		FormatArgs.Add(TEXT("Code_SkipUnchangedShadow"), TEXT(""));
+		FormatArgs.Add(TEXT("Code_UpdateShadow"), TEXT(""));
+		FormatArgs.Add(TEXT("Code_InvalidateShadow"), TEXT(""));
+	}
+
 	FormatArgs.Add(TEXT("Declare_PropCompilableStructName"), GetCompilableCPPType());
 	FormatArgs.Add(TEXT("Code_StructCopyProperties"), StructCopyCode);
 
@@ -298,6 +331,46 @@ bool FStructPropertyDecorator::IsStruct()
 	return true;
 }
 
+void FStructPropertyDecorator::EstimateProtoFieldSize(int32& OutTypicalBytes, int32& OutWorstCaseBytes)
+{
+	// The tag and the length prefix
+	OutTypicalBytes = 2;
+	OutWorstCaseBytes = 4;
+	for (TSharedPtr<FPropertyDecorator>& Property : Properties)
+	{
+		int32 TypicalBytes, WorstCaseBytes;
+		Property->EstimateProtoFieldSize(TypicalBytes, WorstCaseBytes);
+		OutTypicalBytes += TypicalBytes;
+		OutWorstCaseBytes += WorstCaseBytes;
+	}
+}
+
+static bool IsPlainOldDataStruct(const UStruct* Struct)
+{
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		const FProperty* Property = *It;
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			if (!IsPlainOldDataStruct(StructProperty->Struct))
+			{
+				return false;
+			}
+		}
+		else if (!Property->IsA<FNumericProperty>() && !Property->IsA<FBoolProperty>() && !Property->IsA<FEnumProperty>())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FStructPropertyDecorator::IsPlainOldData()
+{
+	const FStructProperty* StructProperty = CastField<FStructProperty>(OriginalProperty);
+	return StructProperty != nullptr && IsPlainOldDataStruct(StructProperty->Struct);
+}
+
 TArray<TSharedPtr<FStructPropertyDecorator>> FStructPropertyDecorator::GetStructPropertyDecorators()
 {
 	TArray<TSharedPtr<FStructPropertyDecorator>> StructPropertyDecorators;
@@ -25,6 +25,21 @@ FString FTextPropertyDecorator::GetCode_ActorPropEqualToProtoState(const FString
 	return FPropertyDecorator::GetCode_ActorPropEqualToProtoState(FromActor, FromState);
 }
 
+bool FTextPropertyDecorator::SupportsStringDiffCache()
+{
+	return GetProtoFieldRule() == TEXT("optional");
+}
+
+FString FTextPropertyDecorator::GetCode_SetDeltaState(const FString& TargetInstance, const FString& FullStateName, const FString& DeltaStateName, bool ConditionFullStateIsNull)
+{
+	if (StringDiffCacheIndex == INDEX_NONE)
+	{
+		return FPropertyDecorator::GetCode_SetDeltaState(TargetInstance, FullStateName, DeltaStateName, ConditionFullStateIsNull);
+	}
+	// The display string is what's sent, so it's what the cache compares.
+	return GetCode_SetDeltaStateByStringDiffCache(FString::Printf(TEXT("(%s).ToString()"), *GetCode_GetPropertyValueFrom(TargetInstance)), FullStateName, DeltaStateName);
+}
+
 FString FTextPropertyDecorator::GetCode_SetDeltaStateByMemOffset(const FString& ContainerName, const FString& FullStateName, const FString& DeltaStateName, bool ConditionFullStateIsNull)
 {
 	FStringFormatNamedArguments FormatArgs;
@@ -3,14 +3,17 @@
 #include "PropertyDecorator/ActorCompPropDecoratorBuilder.h"
 #include "PropertyDecorator/AssetPropertyDecoratorBuilder.h"
 #include "PropertyDecorator/BaseDataTypePropertyDecorator.h"
+#include "PropertyDecorator/QuantizedPropertyDecoratorBuilder.h"
 #include "PropertyDecorator/RotatorPropertyDecoratorBuilder.h"
 #include "PropertyDecorator/VectorPropertyDecoratorBuilder.h"
 #include "PropertyDecorator/ClassPropertyDecoratorBuilder.h"
 
 FPropertyDecoratorFactory::FPropertyDecoratorFactory()
 {
-	HeadBuilder = MakeShared<FBytePropertyDecoratorBuilder>();
+	// The properties with the quantization metadata take precedence over their types.
+	HeadBuilder = MakeShared<FQuantizedPropertyDecoratorBuilder>();
 	HeadBuilder
+		->SetNextBuilder(MakeShared<FBytePropertyDecoratorBuilder>())
 		->SetNextBuilder(MakeShared<FBoolPropertyDecoratorBuilder>())
 		->SetNextBuilder(MakeShared<FUInt32PropertyDecoratorBuilder>())
 		->SetNextBuilder(MakeShared<FIntPropertyDecoratorBuilder>())
@@ -7,6 +7,8 @@
 #include "GameFramework/GameStateBase.h"
 #include "GameFramework/PlayerState.h"
 #include "ReplicatorTemplate/CppReplicatorTemplate.h"
+#include "ReplicatorTemplate/GoProtoDataTemplate.h"
+#include "Net/UnrealNetwork.h"
 
 FReplicatedActorDecorator::FReplicatedActorDecorator(
 	const UClass* TargetActorClass
@@ -41,6 +43,23 @@ void FReplicatedActorDecorator::InitPropertiesAndRPCs()
 {
 	FPropertyDecoratorFactory& PropertyDecoratorFactory = FPropertyDecoratorFactory::Get();
 
+	// Collect the replication conditions of the properties
+	TMap<const FProperty*, ELifetimeCondition> RepConditions;
+	if (UObject* CDO = TargetClass->GetDefaultObject())
+	{
+		UClass* MutableClass = const_cast<UClass*>(TargetClass);
+		MutableClass->SetUpRuntimeReplicationData();
+		TArray<FLifetimeProperty> LifetimeProps;
+		CDO->GetLifetimeReplicatedProps(LifetimeProps);
+		for (const FLifetimeProperty& LifetimeProp : LifetimeProps)
+		{
+			if (MutableClass->ClassReps.IsValidIndex(LifetimeProp.RepIndex))
+			{
+				RepConditions.Add(MutableClass->ClassReps[LifetimeProp.RepIndex].Property, LifetimeProp.Condition);
+			}
+		}
+	}
+
 	// Construct all property decorator
 	for (TFieldIterator<FProperty> It(TargetClass, EFieldIteratorFlags::ExcludeSuper); It; ++It)
 	{
@@ -54,6 +73,7 @@ void FReplicatedActorDecorator::InitPropertiesAndRPCs()
 			TSharedPtr<FPropertyDecorator> PropertyDecoratorPtr = PropertyDecoratorFactory.GetPropertyDecorator(Property, this);
 			if (PropertyDecoratorPtr.IsValid())
 			{
+				PropertyDecoratorPtr->SetRepCondition(RepConditions.FindRef(Property));
 				Properties.Emplace(PropertyDecoratorPtr);
 			}
 		}
@@ -69,6 +89,40 @@ void FReplicatedActorDecorator::InitPropertiesAndRPCs()
 		);
 	}
 
+	for (TSharedPtr<FPropertyDecorator> PropertyDecoratorPtr : Properties)
+	{
+		if (PropertyDecoratorPtr->SupportsStringDiffCache())
+		{
+			PropertyDecoratorPtr->SetStringDiffCacheIndex(NumStringDiffCaches++);
+		}
+	}
+
+	// Pack the bools and the bytes into the 32 bits of the packed_flags field, which only pays off for more than one of them.
+	if (CanMergeStateByFields())
+	{
+		TArray<TSharedPtr<FPropertyDecorator>> PackedProperties;
+		int32 PackedBits = 0;
+		for (TSharedPtr<FPropertyDecorator> PropertyDecoratorPtr : Properties)
+		{
+			const int32 Width = PropertyDecoratorPtr->GetPackedFlagsWidth();
+			if (Width > 0 && PackedBits + Width <= 32)
+			{
+				PackedProperties.Add(PropertyDecoratorPtr);
+				PackedBits += Width;
+			}
+		}
+		if (PackedProperties.Num() > 1)
+		{
+			int32 Shift = 0;
+			for (TSharedPtr<FPropertyDecorator> PropertyDecoratorPtr : PackedProperties)
+			{
+				PropertyDecoratorPtr->SetPackedFlagsShift(Shift);
+				Shift += PropertyDecoratorPtr->GetPackedFlagsWidth();
+			}
+			bHasPackedFlags = true;
+		}
+	}
+
 	// Construct all rpc func decorator
 	TArray<FName> FunctionNames;
 	TargetClass->GenerateFunctionList(FunctionNames);
@@ -101,6 +155,12 @@ bool FReplicatedActorDecorator::IsSingletonInChannelData()
 	return bSingletonInChannelData;
 }
 
+bool FReplicatedActorDecorator::CanBeInActorMessage()
+{
+	// The states of UActorComponent are already grouped by the actor, in unrealpb.ActorComponentStates.
+	return !IsSingletonInChannelData() && TargetClass != UActorComponent::StaticClass();
+}
+
 bool FReplicatedActorDecorator::IsChanneldUEBuiltinType()
 {
 	return bChanneldUEBuiltinType;
@@ -197,17 +257,43 @@ FString FReplicatedActorDecorator::GetCode_IndirectlyAccessiblePropertyPtrDeclar
 FString FReplicatedActorDecorator::GetCode_AssignPropertyPointers()
 {
 	FString Result;
+	const FString Container = FString::Printf(TEXT("%s.Get()"), *InstanceRefName);
+	if (IsBlueprintType())
+	{
+		if (Properties.Num() == 0)
+		{
+			return Result;
+		}
+		// The blueprint classes can be recompiled at runtime, so the offsets are looked up by name, once per class of the target objects.
+		FString PropertyNames, DefaultOffsets, RepNotifyNames;
+		for (int32 i = 0; i < Properties.Num(); i++)
+		{
+			const FString Separator = i == 0 ? TEXT("") : TEXT(", ");
+			const FString RepNotifyName = Properties[i]->GetRepNotifyFuncName();
+			PropertyNames.Append(FString::Printf(TEXT("%sTEXT(\"%s\")"), *Separator, *Properties[i]->GetPropertyName()));
+			DefaultOffsets.Append(FString::Printf(TEXT("%s%d"), *Separator, Properties[i]->GetMemOffset()));
+			RepNotifyNames.Append(Separator + (RepNotifyName.IsEmpty() ? TEXT("nullptr") : FString::Printf(TEXT("TEXT(\"%s\")"), *RepNotifyName)));
+		}
+		Result += FString::Printf(
+			TEXT("static const TCHAR* const PropertyNames[] = {%s};\nstatic const int32 DefaultOffsets[] = {%s};\nstatic const TCHAR* const RepNotifyNames[] = {%s};\n")
+			TEXT("PropertyTable = &PropertyTables.FindOrAdd(InTargetObj->GetClass(), PropertyNames, DefaultOffsets, RepNotifyNames);\n"),
+			*PropertyNames, *DefaultOffsets, *RepNotifyNames
+		);
+		for (int32 i = 0; i < Properties.Num(); i++)
+		{
+			if (!Properties[i]->IsDirectlyAccessible())
+			{
+				Result += FString::Printf(TEXT("{ %s; }\n"), *Properties[i]->GetCode_AssignPropPointerByTable(
+					Container, Properties[i]->GetPointerName(), FString::Printf(TEXT("PropertyTable->Offsets[%d]"), i)));
+			}
+		}
+		return Result;
+	}
 	for (TSharedPtr<FPropertyDecorator> Property : Properties)
 	{
 		if (!Property->IsDirectlyAccessible())
 		{
-			Result += FString::Printf(
-				TEXT("{ %s; }\n"),
-				*Property->GetCode_AssignPropPointerDynamic(
-					FString::Printf(TEXT("%s.Get()"), *InstanceRefName),
-					Property->GetPointerName()
-				)
-			);
+			Result += FString::Printf(TEXT("{ %s; }\n"), *Property->GetCode_AssignPropPointerNative(Container, Property->GetPointerName()));
 		}
 	}
 	return Result;
@@ -317,13 +403,171 @@ FString FReplicatedActorDecorator::GetCode_AllPropertiesSetDeltaState(const FStr
 		return TEXT("");
 	}
 	FString SetDeltaStateCodeBuilder;
-	for (const TSharedPtr<FPropertyDecorator> Property : Properties)
+	FString Code_PackedDirtyCondition;
+	FString Code_PackFlags;
+	for (int32 i = 0; i < Properties.Num(); i++)
+	{
+		if (Properties[i]->IsPackedInFlags())
+		{
+			Code_PackedDirtyCondition.Append(FString::Printf(TEXT("%sIsPropertyDirty(%d)"), Code_PackedDirtyCondition.IsEmpty() ? TEXT("") : TEXT(" || "), i));
+			Code_PackFlags.Append(FString::Printf(TEXT("  PackedFlags |= %s;\n"), *Properties[i]->GetCode_PackedFlagsValueFrom(InstanceRefName)));
+			continue;
+		}
+		// The index of the property in GetCode_PushModelPropertyIndices()
+		SetDeltaStateCodeBuilder.Append(FString::Printf(TEXT("if (IsPropertyDirty(%d)) {\n"), i));
+		// The InitialOnly properties are only diffed before the initial state is sent.
+		// The owner-only conditions are not supported: channeld fans the channel data out to all the subscribers of the channel.
+		const bool bInitialOnly = Properties[i]->GetRepCondition() == COND_InitialOnly;
+		if (bInitialOnly)
+		{
+			SetDeltaStateCodeBuilder.Append(TEXT("if (!IsInitialStateDiffed()) {\n"));
+		}
+		SetDeltaStateCodeBuilder.Append(Properties[i]->SupportsShadowState()
+			? Properties[i]->GetCode_SetDeltaStateByShadow(InstanceRefName, TEXT("ShadowState"), DeltaStateName)
+			: Properties[i]->GetCode_SetDeltaState(InstanceRefName, FullStateName, DeltaStateName));
+		SetDeltaStateCodeBuilder.Append(bInitialOnly ? TEXT("}\n}\n") : TEXT("}\n"));
+	}
+	if (HasPackedFlags())
+	{
+		// Any change of the packed properties sends all of them.
+		SetDeltaStateCodeBuilder.Append(FString::Printf(TEXT("if (%s) {\n  uint32 PackedFlags = 0;\n%s"), *Code_PackedDirtyCondition, *Code_PackFlags));
+		SetDeltaStateCodeBuilder.Append(FString::Printf(
+			TEXT("  if (PackedFlags != ShadowState.PackedFlags) {\n    ShadowState.PackedFlags = PackedFlags;\n    %s->set_packed_flags(PackedFlags);\n    bStateChanged = true;\n  }\n}\n"),
+			*DeltaStateName));
+	}
+	if (HasDirtyMask())
 	{
-		SetDeltaStateCodeBuilder.Append(Property->GetCode_SetDeltaState(InstanceRefName, FullStateName, DeltaStateName));
+		SetDeltaStateCodeBuilder.Append(TEXT("if (bStateChanged) {\n  uint64 DirtyMask = 0;\n"));
+		for (int32 i = 0; i < Properties.Num(); i++)
+		{
+			SetDeltaStateCodeBuilder.Append(FString::Printf(TEXT("  if (%s) { DirtyMask |= 1ull << %d; }\n"), *Properties[i]->GetCode_HasMergeableProtoFieldValueIn(DeltaStateName), i));
+		}
+		SetDeltaStateCodeBuilder.Append(FString::Printf(TEXT("  %s->set_dirty_mask(DirtyMask);\n}\n"), *DeltaStateName));
 	}
 	return SetDeltaStateCodeBuilder;
 }
 
+FString FReplicatedActorDecorator::GetCode_AfterMergeFullState(const FString& FullStateName)
+{
+	// MergeFrom() overwrites the dirty mask, which is only meaningful for the delta states.
+	return HasDirtyMask() ? FString::Printf(TEXT("%s->clear_dirty_mask();"), *FullStateName) : FString();
+}
+
+FString FReplicatedActorDecorator::GetDeclaration_ShadowState()
+{
+	if (!HasShadowState())
+	{
+		return FString();
+	}
+	FString MembersCode;
+	for (const TSharedPtr<FPropertyDecorator>& Property : Properties)
+	{
+		if (Property->SupportsShadowState())
+		{
+			MembersCode.Append(FString::Printf(TEXT("    %s\n"), *Property->GetDeclaration_ShadowMember()));
+		}
+	}
+	if (HasPackedFlags())
+	{
+		MembersCode.Append(TEXT("    uint32 PackedFlags{};\n"));
+	}
+	return FString::Printf(
+		TEXT("  // [Server] The values last written to DeltaState of the properties that are diffed without FullState\n  struct FShadowState\n  {\n%s  } ShadowState;\n")
+		TEXT("  virtual void ResetShadowState() override { ShadowState = FShadowState(); }\n"),
+		*MembersCode);
+}
+
+FString FReplicatedActorDecorator::GetCode_MergeDeltaState(const FString& FullStateName, const FString& DeltaStateName)
+{
+	if (IsFullStateShadowed())
+	{
+		return FString();
+	}
+	return FString::Printf(TEXT("if (bStateChanged) {\n    %s->MergeFrom(*%s);\n    %s\n  }"), *FullStateName, *DeltaStateName, *GetCode_AfterMergeFullState(FullStateName));
+}
+
+FString FReplicatedActorDecorator::GetCode_MergeNewState(const FString& FullStateName, const FString& NewStateName)
+{
+	FString Code;
+	if (!IsFullStateShadowed())
+	{
+		Code = FString::Printf(TEXT("%s->MergeFrom(*%s);\n  %s\n"), *FullStateName, *NewStateName, *GetCode_AfterMergeFullState(FullStateName));
+	}
+	for (const TSharedPtr<FPropertyDecorator>& Property : Properties)
+	{
+		if (Property->SupportsShadowState())
+		{
+			Code.Append(TEXT("  ") + Property->GetCode_MergeShadowMember(TEXT("ShadowState"), NewStateName));
+		}
+	}
+	if (HasPackedFlags())
+	{
+		Code.Append(FString::Printf(TEXT("  if (%s->has_packed_flags()) { ShadowState.PackedFlags = %s->packed_flags(); }\n"), *NewStateName, *NewStateName));
+	}
+	return Code;
+}
+
+FString FReplicatedActorDecorator::GetCode_PushModelPropertyIndices()
+{
+	if (Properties.Num() == 0)
+	{
+		return TEXT("");
+	}
+	FString PropertyNames;
+	for (const TSharedPtr<FPropertyDecorator> Property : Properties)
+	{
+		PropertyNames.Append(FString::Printf(TEXT("FName(TEXT(\"%s\")), "), *Property->GetPropertyName()));
+	}
+	return FString::Printf(
+		TEXT("  static const FName PropertyNames[] = { %s};\n  for (int32 i = 0; i < UE_ARRAY_COUNT(PropertyNames); ++i) { if (PropertyNames[i] == PropertyName) { return i; } }\n"),
+		*PropertyNames
+	);
+}
+
+int32 FReplicatedActorDecorator::GetPushModelPropertyNum()
+{
+	return Properties.Num();
+}
+
+void FReplicatedActorDecorator::EstimateStateSize(int32& OutTypicalBytes, int32& OutWorstCaseBytes)
+{
+	if (IsSingletonInChannelData())
+	{
+		// The tag and the length prefix of the state field
+		OutTypicalBytes = 2;
+		OutWorstCaseBytes = 4;
+	}
+	else
+	{
+		// The map entry: the tag and the length prefix, the NetGUID key, and the tag and the length prefix of the state
+		OutTypicalBytes = 8;
+		OutWorstCaseBytes = 14;
+	}
+	if (HasDirtyMask())
+	{
+		OutTypicalBytes += 3;
+		OutWorstCaseBytes += 11;
+	}
+	if (HasPackedFlags())
+	{
+		OutTypicalBytes += 3;
+		OutWorstCaseBytes += 7;
+	}
+	for (const TSharedPtr<FPropertyDecorator>& Property : Properties)
+	{
+		int32 TypicalBytes, WorstCaseBytes;
+		Property->EstimateProtoFieldSize(TypicalBytes, WorstCaseBytes);
+		OutTypicalBytes += TypicalBytes;
+		OutWorstCaseBytes += WorstCaseBytes;
+	}
+}
+
+float FReplicatedActorDecorator::GetNetUpdateFrequency() const
+{
+	const AActor* ActorCDO = Cast<AActor>(TargetClass->GetDefaultObject());
+	return ActorCDO ? ActorCDO->NetUpdateFrequency : 0.f;
+}
+
 FString FReplicatedActorDecorator::GetCode_AllPropertiesOnStateChange(const FString& NewStateName)
 {
 	if (Properties.Num() == 0)
@@ -350,9 +594,10 @@ FString FReplicatedActorDecorator::GetCode_AllPropertiesOnStateChange(const FStr
 	}
 	
 	// Generate code for calling OnRep() functions after all the properties are updated, to align with the native UE's behavior.
-	for (const TSharedPtr<FPropertyDecorator> Property : Properties)
+	for (int32 i = 0; i < Properties.Num(); i++)
 	{
-		OnChangeStateCodeBuilder.Append(Property->GetCode_CallRepNotify(InstanceRefName, FString::Printf(TEXT("&Old%s"), *Property->GetPropertyName())));
+		OnChangeStateCodeBuilder.Append(Properties[i]->GetCode_CallRepNotify(InstanceRefName, FString::Printf(TEXT("&Old%s"), *Properties[i]->GetPropertyName()),
+			IsBlueprintType() ? FString::Printf(TEXT("PropertyTable->RepNotifies[%d]"), i) : FString()));
 	}
 	
 	return OnChangeStateCodeBuilder;
@@ -372,11 +617,24 @@ FString FReplicatedActorDecorator::GetDefinition_ProtoStateMessage()
 	for (int32 i = 0; i < Properties.Num(); i++)
 	{
 		const TSharedPtr<FPropertyDecorator> Property = Properties[i];
+		if (Property->IsPackedInFlags())
+		{
+			continue;
+		}
 		FString ProtoField = Property->GetDefinition_ProtoField(ProtoIndex) + TEXT(";\n");
 		FieldDefinitions += ProtoField;
 		ProtoIndex++;
 	
 	}
+	if (HasPackedFlags())
+	{
+		FieldDefinitions += FString::Printf(TEXT("optional uint32 packed_flags = %d;\n"), ProtoIndex);
+		ProtoIndex++;
+	}
+	if (HasDirtyMask())
+	{
+		FieldDefinitions += FString::Printf(TEXT("optional uint64 dirty_mask = %d;\n"), ProtoIndex);
+	}
 	FStringFormatNamedArguments FormatArgs;
 	FormatArgs.Add(TEXT("Declare_StateMessageType"), GetProtoStateMessageType());
 	FormatArgs.Add(TEXT("Declare_ProtoFields"), FieldDefinitions);
@@ -390,6 +648,14 @@ int32 FReplicatedActorDecorator::GetRPCNum()
 	return RPCs.Num();
 }
 
+void FReplicatedActorDecorator::GetRPCFunctionNames(TSet<FName>& OutFuncNames) const
+{
+	for (const TSharedPtr<FRPCDecorator>& RPC : RPCs)
+	{
+		OutFuncNames.Add(RPC->GetFunctionName());
+	}
+}
+
 FString FReplicatedActorDecorator::GetCode_SerializeFunctionParams()
 {
 	FString SerializeParamCodes;
@@ -465,7 +731,7 @@ FString FReplicatedActorDecorator::GetDefinition_ChannelDataFieldNameProto()
 {
 	FString ProtoStateMessageType = GetProtoStateMessageType();
 	ProtoStateMessageType[0] = FChar::ToLower(ProtoStateMessageType[0]);
-	return ProtoStateMessageType + (IsSingletonInChannelData() ? TEXT("") : TEXT("s"));
+	return ProtoStateMessageType + (IsSingletonInChannelData() || IsInActorMessage() ? TEXT("") : TEXT("s"));
 }
 
 FString FReplicatedActorDecorator::GetDefinition_ChannelDataFieldNameGo()
@@ -494,6 +760,37 @@ FString FReplicatedActorDecorator::GetDefinition_ChannelDataFieldNameCpp()
 	return GetDefinition_ChannelDataFieldNameProto().ToLower();
 }
 
+FString FReplicatedActorDecorator::GetDefinition_ChannelDataFieldNumberCpp()
+{
+	// Same as UnderscoresToCamelCase(FieldName, true) in protoc
+	const FString ChannelDataFieldName = GetDefinition_ChannelDataFieldNameProto();
+	FString Result = TEXT("k");
+	bool bCapNext = true;
+	for (const TCHAR C : ChannelDataFieldName)
+	{
+		if (FChar::IsLower(C))
+		{
+			Result.AppendChar(bCapNext ? FChar::ToUpper(C) : C);
+			bCapNext = false;
+		}
+		else if (FChar::IsUpper(C))
+		{
+			Result.AppendChar(C);
+			bCapNext = false;
+		}
+		else if (FChar::IsDigit(C))
+		{
+			Result.AppendChar(C);
+			bCapNext = true;
+		}
+		else
+		{
+			bCapNext = true;
+		}
+	}
+	return Result + TEXT("FieldNumber");
+}
+
 FString FReplicatedActorDecorator::GetCode_ConstPathFNameVarDecl()
 {
 	return FString::Printf(TEXT("const FName %s = FName(\"%s\");"), *VariableName_ConstClassPathFName, *TargetClass->GetPathName());
@@ -542,16 +839,27 @@ FString FReplicatedActorDecorator::GetCode_ChanneldDataProcessor_InitRemovedStat
 	return TEXT("");
 }
 
-FString FReplicatedActorDecorator::GetCode_ChannelDataProcessor_Merge(const TArray<TSharedPtr<FReplicatedActorDecorator>>& ActorChildren)
+FString FReplicatedActorDecorator::GetCode_ChannelDataProcessor_Merge(const TArray<TSharedPtr<FReplicatedActorDecorator>>& ActorChildren, bool bMoveStates)
 {
+	// Merged in the loop over the actors, see GetCode_ChannelDataProcessor_MergeActorField().
+	if (IsInActorMessage())
+	{
+		return FString();
+	}
 	FStringFormatNamedArguments FormatArgs;
-	FormatArgs.Add(TEXT("Definition_ChannelDataFieldName"), GetDefinition_ChannelDataFieldNameCpp());
+	const FString FieldName = GetDefinition_ChannelDataFieldNameCpp();
+	FormatArgs.Add(TEXT("Definition_ChannelDataFieldName"), FieldName);
+	FormatArgs.Add(TEXT("Code_SrcStates"), FString::Printf(bMoveStates ? TEXT("*Src->mutable_%s()") : TEXT("Src->%s()"), *FieldName));
+	FormatArgs.Add(TEXT("Code_InsertState"), bMoveStates ? TEXT("(*DstStates)[Pair.first].Swap(&Pair.second);") : TEXT("DstStates->emplace(Pair.first, Pair.second);"));
 	if (IsSingletonInChannelData())
 	{
+		FormatArgs.Add(TEXT("Code_MergeState"), GetCode_ChannelDataProcessor_MergeState(
+			FString::Printf(TEXT("Dst->mutable_%s()"), *FieldName), FString::Printf(TEXT("&Src->%s()"), *FieldName)));
 		return FString::Format(ActorDecor_ChannelDataProcessorMerge_Singleton, FormatArgs);
 	}
 	else
 	{
+		FormatArgs.Add(TEXT("Code_MergeState"), GetCode_ChannelDataProcessor_MergeState(TEXT("&Itr->second"), TEXT("&Pair.second")));
 		FString Code_MergeLoopInner;
 		if (TargetClass == AActor::StaticClass())
 		{
@@ -599,12 +907,177 @@ FString FReplicatedActorDecorator::GetCode_ChannelDataProcessor_Merge(const TArr
 	}
 }
 
+bool FReplicatedActorDecorator::HasDirtyMask()
+{
+	// The narrow states are cheap enough to merge by checking every field.
+	static constexpr int32 MinPropertiesForDirtyMask = 8;
+	static constexpr int32 MaxPropertiesForDirtyMask = 64;
+	return CanMergeStateByFields() && Properties.Num() >= MinPropertiesForDirtyMask && Properties.Num() <= MaxPropertiesForDirtyMask;
+}
+
+bool FReplicatedActorDecorator::HasPackedFlags()
+{
+	return bHasPackedFlags;
+}
+
+bool FReplicatedActorDecorator::HasShadowState()
+{
+	return HasPackedFlags() || Properties.ContainsByPredicate([](const TSharedPtr<FPropertyDecorator>& Property) { return Property->SupportsShadowState(); });
+}
+
+bool FReplicatedActorDecorator::IsFullStateShadowed()
+{
+	return Properties.Num() > 0 && !Properties.ContainsByPredicate([](const TSharedPtr<FPropertyDecorator>& Property)
+	{
+		return !Property->IsPackedInFlags() && !Property->SupportsShadowState();
+	});
+}
+
+bool FReplicatedActorDecorator::CanMergeStateByFields()
+{
+	// The built-in states are defined in unreal_common.proto rather than generated from the properties,
+	// and the state of UActorComponent is a map of the component states.
+	return !IsChanneldUEBuiltinType() && !IsSkipGenChannelDataState() && TargetClass != UActorComponent::StaticClass();
+}
+
+FString FReplicatedActorDecorator::GetCode_ChannelDataProcessor_MergeStateFunc()
+{
+	if (!CanMergeStateByFields())
+	{
+		return TEXT("");
+	}
+
+	FString Code_MergeFields;
+	if (TargetClass->IsChildOf(UActorComponent::StaticClass()))
+	{
+		Code_MergeFields.Append(TEXT("if (Src->removed())\n{\n  Dst->set_removed(true);\n}\n"));
+	}
+	if (HasPackedFlags())
+	{
+		Code_MergeFields.Append(TEXT("if (Src->has_packed_flags())\n{\n  Dst->set_packed_flags(Src->packed_flags());\n}\n"));
+	}
+	FString Code_MergeAllFields;
+	FString Code_MergeFieldCases;
+	for (int32 i = 0; i < Properties.Num(); i++)
+	{
+		if (Properties[i]->IsPackedInFlags())
+		{
+			continue;
+		}
+		const FString Code_MergeField = Properties[i]->GetCode_MergeProtoField(TEXT("Dst"), TEXT("Src"));
+		Code_MergeAllFields.Append(Code_MergeField);
+		Code_MergeFieldCases.Append(FString::Printf(TEXT("case %d:\n{\n%s  break;\n}\n"), i, *Code_MergeField));
+	}
+	if (HasDirtyMask())
+	{
+		FStringFormatNamedArguments MaskFormatArgs;
+		MaskFormatArgs.Add(TEXT("Code_MergeFieldCases"), Code_MergeFieldCases);
+		MaskFormatArgs.Add(TEXT("Code_MergeFields"), Code_MergeAllFields);
+		Code_MergeFields.Append(FString::Format(ActorDecor_ChannelDataProcessorMergeStateByDirtyMask, MaskFormatArgs));
+	}
+	else
+	{
+		Code_MergeFields.Append(Code_MergeAllFields);
+	}
+
+	FStringFormatNamedArguments FormatArgs;
+	FormatArgs.Add(TEXT("Definition_ProtoNamespace"), GetProtoNamespace());
+	FormatArgs.Add(TEXT("Definition_ProtoStateMsgName"), GetProtoStateMessageType());
+	FormatArgs.Add(TEXT("Code_MergeFields"), Code_MergeFields);
+	return FString::Format(ActorDecor_ChannelDataProcessorMergeStateFunc, FormatArgs);
+}
+
+FString FReplicatedActorDecorator::GetCode_ChannelDataProcessor_MergeState(const FString& DstState, const FString& SrcState)
+{
+	if (CanMergeStateByFields())
+	{
+		return FString::Printf(TEXT("MergeState_%s(%s, %s);"), *GetProtoStateMessageType(), *DstState, *SrcState);
+	}
+	return FString::Printf(TEXT("(%s)->MergeFrom(*(%s));"), *DstState, *SrcState);
+}
+
+FString FReplicatedActorDecorator::GetCode_MergeStateFuncGo(const FString& FuncName, const FString& ChannelDataPackageName)
+{
+	if (!CanMergeStateByFields())
+	{
+		return TEXT("");
+	}
+
+	FString Code_MergeFields;
+	if (TargetClass->IsChildOf(UActorComponent::StaticClass()))
+	{
+		Code_MergeFields.Append(TEXT("\tif src.Removed {\n\t\tdst.Removed = true\n\t}\n"));
+	}
+	if (HasPackedFlags())
+	{
+		Code_MergeFields.Append(TEXT("\tif src.PackedFlags != nil {\n\t\tdst.PackedFlags = src.PackedFlags\n\t}\n"));
+	}
+	FString Code_MergeAllFields;
+	FString Code_MergeFieldCases;
+	for (int32 i = 0; i < Properties.Num(); i++)
+	{
+		if (Properties[i]->IsPackedInFlags())
+		{
+			continue;
+		}
+		const FString Code_MergeField = Properties[i]->GetCode_MergeProtoFieldGo(TEXT("dst"), TEXT("src"));
+		Code_MergeAllFields.Append(Code_MergeField);
+		Code_MergeFieldCases.Append(FString::Printf(TEXT("case %d:\n%s"), i, *Code_MergeField));
+	}
+	if (HasDirtyMask())
+	{
+		FStringFormatNamedArguments MaskFormatArgs;
+		MaskFormatArgs.Add(TEXT("Code_MergeFieldCases"), Code_MergeFieldCases);
+		MaskFormatArgs.Add(TEXT("Code_MergeFields"), Code_MergeAllFields);
+		Code_MergeFields.Append(FString::Format(CodeGen_Go_MergeStateByDirtyMaskTemplate, MaskFormatArgs));
+	}
+	else
+	{
+		Code_MergeFields.Append(Code_MergeAllFields);
+	}
+
+	FStringFormatNamedArguments FormatArgs;
+	FormatArgs.Add(TEXT("Definition_MergeFuncName"), FuncName);
+	FormatArgs.Add(TEXT("Definition_StatePackagePath"), GetProtoPackagePathGo(ChannelDataPackageName));
+	FormatArgs.Add(TEXT("Definition_StateClassName"), GetProtoStateMessageTypeGo());
+	FormatArgs.Add(TEXT("Code_MergeFields"), Code_MergeFields);
+	return FString::Format(CodeGen_Go_MergeStateFuncTemplate, FormatArgs);
+}
+
+FString FReplicatedActorDecorator::GetCode_SampleStateGo(const FString& ChannelDataPackageName)
+{
+	FString Code_Fields;
+	for (const TSharedPtr<FPropertyDecorator> Property : Properties)
+	{
+		const FString SampleValue = Property->GetCode_ProtoFieldSampleValueGo();
+		if (!SampleValue.IsEmpty())
+		{
+			Code_Fields.Append(FString::Printf(TEXT("%s: %s, "), *Property->GetProtoFieldNameGo(), *SampleValue));
+		}
+	}
+	if (HasPackedFlags())
+	{
+		Code_Fields.Append(TEXT("PackedFlags: proto.Uint32(1), "));
+	}
+	if (HasDirtyMask())
+	{
+		Code_Fields.Append(FString::Printf(TEXT("DirtyMask: proto.Uint64(%llu), "), Properties.Num() == 64 ? MAX_uint64 : (1ull << Properties.Num()) - 1));
+	}
+	return FString::Printf(TEXT("&%s%s{%s}"), *GetProtoPackagePathGo(ChannelDataPackageName), *GetProtoStateMessageTypeGo(), *Code_Fields);
+}
+
 FString FReplicatedActorDecorator::GetCode_ChannelDataProcessor_GetStateFromChannelData(const FString& ChannelDataMessageName)
 {
 	FStringFormatNamedArguments FormatArgs;
 	FormatArgs.Add(TEXT("Code_Condition"), GetCode_ChannelDataProcessor_IsTargetClass());
 	FormatArgs.Add(TEXT("Declaration_ChannelDataMessage"), ChannelDataMessageName);
 	FormatArgs.Add(TEXT("Definition_ChannelDataFieldName"), GetDefinition_ChannelDataFieldNameCpp());
+	if (IsInActorMessage())
+	{
+		const bool bRemovable = TargetClass == AActor::StaticClass() || TargetClass->IsChildOf(UActorComponent::StaticClass());
+		FormatArgs.Add(TEXT("Code_IsRemoved"), bRemovable ? FString::Printf(TEXT("Itr->second.%s().removed()"), *GetDefinition_ChannelDataFieldNameCpp()) : FString(TEXT("false")));
+		return FString::Format(ActorDecor_GetStateFromActorMessage, FormatArgs);
+	}
 	if (IsSingletonInChannelData())
 	{
 		if (TargetClass == UActorComponent::StaticClass())
@@ -626,6 +1099,55 @@ FString FReplicatedActorDecorator::GetCode_ChannelDataProcessor_GetStateFromChan
 	return FString::Format(ActorDecor_GetStateFromChannelData, FormatArgs);
 }
 
+FString FReplicatedActorDecorator::GetCode_ChannelDataProcessor_MergeFromString()
+{
+	// The actor-centric channel data doesn't support MergeFromString().
+	if (IsInActorMessage())
+	{
+		return FString();
+	}
+	FStringFormatNamedArguments FormatArgs;
+	FormatArgs.Add(TEXT("Definition_ChannelDataFieldNumber"), GetDefinition_ChannelDataFieldNumberCpp());
+	FormatArgs.Add(TEXT("Definition_ChannelDataFieldName"), GetDefinition_ChannelDataFieldNameCpp());
+	FormatArgs.Add(TEXT("Definition_ProtoNamespace"), GetProtoNamespace());
+	FormatArgs.Add(TEXT("Definition_ProtoStateMsgName"), GetProtoStateMessageType());
+	FormatArgs.Add(TEXT("Code_MergeStateFunc"), CanMergeStateByFields() ? FString::Printf(TEXT(", &MergeState_%s"), *GetProtoStateMessageType()) : FString());
+	if (IsSingletonInChannelData())
+	{
+		return FString::Format(HasDirtyMask() ? ActorDecor_ChannelDataProcessorMergeFromString_SingletonByFields : ActorDecor_ChannelDataProcessorMergeFromString_Singleton, FormatArgs);
+	}
+	if (TargetClass == AActor::StaticClass())
+	{
+		FormatArgs.Add(TEXT("Code_RemoveState"), TEXT("RemovedActorNetGUIDs.Add(NetGUID);"));
+		return FString::Format(ActorDecor_ChannelDataProcessorMergeFromString_RemovableMap, FormatArgs);
+	}
+	if (TargetClass != UActorComponent::StaticClass() && TargetClass->IsChildOf(UActorComponent::StaticClass()))
+	{
+		FormatArgs.Add(TEXT("Code_RemoveState"), FString::Printf(TEXT("Dst->mutable_%s()->erase(NetGUID);"), *GetDefinition_ChannelDataFieldNameCpp()));
+		return FString::Format(ActorDecor_ChannelDataProcessorMergeFromString_RemovableMap, FormatArgs);
+	}
+	return FString::Format(HasDirtyMask() ? ActorDecor_ChannelDataProcessorMergeFromString_MapByFields : ActorDecor_ChannelDataProcessorMergeFromString_Map, FormatArgs);
+}
+
+FString FReplicatedActorDecorator::GetCode_ChannelDataProcessor_MergeFromStringEraseActor(const TArray<TSharedPtr<FReplicatedActorDecorator>>& ActorChildren)
+{
+	FString Code;
+	if (TargetClass != AActor::StaticClass() || IsInActorMessage())
+	{
+		return Code;
+	}
+	for (const TSharedPtr<FReplicatedActorDecorator> ChildrenActor : ActorChildren)
+	{
+		// Singleton actors are not permanently removed from ChannelData.
+		if (ChildrenActor->IsSingletonInChannelData())
+		{
+			continue;
+		}
+		Code.Append(FString::Printf(TEXT("Dst->mutable_%s()->erase(NetGUID);\n"), *ChildrenActor->GetDefinition_ChannelDataFieldNameCpp()));
+	}
+	return Code;
+}
+
 FString FReplicatedActorDecorator::GetCode_ChannelDataProcessor_SetStateToChannelData(const FString& ChannelDataMessageName)
 {
 	FStringFormatNamedArguments FormatArgs;
@@ -634,6 +1156,12 @@ FString FReplicatedActorDecorator::GetCode_ChannelDataProcessor_SetStateToChanne
 	FormatArgs.Add(TEXT("Definition_ChannelDataFieldName"), GetDefinition_ChannelDataFieldNameCpp());
 	FormatArgs.Add(TEXT("Definition_ProtoNamespace"), GetProtoNamespace());
 	FormatArgs.Add(TEXT("Definition_ProtoStateMsgName"), GetProtoStateMessageType());
+	if (IsInActorMessage())
+	{
+		const bool bRemovable = TargetClass == AActor::StaticClass() || TargetClass->IsChildOf(UActorComponent::StaticClass());
+		FormatArgs.Add(TEXT("Code_AccessibleState"), bRemovable ? FString::Printf(TEXT("State != nullptr ? State : Removed%s.Get()"), *GetProtoStateMessageType()) : FString(TEXT("State")));
+		return FString::Format(ActorDecor_SetStateToActorMessage, FormatArgs);
+	}
 	if (IsSingletonInChannelData())
 	{
 		if (TargetClass == UActorComponent::StaticClass()){
@@ -652,9 +1180,21 @@ FString FReplicatedActorDecorator::GetCode_ChannelDataProcessor_SetStateToChanne
 	return FString::Format(ActorDecor_SetStateToChannelData, FormatArgs);
 }
 
+FString FReplicatedActorDecorator::GetCode_RegisterStateBinding(const FString& ChannelDataType)
+{
+	if (IsBlueprintType() || IsSingletonInChannelData() || IsInActorMessage() || TargetClass == UActorComponent::StaticClass())
+	{
+		return FString();
+	}
+	const bool bRemovable = TargetClass == AActor::StaticClass() || TargetClass->IsChildOf(UActorComponent::StaticClass());
+	return FString::Printf(TEXT("REGISTER_STATE_BINDING(%s, %s, %s::%s, %s, %s);\n"),
+		*ChannelDataType, *GetActorCPPClassName(), *GetProtoNamespace(), *GetProtoStateMessageType(),
+		*GetDefinition_ChannelDataFieldNameCpp(), bRemovable ? TEXT("true") : TEXT("false"));
+}
+
 FString FReplicatedActorDecorator::GetCode_ChannelDataProtoFieldDefinition(const int32& FieldNum)
 {
-	if (IsSingletonInChannelData())
+	if (IsSingletonInChannelData() || IsInActorMessage())
 	{
 		return FString::Printf(TEXT("optional %s.%s %s = %d;\n"), *GetProtoPackageName(), *GetProtoStateMessageType(), *GetDefinition_ChannelDataFieldNameProto(), FieldNum);
 	}
@@ -664,6 +1204,22 @@ FString FReplicatedActorDecorator::GetCode_ChannelDataProtoFieldDefinition(const
 	}
 }
 
+FString FReplicatedActorDecorator::GetCode_ChannelDataProcessor_MergeActorField(bool bMoveStates)
+{
+	FStringFormatNamedArguments FormatArgs;
+	const FString FieldName = GetDefinition_ChannelDataFieldNameCpp();
+	FormatArgs.Add(TEXT("Definition_ChannelDataFieldName"), FieldName);
+	FormatArgs.Add(TEXT("Code_MergeState"), GetCode_ChannelDataProcessor_MergeState(
+		FString::Printf(TEXT("DstActor.mutable_%s()"), *FieldName), FString::Printf(TEXT("&SrcActor.%s()"), *FieldName)));
+	FormatArgs.Add(TEXT("Code_InsertState"), FString::Printf(bMoveStates ? TEXT("DstActor.mutable_%s()->Swap(SrcActor.mutable_%s());") : TEXT("*DstActor.mutable_%s() = SrcActor.%s();"), *FieldName, *FieldName));
+	// The removed actor is erased as a whole before its fields are merged.
+	if (TargetClass != AActor::StaticClass() && TargetClass->IsChildOf(UActorComponent::StaticClass()))
+	{
+		return FString::Format(ActorDecor_ChannelDataProcessorMergeActorField_Removable, FormatArgs);
+	}
+	return FString::Format(ActorDecor_ChannelDataProcessorMergeActorField, FormatArgs);
+}
+
 bool FReplicatedActorDecorator::IsStruct()
 {
 	return false;
@@ -6,21 +6,65 @@
 #include "ReplicatorGeneratorUtils.h"
 #include "GameFramework/PlayerState.h"
 #include "Internationalization/Regex.h"
+#include "Async/ParallelFor.h"
 #include "Misc/FileHelper.h"
+#include "Serialization/BufferArchive.h"
+#include "Serialization/MemoryReader.h"
 #include "ReplicatorTemplate/BlueprintReplicatorTemplate.h"
 #include "ReplicatorTemplate/CppReplicatorTemplate.h"
 #include "ReplicatorTemplate/GoProtoDataTemplate.h"
 
-bool FReplicatorCodeGenerator::RefreshModuleInfoByClassName()
+// Bump when the format of the class-to-header index cache changes.
+static constexpr int32 ClassHeaderIndexCacheVersion = 1;
+
+// The key of the map `actors` in FChannelDataCode::FieldNumbers, which can't be a class path.
+static const TCHAR* ChannelDataActorsFieldKey = TEXT("actors");
+
+FString FReplicatorCodeGenerator::GetManifestFilePath()
 {
 	const FString BuildConfiguration = ANSI_TO_TCHAR(COMPILER_CONFIGURATION_NAME);
-	const FString ManifestFilePath = FPaths::ProjectIntermediateDir() / TEXT("Build") / TEXT(CHANNELD_EXPAND_AND_QUOTE(UBT_COMPILED_PLATFORM)) / TEXT(CHANNELD_EXPAND_AND_QUOTE(UE_TARGET_NAME)) / BuildConfiguration / TEXT(CHANNELD_EXPAND_AND_QUOTE(UE_TARGET_NAME)) + TEXT(".uhtmanifest");
+	return FPaths::ProjectIntermediateDir() / TEXT("Build") / TEXT(CHANNELD_EXPAND_AND_QUOTE(UBT_COMPILED_PLATFORM)) / TEXT(CHANNELD_EXPAND_AND_QUOTE(UE_TARGET_NAME)) / BuildConfiguration / TEXT(CHANNELD_EXPAND_AND_QUOTE(UE_TARGET_NAME)) + TEXT(".uhtmanifest");
+}
+
+bool FReplicatorCodeGenerator::RefreshModuleInfoByClassName()
+{
+	bCPPClassInfoMapStale = true;
+	return IFileManager::Get().FileExists(*GetManifestFilePath());
+}
+
+bool FReplicatorCodeGenerator::EnsureCPPClassInfoMapLoaded()
+{
+	if (!bCPPClassInfoMapStale)
+	{
+		return true;
+	}
+
+	const FString ManifestFilePath = GetManifestFilePath();
+	const FDateTime ManifestTimestamp = IFileManager::Get().GetTimeStamp(*ManifestFilePath);
+	if (ManifestTimestamp == FDateTime::MinValue())
+	{
+		UE_LOG(LogChanneldRepGenerator, Error, TEXT("Failed to find manifest file: %s"), *ManifestFilePath);
+		return false;
+	}
+	bCPPClassInfoMapStale = false;
+	if (ManifestTimestamp == LoadedManifestTimestamp)
+	{
+		return true;
+	}
+
+	CPPClassInfoMap.Reset();
+	if (LoadCPPClassInfoMapFromCache(ManifestTimestamp))
+	{
+		LoadedManifestTimestamp = ManifestTimestamp;
+		return true;
+	}
 
 	bool bManifestSuccessfullyLoaded;
 	FManifest Manifest = FManifest::LoadFromFile(ManifestFilePath, bManifestSuccessfullyLoaded);
 	if (!bManifestSuccessfullyLoaded)
 	{
 		UE_LOG(LogChanneldRepGenerator, Error, TEXT("Failed to load manifest file: %s"), *ManifestFilePath);
+		bCPPClassInfoMapStale = true;
 		return false;
 	}
 	for (FManifestModule& ManifestModule : Manifest.Modules)
@@ -29,13 +73,63 @@ bool FReplicatorCodeGenerator::RefreshModuleInfoByClassName()
 		ProcessHeaderFiles(ManifestModule.PublicUObjectHeaders, ManifestModule);
 		ProcessHeaderFiles(ManifestModule.PrivateUObjectHeaders, ManifestModule);
 	}
+	LoadedManifestTimestamp = ManifestTimestamp;
+	SaveCPPClassInfoMapToCache(ManifestTimestamp);
 
 	return true;
 }
 
+bool FReplicatorCodeGenerator::LoadCPPClassInfoMapFromCache(const FDateTime& ManifestTimestamp)
+{
+	TArray<uint8> CacheData;
+	if (!FFileHelper::LoadFileToArray(CacheData, *GenManager_ClassHeaderIndexPath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(CacheData);
+	int32 CacheVersion = 0;
+	int64 CachedManifestTicks = 0;
+	Reader << CacheVersion;
+	Reader << CachedManifestTicks;
+	if (CacheVersion != ClassHeaderIndexCacheVersion || CachedManifestTicks != ManifestTimestamp.GetTicks())
+	{
+		return false;
+	}
+	Reader << CPPClassInfoMap;
+	if (Reader.IsError())
+	{
+		CPPClassInfoMap.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FReplicatorCodeGenerator::SaveCPPClassInfoMapToCache(const FDateTime& ManifestTimestamp)
+{
+	FBufferArchive Writer;
+	int32 CacheVersion = ClassHeaderIndexCacheVersion;
+	int64 ManifestTicks = ManifestTimestamp.GetTicks();
+	Writer << CacheVersion;
+	Writer << ManifestTicks;
+	Writer << CPPClassInfoMap;
+
+	ChanneldReplicatorGeneratorUtils::EnsureRepGenIntermediateDir();
+	if (!FFileHelper::SaveArrayToFile(Writer, *GenManager_ClassHeaderIndexPath))
+	{
+		UE_LOG(LogChanneldRepGenerator, Warning, TEXT("Failed to save the class header index to: %s"), *GenManager_ClassHeaderIndexPath);
+	}
+}
+
+const FCPPClassInfo* FReplicatorCodeGenerator::FindCPPClassInfo(const FString& ClassName)
+{
+	EnsureCPPClassInfoMapLoaded();
+	return CPPClassInfoMap.Find(ClassName);
+}
+
 FString FReplicatorCodeGenerator::GetClassHeadFilePath(const FString& ClassName)
 {
-	FCPPClassInfo* Result = CPPClassInfoMap.Find(ClassName);
+	const FCPPClassInfo* Result = FindCPPClassInfo(ClassName);
 	if (Result != nullptr)
 	{
 		return Result->HeadFilePath;
@@ -45,6 +139,7 @@ FString FReplicatorCodeGenerator::GetClassHeadFilePath(const FString& ClassName)
 
 bool FReplicatorCodeGenerator::Generate(
 	const TArray<FChannelDataInfo>& ChannelDataInfos,
+	const TArray<const UClass*>& RPCOnlyClasses,
 	const FString& ProtoPackageName,
 	const FString& ProtoMessageSuffix,
 	const FString& GoPackageImportPath,
@@ -64,6 +159,14 @@ bool FReplicatorCodeGenerator::Generate(
 			}
 		}
 	}
+	for (const UClass* RPCOnlyClass : RPCOnlyClasses)
+	{
+		if (!ReplicationActorClassSet.Contains(RPCOnlyClass))
+		{
+			ReplicationActorClassSet.Add(RPCOnlyClass);
+			ReplicationActorClasses.Add(RPCOnlyClass);
+		}
+	}
 
 	// Clean global variables, make sure it's empty for this generation
 	TargetActorSameNameCounter.Empty();
@@ -73,27 +176,65 @@ bool FReplicatorCodeGenerator::Generate(
 	FString RegistrationIncludeCode;
 
 	// Generate replicators code
-	TArray<TSharedPtr<FReplicatedActorDecorator>> ActorDecoratorsToGenReplicator;
-	FString RegisterReplicatorCode;
+	// The decorators are created in the order of the classes, as the compilable names of the classes with the same name depend on the order.
+	TArray<TSharedPtr<FReplicatedActorDecorator>> ActorDecorators;
 	for (const UClass* ReplicationActorClass : ReplicationActorClasses)
 	{
 		TSharedPtr<FReplicatedActorDecorator> ActorDecorator;
-		if (!CreateDecorateActor(ActorDecorator, Message, ReplicationActorClass, FChannelDataStateSchema(), ProtoPackageName, ProtoMessageSuffix, GoPackageImportPath))
+		if (!CreateDecorateActor(ActorDecorator, Message, ReplicationActorClass, FChannelDataStateSchema(), ProtoPackageName, ProtoMessageSuffix, GoPackageImportPath, false))
 		{
 			UE_LOG(LogChanneldRepGenerator, Error, TEXT("%s"), *Message);
 			continue;
 		}
+		// Creating the CDO and setting up the replication data of the class (and its super classes) modify the UObject state, so they can't go parallel.
+		UClass* MutableClass = const_cast<UClass*>(ReplicationActorClass);
+		MutableClass->GetDefaultObject();
+		MutableClass->SetUpRuntimeReplicationData();
+		ActorDecorators.Add(ActorDecorator);
+	}
+
+	// Walking the properties and RPCs and formatting the templates are independent for each class. Use -SerialRepGen to run them on the game thread.
+	FPropertyDecoratorFactory::Get();
+	struct FReplicatorCodeResult
+	{
+		FReplicatorCode Code;
+		FString Message;
+		bool bSucceeded = false;
+	};
+	TArray<FReplicatorCodeResult> ReplicatorCodeResults;
+	ReplicatorCodeResults.SetNum(ActorDecorators.Num());
+	ParallelFor(ActorDecorators.Num(), [&ActorDecorators, &ReplicatorCodeResults, this](int32 Index)
+	{
+		const TSharedPtr<FReplicatedActorDecorator>& ActorDecorator = ActorDecorators[Index];
+		ActorDecorator->InitPropertiesAndRPCs();
+		if (!ActorDecorator->IsChanneldUEBuiltinType())
+		{
+			FReplicatorCodeResult& Result = ReplicatorCodeResults[Index];
+			Result.bSucceeded = GenerateReplicatorCode(ActorDecorator, Result.Code, Result.Message);
+		}
+	}, FParse::Param(FCommandLine::Get(), TEXT("SerialRepGen")));
+
+	// Merge the results in the order of the classes, so the output is the same as generating them one by one.
+	TArray<TSharedPtr<FReplicatedActorDecorator>> ActorDecoratorsToGenReplicator;
+	FString RegisterReplicatorCode;
+	TSet<FName> RPCFunctionNames;
+	for (int32 i = 0; i < ActorDecorators.Num(); i++)
+	{
+		const TSharedPtr<FReplicatedActorDecorator>& ActorDecorator = ActorDecorators[i];
+		// The RPCs of the builtin types also get the ids.
+		ActorDecorator->GetRPCFunctionNames(RPCFunctionNames);
 		if (ActorDecorator->IsChanneldUEBuiltinType())
 		{
 			// Skip generate replicator for channeld ue builtin replication actors, they are written in ChanneldUE module.
 			continue;
 		}
-		FReplicatorCode GeneratedResult;
-		if (!GenerateReplicatorCode(ActorDecorator, GeneratedResult, Message))
+		FReplicatorCodeResult& Result = ReplicatorCodeResults[i];
+		if (!Result.bSucceeded)
 		{
-			UE_LOG(LogChanneldRepGenerator, Error, TEXT("%s"), *Message);
+			UE_LOG(LogChanneldRepGenerator, Error, TEXT("%s"), *Result.Message);
 			continue;
 		}
+		FReplicatorCode& GeneratedResult = Result.Code;
 		ReplicationCodeBundle.ReplicatorCodes.Add(GeneratedResult);
 		ActorDecoratorsToGenReplicator.Add(ActorDecorator);
 		RegistrationIncludeCode.Append(GeneratedResult.IncludeActorCode + TEXT("\n"));
@@ -102,8 +243,8 @@ bool FReplicatorCodeGenerator::Generate(
 	}
 
 	// Channel data
-	FString RegisterChannelDataProcessorCode, DeleteChannelDataProcessorCode, ChannelDataProcessorPtrDecls,
-	        ChannelDataRegistrationGoCode;
+	FString RegisterChannelDataProcessorCode, UnregisterChannelDataProcessorCode,
+	        ChannelDataRegistrationGoCode, ChannelDataMergeBenchmarkGoCode;
 	ReplicationCodeBundle.ChannelDataMerge_GoCode.Append(FString::Printf(TEXT("package %s\n"), *ProtoPackageName));
 	// Entity channel data.go imports anypb
 
@@ -121,10 +262,15 @@ bool FReplicatorCodeGenerator::Generate(
 		}
 		RegistrationIncludeCode.Append(ChannelDataCode.IncludeProcessorCode + TEXT("\n"));
 		RegisterChannelDataProcessorCode.Append(ChannelDataCode.RegisterProcessorCode + TEXT("\n"));
-		DeleteChannelDataProcessorCode.Append(ChannelDataCode.DeleteProcessorPtrCode + TEXT("\n"));
-		ChannelDataProcessorPtrDecls.Append(ChannelDataCode.ProcessorPtrDecl + TEXT("\n"));
+		UnregisterChannelDataProcessorCode.Append(ChannelDataCode.UnregisterProcessorCode + TEXT("\n"));
 		ChannelDataRegistrationGoCode.Append(ChannelDataCode.Registration_GoCode + TEXT("\n"));
 		ReplicationCodeBundle.ChannelDataMerge_GoCode.Append(ChannelDataCode.Merge_GoCode + TEXT("\n"));
+		ChannelDataMergeBenchmarkGoCode.Append(ChannelDataCode.MergeBenchmark_GoCode + TEXT("\n"));
+	}
+	if (!ChannelDataMergeBenchmarkGoCode.IsEmpty())
+	{
+		ReplicationCodeBundle.ChannelDataMergeBenchmark_GoCode = FString::Printf(TEXT("package %s\n"), *ProtoPackageName)
+			+ CodeGen_Go_MergeBenchmarkImportTemplate + ChannelDataMergeBenchmarkGoCode;
 	}
 	FStringFormatNamedArguments GoRegFormatArgs;
 	GoRegFormatArgs.Add("Definition_GoImportPath", GoPackageImportPath);
@@ -142,10 +288,19 @@ bool FReplicatorCodeGenerator::Generate(
 		// Register replicators
 		RegistrationFormatArgs.Add(TEXT("Code_ReplicatorRegister"), RegisterReplicatorCode);
 
+		// Register RPC function ids. Sorted so the ids don't depend on the order of the classes.
+		TArray<FName> SortedRPCFunctionNames = RPCFunctionNames.Array();
+		SortedRPCFunctionNames.Sort(FNameLexicalLess());
+		FString RegisterRPCFunctionNamesCode;
+		for (const FName& FuncName : SortedRPCFunctionNames)
+		{
+			RegisterRPCFunctionNamesCode.Append(FString::Printf(TEXT("TEXT(\"%s\"), "), *FuncName.ToString()));
+		}
+		RegistrationFormatArgs.Add(TEXT("Code_RPCFunctionNamesRegister"), FString::Printf(TEXT("    ChanneldReplication::RegisterRPCFunctionNames({%s});"), *RegisterRPCFunctionNamesCode));
+
 		// Register channel data processor
 		RegistrationFormatArgs.Add(TEXT("Code_ChannelDataProcessorRegister"), RegisterChannelDataProcessorCode);
-		RegistrationFormatArgs.Add(TEXT("Code_DeleteChannelDataProcessor"), DeleteChannelDataProcessorCode);
-		RegistrationFormatArgs.Add(TEXT("Declaration_Variables"), ChannelDataProcessorPtrDecls);
+		RegistrationFormatArgs.Add(TEXT("Code_UnregisterChannelDataProcessor"), UnregisterChannelDataProcessorCode);
 		ReplicationCodeBundle.ReplicatorRegistrationHeadCode = FString::Format(*CodeGen_RegistrationTemp, RegistrationFormatArgs);
 	}
 
@@ -273,6 +428,18 @@ bool FReplicatorCodeGenerator::GenerateReplicatorCode(
 	FormatArgs.Add(TEXT("Code_OnStateChangedAdditionalCondition"), OnStateChangedAdditionalCondition);
 	FormatArgs.Add(TEXT("Code_TickAdditionalCondition"), TickAdditionalCondition);
 	FormatArgs.Add(TEXT("Code_IsClient"), IsClientCode);
+	FormatArgs.Add(TEXT("Num_PushModelProperties"), ActorDecorator->GetPushModelPropertyNum());
+	FormatArgs.Add(TEXT("Num_StringDiffCaches"), ActorDecorator->GetStringDiffCacheNum());
+	FormatArgs.Add(TEXT("Code_PushModelPropertyIndices"), ActorDecorator->GetCode_PushModelPropertyIndices());
+
+	// The replicators whose properties are all diffed against the shadow state don't keep the full state.
+	const FString FullStateType = FString::Printf(TEXT("%s::%s"), *ActorDecorator->GetProtoNamespace(), *ActorDecorator->GetProtoStateMessageType());
+	const bool bFullStateShadowed = ActorDecorator->IsFullStateShadowed();
+	FormatArgs.Add(TEXT("Code_OverrideGetFullState"), bFullStateShadowed ? TEXT("") : TEXT("  virtual google::protobuf::Message* GetFullState() override { return FullState; }"));
+	FormatArgs.Add(TEXT("Declare_FullState"), bFullStateShadowed ? FString() : FString::Printf(TEXT("  // [Server+Client] The accumulated channel data of the target object\n  %s* FullState;"), *FullStateType));
+	FormatArgs.Add(TEXT("Declare_ShadowState"), ActorDecorator->GetDeclaration_ShadowState());
+	FormatArgs.Add(TEXT("Code_AcquireFullState"), bFullStateShadowed ? FString() : FString::Printf(TEXT("  FullState = AcquireState<%s>();"), *FullStateType));
+	FormatArgs.Add(TEXT("Code_ReleaseFullState"), bFullStateShadowed ? TEXT("") : TEXT("  ReleaseState(FullState);"));
 
 	if (bIsBlueprint)
 	{
@@ -303,8 +470,11 @@ bool FReplicatorCodeGenerator::GenerateReplicatorCode(
 	CppCodeBuilder.Append(FString::Printf(TEXT("#include \"%s\"\n"), *GeneratedResult.HeadFileName));
 	CppCodeBuilder.Append(FString::Printf(TEXT("#include \"%s\"\n\n"), *GenManager_TypeDefinitionHeadFile));
 
-	// Define and initialize the static PropPointerMemOffsetCache for the constructor
-	CppCodeBuilder.Append(FString::Printf(TEXT("TMap<FString, int32> %s::PropPointerMemOffsetCache;\n\n"), *ActorDecorator->GetReplicatorClassName()));
+	if (bIsBlueprint)
+	{
+		// Define the static property tables for the constructor
+		CppCodeBuilder.Append(FString::Printf(TEXT("FChanneldBlueprintPropertyTables %s::PropertyTables;\n\n"), *ActorDecorator->GetReplicatorClassName()));
+	}
 	
 	FormatArgs.Add(
 		TEXT("Code_AssignPropertyPointers"),
@@ -326,6 +496,8 @@ bool FReplicatorCodeGenerator::GenerateReplicatorCode(
 		TEXT("Code_AllPropertiesSetDeltaState"),
 		ActorDecorator->GetCode_AllPropertiesSetDeltaState(TEXT("FullState"), TEXT("DeltaState"))
 	);
+	FormatArgs.Add(TEXT("Code_MergeDeltaState"), ActorDecorator->GetCode_MergeDeltaState(TEXT("FullState"), TEXT("DeltaState")));
+	FormatArgs.Add(TEXT("Code_MergeNewState"), ActorDecorator->GetCode_MergeNewState(TEXT("FullState"), TEXT("NewState")));
 	CppCodeBuilder.Append(FString::Format(CodeGen_CPP_TickImplTemplate, FormatArgs));
 
 	FormatArgs.Add(
@@ -439,19 +611,16 @@ bool FReplicatorCodeGenerator::GenerateChannelDataCode(
 	GeneratedResult.ProtoFileName = FString::Printf(TEXT("%s%s"), *GeneratedResult.ProtoBaseFileName, *CodeGen_ProtoFileExtension);
 	GeneratedResult.IncludeProcessorCode = FString::Printf(TEXT("#include \"%s\""), *GeneratedResult.ProcessorHeadFileName);
 
-	// Register channel data processor
-	const FString CDPPointerName = FString::Printf(TEXT("%sPtr"), *ChannelDataProcessorNamespace);
+	// Register channel data processor. It's created when the channel data type is looked up for the first time.
 	GeneratedResult.RegisterProcessorCode = FString::Printf(
-		TEXT("%s = new %s::%s();\nChanneldReplication::RegisterChannelDataProcessor(TEXT(\"%s.%s\"), %s);\n"),
-		*CDPPointerName,
-		*ChannelDataProcessorNamespace, *ChannelDataProcessorClassName,
-		*ProtoPackageName, *ChannelDataProtoMsgName,
-		*CDPPointerName
+		TEXT("ChanneldReplication::RegisterChannelDataProcessorFactory(TEXT(\"%s\"), []() -> IChannelDataProcessor* { return new %s::%s(); });\n"),
+		*GeneratedResult.ChannelDataMsgName,
+		*ChannelDataProcessorNamespace, *ChannelDataProcessorClassName
 	);
-	GeneratedResult.DeleteProcessorPtrCode = FString::Printf(TEXT("delete %s;"), *CDPPointerName);
-	GeneratedResult.ProcessorPtrDecl = FString::Printf(TEXT("%s::%s* %s;\n"), *ChannelDataProcessorNamespace, *ChannelDataProcessorClassName, *CDPPointerName);
+	GeneratedResult.UnregisterProcessorCode = FString::Printf(TEXT("ChanneldReplication::UnregisterChannelDataProcessor(TEXT(\"%s\"));"), *GeneratedResult.ChannelDataMsgName);
 
 	TArray<TSharedPtr<FReplicatedActorDecorator>> ActorDecoratorsToGenChannelData;
+	TArray<float> UpdateFrequencies;
 
 	FString Message;
 	for (const FChannelDataInfo::FStateInfo& StateInfo : ChannelDataInfo.StateInfos)
@@ -467,11 +636,71 @@ bool FReplicatorCodeGenerator::GenerateChannelDataCode(
 			continue;
 		}
 		ActorDecoratorsToGenChannelData.Add(ActorDecorator);
+
+		float UpdateFrequency = StateInfo.Setting.UpdateFrequency;
+		if (UpdateFrequency <= 0.f)
+		{
+			// The components are sent along with their owners.
+			const UClass* FrequencyClass = StateInfo.RepActorClass->IsChildOf(AActor::StaticClass()) ? StateInfo.RepActorClass : AActor::StaticClass();
+			UpdateFrequency = GetDefault<AActor>(const_cast<UClass*>(FrequencyClass))->NetUpdateFrequency;
+		}
+		UpdateFrequencies.Add(UpdateFrequency);
+	}
+
+	// The entity channel data has only one actor, so the actor-centric layout saves nothing there.
+	bool bActorCentric = false;
+	if (ChannelDataInfo.Schema.bActorCentric && ChannelDataInfo.Schema.ChannelType != EChanneldChannelType::ECT_Entity)
+	{
+		for (const TSharedPtr<FReplicatedActorDecorator>& ActorDecorator : ActorDecoratorsToGenChannelData)
+		{
+			if (ActorDecorator->CanBeInActorMessage())
+			{
+				ActorDecorator->SetInActorMessage(true);
+				bActorCentric = true;
+			}
+		}
+	}
+
+	TArray<int32> FieldNumbers;
+	AssignChannelDataFieldNumbers(ChannelDataInfo, ActorDecoratorsToGenChannelData, UpdateFrequencies, FieldNumbers);
+	for (int32 i = 0; i < ActorDecoratorsToGenChannelData.Num(); i++)
+	{
+		GeneratedResult.FieldNumbers.Add(ActorDecoratorsToGenChannelData[i]->GetActorPathName(), FieldNumbers[i]);
+	}
+
+	int32 ActorsFieldNumber = INDEX_NONE;
+	if (bActorCentric)
+	{
+		// Only the states outside the actor message share the numbers with the map, so it usually gets a 1-byte tag.
+		TSet<int32> UsedFieldNumbers;
+		for (int32 i = 0; i < ActorDecoratorsToGenChannelData.Num(); i++)
+		{
+			if (!ActorDecoratorsToGenChannelData[i]->IsInActorMessage())
+			{
+				UsedFieldNumbers.Add(FieldNumbers[i]);
+			}
+		}
+		const int32* LastFieldNumber = ChannelDataInfo.LastFieldNumbers.Find(ChannelDataActorsFieldKey);
+		if (LastFieldNumber && *LastFieldNumber > 0 && !UsedFieldNumbers.Contains(*LastFieldNumber))
+		{
+			ActorsFieldNumber = *LastFieldNumber;
+		}
+		else
+		{
+			ActorsFieldNumber = 1;
+			while (UsedFieldNumbers.Contains(ActorsFieldNumber))
+			{
+				ActorsFieldNumber++;
+			}
+		}
+		GeneratedResult.FieldNumbers.Add(ChannelDataActorsFieldKey, ActorsFieldNumber);
 	}
 
 	// Generate ChannelDataProcessor Proto definition file
 	if (!GenerateChannelDataProtoDefFile(
 		ActorDecoratorsToGenChannelData
+		, FieldNumbers
+		, ActorsFieldNumber
 		, ChannelDataInfo.Schema.ChannelType
 		, ChannelDataProtoMsgName
 		, ProtoPackageName
@@ -511,6 +740,12 @@ bool FReplicatorCodeGenerator::GenerateChannelDataCode(
 		Swap(SortedReplicationActorClasses[AActorIndex], SortedReplicationActorClasses[SortedReplicationActorClasses.Num() - 1]);
 	}
 
+	// The replicators of the native classes in the maps access their states without the TargetClass dispatch of the processor.
+	const FString ChannelDataType = FString::Printf(TEXT("%s::%s"), *ProtoPackageName, *ChannelDataProtoMsgName);
+	for (const TSharedPtr<FReplicatedActorDecorator>& ActorDecorator : ActorDecoratorsToGenChannelData)
+	{
+		GeneratedResult.RegisterProcessorCode.Append(ActorDecorator->GetCode_RegisterStateBinding(ChannelDataType));
+	}
 
 	// Generate ChannelDataProcessor CPP code
 	if (!GenerateChannelDataProcessorCode(
@@ -537,7 +772,8 @@ bool FReplicatorCodeGenerator::GenerateChannelDataCode(
 		ChannelDataInfo.Schema.ChannelType,
 		ChannelDataProtoMsgName,
 		ProtoPackageName,
-		GeneratedResult.Merge_GoCode
+		GeneratedResult.Merge_GoCode,
+		GeneratedResult.MergeBenchmark_GoCode
 	))
 	{
 		ResultMessage = TEXT("Failed to generate channel data merge go code");
@@ -574,15 +810,25 @@ bool FReplicatorCodeGenerator::GenerateChannelDataProcessorCode(
 	FString ChannelDataProcessor_ConstPathFNameVarDecl;
 	FString ChannelDataProcessor_RemovedStateDecl;
 	FString ChannelDataProcessor_InitRemovedStateCode;
+	FString ChannelDataProcessor_MergeStateFuncCode;
+	TSet<FString> MergeStateFuncStateTypes;
 	FString ChannelDataProcessor_MergeCode;
+	FString ChannelDataProcessor_MergeMoveCode;
+	FString ChannelDataProcessor_MergeFromStringCode;
+	FString ChannelDataProcessor_MergeFromStringEraseActorsCode;
 	FString ChannelDataProcessor_GetStateCode;
 	FString ChannelDataProcessor_SetStateCode;
 	FString ChannelDataProcessor_GetRelevantNetGUIDsCode;
+	FString ChannelDataProcessor_MergeActorFieldsCode;
+	FString ChannelDataProcessor_MergeMoveActorFieldsCode;
+	FString ChannelDataProcessor_EraseRemovedActorCode;
 
 	// Handle Merge/GetState/SetStsate of UnrealObjectRef for the Entity channel data
 	if (ChannelType == EChanneldChannelType::ECT_Entity)
 	{
 		ChannelDataProcessor_MergeCode.Append(CodeGen_MergeObjectState);
+		ChannelDataProcessor_MergeMoveCode.Append(CodeGen_MergeObjectState);
+		ChannelDataProcessor_MergeFromStringCode.Append(CodeGen_MergeObjectStateFromString);
 	}
 
 	ChannelDataProcessor_GetStateCode.Append(FString::Format(ChannelType == EChanneldChannelType::ECT_Entity ?
@@ -610,7 +856,26 @@ bool FReplicatorCodeGenerator::GenerateChannelDataProcessorCode(
 		ChannelDataProcessor_ConstPathFNameVarDecl.Append(ActorDecorator->GetCode_ConstPathFNameVarDecl() + TEXT("\n"));
 		ChannelDataProcessor_RemovedStateDecl.Append(ActorDecorator->GetDeclaration_ChanneldDataProcessor_RemovedStata() + TEXT("\n"));
 		ChannelDataProcessor_InitRemovedStateCode.Append(ActorDecorator->GetCode_ChanneldDataProcessor_InitRemovedState());
+		bool bMergeStateFuncExists = false;
+		MergeStateFuncStateTypes.Add(ActorDecorator->GetProtoStateMessageType(), &bMergeStateFuncExists);
+		if (!bMergeStateFuncExists)
+		{
+			ChannelDataProcessor_MergeStateFuncCode.Append(ActorDecorator->GetCode_ChannelDataProcessor_MergeStateFunc());
+		}
 		ChannelDataProcessor_MergeCode.Append(ActorDecorator->GetCode_ChannelDataProcessor_Merge(ChildrenOfAActor));
+		ChannelDataProcessor_MergeMoveCode.Append(ActorDecorator->GetCode_ChannelDataProcessor_Merge(ChildrenOfAActor, true));
+		ChannelDataProcessor_MergeFromStringCode.Append(ActorDecorator->GetCode_ChannelDataProcessor_MergeFromString());
+		ChannelDataProcessor_MergeFromStringEraseActorsCode.Append(ActorDecorator->GetCode_ChannelDataProcessor_MergeFromStringEraseActor(ChildrenOfAActor));
+		if (ActorDecorator->IsInActorMessage())
+		{
+			ChannelDataProcessor_MergeActorFieldsCode.Append(ActorDecorator->GetCode_ChannelDataProcessor_MergeActorField());
+			ChannelDataProcessor_MergeMoveActorFieldsCode.Append(ActorDecorator->GetCode_ChannelDataProcessor_MergeActorField(true));
+			if (TargetClass == AActor::StaticClass())
+			{
+				ChannelDataProcessor_EraseRemovedActorCode = FString::Format(CodeGen_EraseRemovedActorTemplate,
+					FStringFormatNamedArguments{{TEXT("Definition_ActorStateFieldName"), ActorDecorator->GetDefinition_ChannelDataFieldNameCpp()}});
+			}
+		}
 		
 		ChannelDataProcessor_GetStateCode.Append(
 			FString::Printf(
@@ -642,6 +907,19 @@ bool FReplicatorCodeGenerator::GenerateChannelDataProcessorCode(
 			ChannelDataProcessor_GetRelevantNetGUIDsCode.Append(FString::Format(CodeGen_GetRelevantNetIdByStateTemplate, FormatArgs));
 		}
 	}
+	const bool bActorCentric = !ChannelDataProcessor_MergeActorFieldsCode.IsEmpty();
+	if (bActorCentric)
+	{
+		FStringFormatNamedArguments FormatArgs;
+		FormatArgs.Add(TEXT("Code_EraseRemovedActor"), ChannelDataProcessor_EraseRemovedActorCode);
+		FormatArgs.Add(TEXT("Code_SrcActors"), TEXT("Src->actors()"));
+		FormatArgs.Add(TEXT("Code_MergeActorFields"), ChannelDataProcessor_MergeActorFieldsCode);
+		ChannelDataProcessor_MergeCode.Append(FString::Format(CodeGen_MergeActorsTemplate, FormatArgs));
+		FormatArgs.Add(TEXT("Code_SrcActors"), TEXT("*Src->mutable_actors()"));
+		FormatArgs.Add(TEXT("Code_MergeActorFields"), ChannelDataProcessor_MergeMoveActorFieldsCode);
+		ChannelDataProcessor_MergeMoveCode.Append(FString::Format(CodeGen_MergeActorsTemplate, FormatArgs));
+	}
+
 	FStringFormatNamedArguments CDPFormatArgs;
 	CDPFormatArgs.Add(TEXT("Code_IncludeAdditionHeaders"), ChannelDataProcessor_IncludeCode);
 	CDPFormatArgs.Add(TEXT("File_ChannelDataProtoHeader"), ChannelDataProtoHeadFileName);
@@ -655,7 +933,13 @@ bool FReplicatorCodeGenerator::GenerateChannelDataProcessorCode(
 	CDPFormatArgs.Add(TEXT("Code_InitRemovedState"), ChannelDataProcessor_InitRemovedStateCode);
 	CDPFormatArgs.Add(TEXT("Definition_CDP_ProtoMsgName"), ChannelDataMessageName);
 
+	CDPFormatArgs.Add(TEXT("Code_MergeStateFunctions"), ChannelDataProcessor_MergeStateFuncCode);
 	CDPFormatArgs.Add(TEXT("Code_Merge"), ChannelDataProcessor_MergeCode);
+	CDPFormatArgs.Add(TEXT("Code_MergeMove"), ChannelDataProcessor_MergeMoveCode);
+	// The fields of the actor messages are not parsed by MergeFromString(), so the actor-centric channel data is parsed and merged.
+	CDPFormatArgs.Add(TEXT("Code_SupportsMergeFromString"), bActorCentric ? TEXT("false") : TEXT("true"));
+	CDPFormatArgs.Add(TEXT("Code_MergeFromString"), ChannelDataProcessor_MergeFromStringCode);
+	CDPFormatArgs.Add(TEXT("Code_MergeFromStringEraseActors"), ChannelDataProcessor_MergeFromStringEraseActorsCode);
 	CDPFormatArgs.Add(TEXT("Declaration_CDP_ProtoVar"), ChannelDataMessageName);
 	CDPFormatArgs.Add(TEXT("Code_GetStateFromChannelData"), ChannelDataProcessor_GetStateCode.IsEmpty() ? TEXT("") : ChannelDataProcessor_GetStateCode + TEXT("else"));
 	CDPFormatArgs.Add(TEXT("Code_SetStateToChannelData"), ChannelDataProcessor_SetStateCode.IsEmpty() ? TEXT("") : ChannelDataProcessor_SetStateCode + TEXT("else"));
@@ -664,8 +948,77 @@ bool FReplicatorCodeGenerator::GenerateChannelDataProcessorCode(
 	return true;
 }
 
+void FReplicatorCodeGenerator::AssignChannelDataFieldNumbers(
+	const FChannelDataInfo& ChannelDataInfo,
+	const TArray<TSharedPtr<FReplicatedActorDecorator>>& TargetActors,
+	const TArray<float>& UpdateFrequencies,
+	TArray<int32>& OutFieldNumbers
+)
+{
+	OutFieldNumbers.Init(0, TargetActors.Num());
+	TSet<int32> UsedFieldNumbers;
+	// Entity channel data always has the UnrealObjectRef field
+	if (ChannelDataInfo.Schema.ChannelType == EChanneldChannelType::ECT_Entity)
+	{
+		UsedFieldNumbers.Add(1);
+	}
+
+	for (int32 i = 0; i < TargetActors.Num(); i++)
+	{
+		const int32* LastFieldNumber = ChannelDataInfo.LastFieldNumbers.Find(TargetActors[i]->GetActorPathName());
+		if (LastFieldNumber && *LastFieldNumber > 0 && !UsedFieldNumbers.Contains(*LastFieldNumber))
+		{
+			OutFieldNumbers[i] = *LastFieldNumber;
+			UsedFieldNumbers.Add(*LastFieldNumber);
+		}
+	}
+
+	TArray<int32> SortedIndices;
+	for (int32 i = 0; i < TargetActors.Num(); i++)
+	{
+		SortedIndices.Add(i);
+	}
+	SortedIndices.StableSort([&UpdateFrequencies](int32 A, int32 B) { return UpdateFrequencies[A] > UpdateFrequencies[B]; });
+
+	int32 NextFieldNumber = 1;
+	for (const int32 Index : SortedIndices)
+	{
+		if (OutFieldNumbers[Index] != 0)
+		{
+			continue;
+		}
+		while (UsedFieldNumbers.Contains(NextFieldNumber))
+		{
+			NextFieldNumber++;
+		}
+		OutFieldNumbers[Index] = NextFieldNumber;
+		UsedFieldNumbers.Add(NextFieldNumber);
+	}
+
+	// A kept number may cost a 2-byte tag while a less frequently updated state has a 1-byte one.
+	for (int32 i = 0; i < TargetActors.Num(); i++)
+	{
+		if (OutFieldNumbers[i] <= 15)
+		{
+			continue;
+		}
+		for (int32 j = 0; j < TargetActors.Num(); j++)
+		{
+			if (OutFieldNumbers[j] <= 15 && UpdateFrequencies[j] < UpdateFrequencies[i])
+			{
+				UE_LOG(LogChanneldRepGenerator, Log, TEXT("The state [%s] (%.1f/s) has the field number %d, while [%s] (%.1f/s) has %d. Generate with -ResetChannelDataFieldNumbers to renumber the states by the update frequency."),
+					*TargetActors[i]->GetActorPathName(), UpdateFrequencies[i], OutFieldNumbers[i],
+					*TargetActors[j]->GetActorPathName(), UpdateFrequencies[j], OutFieldNumbers[j]);
+				break;
+			}
+		}
+	}
+}
+
 bool FReplicatorCodeGenerator::GenerateChannelDataProtoDefFile(
 	const TArray<TSharedPtr<FReplicatedActorDecorator>>& TargetActors,
+	const TArray<int32>& FieldNumbers,
+	int32 ActorsFieldNumber,
 	const EChanneldChannelType ChannelType,
 	const FString& ChannelDataMessageName,
 	const FString& ProtoPackageName,
@@ -674,28 +1027,42 @@ bool FReplicatorCodeGenerator::GenerateChannelDataProtoDefFile(
 )
 {
 	FString ChannelDataFields;
+	FString ActorFields;
 	FString ImportCode = FString::Printf(TEXT("import \"%s\";\n"), *GenManager_UnrealCommonProtoFile);
-	int32 I = 0;
+	bool bImportUnrealComponents = false;
 	// Entity channel data always has the UnrealObjectRef field
 	if (ChannelType == EChanneldChannelType::ECT_Entity)
 	{
-		I++;
 		ChannelDataFields.Append("optional unrealpb.UnrealObjectRef objRef = 1;\n");
 	}
-	for (const TSharedPtr<FReplicatedActorDecorator> ActorDecorator : TargetActors)
+	for (int32 I = 0; I < TargetActors.Num(); I++)
 	{
-		FString ChannelDataField = ActorDecorator->GetCode_ChannelDataProtoFieldDefinition(++I);
-		ChannelDataFields.Append(ChannelDataField);
+		const TSharedPtr<FReplicatedActorDecorator>& ActorDecorator = TargetActors[I];
+		FString ChannelDataField = ActorDecorator->GetCode_ChannelDataProtoFieldDefinition(FieldNumbers[I]);
+		(ActorDecorator->IsInActorMessage() ? ActorFields : ChannelDataFields).Append(ChannelDataField);
 		if (!ActorDecorator->IsChanneldUEBuiltinType())
 		{
 			ImportCode.Append(FString::Printf(TEXT("import \"%s\";\n"), *ActorDecorator->GetProtoDefinitionsFileName()));
 		}
+		else if (!bImportUnrealComponents && ChanneldReplicatorGeneratorUtils::IsInUnrealComponentsProto(ActorDecorator->GetTargetClass()))
+		{
+			ImportCode.Append(FString::Printf(TEXT("import \"%s\";\n"), *GenManager_UnrealComponentsProtoFile));
+			bImportUnrealComponents = true;
+		}
 	}
 	FStringFormatNamedArguments FormatArgs;
 	FormatArgs.Add(TEXT("Code_Import"), ImportCode);
 	FormatArgs.Add(TEXT("Option"), FString::Printf(TEXT("option go_package = \"%s\";\n"), *GoPackageImportPath));
 	FormatArgs.Add(TEXT("Declare_ProtoPackageName"), ProtoPackageName);
-	FormatArgs.Add(TEXT("Definition_ProtoStateMsg"), FString::Printf(TEXT("message %s {\n%s}\n"), *ChannelDataMessageName, *ChannelDataFields));
+	FString ProtoStateMsg;
+	if (ActorsFieldNumber != INDEX_NONE)
+	{
+		const FString ActorMessageName = ChannelDataMessageName + TEXT("Actor");
+		ProtoStateMsg.Append(FString::Printf(TEXT("message %s {\n%s}\n\n"), *ActorMessageName, *ActorFields));
+		ChannelDataFields.Append(FString::Printf(TEXT("map<uint32, %s> actors = %d;\n"), *ActorMessageName, ActorsFieldNumber));
+	}
+	ProtoStateMsg.Append(FString::Printf(TEXT("message %s {\n%s}\n"), *ChannelDataMessageName, *ChannelDataFields));
+	FormatArgs.Add(TEXT("Definition_ProtoStateMsg"), ProtoStateMsg);
 	ChannelDataProtoFile = FString::Format(CodeGen_ProtoTemplate, FormatArgs);
 	return true;
 }
@@ -706,7 +1073,8 @@ bool FReplicatorCodeGenerator::GenerateChannelDataMerge_GoCode(
 	const EChanneldChannelType ChannelType,
 	const FString& ChannelDataMessageName,
 	const FString& ProtoPackageName,
-	FString& GoCode
+	FString& GoCode,
+	FString& BenchmarkGoCode
 )
 {
 	// The first letter of Go proto type name should be upper case.
@@ -715,11 +1083,17 @@ bool FReplicatorCodeGenerator::GenerateChannelDataMerge_GoCode(
 
 	// Generate code: Implement [channeld.MergeableChannelData]
 	FString MergeStateCode = TEXT("");
+	FString MergeStateFuncsCode;
+	FString BenchmarkFillStatesCode;
 	bool bHasMergeStateInMap = false;
+	const FString ActorMsgGoName = ChannelDataProtoMsgGoName + TEXT("Actor");
 	{
 		FStringFormatNamedArguments FormatArgs;
 
 		FString MergeActorStateCode = TEXT("");
+		FString MergeStatesInActorCode;
+		FString DeleteRemovedActorCode;
+		FString BenchmarkSampleStatesInActorCode;
 
 		for (const TSharedPtr<FReplicatedActorDecorator> ActorDecorator : TargetActors)
 		{
@@ -727,7 +1101,64 @@ bool FReplicatorCodeGenerator::GenerateChannelDataMerge_GoCode(
 			FString StateClassName = ActorDecorator->GetProtoStateMessageTypeGo();
 			FormatArgs.Add("Definition_StateClassName", StateClassName);
 
-			if (ActorDecorator->IsSingletonInChannelData())
+			FString DstStateVar = ActorDecorator->IsSingletonInChannelData() ? TEXT("dst.") + StateClassName : TEXT("old") + StateClassName;
+			FString SrcStateVar = ActorDecorator->IsSingletonInChannelData() ? TEXT("srcData.") + StateClassName : TEXT("new") + StateClassName;
+			if (ActorDecorator->IsInActorMessage())
+			{
+				DstStateVar = TEXT("oldActor.") + ActorDecorator->GetDefinition_ChannelDataFieldNameGo();
+				SrcStateVar = TEXT("newActor.") + ActorDecorator->GetDefinition_ChannelDataFieldNameGo();
+			}
+			// The same state type can be in different channel data types, so the function name has the channel data type as well.
+			const FString MergeFuncName = FString::Printf(TEXT("merge%s%s"), *ChannelDataProtoMsgGoName, *StateClassName);
+			const FString MergeFuncCode = ActorDecorator->GetCode_MergeStateFuncGo(MergeFuncName, ProtoPackageName);
+			if (!MergeFuncCode.IsEmpty())
+			{
+				MergeStateFuncsCode.Append(MergeFuncCode);
+				FormatArgs.Add("Code_MergeState", FString::Printf(TEXT("%s(%s, %s)"), *MergeFuncName, *DstStateVar, *SrcStateVar));
+			}
+			else
+			{
+				FormatArgs.Add("Code_MergeState", FString::Printf(TEXT("proto.Merge(%s, %s)"), *DstStateVar, *SrcStateVar));
+			}
+
+			// Only the states in the same package are filled in the benchmark, so it doesn't need to import the others.
+			if (ActorDecorator->GetProtoPackagePathGo(ProtoPackageName).IsEmpty())
+			{
+				const FString SampleStateCode = ActorDecorator->GetCode_SampleStateGo(ProtoPackageName);
+				if (ActorDecorator->IsInActorMessage())
+				{
+					BenchmarkSampleStatesInActorCode.Append(FString::Printf(TEXT("\t\t\t%s: %s,\n"), *ActorDecorator->GetDefinition_ChannelDataFieldNameGo(), *SampleStateCode));
+				}
+				else if (ActorDecorator->IsSingletonInChannelData())
+				{
+					BenchmarkFillStatesCode.Append(FString::Printf(TEXT("\tsrc.%s = %s\n"), *StateClassName, *SampleStateCode));
+				}
+				else
+				{
+					BenchmarkFillStatesCode.Append(FString::Format(CodeGen_Go_MergeBenchmarkFillMapTemplate, FStringFormatNamedArguments{
+						{TEXT("Definition_StateMapName"), ActorDecorator->GetDefinition_ChannelDataFieldNameGo()},
+						{TEXT("Definition_StateClassName"), StateClassName},
+						{TEXT("Code_SampleState"), SampleStateCode},
+					}));
+				}
+			}
+
+			if (ActorDecorator->IsInActorMessage())
+			{
+				FormatArgs.Add("Definition_StateVarName", ActorDecorator->GetDefinition_ChannelDataFieldNameGo());
+				if (ActorDecorator->GetTargetClass() == AActor::StaticClass())
+				{
+					// The removed actor is deleted as a whole before its states are merged.
+					DeleteRemovedActorCode = FString::Format(CodeGen_Go_DeleteRemovedActorTemplate, FormatArgs);
+					MergeStatesInActorCode.Append(FString::Format(CodeGen_Go_MergeStateInActorTemplate, FormatArgs));
+				}
+				else
+				{
+					MergeStatesInActorCode.Append(FString::Format(ActorDecorator->GetTargetClass()->IsChildOf<UActorComponent>() ?
+						CodeGen_Go_MergeCompStateInActorTemplate : CodeGen_Go_MergeStateInActorTemplate, FormatArgs));
+				}
+			}
+			else if (ActorDecorator->IsSingletonInChannelData())
 			{
 				FormatArgs.Add("Definition_StateVarName", StateClassName);
 				bHasMergeStateInMap = true;
@@ -774,6 +1205,23 @@ bool FReplicatorCodeGenerator::GenerateChannelDataMerge_GoCode(
 		}
 		// Add ActorState's merge code at last
 		MergeStateCode.Append(MergeActorStateCode);
+
+		if (!MergeStatesInActorCode.IsEmpty())
+		{
+			bHasMergeStateInMap = true;
+			MergeStateCode.Append(FString::Format(CodeGen_Go_MergeActorsTemplate, FStringFormatNamedArguments{
+				{TEXT("Definition_ActorMsgName"), ActorMsgGoName},
+				{TEXT("Code_DeleteRemovedActor"), DeleteRemovedActorCode},
+				{TEXT("Code_MergeStatesInActor"), MergeStatesInActorCode},
+			}));
+		}
+		if (!BenchmarkSampleStatesInActorCode.IsEmpty())
+		{
+			BenchmarkFillStatesCode.Append(FString::Format(CodeGen_Go_MergeBenchmarkFillActorsTemplate, FStringFormatNamedArguments{
+				{TEXT("Definition_ActorMsgName"), ActorMsgGoName},
+				{TEXT("Code_SampleStates"), BenchmarkSampleStatesInActorCode},
+			}));
+		}
 	}
 	FString CheckHandoverCode = TEXT("");
 	FString NotifyHandoverCode = TEXT("");
@@ -804,6 +1252,10 @@ bool FReplicatorCodeGenerator::GenerateChannelDataMerge_GoCode(
 		FormatArgs.Add("Code_NotifyHandover", NotifyHandoverCode);
 		FormatArgs.Add("Decl_ChannelDataMsgVar", bHasMergeStateInMap ? TEXT("srcData") : TEXT("_"));
 		GoCode.Append(FString::Format(CodeGen_Go_MergeTemplate, FormatArgs));
+		GoCode.Append(MergeStateFuncsCode);
+
+		FormatArgs.Add("Code_FillStates", BenchmarkFillStatesCode);
+		BenchmarkGoCode.Append(FString::Format(CodeGen_Go_MergeBenchmarkTemplate, FormatArgs));
 	}
 
 	// GoCode.Append(TEXT("\treturn nil\n}\n"));
@@ -837,7 +1289,23 @@ bool FReplicatorCodeGenerator::GenerateChannelDataRegistration_GoCode(
 
 void FReplicatorCodeGenerator::ProcessHeaderFiles(const TArray<FString>& Files, const FManifestModule& ManifestModule)
 {
+	if (Files.Num() == 0)
+	{
+		return;
+	}
+
+	// The module part of the info is the same for all the classes in the module.
+	FModuleInfo ModuleInfo;
+	ModuleInfo.Name = ManifestModule.Name;
+	// Normalize path
+	ModuleInfo.BaseDirectory = ManifestModule.BaseDirectory;
+	ModuleInfo.BaseDirectory.ReplaceInline(TEXT("\\"), TEXT("/"), ESearchCase::CaseSensitive);
+	ModuleInfo.IncludeBase = ManifestModule.IncludeBase;
+	ModuleInfo.IncludeBase.ReplaceInline(TEXT("\\"), TEXT("/"), ESearchCase::CaseSensitive);
+	ModuleInfo.bIsBuildInEngine = FPaths::IsUnderDirectory(ModuleInfo.IncludeBase, FPaths::EngineDir());
+
 	FPlatformFileManager& FileManager = FPlatformFileManager::Get();
+	const FRegexPattern MatherPatter(FString(TEXT(R"EOF(UCLASS\(.*\)\s*class\s+(?:\w+_API\s+)?([\w_]+)\s+\:)EOF")));
 	for (const FString& HeaderFilePath : Files)
 	{
 		if (!FileManager.GetPlatformFile().FileExists(*HeaderFilePath))
@@ -847,29 +1315,20 @@ void FReplicatorCodeGenerator::ProcessHeaderFiles(const TArray<FString>& Files,
 		FString Code;
 		// Load source code files, and capture all 'UCLASS' marked classes.
 		FFileHelper::LoadFileToString(Code, *HeaderFilePath);
-		FRegexPattern MatherPatter(FString(TEXT(R"EOF(UCLASS\(.*\)\s*class\s+(?:\w+_API\s+)?([\w_]+)\s+\:)EOF")));
+		if (!Code.Contains(TEXT("UCLASS"), ESearchCase::CaseSensitive))
+		{
+			continue;
+		}
+		FString RelativeToModule = HeaderFilePath;
+		RelativeToModule.ReplaceInline(TEXT("\\"), TEXT("/"), ESearchCase::CaseSensitive);
+		RelativeToModule = RelativeToModule.Replace(*ModuleInfo.IncludeBase, TEXT(""), ESearchCase::CaseSensitive);
 		FRegexMatcher Matcher(MatherPatter, Code);
 		while (Matcher.FindNext())
 		{
-			FString CapturedCppClassName = Matcher.GetCaptureGroup(1);
-
-			FModuleInfo ModuleInfo;
-			ModuleInfo.Name = ManifestModule.Name;
-			// Normalize path
-			ModuleInfo.BaseDirectory = ManifestModule.BaseDirectory;
-			ModuleInfo.BaseDirectory.ReplaceInline(TEXT("\\"), TEXT("/"), ESearchCase::CaseSensitive);
-			ModuleInfo.IncludeBase = ManifestModule.IncludeBase;
-			ModuleInfo.IncludeBase.ReplaceInline(TEXT("\\"), TEXT("/"), ESearchCase::CaseSensitive);
-			FString RelativeToModule = HeaderFilePath;
-			RelativeToModule.ReplaceInline(TEXT("\\"), TEXT("/"), ESearchCase::CaseSensitive);
-			RelativeToModule = RelativeToModule.Replace(*ModuleInfo.IncludeBase, TEXT(""), ESearchCase::CaseSensitive);
-			ModuleInfo.RelativeToModule = RelativeToModule;
-			ModuleInfo.bIsBuildInEngine = FPaths::IsUnderDirectory(ModuleInfo.IncludeBase, FPaths::EngineDir());
-			ModuleInfoByClassName.Add(CapturedCppClassName, ModuleInfo);
-			FCPPClassInfo CPPClassInfo;
+			FCPPClassInfo& CPPClassInfo = CPPClassInfoMap.Add(Matcher.GetCaptureGroup(1));
 			CPPClassInfo.ModuleInfo = ModuleInfo;
+			CPPClassInfo.ModuleInfo.RelativeToModule = RelativeToModule;
 			CPPClassInfo.HeadFilePath = HeaderFilePath;
-			CPPClassInfoMap.Add(CapturedCppClassName, CPPClassInfo);
 		}
 	}
 }
@@ -926,7 +1385,8 @@ bool FReplicatorCodeGenerator::CreateDecorateActor(
 	);
 	// If the target class is c++ class, we need to find the module it belongs to.
 	// The module info is used to generate the include code in head file.
-	if (!ActorDecorator->IsBlueprintType() && !ModuleInfoByClassName.Contains(ActorDecorator->GetActorCPPClassName()))
+	const FModuleInfo* ModuleInfo = ActorDecorator->IsBlueprintType() ? nullptr : GetModuleInfo(ActorDecorator->GetActorCPPClassName());
+	if (!ActorDecorator->IsBlueprintType() && ModuleInfo == nullptr)
 	{
 		OutResultMessage = FString::Printf(TEXT("Can not find the module which the class '%s' belongs to"), *ActorDecorator->GetActorCPPClassName());
 		delete ActorDecorator;
@@ -936,7 +1396,7 @@ bool FReplicatorCodeGenerator::CreateDecorateActor(
 	}
 	if (!ActorDecorator->IsBlueprintType())
 	{
-		ActorDecorator->SetModuleInfo(ModuleInfoByClassName.FindChecked(ActorDecorator->GetActorCPPClassName()));
+		ActorDecorator->SetModuleInfo(*ModuleInfo);
 	}
 	if (bInitPropertiesAndRPCs)
 	{
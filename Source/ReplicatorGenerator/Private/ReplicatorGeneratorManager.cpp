@@ -1,12 +1,15 @@
 ﻿#include "ReplicatorGeneratorManager.h"
 
 #include "ReplicatorGeneratorUtils.h"
+#include "ChanneldMetrics.h"
+#include "ChanneldNativeRPCFallbacks.h"
 #include "Engine/AssetManager.h"
 #include "Engine/SCS_Node.h"
 #include "GameFramework/Character.h"
 #include "HAL/FileManagerGeneric.h"
 #include "Internationalization/Regex.h"
 #include "Misc/FileHelper.h"
+#include "Misc/SecureHash.h"
 #include "Persistence/ChannelDataSchemaController.h"
 
 DEFINE_LOG_CATEGORY(LogChanneldRepGenerator);
@@ -83,8 +86,59 @@ bool FReplicatorGeneratorManager::GenerateReplication(const FString GoPackageImp
 		ChannelDataInfos.Add(ChannelDataSchema);
 	}
 
+	FGeneratedManifest LastManifest;
+	LastCodeFileHashes.Reset();
+	if (LoadLatestGeneratedManifest(LastManifest))
+	{
+		LastCodeFileHashes = MoveTemp(LastManifest.CodeFileHashes);
+		// Use -ResetChannelDataFieldNumbers to renumber all the states by the update frequency, which breaks the compatibility with the old builds.
+		if (!FParse::Param(FCommandLine::Get(), TEXT("ResetChannelDataFieldNumbers")))
+		{
+			for (FChannelDataInfo& ChannelDataInfo : ChannelDataInfos)
+			{
+				if (FChannelDataFieldNumbers* LastFieldNumbers = LastManifest.ChannelDataFieldNumbers.Find(ChannelDataInfo.Schema.ChannelType))
+				{
+					ChannelDataInfo.LastFieldNumbers = MoveTemp(LastFieldNumbers->FieldNumbers);
+				}
+			}
+		}
+	}
+
+	// The functions that failed to serialize because their classes have no replicator. Generate the replicators of the classes, so the RPCs
+	// stay off the native path, even if the classes have no state in the channel data.
+	TSet<FString> NativeRPCFallbackClasses(LastManifest.NativeRPCFallbackClasses);
+	for (const FChanneldNativeRPCFallbackReport& Report : FChanneldNativeRPCFallbackReport::LoadAll())
+	{
+		for (const FChanneldNativeRPCFallback& Function : Report.Functions)
+		{
+			if (Function.Reason == LexToString(RPCDropReason_SerializeFailed))
+			{
+				NativeRPCFallbackClasses.Add(Function.ClassPath);
+			}
+			else if (Function.Reason == LexToString(RPCDropReason_NoRepComp))
+			{
+				UE_LOG(LogChanneldRepGenerator, Warning, TEXT("RPC %s::%s fell back to the native path, as the actor has no ChanneldReplicationComponent."), *Function.ClassPath, *Function.FuncName);
+			}
+		}
+	}
+	TArray<FString> SortedNativeRPCFallbackClasses = NativeRPCFallbackClasses.Array();
+	SortedNativeRPCFallbackClasses.Sort();
+	TArray<const UClass*> RPCOnlyClasses;
+	for (const FString& ClassPath : SortedNativeRPCFallbackClasses)
+	{
+		const UClass* TargetClass = LoadClass<UObject>(nullptr, *ClassPath, nullptr, LOAD_None, nullptr);
+		if (TargetClass && ChanneldReplicatorGeneratorUtils::TargetToGenerateReplicator(TargetClass))
+		{
+			RPCOnlyClasses.Add(TargetClass);
+		}
+		else
+		{
+			UE_LOG(LogChanneldRepGenerator, Warning, TEXT("Unable to generate the replicator for the native RPC fallbacks of class [%s]"), *ClassPath);
+		}
+	}
+
 	// We need to include the header file of the target class in 'ChanneldReplicatorRegister.h'. so we need to know the include path of the target class from 'uhtmanifest' file.
-	// But the 'uhtmanifest' file is a large json file, so we need to read and parser it only once.
+	// But the 'uhtmanifest' file is a large json file, so the class-to-header index built from it is cached, and only rebuilt when the 'uhtmanifest' changes.
 	CodeGenerator->RefreshModuleInfoByClassName();
 
 	FGeneratedCodeBundle ReplicatorCodeBundle;
@@ -92,6 +146,7 @@ bool FReplicatorGeneratorManager::GenerateReplication(const FString GoPackageImp
 	const FString GoPackageImportPath = GoPackageImportPathPrefix / ProtoPackageName;
 	CodeGenerator->Generate(
 		ChannelDataInfos
+		, RPCOnlyClasses
 		, ProtoPackageName
 		, CompatibleRecompilation ? ChanneldReplicatorGeneratorUtils::GetHashString(FDateTime::Now().ToString()) : TEXT("")
 		, GoPackageImportPath
@@ -99,16 +154,25 @@ bool FReplicatorGeneratorManager::GenerateReplication(const FString GoPackageImp
 	);
 	FString Message;
 
+	CodeFileHashes.Reset();
+	NumUnchangedFiles = 0;
+
 	// Generate type definitions file
-	WriteCodeFile(GetReplicatorStorageDir() / GenManager_TypeDefinitionHeadFile, ReplicatorCodeBundle.TypeDefinitionsHeadCode, Message);
-	WriteCodeFile(GetReplicatorStorageDir() / GenManager_TypeDefinitionCppFile, ReplicatorCodeBundle.TypeDefinitionsCppCode, Message);
+	WriteCodeFileIfChanged(GenManager_TypeDefinitionHeadFile, ReplicatorCodeBundle.TypeDefinitionsHeadCode);
+	WriteCodeFileIfChanged(GenManager_TypeDefinitionCppFile, ReplicatorCodeBundle.TypeDefinitionsCppCode);
 
 	// Generate replicator code file
+	TMap<FString, FReplicationCostEstimate> ReplicationCostEstimates;
 	for (FReplicatorCode& ReplicatorCode : ReplicatorCodeBundle.ReplicatorCodes)
 	{
-		WriteCodeFile(GetReplicatorStorageDir() / ReplicatorCode.HeadFileName, ReplicatorCode.HeadCode, Message);
-		WriteCodeFile(GetReplicatorStorageDir() / ReplicatorCode.CppFileName, ReplicatorCode.CppCode, Message);
-		WriteProtoFile(GetReplicatorStorageDir() / ReplicatorCode.ProtoFileName, ReplicatorCode.ProtoDefinitionsFile, Message);
+		FReplicationCostEstimate& CostEstimate = ReplicationCostEstimates.Add(ReplicatorCode.ActorDecorator->GetActorPathName());
+		ReplicatorCode.ActorDecorator->EstimateStateSize(CostEstimate.TypicalStateBytes, CostEstimate.WorstCaseStateBytes);
+		CostEstimate.NetUpdateFrequency = ReplicatorCode.ActorDecorator->GetNetUpdateFrequency();
+		CostEstimate.UpdateBytesPerSecond();
+
+		WriteCodeFileIfChanged(ReplicatorCode.HeadFileName, ReplicatorCode.HeadCode);
+		WriteCodeFileIfChanged(ReplicatorCode.CppFileName, ReplicatorCode.CppCode);
+		WriteCodeFileIfChanged(ReplicatorCode.ProtoFileName, ReplicatorCode.ProtoDefinitionsFile);
 		UE_LOG(
 			LogChanneldRepGenerator,
 			Verbose,
@@ -122,23 +186,34 @@ bool FReplicatorGeneratorManager::GenerateReplication(const FString GoPackageImp
 	}
 
 	// Generate replicator registration code file
-	WriteCodeFile(GetReplicatorStorageDir() / GenManager_RepRegistrationHeadFile, ReplicatorCodeBundle.ReplicatorRegistrationHeadCode, Message);
+	WriteCodeFileIfChanged(GenManager_RepRegistrationHeadFile, ReplicatorCodeBundle.ReplicatorRegistrationHeadCode);
 
 	// Generate global struct declarations file and proto definitions file
-	WriteCodeFile(GetReplicatorStorageDir() / GenManager_GlobalStructHeaderFile, ReplicatorCodeBundle.GlobalStructCodes, Message);
-	WriteProtoFile(GetReplicatorStorageDir() / GenManager_GlobalStructProtoFile, ReplicatorCodeBundle.GlobalStructProtoDefinitions, Message);
+	WriteCodeFileIfChanged(GenManager_GlobalStructHeaderFile, ReplicatorCodeBundle.GlobalStructCodes);
+	WriteCodeFileIfChanged(GenManager_GlobalStructProtoFile, ReplicatorCodeBundle.GlobalStructProtoDefinitions);
 
 	TMap<EChanneldChannelType, FString> ChannelTypeToChannelDataMsgMap;
-	for (const FChannelDataCode& ChannelDataCode : ReplicatorCodeBundle.ChannelDataCodes)
+	TMap<EChanneldChannelType, FChannelDataFieldNumbers> ChannelDataFieldNumbers;
+	for (FChannelDataCode& ChannelDataCode : ReplicatorCodeBundle.ChannelDataCodes)
 	{
 		ChannelTypeToChannelDataMsgMap.Add(ChannelDataCode.ChannelType, ChannelDataCode.ChannelDataMsgName);
-		WriteCodeFile(GetReplicatorStorageDir() / ChannelDataCode.ProcessorHeadFileName, ChannelDataCode.ProcessorHeadCode, Message);
-		WriteProtoFile(GetReplicatorStorageDir() / ChannelDataCode.ProtoFileName, ChannelDataCode.ProtoDefsFile, Message);
+		ChannelDataFieldNumbers.Add(ChannelDataCode.ChannelType).FieldNumbers = MoveTemp(ChannelDataCode.FieldNumbers);
+		WriteCodeFileIfChanged(ChannelDataCode.ProcessorHeadFileName, ChannelDataCode.ProcessorHeadCode);
+		WriteCodeFileIfChanged(ChannelDataCode.ProtoFileName, ChannelDataCode.ProtoDefsFile);
 	}
+
+	RemoveStaleGeneratedFiles();
+	UE_LOG(LogChanneldRepGenerator, Log, TEXT("Generated %d code files, %d of them are unchanged and skipped"), CodeFileHashes.Num(), NumUnchangedFiles);
+
 	// Generate channel data golang merge code temporary file.
 	ChanneldReplicatorGeneratorUtils::EnsureRepGenIntermediateDir();
 	WriteCodeFile(GenManager_TemporaryGoMergeCodePath, ReplicatorCodeBundle.ChannelDataMerge_GoCode, Message);
 	WriteCodeFile(GenManager_TemporaryGoRegistrationCodePath, ReplicatorCodeBundle.ChannelDataRegistration_GoCode, Message);
+	const bool bHasMergeBenchmark = !ReplicatorCodeBundle.ChannelDataMergeBenchmark_GoCode.IsEmpty();
+	if (bHasMergeBenchmark)
+	{
+		WriteCodeFile(GenManager_TemporaryGoMergeBenchmarkCodePath, ReplicatorCodeBundle.ChannelDataMergeBenchmark_GoCode, Message);
+	}
 
 	// Save the generated manifest file
 	FGeneratedManifest Manifest(
@@ -148,6 +223,11 @@ bool FReplicatorGeneratorManager::GenerateReplication(const FString GoPackageImp
 		, GenManager_TemporaryGoRegistrationCodePath
 		, ChannelTypeToChannelDataMsgMap
 	);
+	Manifest.CodeFileHashes = MoveTemp(CodeFileHashes);
+	Manifest.ReplicationCostEstimates = MoveTemp(ReplicationCostEstimates);
+	Manifest.ChannelDataFieldNumbers = MoveTemp(ChannelDataFieldNumbers);
+	Manifest.NativeRPCFallbackClasses = MoveTemp(SortedNativeRPCFallbackClasses);
+	Manifest.TemporaryGoMergeBenchmarkCodePath = bHasMergeBenchmark ? GenManager_TemporaryGoMergeBenchmarkCodePath : FString();
 
 	if (!SaveGeneratedManifest(Manifest))
 	{
@@ -170,6 +250,52 @@ inline bool FReplicatorGeneratorManager::WriteProtoFile(const FString& FilePath,
 	return WriteCodeFile(FilePath, ProtoContent, ResultMessage);
 }
 
+bool FReplicatorGeneratorManager::WriteCodeFileIfChanged(const FString& FileName, const FString& Code)
+{
+	FMD5 Md5;
+	Md5.Update(reinterpret_cast<const uint8*>(*Code), Code.Len() * sizeof(TCHAR));
+	uint8 Digest[16];
+	Md5.Final(Digest);
+	const FString Hash = BytesToHex(Digest, 16);
+	CodeFileHashes.Add(FileName, Hash);
+
+	// Compare with the hash of the last generation rather than the file content, as the written files may be formatted by clang-format.
+	const FString FilePath = GetReplicatorStorageDir() / FileName;
+	const FString* LastHash = LastCodeFileHashes.Find(FileName);
+	if (LastHash && *LastHash == Hash && IFileManager::Get().FileExists(*FilePath))
+	{
+		NumUnchangedFiles++;
+		return true;
+	}
+
+	FString Message;
+	return WriteCodeFile(FilePath, Code, Message);
+}
+
+void FReplicatorGeneratorManager::RemoveStaleGeneratedFiles()
+{
+	TArray<FString> AllFiles;
+	IFileManager::Get().FindFiles(AllFiles, *GetReplicatorStorageDir());
+	for (const FString& FileName : AllFiles)
+	{
+		if (CodeFileHashes.Contains(FileName))
+		{
+			continue;
+		}
+		// Keep the protoc outputs (.pb.h, .pb.cpp) of the generated proto files.
+		FString ProtoFileName = FileName;
+		if (ProtoFileName.RemoveFromEnd(CodeGen_ProtoPbHeadExtension) || ProtoFileName.RemoveFromEnd(CodeGen_ProtoPbCPPExtension) || ProtoFileName.RemoveFromEnd(TEXT(".pb.cc")))
+		{
+			if (CodeFileHashes.Contains(ProtoFileName + CodeGen_ProtoFileExtension))
+			{
+				continue;
+			}
+		}
+		UE_LOG(LogChanneldRepGenerator, Verbose, TEXT("Removing the stale generated file: %s"), *FileName);
+		IFileManager::Get().Delete(*(GetReplicatorStorageDir() / FileName));
+	}
+}
+
 TArray<FString> FReplicatorGeneratorManager::GetGeneratedTargetClasses()
 {
 	TArray<FString> HeadFiles;
@@ -196,6 +322,23 @@ TArray<FString> FReplicatorGeneratorManager::GetGeneratedProtoFiles()
 	return AllCodeFiles;
 }
 
+TArray<FString> FReplicatorGeneratorManager::GetOutdatedProtoFiles()
+{
+	IFileManager& FileManager = IFileManager::Get();
+	TArray<FString> Result;
+	for (const FString& ProtoFile : GetGeneratedProtoFiles())
+	{
+		const FString ProtoFilePath = GetReplicatorStorageDir() / ProtoFile;
+		const FDateTime PbHeadTime = FileManager.GetTimeStamp(*FPaths::ChangeExtension(ProtoFilePath, CodeGen_ProtoPbHeadExtension));
+		// GetTimeStamp() returns FDateTime::MinValue() if the file doesn't exist.
+		if (PbHeadTime < FileManager.GetTimeStamp(*ProtoFilePath))
+		{
+			Result.Add(ProtoFile);
+		}
+	}
+	return Result;
+}
+
 void FReplicatorGeneratorManager::RemoveGeneratedReplicator(const FString& ClassName)
 {
 	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
@@ -240,6 +383,31 @@ bool FReplicatorGeneratorManager::LoadLatestGeneratedManifest(FGeneratedManifest
 	return GeneratedManifestModel.GetData(Result, true);
 }
 
+bool FReplicatorGeneratorManager::GetReplicationCostEstimate(const UClass* TargetClass, FReplicationCostEstimate& OutEstimate)
+{
+	OutEstimate = FReplicationCostEstimate();
+	FGeneratedManifest Manifest;
+	if (TargetClass == nullptr || !GeneratedManifestModel.GetData(Manifest))
+	{
+		return false;
+	}
+
+	bool bFound = false;
+	for (const UClass* Class = TargetClass; Class != nullptr; Class = Class->GetSuperClass())
+	{
+		if (const FReplicationCostEstimate* CostEstimate = Manifest.ReplicationCostEstimates.Find(Class->GetPathName()))
+		{
+			OutEstimate.TypicalStateBytes += CostEstimate->TypicalStateBytes;
+			OutEstimate.WorstCaseStateBytes += CostEstimate->WorstCaseStateBytes;
+			bFound = true;
+		}
+	}
+	const AActor* ActorCDO = Cast<AActor>(TargetClass->GetDefaultObject());
+	OutEstimate.NetUpdateFrequency = ActorCDO ? ActorCDO->NetUpdateFrequency : 0.f;
+	OutEstimate.UpdateBytesPerSecond();
+	return bFound;
+}
+
 bool FReplicatorGeneratorManager::SaveGeneratedManifest(const FGeneratedManifest& Manifest)
 {
 	ChanneldReplicatorGeneratorUtils::EnsureRepGenIntermediateDir();
@@ -52,7 +52,19 @@ namespace ChanneldReplicatorGeneratorUtils
 
 	bool IsChanneldUEBuiltinClass(const UClass* TargetClass)
 	{
-		return ChanneldUEBuiltinClassSet.Contains(TargetClass);
+		return ChanneldUEBuiltinClassSet.Contains(TargetClass) || IsAbilitySystemComponentClass(TargetClass);
+	}
+
+	bool IsAbilitySystemComponentClass(const UClass* TargetClass)
+	{
+		return TargetClass && TargetClass->GetPathName() == TEXT("/Script/GameplayAbilities.AbilitySystemComponent");
+	}
+
+	bool IsInUnrealComponentsProto(const UClass* TargetClass)
+	{
+		return TargetClass == USkeletalMeshComponent::StaticClass()
+			|| TargetClass == UProjectileMovementComponent::StaticClass()
+			|| IsAbilitySystemComponentClass(TargetClass);
 	}
 
 	bool IsChanneldUEBuiltinSingletonClass(const UClass* TargetClass)
@@ -218,7 +230,8 @@ namespace ChanneldReplicatorGeneratorUtils
 			(TargetClass->IsChildOf(AActor::StaticClass()) || TargetClass->IsChildOf(UActorComponent::StaticClass())) &&
 			!TargetClass->IsChildOf(ALevelScriptActor::StaticClass()) &&
 			!(ClassName.StartsWith(TEXT("SKEL_")) || ClassName.StartsWith(TEXT("REINST_"))) &&
-			HasReplicatedPropertyOrRPC(TargetClass);
+			// The builtin replicators of unreal_components.proto replicate the states that are not the replicated properties (e.g. the montage).
+			(HasReplicatedPropertyOrRPC(TargetClass) || IsInUnrealComponentsProto(TargetClass));
 	}
 
 	bool ContainsUncompilableChar(const FString& Test)
@@ -52,9 +52,28 @@ private:
 	TWeakPtr<SNotificationItem> FilterRepActorNotiPtr;
 
 
-	void ApplyChangesToBP(AActor* ActorContex);
-
-	void AddCompToActorBPInternal(bool ShowDialog = false);
+	void ApplyChangesToBP(AActor* ActorContex, bool bNotify = true);
+
+	// The Blueprints in the result of the commandlet are loaded asynchronously and modified in time slices, so the editor keeps responsive.
+	void StartAddingComp();
+	void TickAddingComp();
+	void RequestBPLoads();
+	void OnBPPackageLoaded(const FString& BPPath, int32 RunId);
+	// Returns true if the component is added to the Blueprint.
+	bool AddCompToBP(const FString& BPPath);
+	void FinishAddingComp(bool ShowDialog);
+	void UpdateAddingCompNotification();
+
+	// Increased by each run, so the package loads of a canceled run are ignored.
+	int32 AddingCompRunId = 0;
+	// Not requested to load yet
+	TArray<FString> PendingBPPaths;
+	// Loaded and waiting to be modified
+	TArray<FString> LoadedBPPaths;
+	int32 NumLoadingBPs = 0;
+	int32 NumTotalBPs = 0;
+	int32 NumProcessedBPs = 0;
+	TArray<FString> ModifiedBPPaths;
 
 	void SpawnRunningFilterRepActorNotification();
 
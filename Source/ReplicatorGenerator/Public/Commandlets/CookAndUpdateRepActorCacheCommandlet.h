@@ -21,6 +21,8 @@ public:
 
 	TSet<FString> CheckedClasses;
 	TSet<FSoftClassPath> FilteredClasses;
+	// The package names of the maps loaded by the cook.
+	TSet<FString> LoadedMapPackages;
 };
 
 UCLASS()
@@ -32,4 +34,10 @@ public:
 	UCookAndUpdateRepActorCacheCommandlet();
 
 	virtual int32 Main(const FString& CmdLineParams) override;
+
+	// Save the replicated classes in the binary format that the servers can memory-map at runtime. See FChanneldRepClassTable.
+	static bool SaveRepClassTable(const TArray<const UClass*>& TargetClasses);
+
+	// Precompute the NetIds of the static actors of the map for the spatial servers. See FChanneldStaticActorTable.
+	static bool SaveStaticActorTable(const FString& MapPackageName);
 };
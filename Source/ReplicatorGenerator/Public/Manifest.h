@@ -21,6 +21,17 @@ struct FModuleInfo
 	}
 
 	bool bIsBuildInEngine;
+
+	friend FArchive& operator<<(FArchive& Ar, FModuleInfo& ModuleInfo)
+	{
+		Ar << ModuleInfo.Name;
+		Ar << ModuleInfo.BaseDirectory;
+		Ar << ModuleInfo.IncludeBase;
+		Ar << ModuleInfo.RelativeToModule;
+		Ar << ModuleInfo.bIsBuildInEngine;
+
+		return Ar;
+	}
 };
 
 struct FManifestModule
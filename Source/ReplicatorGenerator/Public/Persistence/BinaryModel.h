@@ -0,0 +1,130 @@
+﻿#pragma once
+
+#include "ReplicatorGeneratorDefinition.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/BufferArchive.h"
+#include "Serialization/MemoryReader.h"
+
+/**
+ * The same as TJsonModel, but the data is saved in a compact binary format by the operator<< of the struct, which is much faster to load.
+ * The file starts with a magic number and OutStructType::BinaryVersion. The file of another version is treated as non-existing.
+ */
+template <typename OutStructType>
+class TBinaryModel
+{
+protected:
+	static constexpr uint32 Magic = 0x43484E44; // "CHND"
+
+	FString DataFilePath;
+
+	FDateTime LastLoadTime;
+	bool bLastLoadExisting = true;
+
+	OutStructType Data;
+
+public:
+	TBinaryModel() = default;
+
+	TBinaryModel(const FString& InDataFilePath)
+	{
+		SetDataFilePath(InDataFilePath);
+	}
+
+	virtual ~TBinaryModel() = default;
+
+	virtual void SetDataFilePath(const FString& InDataFilePath)
+	{
+		DataFilePath = InDataFilePath;
+		FPaths::NormalizeFilename(DataFilePath);
+	}
+
+	virtual bool IsExist() const
+	{
+		return FPaths::FileExists(DataFilePath);
+	}
+
+	virtual bool GetData(OutStructType& OutData, bool ForceLoad = false)
+	{
+		OutData = OutStructType();
+		if (ForceLoad || IsNewer())
+		{
+			if (!LoadData())
+			{
+				return false;
+			}
+		}
+		OutData = Data;
+		return true;
+	}
+
+	virtual bool LoadData()
+	{
+		Data = OutStructType();
+		bLastLoadExisting = false;
+		LastLoadTime = FDateTime::UtcNow();
+		if (!IsExist())
+		{
+			return true;
+		}
+
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *DataFilePath))
+		{
+			UE_LOG(LogChanneldRepGenerator, Error, TEXT("Failed to load data from file: %s"), *DataFilePath);
+			return false;
+		}
+		FMemoryReader Reader(Bytes);
+		uint32 FileMagic = 0, FileVersion = 0;
+		Reader << FileMagic;
+		Reader << FileVersion;
+		if (FileMagic != Magic || FileVersion != OutStructType::BinaryVersion)
+		{
+			UE_LOG(LogChanneldRepGenerator, Log, TEXT("Ignored the data file of version %u (expected %u): %s"), FileVersion, OutStructType::BinaryVersion, *DataFilePath);
+			return true;
+		}
+		Reader << Data;
+		if (Reader.IsError())
+		{
+			UE_LOG(LogChanneldRepGenerator, Error, TEXT("Failed to parse data from file: %s"), *DataFilePath);
+			Data = OutStructType();
+			return false;
+		}
+		bLastLoadExisting = true;
+		return true;
+	}
+
+	virtual bool SaveData(const OutStructType& InData)
+	{
+		FBufferArchive Writer;
+		uint32 FileMagic = Magic, FileVersion = OutStructType::BinaryVersion;
+		Writer << FileMagic;
+		Writer << FileVersion;
+		Writer << const_cast<OutStructType&>(InData);
+		if (!FFileHelper::SaveArrayToFile(Writer, *DataFilePath))
+		{
+			UE_LOG(LogChanneldRepGenerator, Error, TEXT("Failed to save data to file: %s"), *DataFilePath);
+			return false;
+		}
+		return true;
+	}
+
+	virtual FDateTime LastUpdatedTime() const
+	{
+		return IFileManager::Get().GetTimeStamp(*DataFilePath);
+	}
+
+	virtual bool IsNewer() const
+	{
+		if (bLastLoadExisting && !IsExist())
+		{
+			return true;
+		}
+		return LastUpdatedTime() > LastLoadTime;
+	}
+
+	// Whether the last loaded file exists and is of the current version.
+	bool IsLoadedDataValid() const
+	{
+		return bLastLoadExisting;
+	}
+};
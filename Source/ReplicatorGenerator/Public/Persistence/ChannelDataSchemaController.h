@@ -23,6 +23,11 @@ struct REPLICATORGENERATOR_API FChannelDataStateSchema
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	bool bSingleton = false;
 
+	// The expected updates per second of the state. The most frequently updated states get the field numbers 1-15 (1-byte tags)
+	// in the channel data message. 0 means the NetUpdateFrequency of the class, or of AActor for the components.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	float UpdateFrequency = 0.f;
+
 	FChannelDataStateSchema() = default;
 
 	FChannelDataStateSchema(const FString& InReplicationClassPath, int32 InStateOrder)
@@ -51,6 +56,11 @@ struct REPLICATORGENERATOR_API FChannelDataSchema
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	int32 ChannelTypeOrder = 0;
 
+	// If true, the states of an actor are the fields of one message in the map `actors`, instead of each state in a map of its own.
+	// The NetGUID is sent once per actor rather than once per state. Not applied to the entity channel data, which has only one actor.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	bool bActorCentric = false;
+
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	TArray<FChannelDataStateSchema> StateSchemata;
 
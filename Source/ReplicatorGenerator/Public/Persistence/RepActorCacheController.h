@@ -3,7 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "JsonModel.h"
+#include "BinaryModel.h"
 #include "ReplicatorGeneratorDefinition.h"
 #include "GameFramework/GameStateBase.h"
 #include "GameFramework/WorldSettings.h"
@@ -50,6 +50,44 @@ struct REPLICATORGENERATOR_API FRepActorRelationCache
 			bIsChildOfWorldSetting = true;
 		}
 	}
+
+	friend FArchive& operator<<(FArchive& Ar, FRepActorRelationCache& RelationCache)
+	{
+		Ar << RelationCache.TargetClassPath;
+		Ar << RelationCache.bIsComponent;
+		Ar << RelationCache.bIsChildOfGameState;
+		Ar << RelationCache.bIsChildOfWorldSetting;
+		Ar << RelationCache.ParentClassPath;
+		Ar << RelationCache.ComponentClassPaths;
+		return Ar;
+	}
+};
+
+/**
+ * The scan result of an asset under the project content directory, keyed by the package name in FRepActorCache::AssetCaches.
+ * The native packages (/Script/...) only have the ClassPaths.
+ */
+struct FRepActorAssetCache
+{
+	FDateTime FileTime;
+	int64 FileSize = 0;
+	// The hash of the asset file. Only recomputed when the time or the size of the file changes.
+	uint64 FileHash = 0;
+	// The hash of the FileHash and the DependencyHash of the project assets it hard references, e.g. the parent Blueprint.
+	// The asset needs to be scanned again when it changes.
+	uint64 DependencyHash = 0;
+	// The replicated classes in the package found by the last scan.
+	TArray<FString> ClassPaths;
+
+	friend FArchive& operator<<(FArchive& Ar, FRepActorAssetCache& AssetCache)
+	{
+		Ar << AssetCache.FileTime;
+		Ar << AssetCache.FileSize;
+		Ar << AssetCache.FileHash;
+		Ar << AssetCache.DependencyHash;
+		Ar << AssetCache.ClassPaths;
+		return Ar;
+	}
 };
 
 USTRUCT(BlueprintType)
@@ -63,6 +101,11 @@ struct REPLICATORGENERATOR_API FRepActorCache
 	UPROPERTY(BlueprintReadOnly, EditAnywhere)
 	TArray<FRepActorRelationCache> RepActorRelationCaches;
 
+	TMap<FString, FRepActorAssetCache> AssetCaches;
+
+	// The version of the binary cache file. Increase it when the serialized layout changes.
+	static constexpr uint32 BinaryVersion = 1;
+
 	FRepActorCache() = default;
 
 	FRepActorCache(const TArray<FRepActorRelationCache>& InRepActorRelationCaches)
@@ -70,6 +113,14 @@ struct REPLICATORGENERATOR_API FRepActorCache
 	{
 		CacheTime = FDateTime::UtcNow();
 	}
+
+	friend FArchive& operator<<(FArchive& Ar, FRepActorCache& RepActorCache)
+	{
+		Ar << RepActorCache.CacheTime;
+		Ar << RepActorCache.RepActorRelationCaches;
+		Ar << RepActorCache.AssetCaches;
+		return Ar;
+	}
 };
 
 struct FRepActorDependency
@@ -105,16 +156,29 @@ protected:
 	FDateTime LatestRepActorCacheTime;
 	TArray<FRepActorRelationCache> RepActorRelationCaches;
 	TMap<FString, TSharedRef<FRepActorDependency>> RepActorDependencyMap;
+	TMap<FString, FRepActorAssetCache> AssetCaches;
 
-	TJsonModel<FRepActorCache> RepActorCacheModel = GenManager_RepActorCachePath;
-	TJsonModel<FRepActorCache> DefaultRepActorCacheModel = GenManager_DefaultRepActorCachePath;
+	TBinaryModel<FRepActorCache> RepActorCacheModel = GenManager_RepActorCachePath;
+	TBinaryModel<FRepActorCache> DefaultRepActorCacheModel = GenManager_DefaultRepActorCachePath;
 
 public:
 	static FRepActorCache ConvertClassesToRepActorCache(const TArray<const UClass*>& InRepActorClasses);
 
+	/**
+	 * Lists the assets under the project content directory, and hashes the asset files.
+	 * The FileHash in LastAssetCaches is reused if the time and the size of the file don't change.
+	 */
+	static void ScanProjectAssets(const TMap<FString, FRepActorAssetCache>& LastAssetCaches, TMap<FString, FRepActorAssetCache>& OutAssetCaches);
+
+	// Computes the DependencyHash of the assets by the hard package dependencies in the AssetRegistry.
+	static void UpdateDependencyHashes(TMap<FString, FRepActorAssetCache>& InOutAssetCaches);
+
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 
-	bool SaveRepActorCache(const TArray<const UClass*>& InRepActorClasses);
+	bool SaveRepActorCache(const TArray<const UClass*>& InRepActorClasses, const TMap<FString, FRepActorAssetCache>& InAssetCaches);
+
+	// The assets of the last scan. Empty if there's no cache, or the cache is of an older version.
+	const TMap<FString, FRepActorAssetCache>& GetAssetCaches();
 
 	UFUNCTION(BlueprintCallable)
 	bool NeedToRefreshCache();
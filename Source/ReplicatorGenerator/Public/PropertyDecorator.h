@@ -1,46 +1,52 @@
 ﻿#pragma once
 
 #include "IPropertyDecoratorOwner.h"
+#include "UObject/CoreNetTypes.h"
 
 
 const static TCHAR* PropDecorator_AssignPropPtrStatic =
 	LR"EOF(
 {Ref_AssignTo} = ({Declare_PropertyCPPType}*)((uint8*){Ref_ContainerAddr} + {Num_PropMemOffset}))EOF";
 
-const static TCHAR* PropDecorator_AssignPropPtrDynamic =
-		LR"EOF(
-FString PropertyName = TEXT("{Declare_PropertyName}");
-int32* OffsetPtr = PropPointerMemOffsetCache.Find(PropertyName);
-if (OffsetPtr != nullptr)
-{
-    {Ref_AssignTo} = ({Declare_PropertyCPPType}*)((uint8*){Ref_ContainerAddr} + *OffsetPtr);
-}
-else
+const static TCHAR* PropDecorator_AssignPropPtrNative =
+	LR"EOF(
+static const int32 Offset = FindPropertyOffset(ActorClass, TEXT("{Declare_PropertyName}"), {Num_PropMemOffset});
+{Ref_AssignTo} = ({Declare_PropertyCPPType}*)((uint8*){Ref_ContainerAddr} + Offset))EOF";
+
+const static TCHAR* PropDecorator_SetDeltaStateTemplate =
+	LR"EOF(
+if ({Code_BeforeCondition}!({Code_ActorPropEqualToProtoState}))
 {
-    FProperty* Property = ActorClass->FindPropertyByName(FName(*PropertyName));
-    if (Property)
-    {   
-        int32 Offset = Property->GetOffset_ForInternal();
-        PropPointerMemOffsetCache.Emplace(PropertyName, Offset);
-        {Ref_AssignTo} = ({Declare_PropertyCPPType}*)((uint8*){Ref_ContainerAddr} + Offset);
-    }
-    else
-    {
-        UE_LOG(LogTemp, Error, TEXT("%s Replicator construct, but could not find property(%s) in cache or by name."), *ActorClass->GetName(), *PropertyName);
-        {Ref_AssignTo} = ({Declare_PropertyCPPType}*)((uint8*){Ref_ContainerAddr} + {Num_PropMemOffset});
-    }
+  {Code_SetProtoFieldValue};
+  bStateChanged = true;
 }
 )EOF";
 
-const static TCHAR* PropDecorator_SetDeltaStateTemplate =
+// Diffs the property against its member of the shadow state instead of the full state. See FPropertyDecorator::SupportsShadowState().
+const static TCHAR* PropDecorator_SetDeltaStateByShadowTemplate =
 	LR"EOF(
-if ({Code_BeforeCondition}!({Code_ActorPropEqualToProtoState}))
+if (!({Code_GetPropertyValue} == {Code_GetShadowValue}))
 {
+  {Code_GetShadowValue} = static_cast<{Declare_ShadowType}>({Code_GetPropertyValue});
   {Code_SetProtoFieldValue};
   bStateChanged = true;
 }
 )EOF";
 
+// Only converts the string to UTF-8 and compares it with the full state if its hash changes. See FChanneldReplicatorBase::IsStringChanged().
+const static TCHAR* PropDeco_SetDeltaStateByStringDiffCacheTemp =
+	LR"EOF(
+if (IsStringChanged({Num_StringDiffCacheIndex}, {Code_GetStringValue}))
+{
+  std::string NewValue(TCHAR_TO_UTF8(*{Code_GetStringValue}));
+  if (NewValue != {Declare_FullStateName}->{Definition_ProtoName}())
+  {
+    {Declare_DeltaStateName}->set_{Definition_ProtoName}(std::move(NewValue));
+    bStateChanged = true;
+  }
+}
+)EOF";
+
 const static TCHAR* PropDeco_SetDeltaStateByMemOffsetTemp =
 	LR"EOF(
 {
@@ -73,7 +79,7 @@ const static TCHAR* PropDecorator_CallRepNotifyTemplate =
 	LR"EOF(
 if (b{Declare_PropertyName}Changed)
 {
-	{Declare_TargetInstance}->ProcessEvent({Declare_TargetInstance}->GetClass()->FindFunctionByName(FName(TEXT("{Declare_FunctionName}"))), {Code_OnRepParams});
+	{Declare_TargetInstance}->ProcessEvent({Code_RepNotifyFunc}, {Code_OnRepParams});
 }
 )EOF";
 
@@ -140,6 +146,10 @@ public:
 	
 	virtual bool HasAnyPropertyFlags(EPropertyFlags PropertyFlags);
 
+	// The replication condition registered in GetLifetimeReplicatedProps() of the owner class
+	ELifetimeCondition GetRepCondition() const { return RepCondition; }
+	void SetRepCondition(ELifetimeCondition InRepCondition) { RepCondition = InRepCondition; }
+
 	/**
   	  * Get the name of field
   	  */
@@ -245,8 +255,10 @@ public:
 
 	// Get the property/field pointer via static memory offset. Used for C++ struct and UStruct that follow the Standard Layout.
 	virtual FString GetCode_AssignPropPointerStatic(const FString& Container, const FString& AssignTo);
-	// Get the property pointer via dynamic memory offset. Used for UObject/AActor that memory offset can be different across different platforms.
-	virtual FString GetCode_AssignPropPointerDynamic(const FString& Container, const FString& AssignTo);
+	// Get the property pointer via the memory offset in the shared property table of the class. Used for the Blueprint classes, which can be recompiled at runtime.
+	virtual FString GetCode_AssignPropPointerByTable(const FString& Container, const FString& AssignTo, const FString& OffsetCode);
+	// Get the property pointer via the memory offset resolved once per replicator class. Used for the native C++ classes, whose layout can't change at runtime.
+	virtual FString GetCode_AssignPropPointerNative(const FString& Container, const FString& AssignTo);
 
 	/**
 	 * Code that get field value from protobuf message
@@ -271,6 +283,82 @@ public:
 	 */
 	virtual FString GetCode_HasProtoFieldValueIn(const FString& StateName);
 
+	/**
+	 * Code that protobuf message has field value that MergeFrom() would merge. Unlike GetCode_HasProtoFieldValueIn(),
+	 * it also works for the fields without presence, e.g. repeated and bytes.
+	 * For example:
+	 *   NewState->has_biscrouched()
+	 *   NewState->prop_names_size() > 0
+	 */
+	virtual FString GetCode_HasMergeableProtoFieldValueIn(const FString& StateName);
+
+	/**
+	 * Code that merges the protobuf field of SrcStateName into DstStateName, same as what MergeFrom() does to the field
+	 * For example:
+	 *   if (Src->has_biscrouched()) { Dst->set_biscrouched(Src->biscrouched()); }
+	 */
+	virtual FString GetCode_MergeProtoField(const FString& DstStateName, const FString& SrcStateName);
+
+	/**
+	 * Get the name of the field in the protoc generated Go struct, e.g. prop_biscrouched -> PropBiscrouched
+	 */
+	virtual FString GetProtoFieldNameGo();
+
+	/**
+	 * Go code that merges the field of SrcStateName into DstStateName, same as what proto.Merge() does to the field,
+	 * except that the set scalar and bytes values are shared rather than copied.
+	 * For example:
+	 *   if src.PropBiscrouched != nil { dst.PropBiscrouched = src.PropBiscrouched }
+	 */
+	virtual FString GetCode_MergeProtoFieldGo(const FString& DstStateName, const FString& SrcStateName);
+
+	/**
+	 * Go expression of a non-default value of the field, used to fill the states in the generated benchmarks. Empty if not supported.
+	 * For example:
+	 *   proto.Bool(true)
+	 */
+	virtual FString GetCode_ProtoFieldSampleValueGo();
+
+	/**
+	 * Whether the protobuf field type is a scalar type (number, bool, string or bytes) rather than a message
+	 */
+	virtual bool IsProtoFieldScalar();
+
+	/**
+	 * The number of the bits the property takes in the packed_flags field of the owner state, or 0 if it can't be packed.
+	 * Only the optional bool and uint8 (including the enums as byte) fields can be packed.
+	 */
+	virtual int32 GetPackedFlagsWidth();
+
+	/**
+	 * Encode the property in the bits [Shift, Shift + GetPackedFlagsWidth()) of the packed_flags field of the owner state,
+	 * instead of its own field. The getter and the presence check of the proto field are redirected to packed_flags.
+	 */
+	void SetPackedFlagsShift(int32 Shift) { PackedFlagsShift = Shift; }
+	bool IsPackedInFlags() const { return PackedFlagsShift != INDEX_NONE; }
+
+	/**
+	 * Code of the property value shifted to its bits in the packed_flags field
+	 *
+	 * For example:
+	 *   (static_cast<uint32>(Character->bIsCrouched) << 3)
+	 */
+	virtual FString GetCode_PackedFlagsValueFrom(const FString& TargetInstance);
+
+	/**
+	 * Whether the property is diffed by the string diff cache of the replicator, which skips the UTF-8 conversion of the unchanged value.
+	 * Only set for the string properties of the actors, see PropDeco_SetDeltaStateByStringDiffCacheTemp.
+	 */
+	virtual bool SupportsStringDiffCache() { return false; }
+	void SetStringDiffCacheIndex(int32 Index) { StringDiffCacheIndex = Index; }
+
+	/**
+	 * Estimate the encoded bytes of the protobuf field with the tag, when the field is set in a state.
+	 * The typical size assumes small numbers and short strings and arrays. The worst case assumes the longest varints and
+	 * the caps of the strings and arrays in ReplicatorGeneratorDefinition.h.
+	 */
+	virtual void EstimateProtoFieldSize(int32& OutTypicalBytes, int32& OutWorstCaseBytes);
+
 	/**
 	 * Code of actor property equal to protobuf state
 	 *
@@ -295,12 +383,50 @@ public:
 
 	virtual FString GetCode_SetDeltaStateArrayInner(const FString& PropertyPointer, const FString& FullStateName, const FString& DeltaStateName, bool ConditionFullStateIsNull = false);
 
+	/**
+	 * Whether the property is diffed against its member of the shadow state of the replicator instead of the full state.
+	 * Only the numbers and the bools, whose values are compared and written to the proto field as they are.
+	 * See FReplicatedActorDecorator::GetDeclaration_ShadowState().
+	 */
+	virtual bool SupportsShadowState() { return false; }
+
+	/**
+	 * Code of the member of the property in the shadow state
+	 *
+	 * For example:
+	 *   bool bIsCrouched{};
+	 */
+	virtual FString GetDeclaration_ShadowMember();
+
+	/**
+	 * Code that set delta state by diffing the property against the shadow state
+	 * For example:
+	 *   if (!(Character->bIsCrouched == ShadowState.bIsCrouched))
+	 *   {
+	 *     ShadowState.bIsCrouched = static_cast<bool>(Character->bIsCrouched);
+	 *     DeltaState->set_biscrouched(ShadowState.bIsCrouched);
+	 *     bStateChanged = true;
+	 *   }
+	 */
+	virtual FString GetCode_SetDeltaStateByShadow(const FString& TargetInstance, const FString& ShadowName, const FString& DeltaStateName);
+
+	/**
+	 * Code that updates the shadow state by the new state received, same as merging the new state into the full state
+	 * For example:
+	 *   if (NewState->has_biscrouched()) { ShadowState.bIsCrouched = static_cast<bool>(NewState->biscrouched()); }
+	 */
+	virtual FString GetCode_MergeShadowMember(const FString& ShadowName, const FString& NewStateName);
+
 	/**
 	 * The property has RepNotify function and the RepNotify function has parameter
 	 */
 	virtual bool HasOnRepNotifyParam();
 
-	virtual FString GetCode_CallRepNotify(const FString& TargetInstanceName, const FString& OldValuePointer);
+	// The name of the RepNotify function, or empty if the property has no RepNotify
+	FString GetRepNotifyFuncName();
+
+	// RepNotifyFuncCode is the code of the UFunction, or empty to find it by name on the class of the target instance.
+	virtual FString GetCode_CallRepNotify(const FString& TargetInstanceName, const FString& OldValuePointer, const FString& RepNotifyFuncCode = TEXT(""));
 
 	/**
 	 * Code that handle state changes
@@ -342,4 +468,13 @@ protected:
 	FString ProtoFieldType;
 
 	bool bForceNotDirectlyAccessible = false;
+
+	ELifetimeCondition RepCondition = COND_None;
+
+	int32 PackedFlagsShift = INDEX_NONE;
+
+	int32 StringDiffCacheIndex = INDEX_NONE;
+
+	// The code of GetCode_SetDeltaState() by the string diff cache. StringValueCode is the FString of the property.
+	FString GetCode_SetDeltaStateByStringDiffCache(const FString& StringValueCode, const FString& FullStateName, const FString& DeltaStateName);
 };
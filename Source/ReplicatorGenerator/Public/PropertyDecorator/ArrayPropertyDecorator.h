@@ -190,6 +190,8 @@ public:
 
 	virtual FString GetDefinition_ProtoField(int32& FieldNumber) override;
 
+	virtual void EstimateProtoFieldSize(int32& OutTypicalBytes, int32& OutWorstCaseBytes) override;
+
 	virtual bool IsArray() override;
 
 protected:
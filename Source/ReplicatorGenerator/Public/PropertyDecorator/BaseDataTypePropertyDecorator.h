@@ -24,6 +24,10 @@ public: \
 	{ \
 		return TEXT(#PropertyType); \
 	} \
+	virtual bool SupportsShadowState() override \
+	{ \
+		return !IsPackedInFlags(); \
+	} \
 }
 
 #define BASE_DATA_TYPE_PROPERTY_DECORATOR_BUILDER(ClassName, PropertyDecorator, PropertyType) \
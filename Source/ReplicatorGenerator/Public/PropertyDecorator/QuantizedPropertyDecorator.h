@@ -0,0 +1,62 @@
+﻿#pragma once
+#include "PropertyDecorator.h"
+
+const static TCHAR* QuantizedPropDeco_SetDeltaStateByMemOffsetTemp =
+	LR"EOF(
+{
+  {Code_AssignPropPointers};
+  if(ForceMarge)
+  {
+    {Code_SetProtoFieldValue};
+  }
+  if ({Code_BeforeCondition}{Code_QuantizePropValue} != {Code_GetQuantizedProtoFieldValue})
+  {
+    if(!ForceMarge)
+    {
+      {Code_SetProtoFieldValue};
+    }
+    bStateChanged = true;
+  }
+}
+)EOF";
+
+/**
+ * Replicates the float, double, vector or rotator property with the ChanneldQuantize metadata as fixed-point integer, e.g.
+ * UPROPERTY(Replicated, meta=(ChanneldQuantize="0.1", ChanneldBits=16))
+ * The float is encoded to a sint32 field, and the vector or rotator is packed to a uint64 field (at most 21 bits per component).
+ * The value is clamped to the range of the bits, and the change of the property is only replicated if the encoded value changes.
+ */
+class FQuantizedPropertyDecorator : public FPropertyDecorator
+{
+public:
+	enum class EQuantizedType : uint8
+	{
+		Float,
+		Vector,
+		Rotator,
+	};
+
+	FQuantizedPropertyDecorator(FProperty* InProperty, IPropertyDecoratorOwner* InOwner, EQuantizedType InQuantizedType);
+
+	virtual ~FQuantizedPropertyDecorator() override = default;
+
+	virtual FString GetPropertyType() override;
+
+	virtual FString GetCode_GetProtoFieldValueFrom(const FString& StateName) override;
+	virtual FString GetCode_SetProtoFieldValueTo(const FString& StateName, const FString& GetValueCode) override;
+
+	virtual FString GetCode_ActorPropEqualToProtoState(const FString& FromActor, const FString& FromState) override;
+	virtual FString GetCode_ActorPropEqualToProtoState(const FString& FromActor, const FString& FromState, bool ForceFromPointer) override;
+
+	virtual FString GetCode_SetDeltaStateByMemOffset(const FString& ContainerName, const FString& FullStateName, const FString& DeltaStateName, bool ConditionFullStateIsNull = false) override;
+
+	virtual TArray<FString> GetAdditionalIncludes() override;
+
+protected:
+	EQuantizedType QuantizedType;
+	float Step = 1.f;
+	int32 Bits = 32;
+
+	// The encoded value of the property, e.g. ChanneldUtils::QuantizeFloat(Health, 0.1f, 16)
+	FString GetCode_QuantizeValue(const FString& GetValueCode);
+};
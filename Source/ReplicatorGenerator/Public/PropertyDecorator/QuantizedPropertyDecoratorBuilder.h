@@ -0,0 +1,12 @@
+﻿#pragma once
+#include "PropertyDecoratorBuilder.h"
+
+class FQuantizedPropertyDecoratorBuilder: public FPropertyDecoratorBuilder
+{
+public:
+	virtual ~FQuantizedPropertyDecoratorBuilder() override {};
+	virtual bool IsSpecialProperty(FProperty* Property) override;
+
+protected:
+	virtual FPropertyDecorator* ConstructPropertyDecorator(FProperty* Property, IPropertyDecoratorOwner* InOwner) override;
+};
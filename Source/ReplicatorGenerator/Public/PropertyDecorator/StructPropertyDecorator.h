@@ -8,6 +8,7 @@ struct {Declare_PropPtrGroupStructName}
   {Declare_PropPtrGroupStructName}() {}
   {Declare_PropPtrGroupStructName}(void* Container)
   {
+{Code_AssignShadowStructAddr}
 {Code_AssignPropPointers}
   }
 
@@ -17,12 +18,15 @@ struct {Declare_PropPtrGroupStructName}
   }
 
 {Declare_PropertyPointers}
+{Declare_ShadowMembers}
   
   bool Merge(const {Declare_ProtoNamespace}::{Declare_ProtoStateMsgName}* FullState, {Declare_ProtoNamespace}::{Declare_ProtoStateMsgName}* DeltaState, UWorld* World)
   {
     bool bIsFullStateNull = FullState == nullptr;
     bool bStateChanged = false;
+{Code_SkipUnchangedShadow}
 {Code_SetDeltaStates}
+{Code_UpdateShadow}
     return bStateChanged;
   }
   
@@ -38,6 +42,7 @@ struct {Declare_PropPtrGroupStructName}
   {
     bool bStateChanged = false;
 {Code_OnStateChange}
+{Code_InvalidateShadow}
     return bStateChanged;
   }
   
@@ -56,37 +61,43 @@ struct {Declare_PropCompilableStructName}
 };
 )EOF";
 
-const static TCHAR* StructPropDeco_AssignPropPtrStatic =
+// The copy of the plain-old-data struct at the last Merge(). The fields are only compared with the full state when the memory differs.
+const static TCHAR* StructPropDeco_ShadowMembersTemp =
 	LR"EOF(
-void* PropertyAddr = (uint8*){Ref_ContainerAddr} + {Num_PropMemOffset};
-{Ref_AssignTo} = {Declare_PropPtrGroupStructName}(PropertyAddr))EOF";
+  void* ShadowStructAddr = nullptr;
+  uint8 Shadow[{Num_StructSize}];
+  bool bShadowValid = false;
+)EOF";
 
-const static TCHAR* StructPropDeco_AssignPropPtrDynamic =
-    LR"EOF(
-FString PropertyName = TEXT("{Declare_PropertyName}");
-void* PropertyAddr = (uint8*){Ref_ContainerAddr};
-int32* OffsetPtr = PropPointerMemOffsetCache.Find(PropertyName);
-if (OffsetPtr != nullptr)
-{    
-    {Ref_AssignTo} = ({Declare_PropPtrGroupStructName})(PropertyAddr + *OffsetPtr);
-}
-else
-{
-    FProperty* Property = ActorClass->FindPropertyByName(FName(*PropertyName));
-    if (Property)
+// FullState is the default instance when the field is unset, e.g. after FChanneldReplicatorBase::ResetBaseline(), so the struct is sent in full again.
+const static TCHAR* StructPropDeco_SkipUnchangedShadowTemp =
+	LR"EOF(
+    if (bShadowValid && !bIsFullStateNull && FullState != &{Declare_ProtoNamespace}::{Declare_ProtoStateMsgName}::default_instance()
+      && FMemory::Memcmp(Shadow, ShadowStructAddr, sizeof(Shadow)) == 0)
     {
-        int32 Offset = Property->GetOffset_ForInternal();
-        PropPointerMemOffsetCache.Emplace(PropertyName, Offset);
-        {Ref_AssignTo} = ({Declare_PropPtrGroupStructName})(PropertyAddr + Offset);
+      return false;
     }
-    else
+)EOF";
+
+const static TCHAR* StructPropDeco_UpdateShadowTemp =
+	LR"EOF(
+    if (ShadowStructAddr != nullptr)
     {
-        UE_LOG(LogTemp, Error, TEXT("%s Replicator construct, but could not find property(%s) in cache or by name."), *ActorClass->GetName(), *PropertyName);
-        {Ref_AssignTo} = ({Declare_PropPtrGroupStructName})(PropertyAddr + {Num_PropMemOffset});
+      FMemory::Memcpy(Shadow, ShadowStructAddr, sizeof(Shadow));
+      bShadowValid = true;
     }
-}
 )EOF";
 
+const static TCHAR* StructPropDeco_AssignPropPtrStatic =
+	LR"EOF(
+void* PropertyAddr = (uint8*){Ref_ContainerAddr} + {Num_PropMemOffset};
+{Ref_AssignTo} = {Declare_PropPtrGroupStructName}(PropertyAddr))EOF";
+
+const static TCHAR* StructPropDeco_AssignPropPtrNative =
+	LR"EOF(
+static const int32 Offset = FindPropertyOffset(ActorClass, TEXT("{Declare_PropertyName}"), {Num_PropMemOffset});
+{Ref_AssignTo} = {Declare_PropPtrGroupStructName}((uint8*){Ref_ContainerAddr} + Offset))EOF";
+
 const static TCHAR* StructPropDeco_SetDeltaStateArrayInnerTemp =
 	LR"EOF(
 {
@@ -128,7 +139,8 @@ public:
 	virtual FString GetDeclaration_PropertyPtr() override;
 
 	virtual FString GetCode_AssignPropPointerStatic(const FString& Container, const FString& AssignTo) override;
-	virtual FString GetCode_AssignPropPointerDynamic(const FString& Container, const FString& AssignTo) override;
+	virtual FString GetCode_AssignPropPointerByTable(const FString& Container, const FString& AssignTo, const FString& OffsetCode) override;
+	virtual FString GetCode_AssignPropPointerNative(const FString& Container, const FString& AssignTo) override;
 	
 	virtual TArray<FString> GetAdditionalIncludes() override;
 	
@@ -158,6 +170,14 @@ public:
 	virtual bool IsStruct() override;
 
 	virtual TArray<TSharedPtr<FStructPropertyDecorator>> GetStructPropertyDecorators() override;
+
+	virtual void EstimateProtoFieldSize(int32& OutTypicalBytes, int32& OutWorstCaseBytes) override;
+
+	/**
+	 * Whether the struct only has the numeric, bool, enum and plain-old-data struct members, including the ones that are not
+	 * replicated, so the replicator can skip the comparison of the fields by comparing the memory with the last merged copy.
+	 */
+	virtual bool IsPlainOldData();
 	
 protected:
 	TArray<TSharedPtr<FPropertyDecorator>> Properties;
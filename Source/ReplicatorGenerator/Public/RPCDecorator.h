@@ -50,6 +50,8 @@ public:
 	
 	virtual FString GetCode_GetWorldRef() override;
 
+	FORCEINLINE FName GetFunctionName() const { return FunctionName; }
+
 protected:
 	FReplicatedActorDecorator* OwnerActor;
 	UFunction* OriginalFunction;
@@ -35,10 +35,11 @@ static const TCHAR* ActorDecor_GetStateFromChannelData =
 	LR"EOF(
 if({Code_Condition}) {
   auto States = {Declaration_ChannelDataMessage}->mutable_{Definition_ChannelDataFieldName}();
-  if (States->contains(NetGUID))
+  auto Itr = States->find(NetGUID);
+  if (Itr != States->end())
   {
     bIsRemoved = false;
-    return &States->at(NetGUID);
+    return &Itr->second;
   }
 }
 )EOF";
@@ -55,18 +56,18 @@ static const TCHAR* ActorDecor_GetStateFromChannelData_Removable =
 	LR"EOF(
 if({Code_Condition}) {
   auto States = {Declaration_ChannelDataMessage}->mutable_{Definition_ChannelDataFieldName}();
-  if (States->contains(NetGUID))
+  auto Itr = States->find(NetGUID);
+  if (Itr != States->end())
   {
-    auto State = &States->at(NetGUID);
-    bIsRemoved = State->removed();
-    return State;
+    bIsRemoved = Itr->second.removed();
+    return &Itr->second;
   }
 }
 )EOF";
 
 static const TCHAR* ActorDecor_ChannelDataProcessorMergeLoop =
 	LR"EOF(
-for (auto& Pair : Src->{Definition_ChannelDataFieldName}())
+for (auto& Pair : {Code_SrcStates})
 {
 {Code_MergeLoopInner}
 }
@@ -115,13 +116,52 @@ if({Code_Condition}) {
 )EOF";
 static const TCHAR* ActorDecor_ChannelDataProcessorMerge_DoMarge =
 	LR"EOF(
-if (Dst->{Definition_ChannelDataFieldName}().contains(Pair.first))
+auto DstStates = Dst->mutable_{Definition_ChannelDataFieldName}();
+auto Itr = DstStates->find(Pair.first);
+if (Itr != DstStates->end())
 {
-  Dst->mutable_{Definition_ChannelDataFieldName}()->at(Pair.first).MergeFrom(Pair.second);
+  {Code_MergeState}
 }
 else
 {
-  Dst->mutable_{Definition_ChannelDataFieldName}()->emplace(Pair.first, Pair.second);
+  {Code_InsertState}
+}
+)EOF";
+
+static const TCHAR* ActorDecor_ChannelDataProcessorMergeFromString_Singleton =
+	LR"EOF(
+case FChannelData::{Definition_ChannelDataFieldNumber}:
+  bOk = ChannelDataMerge::IsLengthDelimited(Tag) && ChannelDataMerge::MergeMessage(Input, Dst->mutable_{Definition_ChannelDataFieldName}());
+  break;
+)EOF";
+
+static const TCHAR* ActorDecor_ChannelDataProcessorMergeFromString_Map =
+	LR"EOF(
+case FChannelData::{Definition_ChannelDataFieldNumber}:
+  bOk = ChannelDataMerge::IsLengthDelimited(Tag) && ChannelDataMerge::MergeStateMapEntry(Input, *Dst->mutable_{Definition_ChannelDataFieldName}()) != nullptr;
+  break;
+)EOF";
+
+// The removed state is not merged, so it has to be parsed before merging.
+static const TCHAR* ActorDecor_ChannelDataProcessorMergeFromString_RemovableMap =
+	LR"EOF(
+case FChannelData::{Definition_ChannelDataFieldNumber}:
+{
+  uint32 NetGUID = 0;
+  {Definition_ProtoNamespace}::{Definition_ProtoStateMsgName} State;
+  bOk = ChannelDataMerge::IsLengthDelimited(Tag) && ChannelDataMerge::ReadStateMapEntry(Input, NetGUID, State);
+  if (bOk)
+  {
+    if (State.removed())
+    {
+{Code_RemoveState}
+    }
+    else
+    {
+      ChannelDataMerge::MergeState(*Dst->mutable_{Definition_ChannelDataFieldName}(), NetGUID, State{Code_MergeStateFunc});
+    }
+  }
+  break;
 }
 )EOF";
 
@@ -129,7 +169,74 @@ static const TCHAR* ActorDecor_ChannelDataProcessorMerge_Singleton =
 	LR"EOF(
 if (Src->has_{Definition_ChannelDataFieldName}())
 {
-  Dst->mutable_{Definition_ChannelDataFieldName}()->MergeFrom(Src->{Definition_ChannelDataFieldName}());
+  {Code_MergeState}
+}
+)EOF";
+
+// The states with the dirty mask are parsed before merging, so the mask of the existing state is merged rather than overwritten.
+static const TCHAR* ActorDecor_ChannelDataProcessorMergeFromString_SingletonByFields =
+	LR"EOF(
+case FChannelData::{Definition_ChannelDataFieldNumber}:
+{
+  {Definition_ProtoNamespace}::{Definition_ProtoStateMsgName} State;
+  bOk = ChannelDataMerge::IsLengthDelimited(Tag) && ChannelDataMerge::MergeMessage(Input, &State);
+  if (bOk)
+  {
+    MergeState_{Definition_ProtoStateMsgName}(Dst->mutable_{Definition_ChannelDataFieldName}(), &State);
+  }
+  break;
+}
+)EOF";
+
+static const TCHAR* ActorDecor_ChannelDataProcessorMergeFromString_MapByFields =
+	LR"EOF(
+case FChannelData::{Definition_ChannelDataFieldNumber}:
+{
+  uint32 NetGUID = 0;
+  {Definition_ProtoNamespace}::{Definition_ProtoStateMsgName} State;
+  bOk = ChannelDataMerge::IsLengthDelimited(Tag) && ChannelDataMerge::ReadStateMapEntry(Input, NetGUID, State);
+  if (bOk)
+  {
+    ChannelDataMerge::MergeState(*Dst->mutable_{Definition_ChannelDataFieldName}(), NetGUID, State{Code_MergeStateFunc});
+  }
+  break;
+}
+)EOF";
+
+// Only the fields whose bits are set in the dirty mask are visited.
+static const TCHAR* ActorDecor_ChannelDataProcessorMergeStateByDirtyMask =
+	LR"EOF(
+if (Src->has_dirty_mask())
+{
+  for (uint64 Mask = Src->dirty_mask(); Mask != 0; Mask &= Mask - 1)
+  {
+    switch (FPlatformMath::CountTrailingZeros64(Mask))
+    {
+{Code_MergeFieldCases}
+    }
+  }
+}
+else
+{
+{Code_MergeFields}
+}
+// The mask of the merged state is only valid if both states have one.
+if (Dst->has_dirty_mask() && Src->has_dirty_mask())
+{
+  Dst->set_dirty_mask(Dst->dirty_mask() | Src->dirty_mask());
+}
+else
+{
+  Dst->clear_dirty_mask();
+}
+)EOF";
+
+// Merges the fields of the state one by one. Same as MergeFrom(), but without the type check and the unknown fields.
+static const TCHAR* ActorDecor_ChannelDataProcessorMergeStateFunc =
+	LR"EOF(
+static void MergeState_{Definition_ProtoStateMsgName}({Definition_ProtoNamespace}::{Definition_ProtoStateMsgName}* Dst, const {Definition_ProtoNamespace}::{Definition_ProtoStateMsgName}* Src)
+{
+{Code_MergeFields}
 }
 )EOF";
 
@@ -158,9 +265,8 @@ if({Code_Condition}) {
   if (AccessibleState)
   {
 	auto States = {Declaration_ChannelDataMessage}->mutable_actorcomponentstates();
-	const unrealpb::ActorComponentState state = *static_cast<const unrealpb::ActorComponentState*>(AccessibleState);
 	const std::string compname = TCHAR_TO_UTF8(*TargetObject->GetName());
-	States->mutable_states()->emplace(compname, state);
+	(*States->mutable_states())[compname] = *static_cast<const unrealpb::ActorComponentState*>(AccessibleState);
   }
 }
 )EOF";
@@ -172,12 +278,71 @@ if({Code_Condition}) {
   if (AccessibleState)
   {
 	auto States = {Declaration_ChannelDataMessage}->mutable_actorcomponentstatess();
-	const unrealpb::ActorComponentState state = *static_cast<const unrealpb::ActorComponentState*>(AccessibleState);
 	const std::string compname = TCHAR_TO_UTF8(*TargetObject->GetName());
-	(*States)[NetGUID].mutable_states()->emplace(compname, state);
+	(*(*States)[NetGUID].mutable_states())[compname] = *static_cast<const unrealpb::ActorComponentState*>(AccessibleState);
+  }
+}
+)EOF";
+static const TCHAR* ActorDecor_GetStateFromActorMessage =
+	LR"EOF(
+if({Code_Condition}) {
+  auto Actors = {Declaration_ChannelDataMessage}->mutable_actors();
+  auto Itr = Actors->find(NetGUID);
+  if (Itr != Actors->end() && Itr->second.has_{Definition_ChannelDataFieldName}())
+  {
+    bIsRemoved = {Code_IsRemoved};
+    return &Itr->second.{Definition_ChannelDataFieldName}();
+  }
+}
+)EOF";
+
+static const TCHAR* ActorDecor_SetStateToActorMessage =
+	LR"EOF(
+if({Code_Condition}) {
+  auto AccessibleState = {Code_AccessibleState};
+  if (AccessibleState)
+  {
+    auto Actors = {Declaration_ChannelDataMessage}->mutable_actors();
+    *(*Actors)[NetGUID].mutable_{Definition_ChannelDataFieldName}() = *static_cast<const {Definition_ProtoNamespace}::{Definition_ProtoStateMsgName}*>(AccessibleState);
   }
 }
 )EOF";
+
+static const TCHAR* ActorDecor_ChannelDataProcessorMergeActorField =
+	LR"EOF(
+if (SrcActor.has_{Definition_ChannelDataFieldName}())
+{
+  if (DstActor.has_{Definition_ChannelDataFieldName}())
+  {
+    {Code_MergeState}
+  }
+  else
+  {
+    {Code_InsertState}
+  }
+}
+)EOF";
+
+// The removed component is cleared from the actor, rather than merged.
+static const TCHAR* ActorDecor_ChannelDataProcessorMergeActorField_Removable =
+	LR"EOF(
+if (SrcActor.has_{Definition_ChannelDataFieldName}())
+{
+  if (SrcActor.{Definition_ChannelDataFieldName}().removed())
+  {
+    DstActor.clear_{Definition_ChannelDataFieldName}();
+  }
+  else if (DstActor.has_{Definition_ChannelDataFieldName}())
+  {
+    {Code_MergeState}
+  }
+  else
+  {
+    {Code_InsertState}
+  }
+}
+)EOF";
+
 static const TCHAR* ActorDecor_SetStateToChannelData_Removable =
 	LR"EOF(
 if({Code_Condition}) {
@@ -223,6 +388,14 @@ public:
 	 */
 	virtual bool IsSingletonInChannelData();
 
+	/**
+	 * Whether the state is a field of the actor message in the actor-centric channel data (see FChannelDataSchema::bActorCentric),
+	 * rather than a map of its own. Only the non-singleton states other than UActorComponent's can be in the actor message.
+	 */
+	bool IsInActorMessage() const { return bInActorMessage; }
+	bool CanBeInActorMessage();
+	void SetInActorMessage(bool bInActor) { bInActorMessage = bInActor; }
+
 	/**
 	 * Is the replicator of the target class has been implemented by ChanneldUE,
 	 * and the state message is contained in the unreal_common.proto.
@@ -233,6 +406,29 @@ public:
 
 	virtual bool IsSkipGenChannelDataState();
 
+	/**
+	 * Whether the state message has the dirty_mask field, whose bit i is set if the i-th property field is set in the
+	 * message. Only the wide generated states have it, so the merges can skip the unset fields without checking them one by one.
+	 */
+	virtual bool HasDirtyMask();
+
+	/**
+	 * Whether the bool and byte properties of the state are packed into the packed_flags field rather than their own fields.
+	 * The field carries all the packed properties whenever any of them changes, so MergeFrom() merges it correctly.
+	 */
+	virtual bool HasPackedFlags();
+
+	/**
+	 * Whether the replicator diffs some properties (or the packed_flags field) against the shadow state, a plain struct of their last values,
+	 * rather than the full state. See FPropertyDecorator::SupportsShadowState().
+	 */
+	bool HasShadowState();
+
+	/**
+	 * Whether all the properties are diffed against the shadow state, so the replicator doesn't keep the full state at all.
+	 */
+	bool IsFullStateShadowed();
+
 	/**
 	 * Set module info if the target actor class is a cpp class.
 	 * Please call this function before calling GetActorHeaderIncludePath().
@@ -347,6 +543,47 @@ public:
 	 */
 	FString GetCode_AllPropertiesSetDeltaState(const FString& FullStateName, const FString& DeltaStateName);
 
+	/**
+	 * Get code that runs after the delta state or the new state is merged into the full state
+	 */
+	FString GetCode_AfterMergeFullState(const FString& FullStateName);
+
+	/**
+	 * Get the declaration of the shadow state and the override of ResetShadowState(), or empty if HasShadowState() is false
+	 */
+	FString GetDeclaration_ShadowState();
+
+	/**
+	 * Get code that merges the delta state into the full state at the end of Tick(), if there's the full state
+	 */
+	FString GetCode_MergeDeltaState(const FString& FullStateName, const FString& DeltaStateName);
+
+	/**
+	 * Get code that merges the new state received into the full state and the shadow state
+	 */
+	FString GetCode_MergeNewState(const FString& FullStateName, const FString& NewStateName);
+
+	/**
+	 * Get code that maps the property names to their indices in the push model dirty bits
+	 */
+	FString GetCode_PushModelPropertyIndices();
+
+	int32 GetPushModelPropertyNum();
+
+	// The number of the string properties diffed with the string diff caches of FChanneldReplicatorBase
+	int32 GetStringDiffCacheNum() const { return NumStringDiffCaches; }
+
+	/**
+	 * Estimate the encoded bytes of the state of an instance in the channel data, when all the properties are set.
+	 * See FPropertyDecorator::EstimateProtoFieldSize().
+	 */
+	void EstimateStateSize(int32& OutTypicalBytes, int32& OutWorstCaseBytes);
+
+	/**
+	 * The NetUpdateFrequency of the target class, or 0 if the target class is not an actor, e.g. a component replicated with its owner.
+	 */
+	float GetNetUpdateFrequency() const;
+
 	/**
 	 * Get code that handles state changed
 	 */
@@ -365,6 +602,8 @@ public:
 
 	int32 GetRPCNum();
 
+	void GetRPCFunctionNames(TSet<FName>& OutFuncNames) const;
+
 	FString GetCode_SerializeFunctionParams();
 	FString GetCode_DeserializeFunctionParams();
 
@@ -380,6 +619,8 @@ public:
 	virtual FString GetDefinition_ChannelDataFieldNameProto();
 	virtual FString GetDefinition_ChannelDataFieldNameCpp();
 	virtual FString GetDefinition_ChannelDataFieldNameGo();
+	// The name of the field number constant generated by protoc, e.g. kActorStatesFieldNumber.
+	virtual FString GetDefinition_ChannelDataFieldNumberCpp();
 
 	virtual FString GetCode_ConstPathFNameVarDecl();
 
@@ -389,14 +630,43 @@ public:
 
 	virtual FString GetCode_ChanneldDataProcessor_InitRemovedState();
 
-	virtual FString GetCode_ChannelDataProcessor_Merge(const TArray<TSharedPtr<FReplicatedActorDecorator>>& ActorChildren);
+	// If bMoveStates is true, the code is for MergeMove(): the states new to Dst are swapped out of the non-const Src.
+	virtual FString GetCode_ChannelDataProcessor_Merge(const TArray<TSharedPtr<FReplicatedActorDecorator>>& ActorChildren, bool bMoveStates = false);
+
+	// Whether the state message is generated from the replicated properties, so it can be merged field by field.
+	virtual bool CanMergeStateByFields();
+
+	// The static function that merges the state field by field. Empty if the state can't be merged by fields.
+	virtual FString GetCode_ChannelDataProcessor_MergeStateFunc();
+
+	// The code that merges the state SrcState (pointer) into DstState (pointer).
+	virtual FString GetCode_ChannelDataProcessor_MergeState(const FString& DstState, const FString& SrcState);
+
+	// The Go function that merges the state field by field. Empty if the state can't be merged by fields.
+	virtual FString GetCode_MergeStateFuncGo(const FString& FuncName, const FString& ChannelDataPackageName);
+
+	// The Go expression of a state with the sample values, used by the generated merge benchmarks.
+	virtual FString GetCode_SampleStateGo(const FString& ChannelDataPackageName);
+
+	// The case of the channel data field in IChannelDataProcessor::MergeFromString().
+	virtual FString GetCode_ChannelDataProcessor_MergeFromString();
+
+	// The code that erases the states of the removed actor (NetGUID) in IChannelDataProcessor::MergeFromString(). Only for AActor.
+	virtual FString GetCode_ChannelDataProcessor_MergeFromStringEraseActor(const TArray<TSharedPtr<FReplicatedActorDecorator>>& ActorChildren);
 
 	virtual FString GetCode_ChannelDataProcessor_GetStateFromChannelData(const FString& ChannelDataMessageName);
 
 	virtual FString GetCode_ChannelDataProcessor_SetStateToChannelData(const FString& ChannelDataMessageName);
 
+	// The registration of the state binding (see TChanneldStateBinding) of the native class in the map of the channel data.
+	// Empty for the blueprint classes, the singletons, the actor components keyed by the names and the actor-centric states.
+	virtual FString GetCode_RegisterStateBinding(const FString& ChannelDataType);
+
 	virtual FString GetCode_ChannelDataProtoFieldDefinition(const int32& FieldNum);
 
+	// The code that merges the field of the state in SrcActor into DstActor, in the loop over the actors of the actor-centric channel data.
+	virtual FString GetCode_ChannelDataProcessor_MergeActorField(bool bMoveStates = false);
+
 	virtual bool IsStruct() override;
 	
 	virtual bool IsArray() override;
@@ -415,10 +685,13 @@ protected:
 	TArray<TSharedPtr<FRPCDecorator>> RPCs;
 
 	bool bSingletonInChannelData;
+	bool bInActorMessage = false;
 	bool bChanneldUEBuiltinType;
 	bool bSkipGenChannelDataState;
 
 	bool bBlueprintGenerated;
+	bool bHasPackedFlags = false;
+	int32 NumStringDiffCaches = 0;
 	FString ReplicatorClassName;
 
 	FString VariableName_ConstClassPathFName;
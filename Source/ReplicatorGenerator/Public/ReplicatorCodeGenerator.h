@@ -6,6 +6,14 @@ struct FCPPClassInfo
 {
 	FString HeadFilePath;
 	FModuleInfo ModuleInfo;
+
+	friend FArchive& operator<<(FArchive& Ar, FCPPClassInfo& ClassInfo)
+	{
+		Ar << ClassInfo.HeadFilePath;
+		Ar << ClassInfo.ModuleInfo;
+
+		return Ar;
+	}
 };
 
 struct FReplicatorCode
@@ -39,11 +47,15 @@ struct FChannelDataCode
 
 	FString IncludeProcessorCode;
 	FString RegisterProcessorCode;
-	FString DeleteProcessorPtrCode;
-	FString ProcessorPtrDecl;
+	FString UnregisterProcessorCode;
 
 	FString Merge_GoCode;
+	FString MergeBenchmark_GoCode;
 	FString Registration_GoCode;
+
+	// The field numbers of the states in the channel data message, by the path name of the target class.
+	// The map of the actor-centric channel data is under the key "actors".
+	TMap<FString, int32> FieldNumbers;
 };
 
 struct FGeneratedCodeBundle
@@ -63,6 +75,8 @@ struct FGeneratedCodeBundle
 
 	FString ChannelDataRegistration_GoCode;
 	FString ChannelDataMerge_GoCode;
+	// The Go benchmarks of the generated Merge() of the channel data types
+	FString ChannelDataMergeBenchmark_GoCode;
 };
 
 struct FChannelDataInfo
@@ -83,6 +97,10 @@ struct FChannelDataInfo
 
 	TArray<FStateInfo> StateInfos;
 
+	// The field numbers of the last generation, by the path name of the target class. The states keep their numbers, so the
+	// channel data stays compatible when the schema changes; only the new states are numbered by the update frequency.
+	TMap<FString, int32> LastFieldNumbers;
+
 	FChannelDataInfo() = default;
 
 	FChannelDataInfo(const FChannelDataSchema& InSetting) : Schema(InSetting)
@@ -105,15 +123,16 @@ class REPLICATORGENERATOR_API FReplicatorCodeGenerator
 {
 public:
 	/**
-	 * Load the related information of the module of the class from '.uhtmanifest'.
+	 * Mark the class-to-header index to be reloaded on the next lookup, if the '.uhtmanifest' has changed since it was loaded.
+	 * The index is loaded from the binary cache in the intermediate directory if the cache was built from the same '.uhtmanifest',
+	 * otherwise it is rebuilt by parsing the '.uhtmanifest' and the UObject headers of all modules.
 	 * 
-	 * @return true on success, false otherwise.
+	 * @return true if the '.uhtmanifest' exists, false otherwise.
 	 */
 	bool RefreshModuleInfoByClassName();
 
 	/**
-	 * Get the path of the header file by class name.
-	 * Before calling this function, you need to call RefreshModuleInfoByClassName() at least once.
+	 * Get the path of the header file by class name. The class-to-header index is loaded lazily.
 	 * 
 	 * @param ClassName The name of the class, without UE prefix.
 	 * @return Absolute path of the header file.
@@ -124,6 +143,7 @@ public:
 	 * Generate replicator codes for the specified actors.
 	 *
 	 * @param ChannelDataInfos Actor infos to generate replicator for.
+	 * @param RPCOnlyClasses The classes to generate replicator for, without the states in the channel data, e.g. for their RPCs.
 	 * @param ProtoPackageName All generated proto files will use this package name.
 	 * @param ProtoMessageSuffix The suffix of the generated proto message name.
 	 * @param GoPackageImportPath Be used to set 'option go_package='.
@@ -132,20 +152,31 @@ public:
 	 */
 	bool Generate(
 		const TArray<FChannelDataInfo>& ChannelDataInfos,
+		const TArray<const UClass*>& RPCOnlyClasses,
 		const FString& ProtoPackageName,
 		const FString& ProtoMessageSuffix,
 		const FString& GoPackageImportPath,
 		FGeneratedCodeBundle& ReplicationCodeBundle
 	);
 
-	const FModuleInfo* GetModuleInfo(const FString& ClassName) const
+	const FModuleInfo* GetModuleInfo(const FString& ClassName)
 	{
-		return ModuleInfoByClassName.Find(ClassName);
+		const FCPPClassInfo* ClassInfo = FindCPPClassInfo(ClassName);
+		return ClassInfo ? &ClassInfo->ModuleInfo : nullptr;
 	}
 
 protected:
-	TMap<FString, FModuleInfo> ModuleInfoByClassName;
 	TMap<FString, FCPPClassInfo> CPPClassInfoMap;
+	// The timestamp of the '.uhtmanifest' that CPPClassInfoMap was built from.
+	FDateTime LoadedManifestTimestamp;
+	bool bCPPClassInfoMapStale = true;
+
+	const FCPPClassInfo* FindCPPClassInfo(const FString& ClassName);
+	static FString GetManifestFilePath();
+	// Load CPPClassInfoMap from the binary cache or the '.uhtmanifest' if it's stale.
+	bool EnsureCPPClassInfoMapLoaded();
+	bool LoadCPPClassInfoMapFromCache(const FDateTime& ManifestTimestamp);
+	void SaveCPPClassInfoMapToCache(const FDateTime& ManifestTimestamp);
 
 	TMap<FString, int32> TargetActorSameNameCounter;
 	TMap<const UClass*, int32> TargetClassSameNameNumber;
@@ -185,8 +216,25 @@ protected:
 		FString& ChannelDataProcessorCode
 	);
 
+	/**
+	 * Assign the field numbers of the states in the channel data message. The states of the last generation keep their numbers,
+	 * and the new states take the lowest free numbers in the descending order of the update frequency.
+	 */
+	void AssignChannelDataFieldNumbers(
+		const FChannelDataInfo& ChannelDataInfo,
+		const TArray<TSharedPtr<FReplicatedActorDecorator>>& TargetActors,
+		const TArray<float>& UpdateFrequencies,
+		TArray<int32>& OutFieldNumbers
+	);
+
+	/**
+	 * @param ActorsFieldNumber The field number of the map `actors` in the actor-centric channel data, or INDEX_NONE.
+	 * The states that are in the actor message have their field numbers in that message.
+	 */
 	bool GenerateChannelDataProtoDefFile(
 		const TArray<TSharedPtr<FReplicatedActorDecorator>>& TargetActors,
+		const TArray<int32>& FieldNumbers,
+		int32 ActorsFieldNumber,
 		const EChanneldChannelType ChannelType,
 		const FString& ChannelDataMessageName,
 		const FString& ProtoPackageName,
@@ -200,7 +248,8 @@ protected:
 		const EChanneldChannelType ChannelType,
 		const FString& ChannelDataMessageName,
 		const FString& ProtoPackageName,
-		FString& GoCode
+		FString& GoCode,
+		FString& BenchmarkGoCode
 	);
 
 	bool GenerateChannelDataRegistration_GoCode(
@@ -26,14 +26,24 @@ static const FString GenManager_GlobalStructProtoFile = TEXT("ChanneldGlobalStru
 static const FString GenManager_GlobalStructProtoHeaderFile = TEXT("ChanneldGlobalStruct") + CodeGen_ProtoPbHeadExtension;
 
 static const FString GenManager_UnrealCommonProtoFile = TEXT("unreal_common") + CodeGen_ProtoFileExtension;
+// The states of the built-in component replicators beyond unreal_common.proto
+static const FString GenManager_UnrealComponentsProtoFile = TEXT("unreal_components") + CodeGen_ProtoFileExtension;
 
 static const FString GenManager_IntermediateDir = FPaths::ProjectIntermediateDir() / TEXT("ChanneldReplicationGenerated");
-static const FString GenManager_RepActorCachePath = GenManager_IntermediateDir / TEXT("ReplicationActorCache.json");
-static const FString GenManager_DefaultRepActorCachePath = GenManager_IntermediateDir / TEXT("ReplicationActorCache.json");
+static const FString GenManager_RepActorCachePath = GenManager_IntermediateDir / TEXT("ReplicationActorCache.bin");
+static const FString GenManager_DefaultRepActorCachePath = GenManager_IntermediateDir / TEXT("ReplicationActorCache.bin");
 static const FString GenManager_GeneratedManifestFilePath = GenManager_IntermediateDir / TEXT("ReplicationGeneratedManifest.json");
 static const FString GenManager_TemporaryGoMergeCodePath = GenManager_IntermediateDir / TEXT("Tmp_ChannelDataGoMergeCode.go");
 static const FString GenManager_TemporaryGoRegistrationCodePath = GenManager_IntermediateDir / TEXT("Tmp_ChannelDataGoRegCode.go");
+static const FString GenManager_TemporaryGoMergeBenchmarkCodePath = GenManager_IntermediateDir / TEXT("Tmp_ChannelDataGoMergeBenchmark.go");
 static const FString GenManager_RepClassInfoPath = GenManager_IntermediateDir / TEXT("RepAssetInfoPath.json");
+static const FString GenManager_ClassHeaderIndexPath = GenManager_IntermediateDir / TEXT("ClassHeaderIndex.bin");
+
+// The assumptions of the replication cost estimate. The strings and the arrays are unbounded, so their worst case is capped.
+static constexpr int32 GenManager_EstimatedTypicalStringBytes = 16;
+static constexpr int32 GenManager_EstimatedMaxStringBytes = 256;
+static constexpr int32 GenManager_EstimatedTypicalArrayNum = 4;
+static constexpr int32 GenManager_EstimatedMaxArrayNum = 64;
 
 static const FString GenManager_ChannelDataSettingsPath = FPaths::ProjectConfigDir() / TEXT("ChanneldChannelDataSettings.json");
 static const FString GenManager_ChannelDataSchemataPath = FPaths::ProjectConfigDir() / TEXT("ChanneldChannelDataSchema.json");
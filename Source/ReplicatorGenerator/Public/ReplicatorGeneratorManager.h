@@ -6,6 +6,51 @@
 #include "Persistence/JsonModel.h"
 #include "ReplicatorGeneratorManager.generated.h"
 
+/**
+ * The estimated replication cost of the instances of a class. See FReplicatedActorDecorator::EstimateStateSize().
+ */
+USTRUCT(BlueprintType)
+struct REPLICATORGENERATOR_API FReplicationCostEstimate
+{
+	GENERATED_BODY()
+
+	// The bytes of a state with all the properties set
+	UPROPERTY(BlueprintReadOnly)
+	int32 TypicalStateBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 WorstCaseStateBytes = 0;
+
+	// 0 if the class is not an actor
+	UPROPERTY(BlueprintReadOnly)
+	float NetUpdateFrequency = 0;
+
+	// As if the full state was sent in every net update. The delta states only have the changed properties, so it's the upper bound.
+	UPROPERTY(BlueprintReadOnly)
+	int32 TypicalBytesPerSecond = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 WorstCaseBytesPerSecond = 0;
+
+	void UpdateBytesPerSecond()
+	{
+		TypicalBytesPerSecond = FMath::CeilToInt(TypicalStateBytes * NetUpdateFrequency);
+		WorstCaseBytesPerSecond = FMath::CeilToInt(WorstCaseStateBytes * NetUpdateFrequency);
+	}
+};
+
+/**
+ * The field numbers of the states in a channel data message, by the path name of the target class.
+ */
+USTRUCT()
+struct REPLICATORGENERATOR_API FChannelDataFieldNumbers
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TMap<FString, int32> FieldNumbers;
+};
+
 /**
  * Persistent info about latest generated codes.
  */
@@ -26,11 +71,34 @@ struct REPLICATORGENERATOR_API FGeneratedManifest
 	UPROPERTY()
 	FString TemporaryGoRegistrationCodePath;
 
+	// Empty if no merge benchmark is generated.
+	UPROPERTY()
+	FString TemporaryGoMergeBenchmarkCodePath;
+
 	// TODO: FString -> TMap<EChanneldChannelType, FString>
 
 	UPROPERTY()
 	TMap<EChanneldChannelType, FString> ChannelDataMsgNames;
 
+	// The hash of the generated content of each file in the replicator storage dir, by file name. The files of a target class
+	// (.h/.cpp/.proto) are only rewritten when their hashes change, so UBT and protoc can skip the unchanged ones.
+	UPROPERTY()
+	TMap<FString, FString> CodeFileHashes;
+
+	// The estimated replication cost of each target class, by the path name of the class. Only the properties declared in
+	// the class are counted, as the replicated super classes have their own replicators. Can be used for the bandwidth budgets in CI.
+	UPROPERTY()
+	TMap<FString, FReplicationCostEstimate> ReplicationCostEstimates;
+
+	// The field numbers of the channel data states, which are kept in the next generations. See FChannelDataInfo::LastFieldNumbers.
+	UPROPERTY()
+	TMap<EChanneldChannelType, FChannelDataFieldNumbers> ChannelDataFieldNumbers;
+
+	// The path names of the classes whose RPCs failed to serialize and fell back to the native path (see FChanneldNativeRPCFallbackReport).
+	// They get the replicators for their RPCs in the next generations, even if the reports are removed.
+	UPROPERTY()
+	TArray<FString> NativeRPCFallbackClasses;
+
 	FGeneratedManifest() = default;
 
 	FGeneratedManifest(
@@ -97,6 +165,7 @@ public:
 
 	/**
 	 * Generate replicators for the replication actors from registry table.
+	 * The files whose content is the same as the last generation are not rewritten, and the files that are no longer generated are removed.
 	 *
 	 * @param GoPackageImportPathPrefix If the go package is "github.com/metaworking/channeld/examples/channeld-ue-tps/tpspb", the prefix is "github.com/metaworking/channeld/examples/channeld-ue-tps".
 	 * @param CompatibleRecompilation If true, the generated code will be compatible with the previous generated code.
@@ -138,6 +207,13 @@ public:
 	 */
 	TArray<FString> GetGeneratedProtoFiles();
 
+	/**
+	 * Get the generated proto files whose .pb.h is missing or older than the proto file, i.e. need to be compiled by protoc.
+	 *
+	 * return List of the proto file path relative to 'GeneratedReplicators' directory.
+	 */
+	TArray<FString> GetOutdatedProtoFiles();
+
 	/**
 	 * Remove the generated replicator files from 'GeneratedReplicators' directory, including .h, .cpp, .proto, .pb.h, .pb.cpp files.
 	 *
@@ -164,8 +240,27 @@ public:
 
 	bool SaveGeneratedManifest(const FGeneratedManifest& Manifest);
 
+	/**
+	 * Get the estimated replication cost of the instances of the class from the latest generated manifest, summed over the class
+	 * and its super classes. The bytes per second are calculated by the NetUpdateFrequency of the class.
+	 *
+	 * @return false if none of the classes has a generated replicator.
+	 */
+	bool GetReplicationCostEstimate(const UClass* TargetClass, FReplicationCostEstimate& OutEstimate);
+
 	const FModuleInfo* GetModuleInfo(const FString& ClassName) const;
 
+private:
+	// The state of the current GenerateReplication() call.
+	TMap<FString, FString> LastCodeFileHashes;
+	TMap<FString, FString> CodeFileHashes;
+	int32 NumUnchangedFiles = 0;
+
+	// Write the file to the replicator storage dir, unless it exists and its content hash is the same as the last generation.
+	bool WriteCodeFileIfChanged(const FString& FileName, const FString& Code);
+	// Remove the files in the replicator storage dir that are not generated in this generation, and the protoc outputs of the removed proto files.
+	void RemoveStaleGeneratedFiles();
+
 	TSet<FString> DefaultSkipGenRep = {
 		TEXT("/Script/Engine.WorldSettings"),
 		TEXT("/Script/Engine.Light"),
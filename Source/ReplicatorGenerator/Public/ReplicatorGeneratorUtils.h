@@ -3,6 +3,8 @@
 #include "ReplicatorGeneratorManager.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/PlayerState.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
 
 namespace ChanneldReplicatorGeneratorUtils
 {
@@ -48,6 +50,8 @@ namespace ChanneldReplicatorGeneratorUtils
 		UActorComponent::StaticClass(),
 		USceneComponent::StaticClass(),
 		UStaticMeshComponent::StaticClass(),
+		USkeletalMeshComponent::StaticClass(),
+		UProjectileMovementComponent::StaticClass(),
 	};
 
 	TSet<const UClass*> ChanneldUEBuiltinClassSet{ChanneldUEBuiltinClasses};
@@ -56,6 +60,12 @@ namespace ChanneldReplicatorGeneratorUtils
 
 	REPLICATORGENERATOR_API bool IsChanneldUEBuiltinClass(const UClass* TargetClass);
 
+	// UAbilitySystemComponent is matched by the path, as the GameplayAbilities plugin is optional.
+	REPLICATORGENERATOR_API bool IsAbilitySystemComponentClass(const UClass* TargetClass);
+
+	// Whether the state of the builtin class is defined in unreal_components.proto instead of unreal_common.proto
+	REPLICATORGENERATOR_API bool IsInUnrealComponentsProto(const UClass* TargetClass);
+
 	REPLICATORGENERATOR_API bool IsChanneldUEBuiltinSingletonClass(const UClass* TargetClass);
 
 	REPLICATORGENERATOR_API bool HasReplicatedProperty(const UClass* TargetClass);
@@ -19,8 +19,10 @@ public:
   //~Begin FChanneldReplicatorBase Interface
 {Code_OverrideGetNetGUID}
   virtual google::protobuf::Message* GetDeltaState() override;
+{Code_OverrideGetFullState}
   virtual void ClearState() override;
   virtual void Tick(float DeltaTime) override;
+  virtual int32 GetPushModelPropertyIndex(const FName& PropertyName) const override;
   virtual void OnStateChanged(const google::protobuf::Message* NewState) override;
   //~End FChanneldReplicatorBase Interface
 
@@ -28,12 +30,14 @@ public:
 
 protected:
   TWeakObjectPtr<{Declare_TargetBaseClassName}> {Ref_TargetInstanceRef};
-  static TMap<FString, int32> PropPointerMemOffsetCache; 
+  // Shared by the replicators of the Blueprint class and its subclasses
+  static FChanneldBlueprintPropertyTables PropertyTables;
+  const FChanneldBlueprintPropertyTable* PropertyTable = nullptr;
 
-  // [Server+Client] The accumulated channel data of the target object
-  {Declare_ProtoNamespace}::{Declare_ProtoStateMsgName}* FullState;
+{Declare_FullState}
   // [Server] The accumulated delta change before next send
   {Declare_ProtoNamespace}::{Declare_ProtoStateMsgName}* DeltaState;
+{Declare_ShadowState}
 
 private:
 {Declare_IndirectlyAccessiblePropertyPtrs}
@@ -51,8 +55,10 @@ static const TCHAR* CodeGen_BP_ConstructorImplTemplate =
   TArray<FLifetimeProperty> RepProps;
   DisableAllReplicatedPropertiesOfClass(InTargetObj->GetClass(), GetTargetClass(), EFieldIteratorFlags::ExcludeSuper, RepProps);
 
-  FullState = new {Declare_ProtoNamespace}::{Declare_ProtoStateMsgName};
-  DeltaState = new {Declare_ProtoNamespace}::{Declare_ProtoStateMsgName};
+{Code_AcquireFullState}
+  DeltaState = AcquireState<{Declare_ProtoNamespace}::{Declare_ProtoStateMsgName}>();
+  InitPushModel({Num_PushModelProperties});
+  InitStringDiffCaches({Num_StringDiffCaches});
   
   UClass* ActorClass = GetTargetClass();
   if (!ActorClass) {
@@ -21,8 +21,10 @@ public:
 {Code_OverrideGetNetGUID}
   virtual UClass* GetTargetClass() override { return {Declare_TargetClassName}::StaticClass(); }
   virtual google::protobuf::Message* GetDeltaState() override;
+{Code_OverrideGetFullState}
   virtual void ClearState() override;
   virtual void Tick(float DeltaTime) override;
+  virtual int32 GetPushModelPropertyIndex(const FName& PropertyName) const override;
   virtual void OnStateChanged(const google::protobuf::Message* NewState) override;
   //~End FChanneldReplicatorBase Interface
 
@@ -30,12 +32,11 @@ public:
 
 protected:
   TWeakObjectPtr<{Declare_TargetClassName}> {Ref_TargetInstanceRef};
-  static TMap<FString, int32> PropPointerMemOffsetCache;  
 
-  // [Server+Client] The accumulated channel data of the target object
-  {Declare_ProtoNamespace}::{Declare_ProtoStateMsgName}* FullState;
+{Declare_FullState}
   // [Server] The accumulated delta change before next send
   {Declare_ProtoNamespace}::{Declare_ProtoStateMsgName}* DeltaState;
+{Declare_ShadowState}
 
 private:
 {Declare_IndirectlyAccessiblePropertyPtrs}
@@ -58,8 +59,10 @@ static const TCHAR* CodeGen_CPP_ConstructorImplTemplate =
   TArray<FLifetimeProperty> RepProps;
   DisableAllReplicatedPropertiesOfClass(InTargetObj->GetClass(), GetTargetClass(), EFieldIteratorFlags::ExcludeSuper, RepProps);
 
-  FullState = new {Declare_ProtoNamespace}::{Declare_ProtoStateMsgName};
-  DeltaState = new {Declare_ProtoNamespace}::{Declare_ProtoStateMsgName};
+{Code_AcquireFullState}
+  DeltaState = AcquireState<{Declare_ProtoNamespace}::{Declare_ProtoStateMsgName}>();
+  InitPushModel({Num_PushModelProperties});
+  InitStringDiffCaches({Num_StringDiffCaches});
 
   UClass* ActorClass = {Declare_TargetClassName}::StaticClass();
   if (!ActorClass) {
@@ -74,8 +77,8 @@ static const TCHAR* CodeGen_CPP_DestructorImplTemplate =
 	LR"EOF(
 {Declare_ReplicatorClassName}::~{Declare_ReplicatorClassName}()
 {
-  delete FullState;
-  delete DeltaState;
+{Code_ReleaseFullState}
+  ReleaseState(DeltaState);
 }
 )EOF";
 
@@ -104,9 +107,15 @@ void {Declare_ReplicatorClassName}::Tick(float DeltaTime)
 
 {Code_AllPropertiesSetDeltaState}
 
-  if (bStateChanged) {
-    FullState->MergeFrom(*DeltaState);
-  }
+  {Code_MergeDeltaState}
+  ClearDirtyProperties();
+  SetInitialStateDiffed();
+}
+
+int32 {Declare_ReplicatorClassName}::GetPushModelPropertyIndex(const FName& PropertyName) const
+{
+{Code_PushModelPropertyIndices}
+  return INDEX_NONE;
 }
 )EOF";
 
@@ -120,7 +129,7 @@ void {Declare_ReplicatorClassName}::OnStateChanged(const google::protobuf::Messa
   if ({Code_IsClient}) { return; }
 
   const {Declare_ProtoNamespace}::{Declare_ProtoStateMsgName}* NewState = static_cast<const {Declare_ProtoNamespace}::{Declare_ProtoStateMsgName}*>(InNewState);
-  FullState->MergeFrom(*NewState);
+  {Code_MergeNewState}
   bStateChanged = false;
 
   {Code_AllPropertyOnStateChanged}
@@ -188,15 +197,13 @@ class UChanneldReplicatorRegistration : public UEngineSubsystem
   virtual void Initialize(FSubsystemCollectionBase& Collection) override
   {
 {Code_ReplicatorRegister}
+{Code_RPCFunctionNamesRegister}
 {Code_ChannelDataProcessorRegister}
   }
   virtual void Deinitialize() override
   {
-{Code_DeleteChannelDataProcessor}
+{Code_UnregisterChannelDataProcessor}
   }
-
-private:
-  {Declaration_Variables}
 };
 )EOF";
 
@@ -220,6 +227,7 @@ static const FString CodeGen_ChannelDataProcessorCPPTemp =
 #include "unreal_common.pb.h"
 #include "Components/ActorComponent.h"
 #include "Replication/ChanneldReplication.h"
+#include "ChannelDataMerge.h"
 {Code_IncludeAdditionHeaders}
 
 namespace {Declaration_CDP_Namespace}
@@ -228,6 +236,7 @@ namespace {Declaration_CDP_Namespace}
   {
   protected:
   	{Declaration_RemovedState}
+    {Code_MergeStateFunctions}
   
   public:
 
@@ -244,6 +253,45 @@ namespace {Declaration_CDP_Namespace}
     {Code_Merge}
       return true;
     }
+
+    virtual bool MergeMove(google::protobuf::Message* SrcMsg, google::protobuf::Message* DstMsg) override
+    {
+      auto Src = static_cast<{Definition_CDP_ProtoNamespace}::{Definition_CDP_ProtoMsgName}*>(SrcMsg);
+      auto Dst = static_cast<{Definition_CDP_ProtoNamespace}::{Definition_CDP_ProtoMsgName}*>(DstMsg);
+    {Code_MergeMove}
+      return true;
+    }
+
+    virtual bool SupportsMergeFromString() const override { return {Code_SupportsMergeFromString}; }
+
+    virtual bool MergeFromString(const std::string& SrcBytes, google::protobuf::Message* DstMsg) override
+    {
+      using FChannelData = {Definition_CDP_ProtoNamespace}::{Definition_CDP_ProtoMsgName};
+      auto Dst = static_cast<FChannelData*>(DstMsg);
+      google::protobuf::io::CodedInputStream Input(reinterpret_cast<const uint8*>(SrcBytes.data()), SrcBytes.size());
+      // Same as Merge(): the removed actors' states are erased after all the states are merged.
+      TArray<uint32, TInlineAllocator<8>> RemovedActorNetGUIDs;
+      while (const uint32 Tag = Input.ReadTag())
+      {
+        bool bOk;
+        switch (google::protobuf::internal::WireFormatLite::GetTagFieldNumber(Tag))
+        {
+    {Code_MergeFromString}
+        default:
+          bOk = google::protobuf::internal::WireFormatLite::SkipField(&Input, Tag);
+          break;
+        }
+        if (!bOk)
+        {
+          return false;
+        }
+      }
+      for (const uint32 NetGUID : RemovedActorNetGUIDs)
+      {
+    {Code_MergeFromStringEraseActors}
+      }
+      return true;
+    }
     
     virtual const google::protobuf::Message* GetStateFromChannelData(google::protobuf::Message* ChannelData, UClass* TargetClass, UObject* TargetObject, uint32 NetGUID, bool& bIsRemoved) override
     {
@@ -286,6 +334,34 @@ if (Src->has_objref())
 }
 )EOF";
 
+// Merges the actors of the actor-centric channel data. The states of an actor are the fields of its message.
+static const TCHAR* CodeGen_MergeActorsTemplate =
+  LR"EOF(
+for (auto& Pair : {Code_SrcActors})
+{
+  auto& SrcActor = Pair.second;
+{Code_EraseRemovedActor}
+  auto& DstActor = (*Dst->mutable_actors())[Pair.first];
+{Code_MergeActorFields}
+}
+)EOF";
+
+static const TCHAR* CodeGen_EraseRemovedActorTemplate =
+  LR"EOF(
+  if (SrcActor.has_{Definition_ActorStateFieldName}() && SrcActor.{Definition_ActorStateFieldName}().removed())
+  {
+    Dst->mutable_actors()->erase(Pair.first);
+    continue;
+  }
+)EOF";
+
+static const TCHAR* CodeGen_MergeObjectStateFromString =
+  LR"EOF(
+case FChannelData::kObjRefFieldNumber:
+  bOk = ChannelDataMerge::IsLengthDelimited(Tag) && ChannelDataMerge::MergeMessage(Input, Dst->mutable_objref());
+  break;
+)EOF";
+
 static const TCHAR* CodeGen_GetObjectStateFromChannelData = LR"EOF(
   if (TargetClass == UObject::StaticClass())
 	{
@@ -96,9 +96,10 @@ static const TCHAR* CodeGen_Go_NotifyHandover = LR"EOF(
 static const TCHAR* CodeGen_Go_MergeStateTemplate = LR"EOF(
 	if srcData.{Definition_StateVarName} != nil {
 		if dst.{Definition_StateVarName} == nil {
-			dst.{Definition_StateVarName} = &{Definition_StatePackagePath}{Definition_StateClassName}{}
+			dst.{Definition_StateVarName} = srcData.{Definition_StateVarName}
+		} else {
+			{Code_MergeState}
 		}
-		proto.Merge(dst.{Definition_StateVarName}, srcData.{Definition_StateVarName})
 	}
 
 )EOF";
@@ -107,10 +108,10 @@ static const TCHAR* CodeGen_Go_MergeStateInMapTemplate = LR"EOF(
 	for netId, {Definition_NewStateVarName} := range srcData.{Definition_StateMapName} {
 		{Definition_OldStateVarName}, exists := dst.{Definition_StateMapName}[netId]
 		if exists {
-			proto.Merge({Definition_OldStateVarName}, {Definition_NewStateVarName})
+			{Code_MergeState}
 		} else {
 			if dst.{Definition_StateMapName} == nil {
-				dst.{Definition_StateMapName} = make(map[uint32]*{Definition_StatePackagePath}{Definition_StateClassName})
+				dst.{Definition_StateMapName} = make(map[uint32]*{Definition_StatePackagePath}{Definition_StateClassName}, len(srcData.{Definition_StateMapName}))
 			}
 			dst.{Definition_StateMapName}[netId] = {Definition_NewStateVarName}
 		}
@@ -125,10 +126,10 @@ static const TCHAR* CodeGen_Go_MergeCompStateInMapTemplate = LR"EOF(
 		} else {
 			{Definition_OldStateVarName}, exists := dst.{Definition_StateMapName}[netId]
 			if exists {
-				proto.Merge({Definition_OldStateVarName}, {Definition_NewStateVarName})
+				{Code_MergeState}
 			} else {
 				if dst.{Definition_StateMapName} == nil {
-					dst.{Definition_StateMapName} = make(map[uint32]*{Definition_StatePackagePath}{Definition_StateClassName})
+					dst.{Definition_StateMapName} = make(map[uint32]*{Definition_StatePackagePath}{Definition_StateClassName}, len(srcData.{Definition_StateMapName}))
 				}
 				dst.{Definition_StateMapName}[netId] = {Definition_NewStateVarName}
 			}
@@ -146,10 +147,10 @@ static const TCHAR* CodeGen_Go_MergeActorStateInMapTemplate = LR"EOF(
 		} else {
 			{Definition_OldStateVarName}, exists := dst.{Definition_StateMapName}[netId]
 			if exists {
-				proto.Merge({Definition_OldStateVarName}, {Definition_NewStateVarName})
+				{Code_MergeState}
 			} else {
 				if dst.{Definition_StateMapName} == nil {
-					dst.{Definition_StateMapName} = make(map[uint32]*{Definition_StatePackagePath}{Definition_StateClassName})
+					dst.{Definition_StateMapName} = make(map[uint32]*{Definition_StatePackagePath}{Definition_StateClassName}, len(srcData.{Definition_StateMapName}))
 				}
 				dst.{Definition_StateMapName}[netId] = {Definition_NewStateVarName}
 			}
@@ -158,6 +159,127 @@ static const TCHAR* CodeGen_Go_MergeActorStateInMapTemplate = LR"EOF(
 
 )EOF";
 
+// Merges the actors of the actor-centric channel data. The states of an actor are the fields of its message.
+static const TCHAR* CodeGen_Go_MergeActorsTemplate = LR"EOF(
+	for netId, newActor := range srcData.Actors {
+		{Code_DeleteRemovedActor}
+		oldActor, exists := dst.Actors[netId]
+		if !exists {
+			if dst.Actors == nil {
+				dst.Actors = make(map[uint32]*{Definition_ActorMsgName}, len(srcData.Actors))
+			}
+			oldActor = &{Definition_ActorMsgName}{}
+			dst.Actors[netId] = oldActor
+		}
+{Code_MergeStatesInActor}
+	}
+
+)EOF";
+
+static const TCHAR* CodeGen_Go_DeleteRemovedActorTemplate = LR"EOF(
+		if newActor.{Definition_StateVarName} != nil && newActor.{Definition_StateVarName}.Removed {
+			delete(dst.Actors, netId)
+			channeld.RootLogger().Debug("removed actor state", zap.Uint32("netId", netId))
+			continue
+		}
+)EOF";
+
+static const TCHAR* CodeGen_Go_MergeStateInActorTemplate = LR"EOF(
+		if newActor.{Definition_StateVarName} != nil {
+			if oldActor.{Definition_StateVarName} == nil {
+				oldActor.{Definition_StateVarName} = newActor.{Definition_StateVarName}
+			} else {
+				{Code_MergeState}
+			}
+		}
+)EOF";
+
+static const TCHAR* CodeGen_Go_MergeCompStateInActorTemplate = LR"EOF(
+		if newActor.{Definition_StateVarName} != nil {
+			if newActor.{Definition_StateVarName}.Removed {
+				oldActor.{Definition_StateVarName} = nil
+			} else if oldActor.{Definition_StateVarName} == nil {
+				oldActor.{Definition_StateVarName} = newActor.{Definition_StateVarName}
+			} else {
+				{Code_MergeState}
+			}
+		}
+)EOF";
+
+// Merges the fields of the state one by one, without the reflection of proto.Merge(). The merged state shares the set
+// values of src rather than copying them, same as the new states that are put into the maps.
+static const TCHAR* CodeGen_Go_MergeStateFuncTemplate = LR"EOF(
+func {Definition_MergeFuncName}(dst, src *{Definition_StatePackagePath}{Definition_StateClassName}) {
+{Code_MergeFields}
+}
+)EOF";
+
+// Only the fields whose bits are set in the dirty mask are visited.
+static const TCHAR* CodeGen_Go_MergeStateByDirtyMaskTemplate = LR"EOF(
+	if src.DirtyMask != nil {
+		for i, mask := 0, *src.DirtyMask; mask != 0; i, mask = i+1, mask>>1 {
+			if mask&1 == 0 {
+				continue
+			}
+			switch i {
+{Code_MergeFieldCases}
+			}
+		}
+	} else {
+{Code_MergeFields}
+	}
+	// The mask of the merged state is only valid if both states have one.
+	if dst.DirtyMask != nil && src.DirtyMask != nil {
+		if mask := *dst.DirtyMask | *src.DirtyMask; mask != *dst.DirtyMask {
+			dst.DirtyMask = &mask
+		}
+	} else {
+		dst.DirtyMask = nil
+	}
+)EOF";
+
+static const TCHAR* CodeGen_Go_MergeBenchmarkImportTemplate = LR"EOF(
+import (
+	"testing"
+
+	"google.golang.org/protobuf/proto"
+)
+
+// The number of the states in each map of the benchmarked channel data.
+const benchmarkNumStates = 100
+)EOF";
+
+static const TCHAR* CodeGen_Go_MergeBenchmarkTemplate = LR"EOF(
+func Benchmark{Definition_ChannelDataMsgName}Merge(b *testing.B) {
+	src := &{Definition_ChannelDataMsgName}{}
+{Code_FillStates}
+	dst := proto.Clone(src).(*{Definition_ChannelDataMsgName})
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if err := dst.Merge(src, nil, nil); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+)EOF";
+
+static const TCHAR* CodeGen_Go_MergeBenchmarkFillMapTemplate = LR"EOF(
+	src.{Definition_StateMapName} = make(map[uint32]*{Definition_StateClassName}, benchmarkNumStates)
+	for netId := uint32(1); netId <= benchmarkNumStates; netId++ {
+		src.{Definition_StateMapName}[netId] = {Code_SampleState}
+	}
+)EOF";
+
+static const TCHAR* CodeGen_Go_MergeBenchmarkFillActorsTemplate = LR"EOF(
+	src.Actors = make(map[uint32]*{Definition_ActorMsgName}, benchmarkNumStates)
+	for netId := uint32(1); netId <= benchmarkNumStates; netId++ {
+		src.Actors[netId] = &{Definition_ActorMsgName}{
+{Code_SampleStates}
+		}
+	}
+)EOF";
+
 static const TCHAR* CodeGen_Go_DeleteStateInMapTemplate = LR"EOF(
 	delete(dst.{Definition_StateMapName}, netId)
 )EOF";
@@ -26,10 +26,10 @@ public class ReplicatorGenerator : ModuleRules
 				"ChanneldUE",
 				"AnalyticsET",
 				"JsonUtilities",
+				"AssetRegistry",
 #if UE_5_0_OR_LATER
 				"RenderCore",
 				"DeveloperToolSettings",
-				"AssetRegistry",
 #endif
 			}
 		);
@@ -11,4 +11,7 @@ rename channeld.pb.cc channeld.pb.cpp
 
 %PROTOC% --cpp_out=.  --cpp_opt=dllexport_decl=CHANNELDUE_API -I "%CHANNELD_PATH%/pkg/unrealpb" -I "%PROTOBUF_PATH%/include" unreal_common.proto
 del /q unreal_common.pb.cpp
-rename unreal_common.pb.cc unreal_common.pb.cpp
\ No newline at end of file
+rename unreal_common.pb.cc unreal_common.pb.cpp
+%PROTOC% --cpp_out=.  --cpp_opt=dllexport_decl=CHANNELDUE_API -I . -I "%CHANNELD_PATH%/pkg/unrealpb" -I "%PROTOBUF_PATH%/include" unreal_components.proto
+del /q unreal_components.pb.cpp
+rename unreal_components.pb.cc unreal_components.pb.cpp
@@ -9,6 +9,7 @@ if NOT "{Username}" == "" (
 )
 
 :channeldpush
+if "{ChanneldTag}" == "" goto serverpush
 docker push {ChanneldTag} 2>docker_error.txt
 if ERRORLEVEL 1 (
     findstr /i /c:"denied: requested access to the resource is denied" docker_error.txt
@@ -33,6 +34,7 @@ docker login {ChanneldRepoUrl}
 goto channeldpush
 
 :serverpush
+if "{ServerTag}" == "" Exit /b 0
 docker push {ServerTag} 2>docker_error.txt
 if ERRORLEVEL 1 (
     findstr /i /c:"denied: requested access to the resource is denied" docker_error.txt
@@ -46,7 +48,7 @@ if ERRORLEVEL 1 (
 )
 Exit /b 0
 
-:channeldlogin
+:serverlogin
 if "{ServerRepoUrl}" == "" (
     echo Please login to dockerhub.
 ) else (